@@ -61,6 +61,36 @@
   `define ENABLE_M_EXT 0
 `endif
 
+// Multiplier implementation (M extension)
+//   0   = iterative mul_unit (one bit per cycle, stalls the pipeline)
+//   1-3 = pipelined Booth multiplier (mul_pipelined.v), result after 1-3 stages
+`ifndef MUL_STAGES
+  `define MUL_STAGES 0
+`endif
+
+// Divider radix (M extension, div_unit.v)
+//   2 = one quotient bit per cycle (XLEN iterations)
+//   4 = two bits per cycle with early termination and fast paths
+`ifndef DIV_RADIX
+  `define DIV_RADIX 2
+`endif
+
+// FPU datapath (F/D extensions)
+//   0 = FADD/FSUB/FMUL/FMA run in the multi-cycle fpu units (stalls the pipeline)
+//   1 = FADD/FSUB/FMUL/FMA issue to fp_fma_pipelined.v (4-cycle latency, one per
+//       cycle); a destination scoreboard stalls only dependent instructions
+`ifndef FPU_PIPELINED
+  `define FPU_PIPELINED 0
+`endif
+
+// Long-latency ops (DIV/DIVU/REM/REMU, FDIV, FSQRT)
+//   0 = run in mul_div_unit / fpu and stall the pipeline until done
+//   1 = issue to long_op_unit.v and complete out of order; a register
+//       scoreboard stalls only instructions that read or overwrite the result
+`ifndef NONBLOCKING_LONG_OPS
+  `define NONBLOCKING_LONG_OPS 0
+`endif
+
 // A Extension: Atomic Instructions
 `ifndef ENABLE_A_EXT
   `define ENABLE_A_EXT 0
@@ -85,7 +115,15 @@
 // Cache Configuration
 // ============================================================================
 
-// Instruction Cache
+// Instruction Cache (icache.v, between IF and instruction_memory)
+`ifndef ENABLE_ICACHE
+  `define ENABLE_ICACHE 0  // 0 = fetch directly from instruction_memory
+`endif
+
+`ifndef ICACHE_REFILL_LATENCY
+  `define ICACHE_REFILL_LATENCY 4  // Wait cycles per refill word (models off-chip memory)
+`endif
+
 `ifndef ICACHE_SIZE
   `define ICACHE_SIZE 4096  // 4KB default
 `endif
@@ -98,7 +136,15 @@
   `define ICACHE_WAYS 1  // Direct-mapped by default
 `endif
 
-// Data Cache
+// Data Cache (dcache.v, between a core's data port and simple_bus)
+`ifndef ENABLE_DCACHE
+  `define ENABLE_DCACHE 0  // 0 = every data access goes over the bus
+`endif
+
+`ifndef DCACHE_MSHRS
+  `define DCACHE_MSHRS 2  // Outstanding line misses (store misses do not stall)
+`endif
+
 `ifndef DCACHE_SIZE
   `define DCACHE_SIZE 4096  // 4KB default
 `endif
@@ -111,7 +157,25 @@
   `define DCACHE_WAYS 1  // Direct-mapped by default
 `endif
 
-// L2 Cache (for multicore)
+// Store Buffer (store_buffer.v, between the MEM stage and the core's bus port)
+`ifndef ENABLE_STORE_BUFFER
+  `define ENABLE_STORE_BUFFER 0  // 0 = stores wait for the bus in MEM
+`endif
+
+`ifndef STORE_BUFFER_ENTRIES
+  `define STORE_BUFFER_ENTRIES 4  // Doubleword entries
+`endif
+
+// Near-memory AMOs: AMOSWAP/ADD/XOR/AND/OR/MIN/MAX/MINU/MAXU to DMEM are sent as
+// one bus transaction and executed by dmem_bus_adapter (amo_alu.v). Only takes
+// effect without D-cache and L2 (a cached copy would miss the update) and
+// without BUS_PIPELINED
+`ifndef ENABLE_NEAR_MEM_AMO
+  `define ENABLE_NEAR_MEM_AMO 0  // 0 = read, modify in the core, write back
+`endif
+
+// L2 Cache (for multicore): shared by all harts between the hart arbiter and
+// simple_bus (rv_soc.v), same design as the D-cache
 `ifndef L2_CACHE_SIZE
   `define L2_CACHE_SIZE 65536  // 64KB default
 `endif
@@ -120,6 +184,14 @@
   `define L2_CACHE_ENABLE 0
 `endif
 
+`ifndef L2_CACHE_WAYS
+  `define L2_CACHE_WAYS 4
+`endif
+
+`ifndef L2_CACHE_LINE_SIZE
+  `define L2_CACHE_LINE_SIZE `DCACHE_LINE_SIZE
+`endif
+
 // ============================================================================
 // Multicore Configuration
 // ============================================================================
@@ -129,7 +201,18 @@
 `endif
 
 `ifndef ENABLE_COHERENCY
-  `define ENABLE_COHERENCY 0
+  `define ENABLE_COHERENCY 0  // 1 = MESI snooping between D-caches (coherence_hub.v)
+`endif
+
+// Pipelined bus (rv_soc.v): every hart's data port (after its D-cache) is a
+// split_bus master with one transaction in flight (split_bus_master.v); DMEM is
+// a pipelined split_bus slave (dmem_split_adapter.v) and the other slaves are
+// reached through split_bus_bridge.v and simple_bus. Harts overlap their
+// accesses instead of taking turns on one bus. split_bus has no bus lock, write
+// snoop or AMO sideband, so it only takes effect with one hart or coherent
+// D-caches, and without L2; near-memory AMOs are not used with it
+`ifndef BUS_PIPELINED
+  `define BUS_PIPELINED 0  // 0 = harts share simple_bus (bus_master_arbiter)
 `endif
 
 // ============================================================================
@@ -156,6 +239,38 @@
   `define TLB_ENTRIES 16  // Number of TLB entries (power of 2)
 `endif
 
+// Shared L2 TLB behind the I-TLB and D-TLB (l2_tlb.v, probed before a page walk)
+//   L2_TLB_ENTRIES    = 4KB-page entries, set-associative (0 = no L2 TLB)
+//   L2_TLB_WAYS       = associativity of the 4KB-page array
+//   L2_TLB_SUPERPAGES = fully-associative megapage/gigapage entries
+`ifndef L2_TLB_ENTRIES
+  `define L2_TLB_ENTRIES 0
+`endif
+
+`ifndef L2_TLB_WAYS
+  `define L2_TLB_WAYS 4
+`endif
+
+`ifndef L2_TLB_SUPERPAGES
+  `define L2_TLB_SUPERPAGES 8
+`endif
+
+// Page-walk cache in ptw.v: non-leaf PTEs keyed by VPN prefix and ASID, so a
+// walk starts at the deepest cached level (usually one PTE read for Sv32/Sv39)
+//   0 = every walk starts from satp.PPN
+`ifndef PWC_ENTRIES
+  `define PWC_ENTRIES 0
+`endif
+
+// Hardware PTE A/D update (Svadu-style)
+//   0 = walker leaves PTE.A/PTE.D to software
+//   1 = walker sets PTE.A (and PTE.D on a store) with a read-modify-write of
+//       the PTE that holds the bus from read to write; a store to a page
+//       cached with D=0 misses in the D-TLB and re-walks to set D
+`ifndef PTW_AD_UPDATE
+  `define PTW_AD_UPDATE 0
+`endif
+
 // ============================================================================
 // Pipeline Configuration
 // ============================================================================
@@ -164,6 +279,87 @@
   `define PIPELINE_STAGES 5  // Classic 5-stage pipeline
 `endif
 
+// Issue width (in-order)
+//   1 = scalar
+//   2 = dual issue: a 64-bit fetch bundle pairs the instruction at PC with a
+//       simple ALU op at PC+4 (no RAW between them), which runs in a second
+//       ALU lane alongside it and writes through register file port 2
+`ifndef ISSUE_WIDTH
+  `define ISSUE_WIDTH 1
+`endif
+
+// Instruction fetch queue (fetch_queue.v, between fetch and the IF-stage RVC logic)
+//   0   = IF PC fetches directly and stalls with decode
+//   4-8 = halfword entries; fetch runs ahead of decode while it is stalled, and
+//         with ENABLE_ICACHE the I-cache prefetches the next line
+//         (use 8 with ISSUE_WIDTH=2, which consumes 4 halfwords per pair)
+`ifndef FETCH_QUEUE_DEPTH
+  `define FETCH_QUEUE_DEPTH 0
+`endif
+
+// Load-use bypass
+//   0 = an instruction that uses a load result in the next cycle stalls 1 cycle
+//   1 = integer load data is forwarded from MEM straight into EX, removing the
+//       bubble for ALU consumers (and load/store consumers with translation off)
+//       Longer cycle: bus read data -> load alignment -> forward mux -> ALU ->
+//       EX/MEM all in one cycle (make test-load-use-bypass)
+`ifndef LOAD_USE_BYPASS
+  `define LOAD_USE_BYPASS 0
+`endif
+
+// Atomic completion-cycle forwarding
+//   0 = an instruction that reads an atomic's rd waits until the atomic has
+//       left EX (stall also covers the completion cycle; MEM->ID forwarding)
+//   1 = the result is forwarded EX->ID in the completion cycle (atomic_done),
+//       one bubble less per dependent atomic (KNOWN_ISSUES.md item 1)
+`ifndef ATOMIC_DONE_FORWARD
+  `define ATOMIC_DONE_FORWARD 0
+`endif
+
+// ============================================================================
+// Branch Prediction
+// ============================================================================
+
+// Dynamic branch predictor in IF (branch_predictor.v)
+// Disabled: every taken branch/jump redirects from EX (2-cycle penalty)
+// Enabled:  only mispredictions redirect from EX
+`ifndef ENABLE_BRANCH_PRED
+  `define ENABLE_BRANCH_PRED 0
+`endif
+
+`ifndef BP_BHT_ENTRIES
+  `define BP_BHT_ENTRIES 512  // 2-bit counters (power of 2)
+`endif
+
+`ifndef BP_BTB_ENTRIES
+  `define BP_BTB_ENTRIES 64  // Direct-mapped BTB entries (power of 2)
+`endif
+
+`ifndef BP_BTB_TAG_BITS
+  `define BP_BTB_TAG_BITS 16  // Partial PC tag per BTB entry
+`endif
+
+`ifndef BP_GHR_BITS
+  `define BP_GHR_BITS 8  // Global history bits for gshare (0 = bimodal, max 16)
+`endif
+
+`ifndef BP_RAS_DEPTH
+  `define BP_RAS_DEPTH 8  // Return address stack entries (power of 2)
+`endif
+
+// ============================================================================
+// Performance Counters
+// ============================================================================
+
+// Hardware performance monitor (csr_file.v): mcycle, minstret and time are
+// always implemented; HPM_COUNTERS adds mhpmcounter3.. with mhpmevent selectors
+// (event numbers HPM_EVENT_* in rv_csr_defines.vh)
+//   0    = mhpmcounter3-31 and mhpmevent3-31 read as zero
+//   1-29 = mhpmcounter3 .. mhpmcounter(2+HPM_COUNTERS)
+`ifndef HPM_COUNTERS
+  `define HPM_COUNTERS 0
+`endif
+
 // ============================================================================
 // Debug and Verification
 // ============================================================================
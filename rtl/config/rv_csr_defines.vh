@@ -46,6 +46,19 @@ localparam [11:0] CSR_MCAUSE    = 12'h342;  // Machine trap cause
 localparam [11:0] CSR_MTVAL     = 12'h343;  // Machine bad address or instruction
 localparam [11:0] CSR_MIP       = 12'h344;  // Machine interrupt pending
 
+// Machine Counter Setup
+localparam [11:0] CSR_MCOUNTEREN    = 12'h306;  // Counter access enable for S-mode
+localparam [11:0] CSR_MCOUNTINHIBIT = 12'h320;  // Stop individual counters
+localparam [11:0] CSR_MHPMEVENT3    = 12'h323;  // Event selectors 0x323-0x33F
+
+// Machine Counters/Timers
+localparam [11:0] CSR_MCYCLE        = 12'hB00;  // Cycle counter
+localparam [11:0] CSR_MINSTRET      = 12'hB02;  // Instructions retired
+localparam [11:0] CSR_MHPMCOUNTER3  = 12'hB03;  // Event counters 0xB03-0xB1F
+localparam [11:0] CSR_MCYCLEH       = 12'hB80;  // RV32: upper 32 bits of mcycle
+localparam [11:0] CSR_MINSTRETH     = 12'hB82;  // RV32: upper 32 bits of minstret
+localparam [11:0] CSR_MHPMCOUNTER3H = 12'hB83;  // RV32: upper halves 0xB83-0xB9F
+
 // =============================================================================
 // Supervisor-Level CSR Addresses (RISC-V Spec Section 4)
 // =============================================================================
@@ -62,6 +75,9 @@ localparam [11:0] CSR_SCAUSE    = 12'h142;  // Supervisor trap cause
 localparam [11:0] CSR_STVAL     = 12'h143;  // Supervisor bad address or instruction
 localparam [11:0] CSR_SIP       = 12'h144;  // Supervisor interrupt pending
 
+// Supervisor Counter Setup
+localparam [11:0] CSR_SCOUNTEREN = 12'h106;  // Counter access enable for U-mode
+
 // Supervisor Address Translation and Protection
 localparam [11:0] CSR_SATP      = 12'h180;  // Supervisor address translation and protection
 
@@ -73,6 +89,40 @@ localparam [11:0] CSR_FFLAGS    = 12'h001;  // Floating-point exception flags
 localparam [11:0] CSR_FRM       = 12'h002;  // Floating-point rounding mode
 localparam [11:0] CSR_FCSR      = 12'h003;  // Floating-point control and status register
 
+// =============================================================================
+// User-Level Counter Shadows (RISC-V Spec Section 2.2, read-only)
+// =============================================================================
+// Visible in S-mode when mcounteren[n] is set, in U-mode when both
+// mcounteren[n] and scounteren[n] are set (n = address[4:0])
+
+localparam [11:0] CSR_CYCLE        = 12'hC00;  // Shadow of mcycle
+localparam [11:0] CSR_TIME         = 12'hC01;  // CLINT mtime
+localparam [11:0] CSR_INSTRET      = 12'hC02;  // Shadow of minstret
+localparam [11:0] CSR_HPMCOUNTER3  = 12'hC03;  // Shadows 0xC03-0xC1F
+localparam [11:0] CSR_CYCLEH       = 12'hC80;  // RV32 upper halves
+localparam [11:0] CSR_TIMEH        = 12'hC81;
+localparam [11:0] CSR_INSTRETH     = 12'hC82;
+localparam [11:0] CSR_HPMCOUNTER3H = 12'hC83;  // Shadows 0xC83-0xC9F
+
+// =============================================================================
+// Hardware Performance Monitor Events (mhpmevent values)
+// =============================================================================
+// Each event is a per-cycle condition; a counter selecting it adds 1 in every
+// cycle the condition holds (stall events) or once per occurrence (pulses).
+// 0 = no event (counter holds)
+
+localparam HPM_EVENT_LOAD_USE   = 1;   // Load-use bubble (integer or FP load)
+localparam HPM_EVENT_M_STALL    = 2;   // M unit holding the pipeline
+localparam HPM_EVENT_A_STALL    = 3;   // A unit holding the pipeline
+localparam HPM_EVENT_FP_STALL   = 4;   // Multi-cycle FPU holding the pipeline
+localparam HPM_EVENT_MMU_STALL  = 5;   // EX waiting for D-TLB translation
+localparam HPM_EVENT_BUS_STALL  = 6;   // Data bus request waiting for ready
+localparam HPM_EVENT_BR_FLUSH   = 7;   // Branch/jump mispredicted (EX redirect)
+localparam HPM_EVENT_TRAP_FLUSH = 8;   // Pipeline flushed by a trap
+localparam HPM_EVENT_ITLB_MISS  = 9;   // I-TLB miss (L2 TLB probe or walk)
+localparam HPM_EVENT_DTLB_MISS  = 10;  // D-TLB miss (L2 TLB probe or walk)
+localparam HPM_NUM_EVENTS       = 10;  // Width of the event vector
+
 // =============================================================================
 // CSR Instruction Opcodes (funct3 field)
 // =============================================================================
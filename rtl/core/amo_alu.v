@@ -0,0 +1,70 @@
+// amo_alu.v - AMO Read-Modify-Write Datapath
+// Computes the value an AMO writes back from the loaded memory value and rs2
+// Author: RV1 Project
+// Date: 2026-10-16
+//
+// Features:
+// - AMOSWAP/ADD/XOR/AND/OR/MIN/MAX/MINU/MAXU (funct5 encoding)
+// - Word operations on RV64 compare the low 32 bits (sign- or zero-extended);
+//   only the low word of the result is written for .W
+// - Shared by atomic_unit.v (in-core AMOs) and dmem_bus_adapter.v (near-memory
+//   AMOs), so both paths compute identical results
+
+`include "config/rv_config.vh"
+
+module amo_alu #(
+  parameter XLEN = `XLEN
+) (
+  input  wire [4:0]      op,          // funct5
+  input  wire            word,        // .W on RV64
+  input  wire [XLEN-1:0] mem_value,   // Value loaded from memory
+  input  wire [XLEN-1:0] src,         // rs2
+  output reg  [XLEN-1:0] result       // Value to store
+);
+
+  localparam [4:0] ATOMIC_SWAP = 5'b00001;
+  localparam [4:0] ATOMIC_ADD  = 5'b00000;
+  localparam [4:0] ATOMIC_XOR  = 5'b00100;
+  localparam [4:0] ATOMIC_AND  = 5'b01100;
+  localparam [4:0] ATOMIC_OR   = 5'b01000;
+  localparam [4:0] ATOMIC_MIN  = 5'b10000;
+  localparam [4:0] ATOMIC_MAX  = 5'b10100;
+  localparam [4:0] ATOMIC_MINU = 5'b11000;
+  localparam [4:0] ATOMIC_MAXU = 5'b11100;
+
+  // For word operations on RV64, mask operands appropriately:
+  // - Signed operations (MIN/MAX): sign-extend from bit 31
+  // - Unsigned operations (MINU/MAXU): zero-extend
+  wire signed [XLEN-1:0] mem_signed, src_signed;
+  wire [XLEN-1:0] mem_unsigned, src_unsigned;
+
+  generate
+    if (XLEN == 64) begin : gen_mask_64
+      assign mem_signed   = word ? {{32{mem_value[31]}}, mem_value[31:0]} : $signed(mem_value);
+      assign src_signed   = word ? {{32{src[31]}}, src[31:0]} : $signed(src);
+      assign mem_unsigned = word ? {{32{1'b0}}, mem_value[31:0]} : mem_value;
+      assign src_unsigned = word ? {{32{1'b0}}, src[31:0]} : src;
+    end else begin : gen_mask_32
+      assign mem_signed   = $signed(mem_value);
+      assign src_signed   = $signed(src);
+      assign mem_unsigned = mem_value;
+      assign src_unsigned = src;
+    end
+  endgenerate
+
+  always @(*) begin
+    case (op)
+      ATOMIC_SWAP: result = src;
+      ATOMIC_ADD:  result = mem_value + src;
+      ATOMIC_XOR:  result = mem_value ^ src;
+      ATOMIC_AND:  result = mem_value & src;
+      ATOMIC_OR:   result = mem_value | src;
+      ATOMIC_MIN:  result = (mem_signed < src_signed) ? mem_value : src;
+      ATOMIC_MAX:  result = (mem_signed > src_signed) ? mem_value : src;
+      ATOMIC_MINU: result = (mem_unsigned < src_unsigned) ? mem_value : src;
+      ATOMIC_MAXU: result = (mem_unsigned > src_unsigned) ? mem_value : src;
+      default:     result = mem_value;
+    endcase
+  end
+
+endmodule
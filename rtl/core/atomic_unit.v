@@ -1,6 +1,8 @@
 // atomic_unit.v - RISC-V A Extension Atomic Operations Unit
 // Implements LR/SC and AMO instructions
 // Part of RV1 RISC-V CPU Core
+// Updated: 2026-10-16 - Near-memory AMOs (ENABLE_NEAR_MEM_AMO): the read carries
+//                       the operation and memory writes the result itself
 
 `include "rtl/config/rv_config.vh"
 
@@ -29,6 +31,9 @@ module atomic_unit #(
     output reg  [2:0] mem_size,         // Memory access size
     input  wire [XLEN-1:0] mem_rdata,   // Memory read data
     input  wire mem_ready,              // Memory ready
+    output wire mem_amo,                // Read is an AMO executed by memory
+    output wire [4:0] mem_amo_op,       // AMO operation (funct5)
+    input  wire near_mem,               // Memory at mem_addr executes AMOs
 
     // Reservation station interface (for LR/SC)
     output reg  lr_valid,               // LR operation valid
@@ -69,7 +74,7 @@ module atomic_unit #(
 
     // Internal registers
     reg [XLEN-1:0] loaded_value;        // Value loaded from memory
-    reg [XLEN-1:0] computed_value;      // Computed result for AMO
+    wire [XLEN-1:0] computed_value;     // Computed result for AMO
     reg [4:0] current_op;               // Current operation
     reg [XLEN-1:0] current_addr;        // Current address
     reg [XLEN-1:0] current_src;         // Current source data
@@ -81,6 +86,10 @@ module atomic_unit #(
     wire is_sc  = (current_op == ATOMIC_SC);
     wire is_amo = !is_lr && !is_sc;
 
+    // AMO sent to memory as a single transaction: memory returns the old
+    // value and writes the new one, so COMPUTE/WRITE/WAIT_WRITE are skipped
+    wire amo_near = is_amo && near_mem;
+
     // Size decoding (funct3: 010=word, 011=doubleword)
     wire is_word = (current_size == 3'b010);
     wire is_dword = (current_size == 3'b011);
@@ -121,6 +130,9 @@ module atomic_unit #(
                         end else begin
                             next_state = STATE_DONE;
                         end
+                    end else if (amo_near) begin
+                        // Near-memory AMO: memory already wrote the result
+                        next_state = STATE_DONE;
                     end else begin
                         // AMO: Compute, then write
                         next_state = STATE_COMPUTE;
@@ -189,11 +201,17 @@ module atomic_unit #(
             STATE_READ: begin
                 mem_req = 1'b1;
                 mem_we = 1'b0;
+                if (amo_near) begin
+                    mem_wdata = current_src;  // Operand for the memory-side ALU
+                end
             end
 
             STATE_WAIT_READ: begin
                 mem_req = 1'b1;
                 mem_we = 1'b0;
+                if (amo_near) begin
+                    mem_wdata = current_src;
+                end
             end
 
             STATE_WRITE: begin
@@ -218,6 +236,9 @@ module atomic_unit #(
         endcase
     end
 
+    assign mem_amo    = amo_near && (state == STATE_READ || state == STATE_WAIT_READ);
+    assign mem_amo_op = current_op;
+
     // Load value from memory
     always @(posedge clk or posedge reset) begin
         if (reset) begin
@@ -227,77 +248,16 @@ module atomic_unit #(
         end
     end
 
-    // AMO computation logic
-    // For word operations on RV64, mask operands appropriately:
-    // - Signed operations (MIN/MAX): sign-extend from bit 31
-    // - Unsigned operations (MINU/MAXU): zero-extend
-    wire signed [XLEN-1:0] loaded_signed, src_signed;
-    wire [XLEN-1:0] loaded_unsigned, src_unsigned;
-
-    generate
-        if (XLEN == 64) begin : gen_mask_64
-            // For signed comparisons: sign-extend word operations
-            assign loaded_signed = is_word ? {{32{loaded_value[31]}}, loaded_value[31:0]} : $signed(loaded_value);
-            assign src_signed = is_word ? {{32{current_src[31]}}, current_src[31:0]} : $signed(current_src);
-
-            // For unsigned comparisons: zero-extend word operations
-            assign loaded_unsigned = is_word ? {{32{1'b0}}, loaded_value[31:0]} : loaded_value;
-            assign src_unsigned = is_word ? {{32{1'b0}}, current_src[31:0]} : current_src;
-        end else begin : gen_mask_32
-            assign loaded_signed = $signed(loaded_value);
-            assign src_signed = $signed(current_src);
-            assign loaded_unsigned = loaded_value;
-            assign src_unsigned = current_src;
-        end
-    endgenerate
-
-    always @(*) begin
-        computed_value = loaded_value;  // Default: no change
-
-        case (current_op)
-            ATOMIC_SWAP: begin
-                computed_value = current_src;
-            end
-
-            ATOMIC_ADD: begin
-                computed_value = loaded_value + current_src;
-            end
-
-            ATOMIC_XOR: begin
-                computed_value = loaded_value ^ current_src;
-            end
-
-            ATOMIC_AND: begin
-                computed_value = loaded_value & current_src;
-            end
-
-            ATOMIC_OR: begin
-                computed_value = loaded_value | current_src;
-            end
-
-            ATOMIC_MIN: begin
-                computed_value = (loaded_signed < src_signed) ? loaded_value : current_src;
-            end
-
-            ATOMIC_MAX: begin
-                computed_value = (loaded_signed > src_signed) ? loaded_value : current_src;
-            end
-
-            ATOMIC_MINU: begin
-                // Use zero-extended values for unsigned comparison (handles RV64 word operations)
-                computed_value = (loaded_unsigned < src_unsigned) ? loaded_value : current_src;
-            end
-
-            ATOMIC_MAXU: begin
-                // Use zero-extended values for unsigned comparison (handles RV64 word operations)
-                computed_value = (loaded_unsigned > src_unsigned) ? loaded_value : current_src;
-            end
-
-            default: begin
-                computed_value = loaded_value;
-            end
-        endcase
-    end
+    // AMO computation logic (shared with the near-memory path)
+    amo_alu #(
+        .XLEN(XLEN)
+    ) amo_alu_inst (
+        .op(current_op),
+        .word(is_word),
+        .mem_value(loaded_value),
+        .src(current_src),
+        .result(computed_value)
+    );
 
     // LR/SC reservation signals
     always @(*) begin
@@ -322,7 +282,8 @@ module atomic_unit #(
                 end
                 `ifdef DEBUG_ATOMIC
                 if (is_lr) $display("[ATOMIC] LR @ 0x%08h -> 0x%08h", current_addr, mem_rdata);
-                if (is_amo) $display("[ATOMIC] AMO @ 0x%08h -> 0x%08h (op=%d)", current_addr, mem_rdata, current_op);
+                if (is_amo) $display("[ATOMIC] AMO @ 0x%08h -> 0x%08h (op=%d%s)", current_addr, mem_rdata, current_op,
+                                     amo_near ? ", near-memory" : "");
                 `endif
             end else if (is_sc) begin
                 // SC returns 0 on success, 1 on failure
@@ -0,0 +1,260 @@
+// branch_predictor.v - Dynamic Branch Predictor (BHT + BTB)
+// Predicts the next fetch PC in the IF stage so that correctly predicted
+// taken branches/jumps do not pay the EX-stage redirect penalty
+// BHT: 2-bit saturating counters indexed by gshare (PC ^ history) or PC only (bimodal)
+// BTB: direct-mapped, partially tagged, holds target and branch/jump/call/return type
+// RAS: return address stack, pushed/popped speculatively in IF and repaired
+//      from a committed copy of the stack pointer on misprediction or trap/xRET
+// Author: RV1 Project
+// Date: 2026-10-16
+// Updated: 2026-10-16 - Coroutine swap (pop then push) entry type
+
+`include "config/rv_config.vh"
+
+module branch_predictor #(
+  parameter XLEN         = `XLEN,
+  parameter ENABLE       = `ENABLE_BRANCH_PRED,
+  parameter BHT_ENTRIES  = `BP_BHT_ENTRIES,   // Power of 2
+  parameter BTB_ENTRIES  = `BP_BTB_ENTRIES,   // Power of 2
+  parameter BTB_TAG_BITS = `BP_BTB_TAG_BITS,
+  parameter GHR_BITS     = `BP_GHR_BITS,      // 0 = bimodal, 1..16 = gshare
+  parameter RAS_DEPTH    = `BP_RAS_DEPTH      // Power of 2
+) (
+  input  wire             clk,
+  input  wire             reset_n,
+
+  // IF stage lookup (combinational)
+  input  wire [XLEN-1:0]  if_pc,
+  output wire             pred_taken,        // Redirect fetch to pred_target
+  output wire [XLEN-1:0]  pred_target,
+  output wire [31:0]      pred_meta,         // Predictor state snapshot, carried down the pipeline
+  input  wire             if_advance,        // Fetch PC advances this cycle (no stall/redirect)
+  input  wire [XLEN-1:0]  if_link_addr,      // Return address of the fetched instruction (PC+2/PC+4)
+
+  // EX stage resolution (one pulse per resolved branch/jump or mispredicted instruction)
+  input  wire             update_valid,
+  input  wire [XLEN-1:0]  update_pc,
+  input  wire             update_is_branch,  // Conditional branch (trains BHT)
+  input  wire             update_is_jump,    // JAL/JALR (always taken)
+  input  wire             update_is_call,    // Jump linking to ra/t0
+  input  wire             update_is_ret,     // JALR through ra/t0 without link
+  input  wire [XLEN-1:0]  update_link_addr,  // Return address of the resolved instruction
+  input  wire             update_taken,
+  input  wire [XLEN-1:0]  update_target,
+  input  wire [31:0]      update_meta,       // pred_meta captured at lookup time
+  input  wire             update_mispredict,
+
+  // Pipeline flush (trap/xRET): discard speculative RAS updates
+  input  wire             flush_restore,
+
+  // Statistics (prediction accuracy)
+  output reg  [31:0]      stat_branches,     // Resolved conditional branches
+  output reg  [31:0]      stat_branch_miss,  // Mispredicted conditional branches
+  output reg  [31:0]      stat_jumps,        // Resolved JAL/JALR
+  output reg  [31:0]      stat_jump_miss     // Mispredicted JAL/JALR (target miss)
+);
+
+  // =========================================================================
+  // Index / Tag Extraction
+  // =========================================================================
+  // PC bit 0 is always zero; bit 1 is kept so RVC instructions sharing a
+  // word get distinct entries
+
+  localparam BHT_IDX_BITS = $clog2(BHT_ENTRIES);
+  localparam BTB_IDX_BITS = $clog2(BTB_ENTRIES);
+  localparam HIST_BITS    = (GHR_BITS > BHT_IDX_BITS) ? BHT_IDX_BITS : GHR_BITS;
+
+  localparam RAS_PTR_BITS = (RAS_DEPTH > 1) ? $clog2(RAS_DEPTH) : 1;
+
+  // Counter encoding
+  localparam WEAK_NT = 2'b01;
+
+  // BTB entry types
+  localparam BTB_BRANCH = 3'b000;  // Conditional: direction from BHT
+  localparam BTB_JUMP   = 3'b001;  // JAL/JALR: always taken, target from BTB
+  localparam BTB_CALL   = 3'b010;  // Linking jump: always taken, pushes RAS
+  localparam BTB_RET    = 3'b011;  // Return: always taken, target from RAS
+  localparam BTB_SWAP   = 3'b100;  // Coroutine swap: target from RAS, pops then pushes
+
+  function [BHT_IDX_BITS-1:0] bht_index;
+    input [XLEN-1:0] pc;
+    input [15:0]     hist;
+    begin
+      bht_index = pc[BHT_IDX_BITS:1];
+      if (HIST_BITS > 0)
+        bht_index = bht_index ^ hist[BHT_IDX_BITS-1:0];
+    end
+  endfunction
+
+  function [BTB_IDX_BITS-1:0] btb_index;
+    input [XLEN-1:0] pc;
+    begin
+      btb_index = pc[BTB_IDX_BITS:1];
+    end
+  endfunction
+
+  function [BTB_TAG_BITS-1:0] btb_tag;
+    input [XLEN-1:0] pc;
+    begin
+      btb_tag = pc[BTB_IDX_BITS+BTB_TAG_BITS:BTB_IDX_BITS+1];
+    end
+  endfunction
+
+  // =========================================================================
+  // Storage
+  // =========================================================================
+
+  reg [1:0]              bht        [0:BHT_ENTRIES-1];
+  reg                    btb_valid  [0:BTB_ENTRIES-1];
+  reg [BTB_TAG_BITS-1:0] btb_tags   [0:BTB_ENTRIES-1];
+  reg [XLEN-1:0]         btb_target [0:BTB_ENTRIES-1];
+  reg [2:0]              btb_type   [0:BTB_ENTRIES-1];
+
+  // Return address stack (circular; overflow overwrites the oldest entry)
+  // ras_ptr is the speculative top (IF), ras_commit_ptr tracks instructions
+  // that have left EX and is used to repair ras_ptr
+  reg [XLEN-1:0]         ras        [0:RAS_DEPTH-1];
+  reg [RAS_PTR_BITS-1:0] ras_ptr;          // Next free slot
+  reg [RAS_PTR_BITS-1:0] ras_commit_ptr;
+
+  // Global history of resolved conditional branches (non-speculative)
+  reg [15:0] ghr;
+  wire [15:0] ghr_masked = (HIST_BITS > 0) ? (ghr & ((16'd1 << HIST_BITS) - 16'd1)) : 16'd0;
+
+  // =========================================================================
+  // Lookup (IF stage)
+  // =========================================================================
+
+  wire [BTB_IDX_BITS-1:0] if_btb_idx = btb_index(if_pc);
+  wire [BHT_IDX_BITS-1:0] if_bht_idx = bht_index(if_pc, ghr_masked);
+
+  wire if_btb_hit = btb_valid[if_btb_idx] && (btb_tags[if_btb_idx] == btb_tag(if_pc));
+  wire if_bht_taken = bht[if_bht_idx][1];
+  wire [2:0] if_type = btb_type[if_btb_idx];
+
+  wire [RAS_PTR_BITS-1:0] ras_top_idx = ras_ptr - 1'b1;
+
+  assign pred_taken  = ENABLE && if_btb_hit && ((if_type != BTB_BRANCH) || if_bht_taken);
+  assign pred_target = ((if_type == BTB_RET) || (if_type == BTB_SWAP)) ? ras[ras_top_idx] :
+                                                                           btb_target[if_btb_idx];
+  assign pred_meta   = {16'd0, ghr_masked};
+
+  // Speculative RAS operations for the instruction being fetched
+  wire if_ras_push = pred_taken && if_advance && (if_type == BTB_CALL);
+  wire if_ras_pop  = pred_taken && if_advance && (if_type == BTB_RET);
+  wire if_ras_swap = pred_taken && if_advance && (if_type == BTB_SWAP);
+
+  // =========================================================================
+  // Update (EX stage)
+  // =========================================================================
+
+  wire [BHT_IDX_BITS-1:0] up_bht_idx = bht_index(update_pc, update_meta[15:0]);
+  wire [BTB_IDX_BITS-1:0] up_btb_idx = btb_index(update_pc);
+  wire [1:0]              up_ctr     = bht[up_bht_idx];
+
+  integer i;
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      for (i = 0; i < BHT_ENTRIES; i = i + 1)
+        bht[i] <= WEAK_NT;
+      for (i = 0; i < BTB_ENTRIES; i = i + 1) begin
+        btb_valid[i]  <= 1'b0;
+        btb_tags[i]   <= {BTB_TAG_BITS{1'b0}};
+        btb_target[i] <= {XLEN{1'b0}};
+        btb_type[i]   <= BTB_BRANCH;
+      end
+      for (i = 0; i < RAS_DEPTH; i = i + 1)
+        ras[i] <= {XLEN{1'b0}};
+      ras_ptr          <= {RAS_PTR_BITS{1'b0}};
+      ras_commit_ptr   <= {RAS_PTR_BITS{1'b0}};
+      ghr              <= 16'd0;
+      stat_branches    <= 32'd0;
+      stat_branch_miss <= 32'd0;
+      stat_jumps       <= 32'd0;
+      stat_jump_miss   <= 32'd0;
+    end else if (ENABLE) begin
+      // RAS: committed pointer follows instructions leaving EX. A misprediction
+      // flushes everything younger, so the speculative pointer is rebuilt from
+      // the committed one (including this instruction's own push/pop). A
+      // coroutine swap (call and return) pops then pushes: depth unchanged
+      if (update_valid && update_is_call && !update_is_ret)
+        ras_commit_ptr <= ras_commit_ptr + 1'b1;
+      else if (update_valid && update_is_ret && !update_is_call)
+        ras_commit_ptr <= ras_commit_ptr - 1'b1;
+
+      if (flush_restore) begin
+        ras_ptr <= ras_commit_ptr;
+      end else if (update_valid && update_mispredict) begin
+        if (update_is_call && update_is_ret) begin
+          ras[ras_commit_ptr - 1'b1] <= update_link_addr;
+          ras_ptr <= ras_commit_ptr;
+        end else if (update_is_call) begin
+          ras[ras_commit_ptr] <= update_link_addr;
+          ras_ptr <= ras_commit_ptr + 1'b1;
+        end else if (update_is_ret) begin
+          ras_ptr <= ras_commit_ptr - 1'b1;
+        end else begin
+          ras_ptr <= ras_commit_ptr;
+        end
+      end else if (if_ras_push) begin
+        ras[ras_ptr] <= if_link_addr;
+        ras_ptr <= ras_ptr + 1'b1;
+      end else if (if_ras_pop) begin
+        ras_ptr <= ras_ptr - 1'b1;
+      end else if (if_ras_swap) begin
+        ras[ras_top_idx] <= if_link_addr;
+      end
+
+      if (update_valid) begin
+        // BHT: saturating counter, conditional branches only
+        if (update_is_branch) begin
+          if (update_taken && up_ctr != 2'b11)
+            bht[up_bht_idx] <= up_ctr + 2'b01;
+          else if (!update_taken && up_ctr != 2'b00)
+            bht[up_bht_idx] <= up_ctr - 2'b01;
+          ghr <= {ghr[14:0], update_taken};
+        end
+
+        // BTB: allocate/refresh on taken, leave entry on not-taken so the BHT
+        // can still predict the next occurrence
+        if (update_taken) begin
+          btb_valid[up_btb_idx]  <= 1'b1;
+          btb_tags[up_btb_idx]   <= btb_tag(update_pc);
+          btb_target[up_btb_idx] <= update_target;
+          btb_type[up_btb_idx]   <= !update_is_jump ? BTB_BRANCH :
+                                    (update_is_call && update_is_ret) ? BTB_SWAP :
+                                    update_is_call  ? BTB_CALL :
+                                    update_is_ret   ? BTB_RET : BTB_JUMP;
+        end else if (!update_is_branch && !update_is_jump) begin
+          // Stale hit on a non-control-flow instruction (e.g. after FENCE.I)
+          btb_valid[up_btb_idx] <= 1'b0;
+        end
+
+        // Statistics
+        if (update_is_branch) begin
+          stat_branches <= stat_branches + 1;
+          if (update_mispredict)
+            stat_branch_miss <= stat_branch_miss + 1;
+        end
+        if (update_is_jump) begin
+          stat_jumps <= stat_jumps + 1;
+          if (update_mispredict)
+            stat_jump_miss <= stat_jump_miss + 1;
+        end
+      end
+    end
+  end
+
+  `ifdef DEBUG_BPRED
+  always @(posedge clk) begin
+    if (reset_n && pred_taken)
+      $display("[BPRED] Predict PC=0x%h -> 0x%h (type=%b ctr=%b ras_ptr=%0d)",
+               if_pc, pred_target, if_type, bht[if_bht_idx], ras_ptr);
+    if (reset_n && update_valid)
+      $display("[BPRED] Resolve PC=0x%h br=%b jmp=%b taken=%b tgt=0x%h mispredict=%b",
+               update_pc, update_is_branch, update_is_jump, update_taken, update_target,
+               update_mispredict);
+  end
+  `endif
+
+endmodule
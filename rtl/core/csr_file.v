@@ -3,12 +3,17 @@
 // Supports CSR instructions: CSRRW, CSRRS, CSRRC, CSRRWI, CSRRSI, CSRRCI
 // Supports trap handling: exception entry and MRET
 // Parameterized for RV32/RV64
+// Updated: 2026-10-16 - Counters: mcycle/minstret/time, HPM_COUNTERS event
+//                       counters with mhpmevent, mcountinhibit, and the
+//                       user-level shadows gated by mcounteren/scounteren
 
 `include "config/rv_config.vh"
 `include "config/rv_csr_defines.vh"
 
 module csr_file #(
-  parameter XLEN = `XLEN
+  parameter XLEN = `XLEN,
+  parameter HART_ID = 0,
+  parameter HPM_COUNTERS = `HPM_COUNTERS  // mhpmcounter3.. implemented (0-29)
 ) (
   input  wire             clk,
   input  wire             reset_n,
@@ -77,7 +82,12 @@ module csr_file #(
   // Interrupt status outputs (for interrupt handling in core)
   output wire [XLEN-1:0]  mip_out,        // Machine Interrupt Pending register
   output wire [XLEN-1:0]  mie_out,        // Machine Interrupt Enable register
-  output wire [XLEN-1:0]  mideleg_out     // Machine Interrupt Delegation register
+  output wire [XLEN-1:0]  mideleg_out,    // Machine Interrupt Delegation register
+
+  // Performance counters
+  input  wire [1:0]       instret_inc,    // Instructions retired this cycle (2 with dual issue)
+  input  wire [HPM_NUM_EVENTS-1:0] hpm_events, // Bit n-1 = event HPM_EVENT_* n this cycle
+  input  wire [63:0]      mtime_in        // CLINT mtime (time/timeh CSRs)
 );
 
   // =========================================================================
@@ -151,6 +161,20 @@ module csr_file #(
   // Trap handling state
   reg trap_taken_r;            // Flag to prevent multiple trap entries in same cycle
 
+  // Counters (64-bit on both RV32 and RV64; RV32 reaches the upper half
+  // through the *h CSRs)
+  localparam HPM_N = (HPM_COUNTERS > 0) ? HPM_COUNTERS : 1;  // Array size
+  reg [63:0] mcycle_r;
+  reg [63:0] minstret_r;
+  reg [63:0] mhpmcounter_r [0:HPM_N-1];  // mhpmcounter3 + i
+  reg [4:0]  mhpmevent_r   [0:HPM_N-1];  // Event number, 0 = none
+  reg [31:0] mcountinhibit_r;  // Bit n stops counter n (CY=0, IR=2, HPMn)
+  reg [31:0] mcounteren_r;     // Bit n: counter n readable in S-mode
+  reg [31:0] scounteren_r;     // Bit n: counter n readable in U-mode
+
+  // Writable mcountinhibit bits: CY, IR and the implemented HPM counters
+  localparam [31:0] CNT_INHIBIT_MASK = ((64'h1 << (3 + HPM_COUNTERS)) - 1) & ~32'h2;
+
   // =========================================================================
   // Read-Only CSRs (hardwired)
   // =========================================================================
@@ -164,8 +188,8 @@ module csr_file #(
   // Implementation ID: 1 = RV1 implementation
   wire [XLEN-1:0] mimpid = {{(XLEN-1){1'b0}}, 1'b1};
 
-  // Hardware Thread ID: 0 = single-threaded
-  wire [XLEN-1:0] mhartid = {XLEN{1'b0}};
+  // Hardware Thread ID (0 on single-hart systems)
+  wire [XLEN-1:0] mhartid = HART_ID;
 
   // =========================================================================
   // CSR Read Logic
@@ -210,6 +234,39 @@ module csr_file #(
     end
   endgenerate
 
+  // Counter CSRs: the low 5 address bits select counter n in every bank
+  //   0xB00-0xB1F mcycle/minstret/mhpmcounterN   0xB80-0xB9F upper halves (RV32)
+  //   0xC00-0xC1F cycle/time/instret/hpmcounterN 0xC80-0xC9F upper halves (RV32)
+  //   0x323-0x33F mhpmevent3-31
+  // mhpmcounter/mhpmevent above 2+HPM_COUNTERS exist and read as zero
+  wire [4:0] cnt_idx       = csr_addr[4:0];
+  wire       cnt_hpm       = (cnt_idx >= 5'd3) && (cnt_idx < 3 + HPM_COUNTERS);
+  wire       cnt_is_mcnt   = (csr_addr[11:5] == 7'b1011_000) && (cnt_idx != 5'd1);
+  wire       cnt_is_mcnth  = (csr_addr[11:5] == 7'b1011_100) && (cnt_idx != 5'd1) && (XLEN == 32);
+  wire       cnt_is_ucnt   = (csr_addr[11:5] == 7'b1100_000);
+  wire       cnt_is_ucnth  = (csr_addr[11:5] == 7'b1100_100) && (XLEN == 32);
+  wire       cnt_is_event  = (csr_addr[11:5] == 7'b0011_001) && (cnt_idx >= 5'd3);
+
+  reg [63:0] cnt_value;
+  always @(*) begin
+    case (cnt_idx)
+      5'd0:    cnt_value = mcycle_r;
+      5'd1:    cnt_value = mtime_in;
+      5'd2:    cnt_value = minstret_r;
+      default: cnt_value = cnt_hpm ? mhpmcounter_r[cnt_idx - 3] : 64'h0;
+    endcase
+  end
+
+  wire [XLEN-1:0] cnt_rdata =
+    (cnt_is_mcnt  || cnt_is_ucnt)  ? cnt_value[XLEN-1:0] :
+    (cnt_is_mcnth || cnt_is_ucnth) ? {{(XLEN-32){1'b0}}, cnt_value[63:32]} :
+    (cnt_is_event && cnt_hpm)      ? {{(XLEN-5){1'b0}}, mhpmevent_r[cnt_idx - 3]} :
+                                     {XLEN{1'b0}};
+
+  // User-level counters: S-mode needs mcounteren[n], U-mode also scounteren[n]
+  wire cnt_user_ok = (current_priv == PRIV_M_MODE) ||
+                     (mcounteren_r[cnt_idx] && ((current_priv == PRIV_S_MODE) || scounteren_r[cnt_idx]));
+
   always @(*) begin
     case (csr_addr)
       // Machine-mode CSRs
@@ -235,6 +292,8 @@ module csr_file #(
       CSR_MARCHID:   csr_rdata = {{(XLEN-32){1'b0}}, marchid};    // Zero-extend to XLEN
       CSR_MIMPID:    csr_rdata = {{(XLEN-32){1'b0}}, mimpid};     // Zero-extend to XLEN
       CSR_MHARTID:   csr_rdata = {{(XLEN-32){1'b0}}, mhartid};    // Zero-extend to XLEN
+      CSR_MCOUNTEREN:    csr_rdata = {{(XLEN-32){1'b0}}, mcounteren_r};
+      CSR_MCOUNTINHIBIT: csr_rdata = {{(XLEN-32){1'b0}}, mcountinhibit_r};
       // Supervisor-mode CSRs
       CSR_SSTATUS:   csr_rdata = sstatus_value;
       CSR_SIE:       csr_rdata = sie_value;
@@ -245,6 +304,7 @@ module csr_file #(
       CSR_STVAL:     csr_rdata = stval_r;
       CSR_SIP:       csr_rdata = sip_value;
       CSR_SATP:      csr_rdata = satp_r;
+      CSR_SCOUNTEREN: csr_rdata = {{(XLEN-32){1'b0}}, scounteren_r};
       // Floating-point CSRs
       CSR_FFLAGS:    begin
         // Forward new flags if being accumulated in same cycle (WB stage hazard)
@@ -259,7 +319,7 @@ module csr_file #(
         // Forward new flags if being accumulated in same cycle (WB stage hazard)
         csr_rdata = {{(XLEN-8){1'b0}}, frm_r, (fflags_we ? (fflags_r | fflags_in) : fflags_r)};
       end
-      default:       csr_rdata = {XLEN{1'b0}};  // Return 0 for unknown CSRs
+      default:       csr_rdata = cnt_rdata;     // Counters/mhpmevent, 0 for unknown CSRs
     endcase
   end
 
@@ -321,16 +381,23 @@ module csr_file #(
                     (csr_addr == CSR_FFLAGS) ||
                     (csr_addr == CSR_FRM) ||
                     (csr_addr == CSR_FCSR) ||
+                    (csr_addr == CSR_MCOUNTEREN) ||
+                    (csr_addr == CSR_MCOUNTINHIBIT) ||
+                    (csr_addr == CSR_SCOUNTEREN) ||
+                    cnt_is_mcnt || cnt_is_mcnth || cnt_is_event ||
+                    cnt_is_ucnt || cnt_is_ucnth ||
                     csr_is_test;  // Accept test CSRs
 
   // Illegal CSR access conditions:
   // 1. CSR doesn't exist
   // 2. Privilege level too low to access CSR
   // 3. Attempting to write to read-only CSR
+  // 4. User-level counter not enabled by mcounteren/scounteren
   //
   // Note: Privilege and existence checks apply to both reads and writes (csr_access).
   // Read-only check only applies to writes (csr_we).
-  assign illegal_csr = csr_access && ((!csr_exists) || (!csr_priv_ok) || (csr_we && csr_read_only));
+  assign illegal_csr = csr_access && ((!csr_exists) || (!csr_priv_ok) || (csr_we && csr_read_only) ||
+                                      ((cnt_is_ucnt || cnt_is_ucnth) && !cnt_user_ok));
 
   `ifdef DEBUG_CSR
   always @(posedge clk) begin
@@ -574,6 +641,85 @@ module csr_file #(
     end
   end
 
+  // =========================================================================
+  // Performance Counters
+  // =========================================================================
+  // mcycle counts every cycle, minstret every instruction leaving WB, and
+  // mhpmcounterN every cycle its selected event is set. A CSR write to a
+  // counter wins over that cycle's increment. Reads happen in EX, so minstret
+  // does not yet include the (at most two) older instructions in MEM/WB.
+
+  wire cnt_write = csr_we && !csr_read_only && !trap_entry && !mret && !sret;
+
+  wire [HPM_NUM_EVENTS:0] hpm_event_vec = {hpm_events, 1'b0};  // Event 0 never fires
+
+  // Replace the low XLEN bits (whole counter on RV64) or the upper half
+  function [63:0] cnt_write_lo;
+    input [63:0]     cur;
+    input [XLEN-1:0] val;
+    begin
+      cnt_write_lo = cur;
+      cnt_write_lo[XLEN-1:0] = val;
+    end
+  endfunction
+
+  function [63:0] cnt_write_hi;
+    input [63:0]     cur;
+    input [XLEN-1:0] val;
+    begin
+      cnt_write_hi = {val[31:0], cur[31:0]};
+    end
+  endfunction
+
+  integer h;  // counter bank
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      mcycle_r        <= 64'h0;
+      minstret_r      <= 64'h0;
+      mcountinhibit_r <= 32'h0;
+      mcounteren_r    <= 32'h0;
+      scounteren_r    <= 32'h0;
+      for (h = 0; h < HPM_N; h = h + 1) begin
+        mhpmcounter_r[h] <= 64'h0;
+        mhpmevent_r[h]   <= 5'd0;
+      end
+    end else begin
+      // Increments
+      if (!mcountinhibit_r[0])
+        mcycle_r <= mcycle_r + 64'd1;
+      if (!mcountinhibit_r[2])
+        minstret_r <= minstret_r + {62'h0, instret_inc};
+      for (h = 0; h < HPM_COUNTERS; h = h + 1) begin
+        if (!mcountinhibit_r[h + 3] && hpm_event_vec[mhpmevent_r[h]])
+          mhpmcounter_r[h] <= mhpmcounter_r[h] + 64'd1;
+      end
+
+      // CSR writes (after the increments, so they take priority)
+      if (cnt_write) begin
+        if (csr_addr == CSR_MCOUNTEREN)    mcounteren_r    <= csr_write_value[31:0];
+        if (csr_addr == CSR_SCOUNTEREN)    scounteren_r    <= csr_write_value[31:0];
+        if (csr_addr == CSR_MCOUNTINHIBIT) mcountinhibit_r <= csr_write_value[31:0] & CNT_INHIBIT_MASK;
+        if (cnt_is_mcnt) begin
+          if (cnt_idx == 5'd0) mcycle_r   <= cnt_write_lo(mcycle_r, csr_write_value);
+          if (cnt_idx == 5'd2) minstret_r <= cnt_write_lo(minstret_r, csr_write_value);
+        end
+        if (cnt_is_mcnth) begin
+          if (cnt_idx == 5'd0) mcycle_r   <= cnt_write_hi(mcycle_r, csr_write_value);
+          if (cnt_idx == 5'd2) minstret_r <= cnt_write_hi(minstret_r, csr_write_value);
+        end
+        for (h = 0; h < HPM_COUNTERS; h = h + 1) begin
+          if (cnt_idx == h + 3) begin
+            if (cnt_is_mcnt)  mhpmcounter_r[h] <= cnt_write_lo(mhpmcounter_r[h], csr_write_value);
+            if (cnt_is_mcnth) mhpmcounter_r[h] <= cnt_write_hi(mhpmcounter_r[h], csr_write_value);
+            // WARL: unsupported event numbers read back as 0
+            if (cnt_is_event)
+              mhpmevent_r[h] <= (csr_write_value <= HPM_NUM_EVENTS) ? csr_write_value[4:0] : 5'd0;
+          end
+        end
+      end
+    end
+  end
+
   // =========================================================================
   // Trap Target Privilege Determination (Phase 2)
   // =========================================================================
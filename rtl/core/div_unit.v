@@ -2,11 +2,16 @@
 // Implements DIV, DIVU, REM, REMU instructions
 // Based on PicoRV32's proven division algorithm
 // Parameterized for RV32/RV64 support
+// RADIX = 4 (`DIV_RADIX) retires two quotient bits per cycle, starts at the
+// highest possible quotient digit (leading-zero early termination) and
+// finishes divide-by-zero, |divisor| == 1 (incl. signed overflow) and
+// |dividend| < |divisor| without iterating
 
 `include "config/rv_config.vh"
 
 module div_unit #(
-  parameter XLEN = `XLEN
+  parameter XLEN  = `XLEN,
+  parameter RADIX = `DIV_RADIX   // 2 = one bit per cycle, 4 = two bits per cycle
 )(
   input  wire                clk,
   input  wire                reset_n,
@@ -90,6 +95,42 @@ module div_unit #(
   // Busy signal: high when running
   assign busy = running;
 
+  // Radix-4 datapath: pick quotient digit 0..3 by comparing the partial
+  // remainder with 1x, 2x and 3x the aligned divisor in parallel
+  wire [2*XLEN:0] r4_d1  = {2'b00, divisor_reg};
+  wire [2*XLEN:0] r4_d2  = r4_d1 << 1;
+  wire [2*XLEN:0] r4_d3  = r4_d1 + r4_d2;
+  wire [2*XLEN:0] r4_rem = {{(XLEN+1){1'b0}}, dividend_reg};
+
+  wire [1:0]      r4_digit = (r4_rem >= r4_d3) ? 2'd3 :
+                             (r4_rem >= r4_d2) ? 2'd2 :
+                             (r4_rem >= r4_d1) ? 2'd1 : 2'd0;
+  wire [XLEN-1:0] r4_sub   = (r4_digit == 2'd3) ? r4_d3[XLEN-1:0] :
+                             (r4_digit == 2'd2) ? r4_d2[XLEN-1:0] :
+                             (r4_digit == 2'd1) ? r4_d1[XLEN-1:0] : {XLEN{1'b0}};
+
+  // Early termination: the quotient has at most clz(divisor) - clz(dividend) + 1
+  // significant bits, so the first digit is placed there (rounded up to an even
+  // bit so the last digit lands on bit 0)
+  function [7:0] clz;
+    input [XLEN-1:0] value;
+    integer b;
+    begin
+      clz = XLEN;
+      for (b = 0; b < XLEN; b = b + 1)
+        if (value[b])
+          clz = XLEN - 1 - b;
+    end
+  endfunction
+
+  wire [7:0] r4_shift_raw = clz(abs_divisor) - clz(abs_dividend);
+  wire [7:0] r4_shift     = r4_shift_raw + {7'b0, r4_shift_raw[0]};
+
+  // Fast paths (radix-4 mode)
+  wire div_by_zero  = (masked_divisor == {XLEN{1'b0}});
+  wire div_by_one   = (abs_divisor == {{(XLEN-1){1'b0}}, 1'b1});  // Also covers signed overflow
+  wire div_small    = (abs_dividend < abs_divisor);
+
   // Datapath (PicoRV32-inspired algorithm)
   always @(posedge clk or negedge reset_n) begin
     if (!reset_n) begin
@@ -119,9 +160,26 @@ module div_unit #(
         quotient     <= {XLEN{1'b0}};
         quotient_msk <= {1'b1, {(XLEN-1){1'b0}}};  // Start with MSB set
 
+        if (RADIX == 4) begin
+          if (div_by_zero) begin
+            // Quotient all ones, remainder = dividend (outsign restores its sign)
+            quotient     <= {XLEN{1'b1}};
+            quotient_msk <= {XLEN{1'b0}};
+          end else if (div_by_one) begin
+            quotient     <= abs_dividend;
+            dividend_reg <= {XLEN{1'b0}};
+            quotient_msk <= {XLEN{1'b0}};
+          end else if (div_small) begin
+            quotient_msk <= {XLEN{1'b0}};
+          end else begin
+            divisor_reg  <= abs_divisor << r4_shift;
+            quotient_msk <= {{(XLEN-1){1'b0}}, 1'b1} << r4_shift;  // LSB of the first digit
+          end
+        end
+
         // Calculate output sign (for DIV: signs differ AND divisor != 0, for REM: dividend sign)
         if (div_op == DIV)
-          outsign <= (sign_dividend != sign_divisor) && (divisor != {XLEN{1'b0}});
+          outsign <= (sign_dividend != sign_divisor) && !div_by_zero;
         else if (div_op == REM)
           outsign <= sign_dividend;
         else
@@ -130,11 +188,24 @@ module div_unit #(
         `ifdef DEBUG_DIV
         $display("[DIV] Start: op=%b dividend=%h (%h) divisor=%h (%h) outsign=%b",
                  div_op, dividend, abs_dividend, divisor, abs_divisor,
-                 (div_op == DIV) ? ((sign_dividend != sign_divisor) && (divisor != {XLEN{1'b0}})) :
+                 (div_op == DIV) ? ((sign_dividend != sign_divisor) && !div_by_zero) :
                  (div_op == REM) ? sign_dividend : 1'b0);
         `endif
       end
       // Division computation (runs when quotient_msk != 0)
+      else if (quotient_msk != {XLEN{1'b0}} && running && RADIX == 4) begin
+        // Radix-4: retire one two-bit digit per cycle
+        dividend_reg <= dividend_reg - r4_sub;
+        quotient     <= quotient | (r4_digit[1] ? (quotient_msk << 1) : {XLEN{1'b0}})
+                                 | (r4_digit[0] ? quotient_msk : {XLEN{1'b0}});
+        divisor_reg  <= divisor_reg >> 2;
+        quotient_msk <= quotient_msk >> 2;
+
+        `ifdef DEBUG_DIV_STEPS
+        $display("[DIV_STEP] radix-4: divisor=%h dividend=%h digit=%0d quotient_msk=%h",
+                 divisor_reg, dividend_reg, r4_digit, quotient_msk);
+        `endif
+      end
       else if (quotient_msk != {XLEN{1'b0}} && running) begin
         // PicoRV32 algorithm: compare divisor (63-bit) with dividend (32-bit, zero-extended)
         // Verilog will zero-extend dividend_reg to 63 bits for comparison
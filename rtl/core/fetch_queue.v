@@ -0,0 +1,137 @@
+// fetch_queue.v - Instruction Fetch Queue
+// Decouples instruction fetch from decode: a fetch PC runs ahead of the IF PC
+// and fills a small halfword queue while decode is stalled
+// Features:
+//   - DEPTH halfword entries (4-8); each fetch pushes 1, 2 or 4 halfwords
+//     (1 after a redirect to an odd halfword, 4 when a 64-bit bundle is available)
+//   - Fetched data is visible to decode in the same cycle (no added latency
+//     after a redirect), so the queue only ever adds slack, never delay
+//   - Head presents 32 bits for the IF-stage RVC logic; compressed and 32-bit
+//     instructions are realigned from the queue at any halfword offset
+//   - Next two words at the head for dual-issue bundles
+//   - Fetch page fault is queued behind the fetched halfwords and reported
+//     when decode reaches it; fetching stops until the next redirect
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`include "config/rv_config.vh"
+
+module fetch_queue #(
+  parameter XLEN         = `XLEN,
+  parameter DEPTH        = 8,                   // Halfword entries
+  parameter RESET_VECTOR = {XLEN{1'b0}}
+)(
+  input  wire             clk,
+  input  wire             reset_n,
+
+  // Fetch side
+  output wire [XLEN-1:0]  fetch_addr,           // Virtual address to fetch
+  output wire             fetch_req,            // Room for a fetch this cycle
+  input  wire             fetch_valid,          // fetch_data valid (translated, hit)
+  input  wire [31:0]      fetch_data,           // 32 bits at fetch_addr
+  input  wire             fetch_next_valid,     // fetch_next valid (word-aligned fetch only)
+  input  wire [31:0]      fetch_next,           // 32 bits at fetch_addr + 4
+  input  wire             fetch_fault,          // Page fault on fetch_addr
+  input  wire [XLEN-1:0]  fetch_fault_vaddr,
+
+  // Decode side
+  output wire             head_valid,           // Complete instruction at the head
+  output wire [31:0]      head_instr,           // 32 bits at the IF PC
+  output wire             head_next_valid,      // head_next valid (4 halfwords present)
+  output wire [31:0]      head_next,            // 32 bits at the IF PC + 4
+  output wire             head_fault,           // Decode reached a fetch page fault
+  output wire [XLEN-1:0]  head_fault_vaddr,
+  input  wire             consume,              // IF PC advances sequentially
+  input  wire [2:0]       consume_hw,           // Halfwords consumed (1, 2 or 4)
+
+  // Redirect (trap, xRET, branch/jump, predicted taken)
+  input  wire             redirect,
+  input  wire [XLEN-1:0]  redirect_pc
+);
+
+  localparam CNT_BITS = $clog2(DEPTH + 1);
+  localparam VIEW     = DEPTH + 4;              // Queue plus one incoming fetch
+
+  reg  [15:0]          q [0:DEPTH-1];
+  reg  [CNT_BITS-1:0]  count;
+  reg  [XLEN-1:0]      fetch_pc;
+  reg                  fault_pending;
+  reg  [XLEN-1:0]      fault_vaddr_r;
+
+  wire [CNT_BITS:0]    free = DEPTH - count;
+
+  assign fetch_addr = fetch_pc;
+  assign fetch_req  = (free >= 2) && !fault_pending;
+
+  // Halfwords accepted from this cycle's fetch
+  wire       fetch_ok = fetch_req && fetch_valid && !fetch_fault;
+  wire [2:0] push_hw  = !fetch_ok          ? 3'd0 :
+                        fetch_pc[1]        ? 3'd1 :
+                        (fetch_next_valid && free >= 4) ? 3'd4 : 3'd2;
+
+  wire [63:0] fetch_bundle = fetch_pc[1] ? {48'h0, fetch_data[31:16]} : {fetch_next, fetch_data};
+
+  // Queue contents followed by the incoming halfwords
+  reg  [15:0]          view [0:VIEW-1];
+  wire [CNT_BITS+1:0]  view_count = count + push_hw;
+
+  integer i;
+  always @(*) begin
+    for (i = 0; i < VIEW; i = i + 1) begin
+      if (i < count)
+        view[i] = q[i];
+      else if (i - count < 4)
+        view[i] = fetch_bundle[(i - count)*16 +: 16];
+      else
+        view[i] = 16'h0000;
+    end
+  end
+
+  assign head_instr       = {view[1], view[0]};
+  assign head_valid       = (view_count >= 2) || ((view_count == 1) && (view[0][1:0] != 2'b11));
+  assign head_next        = {view[3], view[2]};
+  assign head_next_valid  = (view_count >= 4);
+
+  // A fault becomes visible once every halfword fetched before it is consumed
+  wire fault_now          = fetch_req && fetch_fault;
+  assign head_fault       = !head_valid && (fault_pending || fault_now);
+  assign head_fault_vaddr = fault_pending ? fault_vaddr_r : fetch_fault_vaddr;
+
+  wire [2:0] pop_hw = (consume && head_valid) ? consume_hw : 3'd0;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      for (i = 0; i < DEPTH; i = i + 1)
+        q[i] <= 16'h0000;
+      count         <= {CNT_BITS{1'b0}};
+      fetch_pc      <= RESET_VECTOR;
+      fault_pending <= 1'b0;
+      fault_vaddr_r <= {XLEN{1'b0}};
+    end else if (redirect) begin
+      count         <= {CNT_BITS{1'b0}};
+      fetch_pc      <= redirect_pc;
+      fault_pending <= 1'b0;
+    end else begin
+      for (i = 0; i < DEPTH; i = i + 1)
+        q[i] <= view[i + pop_hw];
+      count <= view_count - pop_hw;
+      if (fetch_ok)
+        fetch_pc <= fetch_pc + {push_hw, 1'b0};
+      if (fault_now && !fault_pending) begin
+        fault_pending <= 1'b1;
+        fault_vaddr_r <= fetch_fault_vaddr;
+      end
+    end
+  end
+
+  `ifdef DEBUG_FETCH_QUEUE
+  always @(posedge clk) begin
+    if (redirect)
+      $display("[FETCHQ] Redirect to 0x%h (dropped %0d halfwords)", redirect_pc, count);
+    else if (push_hw != 0 || pop_hw != 0)
+      $display("[FETCHQ] fetch_pc=0x%h push=%0d pop=%0d count=%0d->%0d",
+               fetch_pc, push_hw, pop_hw, count, view_count - pop_hw);
+  end
+  `endif
+
+endmodule
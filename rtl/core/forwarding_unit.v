@@ -3,6 +3,10 @@
 // Implements comprehensive forwarding for both ID and EX stages:
 //   - ID stage: EX→ID, MEM→ID, WB→ID (for early branch resolution)
 //   - EX stage: EX→EX, MEM→EX (for ALU operations)
+//   - Dual issue (ISSUE_WIDTH=2): lane-1 producers in every stage, and the same
+//     selects for the lane-1 consumer. A *_l1 bit says the selected stage's
+//     value comes from lane 1; lane 1 is the younger of a pair, so it wins
+//     when both lanes of one stage write the matching register
 
 module forwarding_unit (
   // ========================================
@@ -37,7 +41,7 @@ module forwarding_unit (
   // ID/EX register outputs (instruction currently in EX stage)
   input  wire [4:0] idex_rd,           // EX stage destination register
   input  wire       idex_reg_write,    // EX stage will write to register
-  input  wire       idex_is_atomic,    // EX stage has atomic instruction (disable EX→ID forwarding)
+  input  wire       idex_atomic_pending, // EX stage atomic whose result is not ready yet (disable EX→ID forwarding)
 
   // EX/MEM register outputs (instruction in MEM stage)
   input  wire [4:0] exmem_rd,          // MEM stage destination register
@@ -50,6 +54,39 @@ module forwarding_unit (
   input  wire       memwb_int_reg_write_fp, // WB stage FP-to-INT write
   input  wire       memwb_valid,       // WB stage instruction is valid (not flushed)
 
+  // ========================================
+  // Second Issue Lane (tie off when ISSUE_WIDTH=1)
+  // ========================================
+
+  // Lane-1 producers (write enables already qualified by valid)
+  input  wire [4:0] idex1_rd,          // EX stage lane-1 destination
+  input  wire       idex1_reg_write,
+  input  wire [4:0] exmem1_rd,         // MEM stage lane-1 destination
+  input  wire       exmem1_reg_write,
+  input  wire [4:0] memwb1_rd,         // WB stage lane-1 destination
+  input  wire       memwb1_reg_write,
+  input  wire       memwb1_valid,
+
+  // Lane select for the lane-0 consumer
+  output reg        id_forward_a_l1,   // id_forward_a source is lane 1
+  output reg        id_forward_b_l1,
+  output reg        forward_a_l1,      // forward_a source is lane 1
+  output reg        forward_b_l1,
+
+  // Lane-1 consumer (same encodings as the lane-0 selects)
+  input  wire [4:0] id1_rs1,           // ID stage lane-1 source registers
+  input  wire [4:0] id1_rs2,
+  input  wire [4:0] idex1_rs1,         // EX stage lane-1 source registers
+  input  wire [4:0] idex1_rs2,
+  output reg  [2:0] id1_forward_a,
+  output reg  [2:0] id1_forward_b,
+  output reg        id1_forward_a_l1,
+  output reg        id1_forward_b_l1,
+  output reg  [1:0] forward1_a,
+  output reg  [1:0] forward1_b,
+  output reg        forward1_a_l1,
+  output reg        forward1_b_l1,
+
   // ========================================
   // FP Register Forwarding
   // ========================================
@@ -90,19 +127,34 @@ module forwarding_unit (
   always @(*) begin
     // Default: no forwarding
     id_forward_a = 3'b000;
+    id_forward_a_l1 = 1'b0;
 
     // Check EX stage (highest priority - most recent instruction)
-    // Skip EX forwarding for atomic operations (they take multiple cycles, result not ready)
-    if (idex_reg_write && (idex_rd != 5'h0) && (idex_rd == id_rs1) && !idex_is_atomic) begin
+    // Skip EX forwarding for atomic operations until their completion cycle
+    // (they take multiple cycles; atomic_unit's result is registered when done)
+    // Lane 1 of the same stage is younger, so it is checked first
+    if (idex1_reg_write && (idex1_rd != 5'h0) && (idex1_rd == id_rs1)) begin
+      id_forward_a = 3'b100;
+      id_forward_a_l1 = 1'b1;
+    end
+    else if (idex_reg_write && (idex_rd != 5'h0) && (idex_rd == id_rs1) && !idex_atomic_pending) begin
       id_forward_a = 3'b100;  // Forward from EX stage
     end
     // Check MEM stage (second priority)
     // Include FP-to-INT writes (FMV.X.W, FCVT.W.S, FP compare, etc.)
+    else if (exmem1_reg_write && (exmem1_rd != 5'h0) && (exmem1_rd == id_rs1)) begin
+      id_forward_a = 3'b010;
+      id_forward_a_l1 = 1'b1;
+    end
     else if ((exmem_reg_write | exmem_int_reg_write_fp) && (exmem_rd != 5'h0) && (exmem_rd == id_rs1)) begin
       id_forward_a = 3'b010;  // Forward from MEM stage
     end
     // Check WB stage (lowest priority - oldest instruction)
     // CRITICAL: Only forward if memwb_valid=1 (prevents forwarding from flushed instructions)
+    else if (memwb1_reg_write && (memwb1_rd != 5'h0) && (memwb1_rd == id_rs1) && memwb1_valid) begin
+      id_forward_a = 3'b001;
+      id_forward_a_l1 = 1'b1;
+    end
     else if ((memwb_reg_write | memwb_int_reg_write_fp) && (memwb_rd != 5'h0) && (memwb_rd == id_rs1) && memwb_valid) begin
       id_forward_a = 3'b001;  // Forward from WB stage
     end
@@ -111,19 +163,34 @@ module forwarding_unit (
   always @(*) begin
     // Default: no forwarding
     id_forward_b = 3'b000;
+    id_forward_b_l1 = 1'b0;
 
     // Check EX stage (highest priority)
-    // Skip EX forwarding for atomic operations (they take multiple cycles, result not ready)
-    if (idex_reg_write && (idex_rd != 5'h0) && (idex_rd == id_rs2) && !idex_is_atomic) begin
+    // Skip EX forwarding for atomic operations until their completion cycle
+    // (they take multiple cycles; atomic_unit's result is registered when done)
+    // Lane 1 of the same stage is younger, so it is checked first
+    if (idex1_reg_write && (idex1_rd != 5'h0) && (idex1_rd == id_rs2)) begin
+      id_forward_b = 3'b100;
+      id_forward_b_l1 = 1'b1;
+    end
+    else if (idex_reg_write && (idex_rd != 5'h0) && (idex_rd == id_rs2) && !idex_atomic_pending) begin
       id_forward_b = 3'b100;  // Forward from EX stage
     end
     // Check MEM stage (second priority)
     // Include FP-to-INT writes (FMV.X.W, FCVT.W.S, FP compare, etc.)
+    else if (exmem1_reg_write && (exmem1_rd != 5'h0) && (exmem1_rd == id_rs2)) begin
+      id_forward_b = 3'b010;
+      id_forward_b_l1 = 1'b1;
+    end
     else if ((exmem_reg_write | exmem_int_reg_write_fp) && (exmem_rd != 5'h0) && (exmem_rd == id_rs2)) begin
       id_forward_b = 3'b010;  // Forward from MEM stage
     end
     // Check WB stage (lowest priority)
     // CRITICAL: Only forward if memwb_valid=1 (prevents forwarding from flushed instructions)
+    else if (memwb1_reg_write && (memwb1_rd != 5'h0) && (memwb1_rd == id_rs2) && memwb1_valid) begin
+      id_forward_b = 3'b001;
+      id_forward_b_l1 = 1'b1;
+    end
     else if ((memwb_reg_write | memwb_int_reg_write_fp) && (memwb_rd != 5'h0) && (memwb_rd == id_rs2) && memwb_valid) begin
       id_forward_b = 3'b001;  // Forward from WB stage
     end
@@ -139,11 +206,17 @@ module forwarding_unit (
   always @(*) begin
     // Default: no forwarding
     forward_a = 2'b00;
+    forward_a_l1 = 1'b0;
 
     // MEM hazard (highest priority): Forward from EX/MEM
     // Condition: EX/MEM.reg_write AND EX/MEM.rd != 0 AND EX/MEM.rd == ID/EX.rs1
     // Include FP-to-INT writes (FMV.X.W, FCVT.W.S, FP compare, etc.)
-    if ((exmem_reg_write | exmem_int_reg_write_fp) && (exmem_rd != 5'h0) && (exmem_rd == idex_rs1)) begin
+    // Lane 1 of the same stage is younger, so it is checked first
+    if (exmem1_reg_write && (exmem1_rd != 5'h0) && (exmem1_rd == idex_rs1)) begin
+      forward_a = 2'b10;
+      forward_a_l1 = 1'b1;
+    end
+    else if ((exmem_reg_write | exmem_int_reg_write_fp) && (exmem_rd != 5'h0) && (exmem_rd == idex_rs1)) begin
       forward_a = 2'b10;
       `ifdef DEBUG_FORWARD
       $display("[FORWARD_A] @%0t MEM hazard: rs1=x%0d matches exmem_rd=x%0d (fwd=2'b10)", $time, idex_rs1, exmem_rd);
@@ -153,6 +226,10 @@ module forwarding_unit (
     // Condition: MEM/WB.reg_write AND MEM/WB.rd != 0 AND MEM/WB.rd == ID/EX.rs1
     // Include FP-to-INT writes
     // CRITICAL: Only forward if memwb_valid=1 (prevents forwarding from flushed instructions)
+    else if (memwb1_reg_write && (memwb1_rd != 5'h0) && (memwb1_rd == idex_rs1) && memwb1_valid) begin
+      forward_a = 2'b01;
+      forward_a_l1 = 1'b1;
+    end
     else if ((memwb_reg_write | memwb_int_reg_write_fp) && (memwb_rd != 5'h0) && (memwb_rd == idex_rs1) && memwb_valid) begin
       forward_a = 2'b01;
       `ifdef DEBUG_FORWARD
@@ -169,10 +246,16 @@ module forwarding_unit (
   always @(*) begin
     // Default: no forwarding
     forward_b = 2'b00;
+    forward_b_l1 = 1'b0;
 
     // MEM hazard (highest priority): Forward from EX/MEM
     // Include FP-to-INT writes (FMV.X.W, FCVT.W.S, FP compare, etc.)
-    if ((exmem_reg_write | exmem_int_reg_write_fp) && (exmem_rd != 5'h0) && (exmem_rd == idex_rs2)) begin
+    // Lane 1 of the same stage is younger, so it is checked first
+    if (exmem1_reg_write && (exmem1_rd != 5'h0) && (exmem1_rd == idex_rs2)) begin
+      forward_b = 2'b10;
+      forward_b_l1 = 1'b1;
+    end
+    else if ((exmem_reg_write | exmem_int_reg_write_fp) && (exmem_rd != 5'h0) && (exmem_rd == idex_rs2)) begin
       forward_b = 2'b10;
       `ifdef DEBUG_FORWARD
       $display("[FORWARD_B] @%0t MEM hazard: rs2=x%0d matches exmem_rd=x%0d (fwd=2'b10)", $time, idex_rs2, exmem_rd);
@@ -181,6 +264,10 @@ module forwarding_unit (
     // WB hazard: Forward from MEM/WB
     // Include FP-to-INT writes
     // CRITICAL: Only forward if memwb_valid=1 (prevents forwarding from flushed instructions)
+    else if (memwb1_reg_write && (memwb1_rd != 5'h0) && (memwb1_rd == idex_rs2) && memwb1_valid) begin
+      forward_b = 2'b01;
+      forward_b_l1 = 1'b1;
+    end
     else if ((memwb_reg_write | memwb_int_reg_write_fp) && (memwb_rd != 5'h0) && (memwb_rd == idex_rs2) && memwb_valid) begin
       forward_b = 2'b01;
       `ifdef DEBUG_FORWARD
@@ -194,6 +281,107 @@ module forwarding_unit (
     `endif
   end
 
+  // ========================================
+  // Lane-1 Consumer Integer Forwarding (ISSUE_WIDTH=2)
+  // ========================================
+  // Same priorities as lane 0. A lane-1 instruction never depends on the lane-0
+  // instruction of its own pair (pairing rule), so lane 0 of the same stage is
+  // never a source here.
+
+  always @(*) begin
+    id1_forward_a = 3'b000;
+    id1_forward_a_l1 = 1'b0;
+
+    if (idex1_reg_write && (idex1_rd != 5'h0) && (idex1_rd == id1_rs1)) begin
+      id1_forward_a = 3'b100;
+      id1_forward_a_l1 = 1'b1;
+    end
+    else if (idex_reg_write && (idex_rd != 5'h0) && (idex_rd == id1_rs1) && !idex_atomic_pending) begin
+      id1_forward_a = 3'b100;
+    end
+    else if (exmem1_reg_write && (exmem1_rd != 5'h0) && (exmem1_rd == id1_rs1)) begin
+      id1_forward_a = 3'b010;
+      id1_forward_a_l1 = 1'b1;
+    end
+    else if ((exmem_reg_write | exmem_int_reg_write_fp) && (exmem_rd != 5'h0) && (exmem_rd == id1_rs1)) begin
+      id1_forward_a = 3'b010;
+    end
+    else if (memwb1_reg_write && (memwb1_rd != 5'h0) && (memwb1_rd == id1_rs1) && memwb1_valid) begin
+      id1_forward_a = 3'b001;
+      id1_forward_a_l1 = 1'b1;
+    end
+    else if ((memwb_reg_write | memwb_int_reg_write_fp) && (memwb_rd != 5'h0) && (memwb_rd == id1_rs1) && memwb_valid) begin
+      id1_forward_a = 3'b001;
+    end
+  end
+
+  always @(*) begin
+    id1_forward_b = 3'b000;
+    id1_forward_b_l1 = 1'b0;
+
+    if (idex1_reg_write && (idex1_rd != 5'h0) && (idex1_rd == id1_rs2)) begin
+      id1_forward_b = 3'b100;
+      id1_forward_b_l1 = 1'b1;
+    end
+    else if (idex_reg_write && (idex_rd != 5'h0) && (idex_rd == id1_rs2) && !idex_atomic_pending) begin
+      id1_forward_b = 3'b100;
+    end
+    else if (exmem1_reg_write && (exmem1_rd != 5'h0) && (exmem1_rd == id1_rs2)) begin
+      id1_forward_b = 3'b010;
+      id1_forward_b_l1 = 1'b1;
+    end
+    else if ((exmem_reg_write | exmem_int_reg_write_fp) && (exmem_rd != 5'h0) && (exmem_rd == id1_rs2)) begin
+      id1_forward_b = 3'b010;
+    end
+    else if (memwb1_reg_write && (memwb1_rd != 5'h0) && (memwb1_rd == id1_rs2) && memwb1_valid) begin
+      id1_forward_b = 3'b001;
+      id1_forward_b_l1 = 1'b1;
+    end
+    else if ((memwb_reg_write | memwb_int_reg_write_fp) && (memwb_rd != 5'h0) && (memwb_rd == id1_rs2) && memwb_valid) begin
+      id1_forward_b = 3'b001;
+    end
+  end
+
+  always @(*) begin
+    forward1_a = 2'b00;
+    forward1_a_l1 = 1'b0;
+
+    if (exmem1_reg_write && (exmem1_rd != 5'h0) && (exmem1_rd == idex1_rs1)) begin
+      forward1_a = 2'b10;
+      forward1_a_l1 = 1'b1;
+    end
+    else if ((exmem_reg_write | exmem_int_reg_write_fp) && (exmem_rd != 5'h0) && (exmem_rd == idex1_rs1)) begin
+      forward1_a = 2'b10;
+    end
+    else if (memwb1_reg_write && (memwb1_rd != 5'h0) && (memwb1_rd == idex1_rs1) && memwb1_valid) begin
+      forward1_a = 2'b01;
+      forward1_a_l1 = 1'b1;
+    end
+    else if ((memwb_reg_write | memwb_int_reg_write_fp) && (memwb_rd != 5'h0) && (memwb_rd == idex1_rs1) && memwb_valid) begin
+      forward1_a = 2'b01;
+    end
+  end
+
+  always @(*) begin
+    forward1_b = 2'b00;
+    forward1_b_l1 = 1'b0;
+
+    if (exmem1_reg_write && (exmem1_rd != 5'h0) && (exmem1_rd == idex1_rs2)) begin
+      forward1_b = 2'b10;
+      forward1_b_l1 = 1'b1;
+    end
+    else if ((exmem_reg_write | exmem_int_reg_write_fp) && (exmem_rd != 5'h0) && (exmem_rd == idex1_rs2)) begin
+      forward1_b = 2'b10;
+    end
+    else if (memwb1_reg_write && (memwb1_rd != 5'h0) && (memwb1_rd == idex1_rs2) && memwb1_valid) begin
+      forward1_b = 2'b01;
+      forward1_b_l1 = 1'b1;
+    end
+    else if ((memwb_reg_write | memwb_int_reg_write_fp) && (memwb_rd != 5'h0) && (memwb_rd == idex1_rs2) && memwb_valid) begin
+      forward1_b = 2'b01;
+    end
+  end
+
   // ========================================
   // ID Stage FP Register Forwarding
   // ========================================
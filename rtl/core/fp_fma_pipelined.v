@@ -0,0 +1,579 @@
+// fp_fma_pipelined.v - Pipelined Fused Multiply-Add Datapath
+// Executes FADD/FSUB/FMUL/FMADD/FMSUB/FNMSUB/FNMADD (single and double) with a
+// fixed latency, accepting a new operation every cycle
+// Structure:
+//   - One fused datapath: FADD/FSUB run as a*1.0 +/- b, FMUL as a*b with no
+//     addend, so every op has the same latency and results never collide
+//   - Exact 106-bit product, addend aligned into a 163-bit window with sticky
+//   - Single rounding step (all five rounding modes), tininess after rounding
+// Stage mapping (result in the 4th cycle, one op per cycle):
+//   1: unpack, special cases, subnormal pre-normalize, significand multiply
+//   2: addend alignment and add/subtract
+//   3: leading-zero count and normalize
+//   4: denormalize, round, overflow and pack (combinational from stage 3)
+// Operations in flight cannot be stalled or cancelled: the core only issues
+// committed instructions, and results go to a dedicated register file port
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`include "config/rv_config.vh"
+
+module fp_fma_pipelined #(
+  parameter FLEN = `FLEN               // 32 (F only) or 64 (F+D)
+)(
+  input  wire              clk,
+  input  wire              reset_n,
+
+  // Issue (EX stage)
+  input  wire              valid_in,
+  input  wire [4:0]        fp_alu_op,   // FP_ADD/SUB/MUL/FMA/FMSUB/FNMSUB/FNMADD
+  input  wire              fmt,         // 0: single, 1: double
+  input  wire [2:0]        rounding_mode,
+  input  wire [4:0]        rd_in,       // Destination tag carried with the op
+  input  wire [FLEN-1:0]   operand_a,
+  input  wire [FLEN-1:0]   operand_b,
+  input  wire [FLEN-1:0]   operand_c,
+
+  // Completion (3 cycles after issue)
+  output wire              valid_out,
+  output wire [4:0]        rd_out,
+  output wire              fmt_out,
+  output reg  [FLEN-1:0]   result,
+  output reg               flag_nv,
+  output reg               flag_of,
+  output reg               flag_uf,
+  output reg               flag_nx
+);
+
+  // Operation encoding (matches control_unit / fpu)
+  localparam FP_ADD    = 5'b00000;
+  localparam FP_SUB    = 5'b00001;
+  localparam FP_MUL    = 5'b00010;
+  localparam FP_FMSUB  = 5'b01110;
+  localparam FP_FNMSUB = 5'b01111;
+  localparam FP_FNMADD = 5'b10000;
+
+  localparam RNE = 3'b000;
+  localparam RTZ = 3'b001;
+  localparam RDN = 3'b010;
+  localparam RUP = 3'b011;
+  localparam RMM = 3'b100;
+
+  localparam W  = 163;                 // Alignment / sum window
+  localparam EW = 14;                  // Signed internal exponent width
+
+  localparam [63:0] CANON_NAN_D = 64'h7FF8_0000_0000_0000;
+  localparam [63:0] CANON_NAN_S = 64'hFFFF_FFFF_7FC0_0000;
+
+  // =========================================================================
+  // Helpers
+  // =========================================================================
+
+  // Leading zeros of a 53-bit significand (53 when zero)
+  function [5:0] lzc53;
+    input [52:0] v;
+    integer k;
+    reg found;
+    begin
+      lzc53 = 6'd53;
+      found = 1'b0;
+      for (k = 52; k >= 0; k = k - 1)
+        if (!found && v[k]) begin
+          lzc53 = 52 - k;
+          found = 1'b1;
+        end
+    end
+  endfunction
+
+  // Leading zeros of the sum window
+  function [7:0] lzc_w;
+    input [W-1:0] v;
+    integer k;
+    reg found;
+    begin
+      lzc_w = W;
+      found = 1'b0;
+      for (k = W-1; k >= 0; k = k - 1)
+        if (!found && v[k]) begin
+          lzc_w = W - 1 - k;
+          found = 1'b1;
+        end
+    end
+  endfunction
+
+  // =========================================================================
+  // Stage 1: unpack, specials, multiply
+  // =========================================================================
+
+  // Operands as 64-bit values; FLEN=32 registers hold singles only
+  wire [63:0] a64, b64, c64;
+  wire        fmt_d = (FLEN == 64) && fmt;
+
+  generate
+    if (FLEN == 64) begin : gen_op64
+      assign a64 = operand_a;
+      assign b64 = operand_b;
+      assign c64 = operand_c;
+    end else begin : gen_op32
+      assign a64 = {32'hFFFF_FFFF, operand_a};
+      assign b64 = {32'hFFFF_FFFF, operand_b};
+      assign c64 = {32'hFFFF_FFFF, operand_c};
+    end
+  endgenerate
+
+  // Unpacked operand fields
+  reg          u_sign  [0:2];
+  reg [52:0]   u_sig   [0:2];          // Normalized significand (bit 52 set unless zero)
+  reg [EW-1:0] u_exp   [0:2];          // Unbiased exponent of bit 52
+  reg          u_zero  [0:2];
+  reg          u_inf   [0:2];
+  reg          u_nan   [0:2];
+  reg          u_snan  [0:2];
+
+  reg  [63:0]   x;
+  reg  [10:0]   xe;
+  reg  [51:0]   xf;
+  reg  [5:0]    xlz;
+  reg           boxed;
+  integer       n;
+
+  always @(*) begin
+    for (n = 0; n < 3; n = n + 1) begin
+      x     = (n == 0) ? a64 : (n == 1) ? b64 : c64;
+      boxed = 1'b1;
+      if (fmt_d) begin
+        u_sign[n] = x[63];
+        xe        = x[62:52];
+        xf        = x[51:0];
+        u_inf[n]  = (xe == 11'h7FF) && (xf == 52'h0);
+        u_nan[n]  = (xe == 11'h7FF) && (xf != 52'h0);
+        u_snan[n] = u_nan[n] && !xf[51];
+        u_zero[n] = (xe == 11'h0) && (xf == 52'h0);
+        u_sig[n]  = {(xe != 11'h0), xf};
+        u_exp[n]  = (xe == 11'h0) ? -14'sd1022 : ({3'b000, xe} - 14'sd1023);
+      end else begin
+        // Improperly NaN-boxed singles read as the canonical (quiet) NaN
+        boxed     = (x[63:32] == 32'hFFFF_FFFF);
+        u_sign[n] = boxed ? x[31] : 1'b0;
+        xe        = boxed ? {3'b000, x[30:23]} : 11'h0FF;
+        xf        = boxed ? {x[22:0], 29'h0} : {1'b1, 51'h0};
+        u_inf[n]  = (xe == 11'h0FF) && (xf == 52'h0);
+        u_nan[n]  = (xe == 11'h0FF) && (xf != 52'h0);
+        u_snan[n] = u_nan[n] && !xf[51];
+        u_zero[n] = (xe == 11'h0) && (xf == 52'h0);
+        u_sig[n]  = {(xe != 11'h0), xf};
+        u_exp[n]  = (xe == 11'h0) ? -14'sd126 : ({3'b000, xe} - 14'sd127);
+      end
+      // Pre-normalize subnormals so the product MSB is at bit 104 or 105
+      xlz = lzc53(u_sig[n]);
+      if (!u_zero[n] && xlz != 6'd0) begin
+        u_sig[n] = u_sig[n] << xlz;
+        u_exp[n] = u_exp[n] - {{(EW-6){1'b0}}, xlz};
+      end
+    end
+  end
+
+  // Operation decode: multiplicands m1*m2, addend ad
+  wire is_addsub  = (fp_alu_op == FP_ADD) || (fp_alu_op == FP_SUB);
+  wire no_addend  = (fp_alu_op == FP_MUL);
+  wire neg_prod   = (fp_alu_op == FP_FNMSUB) || (fp_alu_op == FP_FNMADD);
+  wire neg_add    = (fp_alu_op == FP_SUB) || (fp_alu_op == FP_FMSUB) || (fp_alu_op == FP_FNMADD);
+
+  // FADD/FSUB: b becomes the addend and the second multiplicand is 1.0
+  wire          m2_sign = is_addsub ? 1'b0         : u_sign[1];
+  wire [52:0]   m2_sig  = is_addsub ? {1'b1, 52'h0} : u_sig[1];
+  wire [EW-1:0] m2_exp  = is_addsub ? {EW{1'b0}}   : u_exp[1];
+  wire          m2_zero = !is_addsub && u_zero[1];
+  wire          m2_inf  = !is_addsub && u_inf[1];
+  wire          m2_nan  = !is_addsub && u_nan[1];
+  wire          m2_snan = !is_addsub && u_snan[1];
+
+  wire          ad_sel  = is_addsub;                    // 1: addend from b, 0: from c
+  wire          ad_sign = ad_sel ? u_sign[1] : u_sign[2];
+  wire [52:0]   ad_sig  = ad_sel ? u_sig[1]  : u_sig[2];
+  wire [EW-1:0] ad_exp  = ad_sel ? u_exp[1]  : u_exp[2];
+  wire          ad_zero = no_addend || (ad_sel ? u_zero[1] : u_zero[2]);
+  wire          ad_inf  = !no_addend && (ad_sel ? u_inf[1]  : u_inf[2]);
+  wire          ad_nan  = !no_addend && (ad_sel ? u_nan[1]  : u_nan[2]);
+  wire          ad_snan = !no_addend && (ad_sel ? u_snan[1] : u_snan[2]);
+  wire [63:0]   ad_bits = ad_sel ? b64 : c64;
+
+  wire sign_p = u_sign[0] ^ m2_sign ^ neg_prod;
+  wire sign_c = ad_sign ^ neg_add;
+
+  // Special cases resolved in stage 1
+  wire any_nan        = u_nan[0] || m2_nan || ad_nan;
+  wire any_snan       = u_snan[0] || m2_snan || ad_snan;
+  wire inf_times_zero = (u_inf[0] && m2_zero) || (u_zero[0] && m2_inf);
+  wire prod_inf       = (u_inf[0] || m2_inf) && !inf_times_zero && !u_nan[0] && !m2_nan;
+  wire prod_zero      = u_zero[0] || m2_zero;
+  wire inf_minus_inf  = prod_inf && ad_inf && (sign_p != sign_c);
+  wire invalid        = any_snan || inf_times_zero || inf_minus_inf;
+
+  reg        s1_special_d;
+  reg [63:0] s1_special_val_d;
+
+  always @(*) begin
+    s1_special_d     = 1'b1;
+    s1_special_val_d = 64'h0;
+    if (any_nan || invalid)
+      s1_special_val_d = fmt_d ? CANON_NAN_D : CANON_NAN_S;
+    else if (prod_inf)
+      s1_special_val_d = fmt_d ? {sign_p, 11'h7FF, 52'h0} : {32'hFFFF_FFFF, sign_p, 8'hFF, 23'h0};
+    else if (ad_inf)
+      s1_special_val_d = fmt_d ? {sign_c, 11'h7FF, 52'h0} : {32'hFFFF_FFFF, sign_c, 8'hFF, 23'h0};
+    else if (prod_zero && ad_zero) begin
+      // 0 + 0: like signs keep the sign, otherwise +0 (-0 when rounding down)
+      if (no_addend || sign_p == sign_c)
+        s1_special_val_d = fmt_d ? {sign_p, 63'h0} : {32'hFFFF_FFFF, sign_p, 31'h0};
+      else
+        s1_special_val_d = fmt_d ? {(rounding_mode == RDN), 63'h0}
+                                 : {32'hFFFF_FFFF, (rounding_mode == RDN), 31'h0};
+    end else if (prod_zero)
+      // 0 + c is exactly c (with the addend sign applied)
+      s1_special_val_d = fmt_d ? {sign_c, ad_bits[62:0]} : {32'hFFFF_FFFF, sign_c, ad_bits[30:0]};
+    else
+      s1_special_d = 1'b0;
+  end
+
+  wire [105:0]  product = u_sig[0] * m2_sig;
+  wire [EW-1:0] exp_p   = u_exp[0] + m2_exp;
+
+  reg          s1_valid;
+  reg [4:0]    s1_rd;
+  reg          s1_fmt;
+  reg [2:0]    s1_rm;
+  reg          s1_special;
+  reg [63:0]   s1_special_val;
+  reg          s1_nv;
+  reg          s1_sign_p, s1_sign_c, s1_ad_zero;
+  reg [105:0]  s1_prod;
+  reg [EW-1:0] s1_exp_p;
+  reg [52:0]   s1_ad_sig;
+  reg [EW-1:0] s1_ad_exp;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      s1_valid       <= 1'b0;
+      s1_rd          <= 5'h0;
+      s1_fmt         <= 1'b0;
+      s1_rm          <= 3'b000;
+      s1_special     <= 1'b0;
+      s1_special_val <= 64'h0;
+      s1_nv          <= 1'b0;
+      s1_sign_p      <= 1'b0;
+      s1_sign_c      <= 1'b0;
+      s1_ad_zero     <= 1'b0;
+      s1_prod        <= 106'h0;
+      s1_exp_p       <= {EW{1'b0}};
+      s1_ad_sig      <= 53'h0;
+      s1_ad_exp      <= {EW{1'b0}};
+    end else begin
+      s1_valid       <= valid_in;
+      s1_rd          <= rd_in;
+      s1_fmt         <= fmt_d;
+      s1_rm          <= rounding_mode;
+      s1_special     <= s1_special_d;
+      s1_special_val <= s1_special_val_d;
+      s1_nv          <= invalid;
+      s1_sign_p      <= sign_p;
+      s1_sign_c      <= sign_c;
+      s1_ad_zero     <= ad_zero;
+      s1_prod        <= product;
+      s1_exp_p       <= exp_p;
+      s1_ad_sig      <= ad_sig;
+      s1_ad_exp      <= ad_exp;
+    end
+  end
+
+  // =========================================================================
+  // Stage 2: align addend and add
+  // =========================================================================
+  // Window bit k weighs 2^(exp_p - 104 + k): the product sits at [105:0].
+  // The addend starts with its MSB at bit 162 and is shifted right by
+  // 58 - (exp_c - exp_p). When the addend is more than 58 binades above the
+  // product the shift clamps at 0 and the window is rebased on the addend
+  // (bit k weighs 2^(exp_c - 162 + k)); the product then lies entirely below
+  // the addend's guard bits and only contributes round/sticky, which it still
+  // does correctly from its unshifted position.
+
+  wire [EW-1:0] exp_diff  = s1_ad_exp - s1_exp_p;
+  wire [EW-1:0] ad_shift  = 14'sd58 - exp_diff;
+  wire          shift_neg = ad_shift[EW-1];
+  wire          shift_all = !shift_neg && (ad_shift >= W);
+
+  reg [W-1:0] ad_full, ad_aligned, ad_lost;
+  reg         ad_sticky;
+
+  always @(*) begin
+    ad_full = {s1_ad_sig, {(W-53){1'b0}}};
+    ad_lost = {W{1'b0}};
+    if (s1_ad_zero) begin
+      ad_aligned = {W{1'b0}};
+      ad_sticky  = 1'b0;
+    end else if (shift_neg) begin
+      ad_aligned = ad_full;
+      ad_sticky  = 1'b0;
+    end else if (shift_all) begin
+      ad_aligned = {W{1'b0}};
+      ad_sticky  = 1'b1;
+    end else begin
+      ad_aligned = ad_full >> ad_shift;
+      ad_lost    = ad_full << (W - ad_shift);
+      ad_sticky  = (ad_shift != 0) && (ad_lost != {W{1'b0}});
+    end
+  end
+
+  wire [W-1:0] prod_w  = {{(W-106){1'b0}}, s1_prod};
+  wire         eff_sub = !s1_ad_zero && (s1_sign_p != s1_sign_c);
+  wire         prod_ge = (prod_w >= ad_aligned);
+
+  reg [W-1:0] sum_mag;
+  reg         sum_sign;
+
+  always @(*) begin
+    if (!eff_sub) begin
+      sum_mag  = prod_w + ad_aligned;           // < 2^163, never carries out
+      sum_sign = s1_sign_p;
+    end else if (prod_ge) begin
+      // Lost addend bits are a borrow below bit 0 (only possible here)
+      sum_mag  = prod_w - ad_aligned - {{(W-1){1'b0}}, ad_sticky};
+      sum_sign = s1_sign_p;
+    end else begin
+      sum_mag  = ad_aligned - prod_w;
+      sum_sign = s1_sign_c;
+    end
+  end
+
+  wire sum_zero = (sum_mag == {W{1'b0}}) && !ad_sticky;
+
+  reg          s2_valid;
+  reg [4:0]    s2_rd;
+  reg          s2_fmt;
+  reg [2:0]    s2_rm;
+  reg          s2_special;
+  reg [63:0]   s2_special_val;
+  reg          s2_nv;
+  reg [W-1:0]  s2_mag;
+  reg          s2_sticky;
+  reg          s2_sign;
+  reg          s2_zero;
+  reg [EW-1:0] s2_exp_base;            // Window bit 104 weighs 2^s2_exp_base
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      s2_valid       <= 1'b0;
+      s2_rd          <= 5'h0;
+      s2_fmt         <= 1'b0;
+      s2_rm          <= 3'b000;
+      s2_special     <= 1'b0;
+      s2_special_val <= 64'h0;
+      s2_nv          <= 1'b0;
+      s2_mag         <= {W{1'b0}};
+      s2_sticky      <= 1'b0;
+      s2_sign        <= 1'b0;
+      s2_zero        <= 1'b0;
+      s2_exp_base    <= {EW{1'b0}};
+    end else begin
+      s2_valid       <= s1_valid;
+      s2_rd          <= s1_rd;
+      s2_fmt         <= s1_fmt;
+      s2_rm          <= s1_rm;
+      s2_special     <= s1_special;
+      s2_special_val <= s1_special_val;
+      s2_nv          <= s1_nv;
+      s2_mag         <= sum_mag;
+      s2_sticky      <= ad_sticky;   // Subtract: borrow taken above, fraction left over
+      // Exact cancellation: +0, or -0 when rounding down
+      s2_sign        <= sum_zero ? (s1_rm == RDN) : sum_sign;
+      s2_zero        <= sum_zero;
+      s2_exp_base    <= (shift_neg && !s1_ad_zero) ? (s1_ad_exp - 14'sd58) : s1_exp_p;
+    end
+  end
+
+  // =========================================================================
+  // Stage 3: normalize
+  // =========================================================================
+
+  wire [7:0]    norm_lz  = lzc_w(s2_mag);
+  wire [W-1:0]  norm_mag = s2_mag << norm_lz;
+  // Exponent of the leading one: base - 104 + (162 - lz)
+  wire [EW-1:0] norm_exp = s2_exp_base + 14'sd58 - {{(EW-8){1'b0}}, norm_lz};
+
+  reg          s3_valid;
+  reg [4:0]    s3_rd;
+  reg          s3_fmt;
+  reg [2:0]    s3_rm;
+  reg          s3_special;
+  reg [63:0]   s3_special_val;
+  reg          s3_nv;
+  reg [W-1:0]  s3_mag;
+  reg          s3_sticky;
+  reg          s3_sign;
+  reg          s3_zero;
+  reg [EW-1:0] s3_exp;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      s3_valid       <= 1'b0;
+      s3_rd          <= 5'h0;
+      s3_fmt         <= 1'b0;
+      s3_rm          <= 3'b000;
+      s3_special     <= 1'b0;
+      s3_special_val <= 64'h0;
+      s3_nv          <= 1'b0;
+      s3_mag         <= {W{1'b0}};
+      s3_sticky      <= 1'b0;
+      s3_sign        <= 1'b0;
+      s3_zero        <= 1'b0;
+      s3_exp         <= {EW{1'b0}};
+    end else begin
+      s3_valid       <= s2_valid;
+      s3_rd          <= s2_rd;
+      s3_fmt         <= s2_fmt;
+      s3_rm          <= s2_rm;
+      s3_special     <= s2_special;
+      s3_special_val <= s2_special_val;
+      s3_nv          <= s2_nv;
+      s3_mag         <= norm_mag;
+      s3_sticky      <= s2_sticky;
+      s3_sign        <= s2_sign;
+      s3_zero        <= s2_zero;
+      s3_exp         <= norm_exp;
+    end
+  end
+
+  // =========================================================================
+  // Stage 4: denormalize, round, pack
+  // =========================================================================
+
+  function round_up;
+    input [2:0] rm;
+    input       sign;
+    input       lsb;
+    input       guard;
+    input       sticky;
+    begin
+      case (rm)
+        RNE:     round_up = guard && (sticky || lsb);
+        RTZ:     round_up = 1'b0;
+        RDN:     round_up = sign && (guard || sticky);
+        RUP:     round_up = !sign && (guard || sticky);
+        RMM:     round_up = guard;
+        default: round_up = 1'b0;
+      endcase
+    end
+  endfunction
+
+  reg [EW-1:0] emin, emax, bias, dn_shift, e_res;
+  reg [W-1:0]  dn_mag, dn_lost;
+  reg          dn_sticky, tiny, inc, norm_inc, norm_all_ones, g, st, lsb, ovf;
+  reg [53:0]   sig_r;                  // p+1 bits (p = 53 or 24)
+  reg [52:0]   sig_t;
+  reg [10:0]   e_bits;
+  reg [63:0]   packed_r;
+
+  always @(*) begin
+    emin = s3_fmt ? -14'sd1022 : -14'sd126;
+    emax = s3_fmt ?  14'sd1023 :  14'sd127;
+    bias = s3_fmt ?  14'sd1023 :  14'sd127;
+
+    // Results below the normal range are shifted right to the emin scale
+    dn_lost   = {W{1'b0}};
+    dn_shift  = ($signed(s3_exp) < $signed(emin)) ? (emin - s3_exp) : {EW{1'b0}};
+    if (dn_shift >= W) begin
+      dn_mag    = {W{1'b0}};
+      dn_sticky = (s3_mag != {W{1'b0}});
+    end else begin
+      dn_mag    = s3_mag >> dn_shift;
+      dn_lost   = s3_mag << (W - dn_shift);
+      dn_sticky = (dn_shift != 0) && (dn_lost != {W{1'b0}});
+    end
+
+    // Extract p significand bits, guard and sticky
+    if (s3_fmt) begin
+      sig_t = dn_mag[W-1:W-53];
+      g     = dn_mag[W-54];
+      st    = (dn_mag[W-55:0] != 0) || dn_sticky || s3_sticky;
+      lsb   = sig_t[0];
+      norm_all_ones = (s3_mag[W-1:W-53] == {53{1'b1}});
+      norm_inc = round_up(s3_rm, s3_sign, s3_mag[W-53], s3_mag[W-54],
+                          (s3_mag[W-55:0] != 0) || s3_sticky);
+    end else begin
+      sig_t = {29'h0, dn_mag[W-1:W-24]};
+      g     = dn_mag[W-25];
+      st    = (dn_mag[W-26:0] != 0) || dn_sticky || s3_sticky;
+      lsb   = sig_t[0];
+      norm_all_ones = (s3_mag[W-1:W-24] == {24{1'b1}});
+      norm_inc = round_up(s3_rm, s3_sign, s3_mag[W-24], s3_mag[W-25],
+                          (s3_mag[W-26:0] != 0) || s3_sticky);
+    end
+
+    inc   = round_up(s3_rm, s3_sign, lsb, g, st);
+    sig_r = {1'b0, sig_t} + {53'h0, inc};
+
+    // Carry out of the significand bumps the exponent
+    e_res = (dn_shift != 0) ? emin : s3_exp;
+    if (s3_fmt ? sig_r[53] : sig_r[24]) begin
+      sig_r = sig_r >> 1;
+      e_res = e_res + 14'sd1;
+    end
+
+    // Tininess after rounding: below 2^emin even with an unbounded exponent
+    tiny = ($signed(s3_exp) < $signed(emin)) &&
+           !((s3_exp == emin - 14'sd1) && norm_all_ones && norm_inc);
+    ovf  = $signed(e_res) > $signed(emax);
+
+    // Biased exponent: 0 when the rounded result is still subnormal
+    e_bits = (s3_fmt ? sig_r[52] : sig_r[23]) ? (e_res + bias) : 11'h0;
+
+    if (ovf) begin
+      // Overflow: infinity or largest finite depending on rounding direction
+      if (s3_rm == RTZ || (s3_rm == RDN && !s3_sign) || (s3_rm == RUP && s3_sign))
+        packed_r = s3_fmt ? {s3_sign, 63'h7FEF_FFFF_FFFF_FFFF}
+                          : {32'hFFFF_FFFF, s3_sign, 31'h7F7F_FFFF};
+      else
+        packed_r = s3_fmt ? {s3_sign, 11'h7FF, 52'h0}
+                          : {32'hFFFF_FFFF, s3_sign, 8'hFF, 23'h0};
+    end else begin
+      packed_r = s3_fmt ? {s3_sign, e_bits, sig_r[51:0]}
+                        : {32'hFFFF_FFFF, s3_sign, e_bits[7:0], sig_r[22:0]};
+    end
+
+    if (s3_special) begin
+      result  = s3_special_val[FLEN-1:0];
+      flag_nv = s3_nv;
+      flag_of = 1'b0;
+      flag_uf = 1'b0;
+      flag_nx = 1'b0;
+    end else if (s3_zero) begin
+      result  = s3_fmt ? {s3_sign, 63'h0} : {32'hFFFF_FFFF, s3_sign, 31'h0};
+      flag_nv = 1'b0;
+      flag_of = 1'b0;
+      flag_uf = 1'b0;
+      flag_nx = 1'b0;
+    end else begin
+      result  = packed_r[FLEN-1:0];
+      flag_nv = 1'b0;
+      flag_of = ovf;
+      flag_uf = !ovf && tiny && (g || st);
+      flag_nx = ovf || g || st;
+    end
+  end
+
+  assign valid_out = s3_valid;
+  assign rd_out    = s3_rd;
+  assign fmt_out   = s3_fmt;
+
+  `ifdef DEBUG_FPU
+  always @(posedge clk) begin
+    if (valid_in)
+      $display("[FMA_PIPE] issue: op=%b fmt=%b rd=f%0d a=%h b=%h c=%h",
+               fp_alu_op, fmt, rd_in, operand_a, operand_b, operand_c);
+    if (valid_out)
+      $display("[FMA_PIPE] done: rd=f%0d result=%h flags=%b%b%b%b",
+               rd_out, result, flag_nv, flag_of, flag_uf, flag_nx);
+  end
+  `endif
+
+endmodule
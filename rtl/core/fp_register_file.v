@@ -2,6 +2,7 @@
 // Implements 32 floating-point registers (f0-f31)
 // Supports both F extension (FLEN=32) and D extension (FLEN=64)
 // Includes NaN boxing logic for single-precision values in double-precision registers
+// Second write port takes completions from the pipelined FMA datapath (FPU_PIPELINED)
 
 `include "config/rv_config.vh"
 
@@ -25,7 +26,14 @@ module fp_register_file #(
   input  wire [FLEN-1:0]   rd_data,
 
   // NaN boxing control (for single-precision writes when FLEN=64)
-  input  wire              write_single  // 1: writing single-precision, apply NaN boxing
+  input  wire              write_single, // 1: writing single-precision, apply NaN boxing
+
+  // Second write port (pipelined FP completions, independent of WB)
+  // The scoreboard keeps both ports from targeting the same register
+  input  wire              wr2_en,
+  input  wire [4:0]        rd2_addr,
+  input  wire [FLEN-1:0]   rd2_data,
+  input  wire              write2_single
 );
 
   // Register array: 32 x FLEN bits
@@ -35,12 +43,18 @@ module fp_register_file #(
   wire [FLEN-1:0] wr_data_boxed;
   assign wr_data_boxed = (FLEN == 64 && write_single) ? {32'hFFFFFFFF, rd_data[31:0]} : rd_data;
 
+  wire [FLEN-1:0] wr2_data_boxed;
+  assign wr2_data_boxed = (FLEN == 64 && write2_single) ? {32'hFFFFFFFF, rd2_data[31:0]} : rd2_data;
+
   // Combinational reads with internal forwarding (3 independent read ports)
   // If reading the register being written this cycle, forward the write data
   // This is critical for FP load-use cases where WB stage writes and ID stage reads in the same cycle
-  assign rs1_data = (wr_en && (rd_addr == rs1_addr)) ? wr_data_boxed : registers[rs1_addr];
-  assign rs2_data = (wr_en && (rd_addr == rs2_addr)) ? wr_data_boxed : registers[rs2_addr];
-  assign rs3_data = (wr_en && (rd_addr == rs3_addr)) ? wr_data_boxed : registers[rs3_addr];
+  assign rs1_data = (wr2_en && (rd2_addr == rs1_addr)) ? wr2_data_boxed :
+                    (wr_en && (rd_addr == rs1_addr)) ? wr_data_boxed : registers[rs1_addr];
+  assign rs2_data = (wr2_en && (rd2_addr == rs2_addr)) ? wr2_data_boxed :
+                    (wr_en && (rd_addr == rs2_addr)) ? wr_data_boxed : registers[rs2_addr];
+  assign rs3_data = (wr2_en && (rd2_addr == rs3_addr)) ? wr2_data_boxed :
+                    (wr_en && (rd_addr == rs3_addr)) ? wr_data_boxed : registers[rs3_addr];
 
   `ifdef DEBUG_FPU
   always @(*) begin
@@ -64,16 +78,24 @@ module fp_register_file #(
       for (i = 0; i < 32; i = i + 1) begin
         registers[i] <= {FLEN{1'b0}};
       end
-    end else if (wr_en) begin
-      // Write to register with optional NaN boxing
-      registers[rd_addr] <= wr_data_boxed;
-      `ifdef DEBUG_FPU
-      if (FLEN == 64 && write_single) begin
-        $display("[FP_REG] Write f%0d = %h (NaN-boxed single)", rd_addr, wr_data_boxed);
-      end else begin
-        $display("[FP_REG] Write f%0d = %h", rd_addr, wr_data_boxed);
+    end else begin
+      if (wr_en) begin
+        // Write to register with optional NaN boxing
+        registers[rd_addr] <= wr_data_boxed;
+        `ifdef DEBUG_FPU
+        if (FLEN == 64 && write_single) begin
+          $display("[FP_REG] Write f%0d = %h (NaN-boxed single)", rd_addr, wr_data_boxed);
+        end else begin
+          $display("[FP_REG] Write f%0d = %h", rd_addr, wr_data_boxed);
+        end
+        `endif
+      end
+      if (wr2_en) begin
+        registers[rd2_addr] <= wr2_data_boxed;
+        `ifdef DEBUG_FPU
+        $display("[FP_REG] Write f%0d = %h (pipelined FPU)", rd2_addr, wr2_data_boxed);
+        `endif
       end
-      `endif
     end
   end
 
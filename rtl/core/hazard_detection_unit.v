@@ -2,9 +2,10 @@
 // Detects load-use hazards and generates stall/bubble control signals
 // A load-use hazard occurs when a load instruction in EX stage
 // produces data needed by the instruction in ID stage
-//
-// ⚠️ KNOWN ISSUE: Atomic forwarding stall is overly conservative (~6% overhead)
-// See line ~126 for detailed explanation and proper fix (requires adding clk/reset_n)
+// Updated: 2026-10-16 - Atomic forwarding stall can end at the atomic's
+//                       completion cycle (ATOMIC_DONE_FORWARD, result forwarded
+//                       EX->ID) instead of costing an extra bubble
+// Updated: 2026-10-16 - Stall-cause vector for the performance counters
 
 `include "config/rv_csr_defines.vh"
 
@@ -15,21 +16,28 @@ module hazard_detection_unit (
   input  wire [4:0]  idex_rd,          // Destination register of load (integer)
   input  wire [4:0]  idex_fp_rd,       // Destination register of FP load
   input  wire        idex_fp_mem_op,   // FP memory operation (FP load/store)
+  input  wire        load_bypass_en,   // LOAD_USE_BYPASS: load data forwarded MEM->EX
+  input  wire        id_bypass_ok,     // ID instruction can take a bypassed load result
 
   // Inputs from IF/ID register (instruction in ID stage)
   input  wire [4:0]  ifid_rs1,         // Source register 1 (integer)
   input  wire [4:0]  ifid_rs2,         // Source register 2 (integer)
+  input  wire [4:0]  ifid1_rs1,        // Dual issue: lane-1 source register 1
+  input  wire [4:0]  ifid1_rs2,        // Dual issue: lane-1 source register 2
+  input  wire        ifid1_valid,      // Dual issue: lane-1 instruction present in ID
   input  wire [4:0]  ifid_fp_rs1,      // Source register 1 (FP)
   input  wire [4:0]  ifid_fp_rs2,      // Source register 2 (FP)
   input  wire [4:0]  ifid_fp_rs3,      // Source register 3 (FP, for FMA)
 
   // M extension signals
   input  wire        mul_div_busy,     // M unit is busy
-  input  wire        idex_is_mul_div,  // M instruction in EX stage
+  input  wire        idex_is_mul_div,  // M instruction in EX stage (iterative unit)
+  input  wire        idex_mul_late,    // Pipelined multiply in EX whose result is not ready until MEM/WB
 
   // A extension signals
   input  wire        atomic_busy,      // A unit is busy
   input  wire        atomic_done,      // A unit operation complete
+  input  wire        atomic_done_fwd_en, // ATOMIC_DONE_FORWARD: result forwarded EX->ID when done
   input  wire        idex_is_atomic,   // A instruction in EX stage
   input  wire        exmem_is_atomic,  // A instruction in MEM stage
   input  wire [4:0]  exmem_rd,         // MEM stage destination register
@@ -37,9 +45,12 @@ module hazard_detection_unit (
   // F/D extension signals
   input  wire        fpu_busy,         // FPU is busy (multi-cycle operation in progress)
   input  wire        fpu_done,         // FPU operation complete (1 cycle pulse)
-  input  wire        idex_fp_alu_en,   // FP instruction in EX stage
+  input  wire        idex_fp_alu_en,   // FP instruction in EX stage (multi-cycle fpu)
   input  wire        exmem_fp_reg_write, // FP instruction in MEM stage
   input  wire        memwb_fp_reg_write, // FP instruction in WB stage
+  input  wire        fp_sb_hazard,     // ID instruction uses a register the FMA pipeline or FDIV/FSQRT has in flight
+  input  wire        fp_pipe_busy,     // Pipelined FP ops in EX or in flight (flags still pending)
+  input  wire        int_sb_hazard,    // ID instruction uses a register a background divide has in flight
 
   // CSR signals (for FFLAGS/FCSR dependency checking and RAW hazards)
   input  wire [11:0] id_csr_addr,      // CSR address in ID stage
@@ -60,10 +71,17 @@ module hazard_detection_unit (
   input  wire        bus_req_valid,    // Bus request is active
   input  wire        bus_req_ready,    // Bus is ready to accept/complete request
 
+  // Store buffer
+  input  wire        sb_fence_stall,   // FENCE in EX waiting for buffered stores to drain
+
   // Hazard control outputs
   output wire        stall_pc,         // Stall program counter
   output wire        stall_ifid,       // Stall IF/ID register
-  output wire        bubble_idex       // Insert bubble (NOP) into ID/EX
+  output wire        bubble_idex,      // Insert bubble (NOP) into ID/EX
+
+  // Stall causes for the performance counters (csr_file.v mhpmevent),
+  // bit i = event HPM_EVENT_* i+1: {bus wait, MMU, FP, A, M, load-use}
+  output wire [5:0]  perf_stall_events
 );
 
   // Load-use hazard detection logic
@@ -90,8 +108,32 @@ module hazard_detection_unit (
   // Check if rs2 has a hazard
   assign rs2_hazard = (idex_rd == ifid_rs2) && (idex_rd != 5'h0);
 
+  // Dual issue: the lane-1 instruction in ID (a simple ALU op paired with the
+  // lane-0 instruction) has the same dependencies on the EX-stage lane-0
+  // instruction. Lane 1 of EX is always a single-cycle ALU op and is forwarded.
+  wire l1_hazard;
+  assign l1_hazard = ifid1_valid && (idex_rd != 5'h0) &&
+                     ((idex_rd == ifid1_rs1) || (idex_rd == ifid1_rs2));
+
+  // Load-use bypass (LOAD_USE_BYPASS): an integer load's data is forwarded
+  // from MEM straight into the dependent instruction in EX, so no bubble is
+  // needed. While the load waits on the bus the whole EX/MEM pair is held, and
+  // nothing in EX commits until the data is there. Consumers that act on their
+  // operands the first cycle they are in EX (M/A/FP units, CSR writes, branch
+  // resolution, and MMU lookups when translation is on) are not eligible
+  // (id_bypass_ok=0) and keep the 1-cycle stall. Lane 1 is always a plain ALU op.
+  wire load_bypass;
+  wire load_use_bypassed;
+  assign load_bypass = load_bypass_en && !idex_fp_mem_op && !idex_is_atomic;
+
   // Load-use hazard exists if there's a load and either source has a hazard
-  assign load_use_hazard = idex_mem_read && (rs1_hazard || rs2_hazard);
+  assign load_use_hazard = idex_mem_read &&
+                           (((rs1_hazard || rs2_hazard) && !(load_bypass && id_bypass_ok)) ||
+                            (l1_hazard && !load_bypass));
+
+  // Dependences resolved by the bypass instead of a stall (for statistics)
+  assign load_use_bypassed = idex_mem_read && load_bypass && !load_use_hazard &&
+                             (rs1_hazard || rs2_hazard || l1_hazard);
 
   // FP load-use hazard detection
   // Similar to integer load-use, but checks FP registers
@@ -120,6 +162,12 @@ module hazard_detection_unit (
   wire m_extension_stall;
   assign m_extension_stall = mul_div_busy || idex_is_mul_div;
 
+  // Pipelined multiply-use hazard (MUL_STAGES >= 2): the product is produced in
+  // MEM or WB, so a dependent instruction in ID waits one cycle with a bubble,
+  // exactly like load-use, and then takes the result from the WB forwarding path
+  wire mul_use_hazard;
+  assign mul_use_hazard = idex_mul_late && (rs1_hazard || rs2_hazard || l1_hazard);
+
   // A extension hazard: stall IF/ID stages when A unit is busy OR when A instruction just entered EX
   // Similar to M extension, atomic operations are multi-cycle and hold the pipeline.
   // BUT: Do not stall when operation is done - this allows the atomic instruction to leave ID/EX
@@ -147,36 +195,16 @@ module hazard_detection_unit (
   assign atomic_rs1_hazard_mem = (exmem_rd == ifid_rs1) && (exmem_rd != 5'h0);
   assign atomic_rs2_hazard_mem = (exmem_rd == ifid_rs2) && (exmem_rd != 5'h0);
 
-  // ============================================================================
-  // FIXME: PERFORMANCE ISSUE - Overly Conservative Stalling (~6% overhead)
-  // ============================================================================
-  // Current implementation: Stall entire atomic execution when dependency exists
-  // Problem: This stalls even when atomic hasn't completed yet AND during completion cycle
-  // Overhead: ~1,049 extra cycles (18,616 vs 17,567 expected) = 6% performance loss
-  //
-  // ROOT CAUSE: Transition cycle bug - when atomic_done=1, dependent instructions
-  // slip through before result propagates to EXMEM where MEM→ID forwarding works.
-  //
-  // BETTER SOLUTION (TODO):
-  //   1. Keep original logic: stall only when (!atomic_done && hazard)
-  //   2. Add ONE extra stall cycle when (atomic_done && hazard) using state register
-  //   3. This covers transition cycle without stalling entire atomic execution
-  //
-  // Example fix:
-  //   reg atomic_done_prev;
-  //   always @(posedge clk) atomic_done_prev <= atomic_done && idex_is_atomic;
-  //   assign atomic_forward_hazard =
-  //     (idex_is_atomic && !atomic_done && hazard) ||  // During execution
-  //     (atomic_done_prev && hazard);                   // Transition cycle only
-  //
-  // Why not implemented: Requires clk/reset_n ports, adds sequential logic complexity
-  // Trade-off: Accepted 6% overhead for simpler combinational-only design
-  // ============================================================================
-
-  // Stall if atomic in EX with dependency (including the completion cycle)
-  // This ensures dependent instructions wait until result is in EXMEM where MEM→ID forwarding works
+  // Default: the dependent instruction waits while the atomic is in EX,
+  // completion cycle included, and takes the result by MEM->ID forwarding.
+  // ATOMIC_DONE_FORWARD: it waits only while the atomic is still executing.
+  // In the completion cycle (atomic_done=1) the result is already in
+  // atomic_unit's result register and forwarding_unit allows EX->ID
+  // forwarding of it (idex_atomic_pending drops), so the dependent leaves ID
+  // together with the atomic leaving EX
   assign atomic_forward_hazard =
-    (idex_is_atomic && (atomic_rs1_hazard_ex || atomic_rs2_hazard_ex));
+    idex_is_atomic && !(atomic_done && atomic_done_fwd_en) &&
+    (atomic_rs1_hazard_ex || atomic_rs2_hazard_ex || l1_hazard);
 
   // FP extension hazard: stall IF/ID stages when FPU is busy with multi-cycle operations
   // FP multi-cycle operations (FDIV, FSQRT, FMA, etc.) hold the pipeline.
@@ -185,6 +213,11 @@ module hazard_detection_unit (
   wire fp_extension_stall;
   assign fp_extension_stall = (fpu_busy || idex_fp_alu_en) && !fpu_done;
 
+  // FP scoreboard hazard (FPU_PIPELINED): pipelined FADD/FMUL/FMA results land
+  // 3 cycles after leaving EX, so only instructions that read (or overwrite) an
+  // in-flight destination wait; independent FP ops keep issuing every cycle.
+  // Computed in the core from the scoreboard; stalls with a bubble like load-use.
+
   // MMU hazard: stall IF/ID stages when MMU is busy with page table walk
   // Page table walks are multi-cycle operations that must complete before proceeding.
   // This prevents IF/ID from advancing while EX/MEM stages are held waiting for MMU.
@@ -233,8 +266,11 @@ module hazard_detection_unit (
   //
   // Bug #7 Fix: Without checking MEM/WB stages, clearing FFLAGS can be contaminated
   // by in-flight FP operations that complete after the clear.
+  // Pipelined FP ops (FPU_PIPELINED) and background FDIV/FSQRT (NONBLOCKING_LONG_OPS)
+  // accumulate flags when they complete, after WB
   assign csr_fpu_dependency_stall = csr_accesses_fp_flags &&
-                                     (fpu_busy || idex_fp_alu_en || exmem_fp_reg_write || memwb_fp_reg_write);
+                                     (fpu_busy || idex_fp_alu_en || exmem_fp_reg_write || memwb_fp_reg_write ||
+                                      fp_pipe_busy);
 
   `ifdef DEBUG_FPU
   always @(posedge clk) begin
@@ -300,13 +336,17 @@ module hazard_detection_unit (
   `endif
 
   // Generate control signals
-  // Stall if load-use hazard (integer or FP), M extension dependency, A extension dependency,
-  // A extension forwarding hazard, FP extension dependency, CSR-FPU dependency, CSR RAW hazard, MMU dependency, or bus wait
-  assign stall_pc    = load_use_hazard || fp_load_use_hazard || m_extension_stall || a_extension_stall || atomic_forward_hazard || fp_extension_stall || csr_fpu_dependency_stall || csr_raw_hazard || mmu_stall || bus_wait_stall;
-  assign stall_ifid  = load_use_hazard || fp_load_use_hazard || m_extension_stall || a_extension_stall || atomic_forward_hazard || fp_extension_stall || csr_fpu_dependency_stall || csr_raw_hazard || mmu_stall || bus_wait_stall;
-  // Note: Bubble for load-use hazards, atomic forwarding hazards, CSR-FPU dependency stalls, AND CSR RAW hazards
-  // (M/A/FP/MMU/bus_wait stalls use hold signals on IDEX and EXMEM to keep instruction in place)
+  // Stall if load-use hazard (integer or FP), pipelined multiply-use, M extension dependency, A extension dependency,
+  // A extension forwarding hazard, FP extension dependency, FP/integer scoreboard hazard, CSR-FPU dependency, CSR RAW hazard,
+  // MMU dependency, bus wait, or FENCE waiting for the store buffer
+  assign stall_pc    = load_use_hazard || fp_load_use_hazard || mul_use_hazard || m_extension_stall || a_extension_stall || atomic_forward_hazard || fp_extension_stall || fp_sb_hazard || int_sb_hazard || csr_fpu_dependency_stall || csr_raw_hazard || mmu_stall || bus_wait_stall || sb_fence_stall;
+  assign stall_ifid  = load_use_hazard || fp_load_use_hazard || mul_use_hazard || m_extension_stall || a_extension_stall || atomic_forward_hazard || fp_extension_stall || fp_sb_hazard || int_sb_hazard || csr_fpu_dependency_stall || csr_raw_hazard || mmu_stall || bus_wait_stall || sb_fence_stall;
+  // Note: Bubble for load-use, multiply-use and FP/integer scoreboard hazards, atomic forwarding hazards, CSR-FPU dependency stalls, AND CSR RAW hazards
+  // (M/A/FP/MMU/bus_wait/FENCE drain stalls use hold signals on IDEX and EXMEM to keep instruction in place)
   // CSR-FPU and CSR RAW stalls need bubbles because they're RAW hazards between operations in EX and instructions in ID
-  assign bubble_idex = load_use_hazard || fp_load_use_hazard || atomic_forward_hazard || csr_fpu_dependency_stall || csr_raw_hazard;
+  assign bubble_idex = load_use_hazard || fp_load_use_hazard || mul_use_hazard || fp_sb_hazard || int_sb_hazard || atomic_forward_hazard || csr_fpu_dependency_stall || csr_raw_hazard;
+
+  assign perf_stall_events = {bus_wait_stall, mmu_stall, fp_extension_stall, a_extension_stall,
+                              m_extension_stall, load_use_hazard || fp_load_use_hazard};
 
 endmodule
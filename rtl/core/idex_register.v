@@ -84,6 +84,11 @@ module idex_register #(
   // C extension signal from ID stage
   input  wire        is_compressed_in, // Was instruction originally compressed?
 
+  // Branch prediction from IF stage
+  input  wire             bp_taken_in,
+  input  wire [XLEN-1:0]  bp_target_in,
+  input  wire [31:0]      bp_meta_in,
+
   // Outputs to EX stage
   output reg  [XLEN-1:0]  pc_out,
   output reg  [XLEN-1:0]  rs1_data_out,
@@ -152,7 +157,12 @@ module idex_register #(
   output reg  [31:0] instruction_out,
 
   // C extension signal to EX stage
-  output reg         is_compressed_out // Was instruction originally compressed?
+  output reg         is_compressed_out, // Was instruction originally compressed?
+
+  // Branch prediction to EX stage (misprediction check / predictor update)
+  output reg              bp_taken_out,
+  output reg  [XLEN-1:0]  bp_target_out,
+  output reg  [31:0]      bp_meta_out
 );
 
   `ifdef DEBUG_IDEX
@@ -235,6 +245,10 @@ module idex_register #(
       instruction_out <= 32'h0;
 
       is_compressed_out <= 1'b0;
+
+      bp_taken_out    <= 1'b0;
+      bp_target_out   <= {XLEN{1'b0}};
+      bp_meta_out     <= 32'd0;
     end else if (flush && !hold) begin
       // Flush: insert NOP bubble (clear control signals, keep data)
       // Note: hold takes priority over flush (M instructions must stay in place)
@@ -300,6 +314,10 @@ module idex_register #(
       instruction_out <= 32'h0;
 
       is_compressed_out <= 1'b0;
+
+      bp_taken_out    <= 1'b0;          // Bubble must not look like a predicted-taken instruction
+      bp_target_out   <= {XLEN{1'b0}};
+      bp_meta_out     <= 32'd0;
     end else if (!hold) begin
       // Normal operation: latch all values (only if not held)
       pc_out          <= pc_in;
@@ -363,6 +381,10 @@ module idex_register #(
       instruction_out <= instruction_in;
 
       is_compressed_out <= is_compressed_in;
+
+      bp_taken_out    <= bp_taken_in;
+      bp_target_out   <= bp_target_in;
+      bp_meta_out     <= bp_meta_in;
     end
     // If hold is asserted, keep previous values (register holds in place)
   end
@@ -19,6 +19,9 @@ module ifid_register #(
   input  wire             is_compressed_in, // Was the original instruction compressed?
   input  wire             page_fault_in,    // Session 117: Instruction page fault
   input  wire [XLEN-1:0]  fault_vaddr_in,   // Session 117: Faulting virtual address
+  input  wire             bp_taken_in,      // Branch predictor: predicted taken
+  input  wire [XLEN-1:0]  bp_target_in,     // Branch predictor: predicted target
+  input  wire [31:0]      bp_meta_in,       // Branch predictor: state snapshot
 
   // Outputs to ID stage
   output reg  [XLEN-1:0]  pc_out,
@@ -26,7 +29,10 @@ module ifid_register #(
   output reg              valid_out,       // 0 = bubble (NOP), 1 = valid instruction
   output reg              is_compressed_out, // Pipelined compressed flag
   output reg              page_fault_out,    // Session 117: Instruction page fault
-  output reg  [XLEN-1:0]  fault_vaddr_out   // Session 117: Faulting virtual address
+  output reg  [XLEN-1:0]  fault_vaddr_out,  // Session 117: Faulting virtual address
+  output reg              bp_taken_out,
+  output reg  [XLEN-1:0]  bp_target_out,
+  output reg  [31:0]      bp_meta_out
 );
 
   // NOP instruction encoding (ADDI x0, x0, 0)
@@ -41,6 +47,9 @@ module ifid_register #(
       is_compressed_out <= 1'b0;  // NOPs are not compressed
       page_fault_out    <= 1'b0;  // Session 117
       fault_vaddr_out   <= {XLEN{1'b0}};  // Session 117
+      bp_taken_out      <= 1'b0;
+      bp_target_out     <= {XLEN{1'b0}};
+      bp_meta_out       <= 32'd0;
     end else if (flush) begin
       // Flush: insert NOP bubble (branch taken)
       pc_out            <= {XLEN{1'b0}};
@@ -49,6 +58,9 @@ module ifid_register #(
       is_compressed_out <= 1'b0;  // NOPs are not compressed
       page_fault_out    <= 1'b0;  // Session 117: Clear page fault on flush
       fault_vaddr_out   <= {XLEN{1'b0}};  // Session 117
+      bp_taken_out      <= 1'b0;
+      bp_target_out     <= {XLEN{1'b0}};
+      bp_meta_out       <= 32'd0;
     end else if (stall) begin
       // Stall: hold current values (load-use hazard)
       pc_out            <= pc_out;
@@ -57,6 +69,9 @@ module ifid_register #(
       is_compressed_out <= is_compressed_out;
       page_fault_out    <= page_fault_out;  // Session 117
       fault_vaddr_out   <= fault_vaddr_out;  // Session 117
+      bp_taken_out      <= bp_taken_out;
+      bp_target_out     <= bp_target_out;
+      bp_meta_out       <= bp_meta_out;
     end else begin
       // Normal operation: latch new values
       pc_out            <= pc_in;
@@ -65,6 +80,9 @@ module ifid_register #(
       is_compressed_out <= is_compressed_in;
       page_fault_out    <= page_fault_in;  // Session 117
       fault_vaddr_out   <= fault_vaddr_in;  // Session 117
+      bp_taken_out      <= bp_taken_in;
+      bp_target_out     <= bp_target_in;
+      bp_meta_out       <= bp_meta_in;
     end
   end
 
@@ -0,0 +1,294 @@
+// long_op_unit.v - Background Long-Latency Execution Unit
+// Runs integer DIV/DIVU/REM/REMU (and W variants), FDIV and FSQRT off the main
+// pipeline so independent instructions keep issuing while they iterate
+// Features:
+//   - One integer divider (div_unit), one FP divider and one FP square root,
+//     each holding at most one operation (a second op of the same kind waits in EX)
+//   - Operations are issued from EX when they commit and can't be cancelled
+//   - Destination tag (and FP format) tracked per unit for the core scoreboard
+//   - Completion handshake: a finished result is held until the core grants it a
+//     register file write slot (integer: free WB slot, FP: free FP write port 2)
+//   - FDIV has completion priority over FSQRT when both are waiting
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`include "config/rv_config.vh"
+
+module long_op_unit #(
+  parameter XLEN = `XLEN,
+  parameter FLEN = `FLEN
+)(
+  input  wire              clk,
+  input  wire              reset_n,
+
+  // Integer divide issue (EX)
+  input  wire              int_issue,
+  input  wire [1:0]        int_op,        // 00=DIV, 01=DIVU, 10=REM, 11=REMU
+  input  wire              int_word,      // RV64: W-suffix instruction
+  input  wire [XLEN-1:0]   int_a,
+  input  wire [XLEN-1:0]   int_b,
+  input  wire [4:0]        int_rd,
+  output wire              int_busy,      // Divider occupied (running or waiting to write)
+
+  // Integer completion
+  output wire              int_wb_valid,
+  output wire [4:0]        int_wb_rd,
+  output wire [XLEN-1:0]   int_wb_data,
+  input  wire              int_wb_grant,  // Write happens this cycle
+
+  // FP issue (EX)
+  input  wire              fp_issue,
+  input  wire              fp_is_sqrt,    // 0: FDIV, 1: FSQRT
+  input  wire              fp_fmt,
+  input  wire [2:0]        fp_rm,
+  input  wire [4:0]        fp_rd,
+  input  wire [FLEN-1:0]   fp_a,
+  input  wire [FLEN-1:0]   fp_b,
+  output wire              fdiv_busy,
+  output wire              fsqrt_busy,
+
+  // FP completion
+  output wire              fp_wb_valid,
+  output wire [4:0]        fp_wb_rd,
+  output wire              fp_wb_fmt,
+  output wire [FLEN-1:0]   fp_wb_data,
+  output wire [4:0]        fp_wb_flags,   // {NV, DZ, OF, UF, NX}
+  input  wire              fp_wb_grant
+);
+
+  // Per-unit state
+  localparam IDLE  = 2'd0;
+  localparam START = 2'd1;                 // FP only: operands latched, start next cycle
+  localparam RUN   = 2'd2;
+  localparam WAIT  = 2'd3;                 // Result ready, waiting for a write slot
+
+  // =========================================================================
+  // Integer divider
+  // =========================================================================
+  // div_unit latches its operands on start, so it is started straight from EX
+
+  wire [XLEN-1:0] div_result;
+  wire            div_busy;
+  wire            div_ready;
+
+  div_unit #(
+    .XLEN(XLEN),
+    .RADIX(`DIV_RADIX)
+  ) u_div (
+    .clk(clk),
+    .reset_n(reset_n),
+    .start(int_issue),
+    .div_op(int_op),
+    .is_word_op(int_word),
+    .dividend(int_a),
+    .divisor(int_b),
+    .result(div_result),
+    .busy(div_busy),
+    .ready(div_ready)
+  );
+
+  reg  [1:0]      int_state;
+  reg  [4:0]      int_rd_r;
+  reg  [XLEN-1:0] int_result_r;
+
+  assign int_busy     = (int_state != IDLE);
+  assign int_wb_valid = (int_state == RUN && div_ready) || (int_state == WAIT);
+  assign int_wb_rd    = int_rd_r;
+  assign int_wb_data  = (int_state == WAIT) ? int_result_r : div_result;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      int_state    <= IDLE;
+      int_rd_r     <= 5'h0;
+      int_result_r <= {XLEN{1'b0}};
+    end else begin
+      case (int_state)
+        IDLE: begin
+          if (int_issue) begin
+            int_state <= RUN;
+            int_rd_r  <= int_rd;
+          end
+        end
+        RUN: begin
+          if (div_ready) begin
+            int_result_r <= div_result;
+            int_state    <= int_wb_grant ? IDLE : WAIT;
+          end
+        end
+        WAIT: begin
+          if (int_wb_grant)
+            int_state <= IDLE;
+        end
+        default: int_state <= IDLE;
+      endcase
+    end
+  end
+
+  // =========================================================================
+  // FP divider and square root
+  // =========================================================================
+  // fp_divider/fp_sqrt sample their operands and format after start and use
+  // the rounding mode until done, so each gets its own copy held for the
+  // whole operation and is started one cycle after issue
+
+  reg  [1:0]      fdiv_state,  fsqrt_state;
+  reg  [4:0]      fdiv_rd,     fsqrt_rd;
+  reg             fdiv_fmt,    fsqrt_fmt;
+  reg  [2:0]      fdiv_rm,     fsqrt_rm;
+  reg  [FLEN-1:0] fdiv_a,      fdiv_b,     fsqrt_a;
+  reg  [FLEN-1:0] fdiv_res_r,  fsqrt_res_r;
+  reg  [4:0]      fdiv_flags_r, fsqrt_flags_r;
+
+  wire            fdiv_done,   fsqrt_done;
+  wire            fdiv_unit_busy, fsqrt_unit_busy;
+  wire [FLEN-1:0] fdiv_result, fsqrt_result;
+  wire            fdiv_nv, fdiv_dz, fdiv_of, fdiv_uf, fdiv_nx;
+  wire            fsqrt_nv, fsqrt_nx;
+
+  fp_divider #(.FLEN(FLEN)) u_fp_divider (
+    .clk            (clk),
+    .reset_n        (reset_n),
+    .start          (fdiv_state == START),
+    .fmt            (fdiv_fmt),
+    .rounding_mode  (fdiv_rm),
+    .busy           (fdiv_unit_busy),
+    .done           (fdiv_done),
+    .operand_a      (fdiv_a),
+    .operand_b      (fdiv_b),
+    .result         (fdiv_result),
+    .flag_nv        (fdiv_nv),
+    .flag_dz        (fdiv_dz),
+    .flag_of        (fdiv_of),
+    .flag_uf        (fdiv_uf),
+    .flag_nx        (fdiv_nx)
+  );
+
+  fp_sqrt #(.FLEN(FLEN)) u_fp_sqrt (
+    .clk            (clk),
+    .reset_n        (reset_n),
+    .start          (fsqrt_state == START),
+    .fmt            (fsqrt_fmt),
+    .rounding_mode  (fsqrt_rm),
+    .busy           (fsqrt_unit_busy),
+    .done           (fsqrt_done),
+    .operand        (fsqrt_a),
+    .result         (fsqrt_result),
+    .flag_nv        (fsqrt_nv),
+    .flag_nx        (fsqrt_nx)
+  );
+
+  assign fdiv_busy  = (fdiv_state != IDLE);
+  assign fsqrt_busy = (fsqrt_state != IDLE);
+
+  // Completion select: FDIV first, then FSQRT
+  wire fdiv_wb_valid  = (fdiv_state == RUN && fdiv_done) || (fdiv_state == WAIT);
+  wire fsqrt_wb_valid = (fsqrt_state == RUN && fsqrt_done) || (fsqrt_state == WAIT);
+  wire fdiv_grant     = fp_wb_grant && fdiv_wb_valid;
+  wire fsqrt_grant    = fp_wb_grant && !fdiv_wb_valid && fsqrt_wb_valid;
+
+  wire [FLEN-1:0] fdiv_res_now    = (fdiv_state == WAIT) ? fdiv_res_r : fdiv_result;
+  wire [4:0]      fdiv_flags_now  = (fdiv_state == WAIT) ? fdiv_flags_r :
+                                    {fdiv_nv, fdiv_dz, fdiv_of, fdiv_uf, fdiv_nx};
+  wire [FLEN-1:0] fsqrt_res_now   = (fsqrt_state == WAIT) ? fsqrt_res_r : fsqrt_result;
+  wire [4:0]      fsqrt_flags_now = (fsqrt_state == WAIT) ? fsqrt_flags_r :
+                                    {fsqrt_nv, 3'b000, fsqrt_nx};
+
+  assign fp_wb_valid = fdiv_wb_valid || fsqrt_wb_valid;
+  assign fp_wb_rd    = fdiv_wb_valid ? fdiv_rd        : fsqrt_rd;
+  assign fp_wb_fmt   = fdiv_wb_valid ? fdiv_fmt       : fsqrt_fmt;
+  assign fp_wb_data  = fdiv_wb_valid ? fdiv_res_now   : fsqrt_res_now;
+  assign fp_wb_flags = fdiv_wb_valid ? fdiv_flags_now : fsqrt_flags_now;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      fdiv_state    <= IDLE;
+      fdiv_rd       <= 5'h0;
+      fdiv_fmt      <= 1'b0;
+      fdiv_rm       <= 3'b000;
+      fdiv_a        <= {FLEN{1'b0}};
+      fdiv_b        <= {FLEN{1'b0}};
+      fdiv_res_r    <= {FLEN{1'b0}};
+      fdiv_flags_r  <= 5'b0;
+    end else begin
+      case (fdiv_state)
+        IDLE: begin
+          if (fp_issue && !fp_is_sqrt) begin
+            fdiv_state <= START;
+            fdiv_rd    <= fp_rd;
+            fdiv_fmt   <= fp_fmt;
+            fdiv_rm    <= fp_rm;
+            fdiv_a     <= fp_a;
+            fdiv_b     <= fp_b;
+          end
+        end
+        START: fdiv_state <= RUN;
+        RUN: begin
+          if (fdiv_done) begin
+            fdiv_res_r   <= fdiv_result;
+            fdiv_flags_r <= {fdiv_nv, fdiv_dz, fdiv_of, fdiv_uf, fdiv_nx};
+            fdiv_state   <= fdiv_grant ? IDLE : WAIT;
+          end
+        end
+        WAIT: begin
+          if (fdiv_grant)
+            fdiv_state <= IDLE;
+        end
+      endcase
+    end
+  end
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      fsqrt_state   <= IDLE;
+      fsqrt_rd      <= 5'h0;
+      fsqrt_fmt     <= 1'b0;
+      fsqrt_rm      <= 3'b000;
+      fsqrt_a       <= {FLEN{1'b0}};
+      fsqrt_res_r   <= {FLEN{1'b0}};
+      fsqrt_flags_r <= 5'b0;
+    end else begin
+      case (fsqrt_state)
+        IDLE: begin
+          if (fp_issue && fp_is_sqrt) begin
+            fsqrt_state <= START;
+            fsqrt_rd    <= fp_rd;
+            fsqrt_fmt   <= fp_fmt;
+            fsqrt_rm    <= fp_rm;
+            fsqrt_a     <= fp_a;
+          end
+        end
+        START: fsqrt_state <= RUN;
+        RUN: begin
+          if (fsqrt_done) begin
+            fsqrt_res_r   <= fsqrt_result;
+            fsqrt_flags_r <= {fsqrt_nv, 3'b000, fsqrt_nx};
+            fsqrt_state   <= fsqrt_grant ? IDLE : WAIT;
+          end
+        end
+        WAIT: begin
+          if (fsqrt_grant)
+            fsqrt_state <= IDLE;
+        end
+      endcase
+    end
+  end
+
+  `ifdef DEBUG_DIV
+  always @(posedge clk) begin
+    if (int_issue)
+      $display("[LONG_OP] DIV issue: op=%b a=%h b=%h rd=x%0d", int_op, int_a, int_b, int_rd);
+    if (int_wb_valid && int_wb_grant)
+      $display("[LONG_OP] DIV done: x%0d <= %h", int_wb_rd, int_wb_data);
+  end
+  `endif
+
+  `ifdef DEBUG_FPU
+  always @(posedge clk) begin
+    if (fp_issue)
+      $display("[LONG_OP] %s issue: a=%h b=%h rd=f%0d", fp_is_sqrt ? "FSQRT" : "FDIV", fp_a, fp_b, fp_rd);
+    if (fp_wb_valid && fp_wb_grant)
+      $display("[LONG_OP] FP done: f%0d <= %h flags=%b", fp_wb_rd, fp_wb_data, fp_wb_flags);
+  end
+  `endif
+
+endmodule
@@ -2,15 +2,33 @@
 // Implements RISC-V Sv32 (RV32) and Sv39 (RV64) virtual memory translation
 // Separate TLBs for instruction fetch (I-TLB) and data access (D-TLB)
 // Eliminates structural hazard from unified TLB arbiter
+// Both TLBs are ASID-tagged (satp.ASID), so a satp switch needs no flush
+// Optional shared L2 TLB (l2_tlb.v): an L1 miss probes it before the PTW is
+// started; PTW results fill both the requesting L1 and the L2
+// Optional hardware A/D update (HW_AD_UPDATE): the PTW writes PTE.A/PTE.D back
+// through the walk memory port; a store to a clean cached page re-walks
+// Non-blocking: each TLB keeps hitting while the other side's walk is in
+// flight; a miss waits as a pending request and is started as soon as the
+// walker is free, and results/faults are routed to the TLB that owns the walk
 // Author: RV1 Project
 // Date: 2025-11-08 (Session 125)
+// Updated: 2026-10-16 - ASID-tagged TLBs, ASID-selective SFENCE.VMA
+// Updated: 2026-10-16 - Shared L2 TLB
+// Updated: 2026-10-16 - Hardware A/D update
+// Updated: 2026-10-16 - Hit-under-miss, owner-routed walk completion
+// Updated: 2026-10-16 - I-TLB/D-TLB miss pulses for the performance counters
+// Updated: 2026-10-16 - PTW A/D read-modify-write lock output
 
 `include "config/rv_config.vh"
 
 module dual_tlb_mmu #(
   parameter XLEN = `XLEN,
   parameter ITLB_ENTRIES = 8,   // I-TLB entries
-  parameter DTLB_ENTRIES = 16   // D-TLB entries (data accesses more frequent)
+  parameter DTLB_ENTRIES = 16,  // D-TLB entries (data accesses more frequent)
+  parameter L2_TLB_ENTRIES    = `L2_TLB_ENTRIES,     // 0 = no L2 TLB
+  parameter L2_TLB_WAYS       = `L2_TLB_WAYS,
+  parameter L2_TLB_SUPERPAGES = `L2_TLB_SUPERPAGES,
+  parameter HW_AD_UPDATE      = `PTW_AD_UPDATE       // PTW sets PTE.A/PTE.D
 ) (
   input  wire             clk,
   input  wire             reset_n,
@@ -35,6 +53,9 @@ module dual_tlb_mmu #(
   // Memory interface for page table walks (shared PTW)
   output wire             ptw_req_valid,
   output wire [XLEN-1:0]  ptw_req_addr,
+  output wire             ptw_req_we,          // A/D write-back (word)
+  output wire [XLEN-1:0]  ptw_req_wdata,
+  output wire             ptw_rmw_lock,        // A/D read-modify-write: keep the bus
   input  wire             ptw_req_ready,
   input  wire [XLEN-1:0]  ptw_resp_data,
   input  wire             ptw_resp_valid,
@@ -48,7 +69,18 @@ module dual_tlb_mmu #(
   // TLB flush control
   input  wire             tlb_flush_all,
   input  wire             tlb_flush_vaddr,
-  input  wire [XLEN-1:0]  tlb_flush_addr
+  input  wire [XLEN-1:0]  tlb_flush_addr,
+  input  wire             tlb_flush_asid,       // SFENCE.VMA rs2 != x0
+  input  wire [15:0]      tlb_flush_asid_value, // rs2 value (ASID)
+
+  // L2 TLB statistics
+  output wire [31:0]      l2_tlb_hits,
+  output wire [31:0]      l2_tlb_misses,
+
+  // L1 miss events (one cycle per miss, when it is looked up in the L2 TLB
+  // or handed to the walker)
+  output wire             itlb_miss,
+  output wire             dtlb_miss
 );
 
   // =========================================================================
@@ -57,12 +89,18 @@ module dual_tlb_mmu #(
 
   wire satp_mode_enabled;
   wire translation_enabled;
+  wire [15:0] satp_asid;      // Sv32: satp[30:22] (9 bits), Sv39: satp[59:44]
+  wire [15:0] flush_asid_value;
 
   generate
     if (XLEN == 32) begin : gen_mode_sv32
       assign satp_mode_enabled = (satp[31:31] == 1'b1);
+      assign satp_asid         = {7'b0, satp[30:22]};
+      assign flush_asid_value  = {7'b0, tlb_flush_asid_value[8:0]};
     end else begin : gen_mode_sv39
       assign satp_mode_enabled = (satp[63:60] == 4'h8);
+      assign satp_asid         = satp[59:44];
+      assign flush_asid_value  = tlb_flush_asid_value;
     end
   endgenerate
 
@@ -83,7 +121,8 @@ module dual_tlb_mmu #(
 
   tlb #(
     .XLEN(XLEN),
-    .TLB_ENTRIES(ITLB_ENTRIES)
+    .TLB_ENTRIES(ITLB_ENTRIES),
+    .HW_AD_UPDATE(HW_AD_UPDATE)
   ) itlb_inst (
     .clk(clk),
     .reset_n(reset_n),
@@ -106,10 +145,13 @@ module dual_tlb_mmu #(
     .mstatus_sum(mstatus_sum),
     .mstatus_mxr(mstatus_mxr),
     .translation_enabled(translation_enabled),
+    .asid(satp_asid),
     // Flush
     .flush_all(tlb_flush_all),
     .flush_vaddr(tlb_flush_vaddr),
-    .flush_addr(tlb_flush_addr)
+    .flush_addr(tlb_flush_addr),
+    .flush_asid(tlb_flush_asid),
+    .flush_asid_value(flush_asid_value)
   );
 
   // =========================================================================
@@ -127,7 +169,8 @@ module dual_tlb_mmu #(
 
   tlb #(
     .XLEN(XLEN),
-    .TLB_ENTRIES(DTLB_ENTRIES)
+    .TLB_ENTRIES(DTLB_ENTRIES),
+    .HW_AD_UPDATE(HW_AD_UPDATE)
   ) dtlb_inst (
     .clk(clk),
     .reset_n(reset_n),
@@ -150,17 +193,23 @@ module dual_tlb_mmu #(
     .mstatus_sum(mstatus_sum),
     .mstatus_mxr(mstatus_mxr),
     .translation_enabled(translation_enabled),
+    .asid(satp_asid),
     // Flush
     .flush_all(tlb_flush_all),
     .flush_vaddr(tlb_flush_vaddr),
-    .flush_addr(tlb_flush_addr)
+    .flush_addr(tlb_flush_addr),
+    .flush_asid(tlb_flush_asid),
+    .flush_asid_value(flush_asid_value)
   );
 
   // =========================================================================
   // Shared PTW Arbiter
   // =========================================================================
   // Priority: D-TLB > I-TLB (data misses block pipeline more)
-  // PTW conflicts are rare (TLB misses infrequent after warmup)
+  // Each side has at most one outstanding miss. A miss that arrives while the
+  // other side's walk is in flight stays pending (the requester keeps its
+  // request up) and is started in the first cycle the walker is idle; the
+  // TLBs keep serving hits meanwhile.
 
   wire if_needs_ptw = if_req_valid && !itlb_hit && translation_enabled;
   wire ex_needs_ptw = ex_req_valid && !dtlb_hit && translation_enabled;
@@ -175,11 +224,30 @@ module dual_tlb_mmu #(
   wire ptw_req_is_store;
   wire ptw_req_is_fetch;
 
-  // Forward declare ptw_busy_r (defined below)
-  reg ptw_busy_r;
+  wire ptw_walking;
+  wire ptw_ready;
+  wire ptw_result_valid;
+
+  // Walker free for a new request: not walking, and not completing (the
+  // completed requester still misses until its TLB is refilled at the clock)
+  wire ptw_idle = !ptw_walking && !ptw_ready;
+
+  // L2 TLB probe: once per L1 miss, while the walker is idle
+  // (the probed L1 is refilled instead of walking)
+  wire tlb_flushing = tlb_flush_all || tlb_flush_vaddr || tlb_flush_asid;
+  wire l2_probe = (if_needs_ptw || ex_needs_ptw) && ptw_idle && !tlb_flushing;
+  wire l2_hit;
+  wire [7:0] l2_pte;
+  // With A/D update, a store to a clean page must re-walk rather than refill
+  // the D-TLB with D=0 again
+  wire l2_clean_store = HW_AD_UPDATE && ptw_grant_to_ex && ex_req_is_store && !l2_pte[7];
+  wire l2_refill = l2_probe && l2_hit && !l2_clean_store;
+
+  assign itlb_miss = l2_probe && ptw_grant_to_if;
+  assign dtlb_miss = l2_probe && ptw_grant_to_ex;
 
-  // Only generate PTW request if not already busy (prevents duplicate walks)
-  assign ptw_req_valid_internal = (if_needs_ptw || ex_needs_ptw) && !ptw_busy_r;
+  // Only generate PTW request if idle (prevents duplicate walks)
+  assign ptw_req_valid_internal = (if_needs_ptw || ex_needs_ptw) && ptw_idle && !l2_refill;
 
   // Debug: Detailed MMU operation tracing
   always @(posedge clk) begin
@@ -211,17 +279,16 @@ module dual_tlb_mmu #(
   // Shared PTW
   // =========================================================================
 
-  wire ptw_ready;
   wire ptw_page_fault;
   wire [XLEN-1:0] ptw_fault_vaddr;
-  wire ptw_result_valid;
   wire [XLEN-1:0] ptw_result_vpn;
   wire [XLEN-1:0] ptw_result_ppn;
   wire [7:0] ptw_result_pte;
   wire [XLEN-1:0] ptw_result_level;
 
   ptw #(
-    .XLEN(XLEN)
+    .XLEN(XLEN),
+    .AD_UPDATE(HW_AD_UPDATE)
   ) ptw_inst (
     .clk(clk),
     .reset_n(reset_n),
@@ -233,6 +300,8 @@ module dual_tlb_mmu #(
     .req_ready(ptw_ready),
     .req_page_fault(ptw_page_fault),
     .req_fault_vaddr(ptw_fault_vaddr),
+    .busy(ptw_walking),
+    .rmw_lock(ptw_rmw_lock),
     // Result for TLB update
     .result_valid(ptw_result_valid),
     .result_vpn(ptw_result_vpn),
@@ -242,6 +311,8 @@ module dual_tlb_mmu #(
     // Memory interface
     .mem_req_valid(ptw_req_valid),
     .mem_req_addr(ptw_req_addr),
+    .mem_req_we(ptw_req_we),
+    .mem_req_wdata(ptw_req_wdata),
     .mem_req_ready(ptw_req_ready),
     .mem_resp_data(ptw_resp_data),
     .mem_resp_valid(ptw_resp_valid),
@@ -249,45 +320,102 @@ module dual_tlb_mmu #(
     .satp(satp),
     .privilege_mode(privilege_mode),
     .mstatus_sum(mstatus_sum),
-    .mstatus_mxr(mstatus_mxr)
+    .mstatus_mxr(mstatus_mxr),
+    // Page-walk cache flush
+    .flush_all(tlb_flush_all),
+    .flush_vaddr(tlb_flush_vaddr),
+    .flush_asid(tlb_flush_asid),
+    .flush_asid_value(flush_asid_value)
   );
 
   // Track which TLB initiated the PTW (to route result back)
-  // Latch only on the FIRST cycle of PTW (when PTW transitions from idle to busy)
+  // Latched when the walker accepts the request; the live grant may move to
+  // the other side while the walk is in flight
   reg ptw_for_itlb;
-  // Note: ptw_busy_r declared earlier (line 179)
 
   always @(posedge clk or negedge reset_n) begin
     if (!reset_n) begin
       ptw_for_itlb <= 0;
-      ptw_busy_r <= 0;
-    end else begin
-      // Update busy status
-      if (ptw_req_valid_internal && !ptw_ready) begin
-        ptw_busy_r <= 1;  // PTW is now busy
-      end else if (ptw_ready || !ptw_req_valid_internal) begin
-        ptw_busy_r <= 0;  // PTW is idle
-      end
-
-      // Latch grant ONLY when PTW starts (transition from idle to busy)
-      if (ptw_req_valid_internal && !ptw_busy_r) begin
-        ptw_for_itlb <= ptw_grant_to_if;
-      end
+    end else if (ptw_req_valid_internal) begin
+      ptw_for_itlb <= ptw_grant_to_if;
     end
   end
 
-  // Route PTW result to correct TLB
-  assign itlb_update_valid = ptw_result_valid && ptw_for_itlb;
-  assign itlb_update_vpn = ptw_result_vpn;
-  assign itlb_update_ppn = ptw_result_ppn;
-  assign itlb_update_pte = ptw_result_pte;
-  assign itlb_update_level = ptw_result_level;
+  // A walk fault is reported only if its owner still misses on the same page
+  // (the request may have been redirected or flushed while the walk ran; it
+  // then simply misses again)
+  wire if_ptw_fault = ptw_page_fault && ptw_for_itlb && if_needs_ptw &&
+                      (ptw_fault_vaddr[XLEN-1:12] == if_req_vaddr[XLEN-1:12]);
+  wire ex_ptw_fault = ptw_page_fault && !ptw_for_itlb && ex_needs_ptw &&
+                      (ptw_fault_vaddr[XLEN-1:12] == ex_req_vaddr[XLEN-1:12]);
+
+  // =========================================================================
+  // L2 TLB
+  // =========================================================================
+
+  wire [XLEN-1:0] l2_vpn;
+  wire [XLEN-1:0] l2_ppn;
+  wire [XLEN-1:0] l2_level;
+
+  generate
+    if (L2_TLB_ENTRIES > 0) begin : gen_l2_tlb
+      l2_tlb #(
+        .XLEN(XLEN),
+        .ENTRIES(L2_TLB_ENTRIES),
+        .WAYS(L2_TLB_WAYS),
+        .SUPERPAGES(L2_TLB_SUPERPAGES)
+      ) l2_tlb_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        // Lookup for the arbitrated L1 miss
+        .lookup_valid(l2_probe),
+        .lookup_vaddr(ptw_req_vaddr),
+        .lookup_hit(l2_hit),
+        .lookup_vpn(l2_vpn),
+        .lookup_ppn(l2_ppn),
+        .lookup_pte(l2_pte),
+        .lookup_level(l2_level),
+        // Fill from PTW
+        .update_valid(ptw_result_valid),
+        .update_vpn(ptw_result_vpn),
+        .update_ppn(ptw_result_ppn),
+        .update_pte(ptw_result_pte),
+        .update_level(ptw_result_level),
+        .asid(satp_asid),
+        // Flush
+        .flush_all(tlb_flush_all),
+        .flush_vaddr(tlb_flush_vaddr),
+        .flush_addr(tlb_flush_addr),
+        .flush_asid(tlb_flush_asid),
+        .flush_asid_value(flush_asid_value),
+        // Statistics
+        .stat_hits(l2_tlb_hits),
+        .stat_misses(l2_tlb_misses)
+      );
+    end else begin : gen_no_l2_tlb
+      assign l2_hit        = 1'b0;
+      assign l2_vpn        = {XLEN{1'b0}};
+      assign l2_ppn        = {XLEN{1'b0}};
+      assign l2_pte        = 8'h00;
+      assign l2_level      = {XLEN{1'b0}};
+      assign l2_tlb_hits   = 32'h0;
+      assign l2_tlb_misses = 32'h0;
+    end
+  endgenerate
+
+  // Route PTW result (or L2 hit) to correct TLB
+  // An L2 probe never coincides with a PTW result, so the two never collide
+  assign itlb_update_valid = (ptw_result_valid && ptw_for_itlb) || (l2_refill && ptw_grant_to_if);
+  assign itlb_update_vpn = ptw_result_valid ? ptw_result_vpn : l2_vpn;
+  assign itlb_update_ppn = ptw_result_valid ? ptw_result_ppn : l2_ppn;
+  assign itlb_update_pte = ptw_result_valid ? ptw_result_pte : l2_pte;
+  assign itlb_update_level = ptw_result_valid ? ptw_result_level : l2_level;
 
-  assign dtlb_update_valid = ptw_result_valid && !ptw_for_itlb;
-  assign dtlb_update_vpn = ptw_result_vpn;
-  assign dtlb_update_ppn = ptw_result_ppn;
-  assign dtlb_update_pte = ptw_result_pte;
-  assign dtlb_update_level = ptw_result_level;
+  assign dtlb_update_valid = (ptw_result_valid && !ptw_for_itlb) || (l2_refill && ptw_grant_to_ex);
+  assign dtlb_update_vpn = itlb_update_vpn;
+  assign dtlb_update_ppn = itlb_update_ppn;
+  assign dtlb_update_pte = itlb_update_pte;
+  assign dtlb_update_level = itlb_update_level;
 
   // =========================================================================
   // I-TLB Response
@@ -296,10 +424,12 @@ module dual_tlb_mmu #(
   // Bare mode (translation disabled): immediate response with VA=PA
   wire if_bare_mode = !translation_enabled;
 
-  // IF ready when: (1) bare mode, (2) TLB hit, or (3) PTW complete for IF
+  // IF ready when: (1) bare mode, (2) TLB hit, or (3) PTW fault for IF
+  // A successful walk refills the I-TLB at the end of its completion cycle;
+  // the request is answered by the TLB hit on the next cycle
   assign if_req_ready = if_bare_mode ||
                         (if_req_valid && itlb_hit) ||
-                        (ptw_ready && ptw_grant_to_if);
+                        if_ptw_fault;
 
   // IF physical address: bare mode→VA, TLB hit→TLB result, PTW miss→0 (stalled)
   assign if_req_paddr = if_bare_mode ? if_req_vaddr :
@@ -308,7 +438,7 @@ module dual_tlb_mmu #(
 
   // IF page fault: TLB hit with permission fault, or PTW fault for IF
   assign if_req_page_fault = (if_req_valid && itlb_hit && itlb_page_fault) ||
-                             (ptw_page_fault && ptw_grant_to_if);
+                             if_ptw_fault;
 
   assign if_req_fault_vaddr = ptw_fault_vaddr;
 
@@ -320,14 +450,14 @@ module dual_tlb_mmu #(
 
   assign ex_req_ready = ex_bare_mode ||
                         (ex_req_valid && dtlb_hit) ||
-                        (ptw_ready && ptw_grant_to_ex);
+                        ex_ptw_fault;
 
   assign ex_req_paddr = ex_bare_mode ? ex_req_vaddr :
                         dtlb_hit ? dtlb_paddr :
                         {XLEN{1'b0}};
 
   assign ex_req_page_fault = (ex_req_valid && dtlb_hit && dtlb_page_fault) ||
-                             (ptw_page_fault && ptw_grant_to_ex);
+                             ex_ptw_fault;
 
   assign ex_req_fault_vaddr = ptw_fault_vaddr;
 
@@ -0,0 +1,380 @@
+// l2_tlb.v - Second-Level TLB
+// Shared backing TLB for the I-TLB and D-TLB, looked up on an L1 TLB miss
+// before the page table walker is started
+// Features:
+//   - ENTRIES-entry, WAYS-way set-associative array for 4KB pages, indexed by
+//     the low VPN bits
+//   - Separate SUPERPAGES-entry fully-associative array for megapages and
+//     gigapages (Sv32 4MB, Sv39 2MB/1GB), matched on the VPN bits above their level
+//   - Tree pseudo-LRU replacement in each set and in the superpage array;
+//     invalid entries are filled first, and a re-walk of a cached page
+//     (A/D update) overwrites its entry
+//   - Filled from every PTW result; ASID-tagged with global (PTE.G) entries and
+//     the same SFENCE.VMA flush variants as tlb.v
+//   - Combinational lookup: the L1 is refilled at the end of the probe cycle
+//     and hits on the next one
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`include "config/rv_config.vh"
+
+module l2_tlb #(
+  parameter XLEN       = `XLEN,
+  parameter ENTRIES    = 128,  // 4KB-page entries (power of 2)
+  parameter WAYS       = 4,    // Associativity of the 4KB-page array (power of 2)
+  parameter SUPERPAGES = 8     // Superpage entries (power of 2)
+) (
+  input  wire             clk,
+  input  wire             reset_n,
+
+  // Lookup (on an L1 TLB miss)
+  input  wire             lookup_valid,
+  input  wire [XLEN-1:0]  lookup_vaddr,
+  output wire             lookup_hit,
+  output reg  [XLEN-1:0]  lookup_vpn,        // Entry contents for the L1 refill
+  output reg  [XLEN-1:0]  lookup_ppn,
+  output reg  [7:0]       lookup_pte,
+  output reg  [XLEN-1:0]  lookup_level,
+
+  // Fill from PTW
+  input  wire             update_valid,
+  input  wire [XLEN-1:0]  update_vpn,
+  input  wire [XLEN-1:0]  update_ppn,
+  input  wire [7:0]       update_pte,
+  input  wire [XLEN-1:0]  update_level,
+
+  input  wire [15:0]      asid,              // Current satp.ASID (lookups and fills)
+
+  // Flush control (SFENCE.VMA, same semantics as tlb.v)
+  input  wire             flush_all,
+  input  wire             flush_vaddr,
+  input  wire [XLEN-1:0]  flush_addr,
+  input  wire             flush_asid,
+  input  wire [15:0]      flush_asid_value,
+
+  // Statistics
+  output reg  [31:0]      stat_hits,
+  output reg  [31:0]      stat_misses
+);
+
+  localparam PTE_G = 5;
+
+  localparam NUM_SETS   = ENTRIES / WAYS;
+  localparam SET_BITS   = (NUM_SETS > 1) ? $clog2(NUM_SETS) : 1;
+  localparam WAY_BITS   = (WAYS > 1) ? $clog2(WAYS) : 1;
+  localparam PLRU_BITS  = (WAYS > 1) ? (WAYS - 1) : 1;
+  localparam SP_BITS    = (SUPERPAGES > 1) ? $clog2(SUPERPAGES) : 1;
+  localparam SP_PLRU    = (SUPERPAGES > 1) ? (SUPERPAGES - 1) : 1;
+
+  // =========================================================================
+  // Storage
+  // =========================================================================
+
+  // 4KB pages: entry (set * WAYS + way)
+  reg                   pg_valid [0:ENTRIES-1];
+  reg [XLEN-1:0]        pg_vpn   [0:ENTRIES-1];
+  reg [XLEN-1:0]        pg_ppn   [0:ENTRIES-1];
+  reg [7:0]             pg_pte   [0:ENTRIES-1];
+  reg [15:0]            pg_asid  [0:ENTRIES-1];
+  reg [PLRU_BITS-1:0]   pg_plru  [0:NUM_SETS-1];
+
+  // Superpages
+  reg                   sp_valid [0:SUPERPAGES-1];
+  reg [XLEN-1:0]        sp_vpn   [0:SUPERPAGES-1];
+  reg [XLEN-1:0]        sp_ppn   [0:SUPERPAGES-1];
+  reg [7:0]             sp_pte   [0:SUPERPAGES-1];
+  reg [XLEN-1:0]        sp_level [0:SUPERPAGES-1];
+  reg [15:0]            sp_asid  [0:SUPERPAGES-1];
+  reg [SP_PLRU-1:0]     sp_plru;
+
+  // =========================================================================
+  // Helpers
+  // =========================================================================
+
+  function [XLEN-1:0] get_full_vpn;
+    input [XLEN-1:0] vaddr;
+    begin
+      if (XLEN == 32)
+        get_full_vpn = {{(XLEN-20){1'b0}}, vaddr[31:12]};
+      else
+        get_full_vpn = {{(XLEN-27){1'b0}}, vaddr[38:12]};
+    end
+  endfunction
+
+  function [SET_BITS-1:0] vpn_set;
+    input [XLEN-1:0] vpn;
+    begin
+      vpn_set = (NUM_SETS > 1) ? vpn[SET_BITS-1:0] : {SET_BITS{1'b0}};
+    end
+  endfunction
+
+  // A superpage matches on the VPN fields above its level
+  function vpn_match;
+    input [XLEN-1:0] entry_vpn;
+    input [XLEN-1:0] vpn;
+    input [XLEN-1:0] level;
+    begin
+      if (XLEN == 32)
+        vpn_match = (level == 1) ? (entry_vpn[19:10] == vpn[19:10]) : (entry_vpn == vpn);
+      else
+        case (level)
+          1:       vpn_match = (entry_vpn[26:9]  == vpn[26:9]);
+          2:       vpn_match = (entry_vpn[26:18] == vpn[26:18]);
+          default: vpn_match = (entry_vpn == vpn);
+        endcase
+    end
+  endfunction
+
+  function asid_match;
+    input [7:0]  pte;
+    input [15:0] entry_asid;
+    input [15:0] cur_asid;
+    begin
+      asid_match = pte[PTE_G] || (entry_asid == cur_asid);
+    end
+  endfunction
+
+  // Tree pseudo-LRU (as in icache.v): bit=0 -> victim left, bit=1 -> right
+  function [WAY_BITS-1:0] plru_victim;
+    input [PLRU_BITS-1:0] bits;
+    integer lvl, node;
+    begin
+      node = 0;
+      for (lvl = 0; lvl < WAY_BITS; lvl = lvl + 1)
+        node = 2 * node + 1 + bits[node];
+      plru_victim = node - (WAYS - 1);
+    end
+  endfunction
+
+  function [PLRU_BITS-1:0] plru_touch;
+    input [PLRU_BITS-1:0] bits;
+    input [WAY_BITS-1:0]  way;
+    integer lvl, node;
+    reg dir;
+    begin
+      plru_touch = bits;
+      node = 0;
+      for (lvl = 0; lvl < WAY_BITS; lvl = lvl + 1) begin
+        dir = way[WAY_BITS-1-lvl];
+        plru_touch[node] = ~dir;
+        node = 2 * node + 1 + dir;
+      end
+    end
+  endfunction
+
+  function [SP_BITS-1:0] sp_plru_victim;
+    input [SP_PLRU-1:0] bits;
+    integer lvl, node;
+    begin
+      node = 0;
+      for (lvl = 0; lvl < SP_BITS; lvl = lvl + 1)
+        node = 2 * node + 1 + bits[node];
+      sp_plru_victim = node - (SUPERPAGES - 1);
+    end
+  endfunction
+
+  function [SP_PLRU-1:0] sp_plru_touch;
+    input [SP_PLRU-1:0] bits;
+    input [SP_BITS-1:0] idx;
+    integer lvl, node;
+    reg dir;
+    begin
+      sp_plru_touch = bits;
+      node = 0;
+      for (lvl = 0; lvl < SP_BITS; lvl = lvl + 1) begin
+        dir = idx[SP_BITS-1-lvl];
+        sp_plru_touch[node] = ~dir;
+        node = 2 * node + 1 + dir;
+      end
+    end
+  endfunction
+
+  // =========================================================================
+  // Lookup (combinational)
+  // =========================================================================
+
+  wire [XLEN-1:0]     req_vpn = get_full_vpn(lookup_vaddr);
+  wire [SET_BITS-1:0] req_set = vpn_set(req_vpn);
+
+  reg                 pg_hit;
+  reg [WAY_BITS-1:0]  pg_hit_way;
+  reg                 sp_hit;
+  reg [SP_BITS-1:0]   sp_hit_idx;
+
+  integer i, w;
+  always @(*) begin
+    pg_hit       = 1'b0;
+    pg_hit_way   = {WAY_BITS{1'b0}};
+    sp_hit       = 1'b0;
+    sp_hit_idx   = {SP_BITS{1'b0}};
+    lookup_vpn   = {XLEN{1'b0}};
+    lookup_ppn   = {XLEN{1'b0}};
+    lookup_pte   = 8'h00;
+    lookup_level = {XLEN{1'b0}};
+
+    for (w = 0; w < WAYS; w = w + 1) begin
+      if (pg_valid[req_set*WAYS + w] && pg_vpn[req_set*WAYS + w] == req_vpn &&
+          asid_match(pg_pte[req_set*WAYS + w], pg_asid[req_set*WAYS + w], asid)) begin
+        pg_hit       = 1'b1;
+        pg_hit_way   = w[WAY_BITS-1:0];
+        lookup_vpn   = pg_vpn[req_set*WAYS + w];
+        lookup_ppn   = pg_ppn[req_set*WAYS + w];
+        lookup_pte   = pg_pte[req_set*WAYS + w];
+        lookup_level = {XLEN{1'b0}};
+      end
+    end
+
+    for (i = 0; i < SUPERPAGES; i = i + 1) begin
+      if (!pg_hit && sp_valid[i] && vpn_match(sp_vpn[i], req_vpn, sp_level[i]) &&
+          asid_match(sp_pte[i], sp_asid[i], asid)) begin
+        sp_hit       = 1'b1;
+        sp_hit_idx   = i[SP_BITS-1:0];
+        lookup_vpn   = sp_vpn[i];
+        lookup_ppn   = sp_ppn[i];
+        lookup_pte   = sp_pte[i];
+        lookup_level = sp_level[i];
+      end
+    end
+  end
+
+  assign lookup_hit = lookup_valid && (pg_hit || sp_hit);
+
+  // =========================================================================
+  // Victim selection: entry already holding the page, else first invalid
+  // entry, else pseudo-LRU
+  // =========================================================================
+
+  wire [SET_BITS-1:0] fill_set = vpn_set(update_vpn);
+  reg  [WAY_BITS-1:0] fill_way;
+  reg  [SP_BITS-1:0]  fill_sp;
+
+  integer vi, vw;
+  always @(*) begin
+    fill_way = (WAYS > 1) ? plru_victim(pg_plru[fill_set]) : {WAY_BITS{1'b0}};
+    for (vw = WAYS - 1; vw >= 0; vw = vw - 1) begin
+      if (!pg_valid[fill_set*WAYS + vw]) begin
+        fill_way = vw[WAY_BITS-1:0];
+      end
+    end
+    for (vw = WAYS - 1; vw >= 0; vw = vw - 1) begin
+      if (pg_valid[fill_set*WAYS + vw] && pg_vpn[fill_set*WAYS + vw] == update_vpn &&
+          asid_match(pg_pte[fill_set*WAYS + vw], pg_asid[fill_set*WAYS + vw], asid)) begin
+        fill_way = vw[WAY_BITS-1:0];
+      end
+    end
+
+    fill_sp = (SUPERPAGES > 1) ? sp_plru_victim(sp_plru) : {SP_BITS{1'b0}};
+    for (vi = SUPERPAGES - 1; vi >= 0; vi = vi - 1) begin
+      if (!sp_valid[vi]) begin
+        fill_sp = vi[SP_BITS-1:0];
+      end
+    end
+    for (vi = SUPERPAGES - 1; vi >= 0; vi = vi - 1) begin
+      if (sp_valid[vi] && vpn_match(sp_vpn[vi], update_vpn, sp_level[vi]) &&
+          asid_match(sp_pte[vi], sp_asid[vi], asid)) begin
+        fill_sp = vi[SP_BITS-1:0];
+      end
+    end
+  end
+
+  // =========================================================================
+  // Fill, flush, replacement state
+  // =========================================================================
+
+  wire [XLEN-1:0] flush_vpn = get_full_vpn(flush_addr);
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      for (i = 0; i < ENTRIES; i = i + 1) begin
+        pg_valid[i] <= 1'b0;
+        pg_vpn[i]   <= {XLEN{1'b0}};
+        pg_ppn[i]   <= {XLEN{1'b0}};
+        pg_pte[i]   <= 8'h00;
+        pg_asid[i]  <= 16'h0000;
+      end
+      for (i = 0; i < NUM_SETS; i = i + 1)
+        pg_plru[i] <= {PLRU_BITS{1'b0}};
+      for (i = 0; i < SUPERPAGES; i = i + 1) begin
+        sp_valid[i] <= 1'b0;
+        sp_vpn[i]   <= {XLEN{1'b0}};
+        sp_ppn[i]   <= {XLEN{1'b0}};
+        sp_pte[i]   <= 8'h00;
+        sp_level[i] <= {XLEN{1'b0}};
+        sp_asid[i]  <= 16'h0000;
+      end
+      sp_plru     <= {SP_PLRU{1'b0}};
+      stat_hits   <= 32'h0;
+      stat_misses <= 32'h0;
+    end else begin
+      // Flush
+      if (flush_all) begin
+        for (i = 0; i < ENTRIES; i = i + 1)
+          pg_valid[i] <= 1'b0;
+        for (i = 0; i < SUPERPAGES; i = i + 1)
+          sp_valid[i] <= 1'b0;
+      end else if (flush_vaddr || flush_asid) begin
+        for (i = 0; i < ENTRIES; i = i + 1) begin
+          if ((!flush_vaddr || pg_vpn[i] == flush_vpn) &&
+              (!flush_asid || (!pg_pte[i][PTE_G] && pg_asid[i] == flush_asid_value)))
+            pg_valid[i] <= 1'b0;
+        end
+        for (i = 0; i < SUPERPAGES; i = i + 1) begin
+          if ((!flush_vaddr || vpn_match(sp_vpn[i], flush_vpn, sp_level[i])) &&
+              (!flush_asid || (!sp_pte[i][PTE_G] && sp_asid[i] == flush_asid_value)))
+            sp_valid[i] <= 1'b0;
+        end
+      end
+
+      // Hit: mark the entry most recently used
+      if (lookup_valid) begin
+        if (pg_hit) begin
+          stat_hits <= stat_hits + 1;
+          if (WAYS > 1)
+            pg_plru[req_set] <= plru_touch(pg_plru[req_set], pg_hit_way);
+        end else if (sp_hit) begin
+          stat_hits <= stat_hits + 1;
+          if (SUPERPAGES > 1)
+            sp_plru <= sp_plru_touch(sp_plru, sp_hit_idx);
+        end else begin
+          stat_misses <= stat_misses + 1;
+        end
+      end
+
+      // Fill from PTW (never in the same cycle as a lookup)
+      if (update_valid) begin
+        if (update_level == 0) begin
+          pg_valid[fill_set*WAYS + fill_way] <= 1'b1;
+          pg_vpn[fill_set*WAYS + fill_way]   <= update_vpn;
+          pg_ppn[fill_set*WAYS + fill_way]   <= update_ppn;
+          pg_pte[fill_set*WAYS + fill_way]   <= update_pte;
+          pg_asid[fill_set*WAYS + fill_way]  <= asid;
+          if (WAYS > 1)
+            pg_plru[fill_set] <= plru_touch(pg_plru[fill_set], fill_way);
+        end else begin
+          sp_valid[fill_sp] <= 1'b1;
+          sp_vpn[fill_sp]   <= update_vpn;
+          sp_ppn[fill_sp]   <= update_ppn;
+          sp_pte[fill_sp]   <= update_pte;
+          sp_level[fill_sp] <= update_level;
+          sp_asid[fill_sp]  <= asid;
+          if (SUPERPAGES > 1)
+            sp_plru <= sp_plru_touch(sp_plru, fill_sp);
+        end
+      end
+    end
+  end
+
+  `ifdef DEBUG_L2_TLB
+  always @(posedge clk) begin
+    if (lookup_valid)
+      $display("[L2TLB] Lookup VA=0x%h VPN=0x%h %s", lookup_vaddr, req_vpn,
+               pg_hit ? "hit (4KB)" : sp_hit ? "hit (superpage)" : "miss");
+    if (update_valid)
+      $display("[L2TLB] Fill VPN=0x%h PPN=0x%h level=%0d asid=%0d -> %s %0d",
+               update_vpn, update_ppn, update_level, asid,
+               (update_level == 0) ? "set" : "superpage",
+               (update_level == 0) ? fill_set : fill_sp);
+  end
+  `endif
+
+endmodule
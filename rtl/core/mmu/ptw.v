@@ -1,13 +1,24 @@
 // ptw.v - Page Table Walker (PTW)
 // Shared page table walker for both I-TLB and D-TLB
 // Implements RISC-V Sv32 (RV32) and Sv39 (RV64) page table walks
+// Optional page-walk cache (PWC_ENTRIES) of non-leaf PTEs, keyed by VPN prefix
+// and ASID: a walk starts below the deepest cached pointer, so most Sv32/Sv39
+// misses need a single PTE read
+// Optional hardware A/D update (AD_UPDATE): a permitted leaf with A=0, or D=0
+// on a store, is written back with the bits set before the TLB is filled
 // Author: RV1 Project
 // Date: 2025-11-08 (Session 125)
+// Updated: 2026-10-16 - busy output (walk in progress)
+// Updated: 2026-10-16 - Page-walk cache
+// Updated: 2026-10-16 - Hardware A/D bit update
+// Updated: 2026-10-16 - rmw_lock output (A/D read-modify-write in progress)
 
 `include "config/rv_config.vh"
 
 module ptw #(
-  parameter XLEN = `XLEN
+  parameter XLEN = `XLEN,
+  parameter PWC_ENTRIES = `PWC_ENTRIES,  // Page-walk cache entries (0 = none)
+  parameter AD_UPDATE   = `PTW_AD_UPDATE // Set PTE.A/PTE.D in memory
 ) (
   input  wire             clk,
   input  wire             reset_n,
@@ -20,6 +31,8 @@ module ptw #(
   output reg              req_ready,         // PTW complete
   output reg              req_page_fault,    // Page fault
   output reg  [XLEN-1:0]  req_fault_vaddr,   // Faulting virtual address
+  output wire             busy,              // Walk in progress (req_valid ignored)
+  output wire             rmw_lock,          // PTE read/A-D write-back in progress (keep the bus)
 
   // PTW result for TLB update
   output reg              result_valid,      // Result valid (update TLB)
@@ -31,6 +44,8 @@ module ptw #(
   // Memory interface for page table walks
   output reg              mem_req_valid,     // Memory request
   output reg  [XLEN-1:0]  mem_req_addr,      // Physical address
+  output reg              mem_req_we,        // PTE write-back (A/D update)
+  output reg  [XLEN-1:0]  mem_req_wdata,     // PTE with A/D set (low word written)
   input  wire             mem_req_ready,     // Memory ready
   input  wire [XLEN-1:0]  mem_resp_data,     // PTE data
   input  wire             mem_resp_valid,    // Response valid
@@ -39,7 +54,14 @@ module ptw #(
   input  wire [XLEN-1:0]  satp,              // SATP register
   input  wire [1:0]       privilege_mode,    // Current privilege mode
   input  wire             mstatus_sum,       // SUM bit
-  input  wire             mstatus_mxr        // MXR bit
+  input  wire             mstatus_mxr,       // MXR bit
+
+  // Page-walk cache flush (SFENCE.VMA)
+  //   flush_asid: only non-global entries of flush_asid_value; otherwise all
+  input  wire             flush_all,
+  input  wire             flush_vaddr,
+  input  wire             flush_asid,
+  input  wire [15:0]      flush_asid_value
 );
 
   // =========================================================================
@@ -69,12 +91,15 @@ module ptw #(
   // =========================================================================
 
   wire [XLEN-1:0] satp_ppn;
+  wire [15:0]     satp_asid;
 
   generate
     if (XLEN == 32) begin : gen_satp_sv32
-      assign satp_ppn = {{10{1'b0}}, satp[21:0]};  // 22-bit PPN
+      assign satp_ppn  = {{10{1'b0}}, satp[21:0]};  // 22-bit PPN
+      assign satp_asid = {7'b0, satp[30:22]};       // 9-bit ASID
     end else begin : gen_satp_sv39
-      assign satp_ppn = {{20{1'b0}}, satp[43:0]};  // 44-bit PPN
+      assign satp_ppn  = {{20{1'b0}}, satp[43:0]};  // 44-bit PPN
+      assign satp_asid = satp[59:44];               // 16-bit ASID
     end
   endgenerate
 
@@ -116,6 +141,23 @@ module ptw #(
     end
   endfunction
 
+  // A PTE read at `level` is selected by the VPN fields from `level` up
+  function vpn_match;
+    input [XLEN-1:0] entry_vpn;
+    input [XLEN-1:0] vpn;
+    input [1:0]      level;
+    begin
+      if (XLEN == 32)
+        vpn_match = (level == 1) ? (entry_vpn[19:10] == vpn[19:10]) : (entry_vpn == vpn);
+      else
+        case (level)
+          1:       vpn_match = (entry_vpn[26:9]  == vpn[26:9]);
+          2:       vpn_match = (entry_vpn[26:18] == vpn[26:18]);
+          default: vpn_match = (entry_vpn == vpn);
+        endcase
+    end
+  endfunction
+
   // =========================================================================
   // Permission Checking
   // =========================================================================
@@ -172,6 +214,7 @@ module ptw #(
   localparam PTW_LEVEL_2    = 3'b011;
   localparam PTW_UPDATE_TLB = 3'b100;
   localparam PTW_FAULT      = 3'b101;
+  localparam PTW_UPDATE_AD  = 3'b110;
 
   reg [2:0] ptw_state;
   reg [2:0] ptw_level;
@@ -185,8 +228,66 @@ module ptw #(
   reg ptw_sum_save;
   reg ptw_mxr_save;
 
+  reg [15:0] ptw_asid_save;
+
   wire [XLEN-1:0] max_levels = (XLEN == 32) ? SV32_LEVELS : SV39_LEVELS;
 
+  // =========================================================================
+  // Page-Walk Cache
+  // =========================================================================
+  // Each entry is a non-leaf PTE read at level 1 or 2, i.e. the PPN of the
+  // next-level table for one VPN prefix. Filled as the walker descends;
+  // replacement: first invalid entry, else round-robin.
+
+  localparam PWC_SIZE = (PWC_ENTRIES > 0) ? PWC_ENTRIES : 1;
+  localparam PWC_BITS = (PWC_SIZE > 1) ? $clog2(PWC_SIZE) : 1;
+
+  reg                 pwc_valid [0:PWC_SIZE-1];
+  reg [XLEN-1:0]      pwc_vpn   [0:PWC_SIZE-1];  // VPN of the walk that filled it
+  reg [1:0]           pwc_level [0:PWC_SIZE-1];  // Level the PTE was read at
+  reg [XLEN-1:0]      pwc_ppn   [0:PWC_SIZE-1];  // Next-level table PPN
+  reg [15:0]          pwc_asid  [0:PWC_SIZE-1];
+  reg                 pwc_g     [0:PWC_SIZE-1];  // Global: everything below is global
+  reg [PWC_BITS-1:0]  pwc_rr;
+
+  wire                pwc_flush = flush_all || flush_vaddr || flush_asid;
+
+  // Deepest cached table for the request
+  reg                 pwc_hit;
+  reg [1:0]           pwc_hit_level;
+  reg [XLEN-1:0]      pwc_hit_ppn;
+  reg [PWC_BITS-1:0]  pwc_fill_idx;
+
+  integer p;
+  always @(*) begin
+    pwc_hit       = 1'b0;
+    pwc_hit_level = 2'd0;
+    pwc_hit_ppn   = {XLEN{1'b0}};
+    pwc_fill_idx  = pwc_rr;
+    for (p = 0; p < PWC_SIZE; p = p + 1) begin
+      if (PWC_ENTRIES > 0 && pwc_valid[p] &&
+          vpn_match(pwc_vpn[p], get_full_vpn(req_vaddr), pwc_level[p]) &&
+          (pwc_g[p] || pwc_asid[p] == satp_asid) &&
+          (!pwc_hit || pwc_level[p] < pwc_hit_level)) begin
+        pwc_hit       = 1'b1;
+        pwc_hit_level = pwc_level[p];
+        pwc_hit_ppn   = pwc_ppn[p];
+      end
+    end
+    for (p = PWC_SIZE - 1; p >= 0; p = p - 1) begin
+      if (!pwc_valid[p])
+        pwc_fill_idx = p[PWC_BITS-1:0];
+    end
+  end
+
+  assign busy = (ptw_state != PTW_IDLE);
+
+  // A/D update is a read-modify-write of the PTE: no other master may write it
+  // between the read and the write-back. Any level can hold the leaf, so the
+  // lock covers every PTE read and stays up through PTW_UPDATE_AD until the
+  // write is accepted (mem_req_valid does not drop in between)
+  assign rmw_lock = AD_UPDATE && mem_req_valid;
+
   integer i;
   always @(posedge clk or negedge reset_n) begin
     if (!reset_n) begin
@@ -203,6 +304,8 @@ module ptw #(
       ptw_mxr_save <= 0;
       mem_req_valid <= 0;
       mem_req_addr <= 0;
+      mem_req_we <= 0;
+      mem_req_wdata <= 0;
       req_ready <= 0;
       req_page_fault <= 0;
       req_fault_vaddr <= 0;
@@ -211,12 +314,33 @@ module ptw #(
       result_ppn <= 0;
       result_pte <= 0;
       result_level <= 0;
+      ptw_asid_save <= 0;
+      pwc_rr <= 0;
+      for (i = 0; i < PWC_SIZE; i = i + 1) begin
+        pwc_valid[i] <= 0;
+        pwc_vpn[i] <= 0;
+        pwc_level[i] <= 0;
+        pwc_ppn[i] <= 0;
+        pwc_asid[i] <= 0;
+        pwc_g[i] <= 0;
+      end
     end else begin
       // Default: clear single-cycle outputs
       req_ready <= 0;
       req_page_fault <= 0;
       result_valid <= 0;
 
+      // Page-walk cache flush (SFENCE.VMA)
+      if (flush_asid && !flush_all) begin
+        for (i = 0; i < PWC_SIZE; i = i + 1) begin
+          if (!pwc_g[i] && pwc_asid[i] == flush_asid_value)
+            pwc_valid[i] <= 0;
+        end
+      end else if (pwc_flush) begin
+        for (i = 0; i < PWC_SIZE; i = i + 1)
+          pwc_valid[i] <= 0;
+      end
+
       case (ptw_state)
         PTW_IDLE: begin
           if (req_valid) begin
@@ -230,23 +354,41 @@ module ptw #(
             ptw_priv_save <= privilege_mode;
             ptw_sum_save <= mstatus_sum;
             ptw_mxr_save <= mstatus_mxr;
-            ptw_level <= max_levels - 1;
-
-            // Calculate first PTE address
-            if (XLEN == 32) begin
-              ptw_pte_addr <= (satp_ppn << PAGE_SHIFT) +
-                              (extract_vpn(req_vaddr, max_levels - 1) << 2);
+            ptw_asid_save <= satp_asid;
+
+            if (pwc_hit) begin
+              // Resume below the deepest cached non-leaf PTE
+              `ifdef DEBUG_PTW
+              $display("PTW: Page-walk cache hit - starting at level %0d", pwc_hit_level - 1);
+              `endif
+              ptw_level <= pwc_hit_level - 1;
+              if (XLEN == 32) begin
+                ptw_pte_addr <= (pwc_hit_ppn << PAGE_SHIFT) +
+                                (extract_vpn(req_vaddr, pwc_hit_level - 1) << 2);
+              end else begin
+                ptw_pte_addr <= (pwc_hit_ppn << PAGE_SHIFT) +
+                                (extract_vpn(req_vaddr, pwc_hit_level - 1) << 3);
+              end
+              ptw_state <= (pwc_hit_level == 2) ? PTW_LEVEL_1 : PTW_LEVEL_0;
             end else begin
-              ptw_pte_addr <= (satp_ppn << PAGE_SHIFT) +
-                              (extract_vpn(req_vaddr, max_levels - 1) << 3);
-            end
+              ptw_level <= max_levels - 1;
 
-            // Go to appropriate level state
-            case (max_levels - 1)
-              2: ptw_state <= PTW_LEVEL_2;
-              1: ptw_state <= PTW_LEVEL_1;
-              default: ptw_state <= PTW_LEVEL_0;
-            endcase
+              // Calculate first PTE address
+              if (XLEN == 32) begin
+                ptw_pte_addr <= (satp_ppn << PAGE_SHIFT) +
+                                (extract_vpn(req_vaddr, max_levels - 1) << 2);
+              end else begin
+                ptw_pte_addr <= (satp_ppn << PAGE_SHIFT) +
+                                (extract_vpn(req_vaddr, max_levels - 1) << 3);
+              end
+
+              // Go to appropriate level state
+              case (max_levels - 1)
+                2: ptw_state <= PTW_LEVEL_2;
+                1: ptw_state <= PTW_LEVEL_1;
+                default: ptw_state <= PTW_LEVEL_0;
+              endcase
+            end
           end
         end
 
@@ -276,7 +418,24 @@ module ptw #(
               if (check_permission(mem_resp_data[7:0], ptw_is_store_save, ptw_is_fetch_save,
                                    ptw_priv_save, ptw_sum_save, ptw_mxr_save)) begin
                 $display("PTW: Leaf PTE found, permission OK");
-                ptw_state <= PTW_UPDATE_TLB;
+                if (AD_UPDATE && (!mem_resp_data[PTE_A] ||
+                                  (ptw_is_store_save && !mem_resp_data[PTE_D]))) begin
+                  // Write the PTE back with A (and D for a store) set. The
+                  // request stays asserted from the read to the write and
+                  // rmw_lock keeps the bus (atomic read-modify-write)
+                  `ifdef DEBUG_PTW
+                  $display("PTW: Setting A%s in PTE", ptw_is_store_save ? "/D" : "");
+                  `endif
+                  ptw_pte_data <= mem_resp_data | (1 << PTE_A) |
+                                  (ptw_is_store_save ? (1 << PTE_D) : 0);
+                  mem_req_valid <= 1;
+                  mem_req_we <= 1;
+                  mem_req_wdata <= mem_resp_data | (1 << PTE_A) |
+                                   (ptw_is_store_save ? (1 << PTE_D) : 0);
+                  ptw_state <= PTW_UPDATE_AD;
+                end else begin
+                  ptw_state <= PTW_UPDATE_TLB;
+                end
               end else begin
                 $display("PTW: FAULT - Permission denied");
                 ptw_state <= PTW_FAULT;
@@ -292,6 +451,21 @@ module ptw #(
               $display("PTW: Non-leaf PTE, descending to level %0d", ptw_level - 1);
               ptw_level <= ptw_level - 1;
 
+              // Remember the next-level table for this VPN prefix
+              if (PWC_ENTRIES > 0 && !pwc_flush) begin
+                pwc_valid[pwc_fill_idx] <= 1;
+                pwc_vpn[pwc_fill_idx] <= ptw_vpn_save;
+                pwc_level[pwc_fill_idx] <= ptw_level[1:0];
+                if (XLEN == 32) begin
+                  pwc_ppn[pwc_fill_idx] <= {{10{1'b0}}, mem_resp_data[31:10]};
+                end else begin
+                  pwc_ppn[pwc_fill_idx] <= {{20{1'b0}}, mem_resp_data[53:10]};
+                end
+                pwc_asid[pwc_fill_idx] <= ptw_asid_save;
+                pwc_g[pwc_fill_idx] <= mem_resp_data[PTE_G];
+                pwc_rr <= pwc_fill_idx + 1;
+              end
+
               // Calculate next PTE address
               if (XLEN == 32) begin
                 ptw_pte_addr <= (mem_resp_data[31:10] << PAGE_SHIFT) +
@@ -314,6 +488,15 @@ module ptw #(
           end
         end
 
+        PTW_UPDATE_AD: begin
+          // Wait for the PTE write to be accepted
+          if (mem_req_ready) begin
+            mem_req_valid <= 0;
+            mem_req_we <= 0;
+            ptw_state <= PTW_UPDATE_TLB;
+          end
+        end
+
         PTW_UPDATE_TLB: begin
           // Send result to TLB for update
           result_valid <= 1;
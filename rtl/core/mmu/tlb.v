@@ -1,14 +1,24 @@
 // tlb.v - Translation Lookaside Buffer (TLB)
 // Reusable TLB module for both I-TLB and D-TLB
 // Provides fast virtual-to-physical address translation with permission checking
+// Entries are tagged with the ASID they were walked under; global (PTE.G)
+// entries match every ASID
+// Megapage/gigapage entries match on the VPN fields above their level
+// Tree pseudo-LRU replacement (invalid entries first), refreshed on every hit
+// With HW_AD_UPDATE, a store to an entry cached with D=0 misses so the PTW
+// can set PTE.D; the re-walked entry overwrites the stale one
 // Author: RV1 Project
 // Date: 2025-11-08 (Session 125)
+// Updated: 2026-10-16 - ASID tags, global entries, ASID-selective SFENCE.VMA
+// Updated: 2026-10-16 - Superpage matching, pseudo-LRU replacement
+// Updated: 2026-10-16 - Store miss on D=0 for hardware A/D update
 
 `include "config/rv_config.vh"
 
 module tlb #(
   parameter XLEN = `XLEN,
-  parameter TLB_ENTRIES = 8  // Number of TLB entries
+  parameter TLB_ENTRIES = 8,  // Number of TLB entries (power of 2)
+  parameter HW_AD_UPDATE = 0  // PTW sets PTE.A/PTE.D (ptw.v AD_UPDATE)
 ) (
   input  wire             clk,
   input  wire             reset_n,
@@ -34,11 +44,17 @@ module tlb #(
   input  wire             mstatus_sum,       // Supervisor User Memory access
   input  wire             mstatus_mxr,       // Make eXecutable Readable
   input  wire             translation_enabled, // Translation enabled (satp.MODE != 0)
+  input  wire [15:0]      asid,              // Current satp.ASID (lookups and updates)
 
-  // TLB flush control
+  // TLB flush control (SFENCE.VMA)
+  //   flush_all                : every entry, including global ones
+  //   flush_vaddr              : entries for flush_addr
+  //   flush_asid (+flush_vaddr): only non-global entries of flush_asid_value
   input  wire             flush_all,         // Flush entire TLB
   input  wire             flush_vaddr,       // Flush specific virtual address
-  input  wire [XLEN-1:0]  flush_addr         // Address to flush (if flush_vaddr)
+  input  wire [XLEN-1:0]  flush_addr,        // Address to flush (if flush_vaddr)
+  input  wire             flush_asid,        // Restrict flush to one ASID (rs2 != x0)
+  input  wire [15:0]      flush_asid_value   // ASID to flush (if flush_asid)
 );
 
   // =========================================================================
@@ -66,9 +82,14 @@ module tlb #(
   reg [XLEN-1:0]        tlb_ppn   [0:TLB_ENTRIES-1];  // Physical page number
   reg [7:0]             tlb_pte   [0:TLB_ENTRIES-1];  // PTE flags
   reg [XLEN-1:0]        tlb_level [0:TLB_ENTRIES-1];  // Page level
+  reg [15:0]            tlb_asid  [0:TLB_ENTRIES-1];  // ASID the entry was walked under
 
-  // TLB replacement policy: simple round-robin
-  reg [$clog2(TLB_ENTRIES)-1:0] tlb_replace_idx;
+  // TLB replacement policy: tree pseudo-LRU
+  localparam IDX_BITS  = (TLB_ENTRIES > 1) ? $clog2(TLB_ENTRIES) : 1;
+  localparam PLRU_BITS = (TLB_ENTRIES > 1) ? (TLB_ENTRIES - 1) : 1;
+
+  reg [PLRU_BITS-1:0] tlb_plru;
+  reg [IDX_BITS-1:0]  tlb_replace_idx;
 
   // =========================================================================
   // VPN Extraction
@@ -87,12 +108,69 @@ module tlb #(
     end
   endfunction
 
+  // Superpages match on the VPN fields above their level
+  // (Sv32: level 1 = 4MB; Sv39: level 1 = 2MB, level 2 = 1GB)
+  function vpn_match;
+    input [XLEN-1:0] entry_vpn;
+    input [XLEN-1:0] vpn;
+    input [XLEN-1:0] level;
+    begin
+      if (XLEN == 32)
+        vpn_match = (level == 1) ? (entry_vpn[19:10] == vpn[19:10]) : (entry_vpn == vpn);
+      else
+        case (level)
+          1:       vpn_match = (entry_vpn[26:9]  == vpn[26:9]);
+          2:       vpn_match = (entry_vpn[26:18] == vpn[26:18]);
+          default: vpn_match = (entry_vpn == vpn);
+        endcase
+    end
+  endfunction
+
+  // Tree pseudo-LRU: bit=0 -> victim in left subtree, bit=1 -> right subtree
+  function [IDX_BITS-1:0] plru_victim;
+    input [PLRU_BITS-1:0] bits;
+    integer lvl, node;
+    begin
+      node = 0;
+      for (lvl = 0; lvl < IDX_BITS; lvl = lvl + 1)
+        node = 2 * node + 1 + bits[node];
+      plru_victim = node - (TLB_ENTRIES - 1);
+    end
+  endfunction
+
+  // Mark entry as most recently used: point every node on its path away from it
+  function [PLRU_BITS-1:0] plru_touch;
+    input [PLRU_BITS-1:0] bits;
+    input [IDX_BITS-1:0]  idx;
+    integer lvl, node;
+    reg dir;
+    begin
+      plru_touch = bits;
+      node = 0;
+      for (lvl = 0; lvl < IDX_BITS; lvl = lvl + 1) begin
+        dir = idx[IDX_BITS-1-lvl];
+        plru_touch[node] = ~dir;
+        node = 2 * node + 1 + dir;
+      end
+    end
+  endfunction
+
+  // Entry belongs to the given address space (global entries belong to all)
+  function asid_match;
+    input [7:0]  pte;
+    input [15:0] entry_asid;
+    input [15:0] cur_asid;
+    begin
+      asid_match = pte[PTE_G] || (entry_asid == cur_asid);
+    end
+  endfunction
+
   // =========================================================================
   // TLB Lookup (Combinational)
   // =========================================================================
 
   reg tlb_hit_found;
-  reg [$clog2(TLB_ENTRIES)-1:0] tlb_hit_idx;
+  reg [IDX_BITS-1:0] tlb_hit_idx;
   reg [XLEN-1:0] tlb_ppn_out;
   reg [7:0] tlb_pte_out;
   reg [XLEN-1:0] tlb_level_out;
@@ -107,9 +185,10 @@ module tlb #(
 
     if (translation_enabled && lookup_valid) begin
       for (i = 0; i < TLB_ENTRIES; i = i + 1) begin
-        if (tlb_valid[i] && (tlb_vpn[i] == get_full_vpn(lookup_vaddr))) begin
+        if (tlb_valid[i] && vpn_match(tlb_vpn[i], get_full_vpn(lookup_vaddr), tlb_level[i]) &&
+            asid_match(tlb_pte[i], tlb_asid[i], asid)) begin
           tlb_hit_found = 1;
-          tlb_hit_idx = i[$clog2(TLB_ENTRIES)-1:0];
+          tlb_hit_idx = i[IDX_BITS-1:0];
           tlb_ppn_out = tlb_ppn[i];
           tlb_pte_out = tlb_pte[i];
           tlb_level_out = tlb_level[i];
@@ -126,13 +205,16 @@ module tlb #(
       for (i = 0; i < TLB_ENTRIES; i = i + 1) begin
         if (tlb_valid[i]) begin
           $display("[TLB_LOOKUP]   Entry[%0d]: VPN=0x%h match=%b",
-                   i, tlb_vpn[i], (tlb_vpn[i] == get_full_vpn(lookup_vaddr)));
+                   i, tlb_vpn[i], vpn_match(tlb_vpn[i], get_full_vpn(lookup_vaddr), tlb_level[i]));
         end
       end
     end
   end
 
-  assign lookup_hit = tlb_hit_found;
+  // A store to a clean page misses so the walker sets PTE.D in memory
+  wire dirty_miss = HW_AD_UPDATE && lookup_is_store && !lookup_is_fetch && !tlb_pte_out[PTE_D];
+
+  assign lookup_hit = tlb_hit_found && !dirty_miss;
 
   // =========================================================================
   // Permission Checking (Combinational)
@@ -190,7 +272,7 @@ module tlb #(
   wire perm_ok = check_permission(tlb_pte_out, lookup_is_store, lookup_is_fetch,
                                   privilege_mode, mstatus_sum, mstatus_mxr);
 
-  assign lookup_page_fault = tlb_hit_found && !perm_ok;
+  assign lookup_page_fault = lookup_hit && !perm_ok;
 
   // =========================================================================
   // Physical Address Construction (Combinational)
@@ -223,44 +305,73 @@ module tlb #(
 
   assign lookup_paddr = construct_pa(tlb_ppn_out, lookup_vaddr, tlb_level_out);
 
+  // =========================================================================
+  // Replacement Victim: entry already holding the page (re-walk), else
+  // first invalid entry, else pseudo-LRU
+  // =========================================================================
+
+  integer v;
+  always @(*) begin
+    tlb_replace_idx = (TLB_ENTRIES > 1) ? plru_victim(tlb_plru) : {IDX_BITS{1'b0}};
+    for (v = TLB_ENTRIES - 1; v >= 0; v = v - 1) begin
+      if (!tlb_valid[v])
+        tlb_replace_idx = v[IDX_BITS-1:0];
+    end
+    for (v = TLB_ENTRIES - 1; v >= 0; v = v - 1) begin
+      if (tlb_valid[v] && vpn_match(tlb_vpn[v], update_vpn, tlb_level[v]) &&
+          asid_match(tlb_pte[v], tlb_asid[v], asid))
+        tlb_replace_idx = v[IDX_BITS-1:0];
+    end
+  end
+
   // =========================================================================
   // TLB Update and Flush Logic (Sequential)
   // =========================================================================
 
   always @(posedge clk or negedge reset_n) begin
     if (!reset_n) begin
-      tlb_replace_idx <= 0;
+      tlb_plru <= {PLRU_BITS{1'b0}};
       for (i = 0; i < TLB_ENTRIES; i = i + 1) begin
         tlb_valid[i] <= 0;
         tlb_vpn[i] <= 0;
         tlb_ppn[i] <= 0;
         tlb_pte[i] <= 0;
         tlb_level[i] <= 0;
+        tlb_asid[i] <= 0;
       end
     end else begin
       // TLB flush logic
+      // An ASID-selective flush keeps global entries and other address spaces
       if (flush_all) begin
         for (i = 0; i < TLB_ENTRIES; i = i + 1) begin
           tlb_valid[i] <= 0;
         end
-      end else if (flush_vaddr) begin
+      end else if (flush_vaddr || flush_asid) begin
         for (i = 0; i < TLB_ENTRIES; i = i + 1) begin
-          if (tlb_vpn[i] == get_full_vpn(flush_addr)) begin
+          if ((!flush_vaddr || vpn_match(tlb_vpn[i], get_full_vpn(flush_addr), tlb_level[i])) &&
+              (!flush_asid || (!tlb_pte[i][PTE_G] && tlb_asid[i] == flush_asid_value))) begin
             tlb_valid[i] <= 0;
           end
         end
       end
 
-      // TLB update from PTW
+      // Hit: mark the entry most recently used
+      if (tlb_hit_found && TLB_ENTRIES > 1) begin
+        tlb_plru <= plru_touch(tlb_plru, tlb_hit_idx);
+      end
+
+      // TLB update from PTW (or L2 TLB refill)
       if (update_valid) begin
         tlb_valid[tlb_replace_idx] <= 1;
         tlb_vpn[tlb_replace_idx] <= update_vpn;
         tlb_ppn[tlb_replace_idx] <= update_ppn;
         tlb_pte[tlb_replace_idx] <= update_pte;
         tlb_level[tlb_replace_idx] <= update_level;
-        tlb_replace_idx <= tlb_replace_idx + 1;
-        $display("[TLB] Update entry[%0d]: VPN=0x%h PPN=0x%h pte=0x%02h level=%0d fetch=%b",
-                 tlb_replace_idx, update_vpn, update_ppn, update_pte, update_level, lookup_is_fetch);
+        tlb_asid[tlb_replace_idx] <= asid;
+        if (TLB_ENTRIES > 1)
+          tlb_plru <= plru_touch(tlb_plru, tlb_replace_idx);
+        $display("[TLB] Update entry[%0d]: VPN=0x%h PPN=0x%h pte=0x%02h level=%0d asid=%0d fetch=%b",
+                 tlb_replace_idx, update_vpn, update_ppn, update_pte, update_level, asid, lookup_is_fetch);
       end
     end
   end
@@ -0,0 +1,224 @@
+// mul_pipelined.v - Pipelined Multiplier for M Extension
+// Implements MUL, MULH, MULHSU, MULHU (and MULW on RV64) with a fixed latency
+// that follows the main pipeline instead of stalling it
+// Structure:
+//   - Radix-4 Booth recoding of operand B (XLEN/2+1 partial products)
+//   - Carry-save (3:2 compressor) Wallace-style reduction to two rows
+//   - Final carry-propagate add and result select
+// Stage mapping (STAGES = `MUL_STAGES):
+//   1: everything in EX (result like an ALU op)
+//   2: EX = Booth + reduction, MEM = final add (result like a load)
+//   3: EX = Booth + reduction, MEM = low-half add, WB = high-half add
+// Stage registers advance with the pipeline registers they shadow: stage 1
+// with EX/MEM (stage1_en = !hold_exmem), stage 2 with MEM/WB (every cycle)
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`include "config/rv_config.vh"
+
+module mul_pipelined #(
+  parameter XLEN   = `XLEN,
+  parameter STAGES = `MUL_STAGES       // 1, 2 or 3
+)(
+  input  wire                clk,
+  input  wire                reset_n,
+
+  input  wire                stage1_en,    // EX -> MEM advance
+
+  // EX stage inputs
+  input  wire  [1:0]         mul_op,       // 00=MUL, 01=MULH, 10=MULHSU, 11=MULHU
+  input  wire                is_word_op,   // RV64: MULW
+  input  wire  [XLEN-1:0]    operand_a,
+  input  wire  [XLEN-1:0]    operand_b,
+
+  // Result of the multiply that is now in stage EX+STAGES-1
+  output wire  [XLEN-1:0]    result
+);
+
+  localparam MUL    = 2'b00;
+  localparam MULH   = 2'b01;
+  localparam MULHSU = 2'b10;
+  localparam MULHU  = 2'b11;
+
+  localparam PW     = 2 * XLEN;        // Product width
+  localparam BW     = XLEN + 2;        // Booth multiplier width (sign-extended, even)
+  localparam NPP    = BW / 2;          // Booth partial products
+  localparam NROWS  = NPP + 1;         // Plus the negation-correction row
+  localparam LEVELS = 12;              // 3:2 levels; enough for 34 rows (RV64)
+
+  // =========================================================================
+  // Operand preparation (EX)
+  // =========================================================================
+
+  wire a_signed = (mul_op == MULH) || (mul_op == MULHSU);
+  wire b_signed = (mul_op == MULH);
+
+  wire [XLEN-1:0] a_w, b_w;
+  generate
+    if (XLEN == 64) begin : gen_word_64
+      assign a_w = is_word_op ? {{32{operand_a[31]}}, operand_a[31:0]} : operand_a;
+      assign b_w = is_word_op ? {{32{operand_b[31]}}, operand_b[31:0]} : operand_b;
+    end else begin : gen_word_32
+      assign a_w = operand_a;
+      assign b_w = operand_b;
+    end
+  endgenerate
+
+  // Both operands become signed values one bit wider than XLEN
+  wire [XLEN:0]   a_ext = {a_signed & a_w[XLEN-1], a_w};
+  wire [BW-1:0]   b_ext = {{2{b_signed & b_w[XLEN-1]}}, b_w};
+  wire [PW-1:0]   a_pw  = {{(PW-XLEN-1){a_ext[XLEN]}}, a_ext};
+
+  // =========================================================================
+  // Radix-4 Booth partial products + carry-save reduction (EX)
+  // =========================================================================
+
+  reg [PW-1:0] tree [0:NROWS-1];
+  reg [PW-1:0] neg_row;
+  reg [PW-1:0] mag, csa_s, csa_c, r0, r1, r2;
+  reg [2:0]    group;
+  reg [PW-1:0] ex_sum, ex_carry;
+  integer i, lvl, r, cnt, nxt;
+
+  always @(*) begin
+    neg_row = {PW{1'b0}};
+    for (i = 0; i < NPP; i = i + 1) begin
+      group = {b_ext[2*i+1], b_ext[2*i], (i == 0) ? 1'b0 : b_ext[2*i-1]};
+      case (group)
+        3'b001, 3'b010, 3'b101, 3'b110: mag = a_pw;
+        3'b011, 3'b100:                 mag = a_pw << 1;
+        default:                        mag = {PW{1'b0}};
+      endcase
+      // Negative digits: one's complement here, +1 via the correction row
+      if (group[2] && group != 3'b111) begin
+        tree[i] = (~mag) << (2 * i);
+        neg_row[2*i] = 1'b1;
+      end else begin
+        tree[i] = mag << (2 * i);
+      end
+    end
+    tree[NPP] = neg_row;
+
+    // Reduce NROWS rows to two, three rows at a time per level
+    cnt = NROWS;
+    for (lvl = 0; lvl < LEVELS; lvl = lvl + 1) begin
+      if (cnt > 2) begin
+        nxt = 0;
+        for (r = 0; r < NROWS; r = r + 3) begin
+          if (r + 2 < cnt) begin
+            r0 = tree[r];
+            r1 = tree[r+1];
+            r2 = tree[r+2];
+            csa_s = r0 ^ r1 ^ r2;
+            csa_c = ((r0 & r1) | (r0 & r2) | (r1 & r2)) << 1;
+            tree[nxt]   = csa_s;
+            tree[nxt+1] = csa_c;
+            nxt = nxt + 2;
+          end else if (r < cnt) begin
+            tree[nxt] = tree[r];
+            nxt = nxt + 1;
+            if (r + 1 < cnt) begin
+              tree[nxt] = tree[r+1];
+              nxt = nxt + 1;
+            end
+          end
+        end
+        cnt = nxt;
+      end
+    end
+    ex_sum   = tree[0];
+    ex_carry = (cnt > 1) ? tree[1] : {PW{1'b0}};
+  end
+
+  // =========================================================================
+  // Result select
+  // =========================================================================
+
+  function [XLEN-1:0] select_result;
+    input [PW-1:0] product;
+    input [1:0]    op;
+    input          word;
+    begin
+      if (op == MUL)
+        // MULW: sign-extend the low word (upper copies truncate away on RV32)
+        select_result = (XLEN == 64 && word) ? {{XLEN{product[31]}}, product[31:0]}
+                                             : product[XLEN-1:0];
+      else
+        select_result = product[PW-1:XLEN];
+    end
+  endfunction
+
+  // =========================================================================
+  // Stages
+  // =========================================================================
+
+  generate
+    if (STAGES <= 1) begin : gen_1stage
+      assign result = select_result(ex_sum + ex_carry, mul_op, is_word_op);
+
+    end else begin : gen_multi
+      // Stage 1 register (EX -> MEM)
+      reg [PW-1:0] s1_sum, s1_carry;
+      reg [1:0]    s1_op;
+      reg          s1_word;
+
+      always @(posedge clk or negedge reset_n) begin
+        if (!reset_n) begin
+          s1_sum   <= {PW{1'b0}};
+          s1_carry <= {PW{1'b0}};
+          s1_op    <= 2'b00;
+          s1_word  <= 1'b0;
+        end else if (stage1_en) begin
+          s1_sum   <= ex_sum;
+          s1_carry <= ex_carry;
+          s1_op    <= mul_op;
+          s1_word  <= is_word_op;
+        end
+      end
+
+      if (STAGES == 2) begin : gen_2stage
+        assign result = select_result(s1_sum + s1_carry, s1_op, s1_word);
+
+      end else begin : gen_3stage
+        // Stage 2 register (MEM -> WB): low half added, high half still carry-save
+        wire [XLEN:0] mem_lo = {1'b0, s1_sum[XLEN-1:0]} + {1'b0, s1_carry[XLEN-1:0]};
+
+        reg [XLEN-1:0] s2_lo;
+        reg            s2_cout;
+        reg [XLEN-1:0] s2_hi_sum, s2_hi_carry;
+        reg [1:0]      s2_op;
+        reg            s2_word;
+
+        always @(posedge clk or negedge reset_n) begin
+          if (!reset_n) begin
+            s2_lo       <= {XLEN{1'b0}};
+            s2_cout     <= 1'b0;
+            s2_hi_sum   <= {XLEN{1'b0}};
+            s2_hi_carry <= {XLEN{1'b0}};
+            s2_op       <= 2'b00;
+            s2_word     <= 1'b0;
+          end else begin
+            s2_lo       <= mem_lo[XLEN-1:0];
+            s2_cout     <= mem_lo[XLEN];
+            s2_hi_sum   <= s1_sum[PW-1:XLEN];
+            s2_hi_carry <= s1_carry[PW-1:XLEN];
+            s2_op       <= s1_op;
+            s2_word     <= s1_word;
+          end
+        end
+
+        wire [XLEN-1:0] wb_hi = s2_hi_sum + s2_hi_carry + {{(XLEN-1){1'b0}}, s2_cout};
+        assign result = select_result({wb_hi, s2_lo}, s2_op, s2_word);
+      end
+    end
+  endgenerate
+
+  `ifdef DEBUG_MULTIPLIER
+  always @(posedge clk) begin
+    if (stage1_en)
+      $display("[MUL_PIPE] EX: op=%b a=0x%h b=0x%h product=0x%h",
+               mul_op, operand_a, operand_b, ex_sum + ex_carry);
+  end
+  `endif
+
+endmodule
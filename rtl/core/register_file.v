@@ -3,6 +3,7 @@
 // Author: RV1 Project
 // Date: 2025-10-09
 // Updated: 2025-10-10 - Parameterized for XLEN (32/64-bit support)
+// Updated: 2026-10-16 - 4 read / 2 write ports for dual issue (ISSUE_WIDTH=2)
 
 `include "config/rv_config.vh"
 
@@ -17,7 +18,16 @@ module register_file #(
   input  wire [XLEN-1:0]  rd_data,     // Write port data
   input  wire             rd_wen,      // Write enable
   output wire [XLEN-1:0]  rs1_data,    // Read port 1 data
-  output wire [XLEN-1:0]  rs2_data     // Read port 2 data
+  output wire [XLEN-1:0]  rs2_data,    // Read port 2 data
+
+  // Second issue lane (tie off when ISSUE_WIDTH=1)
+  input  wire [4:0]       rs3_addr,    // Read port 3 address (lane 1 rs1)
+  input  wire [4:0]       rs4_addr,    // Read port 4 address (lane 1 rs2)
+  input  wire [4:0]       rd2_addr,    // Write port 2 address
+  input  wire [XLEN-1:0]  rd2_data,    // Write port 2 data
+  input  wire             rd2_wen,     // Write port 2 enable
+  output wire [XLEN-1:0]  rs3_data,    // Read port 3 data
+  output wire [XLEN-1:0]  rs4_data     // Read port 4 data
 );
 
   // Register array (x0-x31)
@@ -39,18 +49,34 @@ module register_file #(
         // x0 is hardwired to zero, so don't write to it
         registers[rd_addr] <= rd_data;
       end
+      // Port 2 carries the younger instruction of a pair: it writes last,
+      // so it wins when both ports target the same register
+      if (rd2_wen && rd2_addr != 5'h0) begin
+        registers[rd2_addr] <= rd2_data;
+      end
     end
   end
 
   // Read operations (combinational with internal forwarding)
   // x0 always reads as zero
   // Internal forwarding: if reading the register being written, return write data
+  // (port 2 first, matching the write order above)
   assign rs1_data = (rs1_addr == 5'h0) ? {XLEN{1'b0}} :
-                    (rd_wen && (rd_addr == rs1_addr) && (rd_addr != 5'h0)) ? rd_data :
+                    (rd2_wen && (rd2_addr == rs1_addr)) ? rd2_data :
+                    (rd_wen && (rd_addr == rs1_addr)) ? rd_data :
                     registers[rs1_addr];
   assign rs2_data = (rs2_addr == 5'h0) ? {XLEN{1'b0}} :
-                    (rd_wen && (rd_addr == rs2_addr) && (rd_addr != 5'h0)) ? rd_data :
+                    (rd2_wen && (rd2_addr == rs2_addr)) ? rd2_data :
+                    (rd_wen && (rd_addr == rs2_addr)) ? rd_data :
                     registers[rs2_addr];
+  assign rs3_data = (rs3_addr == 5'h0) ? {XLEN{1'b0}} :
+                    (rd2_wen && (rd2_addr == rs3_addr)) ? rd2_data :
+                    (rd_wen && (rd_addr == rs3_addr)) ? rd_data :
+                    registers[rs3_addr];
+  assign rs4_data = (rs4_addr == 5'h0) ? {XLEN{1'b0}} :
+                    (rd2_wen && (rd2_addr == rs4_addr)) ? rd2_data :
+                    (rd_wen && (rd_addr == rs4_addr)) ? rd_data :
+                    registers[rs4_addr];
 
   // Debug register writes (track x7/t2 corruption)
   `ifdef DEBUG_REG_WRITE
@@ -1,11 +1,14 @@
 // reservation_station.v - LR/SC Reservation Tracking
 // Tracks load-reserved addresses for store-conditional validation
 // Part of RV1 RISC-V CPU Core A Extension
+// Updated: 2026-10-16 - Invalidation by stores from other harts
+// Updated: 2026-10-16 - Line-granular remote invalidation (coherent D-caches)
 
 `include "rtl/config/rv_config.vh"
 
 module reservation_station #(
-    parameter XLEN = `XLEN
+    parameter XLEN = `XLEN,
+    parameter REMOTE_GRANULE_BITS = 0   // log2 bytes matched for remote invalidation (0 = as LR/SC)
 ) (
     input  wire clk,
     input  wire reset,
@@ -22,6 +25,8 @@ module reservation_station #(
     // Invalidation signals
     input  wire invalidate,             // Clear reservation
     input  wire [XLEN-1:0] inv_addr,    // Address being invalidated
+    input  wire remote_invalidate,      // Store (or exclusive line acquire) by another hart
+    input  wire [XLEN-1:0] remote_addr, // Address of that store / line
     input  wire exception,              // Exception occurred
     input  wire interrupt               // Interrupt occurred
 );
@@ -38,6 +43,10 @@ module reservation_station #(
     wire [XLEN-1:0] lr_addr_masked = lr_addr & ~((1 << ADDR_MASK_BITS) - 1);
     wire [XLEN-1:0] sc_addr_masked = sc_addr & ~((1 << ADDR_MASK_BITS) - 1);
     wire [XLEN-1:0] inv_addr_masked = inv_addr & ~((1 << ADDR_MASK_BITS) - 1);
+    // Remote writes may only be known per cache line (coherence_hub RdX)
+    localparam REMOTE_MASK_BITS = (REMOTE_GRANULE_BITS > ADDR_MASK_BITS) ? REMOTE_GRANULE_BITS : ADDR_MASK_BITS;
+
+    wire remote_match = (reserved_addr >> REMOTE_MASK_BITS) == (remote_addr >> REMOTE_MASK_BITS);
 
     // Reservation logic
     always @(posedge clk or posedge reset) begin
@@ -61,6 +70,13 @@ module reservation_station #(
                 $display("[RESERVATION] Invalidated by write to 0x%08h", inv_addr);
                 `endif
             end
+            // Another hart stored to the reserved address
+            else if (remote_invalidate && reserved && remote_match) begin
+                reserved <= 1'b0;
+                `ifdef DEBUG_ATOMIC
+                $display("[RESERVATION] Invalidated by remote write to 0x%08h", remote_addr);
+                `endif
+            end
             // SC consumes or invalidates reservation
             else if (sc_valid) begin
                 reserved <= 1'b0;  // Always clear on SC (success or fail)
@@ -143,7 +143,15 @@ module rv32i_core #(
     .rd_data(rd_data),
     .rd_wen(reg_write),
     .rs1_data(rs1_data),
-    .rs2_data(rs2_data)
+    .rs2_data(rs2_data),
+    // Second issue lane unused in the single-cycle core
+    .rs3_addr(5'h0),
+    .rs4_addr(5'h0),
+    .rd2_addr(5'h0),
+    .rd2_data(32'h0),
+    .rd2_wen(1'b0),
+    .rs3_data(),
+    .rs4_data()
   );
 
   //==========================================================================
@@ -13,7 +13,8 @@ module rv_core_pipelined #(
   parameter RESET_VECTOR = {XLEN{1'b0}},
   parameter IMEM_SIZE = 4096,
   parameter DMEM_SIZE = 16384,
-  parameter MEM_FILE = ""
+  parameter MEM_FILE = "",
+  parameter HART_ID = 0                  // mhartid (multi-hart SoC)
 ) (
   input  wire             clk,
   input  wire             reset_n,
@@ -23,6 +24,7 @@ module rv_core_pipelined #(
   input  wire             msip_in,       // Machine Software Interrupt Pending
   input  wire             meip_in,       // Machine External Interrupt Pending (from PLIC)
   input  wire             seip_in,       // Supervisor External Interrupt Pending (from PLIC)
+  input  wire [63:0]      mtime_in,      // CLINT mtime, read by the time CSR
 
   // Bus master interface (to memory interconnect)
   output wire             bus_req_valid,
@@ -32,6 +34,13 @@ module rv_core_pipelined #(
   output wire [2:0]       bus_req_size,
   input  wire             bus_req_ready,
   input  wire [63:0]      bus_req_rdata,
+  output wire             bus_req_lock,  // Keep the bus across an atomic sequence or PTE A/D update
+  output wire             bus_req_amo,   // Read is an AMO executed by memory (near-memory AMO)
+  output wire [4:0]       bus_req_amo_op, // Its operation (funct5)
+
+  // Stores by other harts (multi-hart SoC), for LR reservation invalidation
+  input  wire             snoop_wr_valid,
+  input  wire [XLEN-1:0]  snoop_wr_addr,
 
   output wire [XLEN-1:0]  pc_out,        // For debugging
   output wire [31:0]      instr_out      // For debugging (instructions always 32-bit)
@@ -55,6 +64,10 @@ module rv_core_pipelined #(
   // EX stage forwarding control signals
   wire [1:0] forward_a;          // EX stage forward select for ALU operand A (2'b10=MEM, 2'b01=WB, 2'b00=NONE)
   wire [1:0] forward_b;          // EX stage forward select for ALU operand B
+  wire       id_forward_a_l1;    // Dual issue: selected ID forward source is lane 1
+  wire       id_forward_b_l1;
+  wire       forward_a_l1;       // Dual issue: selected EX forward source is lane 1
+  wire       forward_b_l1;
 
   // Trap/exception control
   wire trap_flush;         // Flush pipeline on trap
@@ -79,6 +92,13 @@ module rv_core_pipelined #(
   wire [31:0]     if_instruction;     // Final instruction (decompressed if needed)
   wire            if_is_compressed;   // Instruction is compressed
   wire            if_illegal_c_instr; // Illegal compressed instruction
+  wire            if_fetch_stall;     // No instruction at the IF PC this cycle (I-cache miss, fetch queue empty)
+  wire [XLEN-1:0] if_fetch_vaddr;     // Fetch address (IF PC, or the fetch queue's run-ahead PC)
+  wire            if_head_page_fault; // Instruction page fault for the instruction at the IF PC
+  wire [XLEN-1:0] if_head_fault_vaddr;
+  wire            if_bp_taken;        // Branch predictor: redirect fetch
+  wire [XLEN-1:0] if_bp_target;       // Branch predictor: predicted target
+  wire [31:0]     if_bp_meta;         // Branch predictor: state snapshot for update
 
   //==========================================================================
   // IF/ID Pipeline Register Outputs
@@ -89,6 +109,57 @@ module rv_core_pipelined #(
   wire            ifid_is_compressed; // Was the instruction originally compressed?
   wire            ifid_page_fault;    // Session 117: Instruction page fault
   wire [XLEN-1:0] ifid_fault_vaddr;   // Session 117: Faulting virtual address
+  wire            ifid_bp_taken;      // Predicted taken in IF
+  wire [XLEN-1:0] ifid_bp_target;     // Predicted target
+  wire [31:0]     ifid_bp_meta;       // Predictor state snapshot
+
+  //==========================================================================
+  // Dual Issue (ISSUE_WIDTH=2): lane 1 is a simple ALU op at PC+4 that rides
+  // in lane 0's pipeline slot; with ISSUE_WIDTH=1 if_pair is constant 0 and
+  // every lane-1 valid bit stays clear
+  //==========================================================================
+  wire [31:0]     if_bundle_hi;       // 32 bits at PC+4 (second half of the fetch bundle)
+  wire            if_bundle_hi_valid; // if_bundle_hi available this cycle
+  wire            if_pair;            // PC+4 issues alongside PC
+
+  wire            ifid1_valid;
+  wire [31:0]     ifid1_instruction;
+
+  wire [6:0]      id1_opcode;
+  wire [4:0]      id1_rd, id1_rs1, id1_rs2;
+  wire [2:0]      id1_funct3;
+  wire [6:0]      id1_funct7;
+  wire [XLEN-1:0] id1_imm_i, id1_imm_u;
+  wire            id1_reg_write;
+  wire [3:0]      id1_alu_control;
+  wire            id1_alu_src;
+  wire [2:0]      id1_imm_sel;
+  wire [XLEN-1:0] id1_immediate;
+  wire [XLEN-1:0] id1_rs1_data_raw, id1_rs2_data_raw;
+  wire [XLEN-1:0] id1_rs1_data, id1_rs2_data;
+  wire [2:0]      id1_forward_a, id1_forward_b;
+  wire            id1_forward_a_l1, id1_forward_b_l1;
+
+  reg             idex1_valid;
+  reg  [4:0]      idex1_rd_addr, idex1_rs1_addr, idex1_rs2_addr;
+  reg  [XLEN-1:0] idex1_rs1_data, idex1_rs2_data, idex1_imm;
+  reg  [3:0]      idex1_alu_control;
+  reg             idex1_alu_src;
+  reg  [6:0]      idex1_opcode;
+  reg             idex1_reg_write;
+  wire [1:0]      forward1_a, forward1_b;
+  wire            forward1_a_l1, forward1_b_l1;
+  wire [XLEN-1:0] ex1_result;
+
+  reg             exmem1_valid;
+  reg  [4:0]      exmem1_rd_addr;
+  reg             exmem1_reg_write;
+  reg  [XLEN-1:0] exmem1_result;
+
+  reg             memwb1_valid;
+  reg  [4:0]      memwb1_rd_addr;
+  reg             memwb1_reg_write;
+  reg  [XLEN-1:0] memwb1_result;
 
   //==========================================================================
   // ID Stage Signals
@@ -228,6 +299,9 @@ module rv_core_pipelined #(
   wire            idex_illegal_inst;
   wire [31:0]     idex_instruction;
   wire            idex_is_compressed;  // Bug #42: Track if instruction was compressed  // Instructions always 32-bit
+  wire            idex_bp_taken;       // Predicted taken in IF
+  wire [XLEN-1:0] idex_bp_target;      // Predicted target
+  wire [31:0]     idex_bp_meta;        // Predictor state snapshot
 
   //==========================================================================
   // EX Stage Signals
@@ -244,14 +318,30 @@ module rv_core_pipelined #(
   wire [XLEN-1:0] ex_branch_target;
   wire [XLEN-1:0] ex_jump_target;
   wire [XLEN-1:0] ex_pc_plus_4;
+  wire            ex_mispredict;       // Actual next PC differs from predicted: redirect fetch
+  wire [XLEN-1:0] ex_redirect_target;  // Correct next PC on misprediction
+  wire            ex_fence_i;          // FENCE.I in EX: invalidate I-cache, refetch PC+4
+  wire            ex_redirect;         // Misprediction or FENCE.I: redirect fetch
   wire [XLEN-1:0] ex_csr_rdata;       // CSR read data
   wire            ex_illegal_csr;     // Illegal CSR access
 
   // M extension signals
   wire [XLEN-1:0] ex_mul_div_result;
+  wire [XLEN-1:0] ex_mul_div_unit_result;  // Iterative mul_div_unit result
   wire            ex_mul_div_busy;
   wire            ex_mul_div_ready;
 
+  // Pipelined multiplier (MUL_STAGES != 0): multiplies flow through EX/MEM/WB
+  // like ALU ops instead of holding EX; only divides use the iterative unit
+  wire            idex_mul_pipelined   = (`MUL_STAGES != 0) && idex_is_mul_div && !idex_mul_div_op[2];
+  // Background divide (NONBLOCKING_LONG_OPS != 0): divides leave EX at once and
+  // complete later through long_op_unit
+  wire            idex_div_bg          = (`NONBLOCKING_LONG_OPS != 0) && idex_is_mul_div && idex_mul_div_op[2];
+  wire            idex_is_mul_div_seq  = idex_is_mul_div && !idex_mul_pipelined && !idex_div_bg;
+  wire [XLEN-1:0] pmul_result;            // Result of the multiply in its last stage
+  reg             exmem_mul_pipelined;    // Pipelined multiply in MEM
+  reg             memwb_mul_pipelined;    // Pipelined multiply in WB
+
   // F/D extension signals
   wire [`FLEN-1:0] ex_fp_operand_a;        // FP operand A (potentially forwarded)
   wire [`FLEN-1:0] ex_fp_operand_b;        // FP operand B (potentially forwarded)
@@ -270,29 +360,104 @@ module rv_core_pipelined #(
   wire [1:0]      fp_forward_b;
   wire [1:0]      fp_forward_c;
 
+  // Pipelined FMA datapath (FPU_PIPELINED != 0): FADD/FSUB/FMUL/FMA leave EX
+  // like ALU ops and complete into a second FP register file port; all other
+  // FP ops still hold EX in the multi-cycle fpu
+  wire            idex_fp_pipelined = (`FPU_PIPELINED != 0) && idex_fp_alu_en &&
+                                      ((idex_fp_alu_op == 5'b00000) ||   // FADD
+                                       (idex_fp_alu_op == 5'b00001) ||   // FSUB
+                                       (idex_fp_alu_op == 5'b00010) ||   // FMUL
+                                       (idex_fp_alu_op == 5'b01101) ||   // FMADD
+                                       (idex_fp_alu_op == 5'b01110) ||   // FMSUB
+                                       (idex_fp_alu_op == 5'b01111) ||   // FNMSUB
+                                       (idex_fp_alu_op == 5'b10000));    // FNMADD
+  // Background FDIV/FSQRT (NONBLOCKING_LONG_OPS != 0): issue to long_op_unit
+  // and complete through the same port, behind the FMA pipeline
+  wire            idex_fp_long      = (`NONBLOCKING_LONG_OPS != 0) && idex_fp_alu_en &&
+                                      ((idex_fp_alu_op == 5'b00011) ||   // FDIV
+                                       (idex_fp_alu_op == 5'b00100));    // FSQRT
+  wire            idex_fp_alu_seq   = idex_fp_alu_en && !idex_fp_pipelined && !idex_fp_long;
+  wire            fp_pipe_issue;           // Op leaves EX into the FMA pipeline
+  wire            fp_pipe_valid;           // Op completes this cycle
+  wire [4:0]      fp_pipe_rd;
+  wire            fp_pipe_fmt;
+  wire [`FLEN-1:0] fp_pipe_result;
+  wire            fp_pipe_flag_nv;
+  wire            fp_pipe_flag_of;
+  wire            fp_pipe_flag_uf;
+  wire            fp_pipe_flag_nx;
+  reg  [31:0]     fp_busy;                 // Scoreboard: FP destinations in flight
+  wire            fp_sb_hazard;            // ID instruction touches an in-flight register
+
+  // Long-latency unit (NONBLOCKING_LONG_OPS != 0)
+  wire            ex_commit;               // Instruction in EX leaves it this cycle
+  wire            long_int_issue;
+  wire            long_int_busy;           // Divider occupied
+  wire            long_int_wb_valid;
+  wire [4:0]      long_int_wb_rd;
+  wire [XLEN-1:0] long_int_wb_data;
+  wire            long_int_wb_grant;       // Divide result takes a free WB write slot
+  wire            long_fp_issue;
+  wire            long_fdiv_busy;
+  wire            long_fsqrt_busy;
+  wire            long_fp_wb_valid;
+  wire [4:0]      long_fp_wb_rd;
+  wire            long_fp_wb_fmt;
+  wire [`FLEN-1:0] long_fp_wb_data;
+  wire [4:0]      long_fp_wb_flags;
+  wire            long_fp_wb_grant;        // FDIV/FSQRT result takes FP write port 2
+  reg  [31:0]     int_busy;                // Scoreboard: integer destinations in flight
+  wire            int_sb_hazard;           // ID instruction touches an in-flight register
+
+  // FP register file write port 2: FMA pipeline completions, else FDIV/FSQRT
+  wire            fp_wr2_en;
+  wire [4:0]      fp_wr2_rd;
+  wire            fp_wr2_fmt;
+  wire [`FLEN-1:0] fp_wr2_data;
+  wire [4:0]      fp_wr2_flags;
+
   // Hold EX/MEM register when M instruction or A instruction or FP instruction or MMU is executing
   // Session 53: Also hold when bus is waiting (peripherals with registered req_ready)
   // Without this, EX/MEM register advances during bus wait, losing store write data
   wire            hold_exmem;
   wire            bus_wait_stall;  // Bus wait condition (also calculated in hazard unit)
-
-  assign bus_wait_stall = bus_req_valid && !bus_req_ready;
-  assign hold_exmem = (idex_is_mul_div && idex_valid && !ex_mul_div_ready) ||
+  wire            ptw_bus_conflict; // Page walker owns the bus while MEM needs it
+  wire            sb_fence_stall;  // FENCE in EX waiting for the store buffer to drain
+
+  // MEM-stage data bus (arbiter side of the store buffer; the bus_req_* ports
+  // when ENABLE_STORE_BUFFER=0)
+  wire            dbus_req_valid;
+  wire [XLEN-1:0] dbus_req_addr;
+  wire [63:0]     dbus_req_wdata;
+  wire            dbus_req_we;
+  wire [2:0]      dbus_req_size;
+  wire            dbus_req_amo;
+  wire [4:0]      dbus_req_amo_op;
+  wire            dbus_req_ready;
+  wire [63:0]     dbus_req_rdata;
+
+  assign bus_wait_stall = dbus_req_valid && !dbus_req_ready;
+  assign hold_exmem = (idex_is_mul_div_seq && idex_valid && !ex_mul_div_ready) ||
                       (idex_is_atomic && idex_valid && !ex_atomic_done) ||
-                      (idex_fp_alu_en && idex_valid && !ex_fpu_done) ||
+                      (idex_fp_alu_seq && idex_valid && !ex_fpu_done) ||
+                      (idex_div_bg && idex_valid && long_int_busy) ||      // Divider still occupied
+                      (idex_fp_long && idex_valid &&
+                       ((idex_fp_alu_op == 5'b00100) ? long_fsqrt_busy : long_fdiv_busy)) ||
                       mmu_busy ||                    // Phase 3: Stall on MMU page table walk
-                      bus_wait_stall;                // Session 53: Hold during bus wait
+                      bus_wait_stall ||              // Session 53: Hold during bus wait
+                      ptw_bus_conflict ||            // MEM access waits for a page walk
+                      sb_fence_stall;                // FENCE waits for buffered stores
 
   // M unit start signal: pulse once when M instruction first enters EX
   // Only start if not already busy or ready (prevents restarting)
   wire            m_unit_start;
-  assign m_unit_start = idex_is_mul_div && idex_valid && !ex_mul_div_busy && !ex_mul_div_ready;
+  assign m_unit_start = idex_is_mul_div_seq && idex_valid && !ex_mul_div_busy && !ex_mul_div_ready;
 
   // FPU start signal: pulse once when FP instruction first enters EX
   // Start FPU when: (1) FP ALU op enabled, (2) valid instruction, (3) FPU not busy
   // Note: Don't check !ex_fpu_done here - done is a completion flag, not a busy flag
   wire            fpu_start;
-  assign fpu_start = idex_fp_alu_en && idex_valid && !ex_fpu_busy;
+  assign fpu_start = idex_fp_alu_seq && idex_valid && !ex_fpu_busy;
 
   `ifdef DEBUG_JALR_TRACE
   // Trace JALR instruction through all pipeline stages
@@ -407,6 +572,7 @@ module rv_core_pipelined #(
   wire [2:0]      exmem_wb_sel;
   wire            exmem_valid;
   wire [XLEN-1:0] exmem_mul_div_result;
+  wire [XLEN-1:0] exmem_mul_div_result_final;  // Includes MUL_STAGES=2 multiplies finishing in MEM
   wire [XLEN-1:0] exmem_atomic_result;
   wire            exmem_is_atomic;
   wire [`FLEN-1:0] exmem_fp_result;
@@ -477,6 +643,9 @@ module rv_core_pipelined #(
   // MMU page table walk memory interface
   wire            mmu_ptw_req_valid;
   wire [XLEN-1:0] mmu_ptw_req_addr;
+  wire            mmu_ptw_req_we;      // A/D bit write-back (PTW_AD_UPDATE)
+  wire [XLEN-1:0] mmu_ptw_req_wdata;
+  wire            mmu_ptw_rmw_lock;    // PTE read to A/D write-back in progress
   wire            mmu_ptw_req_ready;
   wire [XLEN-1:0] mmu_ptw_resp_data;
   wire            mmu_ptw_resp_valid;
@@ -499,6 +668,7 @@ module rv_core_pipelined #(
   wire [2:0]      memwb_wb_sel;
   wire            memwb_valid;
   wire [XLEN-1:0] memwb_mul_div_result;
+  wire [XLEN-1:0] memwb_mul_div_result_reg;    // Before MUL_STAGES=3 multiplies finishing in WB
   wire [XLEN-1:0] memwb_atomic_result;
   wire [`FLEN-1:0] memwb_fp_result;
   wire [XLEN-1:0] memwb_int_result_fp;
@@ -655,7 +825,9 @@ module rv_core_pipelined #(
   // PC calculation (support both 2-byte and 4-byte increments for C extension)
   assign pc_plus_2 = pc_current + 32'd2;
   assign pc_plus_4 = pc_current + 32'd4;
-  assign pc_increment = if_is_compressed ? pc_plus_2 : pc_plus_4;
+  assign pc_increment = if_is_compressed ? pc_plus_2 :
+                        if_pair ? (pc_current + 32'd8) :   // Dual issue: both bundle words consumed
+                        pc_plus_4;
 
   // DEBUG: PC increment logic tracing
   `ifdef DEBUG_JAL_RET
@@ -668,15 +840,16 @@ module rv_core_pipelined #(
       if (trap_flush) $display("  → TRAP (vec=%h)", trap_vector);
       else if (mret_flush) $display("  → MRET (mepc=%h)", mepc);
       else if (sret_flush) $display("  → SRET (sepc=%h)", sepc);
-      else if (ex_take_branch) $display("  → BR/JMP (idex_pc=%h + imm=%h → tgt=%h, is_jump=%b, idex_is_comp=%b)",
-                                        idex_pc, idex_imm, idex_jump ? ex_jump_target : ex_branch_target, idex_jump, idex_is_compressed);
+      else if (ex_mispredict) $display("  → BR/JMP (idex_pc=%h + imm=%h → tgt=%h, is_jump=%b, idex_is_comp=%b)",
+                                        idex_pc, idex_imm, ex_redirect_target, idex_jump, idex_is_compressed);
+      else if (if_bp_taken) $display("  → PREDICTED (tgt=%h)", if_bp_target);
       else $display("  → INC");
 
       // Sanity check
       if (if_instruction_raw[1:0] == 2'b11 && if_is_compressed) begin
         $display("  *** BUG: Non-compressed instr marked as compressed!");
       end
-      if (pc_next != pc_increment && !trap_flush && !mret_flush && !sret_flush && !ex_take_branch) begin
+      if (pc_next != pc_increment && !trap_flush && !mret_flush && !sret_flush && !ex_mispredict && !if_bp_taken) begin
         $display("  *** BUG: PC_NEXT mismatch! Expected %h, got %h", pc_increment, pc_next);
       end
     end
@@ -747,12 +920,16 @@ module rv_core_pipelined #(
     end
   end
 
-  // PC selection: priority order - trap > mret > sret > branch/jump > PC+increment
+  // PC selection: priority order - trap > mret > sret > EX redirect > prediction > PC+increment
   // Note: Branches/jumps can target 2-byte aligned addresses (for C extension)
+  // With the branch predictor disabled, ex_mispredict == ex_take_branch and
+  // ex_redirect_target is the branch/jump target (original behavior)
+  // FENCE.I also redirects (to PC+4) so instructions fetched before it are refetched
   assign pc_next = trap_flush ? trap_vector :
                    mret_flush ? mepc :
                    sret_flush ? sepc :
-                   ex_take_branch ? (idex_jump ? ex_jump_target : ex_branch_target) :
+                   ex_redirect ? ex_redirect_target :
+                   if_bp_taken ? if_bp_target :
                    pc_increment;
 
   // Debug PC updates
@@ -768,15 +945,21 @@ module rv_core_pipelined #(
     end
   end
 
-  // Pipeline flush: trap/xRET flushes all stages, branch flushes IF/ID and ID/EX
-  assign flush_ifid = trap_flush | mret_flush | sret_flush | ex_take_branch;
-  assign flush_idex = trap_flush | mret_flush | sret_flush | flush_idex_hazard | ex_take_branch;
+  // Pipeline flush: trap/xRET flushes all stages, EX redirect flushes IF/ID and ID/EX
+  assign flush_ifid = trap_flush | mret_flush | sret_flush | ex_redirect;
+  assign flush_idex = trap_flush | mret_flush | sret_flush | flush_idex_hazard | ex_redirect;
+
+  // I-cache miss / empty fetch queue: IF/ID receives a bubble unless ID is stalled (then it holds)
+  wire ifid_flush_gated = flush_ifid | (if_fetch_stall && !stall_ifid);
 
   // PC stall control: override stall on flush (trap/xRET/branch)
   // When a control flow change occurs, PC MUST update regardless of hazards
   // Session 125: Also stall PC when I-TLB miss (waiting for instruction translation)
+  // Also stall PC on I-cache miss (waiting for refill)
+  // With the fetch queue, I-TLB misses only stall the fetch side
   wire pc_stall_gated;
-  assign pc_stall_gated = (stall_pc || if_mmu_busy) && !(trap_flush | mret_flush | sret_flush | ex_take_branch);
+  assign pc_stall_gated = (stall_pc || (if_mmu_busy && (`FETCH_QUEUE_DEPTH == 0)) || if_fetch_stall) &&
+                          !(trap_flush | mret_flush | sret_flush | ex_redirect);
 
   // Program Counter
   pc #(
@@ -801,7 +984,136 @@ module rv_core_pipelined #(
   // Otherwise: use PC directly (bare mode, M-mode, or TLB miss pending)
   wire [XLEN-1:0] if_fetch_addr = (if_needs_translation && if_mmu_req_ready) ?
                                    if_mmu_req_paddr :
-                                   pc_current;
+                                   if_fetch_vaddr;
+
+  // Instruction fetch path
+  // ENABLE_ICACHE=0: IF reads instruction_memory directly (zero latency)
+  // ENABLE_ICACHE=1: IF reads the I-cache; misses refill word-by-word from
+  //                  instruction_memory through imem_bus_adapter, which adds
+  //                  ICACHE_REFILL_LATENCY wait cycles per word
+  wire [XLEN-1:0] imem_read_addr;
+  wire [31:0]     imem_read_data;
+  wire [31:0]     imem_read_data_next;  // Next word (dual-issue bundle, no I-cache)
+
+  wire            if_fetch_req;         // Fetch wanted this cycle
+  wire            if_mem_valid;         // if_mem_data valid this cycle
+  wire [31:0]     if_mem_data;          // 32 bits at if_fetch_addr
+  wire            if_mem_next_valid;    // if_mem_next valid (word-aligned fetch)
+  wire [31:0]     if_mem_next;          // 32 bits at if_fetch_addr + 4
+
+  generate
+    if (`ENABLE_ICACHE) begin : g_icache
+      wire            icache_mem_req_valid;
+      wire [XLEN-1:0] icache_mem_req_addr;
+      wire            icache_mem_req_ready;
+      wire [31:0]     icache_mem_rdata;
+      wire            icache_hit;
+      wire            icache_req_valid = if_fetch_req && !if_mmu_busy;  // Wait for physical address
+
+      // Next-line prefetch (fetch queue only): the line after the one being
+      // fetched, when it is in the same page (same translation)
+      localparam PF_LINE = `ICACHE_LINE_SIZE;
+      wire [XLEN-1:0] if_prefetch_addr  = (if_fetch_addr | (PF_LINE - 1)) + 1;
+      wire            if_prefetch_valid = (`FETCH_QUEUE_DEPTH != 0) && !if_mmu_busy &&
+                                          ((if_fetch_addr[11:0] | (PF_LINE - 1)) != 12'hFFF);
+
+      icache #(
+        .XLEN(XLEN)
+      ) icache_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .req_valid(icache_req_valid),
+        .req_addr(if_fetch_addr),
+        .req_hit(icache_hit),
+        .instruction(if_mem_data),
+        .next_hit(if_mem_next_valid),
+        .next_word(if_mem_next),
+        .prefetch_valid(if_prefetch_valid),
+        .prefetch_addr(if_prefetch_addr),
+        .invalidate(ex_fence_i && !hold_exmem),
+        .mem_req_valid(icache_mem_req_valid),
+        .mem_req_addr(icache_mem_req_addr),
+        .mem_req_ready(icache_mem_req_ready),
+        .mem_rdata(icache_mem_rdata),
+        .stat_hits(),
+        .stat_misses(),
+        .stat_prefetches()
+      );
+
+      imem_bus_adapter #(
+        .ADDR_WIDTH(XLEN),
+        .LATENCY(`ICACHE_REFILL_LATENCY)
+      ) icache_refill (
+        .clk(clk),
+        .reset_n(reset_n),
+        .req_valid(icache_mem_req_valid),
+        .req_addr(icache_mem_req_addr),
+        .req_ready(icache_mem_req_ready),
+        .req_rdata(icache_mem_rdata),
+        .imem_addr(imem_read_addr),
+        .imem_rdata(imem_read_data)
+      );
+
+      assign if_mem_valid = icache_hit;
+    end else begin : g_no_icache
+      assign imem_read_addr    = if_fetch_addr;  // Use translated address!
+      assign if_mem_data       = imem_read_data;
+      assign if_mem_valid      = 1'b1;
+      assign if_mem_next       = imem_read_data_next;
+      assign if_mem_next_valid = 1'b1;
+    end
+  endgenerate
+
+  // Fetch queue (FETCH_QUEUE_DEPTH != 0): fetch runs ahead of the IF PC into a
+  // halfword queue, so it keeps going while decode is stalled; the IF-stage
+  // RVC logic and dual-issue pairing read the queue head. Without it, the
+  // IF PC fetches directly and waits on I-TLB/I-cache misses.
+  generate
+    if (`FETCH_QUEUE_DEPTH != 0) begin : g_fetch_queue
+      wire fq_head_valid;
+      // Anything but a sequential IF PC step refills the queue from pc_next
+      wire fq_redirect = trap_flush | mret_flush | sret_flush | ex_redirect |
+                         (if_bp_taken && !pc_stall_gated);
+
+      fetch_queue #(
+        .XLEN(XLEN),
+        .DEPTH(`FETCH_QUEUE_DEPTH),
+        .RESET_VECTOR(RESET_VECTOR)
+      ) fetch_q (
+        .clk(clk),
+        .reset_n(reset_n),
+        .fetch_addr(if_fetch_vaddr),
+        .fetch_req(if_fetch_req),
+        .fetch_valid(if_mem_valid && !if_mmu_busy),
+        .fetch_data(if_mem_data),
+        .fetch_next_valid(if_mem_next_valid && (if_fetch_vaddr[11:2] != 10'h3FF)),  // Same page only
+        .fetch_next(if_mem_next),
+        .fetch_fault(if_mmu_req_page_fault && !if_mmu_busy),
+        .fetch_fault_vaddr(if_mmu_req_fault_vaddr),
+        .head_valid(fq_head_valid),
+        .head_instr(if_instruction_raw),
+        .head_next_valid(if_bundle_hi_valid),
+        .head_next(if_bundle_hi),
+        .head_fault(if_head_page_fault),
+        .head_fault_vaddr(if_head_fault_vaddr),
+        .consume(!pc_stall_gated),
+        .consume_hw(if_is_compressed ? 3'd1 : if_pair ? 3'd4 : 3'd2),
+        .redirect(fq_redirect),
+        .redirect_pc(pc_next)
+      );
+
+      assign if_fetch_stall = !fq_head_valid && !if_head_page_fault;
+    end else begin : g_no_fetch_queue
+      assign if_fetch_vaddr      = pc_current;
+      assign if_fetch_req        = 1'b1;
+      assign if_instruction_raw  = if_mem_data;
+      assign if_bundle_hi        = if_mem_next;
+      assign if_bundle_hi_valid  = if_mem_next_valid;
+      assign if_head_page_fault  = if_mmu_req_page_fault;
+      assign if_head_fault_vaddr = if_mmu_req_fault_vaddr;
+      assign if_fetch_stall      = !if_mmu_busy && !if_mem_valid;
+    end
+  endgenerate
 
   instruction_memory #(
     .XLEN(XLEN),
@@ -809,8 +1121,9 @@ module rv_core_pipelined #(
     .MEM_FILE(MEM_FILE)
   ) imem (
     .clk(clk),
-    .addr(if_fetch_addr),  // Use translated address!
-    .instruction(if_instruction_raw),
+    .addr(imem_read_addr),
+    .instruction(imem_read_data),
+    .instruction_next(imem_read_data_next),
     // Write interface for self-modifying code (FENCE.I)
     .mem_write(imem_write_enable),
     .write_addr(exmem_alu_result),
@@ -860,20 +1173,125 @@ module rv_core_pipelined #(
     .clk(clk),
     .reset_n(reset_n),
     .stall(stall_ifid),
-    .flush(flush_ifid),
+    .flush(ifid_flush_gated),
     .pc_in(pc_current),
     .instruction_in(if_instruction),    // Already decompressed if it was compressed
     .is_compressed_in(if_is_compressed),
-    .page_fault_in(if_mmu_req_page_fault),   // Session 117
-    .fault_vaddr_in(if_mmu_req_fault_vaddr), // Session 117
+    .page_fault_in(if_head_page_fault),      // Session 117
+    .fault_vaddr_in(if_head_fault_vaddr),    // Session 117
+    .bp_taken_in(if_bp_taken),
+    .bp_target_in(if_bp_target),
+    .bp_meta_in(if_bp_meta),
     .pc_out(ifid_pc),
     .instruction_out(ifid_instruction),
     .valid_out(ifid_valid),
     .is_compressed_out(ifid_is_compressed),
     .page_fault_out(ifid_page_fault),        // Session 117
-    .fault_vaddr_out(ifid_fault_vaddr)       // Session 117
+    .fault_vaddr_out(ifid_fault_vaddr),      // Session 117
+    .bp_taken_out(ifid_bp_taken),
+    .bp_target_out(ifid_bp_target),
+    .bp_meta_out(ifid_bp_meta)
+  );
+
+  // Dual issue pairing (predecode of the 64-bit fetch bundle)
+  // Lane 0 (instruction at PC) may be any ALU, branch/jump or load/store op;
+  // lane 1 (word at PC+4) must be a simple ALU op (LUI/AUIPC/OP-IMM/OP, no M,
+  // no W-ops) that does not read lane 0's destination. Lane 1 can't trap, so
+  // precise exceptions only need lane 1 killed along with anything lane 0 kills.
+  // Pairing also requires a word-aligned, uncompressed, not-predicted-taken
+  // lane 0 and PC+4 in the same page (it shares lane 0's translation).
+  wire [6:0] if0_opcode = if_instruction_raw[6:0];
+  wire [6:0] if0_funct7 = if_instruction_raw[31:25];
+  wire [4:0] if0_rd     = if_instruction_raw[11:7];
+  wire [6:0] if1_opcode = if_bundle_hi[6:0];
+  wire [2:0] if1_funct3 = if_bundle_hi[14:12];
+  wire [6:0] if1_funct7 = if_bundle_hi[31:25];
+  wire [4:0] if1_rs1    = if_bundle_hi[19:15];
+  wire [4:0] if1_rs2    = if_bundle_hi[24:20];
+
+  wire if0_pairable = (if0_opcode == 7'b0110111) ||                              // LUI
+                      (if0_opcode == 7'b0010111) ||                              // AUIPC
+                      (if0_opcode == 7'b0010011) ||                              // OP-IMM
+                      ((if0_opcode == 7'b0110011) && (if0_funct7 != 7'b0000001)) || // OP (not M)
+                      ((XLEN == 64) && (if0_opcode == 7'b0011011)) ||            // OP-IMM-32
+                      ((XLEN == 64) && (if0_opcode == 7'b0111011) &&
+                       (if0_funct7 != 7'b0000001)) ||                            // OP-32 (not M)
+                      (if0_opcode == 7'b1101111) ||                              // JAL
+                      (if0_opcode == 7'b1100111) ||                              // JALR
+                      (if0_opcode == 7'b1100011) ||                              // BRANCH
+                      (if0_opcode == 7'b0000011) ||                              // LOAD
+                      (if0_opcode == 7'b0100011);                                // STORE
+
+  // Shift-immediate encodings: funct6/funct7 must be 0 (SLLI/SRLI) or 0100000x (SRAI)
+  wire if1_shamt_ok = (XLEN == 64) ? 1'b1 : !if_bundle_hi[25];
+  wire if1_slli_ok  = (if_bundle_hi[31:26] == 6'b000000) && if1_shamt_ok;
+  wire if1_sri_ok   = ((if_bundle_hi[31:26] == 6'b000000) ||
+                       (if_bundle_hi[31:26] == 6'b010000)) && if1_shamt_ok;
+
+  wire if1_alu = (if1_opcode == 7'b0110111) ||                                   // LUI
+                 (if1_opcode == 7'b0010111) ||                                   // AUIPC
+                 ((if1_opcode == 7'b0010011) &&                                  // OP-IMM
+                  ((if1_funct3 == 3'b001) ? if1_slli_ok :
+                   (if1_funct3 == 3'b101) ? if1_sri_ok : 1'b1)) ||
+                 ((if1_opcode == 7'b0110011) &&                                  // OP: base RV32I only
+                  ((if1_funct7 == 7'b0000000) ||
+                   ((if1_funct7 == 7'b0100000) && ((if1_funct3 == 3'b000) || (if1_funct3 == 3'b101)))));
+
+  wire if1_reads_rs1 = (if1_opcode != 7'b0110111) && (if1_opcode != 7'b0010111);
+  wire if1_reads_rs2 = (if1_opcode == 7'b0110011);
+  wire if0_writes_rd = (if0_opcode != 7'b1100011) && (if0_opcode != 7'b0100011) && (if0_rd != 5'h0);
+  wire if_pair_dep   = if0_writes_rd && ((if1_reads_rs1 && (if1_rs1 == if0_rd)) ||
+                                         (if1_reads_rs2 && (if1_rs2 == if0_rd)));
+
+  assign if_pair = (`ISSUE_WIDTH == 2) &&
+                   !if_is_compressed && (pc_current[1:0] == 2'b00) &&
+                   (pc_current[11:2] != 10'h3FF) &&
+                   if_bundle_hi_valid && (if_bundle_hi[1:0] == 2'b11) &&
+                   !if_bp_taken && !if_head_page_fault &&
+                   (!if_mmu_busy || (`FETCH_QUEUE_DEPTH != 0)) &&
+                   if0_pairable && if1_alu && !if_pair_dep;
+
+  // Lane-1 IF/ID register: same flush/stall behavior as lane 0, and a bubble
+  // whenever the fetched bundle did not pair
+  ifid_register #(
+    .XLEN(XLEN)
+  ) ifid1_reg (
+    .clk(clk),
+    .reset_n(reset_n),
+    .stall(stall_ifid),
+    .flush(ifid_flush_gated || (!if_pair && !stall_ifid)),
+    .pc_in(pc_plus_4),
+    .instruction_in(if_bundle_hi),
+    .is_compressed_in(1'b0),
+    .page_fault_in(1'b0),
+    .fault_vaddr_in({XLEN{1'b0}}),
+    .bp_taken_in(1'b0),
+    .bp_target_in({XLEN{1'b0}}),
+    .bp_meta_in(32'd0),
+    .pc_out(),
+    .instruction_out(ifid1_instruction),
+    .valid_out(ifid1_valid),
+    .is_compressed_out(),
+    .page_fault_out(),
+    .fault_vaddr_out(),
+    .bp_taken_out(),
+    .bp_target_out(),
+    .bp_meta_out()
   );
 
+  `ifdef DEBUG_DUAL_ISSUE
+  reg [31:0] dual_issue_pairs;
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n)
+      dual_issue_pairs <= 32'd0;
+    else if (memwb1_valid) begin
+      dual_issue_pairs <= dual_issue_pairs + 1;
+      $display("[DUAL] pair #%0d retired: lane1 x%0d <= %h", dual_issue_pairs + 1,
+               memwb1_rd_addr, memwb1_result);
+    end
+  end
+  `endif
+
   //==========================================================================
   // ID STAGE: Instruction Decode
   //==========================================================================
@@ -995,9 +1413,9 @@ module rv_core_pipelined #(
   always @(posedge clk or negedge reset_n) begin
     if (!reset_n)
       if_illegal_c_instr_buffered <= 1'b0;
-    else if (!stall_ifid && !flush_ifid)
+    else if (!stall_ifid && !ifid_flush_gated)
       if_illegal_c_instr_buffered <= if_illegal_c_instr;
-    else if (flush_ifid)
+    else if (ifid_flush_gated)
       if_illegal_c_instr_buffered <= 1'b0;  // Flush clears the illegal flag
   end
 
@@ -1010,6 +1428,98 @@ module rv_core_pipelined #(
   assign id_is_sret = id_is_sret_dec;
   assign id_is_sfence_vma = id_is_sfence_vma_dec;
 
+  // Lane-1 decode (dual issue): only the ALU subset of decoder/control is used
+  decoder #(
+    .XLEN(XLEN)
+  ) decoder1_inst (
+    .instruction(ifid1_instruction),
+    .opcode(id1_opcode),
+    .rd(id1_rd),
+    .rs1(id1_rs1),
+    .rs2(id1_rs2),
+    .funct3(id1_funct3),
+    .funct7(id1_funct7),
+    .imm_i(id1_imm_i),
+    .imm_s(),
+    .imm_b(),
+    .imm_u(id1_imm_u),
+    .imm_j(),
+    .csr_addr(),
+    .csr_uimm(),
+    .is_csr(),
+    .is_ecall(),
+    .is_ebreak(),
+    .is_mret(),
+    .is_sret(),
+    .is_sfence_vma(),
+    .is_mul_div(),
+    .mul_div_op(),
+    .is_word_op(),
+    .is_atomic(),
+    .funct5(),
+    .aq(),
+    .rl(),
+    .rs3(),
+    .is_fp(),
+    .is_fp_load(),
+    .is_fp_store(),
+    .is_fp_op(),
+    .is_fp_fma(),
+    .fp_rm(),
+    .fp_fmt()
+  );
+
+  control #(
+    .XLEN(XLEN)
+  ) control1_inst (
+    .opcode(id1_opcode),
+    .funct3(id1_funct3),
+    .funct7(id1_funct7),
+    // Lane 1 never carries system, M, A or FP instructions
+    .is_csr(1'b0),
+    .is_ecall(1'b0),
+    .is_ebreak(1'b0),
+    .is_mret(1'b0),
+    .is_sret(1'b0),
+    .is_sfence_vma(1'b0),
+    .is_mul_div(1'b0),
+    .mul_div_op(4'b0000),
+    .is_word_op(1'b0),
+    .is_atomic(1'b0),
+    .funct5(5'b00000),
+    .is_fp(1'b0),
+    .is_fp_load(1'b0),
+    .is_fp_store(1'b0),
+    .is_fp_op(1'b0),
+    .is_fp_fma(1'b0),
+    .mstatus_fs(2'b00),
+    .reg_write(id1_reg_write),
+    .mem_read(),
+    .mem_write(),
+    .branch(),
+    .jump(),
+    .alu_control(id1_alu_control),
+    .alu_src(id1_alu_src),
+    .wb_sel(),
+    .imm_sel(id1_imm_sel),
+    .csr_we(),
+    .csr_src(),
+    .mul_div_en(),
+    .mul_div_op_out(),
+    .is_word_op_out(),
+    .atomic_en(),
+    .atomic_funct5(),
+    .fp_reg_write(),
+    .int_reg_write_fp(),
+    .fp_mem_op(),
+    .fp_alu_en(),
+    .fp_alu_op(),
+    .fp_use_dynamic_rm(),
+    .illegal_inst()
+  );
+
+  assign id1_immediate = (id1_imm_sel == 3'b011) ? id1_imm_u : id1_imm_i;  // U (LUI/AUIPC) or I
+
   // Register File
   wire [XLEN-1:0] id_rs1_data_raw;  // Raw register file output
   wire [XLEN-1:0] id_rs2_data_raw;  // Raw register file output
@@ -1019,6 +1529,13 @@ module rv_core_pipelined #(
   // Gate register writes with memwb_valid to ensure only valid instructions commit
   wire int_reg_write_enable = (memwb_reg_write | memwb_int_reg_write_fp) && memwb_valid;
 
+  // Background divide results use the write port in cycles where WB doesn't
+  // (a WB write to x0 counts as free)
+  assign long_int_wb_grant = long_int_wb_valid && !(int_reg_write_enable && memwb_rd_addr != 5'h0);
+
+  wire [4:0]      regfile_rd_addr = long_int_wb_grant ? long_int_wb_rd   : memwb_rd_addr;
+  wire [XLEN-1:0] regfile_rd_data = long_int_wb_grant ? long_int_wb_data : wb_data;
+
   register_file #(
     .XLEN(XLEN)
   ) regfile (
@@ -1026,11 +1543,19 @@ module rv_core_pipelined #(
     .reset_n(reset_n),
     .rs1_addr(id_rs1),
     .rs2_addr(id_rs2),
-    .rd_addr(memwb_rd_addr),          // Write from WB stage
-    .rd_data(wb_data),                // Write data from WB stage
-    .rd_wen(int_reg_write_enable),    // Gated write enable: prevents flushed instruction writes
+    .rd_addr(regfile_rd_addr),        // Write from WB stage (or a background divide)
+    .rd_data(regfile_rd_data),        // Write data from WB stage (or a background divide)
+    .rd_wen(int_reg_write_enable || long_int_wb_grant),  // Gated write enable: prevents flushed instruction writes
     .rs1_data(id_rs1_data_raw),
-    .rs2_data(id_rs2_data_raw)
+    .rs2_data(id_rs2_data_raw),
+    // Dual issue: lane-1 reads, and lane-1 writeback on port 2
+    .rs3_addr(id1_rs1),
+    .rs4_addr(id1_rs2),
+    .rd2_addr(memwb1_rd_addr),
+    .rd2_data(memwb1_result),
+    .rd2_wen(memwb1_valid && memwb1_reg_write),
+    .rs3_data(id1_rs1_data_raw),
+    .rs4_data(id1_rs2_data_raw)
   );
 
   // ID Stage Integer Register Forwarding Muxes
@@ -1043,15 +1568,27 @@ module rv_core_pipelined #(
   wire [XLEN-1:0] ex_forward_data;
   assign ex_forward_data = idex_is_atomic ? ex_atomic_result : ex_alu_result_sext;
 
-  assign id_rs1_data = (id_forward_a == 3'b100) ? ex_forward_data :     // Forward from EX stage (atomic or ALU)
-                       (id_forward_a == 3'b010) ? exmem_forward_data :  // Forward from MEM stage (atomic or ALU)
-                       (id_forward_a == 3'b001) ? wb_data :             // Forward from WB stage
-                       id_rs1_data_raw;                                  // Use register file value
+  // Dual issue: the *_l1 select picks the lane-1 value of the chosen stage
+  assign id_rs1_data = (id_forward_a == 3'b100) ? (id_forward_a_l1 ? ex1_result : ex_forward_data) :        // Forward from EX stage (atomic or ALU)
+                       (id_forward_a == 3'b010) ? (id_forward_a_l1 ? exmem1_result : exmem_forward_data) :  // Forward from MEM stage (atomic or ALU)
+                       (id_forward_a == 3'b001) ? (id_forward_a_l1 ? memwb1_result : wb_data) :             // Forward from WB stage
+                       id_rs1_data_raw;                                                                      // Use register file value
 
-  assign id_rs2_data = (id_forward_b == 3'b100) ? ex_forward_data :     // Forward from EX stage (atomic or ALU)
-                       (id_forward_b == 3'b010) ? exmem_forward_data :  // Forward from MEM stage (atomic or ALU)
-                       (id_forward_b == 3'b001) ? wb_data :             // Forward from WB stage
-                       id_rs2_data_raw;                                  // Use register file value
+  assign id_rs2_data = (id_forward_b == 3'b100) ? (id_forward_b_l1 ? ex1_result : ex_forward_data) :        // Forward from EX stage (atomic or ALU)
+                       (id_forward_b == 3'b010) ? (id_forward_b_l1 ? exmem1_result : exmem_forward_data) :  // Forward from MEM stage (atomic or ALU)
+                       (id_forward_b == 3'b001) ? (id_forward_b_l1 ? memwb1_result : wb_data) :             // Forward from WB stage
+                       id_rs2_data_raw;                                                                      // Use register file value
+
+  // Lane-1 ID operands (same sources)
+  assign id1_rs1_data = (id1_forward_a == 3'b100) ? (id1_forward_a_l1 ? ex1_result : ex_forward_data) :
+                        (id1_forward_a == 3'b010) ? (id1_forward_a_l1 ? exmem1_result : exmem_forward_data) :
+                        (id1_forward_a == 3'b001) ? (id1_forward_a_l1 ? memwb1_result : wb_data) :
+                        id1_rs1_data_raw;
+
+  assign id1_rs2_data = (id1_forward_b == 3'b100) ? (id1_forward_b_l1 ? ex1_result : ex_forward_data) :
+                        (id1_forward_b == 3'b010) ? (id1_forward_b_l1 ? exmem1_result : exmem_forward_data) :
+                        (id1_forward_b == 3'b001) ? (id1_forward_b_l1 ? memwb1_result : wb_data) :
+                        id1_rs2_data_raw;
 
   `ifdef DEBUG_EXCEPTION
   always @(posedge clk) begin
@@ -1116,7 +1653,12 @@ module rv_core_pipelined #(
     .wr_en(fp_reg_write_enable),  // Gated write enable: prevents flushed instruction writes
     .rd_addr(memwb_fp_rd_addr),
     .rd_data(wb_fp_data),
-    .write_single(~memwb_fp_fmt)  // 1 for single-precision (fmt=0), 0 for double-precision (fmt=1)
+    .write_single(~memwb_fp_fmt), // 1 for single-precision (fmt=0), 0 for double-precision (fmt=1)
+    // Pipelined FMA completions (independent of WB)
+    .wr2_en(fp_wr2_en),
+    .rd2_addr(fp_wr2_rd),
+    .rd2_data(fp_wr2_data),
+    .write2_single(~fp_wr2_fmt)
   );
 
   // ID Stage FP Register Forwarding Muxes
@@ -1163,13 +1705,22 @@ module rv_core_pipelined #(
   wire id_csr_we_actual = id_csr_we && !id_csr_write_suppress;
 
   // Hazard Detection Unit
+  // LOAD_USE_BYPASS: ID instruction may take a load result forwarded from MEM
+  wire id_load_bypass_ok;
+  wire [5:0] hpm_stall_events;   // Stall causes for the performance counters
+
   hazard_detection_unit hazard_unit (
     .clk(clk),
     // Integer load-use hazard inputs
     .idex_mem_read(idex_mem_read),
+    .load_bypass_en(`LOAD_USE_BYPASS != 0),
+    .id_bypass_ok(id_load_bypass_ok),
     .idex_rd(idex_rd_addr),
     .ifid_rs1(id_rs1),
     .ifid_rs2(id_rs2),
+    .ifid1_rs1(id1_rs1),
+    .ifid1_rs2(id1_rs2),
+    .ifid1_valid(ifid1_valid),
     // FP load-use hazard inputs
     .idex_fp_rd(idex_fp_rd_addr),
     .idex_fp_mem_op(idex_fp_mem_op),
@@ -1178,19 +1729,24 @@ module rv_core_pipelined #(
     .ifid_fp_rs3(id_rs3),
     // M extension
     .mul_div_busy(ex_mul_div_busy),
-    .idex_is_mul_div(idex_is_mul_div),
+    .idex_is_mul_div(idex_is_mul_div_seq),
+    .idex_mul_late(idex_mul_pipelined && (`MUL_STAGES >= 2)),
     // A extension
     .atomic_busy(ex_atomic_busy),
     .atomic_done(ex_atomic_done),
+    .atomic_done_fwd_en(`ATOMIC_DONE_FORWARD != 0),
     .idex_is_atomic(idex_is_atomic),
     .exmem_is_atomic(exmem_is_atomic),
     .exmem_rd(exmem_rd_addr),
     // F/D extension
     .fpu_busy(ex_fpu_busy),
     .fpu_done(ex_fpu_done),
-    .idex_fp_alu_en(idex_fp_alu_en),
+    .idex_fp_alu_en(idex_fp_alu_seq),
+    .int_sb_hazard(int_sb_hazard),
     .exmem_fp_reg_write(exmem_fp_reg_write),
     .memwb_fp_reg_write(memwb_fp_reg_write),
+    .fp_sb_hazard(fp_sb_hazard),
+    .fp_pipe_busy((fp_busy != 32'h0) || ((idex_fp_pipelined || idex_fp_long) && idex_valid)),
     // CSR signals (for FFLAGS/FCSR dependency checking and RAW hazards)
     .id_csr_addr(id_csr_addr),
     .id_csr_we(id_csr_we),
@@ -1204,12 +1760,15 @@ module rv_core_pipelined #(
     // MMU
     .mmu_busy(mmu_busy),
     // Bus signals (Session 52 - fix CLINT/peripheral store hang)
-    .bus_req_valid(bus_req_valid),
-    .bus_req_ready(bus_req_ready),
+    .bus_req_valid(dbus_req_valid),
+    .bus_req_ready(dbus_req_ready),
+    // Store buffer
+    .sb_fence_stall(sb_fence_stall),
     // Outputs
     .stall_pc(stall_pc),
     .stall_ifid(stall_ifid),
-    .bubble_idex(flush_idex_hazard)
+    .bubble_idex(flush_idex_hazard),
+    .perf_stall_events(hpm_stall_events)
   );
 
   // ID/EX Pipeline Register
@@ -1283,6 +1842,10 @@ module rv_core_pipelined #(
     .instruction_in(ifid_instruction),
     // C extension input
     .is_compressed_in(ifid_is_compressed),
+    // Branch prediction inputs
+    .bp_taken_in(ifid_bp_taken),
+    .bp_target_in(ifid_bp_target),
+    .bp_meta_in(ifid_bp_meta),
     // Data outputs
     .pc_out(idex_pc),
     .rs1_data_out(idex_rs1_data),
@@ -1344,9 +1907,50 @@ module rv_core_pipelined #(
     .illegal_inst_out(idex_illegal_inst),
     .instruction_out(idex_instruction),
     // C extension output
-    .is_compressed_out(idex_is_compressed)
+    .is_compressed_out(idex_is_compressed),
+    // Branch prediction outputs
+    .bp_taken_out(idex_bp_taken),
+    .bp_target_out(idex_bp_target),
+    .bp_meta_out(idex_bp_meta)
   );
 
+  // Lane-1 ID/EX register: held and flushed together with lane 0
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      idex1_valid       <= 1'b0;
+      idex1_rd_addr     <= 5'h0;
+      idex1_rs1_addr    <= 5'h0;
+      idex1_rs2_addr    <= 5'h0;
+      idex1_rs1_data    <= {XLEN{1'b0}};
+      idex1_rs2_data    <= {XLEN{1'b0}};
+      idex1_imm         <= {XLEN{1'b0}};
+      idex1_alu_control <= 4'b0000;
+      idex1_alu_src     <= 1'b0;
+      idex1_opcode      <= 7'h0;
+      idex1_reg_write   <= 1'b0;
+    end else if (hold_exmem) begin
+      // Hold: lane 0 is stalled in EX, lane 1 waits with it
+    end else if (flush_idex) begin
+      idex1_valid       <= 1'b0;
+      idex1_rd_addr     <= 5'h0;
+      idex1_rs1_addr    <= 5'h0;
+      idex1_rs2_addr    <= 5'h0;
+      idex1_reg_write   <= 1'b0;
+    end else begin
+      idex1_valid       <= ifid1_valid;
+      idex1_rd_addr     <= id1_rd;
+      idex1_rs1_addr    <= id1_rs1;
+      idex1_rs2_addr    <= id1_rs2;
+      idex1_rs1_data    <= id1_rs1_data;
+      idex1_rs2_data    <= id1_rs2_data;
+      idex1_imm         <= id1_immediate;
+      idex1_alu_control <= id1_alu_control;
+      idex1_alu_src     <= id1_alu_src;
+      idex1_opcode      <= id1_opcode;
+      idex1_reg_write   <= id1_reg_write && ifid1_valid;
+    end
+  end
+
   //==========================================================================
   // EX STAGE: Execute
   //==========================================================================
@@ -1371,8 +1975,8 @@ module rv_core_pipelined #(
 
     // Pipeline stage write ports
     .idex_rd(idex_rd_addr),
-    .idex_reg_write(idex_reg_write),
-    .idex_is_atomic(idex_is_atomic),
+    .idex_reg_write(idex_reg_write && !idex_div_bg),  // Background divides write via long_op_unit
+    .idex_atomic_pending(idex_is_atomic && !(`ATOMIC_DONE_FORWARD && ex_atomic_done)),  // ATOMIC_DONE_FORWARD: forwardable once done
     .exmem_rd(exmem_rd_addr),
     .exmem_reg_write(exmem_reg_write),
     .exmem_int_reg_write_fp(exmem_int_reg_write_fp),
@@ -1381,6 +1985,31 @@ module rv_core_pipelined #(
     .memwb_int_reg_write_fp(memwb_int_reg_write_fp),
     .memwb_valid(memwb_valid),
 
+    // Dual issue: lane-1 producers and consumer
+    .idex1_rd(idex1_rd_addr),
+    .idex1_reg_write(idex1_reg_write && idex1_valid),
+    .exmem1_rd(exmem1_rd_addr),
+    .exmem1_reg_write(exmem1_reg_write && exmem1_valid),
+    .memwb1_rd(memwb1_rd_addr),
+    .memwb1_reg_write(memwb1_reg_write),
+    .memwb1_valid(memwb1_valid),
+    .id_forward_a_l1(id_forward_a_l1),
+    .id_forward_b_l1(id_forward_b_l1),
+    .forward_a_l1(forward_a_l1),
+    .forward_b_l1(forward_b_l1),
+    .id1_rs1(id1_rs1),
+    .id1_rs2(id1_rs2),
+    .idex1_rs1(idex1_rs1_addr),
+    .idex1_rs2(idex1_rs2_addr),
+    .id1_forward_a(id1_forward_a),
+    .id1_forward_b(id1_forward_b),
+    .id1_forward_a_l1(id1_forward_a_l1),
+    .id1_forward_b_l1(id1_forward_b_l1),
+    .forward1_a(forward1_a),
+    .forward1_b(forward1_b),
+    .forward1_a_l1(forward1_a_l1),
+    .forward1_b_l1(forward1_b_l1),
+
     // ID stage FP forwarding
     .id_fp_rs1(id_rs1),
     .id_fp_rs2(id_rs2),
@@ -1399,7 +2028,7 @@ module rv_core_pipelined #(
 
     // FP pipeline stage write ports
     .idex_fp_rd(idex_fp_rd_addr),
-    .idex_fp_reg_write(idex_fp_reg_write),
+    .idex_fp_reg_write(idex_fp_reg_write && !idex_fp_pipelined && !idex_fp_long),  // Written via port 2
     .exmem_fp_rd(exmem_fp_rd_addr),
     .exmem_fp_reg_write(exmem_fp_reg_write),
     .memwb_fp_rd(memwb_fp_rd_addr),
@@ -1416,8 +2045,8 @@ module rv_core_pipelined #(
   wire disable_forward_a = (idex_opcode == 7'b0110111) || (idex_opcode == 7'b0010111);  // LUI or AUIPC
 
   assign ex_alu_operand_a_forwarded = disable_forward_a ? ex_alu_operand_a :            // No forward for LUI/AUIPC
-                                      (forward_a == 2'b10) ? exmem_forward_data :       // EX hazard (includes FP-to-INT)
-                                      (forward_a == 2'b01) ? wb_data :                  // MEM hazard
+                                      (forward_a == 2'b10) ? ex_fwd_mem_a :             // EX hazard (includes FP-to-INT)
+                                      (forward_a == 2'b01) ? ex_fwd_wb_a :              // MEM hazard
                                       ex_alu_operand_a;                                  // No hazard
 
   `ifdef DEBUG_M_OPERANDS
@@ -1430,23 +2059,33 @@ module rv_core_pipelined #(
   `endif
 
   // Forward data selection: use atomic_result for atomic instructions, int_result_fp for FP-to-INT, mul_div_result for M-extension, alu_result otherwise
+  // With LOAD_USE_BYPASS the load data itself is forwarded, valid once the bus
+  // completes (EX and MEM are held until then). This chains bus read data, load
+  // alignment, this mux, the EX forwarding mux and the ALU into one cycle
   wire [XLEN-1:0] exmem_forward_data;
   assign exmem_forward_data = exmem_is_atomic ? exmem_atomic_result :
                               exmem_int_reg_write_fp ? exmem_int_result_fp :
                               (exmem_wb_sel == 3'b011) ? exmem_csr_rdata :  // CSR read result
                               (exmem_wb_sel == 3'b100) ? exmem_mul_div_result :  // M extension result
+                              (`LOAD_USE_BYPASS && exmem_wb_sel == 3'b001) ? mem_read_data :  // Load data (bypass)
                               exmem_alu_result;
 
+  // Forwarded stage values with the dual-issue lane select applied
+  wire [XLEN-1:0] ex_fwd_mem_a = forward_a_l1 ? exmem1_result : exmem_forward_data;
+  wire [XLEN-1:0] ex_fwd_wb_a  = forward_a_l1 ? memwb1_result : wb_data;
+  wire [XLEN-1:0] ex_fwd_mem_b = forward_b_l1 ? exmem1_result : exmem_forward_data;
+  wire [XLEN-1:0] ex_fwd_wb_b  = forward_b_l1 ? memwb1_result : wb_data;
+
   // rs1 data forwarding (for SFENCE.VMA and other instructions that use rs1 data directly)
   wire [XLEN-1:0] ex_rs1_data_forwarded;
-  assign ex_rs1_data_forwarded = (forward_a == 2'b10) ? exmem_forward_data :       // EX hazard
-                                  (forward_a == 2'b01) ? wb_data :                  // MEM hazard
+  assign ex_rs1_data_forwarded = (forward_a == 2'b10) ? ex_fwd_mem_a :             // EX hazard
+                                  (forward_a == 2'b01) ? ex_fwd_wb_a :              // MEM hazard
                                   idex_rs1_data;                                     // No hazard
 
   // ALU Operand B selection (with forwarding)
   wire [XLEN-1:0] ex_rs2_data_forwarded;
-  assign ex_rs2_data_forwarded = (forward_b == 2'b10) ? exmem_forward_data :       // EX hazard
-                                  (forward_b == 2'b01) ? wb_data :                  // MEM hazard
+  assign ex_rs2_data_forwarded = (forward_b == 2'b10) ? ex_fwd_mem_b :             // EX hazard
+                                  (forward_b == 2'b01) ? ex_fwd_wb_b :              // MEM hazard
                                   idex_rs2_data;                                     // No hazard
 
   `ifdef DEBUG_ATOMIC
@@ -1519,6 +2158,31 @@ module rv_core_pipelined #(
                                        {{32{ex_alu_result[31]}}, ex_alu_result[31:0]} :
                                        ex_alu_result;
 
+  // Lane-1 ALU (dual issue): LUI/AUIPC/OP-IMM/OP only, so no word-op handling
+  wire [XLEN-1:0] ex1_rs1_forwarded = (forward1_a == 2'b10) ? (forward1_a_l1 ? exmem1_result : exmem_forward_data) :
+                                      (forward1_a == 2'b01) ? (forward1_a_l1 ? memwb1_result : wb_data) :
+                                      idex1_rs1_data;
+  wire [XLEN-1:0] ex1_rs2_forwarded = (forward1_b == 2'b10) ? (forward1_b_l1 ? exmem1_result : exmem_forward_data) :
+                                      (forward1_b == 2'b01) ? (forward1_b_l1 ? memwb1_result : wb_data) :
+                                      idex1_rs2_data;
+
+  wire [XLEN-1:0] ex1_operand_a = (idex1_opcode == 7'b0010111) ? (idex_pc + {{(XLEN-3){1'b0}}, 3'b100}) :  // AUIPC (lane 1 is PC+4)
+                                  (idex1_opcode == 7'b0110111) ? {XLEN{1'b0}} :                            // LUI
+                                  ex1_rs1_forwarded;
+  wire [XLEN-1:0] ex1_operand_b = idex1_alu_src ? idex1_imm : ex1_rs2_forwarded;
+
+  alu #(
+    .XLEN(XLEN)
+  ) alu1_inst (
+    .operand_a(ex1_operand_a),
+    .operand_b(ex1_operand_b),
+    .alu_control(idex1_alu_control),
+    .result(ex1_result),
+    .zero(),
+    .less_than(),
+    .less_than_unsigned()
+  );
+
   // Debug: ALU output
   `ifdef DEBUG_ALU
   always @(posedge clk) begin
@@ -1574,13 +2238,13 @@ module rv_core_pipelined #(
       m_operand_a_latched <= {XLEN{1'b0}};
       m_operand_b_latched <= {XLEN{1'b0}};
       m_operands_valid <= 1'b0;
-    end else if (idex_is_mul_div && !ex_mul_div_busy && !m_operands_valid) begin
+    end else if (idex_is_mul_div_seq && !ex_mul_div_busy && !m_operands_valid) begin
       // Latch FORWARDED operands when M instruction first enters EX (before it starts execution)
       // This captures the correct forwarded values before they get polluted by subsequent instructions
       m_operand_a_latched <= ex_alu_operand_a_forwarded;
       m_operand_b_latched <= ex_rs2_data_forwarded;
       m_operands_valid <= 1'b1;
-    end else if (ex_mul_div_ready || !idex_is_mul_div) begin
+    end else if (ex_mul_div_ready || !idex_is_mul_div_seq) begin
       // Clear valid flag when M instruction completes OR when non-M instruction enters EX
       // This ensures back-to-back M instructions get fresh operands (Session 60)
       m_operands_valid <= 1'b0;
@@ -1602,11 +2266,52 @@ module rv_core_pipelined #(
     .is_word_op(idex_is_word_op),
     .operand_a(m_final_operand_a),
     .operand_b(m_final_operand_b),
-    .result(ex_mul_div_result),
+    .result(ex_mul_div_unit_result),
     .busy(ex_mul_div_busy),
     .ready(ex_mul_div_ready)
   );
 
+  // Pipelined multiplier: takes the forwarded operands directly (no latching,
+  // the instruction never waits in EX) and advances with the EX/MEM register
+  mul_pipelined #(
+    .XLEN(XLEN),
+    .STAGES(`MUL_STAGES)
+  ) m_pipe (
+    .clk(clk),
+    .reset_n(reset_n),
+    .stage1_en(!hold_exmem),
+    .mul_op(idex_mul_div_op[1:0]),
+    .is_word_op(idex_is_word_op),
+    .operand_a(ex_alu_operand_a_forwarded),
+    .operand_b(ex_rs2_data_forwarded),
+    .result(pmul_result)
+  );
+
+  // MUL_STAGES=1 finishes in EX; 2 and 3 finish in MEM / WB (see below)
+  assign ex_mul_div_result = (`MUL_STAGES == 1 && idex_mul_pipelined) ? pmul_result :
+                             ex_mul_div_unit_result;
+
+  // Track pipelined multiplies alongside the EX/MEM and MEM/WB registers
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      exmem_mul_pipelined <= 1'b0;
+      memwb_mul_pipelined <= 1'b0;
+    end else begin
+      if (trap_flush)
+        exmem_mul_pipelined <= 1'b0;
+      else if (!hold_exmem)
+        exmem_mul_pipelined <= idex_mul_pipelined && idex_valid;
+      memwb_mul_pipelined <= exmem_mul_pipelined;
+    end
+  end
+
+  // Dependent instructions are interlocked one cycle (hazard unit, like a
+  // load) so these late results are only ever forwarded from WB
+  assign exmem_mul_div_result_final = (`MUL_STAGES == 2 && exmem_mul_pipelined) ? pmul_result :
+                                      exmem_mul_div_result;
+  assign memwb_mul_div_result = (`MUL_STAGES == 3 && memwb_mul_pipelined) ? pmul_result :
+                                memwb_mul_div_result_reg;
+
   // A Extension - Atomic Operations Unit
   wire [XLEN-1:0] ex_atomic_result;
   wire            ex_atomic_done;
@@ -1617,6 +2322,9 @@ module rv_core_pipelined #(
   wire [XLEN-1:0] ex_atomic_mem_wdata;
   wire [2:0]      ex_atomic_mem_size;
   wire            ex_atomic_mem_ready;
+  wire            ex_atomic_mem_amo;
+  wire [4:0]      ex_atomic_mem_amo_op;
+  wire            ex_atomic_near;     // AMO target executes it (see Bus Master Interface)
 
   // A unit start signal: pulse once when A instruction first enters EX
   // Track if current atomic instruction in IDEX has already been executed
@@ -1667,6 +2375,9 @@ module rv_core_pipelined #(
     .mem_size(ex_atomic_mem_size),
     .mem_rdata(mem_read_data),
     .mem_ready(ex_atomic_mem_ready),
+    .mem_amo(ex_atomic_mem_amo),
+    .mem_amo_op(ex_atomic_mem_amo_op),
+    .near_mem(ex_atomic_near),
     // Reservation station interface
     .lr_valid(ex_lr_valid),
     .lr_addr(ex_lr_addr),
@@ -1724,8 +2435,10 @@ module rv_core_pipelined #(
   end
   `endif
 
+  // With coherent D-caches remote writes are seen as whole-line RdX snoops
   reservation_station #(
-    .XLEN(XLEN)
+    .XLEN(XLEN),
+    .REMOTE_GRANULE_BITS(`ENABLE_COHERENCY ? $clog2(`DCACHE_LINE_SIZE) : 0)
   ) reservation_station_inst (
     .clk(clk),
     .reset(!reset_n),
@@ -1736,6 +2449,8 @@ module rv_core_pipelined #(
     .sc_success(ex_sc_success),
     .invalidate(reservation_invalidate),
     .inv_addr(reservation_inv_addr),
+    .remote_invalidate(snoop_wr_valid),
+    .remote_addr(snoop_wr_addr),
     .exception(exception),
     .interrupt(1'b0)                // TODO: connect to interrupt signal when implemented
   );
@@ -1761,6 +2476,73 @@ module rv_core_pipelined #(
                           (ex_alu_operand_a_forwarded + idex_imm) & ~{{(XLEN-1){1'b0}}, 1'b1} :
                           idex_pc + idex_imm;
 
+  // Misprediction detection: compare the actual next PC against what IF predicted
+  // - Taken but predicted not-taken, or predicted to a different target (JALR)
+  // - Not taken (or not a branch at all) but predicted taken
+  // Predictor disabled: idex_bp_taken is always 0, so this reduces to ex_take_branch
+  wire [XLEN-1:0] ex_taken_target = idex_jump ? ex_jump_target : ex_branch_target;
+
+  assign ex_mispredict = idex_valid &&
+                         (ex_take_branch ? (!idex_bp_taken || (idex_bp_target != ex_taken_target)) :
+                                           idex_bp_taken);
+  assign ex_redirect_target = ex_take_branch ? ex_taken_target : ex_pc_plus_4;
+
+  // FENCE.I (Zifencei): stores older than the fence have reached MEM and are
+  // written to IMEM this cycle; invalidate the I-cache and refetch from PC+4
+  // so nothing fetched before the fence is executed
+  assign ex_fence_i  = idex_valid && (idex_opcode == 7'b0001111) && (idex_funct3 == 3'b001);
+  assign ex_redirect = ex_mispredict || ex_fence_i;
+
+  // Train predictor once per instruction, when it leaves EX
+  wire ex_bp_update = idex_valid && (idex_branch || idex_jump || ex_mispredict) &&
+                      !hold_exmem && !trap_flush;
+
+  // Call/return classification for the RAS (RISC-V link register hints: x1/x5)
+  // Covers C.JAL/C.JALR/C.JR, which rvc_decoder expands to JAL/JALR
+  // rd and rs1 both link: the same register is a call (push), different
+  // registers a coroutine swap (call and return: pop, then push)
+  wire ex_rd_is_link  = (idex_rd_addr == 5'd1) || (idex_rd_addr == 5'd5);
+  wire ex_rs1_is_link = (idex_rs1_addr == 5'd1) || (idex_rs1_addr == 5'd5);
+  wire ex_is_call = idex_jump && ex_rd_is_link;
+  wire ex_is_ret  = idex_jump && (idex_opcode == 7'b1100111) && ex_rs1_is_link &&
+                    (!ex_rd_is_link || (idex_rd_addr != idex_rs1_addr));
+
+  // Fetch advances to the predicted PC this cycle (speculative RAS push/pop)
+  wire if_bp_advance = !pc_stall_gated && !(trap_flush | mret_flush | sret_flush | ex_redirect);
+
+  branch_predictor #(
+    .XLEN(XLEN)
+  ) bpred (
+    .clk(clk),
+    .reset_n(reset_n),
+    // IF lookup
+    .if_pc(pc_current),
+    .pred_taken(if_bp_taken),
+    .pred_target(if_bp_target),
+    .pred_meta(if_bp_meta),
+    .if_advance(if_bp_advance),
+    .if_link_addr(pc_increment),
+    // EX resolution
+    .update_valid(ex_bp_update),
+    .update_pc(idex_pc),
+    .update_is_branch(idex_branch),
+    .update_is_jump(idex_jump),
+    .update_is_call(ex_is_call),
+    .update_is_ret(ex_is_ret),
+    .update_link_addr(ex_pc_plus_4),
+    .update_taken(ex_take_branch),
+    .update_target(ex_taken_target),
+    .update_meta(idex_bp_meta),
+    .update_mispredict(ex_mispredict),
+    // Trap/xRET: drop speculative RAS state
+    .flush_restore(trap_flush | mret_flush | sret_flush),
+    // Statistics
+    .stat_branches(),
+    .stat_branch_miss(),
+    .stat_jumps(),
+    .stat_jump_miss()
+  );
+
   //==========================================================================
   // CSR File (in EX stage for read/write)
   //==========================================================================
@@ -1773,8 +2555,9 @@ module rv_core_pipelined #(
   assign ex_csr_uses_rs1 = (idex_wb_sel == 3'b011) && !idex_csr_src;  // CSR instruction using rs1
 
   wire [XLEN-1:0] ex_csr_wdata_forwarded;
-  assign ex_csr_wdata_forwarded = (ex_csr_uses_rs1 && forward_a == 2'b10) ? exmem_alu_result :  // EX-to-EX forward
-                                  (ex_csr_uses_rs1 && forward_a == 2'b01) ? wb_data :           // MEM-to-EX forward
+  assign ex_csr_wdata_forwarded = (ex_csr_uses_rs1 && forward_a == 2'b10) ?                     // EX-to-EX forward
+                                    (forward_a_l1 ? exmem1_result : exmem_alu_result) :
+                                  (ex_csr_uses_rs1 && forward_a == 2'b01) ? ex_fwd_wb_a :       // MEM-to-EX forward
                                   idex_csr_wdata;                                                 // No hazard or imm form
 
   `ifdef DEBUG_PRIV
@@ -1813,8 +2596,21 @@ module rv_core_pipelined #(
   end
   `endif
 
+  // Bug #7b fix: Only accumulate flags for FP ALU operations, not FP loads
+  // FP loads have wb_sel=001 (memory data), FP ALU has other wb_sel values
+  // Bug #14 fix: Include FP→INT operations (fcvt.w.s, fclass, etc.)
+  wire wb_fflags_we = (memwb_fp_reg_write || memwb_int_reg_write_fp) && memwb_valid && (memwb_wb_sel != 3'b001);
+
+  // Performance monitor events (bit n-1 = HPM_EVENT_* n, rv_csr_defines.vh)
+  // A mispredicted branch is counted once, when it leaves EX
+  wire mmu_itlb_miss;
+  wire mmu_dtlb_miss;
+  wire [HPM_NUM_EVENTS-1:0] hpm_events = {mmu_dtlb_miss, mmu_itlb_miss, trap_flush,
+                                          ex_mispredict && !hold_exmem, hpm_stall_events};
+
   csr_file #(
-    .XLEN(XLEN)
+    .XLEN(XLEN),
+    .HART_ID(HART_ID)
   ) csr_file_inst (
     .clk(clk),
     .reset_n(reset_n),
@@ -1858,11 +2654,10 @@ module rv_core_pipelined #(
     // Floating-point CSR connections
     .frm_out(csr_frm),
     .fflags_out(csr_fflags),
-    // Bug #7b fix: Only accumulate flags for FP ALU operations, not FP loads
-    // FP loads have wb_sel=001 (memory data), FP ALU has other wb_sel values
-    // Bug #14 fix: Include FP→INT operations (fcvt.w.s, fclass, etc.)
-    .fflags_we((memwb_fp_reg_write || memwb_int_reg_write_fp) && memwb_valid && (memwb_wb_sel != 3'b001)),
-    .fflags_in({memwb_fp_flag_nv, memwb_fp_flag_dz, memwb_fp_flag_of, memwb_fp_flag_uf, memwb_fp_flag_nx}),
+    // Port 2 completions (FMA pipeline, FDIV/FSQRT) accumulate their flags in the same cycle
+    .fflags_we(wb_fflags_we || fp_wr2_en),
+    .fflags_in((wb_fflags_we ? {memwb_fp_flag_nv, memwb_fp_flag_dz, memwb_fp_flag_of, memwb_fp_flag_uf, memwb_fp_flag_nx} : 5'b0) |
+               (fp_wr2_en ? fp_wr2_flags : 5'b0)),
     // External interrupt inputs (Phase 1.3: CLINT + PLIC integration)
     .mtip_in(mtip_in),
     .msip_in(msip_in),
@@ -1871,7 +2666,11 @@ module rv_core_pipelined #(
     // Interrupt register outputs (Phase 1.5: Interrupt handling)
     .mip_out(mip),
     .mie_out(mie),
-    .mideleg_out(mideleg)
+    .mideleg_out(mideleg),
+    // Performance counters: every instruction leaving WB retires
+    .instret_inc({1'b0, memwb_valid} + {1'b0, memwb1_valid}),
+    .hpm_events(hpm_events),
+    .mtime_in(mtime_in)
   );
 
   // Alias for MMU integration
@@ -2060,6 +2859,13 @@ module rv_core_pipelined #(
   wire satp_mode_enabled = (XLEN == 32) ? csr_satp[31] : (csr_satp[63:60] != 4'b0000);
   wire translation_enabled = satp_mode_enabled && (current_priv != 2'b11);
 
+  // Load-use bypass eligibility: plain integer ALU ops (no M), plus loads and
+  // stores when translation is off (with translation on their EX address
+  // would start a TLB lookup before the bypassed load data is valid)
+  assign id_load_bypass_ok = ((id_opcode == 7'b0110011 || id_opcode == 7'b0111011) && !id_is_mul_div_dec) ||  // OP, OP-32
+                             (id_opcode == 7'b0010011) || (id_opcode == 7'b0011011) ||                        // OP-IMM, OP-IMM-32
+                             ((id_opcode == 7'b0000011 || id_opcode == 7'b0100011) && !translation_enabled);  // LOAD, STORE
+
   exception_unit #(
     .XLEN(XLEN)
   ) exception_unit_inst (
@@ -2171,6 +2977,206 @@ module rv_core_pipelined #(
   end
   `endif
 
+  // Pipelined FMA datapath: ops issue as they leave EX (committed, so they
+  // are never cancelled) and write back 3 cycles later through port 2
+  assign ex_commit     = idex_valid && !exception_taken_r && !hold_exmem &&
+                         !trap_flush && !mret_flush && !sret_flush;
+  assign fp_pipe_issue = idex_fp_pipelined && ex_commit;
+
+  generate
+    if (`FPU_PIPELINED != 0) begin : gen_fp_pipe
+      fp_fma_pipelined #(
+        .FLEN(`FLEN)
+      ) fp_pipe (
+        .clk(clk),
+        .reset_n(reset_n),
+        .valid_in(fp_pipe_issue),
+        .fp_alu_op(idex_fp_alu_op),
+        .fmt(idex_funct7[0]),
+        .rounding_mode(ex_fp_rounding_mode),
+        .rd_in(idex_fp_rd_addr),
+        .operand_a(ex_fp_operand_a),
+        .operand_b(ex_fp_operand_b),
+        .operand_c(ex_fp_operand_c),
+        .valid_out(fp_pipe_valid),
+        .rd_out(fp_pipe_rd),
+        .fmt_out(fp_pipe_fmt),
+        .result(fp_pipe_result),
+        .flag_nv(fp_pipe_flag_nv),
+        .flag_of(fp_pipe_flag_of),
+        .flag_uf(fp_pipe_flag_uf),
+        .flag_nx(fp_pipe_flag_nx)
+      );
+    end else begin : gen_no_fp_pipe
+      assign fp_pipe_valid   = 1'b0;
+      assign fp_pipe_rd      = 5'h0;
+      assign fp_pipe_fmt     = 1'b0;
+      assign fp_pipe_result  = {`FLEN{1'b0}};
+      assign fp_pipe_flag_nv = 1'b0;
+      assign fp_pipe_flag_of = 1'b0;
+      assign fp_pipe_flag_uf = 1'b0;
+      assign fp_pipe_flag_nx = 1'b0;
+    end
+  endgenerate
+
+  // Long-latency unit: DIV/REM, FDIV and FSQRT issue as they leave EX (same
+  // commit point as the FMA pipeline) and write back whenever they finish
+  assign long_int_issue = idex_div_bg && ex_commit;
+  assign long_fp_issue  = idex_fp_long && ex_commit;
+
+  generate
+    if (`NONBLOCKING_LONG_OPS != 0) begin : gen_long_op
+      long_op_unit #(
+        .XLEN(XLEN),
+        .FLEN(`FLEN)
+      ) long_op (
+        .clk(clk),
+        .reset_n(reset_n),
+        .int_issue(long_int_issue),
+        .int_op(idex_mul_div_op[1:0]),
+        .int_word(idex_is_word_op),
+        .int_a(ex_alu_operand_a_forwarded),
+        .int_b(ex_rs2_data_forwarded),
+        .int_rd(idex_rd_addr),
+        .int_busy(long_int_busy),
+        .int_wb_valid(long_int_wb_valid),
+        .int_wb_rd(long_int_wb_rd),
+        .int_wb_data(long_int_wb_data),
+        .int_wb_grant(long_int_wb_grant),
+        .fp_issue(long_fp_issue),
+        .fp_is_sqrt(idex_fp_alu_op == 5'b00100),
+        .fp_fmt(idex_funct7[0]),
+        .fp_rm(ex_fp_rounding_mode),
+        .fp_rd(idex_fp_rd_addr),
+        .fp_a(ex_fp_operand_a),
+        .fp_b(ex_fp_operand_b),
+        .fdiv_busy(long_fdiv_busy),
+        .fsqrt_busy(long_fsqrt_busy),
+        .fp_wb_valid(long_fp_wb_valid),
+        .fp_wb_rd(long_fp_wb_rd),
+        .fp_wb_fmt(long_fp_wb_fmt),
+        .fp_wb_data(long_fp_wb_data),
+        .fp_wb_flags(long_fp_wb_flags),
+        .fp_wb_grant(long_fp_wb_grant)
+      );
+    end else begin : gen_no_long_op
+      assign long_int_busy     = 1'b0;
+      assign long_int_wb_valid = 1'b0;
+      assign long_int_wb_rd    = 5'h0;
+      assign long_int_wb_data  = {XLEN{1'b0}};
+      assign long_fdiv_busy    = 1'b0;
+      assign long_fsqrt_busy   = 1'b0;
+      assign long_fp_wb_valid  = 1'b0;
+      assign long_fp_wb_rd     = 5'h0;
+      assign long_fp_wb_fmt    = 1'b0;
+      assign long_fp_wb_data   = {`FLEN{1'b0}};
+      assign long_fp_wb_flags  = 5'b0;
+    end
+  endgenerate
+
+  // FP write port 2: the FMA pipeline has a fixed latency and can't wait,
+  // so FDIV/FSQRT results are held in long_op_unit until the port is free
+  assign long_fp_wb_grant = long_fp_wb_valid && !fp_pipe_valid;
+  assign fp_wr2_en        = fp_pipe_valid || long_fp_wb_valid;
+  assign fp_wr2_rd        = fp_pipe_valid ? fp_pipe_rd     : long_fp_wb_rd;
+  assign fp_wr2_fmt       = fp_pipe_valid ? fp_pipe_fmt    : long_fp_wb_fmt;
+  assign fp_wr2_data      = fp_pipe_valid ? fp_pipe_result : long_fp_wb_data;
+  assign fp_wr2_flags     = fp_pipe_valid ? {fp_pipe_flag_nv, 1'b0, fp_pipe_flag_of, fp_pipe_flag_uf, fp_pipe_flag_nx}
+                                          : long_fp_wb_flags;
+
+  // Scoreboard: one busy bit per FP register, set at issue, cleared at completion
+  wire        idex_fp_bg         = idex_fp_pipelined || idex_fp_long;
+  wire [31:0] fp_pipe_done_mask  = fp_wr2_en ? (32'h1 << fp_wr2_rd) : 32'h0;
+  wire [31:0] fp_pipe_issue_mask = (fp_pipe_issue || long_fp_issue) ? (32'h1 << idex_fp_rd_addr) : 32'h0;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n)
+      fp_busy <= 32'h0;
+    else
+      fp_busy <= (fp_busy & ~fp_pipe_done_mask) | fp_pipe_issue_mask;
+  end
+
+  // Registers an ID instruction may not touch yet: in flight and not
+  // completing this cycle (completions write through to the read ports),
+  // plus the destination of a pipelined or long op still in EX
+  wire [31:0] fp_busy_id = (fp_busy & ~fp_pipe_done_mask) |
+                           ((idex_fp_bg && idex_valid) ? (32'h1 << idex_fp_rd_addr) : 32'h0);
+
+  // Which FP register fields the ID instruction uses (WAW on rd as well:
+  // a younger FP load or FPU op would otherwise be overwritten by the completion)
+  wire id_is_fma       = (id_opcode == 7'b1000011) || (id_opcode == 7'b1000111) ||
+                         (id_opcode == 7'b1001011) || (id_opcode == 7'b1001111);
+  wire id_is_op_fp     = (id_opcode == 7'b1010011);
+  wire id_fp_int_src   = (id_funct7[6:2] == 5'b11010) || (id_funct7[6:2] == 5'b11110);  // FCVT.*.W/L, FMV.*.X
+  wire id_fp_two_src   = (id_funct7[6:2] == 5'b00000) || (id_funct7[6:2] == 5'b00001) ||  // FADD/FSUB
+                         (id_funct7[6:2] == 5'b00010) || (id_funct7[6:2] == 5'b00011) ||  // FMUL/FDIV
+                         (id_funct7[6:2] == 5'b00100) || (id_funct7[6:2] == 5'b00101) ||  // FSGNJ/FMIN/FMAX
+                         (id_funct7[6:2] == 5'b10100);                                     // FEQ/FLT/FLE
+  wire id_reads_fp_rs1 = id_is_fma || (id_is_op_fp && !id_fp_int_src);
+  wire id_reads_fp_rs2 = id_is_fma || (id_opcode == 7'b0100111) || (id_is_op_fp && id_fp_two_src);
+  // OP-FP with an integer rd (FEQ/FLT/FLE, FCLASS, FCVT.W[U]/L[U], FMV.X.W) writes no FP register
+  wire id_writes_fp_rd = id_is_fma || (id_opcode == 7'b0000111) ||
+                         (id_is_op_fp && !id_int_reg_write_fp);
+
+  assign fp_sb_hazard = ifid_valid &&
+                        ((id_reads_fp_rs1 && fp_busy_id[id_rs1]) ||
+                         (id_reads_fp_rs2 && fp_busy_id[id_rs2]) ||
+                         (id_is_fma       && fp_busy_id[id_rs3]) ||
+                         (id_writes_fp_rd && fp_busy_id[id_rd]));
+
+  `ifdef DEBUG_FPU
+  always @(posedge clk) begin
+    if (fp_sb_hazard)
+      $display("[FP_SB] Stall: busy=%h rs1=f%0d rs2=f%0d rs3=f%0d rd=f%0d",
+               fp_busy_id, id_rs1, id_rs2, id_rs3, id_rd);
+  end
+  `endif
+
+  // Integer scoreboard for background divides: set at issue (x0 never),
+  // cleared when the result takes its write slot
+  wire [31:0] int_done_mask  = long_int_wb_grant ? (32'h1 << long_int_wb_rd) : 32'h0;
+  wire [31:0] int_issue_mask = long_int_issue ? (32'h1 << idex_rd_addr) : 32'h0;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n)
+      int_busy <= 32'h0;
+    else
+      int_busy <= ((int_busy & ~int_done_mask) | int_issue_mask) & 32'hFFFF_FFFE;
+  end
+
+  wire [31:0] int_busy_id = ((int_busy & ~int_done_mask) |
+                             ((idex_div_bg && idex_valid) ? (32'h1 << idex_rd_addr) : 32'h0)) &
+                            32'hFFFF_FFFE;
+
+  // Conservative source decode: every format but U/J reads rs1, R/S/B/AMO read
+  // rs2 (FP ops that read FP rs1 only cost a needless stall while a divide runs)
+  wire id_reads_int_rs1 = (id_opcode != 7'b0110111) && (id_opcode != 7'b0010111) &&   // LUI, AUIPC
+                          (id_opcode != 7'b1101111);                                    // JAL
+  wire id_reads_int_rs2 = (id_opcode == 7'b0110011) || (id_opcode == 7'b0111011) ||   // OP, OP-32
+                          (id_opcode == 7'b0100011) || (id_opcode == 7'b1100011) ||   // STORE, BRANCH
+                          (id_opcode == 7'b0101111);                                    // AMO
+
+  // Dual issue: the paired lane-1 ALU op is checked the same way
+  wire id1_reads_int_rs1 = (id1_opcode != 7'b0110111) && (id1_opcode != 7'b0010111);   // LUI, AUIPC
+  wire id1_reads_int_rs2 = (id1_opcode == 7'b0110011);                                  // OP
+
+  assign int_sb_hazard = (ifid_valid &&
+                          ((id_reads_int_rs1 && int_busy_id[id_rs1]) ||
+                           (id_reads_int_rs2 && int_busy_id[id_rs2]) ||
+                           ((id_reg_write || id_int_reg_write_fp) && int_busy_id[id_rd]))) ||
+                         (ifid1_valid &&
+                          ((id1_reads_int_rs1 && int_busy_id[id1_rs1]) ||
+                           (id1_reads_int_rs2 && int_busy_id[id1_rs2]) ||
+                           (id1_reg_write && int_busy_id[id1_rd])));
+
+  `ifdef DEBUG_DIV
+  always @(posedge clk) begin
+    if (int_sb_hazard)
+      $display("[INT_SB] Stall: busy=%h rs1=x%0d rs2=x%0d rd=x%0d",
+               int_busy_id, id_rs1, id_rs2, id_rd);
+  end
+  `endif
+
   // Store data paths: Separate integer and FP paths for RV32D support
   // Integer stores (SB, SH, SW, SD on RV64): Use forwarded integer rs2
   // FP stores (FSW, FSD): Use FP register data
@@ -2403,7 +3409,7 @@ module rv_core_pipelined #(
     .funct3_in(idex_funct3),
     .mem_read_in(idex_mem_read),
     .mem_write_in(idex_mem_write),
-    .reg_write_in(idex_reg_write),
+    .reg_write_in(idex_reg_write && !idex_div_bg),  // Background divides write via long_op_unit
     .wb_sel_in(idex_wb_sel),
     .valid_in(idex_valid && !exception_taken_r),  // Invalidate if exception occurred last cycle
     .mul_div_result_in(ex_mul_div_result),
@@ -2449,7 +3455,7 @@ module rv_core_pipelined #(
     .fp_result_in(ex_fp_result),
     .int_result_fp_in(ex_int_result_fp),
     .fp_rd_addr_in(idex_fp_rd_addr),
-    .fp_reg_write_in(idex_fp_reg_write),
+    .fp_reg_write_in(idex_fp_reg_write && !idex_fp_pipelined && !idex_fp_long),  // Written via port 2
     .int_reg_write_fp_in(idex_int_reg_write_fp),
     .fp_mem_op_in(idex_fp_mem_op),
     .fp_fmt_in(idex_fp_fmt),
@@ -2491,6 +3497,26 @@ module rv_core_pipelined #(
     .mmu_fault_vaddr_out(exmem_fault_vaddr)
   );
 
+  // Lane-1 EX/MEM register: killed when lane 0 redirects (lane 1 was the
+  // fall-through of a taken branch/jump) or on a trap, held with lane 0
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      exmem1_valid     <= 1'b0;
+      exmem1_rd_addr   <= 5'h0;
+      exmem1_reg_write <= 1'b0;
+      exmem1_result    <= {XLEN{1'b0}};
+    end else if (trap_flush && !hold_exmem) begin
+      exmem1_valid     <= 1'b0;
+      exmem1_rd_addr   <= 5'h0;
+      exmem1_reg_write <= 1'b0;
+    end else if (!hold_exmem) begin
+      exmem1_valid     <= idex1_valid && !exception_taken_r && !ex_redirect;
+      exmem1_rd_addr   <= idex1_rd_addr;
+      exmem1_reg_write <= idex1_reg_write;
+      exmem1_result    <= ex1_result;
+    end
+  end
+
   // Debug: EX/MEM FP register transfers
   `ifdef DEBUG_FPU_CONVERTER
   always @(posedge clk) begin
@@ -2600,6 +3626,9 @@ module rv_core_pipelined #(
   // WRITES: Write data latched immediately into memory array, takes 0 cycles
   //   Cycle N: mem_req=1, mem_we=1 (write happens)
   //   Cycle N: mem_ready=1 (write completes immediately)
+  // With a D-cache (or any slave with variable latency) the bus handshake decides:
+  // a read completes on the first bus_req_ready at least one cycle after the
+  // request, a write on bus_req_ready (identical timing with dmem_bus_adapter)
   reg ex_atomic_mem_read_r;
   always @(posedge clk or negedge reset_n) begin
     if (!reset_n) begin
@@ -2609,8 +3638,8 @@ module rv_core_pipelined #(
       ex_atomic_mem_read_r <= ex_atomic_mem_req && !ex_atomic_mem_we;
     end
   end
-  // Ready immediately for writes, delayed by 1 cycle for reads
-  assign ex_atomic_mem_ready = ex_atomic_mem_we ? 1'b1 : ex_atomic_mem_read_r;
+  // Ready on bus acknowledge for writes, at least 1 cycle later for reads
+  assign ex_atomic_mem_ready = dbus_req_ready && (ex_atomic_mem_we || ex_atomic_mem_read_r);
 
   //--------------------------------------------------------------------------
   // MMU: Virtual Memory Translation (Session 117: Add IF stage translation)
@@ -2629,7 +3658,7 @@ module rv_core_pipelined #(
 
   // IF stage MMU request (instruction fetch translation)
   assign if_mmu_req_valid = if_needs_translation;
-  assign if_mmu_req_vaddr = pc_current;
+  assign if_mmu_req_vaddr = if_fetch_vaddr;  // IF PC, or the fetch queue's run-ahead PC
 
   // EX stage MMU request (data access translation)
   assign ex_mmu_req_valid = ex_needs_translation && idex_valid;
@@ -2638,10 +3667,14 @@ module rv_core_pipelined #(
 
   // TLB flush control from SFENCE.VMA instruction
   // SFENCE.VMA in MEM stage: rs1 specifies vaddr, rs2 specifies ASID
-  // For now, implement simple flush: rs1=x0 && rs2=x0 => flush all
+  //   rs1=x0,  rs2=x0  => flush all (including global entries)
+  //   rs1!=x0          => flush that address
+  //   rs2!=x0          => only non-global entries of that ASID
   wire sfence_flush_all = exmem_is_sfence_vma && (exmem_rs1_addr == 5'h0) && (exmem_rs2_addr == 5'h0);
   wire sfence_flush_vaddr = exmem_is_sfence_vma && (exmem_rs1_addr != 5'h0);
+  wire sfence_flush_asid = exmem_is_sfence_vma && (exmem_rs2_addr != 5'h0);
   wire [XLEN-1:0] sfence_vaddr = exmem_rs1_data;  // rs1 data contains virtual address
+  wire [15:0] sfence_asid = exmem_mem_write_data[15:0];  // rs2 data (forwarded, as for stores)
 
   assign tlb_flush_all = sfence_flush_all;
   assign tlb_flush_vaddr = sfence_flush_vaddr;
@@ -2680,7 +3713,10 @@ module rv_core_pipelined #(
   dual_tlb_mmu #(
     .XLEN(XLEN),
     .ITLB_ENTRIES(8),   // 8-entry I-TLB for instruction fetch
-    .DTLB_ENTRIES(16)   // 16-entry D-TLB for data access (more frequent)
+    .DTLB_ENTRIES(16),  // 16-entry D-TLB for data access (more frequent)
+    .L2_TLB_ENTRIES(`L2_TLB_ENTRIES),
+    .L2_TLB_WAYS(`L2_TLB_WAYS),
+    .L2_TLB_SUPERPAGES(`L2_TLB_SUPERPAGES)
   ) dual_mmu_inst (
     .clk(clk),
     .reset_n(reset_n),
@@ -2702,6 +3738,9 @@ module rv_core_pipelined #(
     // Page table walk memory interface (shared PTW)
     .ptw_req_valid(mmu_ptw_req_valid),
     .ptw_req_addr(mmu_ptw_req_addr),
+    .ptw_req_we(mmu_ptw_req_we),
+    .ptw_req_wdata(mmu_ptw_req_wdata),
+    .ptw_rmw_lock(mmu_ptw_rmw_lock),
     .ptw_req_ready(mmu_ptw_req_ready),
     .ptw_resp_data(mmu_ptw_resp_data),
     .ptw_resp_valid(mmu_ptw_resp_valid),
@@ -2713,7 +3752,15 @@ module rv_core_pipelined #(
     // TLB flush control
     .tlb_flush_all(tlb_flush_all),
     .tlb_flush_vaddr(tlb_flush_vaddr),
-    .tlb_flush_addr(tlb_flush_addr)
+    .tlb_flush_addr(tlb_flush_addr),
+    .tlb_flush_asid(sfence_flush_asid),
+    .tlb_flush_asid_value(sfence_asid),
+    // L2 TLB statistics
+    .l2_tlb_hits(),
+    .l2_tlb_misses(),
+    // Miss events (performance counters)
+    .itlb_miss(mmu_itlb_miss),
+    .dtlb_miss(mmu_dtlb_miss)
   );
 
   // Memory Arbiter: Multiplex between CPU data access and MMU PTW
@@ -2735,11 +3782,34 @@ module rv_core_pipelined #(
   wire [XLEN-1:0] translated_addr = use_mmu_translation ? exmem_paddr : dmem_addr;
 
 
-  assign arb_mem_addr       = mmu_ptw_req_valid ? mmu_ptw_req_addr : translated_addr;
-  assign arb_mem_write_data = dmem_write_data;  // PTW never writes
-  assign arb_mem_read       = mmu_ptw_req_valid ? 1'b1 : dmem_mem_read;
-  assign arb_mem_write      = mmu_ptw_req_valid ? 1'b0 : dmem_mem_write;
-  assign arb_mem_funct3     = mmu_ptw_req_valid ? 3'b010 : dmem_funct3;  // PTW uses word access
+  // PTW writes only to set PTE.A/PTE.D (low word of the PTE)
+  wire [63:0] ptw_wdata64 = mmu_ptw_req_wdata;
+
+  // Bus ownership between the page walker and data accesses. A walk may run
+  // for either TLB while the pipeline keeps going (hit-under-miss), so it must
+  // not cut into a data transaction: the walker takes the bus only when no
+  // data transaction is open and no atomic sequence is running, and a
+  // MEM-stage access that needs the bus is held while the walker owns it.
+  reg  data_txn_open;
+  wire ptw_bus_grant = mmu_ptw_req_valid && !data_txn_open && !ex_atomic_busy;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      data_txn_open <= 1'b0;
+    end else if (dbus_req_ready) begin
+      data_txn_open <= 1'b0;
+    end else if (dbus_req_valid && !ptw_bus_grant) begin
+      data_txn_open <= 1'b1;
+    end
+  end
+
+  assign ptw_bus_conflict = ptw_bus_grant && (dmem_mem_read || dmem_mem_write);
+
+  assign arb_mem_addr       = ptw_bus_grant ? mmu_ptw_req_addr : translated_addr;
+  assign arb_mem_write_data = ptw_bus_grant ? ptw_wdata64 : dmem_write_data;
+  assign arb_mem_read       = ptw_bus_grant ? !mmu_ptw_req_we : dmem_mem_read;
+  assign arb_mem_write      = ptw_bus_grant ? mmu_ptw_req_we : dmem_mem_write;
+  assign arb_mem_funct3     = ptw_bus_grant ? 3'b010 : dmem_funct3;  // PTW uses word access
 
   // PTW ready protocol for registered memory (Session 115: PTW fix)
   // - Read latency: 1 cycle (same as dmem_bus_adapter)
@@ -2750,19 +3820,20 @@ module rv_core_pipelined #(
     if (!reset_n) begin
       ptw_read_in_progress_r <= 1'b0;
     end else begin
-      // Set when PTW issues a request, clear after 1 cycle
-      if (mmu_ptw_req_valid && !ptw_read_in_progress_r) begin
+      // Set when PTW issues a request, clear once the bus acknowledges
+      // (after 1 cycle with dmem_bus_adapter, longer on a D-cache miss)
+      if (ptw_bus_grant && !ptw_read_in_progress_r) begin
         ptw_read_in_progress_r <= 1'b1;
-      end else if (ptw_read_in_progress_r) begin
+      end else if (ptw_read_in_progress_r && dbus_req_ready) begin
         ptw_read_in_progress_r <= 1'b0;
       end
     end
   end
 
-  // PTW ready signal: NOT ready on first cycle, ready on second cycle
-  assign mmu_ptw_req_ready = ptw_read_in_progress_r;
-  // PTW response valid when data is ready (second cycle)
-  assign mmu_ptw_resp_valid = ptw_read_in_progress_r;
+  // PTW ready signal: NOT ready on first cycle, ready on second cycle (or later)
+  assign mmu_ptw_req_ready = ptw_read_in_progress_r && ptw_bus_grant && dbus_req_ready;
+  // PTW response valid when data is ready
+  assign mmu_ptw_resp_valid = ptw_read_in_progress_r && ptw_bus_grant && dbus_req_ready;
   assign mmu_ptw_resp_data = arb_mem_read_data;
 
   //--------------------------------------------------------------------------
@@ -2805,11 +3876,11 @@ module rv_core_pipelined #(
       bus_req_issued <= 1'b0;
     end else begin
       // Set: When we issue a write pulse (first time)
-      if (arb_mem_write_pulse && !bus_req_ready) begin
+      if (arb_mem_write_pulse && !dbus_req_ready) begin
         bus_req_issued <= 1'b1;
       end
       // Clear: When bus becomes ready OR instruction leaves MEM stage
-      else if (bus_req_ready || !exmem_valid) begin
+      else if (dbus_req_ready || !exmem_valid) begin
         bus_req_issued <= 1'b0;
       end
     end
@@ -2820,21 +3891,112 @@ module rv_core_pipelined #(
   // EXCEPTION: Atomic operations (LR/SC, AMO) need LEVEL signals for multi-cycle read-modify-write
   //            The atomic unit controls writes via ex_atomic_busy, so allow continuous writes
   // Session 40: Also check !bus_req_issued to prevent duplicate requests when bus not ready
-  wire arb_mem_write_pulse = mmu_ptw_req_valid ? 1'b0 :
+  // PTW A/D write: level signal like atomics (rewriting the same value is harmless)
+  // A store that reaches MEM while the page walker owns the bus keeps its pulse
+  // pending (store_pulse_deferred) and issues it once the walk releases the bus
+  reg store_pulse_deferred;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      store_pulse_deferred <= 1'b0;
+    end else if (!ptw_bus_grant || !exmem_valid) begin
+      store_pulse_deferred <= 1'b0;
+    end else if (mem_stage_new_instr && dmem_mem_write) begin
+      store_pulse_deferred <= 1'b1;
+    end
+  end
+
+  wire arb_mem_write_pulse = ptw_bus_grant ? mmu_ptw_req_we :
                              ex_atomic_busy ? dmem_mem_write :                       // Atomic: level signal
-                             (dmem_mem_write && mem_stage_new_instr && !bus_req_issued);  // Normal: one-shot pulse, not already issued
+                             (dmem_mem_write && (mem_stage_new_instr || store_pulse_deferred) &&
+                              !bus_req_issued);                                      // Normal: one-shot pulse, not already issued
 
   // Session 52: bus_req_valid must stay high until bus_req_ready to handle slow peripherals
   // When peripheral has registered req_ready (CLINT, UART), the pipeline stalls but we must
   // hold the request active until acknowledged, otherwise writes don't commit
-  assign bus_req_valid = arb_mem_read || arb_mem_write_pulse || bus_req_issued;
-  assign bus_req_addr  = arb_mem_addr;
-  assign bus_req_wdata = arb_mem_write_data;
-  assign bus_req_we    = arb_mem_write_pulse;
-  assign bus_req_size  = arb_mem_funct3;
+  assign dbus_req_valid = arb_mem_read || arb_mem_write_pulse || bus_req_issued;
+  assign dbus_req_addr  = arb_mem_addr;
+  assign dbus_req_wdata = arb_mem_write_data;
+  assign dbus_req_we    = arb_mem_write_pulse;
+  assign dbus_req_size  = arb_mem_funct3;
+
+  // Near-memory AMOs: an AMO to DMEM is a single read that carries the
+  // operation; dmem_bus_adapter writes the result in the read's second cycle.
+  // Not used with a D-cache or L2 (the update would bypass the cached copy),
+  // nor with BUS_PIPELINED (split_bus does not carry the AMO)
+  localparam NEAR_MEM_AMO = `ENABLE_NEAR_MEM_AMO && !`ENABLE_DCACHE && !`L2_CACHE_ENABLE &&
+                            !`BUS_PIPELINED;
+  // Built at XLEN width: with RV64 the mask must cover the upper address bits
+  localparam [XLEN-1:0] NEAR_AMO_BASE = {{(XLEN-32){1'b0}}, 32'h8000_0000};  // DMEM (see simple_bus.v)
+  localparam [XLEN-1:0] NEAR_AMO_MASK = {{(XLEN-32){1'b1}}, 32'hFFF0_0000};
+
+  assign ex_atomic_near  = NEAR_MEM_AMO && ((translated_addr & NEAR_AMO_MASK) == NEAR_AMO_BASE);
+  assign dbus_req_amo    = ex_atomic_mem_amo && !ptw_bus_grant;
+  assign dbus_req_amo_op = ex_atomic_mem_amo_op;
 
   // Bus read data feeds back to arbiter
-  assign arb_mem_read_data = bus_req_rdata;
+  assign arb_mem_read_data = dbus_req_rdata;
+
+  // Atomic read-modify-write: no other hart may use the bus between the read
+  // and the write (multi-hart SoC arbiter keeps this hart's grant). The same
+  // holds for the page walker's PTE read and A/D write-back; with coherent
+  // D-caches the lock keeps the PTE line exclusive and defers snoops to it
+  wire ptw_rmw_lock = ptw_bus_grant && mmu_ptw_rmw_lock;
+  assign bus_req_lock = ex_atomic_busy || ptw_rmw_lock;
+
+  //--------------------------------------------------------------------------
+  // Store Buffer (optional)
+  //--------------------------------------------------------------------------
+  // Stores to DMEM are acknowledged as soon as they are buffered and drain to
+  // the bus port in the background. MMIO and atomic accesses wait for the
+  // buffer to empty; FENCE/FENCE.I are held in EX until it has drained.
+  wire sb_drained;
+  wire ex_fence_any = idex_valid && (idex_opcode == 7'b0001111);
+  assign sb_fence_stall = ex_fence_any && !sb_drained;
+
+  generate
+    if (`ENABLE_STORE_BUFFER) begin : g_store_buffer
+      store_buffer #(
+        .XLEN(XLEN)
+      ) store_buf (
+        .clk(clk),
+        .reset_n(reset_n),
+        // MEM stage side
+        .req_valid(dbus_req_valid),
+        .req_addr(dbus_req_addr),
+        .req_wdata(dbus_req_wdata),
+        .req_we(dbus_req_we),
+        .req_size(dbus_req_size),
+        .req_ordered(ex_atomic_busy || ptw_rmw_lock),
+        .req_amo(dbus_req_amo),
+        .req_amo_op(dbus_req_amo_op),
+        .req_ready(dbus_req_ready),
+        .req_rdata(dbus_req_rdata),
+        .drained(sb_drained),
+        // Bus master port
+        .mem_req_valid(bus_req_valid),
+        .mem_req_addr(bus_req_addr),
+        .mem_req_wdata(bus_req_wdata),
+        .mem_req_we(bus_req_we),
+        .mem_req_size(bus_req_size),
+        .mem_req_amo(bus_req_amo),
+        .mem_req_amo_op(bus_req_amo_op),
+        .mem_req_ready(bus_req_ready),
+        .mem_req_rdata(bus_req_rdata)
+      );
+    end else begin : g_no_store_buffer
+      assign bus_req_valid  = dbus_req_valid;
+      assign bus_req_addr   = dbus_req_addr;
+      assign bus_req_wdata  = dbus_req_wdata;
+      assign bus_req_we     = dbus_req_we;
+      assign bus_req_size   = dbus_req_size;
+      assign bus_req_amo    = dbus_req_amo;
+      assign bus_req_amo_op = dbus_req_amo_op;
+      assign dbus_req_ready = bus_req_ready;
+      assign dbus_req_rdata = bus_req_rdata;
+      assign sb_drained     = 1'b1;
+    end
+  endgenerate
 
   //===========================================================================
   // Debug: Bus Transaction Tracing (Session 50 - MTIMECMP write bug)
@@ -2842,27 +4004,27 @@ module rv_core_pipelined #(
   `ifdef DEBUG_BUS
   always @(posedge clk) begin
     // Trace ALL bus transactions
-    if (bus_req_valid) begin
-      if (bus_req_we) begin
+    if (dbus_req_valid) begin
+      if (dbus_req_we) begin
         $display("[CORE-BUS-WR] Cycle %0d: addr=0x%08h wdata=0x%016h size=%0d valid=%b ready=%b | PC=%h",
-                 $time/10, bus_req_addr, bus_req_wdata, bus_req_size,
-                 bus_req_valid, bus_req_ready, exmem_pc);
+                 $time/10, dbus_req_addr, dbus_req_wdata, dbus_req_size,
+                 dbus_req_valid, dbus_req_ready, exmem_pc);
       end else begin
         $display("[CORE-BUS-RD] Cycle %0d: addr=0x%08h size=%0d valid=%b ready=%b rdata=0x%016h | PC=%h",
-                 $time/10, bus_req_addr, bus_req_size,
-                 bus_req_valid, bus_req_ready, bus_req_rdata, exmem_pc);
+                 $time/10, dbus_req_addr, dbus_req_size,
+                 dbus_req_valid, dbus_req_ready, dbus_req_rdata, exmem_pc);
       end
 
       // Specifically highlight CLINT range accesses (0x0200_0000 - 0x0200_FFFF)
-      if (bus_req_addr >= 32'h0200_0000 && bus_req_addr <= 32'h0200_FFFF) begin
-        $display("       *** CLINT ACCESS DETECTED *** offset=0x%04h", bus_req_addr[15:0]);
-        if (bus_req_addr >= 32'h0200_4000 && bus_req_addr <= 32'h0200_BFF7) begin
+      if (dbus_req_addr >= 32'h0200_0000 && dbus_req_addr <= 32'h0200_FFFF) begin
+        $display("       *** CLINT ACCESS DETECTED *** offset=0x%04h", dbus_req_addr[15:0]);
+        if (dbus_req_addr >= 32'h0200_4000 && dbus_req_addr <= 32'h0200_BFF7) begin
           $display("       *** MTIMECMP RANGE *** (should be 0x4000-0xBFF7)");
         end
-        if (bus_req_addr == 32'h0200_4000) begin
+        if (dbus_req_addr == 32'h0200_4000) begin
           $display("       *** MTIMECMP[0] LOWER 32-bit WRITE ***");
         end
-        if (bus_req_addr == 32'h0200_4004) begin
+        if (dbus_req_addr == 32'h0200_4004) begin
           $display("       *** MTIMECMP[0] UPPER 32-bit WRITE ***");
         end
       end
@@ -2895,7 +4057,7 @@ module rv_core_pipelined #(
     .reg_write_in(reg_write_gated),     // Gated to prevent write on exception
     .wb_sel_in(exmem_wb_sel),
     .valid_in(exmem_valid && !exception_from_mem && !hold_exmem),  // Mark invalid only on MEM-stage exception (preserve precise exceptions)
-    .mul_div_result_in(exmem_mul_div_result),
+    .mul_div_result_in(exmem_mul_div_result_final),
     .atomic_result_in(exmem_atomic_result),
     // F/D extension inputs
     .fp_result_in(exmem_fp_result),
@@ -2921,7 +4083,7 @@ module rv_core_pipelined #(
     .reg_write_out(memwb_reg_write),
     .wb_sel_out(memwb_wb_sel),
     .valid_out(memwb_valid),
-    .mul_div_result_out(memwb_mul_div_result),
+    .mul_div_result_out(memwb_mul_div_result_reg),
     .atomic_result_out(memwb_atomic_result),
     // F/D extension outputs
     .fp_result_out(memwb_fp_result),
@@ -2940,6 +4102,22 @@ module rv_core_pipelined #(
     .csr_we_out(memwb_csr_we)
   );
 
+  // Lane-1 MEM/WB register: advances with lane 0 and is dropped on the same
+  // MEM-stage exception, so a pair commits together or not at all
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      memwb1_valid     <= 1'b0;
+      memwb1_rd_addr   <= 5'h0;
+      memwb1_reg_write <= 1'b0;
+      memwb1_result    <= {XLEN{1'b0}};
+    end else begin
+      memwb1_valid     <= exmem1_valid && !exception_from_mem && !hold_exmem;
+      memwb1_rd_addr   <= exmem1_rd_addr;
+      memwb1_reg_write <= exmem1_reg_write;
+      memwb1_result    <= exmem1_result;
+    end
+  end
+
   // Debug: MEM/WB FP register transfers
   `ifdef DEBUG_FPU_CONVERTER
   always @(posedge clk) begin
@@ -3559,8 +4737,8 @@ module rv_core_pipelined #(
         $display("  PC=%08h rd=x%0d", exmem_pc, exmem_rd_addr);
         $display("  Address = %08h", exmem_alu_result);
         $display("  Bus request: valid=%b addr=%08h we=%b size=%b",
-                 bus_req_valid, bus_req_addr, bus_req_we, bus_req_size);
-        $display("  Bus response: ready=%b rdata=%016h", bus_req_ready, bus_req_rdata);
+                 dbus_req_valid, dbus_req_addr, dbus_req_we, dbus_req_size);
+        $display("  Bus response: ready=%b rdata=%016h", dbus_req_ready, dbus_req_rdata);
         $display("  mem_read_data (after arbitration) = %08h", mem_read_data);
         $display("  funct3=%b (load size/sign)", exmem_funct3);
       end
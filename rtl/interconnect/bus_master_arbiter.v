@@ -0,0 +1,156 @@
+// bus_master_arbiter.v - Multi-Master Arbiter for simple_bus
+// Shares the simple_bus master port between several harts (one port per
+// core, after its optional D-cache)
+// Author: RV1 Project
+// Date: 2026-10-16
+//
+// Features:
+// - Round-robin between requesting masters; masters in QOS_HIGH are served
+//   before the others (round-robin within each class)
+// - A granted master keeps the bus until its transaction completes (request
+//   held until ready, as in the simple_bus protocol) and for as long as it
+//   asserts req_lock (atomic read-modify-write sequences)
+// - Write pulses are not lost while waiting: the core drops req_we after the
+//   first cycle of a held store (so slow peripherals see each store once);
+//   a store that arrives while another master owns the bus has its write
+//   cycle replayed in its first granted cycle
+// - Write snoop output (address and writing master) so every hart can drop
+//   LR reservations on stores from the other harts; near-memory AMOs (reads
+//   with req_amo) write memory and are snooped as well
+
+`include "config/rv_config.vh"
+
+module bus_master_arbiter #(
+  parameter XLEN        = `XLEN,
+  parameter NUM_MASTERS = 1,
+  parameter [NUM_MASTERS-1:0] QOS_HIGH = {NUM_MASTERS{1'b0}}
+) (
+  input  wire                        clk,
+  input  wire                        reset_n,
+
+  // Master ports (one per hart)
+  input  wire [NUM_MASTERS-1:0]      m_req_valid,
+  input  wire [NUM_MASTERS*XLEN-1:0] m_req_addr,
+  input  wire [NUM_MASTERS*64-1:0]   m_req_wdata,
+  input  wire [NUM_MASTERS-1:0]      m_req_we,
+  input  wire [NUM_MASTERS*3-1:0]    m_req_size,
+  input  wire [NUM_MASTERS-1:0]      m_req_lock,
+  input  wire [NUM_MASTERS-1:0]      m_req_amo,
+  input  wire [NUM_MASTERS*5-1:0]    m_req_amo_op,
+  output reg  [NUM_MASTERS-1:0]      m_req_ready,
+  output wire [63:0]                 m_req_rdata,   // Shared; valid with m_req_ready
+
+  // Bus master port (to simple_bus)
+  output reg                         bus_req_valid,
+  output reg  [XLEN-1:0]             bus_req_addr,
+  output reg  [63:0]                 bus_req_wdata,
+  output reg                         bus_req_we,
+  output reg  [2:0]                  bus_req_size,
+  output reg                         bus_req_amo,
+  output reg  [4:0]                  bus_req_amo_op,
+  input  wire                        bus_req_ready,
+  input  wire [63:0]                 bus_req_rdata,
+
+  // Write snoop (a write is being performed on the bus)
+  output wire                        snoop_valid,
+  output wire [XLEN-1:0]             snoop_addr,
+  output wire [31:0]                 snoop_master
+);
+
+  integer k, c;  // grant search
+  integer w;     // pending-write update
+
+  //===========================================================================
+  // Grant
+  //===========================================================================
+
+  reg [31:0]            owner;        // Master granted last cycle
+  reg                   owner_held;   // Its transaction or lock was still open
+  reg [31:0]            rr_next;      // First master to consider next time
+  reg [NUM_MASTERS-1:0] we_pending;   // Store waiting for the bus
+
+  reg        gnt_valid;
+  reg [31:0] gnt;
+  reg        gnt_we;
+
+  always @(*) begin
+    gnt_valid = 1'b0;
+    gnt       = 0;
+
+    if (owner_held && (m_req_valid[owner] || m_req_lock[owner])) begin
+      // Transaction in progress or locked sequence: keep the owner
+      gnt_valid = 1'b1;
+      gnt       = owner;
+    end else begin
+      // High-QoS masters first, then everyone, each round-robin from rr_next
+      for (k = 0; k < NUM_MASTERS; k = k + 1) begin
+        c = (rr_next + k) % NUM_MASTERS;
+        if (!gnt_valid && m_req_valid[c] && QOS_HIGH[c]) begin
+          gnt_valid = 1'b1;
+          gnt       = c;
+        end
+      end
+      for (k = 0; k < NUM_MASTERS; k = k + 1) begin
+        c = (rr_next + k) % NUM_MASTERS;
+        if (!gnt_valid && m_req_valid[c]) begin
+          gnt_valid = 1'b1;
+          gnt       = c;
+        end
+      end
+    end
+
+    gnt_we = m_req_we[gnt] || we_pending[gnt];
+
+    bus_req_valid = gnt_valid && m_req_valid[gnt];
+    bus_req_addr  = m_req_addr[gnt*XLEN +: XLEN];
+    bus_req_wdata = m_req_wdata[gnt*64 +: 64];
+    bus_req_we    = gnt_we;
+    bus_req_size  = m_req_size[gnt*3 +: 3];
+    bus_req_amo   = gnt_valid && m_req_amo[gnt];
+    bus_req_amo_op = m_req_amo_op[gnt*5 +: 5];
+
+    m_req_ready = {NUM_MASTERS{1'b0}};
+    if (gnt_valid)
+      m_req_ready[gnt] = bus_req_ready;
+  end
+
+  assign m_req_rdata = bus_req_rdata;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      owner      <= 0;
+      owner_held <= 1'b0;
+      rr_next    <= 0;
+      we_pending <= {NUM_MASTERS{1'b0}};
+    end else begin
+      owner      <= gnt;
+      owner_held <= gnt_valid && ((m_req_valid[gnt] && !bus_req_ready) || m_req_lock[gnt]);
+      if (gnt_valid && m_req_valid[gnt] && bus_req_ready)
+        rr_next <= (gnt + 1) % NUM_MASTERS;
+
+      for (w = 0; w < NUM_MASTERS; w = w + 1) begin
+        if (!m_req_valid[w] || (gnt_valid && gnt == w))
+          we_pending[w] <= 1'b0;
+        else if (m_req_we[w])
+          we_pending[w] <= 1'b1;
+      end
+    end
+  end
+
+  //===========================================================================
+  // Write Snoop
+  //===========================================================================
+
+  assign snoop_valid  = bus_req_valid && (bus_req_we || bus_req_amo);
+  assign snoop_addr   = bus_req_addr;
+  assign snoop_master = gnt;
+
+  `ifdef DEBUG_BUS
+  always @(posedge clk) begin
+    if (bus_req_valid && bus_req_ready)
+      $display("[BUS_ARB] Cycle %0d: master %0d addr=0x%08h we=%b lock=%b",
+               $time/10, gnt, bus_req_addr, bus_req_we, m_req_lock[gnt]);
+  end
+  `endif
+
+endmodule
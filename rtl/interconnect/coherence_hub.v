@@ -0,0 +1,139 @@
+// coherence_hub.v - Snoop Controller for MESI D-Caches
+// Serializes line acquires of the per-core D-caches (dcache.v, COHERENT=1)
+// and broadcasts each one as a snoop to the other caches
+// Author: RV1 Project
+// Date: 2026-10-16
+//
+// Features:
+// - One acquire in flight at a time, picked round-robin among the caches
+// - Rd (shared) / RdX (exclusive) snoop sent to every other cache; each answers
+//   with snp_ack once it has written back an M copy and downgraded (Rd) or
+//   dropped (RdX) its line. snp_hit reports a copy kept, so the requester
+//   installs S instead of E
+// - The grant is held until the requester drops acq_valid (its write-back,
+//   refill and install are done), so a line never changes hands mid-refill.
+//   Write-backs of snooped caches use the normal data bus, which is free
+//   because the requester issues nothing until granted
+// - snp_valid/snp_addr/snp_excl double as the cross-hart reservation
+//   invalidation: an RdX means another hart is about to write the line
+
+`include "config/rv_config.vh"
+
+module coherence_hub #(
+  parameter XLEN       = `XLEN,
+  parameter NUM_CACHES = 1
+) (
+  input  wire                       clk,
+  input  wire                       reset_n,
+
+  // Acquire requests (one per cache)
+  input  wire [NUM_CACHES-1:0]      acq_valid,
+  input  wire [NUM_CACHES*XLEN-1:0] acq_addr,
+  input  wire [NUM_CACHES-1:0]      acq_excl,
+  output reg  [NUM_CACHES-1:0]      acq_grant,
+  output wire                       acq_shared,
+
+  // Snoops (one per cache, never to the requester)
+  output reg  [NUM_CACHES-1:0]      snp_valid,
+  output wire [XLEN-1:0]            snp_addr,
+  output wire                       snp_excl,
+  input  wire [NUM_CACHES-1:0]      snp_ack,
+  input  wire [NUM_CACHES-1:0]      snp_hit
+);
+
+  localparam H_IDLE  = 2'd0;
+  localparam H_SNOOP = 2'd1;  // Waiting for every other cache to answer
+  localparam H_GRANT = 2'd2;  // Requester owns the line until it drops acq_valid
+
+  reg [1:0]            state;
+  reg [31:0]           cur;          // Requesting cache
+  reg [XLEN-1:0]       cur_addr;
+  reg                  cur_excl;
+  reg [NUM_CACHES-1:0] acked;
+  reg                  shared;
+  reg [31:0]           rr_next;
+
+  assign snp_addr   = cur_addr;
+  assign snp_excl   = cur_excl;
+  assign acq_shared = shared;
+
+  integer k, c;  // request pick
+  reg        pick_valid;
+  reg [31:0] pick;
+
+  always @(*) begin
+    pick_valid = 1'b0;
+    pick       = 0;
+    for (k = 0; k < NUM_CACHES; k = k + 1) begin
+      c = (rr_next + k) % NUM_CACHES;
+      if (!pick_valid && acq_valid[c]) begin
+        pick_valid = 1'b1;
+        pick       = c;
+      end
+    end
+  end
+
+  integer g;  // outputs
+  always @(*) begin
+    acq_grant = {NUM_CACHES{1'b0}};
+    snp_valid = {NUM_CACHES{1'b0}};
+    for (g = 0; g < NUM_CACHES; g = g + 1) begin
+      if (state == H_GRANT && cur == g)
+        acq_grant[g] = 1'b1;
+      if (state == H_SNOOP && !acked[g])
+        snp_valid[g] = 1'b1;
+    end
+  end
+
+  wire [NUM_CACHES-1:0] acked_next = acked | (snp_valid & snp_ack);
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      state    <= H_IDLE;
+      cur      <= 0;
+      cur_addr <= {XLEN{1'b0}};
+      cur_excl <= 1'b0;
+      acked    <= {NUM_CACHES{1'b0}};
+      shared   <= 1'b0;
+      rr_next  <= 0;
+    end else begin
+      case (state)
+        H_IDLE: begin
+          if (pick_valid) begin
+            cur      <= pick;
+            cur_addr <= acq_addr[pick*XLEN +: XLEN];
+            cur_excl <= acq_excl[pick];
+            acked    <= {{(NUM_CACHES-1){1'b0}}, 1'b1} << pick;  // Requester is not snooped
+            shared   <= 1'b0;
+            state    <= H_SNOOP;
+          end
+        end
+
+        H_SNOOP: begin
+          acked  <= acked_next;
+          shared <= shared | (|(snp_valid & snp_ack & snp_hit));
+          if (&acked_next)
+            state <= H_GRANT;
+        end
+
+        H_GRANT: begin
+          if (!acq_valid[cur]) begin
+            rr_next <= (cur + 1) % NUM_CACHES;
+            state   <= H_IDLE;
+          end
+        end
+
+        default: state <= H_IDLE;
+      endcase
+    end
+  end
+
+  `ifdef DEBUG_COHERENCE
+  always @(posedge clk) begin
+    if (state == H_IDLE && pick_valid)
+      $display("[COHERENCE] Cycle %0d: cache %0d %s line 0x%08h", $time/10, pick,
+               acq_excl[pick] ? "RdX" : "Rd", acq_addr[pick*XLEN +: XLEN]);
+  end
+  `endif
+
+endmodule
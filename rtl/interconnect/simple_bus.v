@@ -2,6 +2,7 @@
 // Priority-based address decoder for RV1 SoC peripherals
 // Author: RV1 Project
 // Date: 2025-10-27
+// Updated: 2026-10-16 - Near-memory AMO sideband (master_req_amo) routed to DMEM
 //
 // Memory Map:
 //   0x0000_0000 - 0x0000_FFFF: IMEM (64KB) - read-only via bus for .rodata copy
@@ -16,6 +17,9 @@
 // - Priority-based address decoding
 // - Single-cycle response (all peripherals respond in 1 cycle)
 // - Supports byte/half/word/double accesses
+// - Near-memory AMOs reach DMEM only; the core never marks other targets
+//
+// For multiple masters with overlapping (split) transactions, see split_bus.v
 
 `include "rv_config.vh"
 
@@ -33,6 +37,8 @@ module simple_bus #(
   input  wire [63:0]      master_req_wdata,
   input  wire             master_req_we,
   input  wire [2:0]       master_req_size,     // 0=byte, 1=half, 2=word, 3=double
+  input  wire             master_req_amo,      // Near-memory AMO (read-modify-write)
+  input  wire [4:0]       master_req_amo_op,   // AMO funct5
   output reg              master_req_ready,
   output reg  [63:0]      master_req_rdata,
 
@@ -65,6 +71,8 @@ module simple_bus #(
   output reg  [63:0]      dmem_req_wdata,
   output reg              dmem_req_we,
   output reg  [2:0]       dmem_req_size,
+  output reg              dmem_req_amo,
+  output reg  [4:0]       dmem_req_amo_op,
   input  wire             dmem_req_ready,
   input  wire [63:0]      dmem_req_rdata,
 
@@ -150,6 +158,9 @@ module simple_bus #(
     clint_req_size  = 3'h0;
     dmem_req_size   = 3'h0;
 
+    dmem_req_amo    = 1'b0;
+    dmem_req_amo_op = 5'h0;
+
     // Route request to selected slave
     if (master_req_valid) begin
       if (sel_imem) begin
@@ -180,6 +191,8 @@ module simple_bus #(
         dmem_req_wdata = master_req_wdata;
         dmem_req_we    = master_req_we;
         dmem_req_size  = master_req_size;
+        dmem_req_amo    = master_req_amo;
+        dmem_req_amo_op = master_req_amo_op;
       end
       // If sel_none, no slave selected → ready will be 0, rdata will be 0
     end
@@ -0,0 +1,299 @@
+// split_bus.v - Pipelined Split-Transaction Bus Interconnect
+// Multi-master, multi-slave crossbar with separate request (address) and
+// response (data) phases for RV1 SoC masters that overlap their accesses
+// Author: RV1 Project
+// Date: 2026-10-16
+// Updated: 2026-10-16 - ID width / outstanding limit are plain parameters
+// Updated: 2026-10-16 - Instantiated by rv_soc with BUS_PIPELINED=1
+//                       (hart ports attach through split_bus_master.v)
+//
+// Features:
+// - NUM_MASTERS masters, NUM_SLAVES slaves, address map from SLAVE_BASE/SLAVE_MASK
+//   (slave i owns 32-bit slice i; the lowest matching slave wins, as in simple_bus)
+// - Request and response channels each use valid/ready backpressure, per master
+//   and per slave
+// - Transactions carry an ID: masters tag requests with ID_WIDTH bits, slaves see
+//   {master index, tag} and must echo it on the response
+// - Up to MAX_OUTSTANDING transactions per master; different slaves may answer
+//   out of order, masters match responses by ID
+// - Round-robin request arbitration per slave and response arbitration per
+//   master; a granted request or response stays granted until accepted
+// - Unmapped addresses get an error response from the bus itself (resp_err=1,
+//   rdata=0) so a master never hangs
+//
+// Slaves that follow the simple_bus protocol (valid held until ready) attach
+// through split_bus_bridge.v; DMEM has a native pipelined port
+// (dmem_split_adapter.v) that accepts one request per cycle.
+
+`include "config/rv_config.vh"
+
+module split_bus #(
+  parameter XLEN            = `XLEN,
+  parameter NUM_MASTERS     = 2,
+  parameter NUM_SLAVES      = 5,
+  parameter ID_WIDTH        = 4,   // Tag bits per master
+  parameter MAX_OUTSTANDING = 4,   // Transactions in flight per master
+  // Default map: IMEM, CLINT, PLIC, UART, DMEM (same ranges as simple_bus.v)
+  parameter [NUM_SLAVES*32-1:0] SLAVE_BASE = {32'h8000_0000, 32'h1000_0000, 32'h0C00_0000,
+                                              32'h0200_0000, 32'h0000_0000},
+  parameter [NUM_SLAVES*32-1:0] SLAVE_MASK = {32'hFFF0_0000, 32'hFFFF_F000, 32'hFC00_0000,
+                                              32'hFFFF_0000, 32'hFFFF_0000},
+  // Width of the master index prepended to slave-side IDs
+  parameter MI_WIDTH        = (NUM_MASTERS > 1) ? $clog2(NUM_MASTERS) : 1,
+  parameter SID_WIDTH       = ID_WIDTH + MI_WIDTH
+) (
+  input  wire                            clk,
+  input  wire                            reset_n,
+
+  //===========================================================================
+  // Master Ports (request channel)
+  //===========================================================================
+  input  wire [NUM_MASTERS-1:0]          m_req_valid,
+  output reg  [NUM_MASTERS-1:0]          m_req_ready,
+  input  wire [NUM_MASTERS*ID_WIDTH-1:0] m_req_id,
+  input  wire [NUM_MASTERS*XLEN-1:0]     m_req_addr,
+  input  wire [NUM_MASTERS*64-1:0]       m_req_wdata,
+  input  wire [NUM_MASTERS-1:0]          m_req_we,
+  input  wire [NUM_MASTERS*3-1:0]        m_req_size,
+
+  //===========================================================================
+  // Master Ports (response channel)
+  //===========================================================================
+  output reg  [NUM_MASTERS-1:0]          m_resp_valid,
+  input  wire [NUM_MASTERS-1:0]          m_resp_ready,
+  output reg  [NUM_MASTERS*ID_WIDTH-1:0] m_resp_id,
+  output reg  [NUM_MASTERS*64-1:0]       m_resp_rdata,
+  output reg  [NUM_MASTERS-1:0]          m_resp_err,
+
+  //===========================================================================
+  // Slave Ports (request channel)
+  //===========================================================================
+  output reg  [NUM_SLAVES-1:0]           s_req_valid,
+  input  wire [NUM_SLAVES-1:0]           s_req_ready,
+  output reg  [NUM_SLAVES*SID_WIDTH-1:0] s_req_id,
+  output reg  [NUM_SLAVES*XLEN-1:0]      s_req_addr,
+  output reg  [NUM_SLAVES*64-1:0]        s_req_wdata,
+  output reg  [NUM_SLAVES-1:0]           s_req_we,
+  output reg  [NUM_SLAVES*3-1:0]         s_req_size,
+
+  //===========================================================================
+  // Slave Ports (response channel)
+  //===========================================================================
+  input  wire [NUM_SLAVES-1:0]           s_resp_valid,
+  output reg  [NUM_SLAVES-1:0]           s_resp_ready,
+  input  wire [NUM_SLAVES*SID_WIDTH-1:0] s_resp_id,
+  input  wire [NUM_SLAVES*64-1:0]        s_resp_rdata
+);
+
+  localparam CNT_WIDTH = $clog2(MAX_OUTSTANDING + 1);
+
+  // Loop variables, one set per always block
+  integer dm, ds;          // decode
+  integer rm, rs, rk, rc;  // request arbitration
+  integer pm, pk, pc;      // response arbitration
+  integer qm, qs;          // state update
+  integer gm;              // debug
+
+  //===========================================================================
+  // Address Decode and Outstanding Limit
+  //===========================================================================
+
+  reg [CNT_WIDTH-1:0] outstanding [0:NUM_MASTERS-1];
+  reg                 m_mapped    [0:NUM_MASTERS-1];
+  reg [31:0]          m_slave     [0:NUM_MASTERS-1];
+  reg                 m_room      [0:NUM_MASTERS-1];
+
+  always @(*) begin
+    for (dm = 0; dm < NUM_MASTERS; dm = dm + 1) begin
+      m_mapped[dm] = 1'b0;
+      m_slave[dm]  = 0;
+      for (ds = NUM_SLAVES - 1; ds >= 0; ds = ds - 1) begin
+        if ((m_req_addr[dm*XLEN +: 32] & SLAVE_MASK[ds*32 +: 32]) == SLAVE_BASE[ds*32 +: 32]) begin
+          m_mapped[dm] = 1'b1;
+          m_slave[dm]  = ds;
+        end
+      end
+      m_room[dm] = (outstanding[dm] < MAX_OUTSTANDING);
+    end
+  end
+
+  //===========================================================================
+  // Request Arbitration (per slave, round-robin over masters)
+  //===========================================================================
+
+  reg [31:0] req_rr      [0:NUM_SLAVES-1];  // Master with highest priority next
+  reg        req_lock    [0:NUM_SLAVES-1];  // Presented request not yet accepted
+  reg [31:0] req_lock_m  [0:NUM_SLAVES-1];
+  reg        req_gnt     [0:NUM_SLAVES-1];
+  reg [31:0] req_gnt_m   [0:NUM_SLAVES-1];
+
+  // Bus-generated error responses (one slot per master)
+  reg                err_valid [0:NUM_MASTERS-1];
+  reg [ID_WIDTH-1:0] err_id    [0:NUM_MASTERS-1];
+
+  always @(*) begin
+    for (rs = 0; rs < NUM_SLAVES; rs = rs + 1) begin
+      req_gnt[rs]   = 1'b0;
+      req_gnt_m[rs] = 0;
+      if (req_lock[rs]) begin
+        req_gnt[rs]   = 1'b1;
+        req_gnt_m[rs] = req_lock_m[rs];
+      end else begin
+        for (rk = 0; rk < NUM_MASTERS; rk = rk + 1) begin
+          rc = (req_rr[rs] + rk) % NUM_MASTERS;
+          if (!req_gnt[rs] && m_req_valid[rc] && m_mapped[rc] && m_slave[rc] == rs && m_room[rc]) begin
+            req_gnt[rs]   = 1'b1;
+            req_gnt_m[rs] = rc;
+          end
+        end
+      end
+
+      s_req_valid[rs]                         = req_gnt[rs];
+      s_req_id[rs*SID_WIDTH +: SID_WIDTH]     = {req_gnt_m[rs][MI_WIDTH-1:0],
+                                                m_req_id[req_gnt_m[rs]*ID_WIDTH +: ID_WIDTH]};
+      s_req_addr[rs*XLEN +: XLEN]             = m_req_addr[req_gnt_m[rs]*XLEN +: XLEN];
+      s_req_wdata[rs*64 +: 64]                = m_req_wdata[req_gnt_m[rs]*64 +: 64];
+      s_req_we[rs]                            = m_req_we[req_gnt_m[rs]];
+      s_req_size[rs*3 +: 3]                   = m_req_size[req_gnt_m[rs]*3 +: 3];
+    end
+
+    for (rm = 0; rm < NUM_MASTERS; rm = rm + 1) begin
+      if (m_mapped[rm])
+        m_req_ready[rm] = req_gnt[m_slave[rm]] && (req_gnt_m[m_slave[rm]] == rm) &&
+                         s_req_ready[m_slave[rm]];
+      else
+        m_req_ready[rm] = m_room[rm] && !err_valid[rm];
+    end
+  end
+
+  //===========================================================================
+  // Response Arbitration (per master, round-robin over slaves)
+  //===========================================================================
+
+  reg [31:0] resp_rr     [0:NUM_MASTERS-1];  // Slave with highest priority next
+  reg        resp_lock   [0:NUM_MASTERS-1];  // Presented response not yet accepted
+  reg [31:0] resp_lock_s [0:NUM_MASTERS-1];
+  reg        resp_gnt    [0:NUM_MASTERS-1];
+  reg [31:0] resp_gnt_s  [0:NUM_MASTERS-1];
+
+  function [31:0] resp_master;
+    input [SID_WIDTH-1:0] id;
+    begin
+      resp_master = id[SID_WIDTH-1:ID_WIDTH];
+    end
+  endfunction
+
+  always @(*) begin
+    s_resp_ready = {NUM_SLAVES{1'b0}};
+
+    for (pm = 0; pm < NUM_MASTERS; pm = pm + 1) begin
+      resp_gnt[pm]   = 1'b0;
+      resp_gnt_s[pm] = 0;
+      if (resp_lock[pm]) begin
+        resp_gnt[pm]   = 1'b1;
+        resp_gnt_s[pm] = resp_lock_s[pm];
+      end else if (!err_valid[pm]) begin
+        for (pk = 0; pk < NUM_SLAVES; pk = pk + 1) begin
+          pc = (resp_rr[pm] + pk) % NUM_SLAVES;
+          if (!resp_gnt[pm] && s_resp_valid[pc] &&
+              resp_master(s_resp_id[pc*SID_WIDTH +: SID_WIDTH]) == pm) begin
+            resp_gnt[pm]   = 1'b1;
+            resp_gnt_s[pm] = pc;
+          end
+        end
+      end
+
+      // Error responses go first (nothing else is granted while one waits)
+      if (!resp_lock[pm] && err_valid[pm]) begin
+        m_resp_valid[pm]                  = 1'b1;
+        m_resp_id[pm*ID_WIDTH +: ID_WIDTH] = err_id[pm];
+        m_resp_rdata[pm*64 +: 64]         = 64'h0;
+        m_resp_err[pm]                    = 1'b1;
+      end else begin
+        m_resp_valid[pm]                  = resp_gnt[pm];
+        m_resp_id[pm*ID_WIDTH +: ID_WIDTH] = s_resp_id[resp_gnt_s[pm]*SID_WIDTH +: ID_WIDTH];
+        m_resp_rdata[pm*64 +: 64]         = s_resp_rdata[resp_gnt_s[pm]*64 +: 64];
+        m_resp_err[pm]                    = 1'b0;
+        if (resp_gnt[pm])
+          s_resp_ready[resp_gnt_s[pm]] = m_resp_ready[pm];
+      end
+    end
+  end
+
+  //===========================================================================
+  // Arbitration State, Error Slots and Outstanding Counters
+  //===========================================================================
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      for (qs = 0; qs < NUM_SLAVES; qs = qs + 1) begin
+        req_rr[qs]     <= 0;
+        req_lock[qs]   <= 1'b0;
+        req_lock_m[qs] <= 0;
+      end
+      for (qm = 0; qm < NUM_MASTERS; qm = qm + 1) begin
+        resp_rr[qm]     <= 0;
+        resp_lock[qm]   <= 1'b0;
+        resp_lock_s[qm] <= 0;
+        err_valid[qm]   <= 1'b0;
+        err_id[qm]      <= {ID_WIDTH{1'b0}};
+        outstanding[qm] <= {CNT_WIDTH{1'b0}};
+      end
+    end else begin
+      for (qs = 0; qs < NUM_SLAVES; qs = qs + 1) begin
+        if (req_gnt[qs] && s_req_ready[qs]) begin
+          req_lock[qs] <= 1'b0;
+          req_rr[qs]   <= (req_gnt_m[qs] + 1) % NUM_MASTERS;
+        end else if (req_gnt[qs]) begin
+          req_lock[qs]   <= 1'b1;
+          req_lock_m[qs] <= req_gnt_m[qs];
+        end
+      end
+
+      for (qm = 0; qm < NUM_MASTERS; qm = qm + 1) begin
+        // Response grant
+        if (resp_gnt[qm] && m_resp_ready[qm]) begin
+          resp_lock[qm] <= 1'b0;
+          resp_rr[qm]   <= (resp_gnt_s[qm] + 1) % NUM_SLAVES;
+        end else if (resp_gnt[qm]) begin
+          resp_lock[qm]   <= 1'b1;
+          resp_lock_s[qm] <= resp_gnt_s[qm];
+        end
+
+        // Error slot: filled by an accepted unmapped request, freed when taken
+        if (m_req_valid[qm] && m_req_ready[qm] && !m_mapped[qm]) begin
+          err_valid[qm] <= 1'b1;
+          err_id[qm]    <= m_req_id[qm*ID_WIDTH +: ID_WIDTH];
+        end else if (err_valid[qm] && !resp_lock[qm] && m_resp_ready[qm]) begin
+          err_valid[qm] <= 1'b0;
+        end
+
+        // Outstanding transactions: +1 per accepted request, -1 per response
+        case ({m_req_valid[qm] && m_req_ready[qm], m_resp_valid[qm] && m_resp_ready[qm]})
+          2'b10:   outstanding[qm] <= outstanding[qm] + 1'b1;
+          2'b01:   outstanding[qm] <= outstanding[qm] - 1'b1;
+          default: outstanding[qm] <= outstanding[qm];
+        endcase
+      end
+    end
+  end
+
+  //===========================================================================
+  // Debug Monitoring (Optional)
+  //===========================================================================
+
+  `ifdef DEBUG_BUS
+  always @(posedge clk) begin
+    for (gm = 0; gm < NUM_MASTERS; gm = gm + 1) begin
+      if (m_req_valid[gm] && m_req_ready[gm])
+        $display("[SPLIT_BUS] M%0d req id=%0d addr=0x%08h we=%b -> %s%0d (outstanding=%0d)",
+                 gm, m_req_id[gm*ID_WIDTH +: ID_WIDTH], m_req_addr[gm*XLEN +: XLEN], m_req_we[gm],
+                 m_mapped[gm] ? "S" : "unmapped ", m_mapped[gm] ? m_slave[gm] : 0, outstanding[gm]);
+      if (m_resp_valid[gm] && m_resp_ready[gm])
+        $display("[SPLIT_BUS] M%0d resp id=%0d rdata=0x%016h err=%b",
+                 gm, m_resp_id[gm*ID_WIDTH +: ID_WIDTH], m_resp_rdata[gm*64 +: 64], m_resp_err[gm]);
+    end
+  end
+  `endif
+
+endmodule
@@ -0,0 +1,92 @@
+// split_bus_bridge.v - Split-Transaction to Simple Bus Slave Bridge
+// Attaches a slave with the simple_bus protocol (request held until ready,
+// read data valid with ready) to a split_bus slave port
+// Author: RV1 Project
+// Date: 2026-10-16
+// Updated: 2026-10-16 - ID_WIDTH default no longer from rv_config.vh
+// Updated: 2026-10-16 - Write strobe in the first cycle only
+//
+// Features:
+// - Accepts one transaction at a time and holds it on the simple bus side
+//   until the slave raises ready
+// - req_we is driven in the first cycle only, like the core's data port, so
+//   slaves with a registered ready (UART, PLIC) see each store once
+// - Returns the read data (or a write acknowledge) on the response channel
+//   with the request's ID
+// - The next request is accepted in the cycle the response is taken
+// - No data-width or lane handling: slaves narrower than 64 bits (UART, PLIC)
+//   are zero-extended/sliced by the SoC wiring, as with simple_bus
+
+`include "config/rv_config.vh"
+
+module split_bus_bridge #(
+  parameter XLEN     = `XLEN,
+  parameter ID_WIDTH = 5   // split_bus SID_WIDTH
+) (
+  input  wire                clk,
+  input  wire                reset_n,
+
+  // Split-transaction slave port (from split_bus)
+  input  wire                req_valid,
+  output wire                req_ready,
+  input  wire [ID_WIDTH-1:0] req_id,
+  input  wire [XLEN-1:0]     req_addr,
+  input  wire [63:0]         req_wdata,
+  input  wire                req_we,
+  input  wire [2:0]          req_size,
+
+  output reg                 resp_valid,
+  input  wire                resp_ready,
+  output reg  [ID_WIDTH-1:0] resp_id,
+  output reg  [63:0]         resp_rdata,
+
+  // Simple bus master port (to the slave)
+  output reg                 bus_req_valid,
+  output reg  [XLEN-1:0]     bus_req_addr,
+  output reg  [63:0]         bus_req_wdata,
+  output reg                 bus_req_we,
+  output reg  [2:0]          bus_req_size,
+  input  wire                bus_req_ready,
+  input  wire [63:0]         bus_req_rdata
+);
+
+  // Free when nothing is held on the simple bus and the response slot empties
+  assign req_ready = !bus_req_valid && (!resp_valid || resp_ready);
+
+  reg [ID_WIDTH-1:0] held_id;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      bus_req_valid <= 1'b0;
+      bus_req_addr  <= {XLEN{1'b0}};
+      bus_req_wdata <= 64'h0;
+      bus_req_we    <= 1'b0;
+      bus_req_size  <= 3'h0;
+      held_id       <= {ID_WIDTH{1'b0}};
+      resp_valid    <= 1'b0;
+      resp_id       <= {ID_WIDTH{1'b0}};
+      resp_rdata    <= 64'h0;
+    end else begin
+      if (resp_valid && resp_ready)
+        resp_valid <= 1'b0;
+
+      if (bus_req_valid && bus_req_ready) begin
+        // Slave done: drop the request, post the response
+        bus_req_valid <= 1'b0;
+        resp_valid    <= 1'b1;
+        resp_id       <= held_id;
+        resp_rdata    <= bus_req_rdata;
+      end else if (req_valid && req_ready) begin
+        bus_req_valid <= 1'b1;
+        bus_req_addr  <= req_addr;
+        bus_req_wdata <= req_wdata;
+        bus_req_we    <= req_we;
+        bus_req_size  <= req_size;
+        held_id       <= req_id;
+      end else if (bus_req_valid) begin
+        bus_req_we    <= 1'b0;
+      end
+    end
+  end
+
+endmodule
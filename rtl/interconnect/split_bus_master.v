@@ -0,0 +1,90 @@
+// split_bus_master.v - Simple Bus Master to Split-Transaction Bus Adapter
+// Attaches a master with the simple_bus protocol (core data port, D-cache or
+// store buffer: request held until ready) to a split_bus master port
+// Author: RV1 Project
+// Date: 2026-10-16
+//
+// Features:
+// - One transaction in flight, always with ID 0: the request is presented to
+//   split_bus while nothing is outstanding, then req_ready is raised with the
+//   response (read data or write acknowledge)
+// - The master keeps its request asserted until req_ready, so the adapter
+//   needs no request register; a write strobe given only in the first cycle
+//   (as the core does) is remembered until split_bus accepts the request
+// - A request dropped before its response arrives (pipeline flush) has the
+//   response discarded, so it is never returned to the next request
+// - Error responses (unmapped address) return zero data, as simple_bus does
+
+`include "config/rv_config.vh"
+
+module split_bus_master #(
+  parameter XLEN     = `XLEN,
+  parameter ID_WIDTH = 1   // split_bus ID_WIDTH (only ID 0 is used)
+) (
+  input  wire                clk,
+  input  wire                reset_n,
+
+  // Simple bus slave port (from the master)
+  input  wire                req_valid,
+  input  wire [XLEN-1:0]     req_addr,
+  input  wire [63:0]         req_wdata,
+  input  wire                req_we,
+  input  wire [2:0]          req_size,
+  output wire                req_ready,
+  output wire [63:0]         req_rdata,
+
+  // Split-transaction master port (to split_bus)
+  output wire                m_req_valid,
+  input  wire                m_req_ready,
+  output wire [ID_WIDTH-1:0] m_req_id,
+  output wire [XLEN-1:0]     m_req_addr,
+  output wire [63:0]         m_req_wdata,
+  output wire                m_req_we,
+  output wire [2:0]          m_req_size,
+
+  input  wire                m_resp_valid,
+  output wire                m_resp_ready,
+  input  wire [ID_WIDTH-1:0] m_resp_id,
+  input  wire [63:0]         m_resp_rdata,
+  input  wire                m_resp_err
+);
+
+  reg wait_resp;    // Request accepted, response not yet received
+  reg drop_resp;    // The master gave up the request: discard the response
+  reg we_pending;   // Write strobe seen, request not yet accepted
+
+  assign m_req_valid = req_valid && !wait_resp;
+  assign m_req_id    = {ID_WIDTH{1'b0}};
+  assign m_req_addr  = req_addr;
+  assign m_req_wdata = req_wdata;
+  assign m_req_we    = req_we || we_pending;
+  assign m_req_size  = req_size;
+
+  assign m_resp_ready = 1'b1;
+
+  assign req_ready = wait_resp && !drop_resp && req_valid && m_resp_valid;
+  assign req_rdata = m_resp_err ? 64'h0 : m_resp_rdata;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      wait_resp  <= 1'b0;
+      drop_resp  <= 1'b0;
+      we_pending <= 1'b0;
+    end else begin
+      if (m_req_valid && m_req_ready) begin
+        wait_resp <= 1'b1;
+      end else if (wait_resp && m_resp_valid) begin
+        wait_resp <= 1'b0;
+        drop_resp <= 1'b0;
+      end else if (wait_resp && !req_valid) begin
+        drop_resp <= 1'b1;
+      end
+
+      if (!req_valid || (m_req_valid && m_req_ready))
+        we_pending <= 1'b0;
+      else if (req_we)
+        we_pending <= 1'b1;
+    end
+  end
+
+endmodule
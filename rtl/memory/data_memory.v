@@ -4,6 +4,8 @@
 // Date: 2025-10-09
 // Updated: 2025-10-10 - Parameterized for XLEN (32/64-bit support)
 // Updated: 2025-10-22 - Added FLEN parameter for RV32D support (64-bit FP on 32-bit CPU)
+// Updated: 2026-10-16 - +DMEM_FILE=<hex> runtime image when MEM_FILE is empty
+// Updated: 2026-10-16 - RV_DPI_IMAGE: image copied in by the C++ driver over DPI-C
 
 `include "config/rv_config.vh"
 
@@ -25,6 +27,18 @@ module data_memory #(
   // Memory array (byte-addressable)
   reg [7:0] mem [0:MEM_SIZE-1];
 
+  // Runtime image (+DMEM_FILE=<hex>), used when MEM_FILE is not set at compile time
+  reg [8*256-1:0] plusarg_file;
+
+`ifdef RV_DPI_IMAGE
+  // Program image held by the C++ driver; target 1 (DMEM) has only the segments
+  // in the DMEM window (see instruction_memory.v)
+  import "DPI-C" function int  rv_image_segment(input int target, input int n,
+                                                output longint addr, output longint len);
+  import "DPI-C" function byte rv_image_byte(input int target, input int n,
+                                             input longint offset);
+`endif
+
   // Internal signals
   wire [XLEN-1:0] masked_addr;
   wire [XLEN-1:0] word_addr;
@@ -141,6 +155,11 @@ module data_memory #(
   // Initialize memory
   initial begin
     integer i;
+    integer n;
+    reg [63:0] seg_addr;
+    reg [63:0] seg_len;
+    reg [63:0] off;
+    reg        dpi_loaded;
 
     // Initialize output register to zero
     read_data = 64'h0;
@@ -150,6 +169,17 @@ module data_memory #(
       mem[i] = 8'h0;
     end
 
+    dpi_loaded = 1'b0;
+`ifdef RV_DPI_IMAGE
+    n = 0;
+    while (rv_image_segment(1, n, seg_addr, seg_len) != 0) begin
+      for (off = 0; off < seg_len; off = off + 1)
+        mem[(seg_addr + off) & (MEM_SIZE - 1)] = rv_image_byte(1, n, off);
+      n = n + 1;
+      dpi_loaded = 1'b1;
+    end
+`endif
+
     // Load from file if specified (for compliance tests with embedded data)
     // Hex file format from "objcopy -O verilog" contains space-separated hex bytes
     // $readmemh treats each space-separated value as one byte
@@ -157,6 +187,8 @@ module data_memory #(
     // since we use address masking to wrap addresses into our memory space
     if (MEM_FILE != "") begin
       $readmemh(MEM_FILE, mem);
+    end else if (!dpi_loaded && $value$plusargs("DMEM_FILE=%s", plusarg_file)) begin
+      $readmemh(plusarg_file, mem);
     end
   end
 
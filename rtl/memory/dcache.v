@@ -0,0 +1,772 @@
+// dcache.v - Write-Back Data Cache with MSHRs
+// Sits between a core's data bus master port and simple_bus (bus protocol on
+// both sides, same request/response semantics as dmem_bus_adapter)
+// Features:
+//   - Parameterized size / line size / associativity (DCACHE_* in rv_config.vh)
+//   - Write-back, write-allocate; dirty victims written back before refill
+//   - Tree pseudo-LRU replacement (invalid ways are filled first)
+//   - NUM_MSHRS miss status holding registers: store misses merge their bytes
+//     into an MSHR and complete immediately; loads wait for their line
+//   - Hits complete combinationally (no bus wait cycle)
+//   - Addresses outside [CACHEABLE_BASE, CACHEABLE_MASK] (MMIO) bypass the
+//     cache after all MSHRs have drained, preserving store -> MMIO ordering
+//   - Misaligned accesses that cross a line are done uncached after the
+//     affected lines are written back and invalidated
+//   - COHERENT=1: MESI states (valid/dirty/shared bits) kept coherent with the
+//     other cores' D-caches through coherence_hub.v. Every refill, write-back
+//     and flush first acquires the line at the hub (read-shared for loads,
+//     exclusive for stores and atomics); the hub snoops the other caches,
+//     which write back M lines and downgrade or invalidate their copy. Stores
+//     hit only in E/M; a store to an S line re-fetches it exclusively
+//   - req_lock (atomic read-modify-write in progress): the locked line is read
+//     exclusively and snoops to it wait until the lock drops, so AMOs and SC
+//     execute on a line no other cache can touch in between
+// Author: RV1 Project
+// Date: 2026-10-16
+// Updated: 2026-10-16 - Victim way locked out of hits from the cycle the miss
+//                       engine picks it (store hit there was lost on refill)
+
+`include "config/rv_config.vh"
+
+module dcache #(
+  parameter XLEN       = `XLEN,
+  parameter CACHE_SIZE = `DCACHE_SIZE,       // Bytes
+  parameter LINE_SIZE  = `DCACHE_LINE_SIZE,  // Bytes (power of 2, >= 16)
+  parameter WAYS       = `DCACHE_WAYS,       // Power of 2
+  parameter NUM_MSHRS  = `DCACHE_MSHRS,
+  parameter [XLEN-1:0] CACHEABLE_BASE = 32'h8000_0000,  // DMEM (see simple_bus.v)
+  parameter [XLEN-1:0] CACHEABLE_MASK = 32'hFFF0_0000,
+  parameter COHERENT   = 0                   // MESI snooping through coherence_hub
+) (
+  input  wire             clk,
+  input  wire             reset_n,
+
+  // CPU side (bus slave)
+  input  wire             req_valid,
+  input  wire [XLEN-1:0]  req_addr,
+  input  wire [63:0]      req_wdata,
+  input  wire             req_we,
+  input  wire [2:0]       req_size,          // funct3: size + signedness
+  output wire             req_ready,
+  output wire [63:0]      req_rdata,
+  input  wire             req_lock,          // Atomic sequence in progress
+
+  // Memory side (bus master)
+  output reg              mem_req_valid,
+  output reg  [XLEN-1:0]  mem_req_addr,
+  output reg  [63:0]      mem_req_wdata,
+  output reg              mem_req_we,
+  output reg  [2:0]       mem_req_size,
+  input  wire             mem_req_ready,
+  input  wire [63:0]      mem_req_rdata,
+
+  // Coherence (COHERENT=1): line acquire, held until the engine is done
+  output wire             acq_valid,
+  output wire [XLEN-1:0]  acq_addr,
+  output wire             acq_excl,          // Exclusive (RdX) vs shared (Rd)
+  input  wire             acq_grant,
+  input  wire             acq_shared,        // Another cache kept a copy
+
+  // Coherence (COHERENT=1): snoop of another cache's acquire
+  input  wire             snp_valid,
+  input  wire [XLEN-1:0]  snp_addr,
+  input  wire             snp_excl,
+  output wire             snp_ack,           // Line written back / downgraded / dropped
+  output wire             snp_hit,           // Copy kept (shared) after the snoop
+
+  // Statistics
+  output reg  [31:0]      stat_hits,
+  output reg  [31:0]      stat_misses,       // MSHR allocations
+  output reg  [31:0]      stat_writebacks    // Dirty lines written back
+);
+
+  // =========================================================================
+  // Geometry
+  // =========================================================================
+
+  localparam DWORDS      = LINE_SIZE / 8;
+  localparam LINE_BITS   = LINE_SIZE * 8;
+  localparam NUM_SETS    = CACHE_SIZE / (LINE_SIZE * WAYS);
+  localparam OFFSET_BITS = $clog2(LINE_SIZE);
+  localparam INDEX_BITS  = (NUM_SETS > 1) ? $clog2(NUM_SETS) : 1;
+  localparam TAG_BITS    = XLEN - OFFSET_BITS - INDEX_BITS;
+  localparam LADDR_BITS  = XLEN - OFFSET_BITS;  // Line address (byte address >> OFFSET_BITS)
+  localparam WAY_BITS    = (WAYS > 1) ? $clog2(WAYS) : 1;
+  localparam PLRU_BITS   = (WAYS > 1) ? (WAYS - 1) : 1;
+  localparam MSHR_BITS   = (NUM_MSHRS > 1) ? $clog2(NUM_MSHRS) : 1;
+  localparam BEAT_BITS   = (DWORDS > 1) ? $clog2(DWORDS) : 1;
+
+  // Miss engine states
+  localparam E_IDLE    = 3'd0;
+  localparam E_WB      = 3'd1;  // Write back dirty victim, one doubleword per beat
+  localparam E_REFILL  = 3'd2;  // Read line, one doubleword per beat
+  localparam E_INSTALL = 3'd3;  // Merge MSHR store bytes, write line, free MSHR
+  localparam E_INVAL   = 3'd4;  // Flush only: drop the line
+  localparam E_ACQ     = 3'd5;  // COHERENT: wait for the hub to grant the line
+
+  // =========================================================================
+  // Storage
+  // =========================================================================
+
+  reg                  line_valid [0:NUM_SETS*WAYS-1];
+  reg                  line_dirty [0:NUM_SETS*WAYS-1];
+  reg                  line_shared[0:NUM_SETS*WAYS-1];  // MESI: M=dirty, E=!dirty&&!shared, S=shared
+  reg [TAG_BITS-1:0]   line_tag   [0:NUM_SETS*WAYS-1];
+  reg [LINE_BITS-1:0]  line_data  [0:NUM_SETS*WAYS-1];
+  reg [PLRU_BITS-1:0]  plru       [0:NUM_SETS-1];
+
+  reg                  mshr_valid [0:NUM_MSHRS-1];
+  reg [LADDR_BITS-1:0] mshr_line  [0:NUM_MSHRS-1];
+  reg [LINE_BITS-1:0]  mshr_data  [0:NUM_MSHRS-1];  // Store bytes waiting for the line
+  reg [LINE_SIZE-1:0]  mshr_mask  [0:NUM_MSHRS-1];
+  reg                  mshr_excl  [0:NUM_MSHRS-1];  // Locked load: fetch exclusively
+
+  // Request latch: a request that cannot complete in its first cycle is
+  // captured here (the core drops req_we after the first cycle of a store)
+  reg                  pend_valid;
+  reg [XLEN-1:0]       pend_addr;
+  reg [63:0]           pend_wdata;
+  reg                  pend_we;
+  reg [2:0]            pend_size;
+
+  // Miss engine
+  reg [2:0]            eng_state;
+  reg [MSHR_BITS-1:0]  eng_mshr;
+  reg [INDEX_BITS-1:0] eng_set;
+  reg [WAY_BITS-1:0]   eng_way;
+  reg [LADDR_BITS-1:0] eng_line;         // Line being refilled
+  reg [LADDR_BITS-1:0] eng_victim_line;  // Line being written back
+  reg [BEAT_BITS-1:0]  eng_beat;
+  reg                  eng_flush;
+  reg                  eng_excl;         // COHERENT: line acquired exclusively
+  reg                  eng_shared;       // COHERENT: other copies remain (install as S)
+  reg [LINE_BITS-1:0]  eng_buf;
+
+  reg                  byp_issued;       // Uncached store already presented
+  reg                  byp_busy;         // Uncached access waiting for the bus
+
+  // Locked (atomic) line
+  reg                  lock_valid;
+  reg [LADDR_BITS-1:0] lock_line;
+
+  // Snoop
+  reg                  snp_done;         // Snoop answered, wait for snp_valid to drop
+  reg                  snp_wb;           // Writing back the snooped M line
+  reg [BEAT_BITS-1:0]  snp_beat;
+
+  // =========================================================================
+  // Helpers
+  // =========================================================================
+
+  function [3:0] access_bytes;
+    input [2:0] size;
+    begin
+      case (size[1:0])
+        2'b00:   access_bytes = 4'd1;
+        2'b01:   access_bytes = 4'd2;
+        2'b10:   access_bytes = 4'd4;
+        default: access_bytes = 4'd8;
+      endcase
+    end
+  endfunction
+
+  // Same extension rules as data_memory.v
+  function [63:0] load_extend;
+    input [63:0] raw;
+    input [2:0]  size;
+    begin
+      case (size)
+        3'b000:  load_extend = {{56{raw[7]}}, raw[7:0]};
+        3'b001:  load_extend = {{48{raw[15]}}, raw[15:0]};
+        3'b010:  load_extend = {{32{raw[31]}}, raw[31:0]};
+        3'b011:  load_extend = raw;
+        3'b100:  load_extend = {56'h0, raw[7:0]};
+        3'b101:  load_extend = {48'h0, raw[15:0]};
+        3'b110:  load_extend = {32'h0, raw[31:0]};
+        default: load_extend = 64'h0;
+      endcase
+    end
+  endfunction
+
+  function [LINE_BITS-1:0] write_bytes;
+    input [LINE_BITS-1:0]   line;
+    input [OFFSET_BITS-1:0] off;
+    input [63:0]            wdata;
+    input [3:0]             nbytes;
+    integer b;
+    begin
+      write_bytes = line;
+      for (b = 0; b < 8; b = b + 1)
+        if (b < nbytes)
+          write_bytes[(off + b) * 8 +: 8] = wdata[b * 8 +: 8];
+    end
+  endfunction
+
+  function [LINE_SIZE-1:0] byte_mask;
+    input [OFFSET_BITS-1:0] off;
+    input [3:0]             nbytes;
+    integer b;
+    begin
+      byte_mask = {LINE_SIZE{1'b0}};
+      for (b = 0; b < 8; b = b + 1)
+        if (b < nbytes)
+          byte_mask[off + b] = 1'b1;
+    end
+  endfunction
+
+  function [LINE_BITS-1:0] merge_line;
+    input [LINE_BITS-1:0] base;
+    input [LINE_BITS-1:0] over;
+    input [LINE_SIZE-1:0] mask;
+    integer b;
+    begin
+      for (b = 0; b < LINE_SIZE; b = b + 1)
+        merge_line[b * 8 +: 8] = mask[b] ? over[b * 8 +: 8] : base[b * 8 +: 8];
+    end
+  endfunction
+
+  function [INDEX_BITS-1:0] line_set;
+    input [LADDR_BITS-1:0] laddr;
+    begin
+      line_set = (NUM_SETS > 1) ? laddr[INDEX_BITS-1:0] : {INDEX_BITS{1'b0}};
+    end
+  endfunction
+
+  function [TAG_BITS-1:0] line_tagof;
+    input [LADDR_BITS-1:0] laddr;
+    begin
+      line_tagof = laddr[LADDR_BITS-1:INDEX_BITS];
+    end
+  endfunction
+
+  // Tree pseudo-LRU (same encoding as icache.v)
+  function [WAY_BITS-1:0] plru_victim;
+    input [PLRU_BITS-1:0] bits;
+    integer lvl, node;
+    begin
+      node = 0;
+      for (lvl = 0; lvl < WAY_BITS; lvl = lvl + 1)
+        node = 2 * node + 1 + bits[node];
+      plru_victim = node - (WAYS - 1);
+    end
+  endfunction
+
+  function [PLRU_BITS-1:0] plru_touch;
+    input [PLRU_BITS-1:0] bits;
+    input [WAY_BITS-1:0]  way;
+    integer lvl, node;
+    reg dir;
+    begin
+      plru_touch = bits;
+      node = 0;
+      for (lvl = 0; lvl < WAY_BITS; lvl = lvl + 1) begin
+        dir = way[WAY_BITS-1-lvl];
+        plru_touch[node] = ~dir;
+        node = 2 * node + 1 + dir;
+      end
+    end
+  endfunction
+
+  // =========================================================================
+  // Current request (latched one takes precedence)
+  // =========================================================================
+
+  wire            cur_valid = pend_valid || req_valid;
+  wire [XLEN-1:0] cur_addr  = pend_valid ? pend_addr  : req_addr;
+  wire [63:0]     cur_wdata = pend_valid ? pend_wdata : req_wdata;
+  wire            cur_we    = pend_valid ? pend_we    : req_we;
+  wire [2:0]      cur_size  = pend_valid ? pend_size  : req_size;
+
+  wire [3:0]             cur_nbytes = access_bytes(cur_size);
+  wire [OFFSET_BITS-1:0] cur_off    = cur_addr[OFFSET_BITS-1:0];
+  wire [LADDR_BITS-1:0]  cur_line   = cur_addr[XLEN-1:OFFSET_BITS];
+  wire [LADDR_BITS-1:0]  cur_line_b = cur_line + 1'b1;   // Second line of a crossing access
+  wire [INDEX_BITS-1:0]  cur_set    = line_set(cur_line);
+
+  wire cur_cacheable = ((cur_addr & CACHEABLE_MASK) == CACHEABLE_BASE);
+  wire cur_crosses   = ({1'b0, cur_off} + cur_nbytes) > LINE_SIZE;
+  wire cur_cached    = cur_cacheable && !cur_crosses;
+
+  // =========================================================================
+  // Tag lookup
+  // =========================================================================
+  // The line the miss engine is evicting/replacing is locked out of hits so
+  // a store cannot slip into it after its data has been written back. This
+  // starts in the cycle the engine picks the victim: it samples line_dirty
+  // then, so a store hit that cycle would be overwritten by the refill
+
+  wire eng_lock = (eng_state != E_IDLE);
+
+  wire                  eng_start;     // Engine leaves E_IDLE for an MSHR
+  wire [INDEX_BITS-1:0] svc_set;
+  reg  [WAY_BITS-1:0]   victim_way;
+
+  reg                hit;
+  reg [WAY_BITS-1:0] hit_way;
+  reg                present_a, present_b;   // Line present at all (flush check)
+  reg [WAY_BITS-1:0] present_a_way, present_b_way;
+
+  integer w;
+  always @(*) begin
+    hit = 1'b0;
+    hit_way = {WAY_BITS{1'b0}};
+    present_a = 1'b0;
+    present_b = 1'b0;
+    present_a_way = {WAY_BITS{1'b0}};
+    present_b_way = {WAY_BITS{1'b0}};
+    for (w = 0; w < WAYS; w = w + 1) begin
+      if (line_valid[cur_set*WAYS + w] && line_tag[cur_set*WAYS + w] == line_tagof(cur_line)) begin
+        present_a = 1'b1;
+        present_a_way = w;
+        if (!(eng_lock && eng_set == cur_set && eng_way == w) &&
+            !(eng_start && svc_set == cur_set && victim_way == w)) begin
+          hit = 1'b1;
+          hit_way = w;
+        end
+      end
+      if (line_valid[line_set(cur_line_b)*WAYS + w] &&
+          line_tag[line_set(cur_line_b)*WAYS + w] == line_tagof(cur_line_b)) begin
+        present_b = 1'b1;
+        present_b_way = w;
+      end
+    end
+  end
+
+  wire [LINE_BITS-1:0] hit_line  = line_data[cur_set*WAYS + hit_way];
+  wire [LINE_BITS-1:0] hit_shift = hit_line >> {cur_off, 3'b000};
+  wire [63:0]          hit_rdata = load_extend(hit_shift[63:0], cur_size);
+
+  // Stores and locked loads need the line exclusively (E/M)
+  wire hit_shared = COHERENT && line_shared[cur_set*WAYS + hit_way];
+  wire hit_ok     = hit && !(hit_shared && (cur_we || req_lock));
+  wire upgrade    = hit && !hit_ok;    // Drop the S copy and re-fetch it exclusively
+
+  // =========================================================================
+  // Snoop lookup (COHERENT)
+  // =========================================================================
+
+  wire                  lk_active = COHERENT && req_lock && (lock_valid || (cur_valid && cur_cached));
+  wire [LADDR_BITS-1:0] lk_line   = lock_valid ? lock_line : cur_line;
+
+  wire [LADDR_BITS-1:0] snp_line  = snp_addr[XLEN-1:OFFSET_BITS];
+  wire [INDEX_BITS-1:0] snp_set   = line_set(snp_line);
+
+  reg                snp_present;
+  reg [WAY_BITS-1:0] snp_way;
+
+  integer sw;
+  always @(*) begin
+    snp_present = 1'b0;
+    snp_way = {WAY_BITS{1'b0}};
+    for (sw = 0; sw < WAYS; sw = sw + 1) begin
+      if (line_valid[snp_set*WAYS + sw] && line_tag[snp_set*WAYS + sw] == line_tagof(snp_line)) begin
+        snp_present = 1'b1;
+        snp_way = sw;
+      end
+    end
+  end
+
+  wire [31:0] snp_idx   = snp_set * WAYS + snp_way;
+  wire        snp_req   = COHERENT && snp_valid && !snp_done;
+  // An exclusively held locked line answers once the atomic sequence is over
+  wire        snp_defer = lk_active && !snp_wb && snp_line == lk_line && snp_present && !line_shared[snp_idx] &&
+                          !(eng_lock && eng_set == snp_set && eng_way == snp_way);
+  wire        snp_act   = snp_req && !snp_defer;
+  wire        snp_dirty = snp_present && line_dirty[snp_idx];
+
+  // The CPU waits while its line is being snooped
+  wire snp_block = snp_act && cur_line == snp_line;
+
+  // =========================================================================
+  // MSHR lookup
+  // =========================================================================
+
+  reg                 mshr_hit, mshr_free, mshr_any;
+  reg [MSHR_BITS-1:0] mshr_hit_idx, mshr_free_idx, mshr_svc_idx;
+
+  integer m;
+  always @(*) begin
+    mshr_hit = 1'b0;
+    mshr_free = 1'b0;
+    mshr_any = 1'b0;
+    mshr_hit_idx = {MSHR_BITS{1'b0}};
+    mshr_free_idx = {MSHR_BITS{1'b0}};
+    mshr_svc_idx = {MSHR_BITS{1'b0}};
+    for (m = NUM_MSHRS - 1; m >= 0; m = m - 1) begin
+      if (mshr_valid[m] && mshr_line[m] == cur_line) begin
+        mshr_hit = 1'b1;
+        mshr_hit_idx = m;
+      end
+      if (!mshr_valid[m]) begin
+        mshr_free = 1'b1;
+        mshr_free_idx = m;            // Lowest free index
+      end else begin
+        mshr_any = 1'b1;
+        mshr_svc_idx = m;             // Lowest pending index is serviced first
+      end
+    end
+  end
+
+  // An MSHR being installed this cycle can no longer take store bytes
+  // A line acquired shared cannot take store bytes either (COHERENT)
+  wire mshr_merge_ok = mshr_hit && !(eng_state == E_INSTALL && eng_mshr == mshr_hit_idx) &&
+                       !(COHERENT && eng_lock && !eng_flush && !eng_excl && eng_mshr == mshr_hit_idx);
+
+  // =========================================================================
+  // Request outcome
+  // =========================================================================
+
+  wire complete_hit   = cur_valid && cur_cached && hit_ok && !snp_block;
+  wire complete_merge = cur_valid && cur_cached && !hit_ok && cur_we && !snp_block &&
+                        (mshr_merge_ok || (!mshr_hit && mshr_free));
+  wire alloc_load     = cur_valid && cur_cached && !hit_ok && !cur_we && !snp_block &&
+                        !mshr_hit && mshr_free;
+
+  // Uncached path: MMIO, or a cacheable access crossing a line boundary
+  // Waits for all MSHRs and the engine; crossing accesses also wait for both
+  // lines to be flushed out of the cache
+  wire bypass_path    = cur_valid && !cur_cached;
+  wire bypass_clear   = !mshr_any && (eng_state == E_IDLE);
+  wire flush_needed   = bypass_path && cur_cacheable && (present_a || present_b);
+  // A snoop write-back goes first unless an uncached access is already on the bus
+  wire bypass_active  = bypass_path && bypass_clear && !flush_needed && !snp_wb &&
+                        !(snp_act && snp_dirty && !byp_busy);
+  wire complete_byp   = bypass_active && mem_req_ready;
+
+  wire cur_done = complete_hit || complete_merge || complete_byp;
+
+  assign req_ready = req_valid && cur_done && (!pend_valid || req_addr == pend_addr);
+  assign req_rdata = bypass_active ? mem_req_rdata : hit_rdata;
+
+  // =========================================================================
+  // Victim selection for the MSHR about to be serviced
+  // =========================================================================
+
+  wire [LADDR_BITS-1:0] svc_line = mshr_line[mshr_svc_idx];
+  assign                svc_set  = line_set(svc_line);
+
+  integer v;
+  always @(*) begin
+    victim_way = (WAYS > 1) ? plru_victim(plru[svc_set]) : {WAY_BITS{1'b0}};
+    for (v = WAYS - 1; v >= 0; v = v - 1)
+      if (!line_valid[svc_set*WAYS + v])
+        victim_way = v;
+  end
+
+  // COHERENT: never evict the locked line in the middle of an atomic sequence
+  wire svc_blocked = lk_active && svc_set == line_set(lk_line) &&
+                     line_valid[svc_set*WAYS + victim_way] &&
+                     line_tag[svc_set*WAYS + victim_way] == line_tagof(lk_line);
+
+  assign eng_start = (eng_state == E_IDLE) && mshr_any && !svc_blocked;
+
+  // =========================================================================
+  // Coherence ports
+  // =========================================================================
+
+  assign acq_valid = COHERENT && (eng_state != E_IDLE);
+  assign acq_addr  = {eng_flush ? eng_victim_line : eng_line, {OFFSET_BITS{1'b0}}};
+  assign acq_excl  = eng_flush || eng_excl;
+
+  // Snoop done: clean/absent line at once, M line after its write-back
+  wire snp_wb_start = snp_act && !snp_wb && snp_dirty && !byp_busy;
+  wire snp_finish   = snp_act && (snp_wb ? (mem_req_ready && snp_beat == DWORDS - 1) : !snp_dirty);
+
+  assign snp_ack = snp_finish;
+  assign snp_hit = snp_present && !snp_excl;
+
+  wire [WAY_BITS-1:0]  flush_way = present_a ? present_a_way : present_b_way;
+  wire [INDEX_BITS-1:0] flush_set = present_a ? cur_set : line_set(cur_line_b);
+
+  // =========================================================================
+  // Memory port
+  // =========================================================================
+
+  wire [31:0]          eng_idx      = eng_set * WAYS + eng_way;
+  wire [LINE_BITS-1:0] eng_wb_shift = line_data[eng_idx] >> {eng_beat, 6'b000000};
+  wire [LINE_BITS-1:0] snp_wb_shift = line_data[snp_idx] >> {snp_beat, 6'b000000};
+
+  always @(*) begin
+    mem_req_valid = 1'b0;
+    mem_req_addr  = {XLEN{1'b0}};
+    mem_req_wdata = 64'h0;
+    mem_req_we    = 1'b0;
+    mem_req_size  = 3'b011;
+    case (eng_state)
+      E_WB: begin
+        mem_req_valid = 1'b1;
+        mem_req_addr  = {eng_victim_line, eng_beat, 3'b000};
+        mem_req_wdata = eng_wb_shift[63:0];
+        mem_req_we    = 1'b1;
+      end
+      E_REFILL: begin
+        mem_req_valid = 1'b1;
+        mem_req_addr  = {eng_line, eng_beat, 3'b000};
+      end
+      default: begin
+        if (snp_wb) begin
+          mem_req_valid = 1'b1;
+          mem_req_addr  = {snp_line, snp_beat, 3'b000};
+          mem_req_wdata = snp_wb_shift[63:0];
+          mem_req_we    = 1'b1;
+        end else if (bypass_active) begin
+          mem_req_valid = 1'b1;
+          mem_req_addr  = cur_addr;
+          mem_req_wdata = cur_wdata;
+          mem_req_we    = cur_we && !byp_issued;  // One-shot, like the core's bus port
+          mem_req_size  = cur_size;
+        end
+      end
+    endcase
+  end
+
+  // =========================================================================
+  // Sequential
+  // =========================================================================
+
+  integer i;
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      for (i = 0; i < NUM_SETS*WAYS; i = i + 1) begin
+        line_valid[i] <= 1'b0;
+        line_dirty[i] <= 1'b0;
+        line_shared[i] <= 1'b0;
+        line_tag[i]   <= {TAG_BITS{1'b0}};
+      end
+      for (i = 0; i < NUM_SETS; i = i + 1)
+        plru[i] <= {PLRU_BITS{1'b0}};
+      for (i = 0; i < NUM_MSHRS; i = i + 1) begin
+        mshr_valid[i] <= 1'b0;
+        mshr_line[i]  <= {LADDR_BITS{1'b0}};
+        mshr_mask[i]  <= {LINE_SIZE{1'b0}};
+        mshr_excl[i]  <= 1'b0;
+      end
+      pend_valid      <= 1'b0;
+      pend_addr       <= {XLEN{1'b0}};
+      pend_wdata      <= 64'h0;
+      pend_we         <= 1'b0;
+      pend_size       <= 3'b0;
+      eng_state       <= E_IDLE;
+      eng_mshr        <= {MSHR_BITS{1'b0}};
+      eng_set         <= {INDEX_BITS{1'b0}};
+      eng_way         <= {WAY_BITS{1'b0}};
+      eng_line        <= {LADDR_BITS{1'b0}};
+      eng_victim_line <= {LADDR_BITS{1'b0}};
+      eng_beat        <= {BEAT_BITS{1'b0}};
+      eng_flush       <= 1'b0;
+      eng_excl        <= 1'b0;
+      eng_shared      <= 1'b0;
+      byp_issued      <= 1'b0;
+      byp_busy        <= 1'b0;
+      lock_valid      <= 1'b0;
+      lock_line       <= {LADDR_BITS{1'b0}};
+      snp_done        <= 1'b0;
+      snp_wb          <= 1'b0;
+      snp_beat        <= {BEAT_BITS{1'b0}};
+      stat_hits       <= 32'd0;
+      stat_misses     <= 32'd0;
+      stat_writebacks <= 32'd0;
+    end else begin
+      // ---------------------------------------------------------------
+      // CPU request
+      // ---------------------------------------------------------------
+      if (complete_hit) begin
+        if (cur_we) begin
+          line_data[cur_set*WAYS + hit_way] <= write_bytes(hit_line, cur_off, cur_wdata, cur_nbytes);
+          line_dirty[cur_set*WAYS + hit_way] <= 1'b1;    // E -> M
+        end
+        if (WAYS > 1)
+          plru[cur_set] <= plru_touch(plru[cur_set], hit_way);
+        stat_hits <= stat_hits + 1;
+      end else if (complete_merge) begin
+        if (mshr_merge_ok) begin
+          mshr_data[mshr_hit_idx] <= write_bytes(mshr_data[mshr_hit_idx], cur_off, cur_wdata, cur_nbytes);
+          mshr_mask[mshr_hit_idx] <= mshr_mask[mshr_hit_idx] | byte_mask(cur_off, cur_nbytes);
+        end else begin
+          mshr_valid[mshr_free_idx] <= 1'b1;
+          mshr_line[mshr_free_idx]  <= cur_line;
+          mshr_data[mshr_free_idx]  <= write_bytes({LINE_BITS{1'b0}}, cur_off, cur_wdata, cur_nbytes);
+          mshr_mask[mshr_free_idx]  <= byte_mask(cur_off, cur_nbytes);
+          mshr_excl[mshr_free_idx]  <= 1'b1;
+          if (upgrade)
+            line_valid[cur_set*WAYS + hit_way] <= 1'b0;
+          stat_misses <= stat_misses + 1;
+          `ifdef DEBUG_DCACHE
+          $display("[DCACHE] Store miss addr=0x%h -> MSHR %0d", cur_addr, mshr_free_idx);
+          `endif
+        end
+      end else if (alloc_load) begin
+        mshr_valid[mshr_free_idx] <= 1'b1;
+        mshr_line[mshr_free_idx]  <= cur_line;
+        mshr_mask[mshr_free_idx]  <= {LINE_SIZE{1'b0}};
+        mshr_excl[mshr_free_idx]  <= COHERENT && req_lock;
+        if (upgrade)
+          line_valid[cur_set*WAYS + hit_way] <= 1'b0;
+        stat_misses <= stat_misses + 1;
+        `ifdef DEBUG_DCACHE
+        $display("[DCACHE] Load miss addr=0x%h -> MSHR %0d", cur_addr, mshr_free_idx);
+        `endif
+      end
+
+      if (cur_done)
+        pend_valid <= 1'b0;
+      else if (!pend_valid && req_valid) begin
+        pend_valid <= 1'b1;
+        pend_addr  <= req_addr;
+        pend_wdata <= req_wdata;
+        pend_we    <= req_we;
+        pend_size  <= req_size;
+      end
+
+      if (complete_byp || !bypass_active)
+        byp_issued <= 1'b0;
+      else if (cur_we)
+        byp_issued <= 1'b1;
+
+      byp_busy <= bypass_active && !complete_byp;
+
+      if (!req_lock)
+        lock_valid <= 1'b0;
+      else if (cur_valid && cur_cached) begin
+        lock_valid <= 1'b1;
+        lock_line  <= cur_line;
+      end
+
+      // ---------------------------------------------------------------
+      // Snoop (COHERENT): Rd leaves a clean shared copy, RdX drops it
+      // ---------------------------------------------------------------
+      if (!snp_valid)
+        snp_done <= 1'b0;
+
+      if (snp_wb_start) begin
+        snp_wb   <= 1'b1;
+        snp_beat <= {BEAT_BITS{1'b0}};
+      end else if (snp_wb && mem_req_ready)
+        snp_beat <= snp_beat + 1'b1;
+
+      if (snp_finish) begin
+        snp_done <= 1'b1;
+        snp_wb   <= 1'b0;
+        if (snp_wb)
+          stat_writebacks <= stat_writebacks + 1;
+        if (snp_present) begin
+          line_dirty[snp_idx] <= 1'b0;
+          if (snp_excl)
+            line_valid[snp_idx] <= 1'b0;
+          else
+            line_shared[snp_idx] <= 1'b1;
+        end
+        `ifdef DEBUG_DCACHE
+        $display("[DCACHE] Snoop %s line 0x%h present=%b dirty=%b",
+                 snp_excl ? "RdX" : "Rd", {snp_line, {OFFSET_BITS{1'b0}}}, snp_present, snp_dirty);
+        `endif
+      end
+
+      // ---------------------------------------------------------------
+      // Miss engine
+      // ---------------------------------------------------------------
+      case (eng_state)
+        E_IDLE: begin
+          eng_beat <= {BEAT_BITS{1'b0}};
+          if (eng_start) begin
+            eng_mshr        <= mshr_svc_idx;
+            eng_set         <= svc_set;
+            eng_way         <= victim_way;
+            eng_line        <= svc_line;
+            eng_victim_line <= {line_tag[svc_set*WAYS + victim_way], svc_set};
+            eng_flush       <= 1'b0;
+            eng_excl        <= (|mshr_mask[mshr_svc_idx]) || mshr_excl[mshr_svc_idx];
+            if (COHERENT)
+              eng_state <= E_ACQ;
+            else if (line_valid[svc_set*WAYS + victim_way] && line_dirty[svc_set*WAYS + victim_way])
+              eng_state <= E_WB;
+            else if (&mshr_mask[mshr_svc_idx])
+              eng_state <= E_INSTALL;   // Fully overwritten: no refill needed
+            else
+              eng_state <= E_REFILL;
+          end else if (flush_needed && bypass_clear) begin
+            eng_set         <= flush_set;
+            eng_way         <= flush_way;
+            eng_victim_line <= {line_tag[flush_set*WAYS + flush_way], flush_set};
+            eng_flush       <= 1'b1;
+            if (COHERENT)
+              eng_state     <= E_ACQ;
+            else
+              eng_state     <= line_dirty[flush_set*WAYS + flush_way] ? E_WB : E_INVAL;
+          end
+        end
+
+        E_ACQ: begin
+          // Other caches have been snooped; the victim may have been
+          // downgraded or dropped by a snoop while waiting
+          if (acq_grant) begin
+            eng_shared <= acq_shared;
+            if (eng_flush)
+              eng_state <= (line_valid[eng_idx] && line_dirty[eng_idx]) ? E_WB : E_INVAL;
+            else if (line_valid[eng_idx] && line_dirty[eng_idx])
+              eng_state <= E_WB;
+            else if (&mshr_mask[eng_mshr])
+              eng_state <= E_INSTALL;
+            else
+              eng_state <= E_REFILL;
+          end
+        end
+
+        E_WB: begin
+          if (mem_req_ready) begin
+            eng_beat <= eng_beat + 1'b1;
+            if (eng_beat == DWORDS - 1) begin
+              eng_beat <= {BEAT_BITS{1'b0}};
+              stat_writebacks <= stat_writebacks + 1;
+              `ifdef DEBUG_DCACHE
+              $display("[DCACHE] Writeback line 0x%h", {eng_victim_line, {OFFSET_BITS{1'b0}}});
+              `endif
+              if (eng_flush)
+                eng_state <= E_INVAL;
+              else if (&mshr_mask[eng_mshr])
+                eng_state <= E_INSTALL;
+              else
+                eng_state <= E_REFILL;
+            end
+          end
+        end
+
+        E_REFILL: begin
+          if (mem_req_ready) begin
+            eng_buf[eng_beat * 64 +: 64] <= mem_req_rdata;
+            eng_beat <= eng_beat + 1'b1;
+            if (eng_beat == DWORDS - 1)
+              eng_state <= E_INSTALL;
+          end
+        end
+
+        E_INSTALL: begin
+          line_data[eng_idx]  <= merge_line(eng_buf, mshr_data[eng_mshr], mshr_mask[eng_mshr]);
+          line_tag[eng_idx]   <= line_tagof(eng_line);
+          line_valid[eng_idx] <= 1'b1;
+          line_dirty[eng_idx] <= |mshr_mask[eng_mshr];
+          line_shared[eng_idx] <= COHERENT && !eng_excl && eng_shared;
+          if (WAYS > 1)
+            plru[eng_set] <= plru_touch(plru[eng_set], eng_way);
+          mshr_valid[eng_mshr] <= 1'b0;
+          eng_state <= E_IDLE;
+          `ifdef DEBUG_DCACHE
+          $display("[DCACHE] Install line 0x%h set=%0d way=%0d dirty=%b",
+                   {eng_line, {OFFSET_BITS{1'b0}}}, eng_set, eng_way, |mshr_mask[eng_mshr]);
+          `endif
+        end
+
+        E_INVAL: begin
+          line_valid[eng_idx] <= 1'b0;
+          line_dirty[eng_idx] <= 1'b0;
+          line_shared[eng_idx] <= 1'b0;
+          eng_flush <= 1'b0;
+          eng_state <= E_IDLE;
+        end
+
+        default: eng_state <= E_IDLE;
+      endcase
+    end
+  end
+
+endmodule
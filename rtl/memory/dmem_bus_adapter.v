@@ -2,6 +2,8 @@
 // Adapts the data_memory module to the simple_bus interface
 // Author: RV1 Project
 // Date: 2025-10-27
+// Updated: 2026-10-16 - Near-memory AMOs: a read with req_amo writes back
+//                       amo_alu(old value, req_wdata) in its second cycle
 
 `include "config/rv_config.vh"
 
@@ -20,6 +22,8 @@ module dmem_bus_adapter #(
   input  wire [63:0]      req_wdata,
   input  wire             req_we,
   input  wire [2:0]       req_size,
+  input  wire             req_amo,      // Read-modify-write (near-memory AMO)
+  input  wire [4:0]       req_amo_op,   // AMO funct5
   output wire             req_ready,
   output wire [63:0]      req_rdata
 );
@@ -58,6 +62,27 @@ module dmem_bus_adapter #(
   //          Ready on second cycle (read_in_progress_r)
   assign req_ready = req_we || read_in_progress_r;
 
+  // Near-memory AMO (ENABLE_NEAR_MEM_AMO): the request is a read whose
+  // req_wdata holds rs2. In cycle N+1 read_data holds the old value, which is
+  // returned as for a load while the computed value is written at the same
+  // edge. The array is not accessed by anyone else in between, so the
+  // read-modify-write is atomic without a bus lock
+  wire [63:0]     amo_old = req_rdata;
+  wire [XLEN-1:0] amo_new;
+  wire            amo_write = req_valid && req_amo && !req_we && read_in_progress_r;
+
+  amo_alu #(
+    .XLEN(XLEN)
+  ) amo_alu_inst (
+    .op(req_amo_op),
+    .word(req_size[1:0] == 2'b10),
+    .mem_value(amo_old[XLEN-1:0]),
+    .src(req_wdata[XLEN-1:0]),
+    .result(amo_new)
+  );
+
+  wire [63:0] mem_wdata = amo_write ? {{(64-XLEN){1'b0}}, amo_new} : req_wdata;
+
   // Instantiate data memory
   data_memory #(
     .XLEN(XLEN),
@@ -67,9 +92,9 @@ module dmem_bus_adapter #(
   ) dmem (
     .clk(clk),
     .addr(req_addr),
-    .write_data(req_wdata),
+    .write_data(mem_wdata),
     .mem_read(req_valid && !req_we),
-    .mem_write(req_valid && req_we),
+    .mem_write((req_valid && req_we) || amo_write),
     .funct3(req_size),
     .read_data(req_rdata)
   );
@@ -0,0 +1,76 @@
+// dmem_split_adapter.v - Pipelined Split-Transaction Port for Data Memory
+// Attaches the data_memory module to a split_bus slave port
+// Author: RV1 Project
+// Date: 2026-10-16
+// Updated: 2026-10-16 - ID_WIDTH default no longer from rv_config.vh
+//
+// Features:
+// - Accepts one request per cycle (the registered read port is read at the
+//   accepting edge)
+// - Every request gets a response one cycle later with its ID: read data for
+//   loads, an acknowledge for stores
+// - Back-to-back reads overlap: while response N is presented, request N+1 is
+//   being read, so streaming reads cost one cycle each instead of two as with
+//   dmem_bus_adapter.v
+// - A stalled response (resp_ready=0) stops new requests; the memory's read
+//   register holds the data until it is taken
+
+`include "config/rv_config.vh"
+
+module dmem_split_adapter #(
+  parameter XLEN     = `XLEN,
+  parameter FLEN     = `FLEN,
+  parameter ID_WIDTH = 5,  // split_bus SID_WIDTH
+  parameter MEM_SIZE = 16384,
+  parameter MEM_FILE = ""
+) (
+  input  wire                clk,
+  input  wire                reset_n,
+
+  // Split-transaction slave port
+  input  wire                req_valid,
+  output wire                req_ready,
+  input  wire [ID_WIDTH-1:0] req_id,
+  input  wire [XLEN-1:0]     req_addr,
+  input  wire [63:0]         req_wdata,
+  input  wire                req_we,
+  input  wire [2:0]          req_size,
+
+  output reg                 resp_valid,
+  input  wire                resp_ready,
+  output reg  [ID_WIDTH-1:0] resp_id,
+  output wire [63:0]         resp_rdata
+);
+
+  assign req_ready = !resp_valid || resp_ready;
+
+  wire accept = req_valid && req_ready;
+
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      resp_valid <= 1'b0;
+      resp_id    <= {ID_WIDTH{1'b0}};
+    end else if (accept) begin
+      resp_valid <= 1'b1;
+      resp_id    <= req_id;
+    end else if (resp_ready) begin
+      resp_valid <= 1'b0;
+    end
+  end
+
+  data_memory #(
+    .XLEN(XLEN),
+    .FLEN(FLEN),
+    .MEM_SIZE(MEM_SIZE),
+    .MEM_FILE(MEM_FILE)
+  ) dmem (
+    .clk(clk),
+    .addr(req_addr),
+    .write_data(req_wdata),
+    .mem_read(accept && !req_we),
+    .mem_write(accept && req_we),
+    .funct3(req_size),
+    .read_data(resp_rdata)
+  );
+
+endmodule
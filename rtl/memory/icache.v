@@ -0,0 +1,313 @@
+// icache.v - Set-Associative Instruction Cache
+// Sits between the IF stage and a word-wide refill port (imem_bus_adapter)
+// Features:
+//   - Parameterized size / line size / associativity (ICACHE_* in rv_config.vh)
+//   - Tree pseudo-LRU replacement (invalid ways are filled first)
+//   - Critical-word-first refill with early restart (per-word valid during fill)
+//   - Halfword-aligned 32-bit fetch for RVC, including fetches that straddle
+//     two words or two lines
+//   - Whole-cache invalidate for FENCE.I
+//   - Next-word output for word-aligned fetches (64-bit dual-issue bundle)
+//   - Prefetch port: allocates and refills an absent line while the refill
+//     engine is idle and no demand miss is waiting (next-line prefetcher)
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`include "config/rv_config.vh"
+
+module icache #(
+  parameter XLEN       = `XLEN,
+  parameter CACHE_SIZE = `ICACHE_SIZE,       // Bytes
+  parameter LINE_SIZE  = `ICACHE_LINE_SIZE,  // Bytes (power of 2, >= 4)
+  parameter WAYS       = `ICACHE_WAYS        // Power of 2
+) (
+  input  wire             clk,
+  input  wire             reset_n,
+
+  // Fetch interface (combinational hit path)
+  input  wire             req_valid,
+  input  wire [XLEN-1:0]  req_addr,          // Halfword-aligned fetch address
+  output wire             req_hit,           // instruction valid this cycle
+  output wire [31:0]      instruction,       // 32 bits starting at req_addr
+  output wire             next_hit,          // next_word valid (word-aligned req_addr only)
+  output wire [31:0]      next_word,         // 32 bits at req_addr + 4
+
+  // Prefetch (line-aligned, physical)
+  input  wire             prefetch_valid,
+  input  wire [XLEN-1:0]  prefetch_addr,
+
+  // FENCE.I
+  input  wire             invalidate,
+
+  // Refill port (one 32-bit word per handshake)
+  output wire             mem_req_valid,
+  output wire [XLEN-1:0]  mem_req_addr,
+  input  wire             mem_req_ready,
+  input  wire [31:0]      mem_rdata,
+
+  // Statistics
+  output reg  [31:0]      stat_hits,
+  output reg  [31:0]      stat_misses,
+  output reg  [31:0]      stat_prefetches
+);
+
+  // =========================================================================
+  // Geometry
+  // =========================================================================
+
+  localparam WORDS       = LINE_SIZE / 4;
+  localparam NUM_SETS    = CACHE_SIZE / (LINE_SIZE * WAYS);
+  localparam WORD_BITS   = (WORDS > 1) ? $clog2(WORDS) : 1;
+  localparam OFFSET_BITS = $clog2(LINE_SIZE);
+  localparam INDEX_BITS  = (NUM_SETS > 1) ? $clog2(NUM_SETS) : 1;
+  localparam TAG_BITS    = XLEN - OFFSET_BITS - INDEX_BITS;
+  localparam WAY_BITS    = (WAYS > 1) ? $clog2(WAYS) : 1;
+  localparam PLRU_BITS   = (WAYS > 1) ? (WAYS - 1) : 1;
+
+  // =========================================================================
+  // Storage
+  // =========================================================================
+
+  reg                  line_valid [0:NUM_SETS*WAYS-1];
+  reg [TAG_BITS-1:0]   line_tag   [0:NUM_SETS*WAYS-1];
+  reg [31:0]           line_data  [0:NUM_SETS*WAYS*WORDS-1];
+  reg [PLRU_BITS-1:0]  plru       [0:NUM_SETS-1];
+
+  // Refill state
+  reg                  fill_active;
+  reg [INDEX_BITS-1:0] fill_set;
+  reg [WAY_BITS-1:0]   fill_way;
+  reg [TAG_BITS-1:0]   fill_tag;
+  reg [WORD_BITS-1:0]  fill_word;        // Next word to request (wraps)
+  reg [WORD_BITS:0]    fill_count;       // Words received
+  reg [WORDS-1:0]      fill_mask;        // Words of the line already written
+
+  // =========================================================================
+  // Address helpers (word address = byte address >> 2)
+  // =========================================================================
+
+  function [INDEX_BITS-1:0] addr_set;
+    input [XLEN-1:0] a;
+    begin
+      addr_set = (NUM_SETS > 1) ? a[OFFSET_BITS+INDEX_BITS-1:OFFSET_BITS] : {INDEX_BITS{1'b0}};
+    end
+  endfunction
+
+  function [TAG_BITS-1:0] addr_tag;
+    input [XLEN-1:0] a;
+    begin
+      addr_tag = a[XLEN-1:OFFSET_BITS+INDEX_BITS];
+    end
+  endfunction
+
+  function [WORD_BITS-1:0] addr_word;
+    input [XLEN-1:0] a;
+    begin
+      addr_word = (WORDS > 1) ? a[OFFSET_BITS-1:2] : {WORD_BITS{1'b0}};
+    end
+  endfunction
+
+  // Tree pseudo-LRU: bit=0 -> victim in left subtree, bit=1 -> right subtree
+  function [WAY_BITS-1:0] plru_victim;
+    input [PLRU_BITS-1:0] bits;
+    integer lvl, node;
+    begin
+      node = 0;
+      for (lvl = 0; lvl < WAY_BITS; lvl = lvl + 1)
+        node = 2 * node + 1 + bits[node];
+      plru_victim = node - (WAYS - 1);
+    end
+  endfunction
+
+  // Mark way as most recently used: point every node on its path away from it
+  function [PLRU_BITS-1:0] plru_touch;
+    input [PLRU_BITS-1:0] bits;
+    input [WAY_BITS-1:0]  way;
+    integer lvl, node;
+    reg dir;
+    begin
+      plru_touch = bits;
+      node = 0;
+      for (lvl = 0; lvl < WAY_BITS; lvl = lvl + 1) begin
+        dir = way[WAY_BITS-1-lvl];
+        plru_touch[node] = ~dir;
+        node = 2 * node + 1 + dir;
+      end
+    end
+  endfunction
+
+  // =========================================================================
+  // Lookup (combinational)
+  // =========================================================================
+  // A halfword-aligned fetch needs word0 (containing req_addr) and, when
+  // req_addr[1] is set and the low halfword is not a compressed instruction,
+  // the following word (which may live in the next line)
+
+  wire [XLEN-1:0] addr0 = {req_addr[XLEN-1:2], 2'b00};
+  wire [XLEN-1:0] addr1 = addr0 + 4;
+
+  reg              hit0, hit1;
+  reg [WAY_BITS-1:0] hit0_way;
+  reg [31:0]       word0, word1;
+
+  integer w;
+  always @(*) begin
+    hit0 = 1'b0;
+    hit1 = 1'b0;
+    hit0_way = {WAY_BITS{1'b0}};
+    word0 = 32'h0000_0013;  // NOP while missing
+    word1 = 32'h0000_0013;
+    for (w = 0; w < WAYS; w = w + 1) begin
+      if (line_valid[addr_set(addr0)*WAYS + w] &&
+          line_tag[addr_set(addr0)*WAYS + w] == addr_tag(addr0) &&
+          (!fill_active || fill_set != addr_set(addr0) || fill_way != w ||
+           fill_mask[addr_word(addr0)])) begin
+        hit0 = 1'b1;
+        hit0_way = w;
+        word0 = line_data[(addr_set(addr0)*WAYS + w)*WORDS + addr_word(addr0)];
+      end
+      if (line_valid[addr_set(addr1)*WAYS + w] &&
+          line_tag[addr_set(addr1)*WAYS + w] == addr_tag(addr1) &&
+          (!fill_active || fill_set != addr_set(addr1) || fill_way != w ||
+           fill_mask[addr_word(addr1)])) begin
+        hit1 = 1'b1;
+        word1 = line_data[(addr_set(addr1)*WAYS + w)*WORDS + addr_word(addr1)];
+      end
+    end
+  end
+
+  wire [15:0] low_half    = req_addr[1] ? word0[31:16] : word0[15:0];
+  wire        need_word1  = req_addr[1] && (low_half[1:0] == 2'b11);
+
+  assign req_hit     = req_valid && hit0 && (!need_word1 || hit1);
+  assign instruction = req_addr[1] ? {word1[15:0], word0[31:16]} : word0;
+
+  // Second half of a 64-bit fetch bundle; never causes a miss on its own
+  assign next_hit    = req_valid && hit0 && hit1 && !req_addr[1];
+  assign next_word   = word1;
+
+  // Address of the word to refill on a miss
+  wire [XLEN-1:0] miss_addr = hit0 ? addr1 : addr0;
+
+  // Prefetch lookup: tag match only (a line being filled counts as present)
+  reg pf_present;
+
+  integer p;
+  always @(*) begin
+    pf_present = 1'b0;
+    for (p = 0; p < WAYS; p = p + 1)
+      if (line_valid[addr_set(prefetch_addr)*WAYS + p] &&
+          line_tag[addr_set(prefetch_addr)*WAYS + p] == addr_tag(prefetch_addr))
+        pf_present = 1'b1;
+  end
+
+  // Demand misses always win the refill engine
+  wire            demand_miss   = req_valid && !req_hit;
+  wire            prefetch_miss = prefetch_valid && !pf_present && !demand_miss;
+  wire [XLEN-1:0] alloc_addr    = demand_miss ? miss_addr : prefetch_addr;
+
+  // =========================================================================
+  // Victim selection for alloc_addr's set
+  // =========================================================================
+
+  reg              victim_found_invalid;
+  reg [WAY_BITS-1:0] victim_way;
+
+  integer v;
+  always @(*) begin
+    victim_found_invalid = 1'b0;
+    victim_way = (WAYS > 1) ? plru_victim(plru[addr_set(alloc_addr)]) : {WAY_BITS{1'b0}};
+    for (v = WAYS - 1; v >= 0; v = v - 1) begin
+      if (!line_valid[addr_set(alloc_addr)*WAYS + v]) begin
+        victim_found_invalid = 1'b1;
+        victim_way = v;
+      end
+    end
+  end
+
+  // =========================================================================
+  // Refill port
+  // =========================================================================
+
+  assign mem_req_valid = fill_active;
+  assign mem_req_addr  = {fill_tag, fill_set, fill_word, 2'b00};
+
+  // =========================================================================
+  // Sequential: allocation, refill, replacement state, invalidation
+  // =========================================================================
+
+  integer i;
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      for (i = 0; i < NUM_SETS*WAYS; i = i + 1) begin
+        line_valid[i] <= 1'b0;
+        line_tag[i]   <= {TAG_BITS{1'b0}};
+      end
+      for (i = 0; i < NUM_SETS; i = i + 1)
+        plru[i] <= {PLRU_BITS{1'b0}};
+      fill_active <= 1'b0;
+      fill_set    <= {INDEX_BITS{1'b0}};
+      fill_way    <= {WAY_BITS{1'b0}};
+      fill_tag    <= {TAG_BITS{1'b0}};
+      fill_word   <= {WORD_BITS{1'b0}};
+      fill_count  <= {(WORD_BITS+1){1'b0}};
+      fill_mask   <= {WORDS{1'b0}};
+      stat_hits   <= 32'd0;
+      stat_misses <= 32'd0;
+      stat_prefetches <= 32'd0;
+    end else begin
+      // Replacement state follows fetch hits
+      if (req_hit) begin
+        if (WAYS > 1)
+          plru[addr_set(addr0)] <= plru_touch(plru[addr_set(addr0)], hit0_way);
+        stat_hits <= stat_hits + 1;
+      end
+
+      if (fill_active) begin
+        // Refill in progress: one word per handshake, starting at the critical word
+        if (mem_req_ready) begin
+          line_data[(fill_set*WAYS + fill_way)*WORDS + fill_word] <= mem_rdata;
+          fill_mask[fill_word] <= 1'b1;
+          fill_word  <= fill_word + 1'b1;
+          fill_count <= fill_count + 1'b1;
+          if (fill_count == WORDS - 1)
+            fill_active <= 1'b0;
+        end
+      end else if ((demand_miss || prefetch_miss) && !invalidate) begin
+        // Miss or prefetch: allocate victim way, tag becomes valid immediately;
+        // words become visible as they arrive (early restart)
+        line_valid[addr_set(alloc_addr)*WAYS + victim_way] <= 1'b1;
+        line_tag[addr_set(alloc_addr)*WAYS + victim_way]   <= addr_tag(alloc_addr);
+        if (WAYS > 1)
+          plru[addr_set(alloc_addr)] <= plru_touch(plru[addr_set(alloc_addr)], victim_way);
+        fill_active <= 1'b1;
+        fill_set    <= addr_set(alloc_addr);
+        fill_way    <= victim_way;
+        fill_tag    <= addr_tag(alloc_addr);
+        fill_word   <= addr_word(alloc_addr);
+        fill_count  <= {(WORD_BITS+1){1'b0}};
+        fill_mask   <= {WORDS{1'b0}};
+        if (demand_miss)
+          stat_misses <= stat_misses + 1;
+        else
+          stat_prefetches <= stat_prefetches + 1;
+        `ifdef DEBUG_ICACHE
+        $display("[ICACHE] %s addr=0x%h set=%0d way=%0d (invalid=%b)",
+                 demand_miss ? "Miss" : "Prefetch",
+                 alloc_addr, addr_set(alloc_addr), victim_way, victim_found_invalid);
+        `endif
+      end
+
+      // FENCE.I: drop every line (an in-flight refill still completes into
+      // the now-invalid line and is simply refetched later)
+      if (invalidate) begin
+        for (i = 0; i < NUM_SETS*WAYS; i = i + 1)
+          line_valid[i] <= 1'b0;
+        `ifdef DEBUG_ICACHE
+        $display("[ICACHE] Invalidate all");
+        `endif
+      end
+    end
+  end
+
+endmodule
@@ -0,0 +1,62 @@
+// imem_bus_adapter.v - IMEM Bus Adapter
+// Adapts instruction memory for bus access (read-only)
+// Author: RV1 Project
+// Date: 2025-10-27 (Session 33)
+// Updated: 2026-10-16 - LATENCY parameter, used as the I-cache refill port
+//
+// Purpose: Allow data loads from IMEM for .rodata section copy
+// This enables startup code to copy read-only data from IMEM to DMEM
+// in a Harvard architecture system.
+//
+// With LATENCY > 0 each read is held off for LATENCY cycles before
+// req_ready, modelling off-chip instruction memory behind the I-cache.
+// Protocol (LATENCY=2):
+// Cycle N:   req_valid=1 -> req_ready=0
+// Cycle N+1: req_valid=1 -> req_ready=0
+// Cycle N+2: req_valid=1 -> req_ready=1 (req_rdata valid, next read may start)
+
+`include "config/rv_config.vh"
+
+module imem_bus_adapter #(
+  parameter ADDR_WIDTH = 32,
+  parameter LATENCY    = 0     // Wait cycles per read (0 = combinational passthrough)
+) (
+  input  wire                   clk,
+  input  wire                   reset_n,
+
+  // Bus slave interface (read-only)
+  input  wire                   req_valid,
+  input  wire [ADDR_WIDTH-1:0]  req_addr,
+  output wire                   req_ready,
+  output wire [31:0]            req_rdata,
+
+  // Instruction memory interface
+  output wire [ADDR_WIDTH-1:0]  imem_addr,
+  input  wire [31:0]            imem_rdata
+);
+
+  // IMEM already has combinational read; only the handshake is delayed
+  assign imem_addr  = req_addr;
+  assign req_rdata  = imem_rdata;
+
+  generate
+    if (LATENCY == 0) begin : g_passthrough
+      assign req_ready = req_valid;  // Always ready for reads
+    end else begin : g_latency
+      reg [$clog2(LATENCY+1)-1:0] wait_count;
+
+      always @(posedge clk or negedge reset_n) begin
+        if (!reset_n) begin
+          wait_count <= 0;
+        end else if (req_valid && wait_count != LATENCY) begin
+          wait_count <= wait_count + 1'b1;
+        end else begin
+          wait_count <= 0;           // Completed (or idle): next read starts over
+        end
+      end
+
+      assign req_ready = req_valid && (wait_count == LATENCY);
+    end
+  endgenerate
+
+endmodule
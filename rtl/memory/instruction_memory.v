@@ -5,6 +5,9 @@
 // Updated: 2025-10-10 - Parameterized for XLEN (32/64-bit address support)
 // Updated: 2025-10-11 - Added write capability for FENCE.I compliance
 // Updated: 2025-10-11 - Added support for C extension (16-bit aligned access)
+// Updated: 2026-10-16 - Added next-word read for the dual-issue fetch bundle
+// Updated: 2026-10-16 - +IMEM_FILE=<hex> runtime image when MEM_FILE is empty
+// Updated: 2026-10-16 - RV_DPI_IMAGE: image copied in by the C++ driver over DPI-C
 
 `include "config/rv_config.vh"
 
@@ -17,6 +20,7 @@ module instruction_memory #(
   input  wire             clk,          // Clock for writes
   input  wire [XLEN-1:0]  addr,         // Byte address for reads
   output wire [31:0]      instruction,  // Instruction output (always 32-bit in base ISA)
+  output wire [31:0]      instruction_next, // 32 bits at addr + 4 (dual-issue bundle)
 
   // Write interface for FENCE.I support (self-modifying code)
   input  wire             mem_write,    // Write enable
@@ -28,16 +32,49 @@ module instruction_memory #(
   // Memory array (byte-addressed for easier hex file loading)
   reg [7:0] mem [0:MEM_SIZE-1];
 
+  // Runtime image (+IMEM_FILE=<hex>), used when MEM_FILE is not set at compile
+  // time so one simulator build (tb/verilator/rv_soc_sim) can run any program
+  reg [8*256-1:0] plusarg_file;
+
+`ifdef RV_DPI_IMAGE
+  // Program image held by the C++ driver (tb/verilator/rv_soc_sim.cpp): segment n
+  // of target 0 (IMEM) is [addr, addr+len); bytes are fetched one by one
+  import "DPI-C" function int  rv_image_segment(input int target, input int n,
+                                                output longint addr, output longint len);
+  import "DPI-C" function byte rv_image_byte(input int target, input int n,
+                                             input longint offset);
+`endif
+
   // Initialize memory
   initial begin
     integer i;
+    integer n;
+    reg [63:0] seg_addr;
+    reg [63:0] seg_len;
+    reg [63:0] off;
+    reg        dpi_loaded;
+
+    dpi_loaded = 1'b0;
+`ifdef RV_DPI_IMAGE
+    // ELF PT_LOAD segments straight into mem[] (addresses masked like fetches);
+    // no NOP fill and no hex file, so start-up does not scale with MEM_SIZE
+    n = 0;
+    while (rv_image_segment(0, n, seg_addr, seg_len) != 0) begin
+      for (off = 0; off < seg_len; off = off + 1)
+        mem[(seg_addr + off) & (MEM_SIZE - 1)] = rv_image_byte(0, n, off);
+      n = n + 1;
+      dpi_loaded = 1'b1;
+    end
+`endif
 
     // Initialize to NOP (ADDI x0, x0, 0) = 0x00000013 in little-endian bytes
-    for (i = 0; i < MEM_SIZE; i = i + 4) begin
-      mem[i]   = 8'h13;  // NOP byte 0
-      mem[i+1] = 8'h00;  // NOP byte 1
-      mem[i+2] = 8'h00;  // NOP byte 2
-      mem[i+3] = 8'h00;  // NOP byte 3
+    if (!dpi_loaded) begin
+      for (i = 0; i < MEM_SIZE; i = i + 4) begin
+        mem[i]   = 8'h13;  // NOP byte 0
+        mem[i+1] = 8'h00;  // NOP byte 1
+        mem[i+2] = 8'h00;  // NOP byte 2
+        mem[i+3] = 8'h00;  // NOP byte 3
+      end
     end
 
     // Load from file if specified
@@ -59,6 +96,8 @@ module instruction_memory #(
       $display("  [0x210c] = 0x%02h%02h%02h%02h", mem[32'h210f], mem[32'h210e], mem[32'h210d], mem[32'h210c]);
       $display("  [0x2110] = 0x%02h%02h%02h%02h", mem[32'h2113], mem[32'h2112], mem[32'h2111], mem[32'h2110]);
       $display("=================================");
+    end else if (!dpi_loaded && $value$plusargs("IMEM_FILE=%s", plusarg_file)) begin
+      $readmemh(plusarg_file, mem);
     end
   end
 
@@ -80,6 +119,11 @@ module instruction_memory #(
   assign instruction = {mem[read_addr+3], mem[read_addr+2],
                         mem[read_addr+1], mem[read_addr]};
 
+  // Second word of a 64-bit fetch bundle (wraps at the end of memory)
+  wire [XLEN-1:0] next_addr = (read_addr + 4) & (MEM_SIZE - 1);
+  assign instruction_next = {mem[next_addr+3], mem[next_addr+2],
+                             mem[next_addr+1], mem[next_addr]};
+
   // Debug: Monitor fetches at problematic address (using posedge clk to avoid spam)
   reg [XLEN-1:0] prev_addr;
   always @(posedge clk) begin
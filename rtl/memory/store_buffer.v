@@ -0,0 +1,370 @@
+// store_buffer.v - Coalescing Store Buffer
+// Sits between the core's MEM-stage bus arbiter and its bus master port, so
+// stores to memory retire as soon as they are buffered and drain to the bus
+// in the background
+// Features:
+//   - NUM_ENTRIES doubleword entries with byte masks (STORE_BUFFER_ENTRIES)
+//   - Stores to a doubleword already buffered (other than the entry being
+//     drained) merge into that entry
+//   - Loads fully covered by one entry are answered from the buffer; loads that
+//     touch no buffered byte go to the bus ahead of the buffered stores; loads
+//     that partially overlap wait until the overlapping stores have drained
+//   - Accesses outside [BUFFER_BASE, BUFFER_MASK] (MMIO) and ordered accesses
+//     (AMO/LR/SC) wait until the buffer is empty and then go straight through
+//   - drained output lets FENCE wait until every buffered store is visible
+//   - Near-memory AMO sideband (req_amo/req_amo_op) passed through with the
+//     ordered read it belongs to
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`include "config/rv_config.vh"
+
+module store_buffer #(
+  parameter XLEN        = `XLEN,
+  parameter NUM_ENTRIES = `STORE_BUFFER_ENTRIES,
+  parameter [XLEN-1:0] BUFFER_BASE = 32'h8000_0000,  // DMEM (see simple_bus.v)
+  parameter [XLEN-1:0] BUFFER_MASK = 32'hFFF0_0000
+) (
+  input  wire             clk,
+  input  wire             reset_n,
+
+  // Core side (bus slave)
+  input  wire             req_valid,
+  input  wire [XLEN-1:0]  req_addr,
+  input  wire [63:0]      req_wdata,
+  input  wire             req_we,
+  input  wire [2:0]       req_size,          // funct3: size + signedness
+  input  wire             req_ordered,       // Atomic access: never buffered or bypassed
+  input  wire             req_amo,           // Near-memory AMO (always ordered)
+  input  wire [4:0]       req_amo_op,
+  output wire             req_ready,
+  output wire [63:0]      req_rdata,
+
+  // All buffered stores written to the bus (and none being accepted)
+  output wire             drained,
+
+  // Bus side (bus master)
+  output reg              mem_req_valid,
+  output reg  [XLEN-1:0]  mem_req_addr,
+  output reg  [63:0]      mem_req_wdata,
+  output reg              mem_req_we,
+  output reg  [2:0]       mem_req_size,
+  output reg              mem_req_amo,
+  output reg  [4:0]       mem_req_amo_op,
+  input  wire             mem_req_ready,
+  input  wire [63:0]      mem_req_rdata
+);
+
+  localparam PTR_BITS = (NUM_ENTRIES > 1) ? $clog2(NUM_ENTRIES) : 1;
+  localparam DW_BITS  = XLEN - 3;  // Doubleword address (byte address >> 3)
+
+  // =========================================================================
+  // Storage
+  // =========================================================================
+
+  reg                 sb_valid [0:NUM_ENTRIES-1];
+  reg [DW_BITS-1:0]   sb_dw    [0:NUM_ENTRIES-1];
+  reg [63:0]          sb_data  [0:NUM_ENTRIES-1];
+  reg [7:0]           sb_mask  [0:NUM_ENTRIES-1];
+
+  reg [PTR_BITS-1:0]  head;
+  reg [PTR_BITS-1:0]  tail;
+  reg [PTR_BITS:0]    count;
+
+  reg                 drain_busy;        // Drain write presented, waiting for ready
+
+  // Store latch: the core drops req_we after the first cycle of a store, so a
+  // store that cannot be accepted immediately is captured here
+  reg                 pend_valid;
+  reg [XLEN-1:0]      pend_addr;
+  reg [63:0]          pend_wdata;
+  reg [2:0]           pend_size;
+  reg                 pend_ordered;
+
+  reg                 byp_issued;        // Pass-through store already presented
+
+  // =========================================================================
+  // Helpers
+  // =========================================================================
+
+  function [3:0] access_bytes;
+    input [2:0] size;
+    begin
+      case (size[1:0])
+        2'b00:   access_bytes = 4'd1;
+        2'b01:   access_bytes = 4'd2;
+        2'b10:   access_bytes = 4'd4;
+        default: access_bytes = 4'd8;
+      endcase
+    end
+  endfunction
+
+  // Same extension rules as data_memory.v
+  function [63:0] load_extend;
+    input [63:0] raw;
+    input [2:0]  size;
+    begin
+      case (size)
+        3'b000:  load_extend = {{56{raw[7]}}, raw[7:0]};
+        3'b001:  load_extend = {{48{raw[15]}}, raw[15:0]};
+        3'b010:  load_extend = {{32{raw[31]}}, raw[31:0]};
+        3'b011:  load_extend = raw;
+        3'b100:  load_extend = {56'h0, raw[7:0]};
+        3'b101:  load_extend = {48'h0, raw[15:0]};
+        3'b110:  load_extend = {32'h0, raw[31:0]};
+        default: load_extend = 64'h0;
+      endcase
+    end
+  endfunction
+
+  function [63:0] write_bytes;
+    input [63:0] dw;
+    input [2:0]  off;
+    input [63:0] wdata;
+    input [3:0]  nbytes;
+    integer b;
+    begin
+      write_bytes = dw;
+      for (b = 0; b < 8; b = b + 1)
+        if (b < nbytes && off + b < 8)
+          write_bytes[(off + b) * 8 +: 8] = wdata[b * 8 +: 8];
+    end
+  endfunction
+
+  // =========================================================================
+  // Current request (latched store takes precedence)
+  // =========================================================================
+
+  wire            cur_valid   = pend_valid || req_valid;
+  wire [XLEN-1:0] cur_addr    = pend_valid ? pend_addr    : req_addr;
+  wire [63:0]     cur_wdata   = pend_valid ? pend_wdata   : req_wdata;
+  wire            cur_we      = pend_valid ? 1'b1         : req_we;
+  wire [2:0]      cur_size    = pend_valid ? pend_size    : req_size;
+  wire            cur_ordered = pend_valid ? pend_ordered : req_ordered;
+
+  wire [3:0]         cur_nbytes = access_bytes(cur_size);
+  wire [2:0]         cur_off    = cur_addr[2:0];
+  wire [DW_BITS-1:0] cur_dw     = cur_addr[XLEN-1:3];
+  wire [DW_BITS-1:0] cur_dw_b   = cur_dw + 1'b1;      // Second doubleword of a crossing access
+
+  // Bytes touched in this doubleword ([7:0]) and the next one ([15:8])
+  wire [15:0] cur_mask16 = ((16'd1 << cur_nbytes) - 16'd1) << cur_off;
+  wire        cur_crosses = |cur_mask16[15:8];
+
+  wire cur_region   = ((cur_addr & BUFFER_MASK) == BUFFER_BASE) && !cur_ordered;
+  wire cur_buf_wr   = cur_valid && cur_we && cur_region && !cur_crosses;
+  wire cur_buf_rd   = cur_valid && !cur_we && cur_region;
+  wire cur_pass     = cur_valid && !cur_buf_wr && !cur_buf_rd;
+
+  // =========================================================================
+  // Buffer lookup
+  // =========================================================================
+
+  reg                merge_hit;
+  reg [PTR_BITS-1:0] merge_idx;
+  reg [2:0]          overlap_count;
+  reg                fwd_cover;
+  reg [63:0]         fwd_data;
+
+  integer e;
+  always @(*) begin
+    merge_hit = 1'b0;
+    merge_idx = {PTR_BITS{1'b0}};
+    overlap_count = 3'd0;
+    fwd_cover = 1'b0;
+    fwd_data = 64'h0;
+    for (e = 0; e < NUM_ENTRIES; e = e + 1) begin
+      if (sb_valid[e]) begin
+        // Stores merge into any entry for the same doubleword except the head,
+        // which may be partway through draining
+        if (sb_dw[e] == cur_dw && e != head) begin
+          merge_hit = 1'b1;
+          merge_idx = e;
+        end
+        if ((sb_dw[e] == cur_dw && |(sb_mask[e] & cur_mask16[7:0])) ||
+            (sb_dw[e] == cur_dw_b && |(sb_mask[e] & cur_mask16[15:8]))) begin
+          overlap_count = overlap_count + 1'b1;
+          if (sb_dw[e] == cur_dw && (sb_mask[e] & cur_mask16[7:0]) == cur_mask16[7:0]) begin
+            fwd_cover = 1'b1;
+            fwd_data = sb_data[e];
+          end
+        end
+      end
+    end
+  end
+
+  // Load answered from the buffer: exactly one entry overlaps and it holds
+  // every byte of the (non-crossing) load
+  wire fwd_ok   = !cur_crosses && overlap_count == 3'd1 && fwd_cover;
+  wire [63:0] fwd_shift = fwd_data >> {cur_off, 3'b000};
+  wire [63:0] fwd_rdata = load_extend(fwd_shift, cur_size);
+
+  // =========================================================================
+  // Request outcome
+  // =========================================================================
+
+  wire buf_full   = (count == NUM_ENTRIES);
+  wire wr_accept  = cur_buf_wr && (merge_hit || !buf_full);
+  wire fwd_done   = cur_buf_rd && fwd_ok;
+
+  // Loads that miss the buffer go to the bus unless a drain write is in flight
+  wire rd_bus     = cur_buf_rd && overlap_count == 3'd0 && !drain_busy;
+
+  // MMIO / atomic accesses once everything older is on the bus
+  wire pass_active = cur_pass && (count == 0);
+
+  wire drain_bus  = (count != 0) && (drain_busy || !rd_bus);
+
+  wire cur_done = wr_accept || fwd_done || (rd_bus && mem_req_ready) ||
+                  (pass_active && mem_req_ready);
+
+  assign req_ready = req_valid && cur_done && (!pend_valid || req_addr == pend_addr);
+  assign req_rdata = fwd_done ? fwd_rdata : mem_req_rdata;
+  assign drained   = (count == 0) && !cur_buf_wr;
+
+  // =========================================================================
+  // Drain: write the head entry as naturally aligned chunks of its mask
+  // =========================================================================
+
+  wire [7:0]  head_mask = sb_mask[head];
+  wire [63:0] head_data = sb_data[head];
+
+  reg [2:0] drn_off;
+  reg [1:0] drn_lg;                       // log2(bytes)
+  integer b;
+  always @(*) begin
+    drn_off = 3'd0;
+    for (b = 7; b >= 0; b = b - 1)
+      if (head_mask[b])
+        drn_off = b;
+    if (head_mask == 8'hFF)
+      drn_lg = 2'd3;
+    else if (drn_off[1:0] == 2'b00 && ((head_mask >> drn_off) & 8'h0F) == 8'h0F)
+      drn_lg = 2'd2;
+    else if (!drn_off[0] && ((head_mask >> drn_off) & 8'h03) == 8'h03)
+      drn_lg = 2'd1;
+    else
+      drn_lg = 2'd0;
+  end
+
+  wire [7:0] drn_chunk = (((8'd1 << (4'd1 << drn_lg)) - 8'd1) << drn_off);
+
+  // =========================================================================
+  // Bus port
+  // =========================================================================
+
+  always @(*) begin
+    mem_req_valid = 1'b0;
+    mem_req_addr  = {XLEN{1'b0}};
+    mem_req_wdata = 64'h0;
+    mem_req_we    = 1'b0;
+    mem_req_size  = 3'b010;
+    mem_req_amo   = 1'b0;
+    mem_req_amo_op = 5'd0;
+    if (drain_bus) begin
+      mem_req_valid = 1'b1;
+      mem_req_addr  = {sb_dw[head], drn_off};
+      mem_req_wdata = head_data >> {drn_off, 3'b000};
+      mem_req_we    = !drain_busy;        // One-shot, like the core's bus port
+      mem_req_size  = {1'b0, drn_lg};
+    end else if (rd_bus) begin
+      mem_req_valid = 1'b1;
+      mem_req_addr  = cur_addr;
+      mem_req_size  = cur_size;
+    end else if (pass_active) begin
+      mem_req_valid = 1'b1;
+      mem_req_addr  = cur_addr;
+      mem_req_wdata = cur_wdata;
+      mem_req_we    = cur_we && !byp_issued;
+      mem_req_size  = cur_size;
+      mem_req_amo   = req_amo && !pend_valid;
+      mem_req_amo_op = req_amo_op;
+    end
+  end
+
+  // =========================================================================
+  // Sequential
+  // =========================================================================
+
+  wire drain_ack  = drain_bus && mem_req_ready;
+  wire drain_pop  = drain_ack && ((head_mask & ~drn_chunk) == 8'h00);
+  wire alloc      = wr_accept && !merge_hit;
+
+  integer i;
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+      for (i = 0; i < NUM_ENTRIES; i = i + 1) begin
+        sb_valid[i] <= 1'b0;
+        sb_dw[i]    <= {DW_BITS{1'b0}};
+        sb_data[i]  <= 64'h0;
+        sb_mask[i]  <= 8'h00;
+      end
+      head         <= {PTR_BITS{1'b0}};
+      tail         <= {PTR_BITS{1'b0}};
+      count        <= {(PTR_BITS+1){1'b0}};
+      drain_busy   <= 1'b0;
+      pend_valid   <= 1'b0;
+      pend_addr    <= {XLEN{1'b0}};
+      pend_wdata   <= 64'h0;
+      pend_size    <= 3'b0;
+      pend_ordered <= 1'b0;
+      byp_issued   <= 1'b0;
+    end else begin
+      // Accept / merge a store
+      if (wr_accept) begin
+        if (merge_hit) begin
+          sb_data[merge_idx] <= write_bytes(sb_data[merge_idx], cur_off, cur_wdata, cur_nbytes);
+          sb_mask[merge_idx] <= sb_mask[merge_idx] | cur_mask16[7:0];
+        end else begin
+          sb_valid[tail] <= 1'b1;
+          sb_dw[tail]    <= cur_dw;
+          sb_data[tail]  <= write_bytes(64'h0, cur_off, cur_wdata, cur_nbytes);
+          sb_mask[tail]  <= cur_mask16[7:0];
+          tail <= (tail == NUM_ENTRIES - 1) ? {PTR_BITS{1'b0}} : tail + 1'b1;
+        end
+        `ifdef DEBUG_STORE_BUFFER
+        $display("[SB] %s addr=0x%h data=0x%h size=%0d count=%0d",
+                 merge_hit ? "Merge" : "Alloc", cur_addr, cur_wdata, cur_size, count);
+        `endif
+      end
+
+      // Drain the head entry
+      if (drain_bus) begin
+        if (mem_req_ready) begin
+          drain_busy <= 1'b0;
+          if (drain_pop) begin
+            sb_valid[head] <= 1'b0;
+            head <= (head == NUM_ENTRIES - 1) ? {PTR_BITS{1'b0}} : head + 1'b1;
+          end else begin
+            sb_mask[head] <= head_mask & ~drn_chunk;
+          end
+          `ifdef DEBUG_STORE_BUFFER
+          $display("[SB] Drain addr=0x%h data=0x%h size=%0d",
+                   mem_req_addr, mem_req_wdata, mem_req_size);
+          `endif
+        end else begin
+          drain_busy <= 1'b1;
+        end
+      end
+
+      count <= count + (alloc ? 1'b1 : 1'b0) - (drain_pop ? 1'b1 : 1'b0);
+
+      // Store latch
+      if (cur_done)
+        pend_valid <= 1'b0;
+      else if (!pend_valid && req_valid && req_we) begin
+        pend_valid   <= 1'b1;
+        pend_addr    <= req_addr;
+        pend_wdata   <= req_wdata;
+        pend_size    <= req_size;
+        pend_ordered <= req_ordered;
+      end
+
+      if (!pass_active || mem_req_ready)
+        byp_issued <= 1'b0;
+      else if (cur_we)
+        byp_issued <= 1'b1;
+    end
+  end
+
+endmodule
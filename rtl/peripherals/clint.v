@@ -3,6 +3,7 @@
 // Compatible with QEMU virt machine and SiFive devices
 // Author: RV1 Project
 // Date: 2025-10-26
+// Updated: 2026-10-16 - mtime output for the cores' time CSR
 //
 // Memory Map (Base: 0x0200_0000):
 //   0x0000 - 0x3FFF: MSIP (Machine Software Interrupt Pending) - 4 bytes per hart
@@ -36,7 +37,10 @@ module clint #(
 
   // Interrupt outputs (one per hart)
   output wire [NUM_HARTS-1:0]       mti_o,       // Machine Timer Interrupt
-  output wire [NUM_HARTS-1:0]       msi_o        // Machine Software Interrupt
+  output wire [NUM_HARTS-1:0]       msi_o,       // Machine Software Interrupt
+
+  // Real-time counter, read by the cores through the time CSR
+  output wire [63:0]                mtime_o
 );
 
   //===========================================================================
@@ -46,6 +50,7 @@ module clint #(
   // MTIME: 64-bit real-time counter (shared across all harts)
   // Increments every clock cycle
   reg [63:0] mtime;
+  assign mtime_o = mtime;
 
   // MTIMECMP: 64-bit timer compare register (one per hart)
   // When mtime >= mtimecmp[i], mti_o[i] is asserted
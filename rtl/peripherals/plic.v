@@ -3,6 +3,7 @@
 // Compatible with QEMU virt machine and SiFive devices
 // Author: RV1 Project
 // Date: 2025-10-27
+// Updated: 2026-10-16 - One M/S context pair per hart
 //
 // Memory Map (Base: 0x0C00_0000):
 //   0x000000 - 0x000FFF: Interrupt Source Priorities (1-31, 4 bytes each)
@@ -13,6 +14,8 @@
 //   0x200004 - 0x200007: M-mode Hart 0 Claim/Complete
 //   0x201000 - 0x201003: S-mode Hart 0 Priority Threshold
 //   0x201004 - 0x201007: S-mode Hart 0 Claim/Complete
+//   Context c = 2*hart + mode (0=M, 1=S): enables at 0x002000 + c*0x80,
+//   threshold/claim at 0x200000 + c*0x1000 (same layout as QEMU virt)
 //
 // Features:
 // - 32 interrupt sources (source 0 reserved, 1-31 usable)
@@ -20,6 +23,8 @@
 // - Per-hart, per-mode interrupt enables
 // - Claim/complete mechanism for interrupt acknowledgment
 // - Supports M-mode and S-mode contexts
+// - A source claimed by one context is not offered to the others until it is
+//   completed (multi-hart: only one hart services each interrupt)
 
 `include "config/rv_config.vh"
 
@@ -86,6 +91,7 @@ module plic #(
   localparam ADDR_CLAIM_M       = 24'h200004;  // 0x200004 - 0x200007 (hart 0 M-mode)
   localparam ADDR_THRESHOLD_S   = 24'h201000;  // 0x201000 - 0x201003 (hart 0 S-mode)
   localparam ADDR_CLAIM_S       = 24'h201004;  // 0x201004 - 0x201007 (hart 0 S-mode)
+  // Other harts: hart h's contexts follow at +h*0x100 (enables), +h*0x2000 (threshold/claim)
 
   wire is_priority;
   wire is_pending;
@@ -98,15 +104,24 @@ module plic #(
 
   wire [4:0] priority_id;  // Which source priority (0-31)
 
+  // Context of an enable or threshold/claim access (context = 2*hart + mode)
+  wire       in_enable  = (req_addr[23:12] == 12'h002) && (req_addr[6:0] == 7'h0);
+  wire       in_context = (req_addr[23:21] == 3'b001);
+  wire [8:0] enable_ctx = {4'h0, req_addr[11:7]};
+  wire [8:0] context_id = req_addr[20:12];
+  wire [8:0] req_ctx    = in_enable ? enable_ctx : context_id;
+  wire [7:0] req_hart   = req_ctx[8:1];  // Hart whose register is accessed
+  wire       hart_ok    = (req_hart < NUM_HARTS);
+
   // Decode address
   assign is_priority    = (req_addr < 24'h001000);  // 0x000000 - 0x000FFF
   assign is_pending     = (req_addr == ADDR_PENDING);
-  assign is_enable_m    = (req_addr == ADDR_ENABLE_M);
-  assign is_enable_s    = (req_addr == ADDR_ENABLE_S);
-  assign is_threshold_m = (req_addr == ADDR_THRESHOLD_M);
-  assign is_claim_m     = (req_addr == ADDR_CLAIM_M);
-  assign is_threshold_s = (req_addr == ADDR_THRESHOLD_S);
-  assign is_claim_s     = (req_addr == ADDR_CLAIM_S);
+  assign is_enable_m    = in_enable && hart_ok && !req_ctx[0];
+  assign is_enable_s    = in_enable && hart_ok &&  req_ctx[0];
+  assign is_threshold_m = in_context && hart_ok && !req_ctx[0] && (req_addr[11:0] == 12'h000);
+  assign is_claim_m     = in_context && hart_ok && !req_ctx[0] && (req_addr[11:0] == 12'h004);
+  assign is_threshold_s = in_context && hart_ok &&  req_ctx[0] && (req_addr[11:0] == 12'h000);
+  assign is_claim_s     = in_context && hart_ok &&  req_ctx[0] && (req_addr[11:0] == 12'h004);
 
   // Calculate source ID for priority access (address / 4)
   assign priority_id = req_addr[6:2];  // Divide by 4 to get source ID
@@ -138,37 +153,58 @@ module plic #(
   // Priority Arbitration (Find Highest Priority Pending Interrupt)
   //===========================================================================
 
-  // For M-mode hart 0
-  reg [4:0] highest_id_m;
-  reg [2:0] highest_pri_m;
+  // Per hart, per mode
+  reg [4:0] highest_id_m  [0:NUM_HARTS-1];
+  reg [2:0] highest_pri_m [0:NUM_HARTS-1];
+  reg [4:0] highest_id_s  [0:NUM_HARTS-1];
+  reg [2:0] highest_pri_s [0:NUM_HARTS-1];
+
+  // Sources in service: claimed by some context and not yet completed
+  // (a claimed source is not offered to the other contexts)
+  reg [NUM_SOURCES-1:0] claimed_by_m [0:NUM_HARTS-1];
+  reg [NUM_SOURCES-1:0] claimed_by_s [0:NUM_HARTS-1];
+  reg [NUM_SOURCES-1:0] in_service;
 
-  // For S-mode hart 0
-  reg [4:0] highest_id_s;
-  reg [2:0] highest_pri_s;
+  integer h, k;
 
   always @(*) begin
-    // M-mode arbitration
-    highest_id_m = 5'd0;
-    highest_pri_m = 3'd0;
-
-    for (i = 1; i < NUM_SOURCES; i = i + 1) begin
-      if (pending[i] && enables_m[0][i] && (priorities[i] > threshold_m[0])) begin
-        if (priorities[i] > highest_pri_m) begin
-          highest_id_m = i[4:0];
-          highest_pri_m = priorities[i];
+    in_service = {NUM_SOURCES{1'b0}};
+    for (h = 0; h < NUM_HARTS; h = h + 1) begin
+      claimed_by_m[h] = {NUM_SOURCES{1'b0}};
+      claimed_by_s[h] = {NUM_SOURCES{1'b0}};
+      if (claimed_m[h] != 5'd0)
+        claimed_by_m[h][claimed_m[h]] = 1'b1;
+      if (claimed_s[h] != 5'd0)
+        claimed_by_s[h][claimed_s[h]] = 1'b1;
+      in_service = in_service | claimed_by_m[h] | claimed_by_s[h];
+    end
+
+    for (h = 0; h < NUM_HARTS; h = h + 1) begin
+      // M-mode arbitration
+      highest_id_m[h] = 5'd0;
+      highest_pri_m[h] = 3'd0;
+
+      for (k = 1; k < NUM_SOURCES; k = k + 1) begin
+        if (pending[k] && enables_m[h][k] && (priorities[k] > threshold_m[h]) &&
+            (!in_service[k] || claimed_by_m[h][k])) begin
+          if (priorities[k] > highest_pri_m[h]) begin
+            highest_id_m[h] = k[4:0];
+            highest_pri_m[h] = priorities[k];
+          end
         end
       end
-    end
 
-    // S-mode arbitration
-    highest_id_s = 5'd0;
-    highest_pri_s = 3'd0;
+      // S-mode arbitration
+      highest_id_s[h] = 5'd0;
+      highest_pri_s[h] = 3'd0;
 
-    for (i = 1; i < NUM_SOURCES; i = i + 1) begin
-      if (pending[i] && enables_s[0][i] && (priorities[i] > threshold_s[0])) begin
-        if (priorities[i] > highest_pri_s) begin
-          highest_id_s = i[4:0];
-          highest_pri_s = priorities[i];
+      for (k = 1; k < NUM_SOURCES; k = k + 1) begin
+        if (pending[k] && enables_s[h][k] && (priorities[k] > threshold_s[h]) &&
+            (!in_service[k] || claimed_by_s[h][k])) begin
+          if (priorities[k] > highest_pri_s[h]) begin
+            highest_id_s[h] = k[4:0];
+            highest_pri_s[h] = priorities[k];
+          end
         end
       end
     end
@@ -178,11 +214,16 @@ module plic #(
   // Interrupt Output Generation
   //===========================================================================
 
-  // Assert MEI if there's a pending interrupt for M-mode
-  assign mei_o[0] = (highest_id_m != 5'd0);
+  genvar gh;
+  generate
+    for (gh = 0; gh < NUM_HARTS; gh = gh + 1) begin : g_hart_irq
+      // Assert MEI if there's a pending interrupt for M-mode
+      assign mei_o[gh] = (highest_id_m[gh] != 5'd0);
 
-  // Assert SEI if there's a pending interrupt for S-mode
-  assign sei_o[0] = (highest_id_s != 5'd0);
+      // Assert SEI if there's a pending interrupt for S-mode
+      assign sei_o[gh] = (highest_id_s[gh] != 5'd0);
+    end
+  endgenerate
 
   //===========================================================================
   // Memory-Mapped Register Access
@@ -216,28 +257,28 @@ module plic #(
           // Write to interrupt source priority (source 0 is read-only)
           priorities[priority_id] <= req_wdata[2:0];  // 3-bit priority
         end else if (is_enable_m) begin
-          // Write to M-mode interrupt enables (hart 0)
-          enables_m[0] <= req_wdata[NUM_SOURCES-1:0];
+          // Write to M-mode interrupt enables
+          enables_m[req_hart] <= req_wdata[NUM_SOURCES-1:0];
         end else if (is_enable_s) begin
-          // Write to S-mode interrupt enables (hart 0)
-          enables_s[0] <= req_wdata[NUM_SOURCES-1:0];
+          // Write to S-mode interrupt enables
+          enables_s[req_hart] <= req_wdata[NUM_SOURCES-1:0];
         end else if (is_threshold_m) begin
-          // Write to M-mode priority threshold (hart 0)
-          threshold_m[0] <= req_wdata[2:0];
+          // Write to M-mode priority threshold
+          threshold_m[req_hart] <= req_wdata[2:0];
         end else if (is_threshold_s) begin
-          // Write to S-mode priority threshold (hart 0)
-          threshold_s[0] <= req_wdata[2:0];
+          // Write to S-mode priority threshold
+          threshold_s[req_hart] <= req_wdata[2:0];
         end else if (is_claim_m) begin
           // Complete M-mode interrupt (write claimed ID back)
-          if (req_wdata[4:0] == claimed_m[0] && claimed_m[0] != 5'd0) begin
-            pending[claimed_m[0]] <= 1'b0;  // Clear pending bit
-            claimed_m[0] <= 5'd0;           // Clear claimed ID
+          if (req_wdata[4:0] == claimed_m[req_hart] && claimed_m[req_hart] != 5'd0) begin
+            pending[claimed_m[req_hart]] <= 1'b0;  // Clear pending bit
+            claimed_m[req_hart] <= 5'd0;           // Clear claimed ID
           end
         end else if (is_claim_s) begin
           // Complete S-mode interrupt (write claimed ID back)
-          if (req_wdata[4:0] == claimed_s[0] && claimed_s[0] != 5'd0) begin
-            pending[claimed_s[0]] <= 1'b0;  // Clear pending bit
-            claimed_s[0] <= 5'd0;           // Clear claimed ID
+          if (req_wdata[4:0] == claimed_s[req_hart] && claimed_s[req_hart] != 5'd0) begin
+            pending[claimed_s[req_hart]] <= 1'b0;  // Clear pending bit
+            claimed_s[req_hart] <= 5'd0;           // Clear claimed ID
           end
         end
         // Pending register is read-only, writes are ignored
@@ -256,29 +297,29 @@ module plic #(
           // Read interrupt pending bits (all 32 sources in 1 word)
           req_rdata <= pending;
         end else if (is_enable_m) begin
-          // Read M-mode interrupt enables (hart 0)
-          req_rdata <= enables_m[0];
+          // Read M-mode interrupt enables
+          req_rdata <= enables_m[req_hart];
         end else if (is_enable_s) begin
-          // Read S-mode interrupt enables (hart 0)
-          req_rdata <= enables_s[0];
+          // Read S-mode interrupt enables
+          req_rdata <= enables_s[req_hart];
         end else if (is_threshold_m) begin
-          // Read M-mode priority threshold (hart 0)
-          req_rdata <= {29'h0, threshold_m[0]};
+          // Read M-mode priority threshold
+          req_rdata <= {29'h0, threshold_m[req_hart]};
         end else if (is_threshold_s) begin
-          // Read S-mode priority threshold (hart 0)
-          req_rdata <= {29'h0, threshold_s[0]};
+          // Read S-mode priority threshold
+          req_rdata <= {29'h0, threshold_s[req_hart]};
         end else if (is_claim_m) begin
           // Claim M-mode interrupt (returns highest-priority pending ID)
-          req_rdata <= {27'h0, highest_id_m};
-          if (highest_id_m != 5'd0) begin
-            claimed_m[0] <= highest_id_m;  // Record claimed interrupt
+          req_rdata <= {27'h0, highest_id_m[req_hart]};
+          if (highest_id_m[req_hart] != 5'd0) begin
+            claimed_m[req_hart] <= highest_id_m[req_hart];  // Record claimed interrupt
             // Don't clear pending yet - wait for completion write
           end
         end else if (is_claim_s) begin
           // Claim S-mode interrupt (returns highest-priority pending ID)
-          req_rdata <= {27'h0, highest_id_s};
-          if (highest_id_s != 5'd0) begin
-            claimed_s[0] <= highest_id_s;  // Record claimed interrupt
+          req_rdata <= {27'h0, highest_id_s[req_hart]};
+          if (highest_id_s[req_hart] != 5'd0) begin
+            claimed_s[req_hart] <= highest_id_s[req_hart];  // Record claimed interrupt
             // Don't clear pending yet - wait for completion write
           end
         end else begin
@@ -315,16 +356,16 @@ module plic #(
         if (is_claim_s)
           $display("PLIC[@%t]: COMPLETE S-mode IRQ %0d", $time, req_wdata[4:0]);
       end else begin
-        if (is_claim_m && highest_id_m != 0)
-          $display("PLIC[@%t]: CLAIM M-mode IRQ %0d", $time, highest_id_m);
-        if (is_claim_s && highest_id_s != 0)
-          $display("PLIC[@%t]: CLAIM S-mode IRQ %0d", $time, highest_id_s);
+        if (is_claim_m && highest_id_m[req_hart] != 0)
+          $display("PLIC[@%t]: CLAIM M-mode IRQ %0d (hart %0d)", $time, highest_id_m[req_hart], req_hart);
+        if (is_claim_s && highest_id_s[req_hart] != 0)
+          $display("PLIC[@%t]: CLAIM S-mode IRQ %0d (hart %0d)", $time, highest_id_s[req_hart], req_hart);
       end
     end
     if (mei_o[0])
-      $display("PLIC[@%t]: MEI asserted (IRQ %0d, pri %0d)", $time, highest_id_m, highest_pri_m);
+      $display("PLIC[@%t]: MEI asserted (IRQ %0d, pri %0d)", $time, highest_id_m[0], highest_pri_m[0]);
     if (sei_o[0])
-      $display("PLIC[@%t]: SEI asserted (IRQ %0d, pri %0d)", $time, highest_id_s, highest_pri_s);
+      $display("PLIC[@%t]: SEI asserted (IRQ %0d, pri %0d)", $time, highest_id_s[0], highest_pri_s[0]);
   end
   `endif
 
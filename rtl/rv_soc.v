@@ -3,6 +3,11 @@
 // Phase 1.4: Complete SoC integration with memory-mapped peripherals
 // Author: RV1 Project
 // Date: 2025-10-27
+// Updated: 2026-10-16 - NUM_HARTS cores sharing simple_bus (bus_master_arbiter)
+// Updated: 2026-10-16 - MESI D-caches (coherence_hub) and optional shared L2
+// Updated: 2026-10-16 - Near-memory AMO sideband from the cores to DMEM
+// Updated: 2026-10-16 - CLINT mtime to the cores' time CSR
+// Updated: 2026-10-16 - Pipelined bus option (BUS_PIPELINED, split_bus)
 
 `include "config/rv_config.vh"
 
@@ -12,7 +17,7 @@ module rv_soc #(
   parameter IMEM_SIZE = 16384,      // 16KB instruction memory
   parameter DMEM_SIZE = 16384,      // 16KB data memory
   parameter MEM_FILE = "",
-  parameter NUM_HARTS = 1           // Number of hardware threads
+  parameter NUM_HARTS = `NUM_CORES  // Number of harts (one core each)
 ) (
   input  wire             clk,
   input  wire             reset_n,
@@ -37,22 +42,69 @@ module rv_soc #(
   // Interrupt signals (from peripherals)
   wire [NUM_HARTS-1:0] mtip_vec;      // Machine Timer Interrupt vector (from CLINT)
   wire [NUM_HARTS-1:0] msip_vec;      // Machine Software Interrupt vector (from CLINT)
+  wire [NUM_HARTS-1:0] meip_vec;      // Machine External Interrupt vector (from PLIC)
+  wire [NUM_HARTS-1:0] seip_vec;      // Supervisor External Interrupt vector (from PLIC)
+  wire [63:0]          clint_mtime;   // CLINT mtime (cores' time CSR)
   wire             mtip;              // Machine Timer Interrupt for hart 0
   wire             msip;              // Machine Software Interrupt for hart 0
-  wire             meip;              // Machine External Interrupt (from PLIC)
-  wire             seip;              // Supervisor External Interrupt (from PLIC)
 
   // Extract hart 0 interrupts from vectors
   assign mtip = mtip_vec[0];
   assign msip = msip_vec[0];
   wire             uart_irq;          // UART interrupt
 
-  // Bus signals - Master (Core)
+  // Per-hart bus master ports (after each hart's optional D-cache)
+  wire [NUM_HARTS-1:0]      hart_req_valid;
+  wire [NUM_HARTS*XLEN-1:0] hart_req_addr;
+  wire [NUM_HARTS*64-1:0]   hart_req_wdata;
+  wire [NUM_HARTS-1:0]      hart_req_we;
+  wire [NUM_HARTS*3-1:0]    hart_req_size;
+  wire [NUM_HARTS-1:0]      hart_req_lock;
+  wire [NUM_HARTS-1:0]      hart_req_amo;     // Near-memory AMO (ENABLE_NEAR_MEM_AMO)
+  wire [NUM_HARTS*5-1:0]    hart_req_amo_op;
+  wire [NUM_HARTS-1:0]      hart_req_ready;
+  wire [NUM_HARTS*64-1:0]   hart_req_rdata;   // Per hart (one copy each with simple_bus)
+
+  // Stores on the shared bus (for LR reservation invalidation in other harts)
+  wire                      snoop_valid;
+  wire [XLEN-1:0]           snoop_addr;
+  wire [31:0]               snoop_master;
+
+  // D-cache coherence (ENABLE_DCACHE && ENABLE_COHERENCY)
+  wire [NUM_HARTS-1:0]      coh_acq_valid;
+  wire [NUM_HARTS*XLEN-1:0] coh_acq_addr;
+  wire [NUM_HARTS-1:0]      coh_acq_excl;
+  wire [NUM_HARTS-1:0]      coh_acq_grant;
+  wire                      coh_acq_shared;
+  wire [NUM_HARTS-1:0]      coh_snp_valid;
+  wire [XLEN-1:0]           coh_snp_addr;
+  wire                      coh_snp_excl;
+  wire [NUM_HARTS-1:0]      coh_snp_ack;
+  wire [NUM_HARTS-1:0]      coh_snp_hit;
+
+  // Debug outputs of every hart (hart 0 drives pc_out/instr_out)
+  wire [NUM_HARTS*XLEN-1:0] hart_pc;
+  wire [NUM_HARTS*32-1:0]   hart_instr;
+
+  // Hart arbiter output (to the L2 cache, or straight to the bus)
+  wire             arb_req_valid;
+  wire [XLEN-1:0]  arb_req_addr;
+  wire [63:0]      arb_req_wdata;
+  wire             arb_req_we;
+  wire [2:0]       arb_req_size;
+  wire             arb_req_amo;
+  wire [4:0]       arb_req_amo_op;
+  wire             arb_req_ready;
+  wire [63:0]      arb_req_rdata;
+
+  // Bus signals - Master (arbiter or L2)
   wire             bus_master_req_valid;
   wire [XLEN-1:0]  bus_master_req_addr;
   wire [63:0]      bus_master_req_wdata;
   wire             bus_master_req_we;
   wire [2:0]       bus_master_req_size;
+  wire             bus_master_req_amo;
+  wire [4:0]       bus_master_req_amo_op;
   wire             bus_master_req_ready;
   wire [63:0]      bus_master_req_rdata;
 
@@ -79,6 +131,8 @@ module rv_soc #(
   wire [63:0]      dmem_req_wdata;
   wire             dmem_req_we;
   wire [2:0]       dmem_req_size;
+  wire             dmem_req_amo;
+  wire [4:0]       dmem_req_amo_op;
   wire             dmem_req_ready;
   wire [63:0]      dmem_req_rdata;
 
@@ -98,35 +152,441 @@ module rv_soc #(
   wire [31:0]      imem_req_rdata;
 
   //==========================================================================
-  // CPU Core
+  // CPU Cores (one per hart)
   //==========================================================================
+  // Every hart runs the same image from its own instruction memory and tells
+  // itself apart by mhartid. Data accesses of all harts share simple_bus
+  // (or split_bus with BUS_PIPELINED).
+
+  genvar h;
+  generate
+    for (h = 0; h < NUM_HARTS; h = h + 1) begin : g_hart
+      // Core data port (to D-cache, or straight to the arbiter)
+      wire             core_req_valid;
+      wire [XLEN-1:0]  core_req_addr;
+      wire [63:0]      core_req_wdata;
+      wire             core_req_we;
+      wire [2:0]       core_req_size;
+      wire             core_req_ready;
+      wire [63:0]      core_req_rdata;
+      wire             core_req_lock;
+      wire             core_req_amo;
+      wire [4:0]       core_req_amo_op;
+
+      rv_core_pipelined #(
+        .XLEN(XLEN),
+        .RESET_VECTOR(RESET_VECTOR),
+        .IMEM_SIZE(IMEM_SIZE),
+        .DMEM_SIZE(DMEM_SIZE),
+        .MEM_FILE(MEM_FILE),
+        .HART_ID(h)
+      ) core (
+        .clk(clk),
+        .reset_n(reset_n),
+        // Interrupts
+        .mtip_in(mtip_vec[h]),
+        .msip_in(msip_vec[h]),
+        .meip_in(meip_vec[h]),
+        .seip_in(seip_vec[h]),
+        .mtime_in(clint_mtime),
+        // Bus master interface
+        .bus_req_valid(core_req_valid),
+        .bus_req_addr(core_req_addr),
+        .bus_req_wdata(core_req_wdata),
+        .bus_req_we(core_req_we),
+        .bus_req_size(core_req_size),
+        .bus_req_ready(core_req_ready),
+        .bus_req_rdata(core_req_rdata),
+        .bus_req_lock(core_req_lock),
+        .bus_req_amo(core_req_amo),
+        .bus_req_amo_op(core_req_amo_op),
+        // Writes by the other harts: RdX snoops with coherent D-caches,
+        // bus writes otherwise
+        .snoop_wr_valid((`ENABLE_DCACHE && `ENABLE_COHERENCY) ? (coh_snp_valid[h] && coh_snp_excl) :
+                                                                (snoop_valid && (snoop_master != h))),
+        .snoop_wr_addr((`ENABLE_DCACHE && `ENABLE_COHERENCY) ? coh_snp_addr : snoop_addr),
+        // Debug
+        .pc_out(hart_pc[h*XLEN +: XLEN]),
+        .instr_out(hart_instr[h*32 +: 32])
+      );
+
+      //======================================================================
+      // Data Cache (optional, per core)
+      //======================================================================
+      // Caches the DMEM range only; CLINT/UART/PLIC/IMEM accesses pass through.
+      // With ENABLE_COHERENCY the caches are kept coherent by coherence_hub and
+      // atomics and PTE A/D updates are made atomic in the cache (locked
+      // line), so the bus is not locked (a locked bus would block the snoop
+      // write-backs the hub waits for)
+
+      if (`ENABLE_DCACHE) begin : g_dcache
+        assign hart_req_lock[h] = `ENABLE_COHERENCY ? 1'b0 : core_req_lock;
+        // Near-memory AMOs are disabled in the core when a D-cache is present
+        assign hart_req_amo[h]           = 1'b0;
+        assign hart_req_amo_op[h*5 +: 5] = 5'd0;
+
+        dcache #(
+          .XLEN(XLEN),
+          .COHERENT(`ENABLE_COHERENCY)
+        ) dcache_inst (
+          .clk(clk),
+          .reset_n(reset_n),
+          // Core side
+          .req_valid(core_req_valid),
+          .req_addr(core_req_addr),
+          .req_wdata(core_req_wdata),
+          .req_we(core_req_we),
+          .req_size(core_req_size),
+          .req_ready(core_req_ready),
+          .req_rdata(core_req_rdata),
+          .req_lock(core_req_lock),
+          // Bus side
+          .mem_req_valid(hart_req_valid[h]),
+          .mem_req_addr(hart_req_addr[h*XLEN +: XLEN]),
+          .mem_req_wdata(hart_req_wdata[h*64 +: 64]),
+          .mem_req_we(hart_req_we[h]),
+          .mem_req_size(hart_req_size[h*3 +: 3]),
+          .mem_req_ready(hart_req_ready[h]),
+          .mem_req_rdata(hart_req_rdata[h*64 +: 64]),
+          // Coherence
+          .acq_valid(coh_acq_valid[h]),
+          .acq_addr(coh_acq_addr[h*XLEN +: XLEN]),
+          .acq_excl(coh_acq_excl[h]),
+          .acq_grant(coh_acq_grant[h]),
+          .acq_shared(coh_acq_shared),
+          .snp_valid(coh_snp_valid[h]),
+          .snp_addr(coh_snp_addr),
+          .snp_excl(coh_snp_excl),
+          .snp_ack(coh_snp_ack[h]),
+          .snp_hit(coh_snp_hit[h]),
+          // Statistics
+          .stat_hits(),
+          .stat_misses(),
+          .stat_writebacks()
+        );
+      end else begin : g_no_dcache
+        assign hart_req_lock[h]               = core_req_lock;
+        assign hart_req_amo[h]                = core_req_amo;
+        assign hart_req_amo_op[h*5 +: 5]      = core_req_amo_op;
+        assign hart_req_valid[h]              = core_req_valid;
+        assign hart_req_addr[h*XLEN +: XLEN]  = core_req_addr;
+        assign hart_req_wdata[h*64 +: 64]     = core_req_wdata;
+        assign hart_req_we[h]                 = core_req_we;
+        assign hart_req_size[h*3 +: 3]        = core_req_size;
+        assign core_req_ready                 = hart_req_ready[h];
+        assign core_req_rdata                 = hart_req_rdata[h*64 +: 64];
+        assign coh_acq_valid[h]               = 1'b0;
+        assign coh_acq_addr[h*XLEN +: XLEN]   = {XLEN{1'b0}};
+        assign coh_acq_excl[h]                = 1'b0;
+        assign coh_snp_ack[h]                 = 1'b1;
+        assign coh_snp_hit[h]                 = 1'b0;
+      end
+    end
+  endgenerate
 
-  rv_core_pipelined #(
-    .XLEN(XLEN),
-    .RESET_VECTOR(RESET_VECTOR),
-    .IMEM_SIZE(IMEM_SIZE),
-    .DMEM_SIZE(DMEM_SIZE),
-    .MEM_FILE(MEM_FILE)
-  ) core (
-    .clk(clk),
-    .reset_n(reset_n),
-    // Interrupts
-    .mtip_in(mtip),
-    .msip_in(msip),
-    .meip_in(meip),
-    .seip_in(seip),
-    // Bus master interface
-    .bus_req_valid(bus_master_req_valid),
-    .bus_req_addr(bus_master_req_addr),
-    .bus_req_wdata(bus_master_req_wdata),
-    .bus_req_we(bus_master_req_we),
-    .bus_req_size(bus_master_req_size),
-    .bus_req_ready(bus_master_req_ready),
-    .bus_req_rdata(bus_master_req_rdata),
-    // Debug
-    .pc_out(pc_out),
-    .instr_out(instr_out)
-  );
+  //==========================================================================
+  // Coherence Hub (MESI snooping between the D-caches)
+  //==========================================================================
+
+  generate
+    if (`ENABLE_DCACHE && `ENABLE_COHERENCY) begin : g_coherence
+      coherence_hub #(
+        .XLEN(XLEN),
+        .NUM_CACHES(NUM_HARTS)
+      ) coherence_hub_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .acq_valid(coh_acq_valid),
+        .acq_addr(coh_acq_addr),
+        .acq_excl(coh_acq_excl),
+        .acq_grant(coh_acq_grant),
+        .acq_shared(coh_acq_shared),
+        .snp_valid(coh_snp_valid),
+        .snp_addr(coh_snp_addr),
+        .snp_excl(coh_snp_excl),
+        .snp_ack(coh_snp_ack),
+        .snp_hit(coh_snp_hit)
+      );
+    end else begin : g_no_coherence
+      assign coh_acq_grant  = {NUM_HARTS{1'b0}};
+      assign coh_acq_shared = 1'b0;
+      assign coh_snp_valid  = {NUM_HARTS{1'b0}};
+      assign coh_snp_addr   = {XLEN{1'b0}};
+      assign coh_snp_excl   = 1'b0;
+    end
+  endgenerate
+
+  assign pc_out    = hart_pc[XLEN-1:0];
+  assign instr_out = hart_instr[31:0];
+
+  //==========================================================================
+  // Hart Arbiter / Pipelined Bus
+  //==========================================================================
+  // simple_bus: round-robin between harts; a hart keeps the bus for a whole
+  // transaction and across an atomic read-modify-write.
+  // BUS_PIPELINED: each hart is a split_bus master with one transaction in
+  // flight. DMEM is a pipelined split_bus slave; every other address goes
+  // through split_bus_bridge to simple_bus, which decodes the peripherals as
+  // before (its DMEM port stays idle). split_bus has no lock, write snoop or
+  // AMO sideband: used only with one hart or coherent D-caches, without L2
+
+  localparam SPLIT_BUS    = `BUS_PIPELINED && !`L2_CACHE_ENABLE &&
+                            (NUM_HARTS == 1 || (`ENABLE_DCACHE && `ENABLE_COHERENCY));
+  localparam SB_ID_WIDTH  = 1;  // One transaction in flight per hart
+  localparam SB_SID_WIDTH = SB_ID_WIDTH + ((NUM_HARTS > 1) ? $clog2(NUM_HARTS) : 1);
+
+  generate
+    if (SPLIT_BUS) begin : g_split_bus
+      wire [NUM_HARTS-1:0]             m_req_valid;
+      wire [NUM_HARTS-1:0]             m_req_ready;
+      wire [NUM_HARTS*SB_ID_WIDTH-1:0] m_req_id;
+      wire [NUM_HARTS*XLEN-1:0]        m_req_addr;
+      wire [NUM_HARTS*64-1:0]          m_req_wdata;
+      wire [NUM_HARTS-1:0]             m_req_we;
+      wire [NUM_HARTS*3-1:0]           m_req_size;
+      wire [NUM_HARTS-1:0]             m_resp_valid;
+      wire [NUM_HARTS-1:0]             m_resp_ready;
+      wire [NUM_HARTS*SB_ID_WIDTH-1:0] m_resp_id;
+      wire [NUM_HARTS*64-1:0]          m_resp_rdata;
+      wire [NUM_HARTS-1:0]             m_resp_err;
+
+      // Slave 0: DMEM, slave 1: everything else (simple_bus)
+      wire [1:0]                s_req_valid;
+      wire [1:0]                s_req_ready;
+      wire [2*SB_SID_WIDTH-1:0] s_req_id;
+      wire [2*XLEN-1:0]         s_req_addr;
+      wire [2*64-1:0]           s_req_wdata;
+      wire [1:0]                s_req_we;
+      wire [2*3-1:0]            s_req_size;
+      wire [1:0]                s_resp_valid;
+      wire [1:0]                s_resp_ready;
+      wire [2*SB_SID_WIDTH-1:0] s_resp_id;
+      wire [2*64-1:0]           s_resp_rdata;
+
+      genvar m;
+      for (m = 0; m < NUM_HARTS; m = m + 1) begin : g_master
+        split_bus_master #(
+          .XLEN(XLEN),
+          .ID_WIDTH(SB_ID_WIDTH)
+        ) master (
+          .clk(clk),
+          .reset_n(reset_n),
+          .req_valid(hart_req_valid[m]),
+          .req_addr(hart_req_addr[m*XLEN +: XLEN]),
+          .req_wdata(hart_req_wdata[m*64 +: 64]),
+          .req_we(hart_req_we[m]),
+          .req_size(hart_req_size[m*3 +: 3]),
+          .req_ready(hart_req_ready[m]),
+          .req_rdata(hart_req_rdata[m*64 +: 64]),
+          .m_req_valid(m_req_valid[m]),
+          .m_req_ready(m_req_ready[m]),
+          .m_req_id(m_req_id[m*SB_ID_WIDTH +: SB_ID_WIDTH]),
+          .m_req_addr(m_req_addr[m*XLEN +: XLEN]),
+          .m_req_wdata(m_req_wdata[m*64 +: 64]),
+          .m_req_we(m_req_we[m]),
+          .m_req_size(m_req_size[m*3 +: 3]),
+          .m_resp_valid(m_resp_valid[m]),
+          .m_resp_ready(m_resp_ready[m]),
+          .m_resp_id(m_resp_id[m*SB_ID_WIDTH +: SB_ID_WIDTH]),
+          .m_resp_rdata(m_resp_rdata[m*64 +: 64]),
+          .m_resp_err(m_resp_err[m])
+        );
+      end
+
+      split_bus #(
+        .XLEN(XLEN),
+        .NUM_MASTERS(NUM_HARTS),
+        .NUM_SLAVES(2),
+        .ID_WIDTH(SB_ID_WIDTH),
+        .MAX_OUTSTANDING(1),
+        // Lowest matching slave wins: DMEM, then everything else
+        .SLAVE_BASE({32'h0000_0000, 32'h8000_0000}),
+        .SLAVE_MASK({32'h0000_0000, 32'hFFF0_0000})
+      ) pipelined_bus (
+        .clk(clk),
+        .reset_n(reset_n),
+        .m_req_valid(m_req_valid),
+        .m_req_ready(m_req_ready),
+        .m_req_id(m_req_id),
+        .m_req_addr(m_req_addr),
+        .m_req_wdata(m_req_wdata),
+        .m_req_we(m_req_we),
+        .m_req_size(m_req_size),
+        .m_resp_valid(m_resp_valid),
+        .m_resp_ready(m_resp_ready),
+        .m_resp_id(m_resp_id),
+        .m_resp_rdata(m_resp_rdata),
+        .m_resp_err(m_resp_err),
+        .s_req_valid(s_req_valid),
+        .s_req_ready(s_req_ready),
+        .s_req_id(s_req_id),
+        .s_req_addr(s_req_addr),
+        .s_req_wdata(s_req_wdata),
+        .s_req_we(s_req_we),
+        .s_req_size(s_req_size),
+        .s_resp_valid(s_resp_valid),
+        .s_resp_ready(s_resp_ready),
+        .s_resp_id(s_resp_id),
+        .s_resp_rdata(s_resp_rdata)
+      );
+
+      dmem_split_adapter #(
+        .XLEN(XLEN),
+        .FLEN(`FLEN),
+        .ID_WIDTH(SB_SID_WIDTH),
+        .MEM_SIZE(DMEM_SIZE),
+        .MEM_FILE("")
+      ) dmem_split (
+        .clk(clk),
+        .reset_n(reset_n),
+        .req_valid(s_req_valid[0]),
+        .req_ready(s_req_ready[0]),
+        .req_id(s_req_id[0 +: SB_SID_WIDTH]),
+        .req_addr(s_req_addr[0 +: XLEN]),
+        .req_wdata(s_req_wdata[0 +: 64]),
+        .req_we(s_req_we[0]),
+        .req_size(s_req_size[0 +: 3]),
+        .resp_valid(s_resp_valid[0]),
+        .resp_ready(s_resp_ready[0]),
+        .resp_id(s_resp_id[0 +: SB_SID_WIDTH]),
+        .resp_rdata(s_resp_rdata[0 +: 64])
+      );
+
+      split_bus_bridge #(
+        .XLEN(XLEN),
+        .ID_WIDTH(SB_SID_WIDTH)
+      ) mmio_bridge (
+        .clk(clk),
+        .reset_n(reset_n),
+        .req_valid(s_req_valid[1]),
+        .req_ready(s_req_ready[1]),
+        .req_id(s_req_id[SB_SID_WIDTH +: SB_SID_WIDTH]),
+        .req_addr(s_req_addr[XLEN +: XLEN]),
+        .req_wdata(s_req_wdata[64 +: 64]),
+        .req_we(s_req_we[1]),
+        .req_size(s_req_size[3 +: 3]),
+        .resp_valid(s_resp_valid[1]),
+        .resp_ready(s_resp_ready[1]),
+        .resp_id(s_resp_id[SB_SID_WIDTH +: SB_SID_WIDTH]),
+        .resp_rdata(s_resp_rdata[64 +: 64]),
+        .bus_req_valid(bus_master_req_valid),
+        .bus_req_addr(bus_master_req_addr),
+        .bus_req_wdata(bus_master_req_wdata),
+        .bus_req_we(bus_master_req_we),
+        .bus_req_size(bus_master_req_size),
+        .bus_req_ready(bus_master_req_ready),
+        .bus_req_rdata(bus_master_req_rdata)
+      );
+
+      assign bus_master_req_amo    = 1'b0;
+      assign bus_master_req_amo_op = 5'd0;
+
+      // No write snoop: a single hart, or coherent D-caches (snooped by the hub)
+      assign snoop_valid  = 1'b0;
+      assign snoop_addr   = {XLEN{1'b0}};
+      assign snoop_master = 0;
+    end else begin : g_hart_arbiter
+      wire [63:0] arb_rdata;  // Shared read data, valid with the hart's ready
+      assign hart_req_rdata = {NUM_HARTS{arb_rdata}};
+
+      bus_master_arbiter #(
+        .XLEN(XLEN),
+        .NUM_MASTERS(NUM_HARTS)
+      ) hart_arbiter (
+        .clk(clk),
+        .reset_n(reset_n),
+        .m_req_valid(hart_req_valid),
+        .m_req_addr(hart_req_addr),
+        .m_req_wdata(hart_req_wdata),
+        .m_req_we(hart_req_we),
+        .m_req_size(hart_req_size),
+        .m_req_lock(hart_req_lock),
+        .m_req_amo(hart_req_amo),
+        .m_req_amo_op(hart_req_amo_op),
+        .m_req_ready(hart_req_ready),
+        .m_req_rdata(arb_rdata),
+        .bus_req_valid(arb_req_valid),
+        .bus_req_addr(arb_req_addr),
+        .bus_req_wdata(arb_req_wdata),
+        .bus_req_we(arb_req_we),
+        .bus_req_size(arb_req_size),
+        .bus_req_amo(arb_req_amo),
+        .bus_req_amo_op(arb_req_amo_op),
+        .bus_req_ready(arb_req_ready),
+        .bus_req_rdata(arb_req_rdata),
+        .snoop_valid(snoop_valid),
+        .snoop_addr(snoop_addr),
+        .snoop_master(snoop_master)
+      );
+    end
+  endgenerate
+
+  //==========================================================================
+  // Shared L2 Cache (optional)
+  //==========================================================================
+  // Memory-side write-back cache of the DMEM range shared by all harts
+  // (dcache.v with L2 geometry). Every L1 refill, write-back and uncached
+  // access passes through it, so it needs no snooping of its own
+
+  generate
+    if (`L2_CACHE_ENABLE && !SPLIT_BUS) begin : g_l2
+      dcache #(
+        .XLEN(XLEN),
+        .CACHE_SIZE(`L2_CACHE_SIZE),
+        .LINE_SIZE(`L2_CACHE_LINE_SIZE),
+        .WAYS(`L2_CACHE_WAYS),
+        .NUM_MSHRS(`DCACHE_MSHRS)
+      ) l2_cache (
+        .clk(clk),
+        .reset_n(reset_n),
+        // Hart arbiter side
+        .req_valid(arb_req_valid),
+        .req_addr(arb_req_addr),
+        .req_wdata(arb_req_wdata),
+        .req_we(arb_req_we),
+        .req_size(arb_req_size),
+        .req_ready(arb_req_ready),
+        .req_rdata(arb_req_rdata),
+        .req_lock(1'b0),
+        // Bus side
+        .mem_req_valid(bus_master_req_valid),
+        .mem_req_addr(bus_master_req_addr),
+        .mem_req_wdata(bus_master_req_wdata),
+        .mem_req_we(bus_master_req_we),
+        .mem_req_size(bus_master_req_size),
+        .mem_req_ready(bus_master_req_ready),
+        .mem_req_rdata(bus_master_req_rdata),
+        // Not snooped
+        .acq_valid(),
+        .acq_addr(),
+        .acq_excl(),
+        .acq_grant(1'b0),
+        .acq_shared(1'b0),
+        .snp_valid(1'b0),
+        .snp_addr({XLEN{1'b0}}),
+        .snp_excl(1'b0),
+        .snp_ack(),
+        .snp_hit(),
+        // Statistics
+        .stat_hits(),
+        .stat_misses(),
+        .stat_writebacks()
+      );
+      // Near-memory AMOs are disabled in the core when the L2 is present
+      assign bus_master_req_amo    = 1'b0;
+      assign bus_master_req_amo_op = 5'd0;
+    end else if (!SPLIT_BUS) begin : g_no_l2
+      assign bus_master_req_valid = arb_req_valid;
+      assign bus_master_req_addr  = arb_req_addr;
+      assign bus_master_req_wdata = arb_req_wdata;
+      assign bus_master_req_we    = arb_req_we;
+      assign bus_master_req_size  = arb_req_size;
+      assign bus_master_req_amo    = arb_req_amo;
+      assign bus_master_req_amo_op = arb_req_amo_op;
+      assign arb_req_ready        = bus_master_req_ready;
+      assign arb_req_rdata        = bus_master_req_rdata;
+    end
+  endgenerate
 
   //==========================================================================
   // Bus Interconnect
@@ -137,12 +597,14 @@ module rv_soc #(
   ) bus (
     .clk(clk),
     .reset_n(reset_n),
-    // Master interface (from Core)
+    // Master interface (from the hart arbiter)
     .master_req_valid(bus_master_req_valid),
     .master_req_addr(bus_master_req_addr),
     .master_req_wdata(bus_master_req_wdata),
     .master_req_we(bus_master_req_we),
     .master_req_size(bus_master_req_size),
+    .master_req_amo(bus_master_req_amo),
+    .master_req_amo_op(bus_master_req_amo_op),
     .master_req_ready(bus_master_req_ready),
     .master_req_rdata(bus_master_req_rdata),
     // Slave 0: CLINT
@@ -166,6 +628,8 @@ module rv_soc #(
     .dmem_req_wdata(dmem_req_wdata),
     .dmem_req_we(dmem_req_we),
     .dmem_req_size(dmem_req_size),
+    .dmem_req_amo(dmem_req_amo),
+    .dmem_req_amo_op(dmem_req_amo_op),
     .dmem_req_ready(dmem_req_ready),
     .dmem_req_rdata(dmem_req_rdata),
     // Slave 3: PLIC
@@ -202,7 +666,8 @@ module rv_soc #(
     .req_rdata(clint_req_rdata),
     // Interrupt outputs (all harts)
     .mti_o(mtip_vec),  // Machine timer interrupt vector
-    .msi_o(msip_vec)   // Machine software interrupt vector
+    .msi_o(msip_vec),  // Machine software interrupt vector
+    .mtime_o(clint_mtime)
   );
 
   //==========================================================================
@@ -255,8 +720,8 @@ module rv_soc #(
     // Interrupt sources (32 sources, only UART connected for now)
     .irq_sources({31'b0, uart_irq}),  // Source 1 = UART
     // Interrupt outputs to core
-    .mei_o(meip),  // Machine External Interrupt
-    .sei_o(seip)   // Supervisor External Interrupt
+    .mei_o(meip_vec),  // Machine External Interrupt (per hart)
+    .sei_o(seip_vec)   // Supervisor External Interrupt (per hart)
   );
 
   //==========================================================================
@@ -350,6 +815,8 @@ module rv_soc #(
     .req_wdata(dmem_req_wdata),
     .req_we(dmem_req_we),
     .req_size(dmem_req_size),
+    .req_amo(dmem_req_amo),
+    .req_amo_op(dmem_req_amo_op),
     .req_ready(dmem_req_ready),
     .req_rdata(dmem_req_rdata)
   );
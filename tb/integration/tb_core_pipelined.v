@@ -6,6 +6,8 @@
 
 `timescale 1ns/1ps
 
+`include "config/rv_config.vh"
+
 module tb_core_pipelined;
 
   // Clock parameters
@@ -38,15 +40,19 @@ module tb_core_pipelined;
   wire [63:0] bus_req_wdata;
   wire        bus_req_we;
   wire [2:0]  bus_req_size;
+  wire        bus_req_amo;     // Near-memory AMO (never set with ENABLE_DCACHE)
+  wire [4:0]  bus_req_amo_op;
   wire        bus_req_ready;
   wire [63:0] bus_req_rdata;
 
   // Cycle counter and performance metrics
   integer cycle_count;
   integer total_instructions;
+  integer dual_issue_pairs;
   integer stall_cycles;
   integer flush_cycles;
   integer load_use_stalls;
+  integer load_use_bypasses;
   integer branch_flushes;
 
   // Test marker detection
@@ -72,17 +78,69 @@ module tb_core_pipelined;
     .msip_in(1'b0),      // No software interrupt for basic tests
     .meip_in(1'b0),      // No external interrupt for basic tests
     .seip_in(1'b0),      // No external interrupt for basic tests
+    .mtime_in(64'h0),    // time CSR reads 0 (no CLINT)
     .bus_req_valid(bus_req_valid),
     .bus_req_addr(bus_req_addr),
     .bus_req_wdata(bus_req_wdata),
     .bus_req_we(bus_req_we),
     .bus_req_size(bus_req_size),
+    .bus_req_amo(bus_req_amo),
+    .bus_req_amo_op(bus_req_amo_op),
     .bus_req_ready(bus_req_ready),
     .bus_req_rdata(bus_req_rdata),
     .pc_out(pc),
     .instr_out(instruction)
   );
 
+  // Memory side of the (optional) D-cache
+  wire        mem_req_valid;
+  wire [31:0] mem_req_addr;
+  wire [63:0] mem_req_wdata;
+  wire        mem_req_we;
+  wire [2:0]  mem_req_size;
+  wire        mem_req_ready;
+  wire [63:0] mem_req_rdata;
+
+  // D-cache between core and DMEM when ENABLE_DCACHE=1
+  // Marker detection below watches the core side, so it is unaffected
+  generate
+    if (`ENABLE_DCACHE) begin : g_dcache
+      dcache #(
+        .XLEN(32),
+        .CACHEABLE_BASE(32'h0000_0000),  // Everything is DMEM in this testbench
+        .CACHEABLE_MASK(32'h0000_0000)
+      ) dcache_inst (
+        .clk(clk),
+        .reset_n(reset_n),
+        .req_valid(bus_req_valid),
+        .req_addr(bus_req_addr),
+        .req_wdata(bus_req_wdata),
+        .req_we(bus_req_we),
+        .req_size(bus_req_size),
+        .req_ready(bus_req_ready),
+        .req_rdata(bus_req_rdata),
+        .mem_req_valid(mem_req_valid),
+        .mem_req_addr(mem_req_addr),
+        .mem_req_wdata(mem_req_wdata),
+        .mem_req_we(mem_req_we),
+        .mem_req_size(mem_req_size),
+        .mem_req_ready(mem_req_ready),
+        .mem_req_rdata(mem_req_rdata),
+        .stat_hits(),
+        .stat_misses(),
+        .stat_writebacks()
+      );
+    end else begin : g_no_dcache
+      assign mem_req_valid = bus_req_valid;
+      assign mem_req_addr  = bus_req_addr;
+      assign mem_req_wdata = bus_req_wdata;
+      assign mem_req_we    = bus_req_we;
+      assign mem_req_size  = bus_req_size;
+      assign bus_req_ready = mem_req_ready;
+      assign bus_req_rdata = mem_req_rdata;
+    end
+  endgenerate
+
   // Simple bus adapter for testbench - connects bus to DMEM
   // All addresses go to DMEM (no peripheral decode in this testbench)
   dmem_bus_adapter #(
@@ -93,13 +151,15 @@ module tb_core_pipelined;
   ) dmem_adapter (
     .clk(clk),
     .reset_n(reset_n),
-    .req_valid(bus_req_valid),
-    .req_addr(bus_req_addr),
-    .req_wdata(bus_req_wdata),
-    .req_we(bus_req_we),
-    .req_size(bus_req_size),
-    .req_ready(bus_req_ready),
-    .req_rdata(bus_req_rdata)
+    .req_valid(mem_req_valid),
+    .req_addr(mem_req_addr),
+    .req_wdata(mem_req_wdata),
+    .req_we(mem_req_we),
+    .req_size(mem_req_size),
+    .req_amo(bus_req_amo),
+    .req_amo_op(bus_req_amo_op),
+    .req_ready(mem_req_ready),
+    .req_rdata(mem_req_rdata)
   );
 
   // Clock generation
@@ -134,9 +194,11 @@ module tb_core_pipelined;
     reset_n = 0;
     cycle_count = 0;
     total_instructions = 0;
+    dual_issue_pairs = 0;
     stall_cycles = 0;
     flush_cycles = 0;
     load_use_stalls = 0;
+    load_use_bypasses = 0;
     branch_flushes = 0;
 
     // Hold reset for a few cycles
@@ -154,6 +216,11 @@ module tb_core_pipelined;
       if (DUT.idex_valid && !DUT.flush_idex) begin
         total_instructions = total_instructions + 1;
       end
+      // Dual issue: the lane-1 instruction of a pair counts separately
+      if (DUT.idex1_valid && !DUT.flush_idex) begin
+        total_instructions = total_instructions + 1;
+        dual_issue_pairs = dual_issue_pairs + 1;
+      end
       if (DUT.stall_pc) begin
         stall_cycles = stall_cycles + 1;
         // Check if it's a load-use stall
@@ -161,10 +228,14 @@ module tb_core_pipelined;
           load_use_stalls = load_use_stalls + 1;
         end
       end
+      // LOAD_USE_BYPASS: a dependent instruction issued behind a load without a bubble
+      if (DUT.hazard_unit.load_use_bypassed && !DUT.stall_pc) begin
+        load_use_bypasses = load_use_bypasses + 1;
+      end
       if (DUT.flush_idex) begin
         flush_cycles = flush_cycles + 1;
-        // Check if it's a branch flush
-        if (DUT.ex_take_branch) begin
+        // Check if it's a branch flush (taken branch, or misprediction with predictor enabled)
+        if (DUT.ex_mispredict) begin
           branch_flushes = branch_flushes + 1;
         end
       end
@@ -427,6 +498,10 @@ module tb_core_pipelined;
         if (total_instructions > 0) begin
           cpi = cycle_count * 1.0 / total_instructions;
           $display("CPI (Cycles/Instr):  %0.3f", cpi);
+          if (dual_issue_pairs > 0) begin
+            $display("IPC (Instr/Cycle):   %0.3f", total_instructions * 1.0 / cycle_count);
+            $display("  Dual-issued pairs: %0d", dual_issue_pairs);
+          end
         end else begin
           $display("CPI (Cycles/Instr):  N/A (no instructions)");
         end
@@ -436,9 +511,18 @@ module tb_core_pipelined;
           flush_rate = flush_cycles * 100.0 / cycle_count;
           $display("Stall cycles:        %0d (%0.1f%%)", stall_cycles, stall_rate);
           $display("  Load-use stalls:   %0d", load_use_stalls);
+          if (load_use_bypasses > 0)
+            $display("  Load-use bypasses: %0d (stall cycles saved)", load_use_bypasses);
           $display("Flush cycles:        %0d (%0.1f%%)", flush_cycles, flush_rate);
           $display("  Branch flushes:    %0d", branch_flushes);
         end
+        if (DUT.bpred.stat_branches + DUT.bpred.stat_jumps > 0) begin
+          $display("Branch predictor:");
+          $display("  Branches:          %0d (%0d mispredicted)",
+                   DUT.bpred.stat_branches, DUT.bpred.stat_branch_miss);
+          $display("  Jumps:             %0d (%0d mispredicted)",
+                   DUT.bpred.stat_jumps, DUT.bpred.stat_jump_miss);
+        end
         $display("");
       end
     end
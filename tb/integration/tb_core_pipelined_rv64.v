@@ -30,6 +30,8 @@ module tb_core_pipelined_rv64;
   wire [63:0] bus_req_wdata;
   wire        bus_req_we;
   wire [2:0]  bus_req_size;
+  wire        bus_req_amo;
+  wire [4:0]  bus_req_amo_op;
   wire        bus_req_ready;
   wire [63:0] bus_req_rdata;
 
@@ -53,11 +55,14 @@ module tb_core_pipelined_rv64;
     .msip_in(1'b0),      // No software interrupt for basic tests
     .meip_in(1'b0),      // No external interrupt for basic tests
     .seip_in(1'b0),      // No external interrupt for basic tests
+    .mtime_in(64'h0),    // time CSR reads 0 (no CLINT)
     .bus_req_valid(bus_req_valid),
     .bus_req_addr(bus_req_addr),
     .bus_req_wdata(bus_req_wdata),
     .bus_req_we(bus_req_we),
     .bus_req_size(bus_req_size),
+    .bus_req_amo(bus_req_amo),
+    .bus_req_amo_op(bus_req_amo_op),
     .bus_req_ready(bus_req_ready),
     .bus_req_rdata(bus_req_rdata),
     .pc_out(pc),
@@ -77,6 +82,8 @@ module tb_core_pipelined_rv64;
     .req_wdata(bus_req_wdata),
     .req_we(bus_req_we),
     .req_size(bus_req_size),
+    .req_amo(bus_req_amo),
+    .req_amo_op(bus_req_amo_op),
     .req_ready(bus_req_ready),
     .req_rdata(bus_req_rdata)
   );
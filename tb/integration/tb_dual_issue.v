@@ -0,0 +1,267 @@
+// tb_dual_issue.v - Directed dual-issue testbench (ISSUE_WIDTH=2)
+// Runs tests/asm/test_dual_issue.hex on the pipelined core and checks, besides
+// the program's own result (x28), that each lane-1 corner case really occurred:
+// a WAW pair committed with port 2 of register_file winning, lane 1 killed by
+// a lane-0 redirect, lane 1 dropped with a lane-0 MEM exception, and a value
+// forwarded from lane 1. Reports IPC (minstret / cycles)
+// Author: RV1 Project
+// Date: 2026-10-16
+//
+// Also runs with ISSUE_WIDTH=1 for comparison: program result, IPC, and lane 1
+// never active (the single-issue core is unchanged)
+
+`timescale 1ns/1ps
+
+`include "config/rv_config.vh"
+
+module tb_dual_issue;
+
+  parameter CLK_PERIOD = 10;
+  parameter TIMEOUT = 20000;
+
+  `ifdef MEM_FILE
+    parameter MEM_INIT_FILE = `MEM_FILE;
+  `else
+    parameter MEM_INIT_FILE = "tests/asm/test_dual_issue.hex";
+  `endif
+
+  reg         clk;
+  reg         reset_n;
+  wire [31:0] pc;
+  wire [31:0] instruction;
+
+  wire        bus_req_valid;
+  wire [31:0] bus_req_addr;
+  wire [63:0] bus_req_wdata;
+  wire        bus_req_we;
+  wire [2:0]  bus_req_size;
+  wire        bus_req_amo;
+  wire [4:0]  bus_req_amo_op;
+  wire        bus_req_ready;
+  wire [63:0] bus_req_rdata;
+
+  // Test tracking
+  integer errors;
+  integer tests;
+  integer cycle_count;
+
+  // Lane-1 event counters
+  integer pairs;              // Pairs retired (lane 1 in WB)
+  integer waw_pairs;          // Pairs committing the same rd
+  integer waw_errors;         // ... where the register file did not keep lane 1's value
+  integer redirect_kills;     // Lane 1 in EX killed by a lane-0 redirect
+  integer exception_drops;    // Lane 1 in MEM dropped with a lane-0 exception
+  integer lane1_forwards;     // EX operand forwarded from lane 1
+  integer lane1_active;       // Cycles with any lane-1 stage valid
+  reg     exc_drop_r;
+
+  reg  [4:0]  waw_rd;
+  reg  [31:0] waw_value;
+
+  rv_core_pipelined #(
+    .XLEN(32),
+    .RESET_VECTOR(32'h80000000),
+    .IMEM_SIZE(16384),
+    .DMEM_SIZE(32768),
+    .MEM_FILE(MEM_INIT_FILE)
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .mtip_in(1'b0),
+    .msip_in(1'b0),
+    .meip_in(1'b0),
+    .seip_in(1'b0),
+    .mtime_in(64'h0),
+    .bus_req_valid(bus_req_valid),
+    .bus_req_addr(bus_req_addr),
+    .bus_req_wdata(bus_req_wdata),
+    .bus_req_we(bus_req_we),
+    .bus_req_size(bus_req_size),
+    .bus_req_amo(bus_req_amo),
+    .bus_req_amo_op(bus_req_amo_op),
+    .bus_req_ready(bus_req_ready),
+    .bus_req_rdata(bus_req_rdata),
+    .pc_out(pc),
+    .instr_out(instruction)
+  );
+
+  dmem_bus_adapter #(
+    .XLEN(32),
+    .FLEN(64),
+    .MEM_SIZE(16384),
+    .MEM_FILE(MEM_INIT_FILE)
+  ) dmem_adapter (
+    .clk(clk),
+    .reset_n(reset_n),
+    .req_valid(bus_req_valid),
+    .req_addr(bus_req_addr),
+    .req_wdata(bus_req_wdata),
+    .req_we(bus_req_we),
+    .req_size(bus_req_size),
+    .req_amo(bus_req_amo),
+    .req_amo_op(bus_req_amo_op),
+    .req_ready(bus_req_ready),
+    .req_rdata(bus_req_rdata)
+  );
+
+  initial begin
+    clk = 0;
+    forever #(CLK_PERIOD/2) clk = ~clk;
+  end
+
+  //==========================================================================
+  // Lane-1 monitors
+  //==========================================================================
+
+  // WAW pair in WB: both ports write the same rd this edge, lane 1 is younger
+  always @(posedge clk) begin
+    if (reset_n && DUT.memwb_valid && DUT.memwb_reg_write && DUT.memwb1_valid &&
+        DUT.memwb1_reg_write && DUT.memwb_rd_addr != 5'h0 &&
+        DUT.memwb_rd_addr == DUT.memwb1_rd_addr) begin
+      waw_rd = DUT.memwb1_rd_addr;
+      waw_value = DUT.memwb1_result;
+      waw_pairs = waw_pairs + 1;
+      #1;
+      if (DUT.regfile.registers[waw_rd] !== waw_value) begin
+        $display("[%0d] WAW x%0d: register file = %h, lane 1 wrote %h",
+                 cycle_count, waw_rd, DUT.regfile.registers[waw_rd], waw_value);
+        waw_errors = waw_errors + 1;
+      end
+    end
+  end
+
+  always @(posedge clk) begin
+    if (reset_n) begin
+      if (DUT.memwb1_valid)
+        pairs = pairs + 1;
+      if (DUT.ifid1_valid || DUT.idex1_valid || DUT.exmem1_valid || DUT.memwb1_valid)
+        lane1_active = lane1_active + 1;
+      if (DUT.idex1_valid && DUT.ex_redirect && !DUT.hold_exmem && !DUT.trap_flush)
+        redirect_kills = redirect_kills + 1;
+      // Exception lasts until the trap is taken: count it once
+      if (DUT.exmem1_valid && DUT.exception_from_mem && !exc_drop_r)
+        exception_drops = exception_drops + 1;
+      exc_drop_r = DUT.exmem1_valid && DUT.exception_from_mem;
+      if (DUT.idex_valid && !DUT.stall_pc &&
+          ((DUT.forward_a != 2'b00 && DUT.forward_a_l1) ||
+           (DUT.forward_b != 2'b00 && DUT.forward_b_l1)))
+        lane1_forwards = lane1_forwards + 1;
+    end
+  end
+
+  //==========================================================================
+  // Test sequence
+  //==========================================================================
+
+  initial begin
+    $display("========================================");
+    $display("Dual-Issue Test (ISSUE_WIDTH=%0d)", `ISSUE_WIDTH);
+    $display("========================================");
+    $display("Loading program from: %s", MEM_INIT_FILE);
+    $display("");
+
+    $dumpfile("sim/waves/dual_issue.vcd");
+    $dumpvars(0, tb_dual_issue);
+
+    errors = 0;
+    tests = 0;
+    cycle_count = 0;
+    pairs = 0;
+    waw_pairs = 0;
+    waw_errors = 0;
+    redirect_kills = 0;
+    exception_drops = 0;
+    lane1_forwards = 0;
+    lane1_active = 0;
+    exc_drop_r = 0;
+
+    reset_n = 0;
+    repeat(5) @(posedge clk);
+    reset_n = 1;
+
+    // Run until EBREAK (the program parks in its trap handler afterwards)
+    while (cycle_count < TIMEOUT &&
+           DUT.ifid_instruction != 32'h00100073 && DUT.if_instruction != 32'h00100073) begin
+      @(posedge clk);
+      cycle_count = cycle_count + 1;
+    end
+    // Let the instructions ahead of EBREAK reach WB
+    repeat(10) @(posedge clk);
+    cycle_count = cycle_count + 10;
+
+    if (cycle_count >= TIMEOUT)
+      $display("WARNING: Timeout reached (%0d cycles)", TIMEOUT);
+    $display("EBREAK at cycle %0d, gp (test) = %0d", cycle_count, DUT.regfile.registers[3]);
+    $display("");
+
+    check("program result (x28)", DUT.regfile.registers[28], 32'hDEADBEEF);
+    if (`ISSUE_WIDTH == 2) begin
+      check_true("instructions dual-issued", pairs > 0);
+      check_true("WAW pair committed", waw_pairs > 0);
+      check_true("WAW pair: port 2 (lane 1) wins", waw_errors == 0);
+      check_true("lane 1 killed by lane-0 redirect", redirect_kills > 0);
+      check_true("lane 1 dropped with lane-0 exception", exception_drops > 0);
+      check_true("forwarded from lane 1", lane1_forwards > 0);
+    end else begin
+      check_true("lane 1 never active", lane1_active == 0);
+    end
+
+    $display("");
+    $display("=== Dual-Issue Statistics ===");
+    $display("Cycles:              %0d", cycle_count);
+    $display("Instructions:        %0d", DUT.csr_file_inst.minstret_r);
+    $display("IPC (Instr/Cycle):   %0.3f", DUT.csr_file_inst.minstret_r * 1.0 / cycle_count);
+    $display("  Dual-issued pairs: %0d", pairs);
+    $display("  WAW pairs:         %0d", waw_pairs);
+    $display("  Redirect kills:    %0d", redirect_kills);
+    $display("  Exception drops:   %0d", exception_drops);
+    $display("  Lane-1 forwards:   %0d", lane1_forwards);
+
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed:      %0d", tests - errors);
+    $display("Failed:      %0d", errors);
+    $display("");
+
+    if (errors == 0) begin
+      $display("All tests PASSED!");
+    end else begin
+      $display("Some tests FAILED!");
+    end
+
+    $finish;
+  end
+
+  task check;
+    input [255:0] name;
+    input [31:0] actual;
+    input [31:0] expected;
+    begin
+      tests = tests + 1;
+      if (actual !== expected) begin
+        $display("FAIL: %0s: expected %h, got %h", name, expected, actual);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %0s", name);
+      end
+    end
+  endtask
+
+  task check_true;
+    input [255:0] name;
+    input cond;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %0s", name);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %0s", name);
+      end
+    end
+  endtask
+
+endmodule
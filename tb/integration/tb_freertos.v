@@ -161,34 +161,34 @@ module tb_freertos;
 
     // CPU state
     .pc(pc),
-    .pc_next(DUT.core.pc_next),
+    .pc_next(DUT.g_hart[0].core.pc_next),
     .instruction(instruction),
-    .valid_instruction(DUT.core.memwb_valid),
+    .valid_instruction(DUT.g_hart[0].core.memwb_valid),
 
     // Register file access
-    .x1_ra(DUT.core.regfile.registers[1]),
-    .x2_sp(DUT.core.regfile.registers[2]),
-    .x10_a0(DUT.core.regfile.registers[10]),
-    .x11_a1(DUT.core.regfile.registers[11]),
-    .x12_a2(DUT.core.regfile.registers[12]),
-    .x13_a3(DUT.core.regfile.registers[13]),
-    .x14_a4(DUT.core.regfile.registers[14]),
-    .x15_a5(DUT.core.regfile.registers[15]),
-    .x16_a6(DUT.core.regfile.registers[16]),
-    .x17_a7(DUT.core.regfile.registers[17]),
+    .x1_ra(DUT.g_hart[0].core.regfile.registers[1]),
+    .x2_sp(DUT.g_hart[0].core.regfile.registers[2]),
+    .x10_a0(DUT.g_hart[0].core.regfile.registers[10]),
+    .x11_a1(DUT.g_hart[0].core.regfile.registers[11]),
+    .x12_a2(DUT.g_hart[0].core.regfile.registers[12]),
+    .x13_a3(DUT.g_hart[0].core.regfile.registers[13]),
+    .x14_a4(DUT.g_hart[0].core.regfile.registers[14]),
+    .x15_a5(DUT.g_hart[0].core.regfile.registers[15]),
+    .x16_a6(DUT.g_hart[0].core.regfile.registers[16]),
+    .x17_a7(DUT.g_hart[0].core.regfile.registers[17]),
 
     // Memory access monitoring
-    .mem_valid(DUT.core.exmem_valid && (DUT.core.exmem_mem_read || DUT.core.exmem_mem_write)),
-    .mem_write(DUT.core.exmem_mem_write),
-    .mem_addr(DUT.core.exmem_alu_result),
-    .mem_wdata(DUT.core.exmem_mem_write_data),
-    .mem_rdata(DUT.core.mem_read_data),
+    .mem_valid(DUT.g_hart[0].core.exmem_valid && (DUT.g_hart[0].core.exmem_mem_read || DUT.g_hart[0].core.exmem_mem_write)),
+    .mem_write(DUT.g_hart[0].core.exmem_mem_write),
+    .mem_addr(DUT.g_hart[0].core.exmem_alu_result),
+    .mem_wdata(DUT.g_hart[0].core.exmem_mem_write_data),
+    .mem_rdata(DUT.g_hart[0].core.mem_read_data),
     .mem_wstrb(4'b1111),  // Full word for now
 
     // Exception/interrupt info
-    .trap_taken(DUT.core.csr_file_inst.mcause_r != prev_mcause),
+    .trap_taken(DUT.g_hart[0].core.csr_file_inst.mcause_r != prev_mcause),
     .trap_pc(pc),
-    .trap_cause(DUT.core.csr_file_inst.mcause_r),
+    .trap_cause(DUT.g_hart[0].core.csr_file_inst.mcause_r),
 
     // Control
     .enable_trace(1'b0),    // Disabled for speed - enable for debugging
@@ -232,16 +232,16 @@ module tb_freertos;
         // Display character and PC
         if (DUT.uart_req_wdata >= 8'h20 && DUT.uart_req_wdata <= 8'h7E) begin
           $display("[UART-BUS-WRITE] Cycle %0d: PC=0x%08h data=0x%02h '%c'",
-                   cycle_count, DUT.core.exmem_pc, DUT.uart_req_wdata, DUT.uart_req_wdata);
+                   cycle_count, DUT.g_hart[0].core.exmem_pc, DUT.uart_req_wdata, DUT.uart_req_wdata);
         end else if (DUT.uart_req_wdata == 8'h0A) begin
           $display("[UART-BUS-WRITE] Cycle %0d: PC=0x%08h data=0x%02h <LF>",
-                   cycle_count, DUT.core.exmem_pc, DUT.uart_req_wdata);
+                   cycle_count, DUT.g_hart[0].core.exmem_pc, DUT.uart_req_wdata);
         end else if (DUT.uart_req_wdata == 8'h0D) begin
           $display("[UART-BUS-WRITE] Cycle %0d: PC=0x%08h data=0x%02h <CR>",
-                   cycle_count, DUT.core.exmem_pc, DUT.uart_req_wdata);
+                   cycle_count, DUT.g_hart[0].core.exmem_pc, DUT.uart_req_wdata);
         end else begin
           $display("[UART-BUS-WRITE] Cycle %0d: PC=0x%08h data=0x%02h",
-                   cycle_count, DUT.core.exmem_pc, DUT.uart_req_wdata);
+                   cycle_count, DUT.g_hart[0].core.exmem_pc, DUT.uart_req_wdata);
         end
       end
       prev_uart_bus_write = DUT.uart_req_valid && DUT.uart_req_we && DUT.uart_req_addr == 8'h00;
@@ -251,11 +251,11 @@ module tb_freertos;
   // Memory write watchpoint - Track writes to Task B's stack (sp=0x80000864)
   // Watch ra location: sp+4 = 0x80000868
   always @(posedge clk) begin
-    if (reset_n && DUT.core.exmem_mem_write && DUT.core.exmem_valid) begin
+    if (reset_n && DUT.g_hart[0].core.exmem_mem_write && DUT.g_hart[0].core.exmem_valid) begin
       // Check if writing to address range 0x80000860-0x80000880 (Task B stack)
-      if (DUT.core.exmem_alu_result >= 32'h80000860 && DUT.core.exmem_alu_result <= 32'h80000880) begin
+      if (DUT.g_hart[0].core.exmem_alu_result >= 32'h80000860 && DUT.g_hart[0].core.exmem_alu_result <= 32'h80000880) begin
         $display("[STACK-WRITE] Cycle %0d: PC=0x%08h writes 0x%08h to addr=0x%08h",
-                 cycle_count, DUT.core.exmem_pc, DUT.core.exmem_mem_write_data, DUT.core.exmem_alu_result);
+                 cycle_count, DUT.g_hart[0].core.exmem_pc, DUT.g_hart[0].core.exmem_mem_write_data, DUT.g_hart[0].core.exmem_alu_result);
       end
     end
   end
@@ -305,19 +305,19 @@ module tb_freertos;
   //always @(posedge clk) begin
   //  if (reset_n && cycle_count >= 120 && cycle_count <= 155) begin
   //    // Monitor DMEM writes (stack operations)
-  //    if (DUT.core.exmem_mem_write && DUT.core.exmem_valid) begin
+  //    if (DUT.g_hart[0].core.exmem_mem_write && DUT.g_hart[0].core.exmem_valid) begin
   //      $display("[MEM-WRITE] Cycle %0d: addr=0x%08h, data=0x%08h, PC=0x%08h",
-  //               cycle_count, DUT.core.exmem_alu_result, DUT.core.exmem_mem_write_data, DUT.core.exmem_pc);
+  //               cycle_count, DUT.g_hart[0].core.exmem_alu_result, DUT.g_hart[0].core.exmem_mem_write_data, DUT.g_hart[0].core.exmem_pc);
   //    end
   //    // Monitor DMEM reads (stack loads)
-  //    if (DUT.core.exmem_mem_read && DUT.core.exmem_valid) begin
+  //    if (DUT.g_hart[0].core.exmem_mem_read && DUT.g_hart[0].core.exmem_valid) begin
   //      $display("[MEM-READ] Cycle %0d: addr=0x%08h, PC=0x%08h",
-  //               cycle_count, DUT.core.exmem_alu_result, DUT.core.exmem_pc);
+  //               cycle_count, DUT.g_hart[0].core.exmem_alu_result, DUT.g_hart[0].core.exmem_pc);
   //    end
   //    // Monitor WB stage loads to x1 (ra)
-  //    if (DUT.core.memwb_reg_write && DUT.core.memwb_rd_addr == 5'd1 && DUT.core.memwb_wb_sel == 3'b001) begin
+  //    if (DUT.g_hart[0].core.memwb_reg_write && DUT.g_hart[0].core.memwb_rd_addr == 5'd1 && DUT.g_hart[0].core.memwb_wb_sel == 3'b001) begin
   //      $display("[LOAD-RA] Cycle %0d: loaded ra=0x%08h from memory",
-  //               cycle_count, DUT.core.wb_data);
+  //               cycle_count, DUT.g_hart[0].core.wb_data);
   //    end
   //  end
   //end
@@ -328,46 +328,46 @@ module tb_freertos;
   always @(posedge clk) begin
     if (reset_n && cycle_count >= 39420 && cycle_count <= 39432) begin
       // Monitor all writes to ra (x1)
-      if (DUT.core.memwb_reg_write && DUT.core.memwb_rd_addr == 5'd1) begin
-        $display("[RA-WRITE-ATTEMPT] Cycle %0d: Trying to write ra=0x%08h", cycle_count, DUT.core.wb_data);
-        $display("       memwb_valid   = %b (comes from exmem_valid && !exception_from_mem && !hold_exmem)", DUT.core.memwb_valid);
-        $display("       int_reg_write_en = %b", DUT.core.int_reg_write_enable);
+      if (DUT.g_hart[0].core.memwb_reg_write && DUT.g_hart[0].core.memwb_rd_addr == 5'd1) begin
+        $display("[RA-WRITE-ATTEMPT] Cycle %0d: Trying to write ra=0x%08h", cycle_count, DUT.g_hart[0].core.wb_data);
+        $display("       memwb_valid   = %b (comes from exmem_valid && !exception_from_mem && !hold_exmem)", DUT.g_hart[0].core.memwb_valid);
+        $display("       int_reg_write_en = %b", DUT.g_hart[0].core.int_reg_write_enable);
         $display("       --- Checking why memwb_valid=0 ---");
-        $display("       exmem_valid      = %b (was JAL valid in MEM stage?)", DUT.core.exmem_valid);
-        $display("       exception_from_mem = %b (did JAL cause exception?)", DUT.core.exception_from_mem);
-        $display("       hold_exmem       = %b (was EXMEM held?)", DUT.core.hold_exmem);
-        if (DUT.core.int_reg_write_enable) begin
+        $display("       exmem_valid      = %b (was JAL valid in MEM stage?)", DUT.g_hart[0].core.exmem_valid);
+        $display("       exception_from_mem = %b (did JAL cause exception?)", DUT.g_hart[0].core.exception_from_mem);
+        $display("       hold_exmem       = %b (was EXMEM held?)", DUT.g_hart[0].core.hold_exmem);
+        if (DUT.g_hart[0].core.int_reg_write_enable) begin
           $display("       ✅ WRITE ENABLED - ra will be updated");
         end else begin
           $display("       ❌ WRITE BLOCKED - ra will NOT be updated!");
         end
       end
       // Monitor forwarding when reading ra
-      if (DUT.core.idex_valid && DUT.core.idex_rs1_addr == 5'd1) begin
+      if (DUT.g_hart[0].core.idex_valid && DUT.g_hart[0].core.idex_rs1_addr == 5'd1) begin
         $display("[RA-FORWARD] Cycle %0d: IDEX reading rs1=x1 (ra)", cycle_count);
-        $display("       idex_PC       = 0x%08h", DUT.core.idex_pc);
-        $display("       idex_instr    = 0x%08h", DUT.core.idex_instruction);
-        $display("       idex_rs1_data = 0x%08h (from IDEX pipe reg)", DUT.core.idex_rs1_data);
-        $display("       forward_a     = %b", DUT.core.forward_a);
-        $display("       memwb_rd      = x%0d", DUT.core.memwb_rd_addr);
-        $display("       memwb_reg_wr  = %b", DUT.core.memwb_reg_write);
-        $display("       memwb_valid   = %b", DUT.core.memwb_valid);
-        $display("       wb_data       = 0x%08h", DUT.core.wb_data);
-        $display("       ex_alu_op_a_fwd = 0x%08h (after forward)", DUT.core.ex_alu_operand_a_forwarded);
+        $display("       idex_PC       = 0x%08h", DUT.g_hart[0].core.idex_pc);
+        $display("       idex_instr    = 0x%08h", DUT.g_hart[0].core.idex_instruction);
+        $display("       idex_rs1_data = 0x%08h (from IDEX pipe reg)", DUT.g_hart[0].core.idex_rs1_data);
+        $display("       forward_a     = %b", DUT.g_hart[0].core.forward_a);
+        $display("       memwb_rd      = x%0d", DUT.g_hart[0].core.memwb_rd_addr);
+        $display("       memwb_reg_wr  = %b", DUT.g_hart[0].core.memwb_reg_write);
+        $display("       memwb_valid   = %b", DUT.g_hart[0].core.memwb_valid);
+        $display("       wb_data       = 0x%08h", DUT.g_hart[0].core.wb_data);
+        $display("       ex_alu_op_a_fwd = 0x%08h (after forward)", DUT.g_hart[0].core.ex_alu_operand_a_forwarded);
         $display("");
       end
       // Monitor IDEX pipeline register every cycle
       $display("[IDEX-STATE] Cycle %0d: PC=0x%08h idex_PC=0x%08h idex_instr=0x%08h idex_valid=%b idex_rs1=%0d",
-               cycle_count, DUT.core.pc_current, DUT.core.idex_pc, DUT.core.idex_instruction,
-               DUT.core.idex_valid, DUT.core.idex_rs1_addr);
+               cycle_count, DUT.g_hart[0].core.pc_current, DUT.g_hart[0].core.idex_pc, DUT.g_hart[0].core.idex_instruction,
+               DUT.g_hart[0].core.idex_valid, DUT.g_hart[0].core.idex_rs1_addr);
       // Monitor flush signals
-      if (DUT.core.flush_idex || DUT.core.ex_take_branch) begin
+      if (DUT.g_hart[0].core.flush_idex || DUT.g_hart[0].core.ex_take_branch) begin
         $display("       [FLUSH] flush_idex=%b ex_take_branch=%b trap_flush=%b",
-                 DUT.core.flush_idex, DUT.core.ex_take_branch, DUT.core.trap_flush);
+                 DUT.g_hart[0].core.flush_idex, DUT.g_hart[0].core.ex_take_branch, DUT.g_hart[0].core.trap_flush);
       end
       // Monitor ra value in register file every cycle
       $display("[RA-VALUE] Cycle %0d: ra=0x%08h",
-               cycle_count, DUT.core.regfile.registers[1]);
+               cycle_count, DUT.g_hart[0].core.regfile.registers[1]);
     end
   end
   */
@@ -378,22 +378,22 @@ module tb_freertos;
   always @(posedge clk) begin
     if (reset_n && cycle_count >= 39480 && cycle_count <= 39495) begin
       // Monitor JALR instruction in ID/EX stage
-      if (DUT.core.idex_valid && DUT.core.idex_jump && DUT.core.idex_opcode == 7'b1100111) begin
+      if (DUT.g_hart[0].core.idex_valid && DUT.g_hart[0].core.idex_jump && DUT.g_hart[0].core.idex_opcode == 7'b1100111) begin
         $display("[JALR-DEBUG] Cycle %0d: JALR detected in IDEX", cycle_count);
-        $display("       IDEX PC         = 0x%08h", DUT.core.idex_pc);
-        $display("       IDEX instr      = 0x%08h", DUT.core.idex_instruction);
-        $display("       idex_jump       = %b", DUT.core.idex_jump);
-        $display("       idex_branch     = %b", DUT.core.idex_branch);
-        $display("       idex_rs1        = x%0d", DUT.core.idex_rs1_addr);
-        $display("       idex_rs1_data   = 0x%08h", DUT.core.idex_rs1_data);
-        $display("       idex_imm        = 0x%08h", DUT.core.idex_imm);
-        $display("       ex_alu_op_a_fwd = 0x%08h (forwarded rs1)", DUT.core.ex_alu_operand_a_forwarded);
-        $display("       ex_jump_target  = 0x%08h (rs1+imm)", DUT.core.ex_jump_target);
-        $display("       ex_take_branch  = %b", DUT.core.ex_take_branch);
-        $display("       pc_next         = 0x%08h", DUT.core.pc_next);
-        $display("       trap_flush      = %b", DUT.core.trap_flush);
-        $display("       mret_flush      = %b", DUT.core.mret_flush);
-        $display("       stall_pc        = %b", DUT.core.stall_pc);
+        $display("       IDEX PC         = 0x%08h", DUT.g_hart[0].core.idex_pc);
+        $display("       IDEX instr      = 0x%08h", DUT.g_hart[0].core.idex_instruction);
+        $display("       idex_jump       = %b", DUT.g_hart[0].core.idex_jump);
+        $display("       idex_branch     = %b", DUT.g_hart[0].core.idex_branch);
+        $display("       idex_rs1        = x%0d", DUT.g_hart[0].core.idex_rs1_addr);
+        $display("       idex_rs1_data   = 0x%08h", DUT.g_hart[0].core.idex_rs1_data);
+        $display("       idex_imm        = 0x%08h", DUT.g_hart[0].core.idex_imm);
+        $display("       ex_alu_op_a_fwd = 0x%08h (forwarded rs1)", DUT.g_hart[0].core.ex_alu_operand_a_forwarded);
+        $display("       ex_jump_target  = 0x%08h (rs1+imm)", DUT.g_hart[0].core.ex_jump_target);
+        $display("       ex_take_branch  = %b", DUT.g_hart[0].core.ex_take_branch);
+        $display("       pc_next         = 0x%08h", DUT.g_hart[0].core.pc_next);
+        $display("       trap_flush      = %b", DUT.g_hart[0].core.trap_flush);
+        $display("       mret_flush      = %b", DUT.g_hart[0].core.mret_flush);
+        $display("       stall_pc        = %b", DUT.g_hart[0].core.stall_pc);
         $display("");
       end
     end
@@ -407,35 +407,35 @@ module tb_freertos;
   always @(posedge clk) begin
     if (reset_n) begin
       // Detect exception at the moment it occurs (before CSR update and pipeline flush)
-      if (DUT.core.exception_gated && !exception_detected_prev) begin
+      if (DUT.g_hart[0].core.exception_gated && !exception_detected_prev) begin
         $display("");
         $display("[EXCEPTION-DETECTION] *** Exception detected at cycle %0d (BEFORE flush) ***", cycle_count);
-        $display("       PC (current)      = 0x%08h", DUT.core.pc_current);
-        $display("       IFID PC           = 0x%08h", DUT.core.ifid_pc);
-        $display("       IFID instruction  = 0x%08h (raw in IFID)", DUT.core.ifid_instruction);
-        $display("       IDEX PC           = 0x%08h", DUT.core.idex_pc);
-        $display("       IDEX instruction  = 0x%08h (in IDEX - used for mtval)", DUT.core.idex_instruction);
-        $display("       IDEX valid        = %b", DUT.core.idex_valid);
-        $display("       IDEX illegal_inst = %b", DUT.core.idex_illegal_inst);
-        $display("       Exception code    = %0d", DUT.core.exception_code);
-        $display("       Exception PC      = 0x%08h", DUT.core.exception_pc);
-        $display("       Exception val     = 0x%08h", DUT.core.exception_val);
-        $display("       MSTATUS           = 0x%08h", DUT.core.csr_file_inst.mstatus_r);
+        $display("       PC (current)      = 0x%08h", DUT.g_hart[0].core.pc_current);
+        $display("       IFID PC           = 0x%08h", DUT.g_hart[0].core.ifid_pc);
+        $display("       IFID instruction  = 0x%08h (raw in IFID)", DUT.g_hart[0].core.ifid_instruction);
+        $display("       IDEX PC           = 0x%08h", DUT.g_hart[0].core.idex_pc);
+        $display("       IDEX instruction  = 0x%08h (in IDEX - used for mtval)", DUT.g_hart[0].core.idex_instruction);
+        $display("       IDEX valid        = %b", DUT.g_hart[0].core.idex_valid);
+        $display("       IDEX illegal_inst = %b", DUT.g_hart[0].core.idex_illegal_inst);
+        $display("       Exception code    = %0d", DUT.g_hart[0].core.exception_code);
+        $display("       Exception PC      = 0x%08h", DUT.g_hart[0].core.exception_pc);
+        $display("       Exception val     = 0x%08h", DUT.g_hart[0].core.exception_val);
+        $display("       MSTATUS           = 0x%08h", DUT.g_hart[0].core.csr_file_inst.mstatus_r);
         $display("       MSTATUS.FS        = %b (00=Off, 01=Initial, 10=Clean, 11=Dirty)",
-                 DUT.core.csr_file_inst.mstatus_r[14:13]);
-        $display("       Control illegal   = %b", DUT.core.id_illegal_inst);
-        $display("       Flush signals     = ifid:%b idex:%b", DUT.core.flush_ifid, DUT.core.flush_idex);
+                 DUT.g_hart[0].core.csr_file_inst.mstatus_r[14:13]);
+        $display("       Control illegal   = %b", DUT.g_hart[0].core.id_illegal_inst);
+        $display("       Flush signals     = ifid:%b idex:%b", DUT.g_hart[0].core.flush_ifid, DUT.g_hart[0].core.flush_idex);
 
         // Decode IDEX instruction for better understanding
-        if (DUT.core.idex_instruction[1:0] == 2'b11) begin
+        if (DUT.g_hart[0].core.idex_instruction[1:0] == 2'b11) begin
           $display("       Instruction type  = 32-bit (non-compressed)");
-          $display("       Opcode            = 0b%07b", DUT.core.idex_instruction[6:0]);
+          $display("       Opcode            = 0b%07b", DUT.g_hart[0].core.idex_instruction[6:0]);
         end else begin
           $display("       Instruction type  = 16-bit compressed (bits [1:0] = %b)",
-                   DUT.core.idex_instruction[1:0]);
+                   DUT.g_hart[0].core.idex_instruction[1:0]);
         end
       end
-      exception_detected_prev = DUT.core.exception_gated;
+      exception_detected_prev = DUT.g_hart[0].core.exception_gated;
     end
   end
 
@@ -448,23 +448,23 @@ module tb_freertos;
   always @(posedge clk) begin
     if (reset_n) begin
       // Monitor CSRs for trap entry
-      if (DUT.core.csr_file_inst.mcause_r != prev_mcause || DUT.core.csr_file_inst.mepc_r != prev_mepc) begin
-        if (DUT.core.csr_file_inst.mcause_r != 0) begin
+      if (DUT.g_hart[0].core.csr_file_inst.mcause_r != prev_mcause || DUT.g_hart[0].core.csr_file_inst.mepc_r != prev_mepc) begin
+        if (DUT.g_hart[0].core.csr_file_inst.mcause_r != 0) begin
           $display("");
           $display("[TRAP-CSR-UPDATE] Exception CSRs updated at cycle %0d (AFTER flush)", cycle_count);
           $display("       mcause = 0x%016h (interrupt=%b, code=%0d)",
-                   DUT.core.csr_file_inst.mcause_r,
-                   DUT.core.csr_file_inst.mcause_r[63],
-                   DUT.core.csr_file_inst.mcause_r[3:0]);
-          $display("       mepc   = 0x%08h", DUT.core.csr_file_inst.mepc_r);
-          $display("       mtval  = 0x%08h (captured instruction)", DUT.core.csr_file_inst.mtval_r);
+                   DUT.g_hart[0].core.csr_file_inst.mcause_r,
+                   DUT.g_hart[0].core.csr_file_inst.mcause_r[63],
+                   DUT.g_hart[0].core.csr_file_inst.mcause_r[3:0]);
+          $display("       mepc   = 0x%08h", DUT.g_hart[0].core.csr_file_inst.mepc_r);
+          $display("       mtval  = 0x%08h (captured instruction)", DUT.g_hart[0].core.csr_file_inst.mtval_r);
           $display("       PC     = 0x%08h (trap handler)", pc);
-          $display("       ifid_instruction = 0x%08h (ID stage NOW)", DUT.core.ifid_instruction);
-          $display("       if_instruction_raw = 0x%08h (IF stage raw)", DUT.core.if_instruction_raw);
-          $display("       if_instruction = 0x%08h (IF stage final)", DUT.core.if_instruction);
+          $display("       ifid_instruction = 0x%08h (ID stage NOW)", DUT.g_hart[0].core.ifid_instruction);
+          $display("       if_instruction_raw = 0x%08h (IF stage raw)", DUT.g_hart[0].core.if_instruction_raw);
+          $display("       if_instruction = 0x%08h (IF stage final)", DUT.g_hart[0].core.if_instruction);
         end
-        prev_mcause = DUT.core.csr_file_inst.mcause_r;
-        prev_mepc = DUT.core.csr_file_inst.mepc_r;
+        prev_mcause = DUT.g_hart[0].core.csr_file_inst.mcause_r;
+        prev_mepc = DUT.g_hart[0].core.csr_file_inst.mepc_r;
       end
     end
   end
@@ -499,14 +499,14 @@ module tb_freertos;
       if (0 && cycle_count >= 603 && cycle_count <= 612) begin
         $display("[PIPELINE] Cycle %0d:", cycle_count);
         $display("  IF: PC=0x%08h, raw=0x%08h, final=0x%08h, compressed=%b",
-                 DUT.core.pc_current, DUT.core.if_instruction_raw,
-                 DUT.core.if_instruction, DUT.core.if_is_compressed);
+                 DUT.g_hart[0].core.pc_current, DUT.g_hart[0].core.if_instruction_raw,
+                 DUT.g_hart[0].core.if_instruction, DUT.g_hart[0].core.if_is_compressed);
         $display("  ID: instruction=0x%08h, valid=%b",
-                 DUT.core.ifid_instruction, DUT.core.ifid_valid);
+                 DUT.g_hart[0].core.ifid_instruction, DUT.g_hart[0].core.ifid_valid);
         $display("  EX: instruction=0x%08h, valid=%b",
-                 DUT.core.idex_instruction, DUT.core.idex_valid);
+                 DUT.g_hart[0].core.idex_instruction, DUT.g_hart[0].core.idex_valid);
         $display("  Exception: code=%0d, gated=%b",
-                 DUT.core.exception_code, DUT.core.exception_gated);
+                 DUT.g_hart[0].core.exception_code, DUT.g_hart[0].core.exception_gated);
       end
 
       // Detailed trace around puts() call (cycles 117-125) - COMMENTED OUT FOR SPEED
@@ -517,17 +517,17 @@ module tb_freertos;
 
       // Trace link register writes - COMMENTED OUT FOR SPEED
       //if (cycle_count >= 117 && cycle_count <= 160) begin
-      //  if (DUT.core.int_reg_write_enable && DUT.core.memwb_rd_addr == 5'd1) begin
+      //  if (DUT.g_hart[0].core.int_reg_write_enable && DUT.g_hart[0].core.memwb_rd_addr == 5'd1) begin
       //    $display("[LINK-REG] Cycle %0d: Writing ra(x1) = 0x%08h (wb_sel=%b, wen=%b, valid=%b)",
-      //             cycle_count, DUT.core.wb_data, DUT.core.memwb_wb_sel,
-      //             DUT.core.int_reg_write_enable, DUT.core.memwb_valid);
+      //             cycle_count, DUT.g_hart[0].core.wb_data, DUT.g_hart[0].core.memwb_wb_sel,
+      //             DUT.g_hart[0].core.int_reg_write_enable, DUT.g_hart[0].core.memwb_valid);
       //  end
       //end
 
       // Trace register x1 (ra) value changes - COMMENTED OUT FOR SPEED
       //if (cycle_count >= 120 && cycle_count <= 130) begin
       //  $display("[REG-ra] Cycle %0d: ra(x1) value = 0x%08h",
-      //           cycle_count, DUT.core.regfile.registers[1]);
+      //           cycle_count, DUT.g_hart[0].core.regfile.registers[1]);
       //end
 
       // Detect main() reached (address 0x1b6e)
@@ -568,16 +568,16 @@ module tb_freertos;
         $display("[INIT-ARRAY] cycle=%0d PC=%h instruction=%h",
                  cycle_count, pc, instruction);
         $display("             t0(x5)=%h t1(x6)=%h t2(x7)=%h",
-                 DUT.core.regfile.registers[5], DUT.core.regfile.registers[6], DUT.core.regfile.registers[7]);
+                 DUT.g_hart[0].core.regfile.registers[5], DUT.g_hart[0].core.regfile.registers[6], DUT.g_hart[0].core.regfile.registers[7]);
       end
 
       // Session 63: Track sp changes - detect when sp != 0x80040a90
       // DISABLED for performance - Session 75 minimal test
       /*
       if (cycle_count >= 39171 && cycle_count <= 39400) begin
-        if (DUT.core.regfile.registers[2] != 32'h80040a90 && DUT.core.regfile.registers[2] != 32'h80040a10) begin
+        if (DUT.g_hart[0].core.regfile.registers[2] != 32'h80040a90 && DUT.g_hart[0].core.regfile.registers[2] != 32'h80040a10) begin
           $display("[SP-CHANGE] cycle=%0d PC=%h sp=%h (changed from 0x80040a90!)",
-                   cycle_count, pc, DUT.core.regfile.registers[2]);
+                   cycle_count, pc, DUT.g_hart[0].core.regfile.registers[2]);
         end
       end
       */
@@ -587,13 +587,13 @@ module tb_freertos;
       /*
       if (cycle_count >= 39370 && cycle_count <= 39500) begin
         $display("[MRET-TRACE] cycle=%0d PC=%h ifid_PC=%h idex_PC=%h exmem_PC=%h",
-                 cycle_count, pc, DUT.core.ifid_pc, DUT.core.idex_pc, DUT.core.exmem_pc);
+                 cycle_count, pc, DUT.g_hart[0].core.ifid_pc, DUT.g_hart[0].core.idex_pc, DUT.g_hart[0].core.exmem_pc);
         $display("             idex_inst=%h exmem_inst=%h",
-                 DUT.core.idex_instruction, DUT.core.exmem_instruction);
+                 DUT.g_hart[0].core.idex_instruction, DUT.g_hart[0].core.exmem_instruction);
         $display("             idex_is_mret=%b exmem_is_mret=%b mret_flush=%b",
-                 DUT.core.idex_is_mret, DUT.core.exmem_is_mret, DUT.core.mret_flush);
+                 DUT.g_hart[0].core.idex_is_mret, DUT.g_hart[0].core.exmem_is_mret, DUT.g_hart[0].core.mret_flush);
         $display("             mepc=%h pc_next=%h exception=%b",
-                 DUT.core.mepc, DUT.core.pc_next, DUT.core.exception);
+                 DUT.g_hart[0].core.mepc, DUT.g_hart[0].core.pc_next, DUT.g_hart[0].core.exception);
       end
       */
 
@@ -602,41 +602,41 @@ module tb_freertos;
         // Show register values during rodata copy - FIRST ITERATION ONLY
         if (pc == 32'h00000056 && cycle_count == 41) begin
           $display("[RODATA-COPY] Cycle %0d: rodata_copy_loop FIRST ITERATION - t0(src)=0x%08h, t1(dst)=0x%08h, t2(end)=0x%08h",
-                   cycle_count, DUT.core.regfile.registers[5], DUT.core.regfile.registers[6], DUT.core.regfile.registers[7]);
+                   cycle_count, DUT.g_hart[0].core.regfile.registers[5], DUT.g_hart[0].core.regfile.registers[6], DUT.g_hart[0].core.regfile.registers[7]);
           // Check what's in IMEM at .rodata addresses (including where strings are!)
           $display("[RODATA-COPY]   CORE IMEM[0x3de8] = 0x%02h%02h%02h%02h (.rodata start - mostly zeros)",
-                   DUT.core.imem.mem[32'h3deb], DUT.core.imem.mem[32'h3dea], DUT.core.imem.mem[32'h3de9], DUT.core.imem.mem[32'h3de8]);
+                   DUT.g_hart[0].core.imem.mem[32'h3deb], DUT.g_hart[0].core.imem.mem[32'h3dea], DUT.g_hart[0].core.imem.mem[32'h3de9], DUT.g_hart[0].core.imem.mem[32'h3de8]);
           $display("[RODATA-COPY]   CORE IMEM[0x42b8] = 0x%02h%02h%02h%02h (should be '[Task' = 0x5B 54 61 73)",
-                   DUT.core.imem.mem[32'h42bb], DUT.core.imem.mem[32'h42ba], DUT.core.imem.mem[32'h42b9], DUT.core.imem.mem[32'h42b8]);
+                   DUT.g_hart[0].core.imem.mem[32'h42bb], DUT.g_hart[0].core.imem.mem[32'h42ba], DUT.g_hart[0].core.imem.mem[32'h42b9], DUT.g_hart[0].core.imem.mem[32'h42b8]);
           $display("[RODATA-COPY]   DATA PORT IMEM[0x42b8] = 0x%02h%02h%02h%02h",
                    DUT.imem_data_port.mem[32'h42bb], DUT.imem_data_port.mem[32'h42ba], DUT.imem_data_port.mem[32'h42b9], DUT.imem_data_port.mem[32'h42b8]);
         end
         // Monitor loads from IMEM during rodata copy - FIRST FEW ITERATIONS
-        if (DUT.core.exmem_mem_read && DUT.core.exmem_valid && cycle_count <= 100) begin
+        if (DUT.g_hart[0].core.exmem_mem_read && DUT.g_hart[0].core.exmem_valid && cycle_count <= 100) begin
           $display("[RODATA-COPY] Cycle %0d: LW from addr=0x%08h, data=0x%08h",
-                   cycle_count, DUT.core.exmem_alu_result, DUT.core.mem_read_data);
+                   cycle_count, DUT.g_hart[0].core.exmem_alu_result, DUT.g_hart[0].core.mem_read_data);
           $display("[RODATA-COPY]   IMEM_DATA_PORT: addr=0x%08h, instruction=0x%08h",
                    DUT.imem_req_addr, DUT.imem_data_port_instruction);
           $display("[RODATA-COPY]   Bus: imem_req_valid=%b, imem_req_ready=%b",
                    DUT.imem_req_valid, DUT.imem_req_ready);
         end
         // Monitor stores to DMEM during rodata copy - FIRST FEW ITERATIONS
-        if (DUT.core.exmem_mem_write && DUT.core.exmem_valid && cycle_count <= 100) begin
+        if (DUT.g_hart[0].core.exmem_mem_write && DUT.g_hart[0].core.exmem_valid && cycle_count <= 100) begin
           $display("[RODATA-COPY] Cycle %0d: SW to addr=0x%08h, data=0x%08h",
-                   cycle_count, DUT.core.exmem_alu_result, DUT.core.exmem_mem_write_data);
+                   cycle_count, DUT.g_hart[0].core.exmem_alu_result, DUT.g_hart[0].core.exmem_mem_write_data);
         end
         if (pc == 32'h00000068 && cycle_count < 2000) begin
           $display("[RODATA-COPY] Cycle %0d: rodata_copy_done - copied %0d bytes",
-                   cycle_count, (DUT.core.regfile.registers[6] - 32'h80000000));
+                   cycle_count, (DUT.g_hart[0].core.regfile.registers[6] - 32'h80000000));
         end
       end
 
       // Monitor printf calls - Session 33 debug
       if (pc == 32'h000026ea) begin  // printf entry point
         $display("[PRINTF] Cycle %0d: printf() called with format string at a0=0x%08h",
-                 cycle_count, DUT.core.regfile.registers[10]);
+                 cycle_count, DUT.g_hart[0].core.regfile.registers[10]);
         // Read first 4 bytes of format string from DMEM
-        if (DUT.core.regfile.registers[10] >= 32'h80000000 && DUT.core.regfile.registers[10] < 32'h80100000) begin
+        if (DUT.g_hart[0].core.regfile.registers[10] >= 32'h80000000 && DUT.g_hart[0].core.regfile.registers[10] < 32'h80100000) begin
           $display("[PRINTF]   Format string in DMEM range (good!)");
         end else begin
           $display("[PRINTF]   WARNING: Format string NOT in DMEM range!");
@@ -719,10 +719,10 @@ module tb_freertos;
       end
 
       // Monitor ALL memory writes during timer setup
-      if (DUT.core.exmem_mem_write && DUT.core.exmem_valid &&
-          DUT.core.exmem_pc >= 32'h00001b8e && DUT.core.exmem_pc <= 32'h00001bf2) begin
+      if (DUT.g_hart[0].core.exmem_mem_write && DUT.g_hart[0].core.exmem_valid &&
+          DUT.g_hart[0].core.exmem_pc >= 32'h00001b8e && DUT.g_hart[0].core.exmem_pc <= 32'h00001bf2) begin
         $display("[TIMER-STORE] Cycle %0d: PC=0x%08h writes 0x%08h to addr 0x%08h",
-                 cycle_count, DUT.core.exmem_pc, DUT.core.exmem_mem_write_data, DUT.core.exmem_alu_result);
+                 cycle_count, DUT.g_hart[0].core.exmem_pc, DUT.g_hart[0].core.exmem_mem_write_data, DUT.g_hart[0].core.exmem_alu_result);
       end
 
       // Monitor ALL bus requests to CLINT address range
@@ -737,10 +737,10 @@ module tb_freertos;
       if (DUT.clint_req_valid && DUT.clint_req_ready) begin
         if (DUT.clint_req_we) begin
           $display("[CLINT-WRITE] Cycle %0d: PC=0x%08h writes 0x%08h to CLINT addr 0x%08h",
-                   cycle_count, DUT.core.exmem_pc, DUT.clint_req_wdata, DUT.clint_req_addr);
+                   cycle_count, DUT.g_hart[0].core.exmem_pc, DUT.clint_req_wdata, DUT.clint_req_addr);
         end else begin
           $display("[CLINT-READ] Cycle %0d: PC=0x%08h reads from CLINT addr 0x%08h",
-                   cycle_count, DUT.core.exmem_pc, DUT.clint_req_addr);
+                   cycle_count, DUT.g_hart[0].core.exmem_pc, DUT.clint_req_addr);
         end
       end
 
@@ -794,9 +794,9 @@ module tb_freertos;
         // BGE rs1, rs2, offset: imm[12|10:5] rs2 rs1 101 imm[4:1|11] 1100011
 
         // Read t0 (x5) and t1 (x6) from core registers
-        // Hierarchy: DUT.core.regfile.registers (not regs)
-        bss_start_addr = DUT.core.regfile.registers[5];  // t0 = start address
-        bss_end_addr = DUT.core.regfile.registers[6];    // t1 = end address
+        // Hierarchy: DUT.g_hart[0].core.regfile.registers (not regs)
+        bss_start_addr = DUT.g_hart[0].core.regfile.registers[5];  // t0 = start address
+        bss_end_addr = DUT.g_hart[0].core.regfile.registers[6];    // t1 = end address
 
         // Validate addresses (BSS should be in DMEM: 0x8000_0000 - 0x8010_0000)
         if (bss_start_addr >= 32'h80000000 && bss_start_addr < 32'h80100000 &&
@@ -839,13 +839,13 @@ module tb_freertos;
       end
 
       // Update t0 register to point past BSS (simulates loop completion)
-      DUT.core.regfile.registers[5] = bss_end_addr;
+      DUT.g_hart[0].core.regfile.registers[5] = bss_end_addr;
 
       // Force PC to jump to bss_zero_done (address 0x3e)
-      // Hierarchy: DUT.core.pc_inst.pc_current
-      force DUT.core.pc_inst.pc_current = 32'h0000003e;
+      // Hierarchy: DUT.g_hart[0].core.pc_inst.pc_current
+      force DUT.g_hart[0].core.pc_inst.pc_current = 32'h0000003e;
       #1;  // Hold for 1 time unit
-      release DUT.core.pc_inst.pc_current;
+      release DUT.g_hart[0].core.pc_inst.pc_current;
 
       $display("[BSS-ACCEL] Cleared %0d KB in 1 cycle (saved ~%0d cycles)",
                bss_cleared_bytes / 1024, (bss_cleared_bytes / 4 * 3) - 1);
@@ -870,10 +870,10 @@ module tb_freertos;
         $display("========================================");
         $display("[ASSERTION] *** vApplicationAssertionFailed() called at cycle %0d ***", cycle_count);
         $display("========================================");
-        $display("[ASSERTION] Return address (ra) = 0x%08h", DUT.core.regfile.registers[1]);
+        $display("[ASSERTION] Return address (ra) = 0x%08h", DUT.g_hart[0].core.regfile.registers[1]);
 
         // Decode which assertion based on ra
-        if (DUT.core.regfile.registers[1] == 32'h00001238) begin
+        if (DUT.g_hart[0].core.regfile.registers[1] == 32'h00001238) begin
           $display("[ASSERTION] Called from xQueueGenericCreateStatic -> xQueueGenericReset");
           $display("[ASSERTION] Checking which assert in xQueueGenericReset...");
           $display("[ASSERTION] Possible: 0x11c8 (queue==NULL) or 0x11cc (size check)");
@@ -892,30 +892,30 @@ module tb_freertos;
       // Track entry to xQueueGenericReset to see parameters (address 0x1114)
       if (pc == 32'h00001114) begin
         $display("[QUEUE-RESET] xQueueGenericReset called at cycle %0d", cycle_count);
-        $display("[QUEUE-RESET] a0 (queue ptr) = 0x%08h", DUT.core.regfile.registers[10]);
-        $display("[QUEUE-RESET] a1 (reset type) = 0x%08h", DUT.core.regfile.registers[11]);
+        $display("[QUEUE-RESET] a0 (queue ptr) = 0x%08h", DUT.g_hart[0].core.regfile.registers[10]);
+        $display("[QUEUE-RESET] a1 (reset type) = 0x%08h", DUT.g_hart[0].core.regfile.registers[11]);
       end
 
       // Track a0 corruption in xQueueGenericCreateStatic (0x11ba - 0x11e2)
       if (pc >= 32'h000011ba && pc <= 32'h000011e2) begin
         if (pc == 32'h000011ba || pc == 32'h000011c4 || pc == 32'h000011ce ||
             pc == 32'h000011da || pc == 32'h000011de || pc == 32'h000011e2) begin
-          $display("[A0-TRACE] PC=0x%08h: a0 (x10) = 0x%08h", pc, DUT.core.regfile.registers[10]);
+          $display("[A0-TRACE] PC=0x%08h: a0 (x10) = 0x%08h", pc, DUT.g_hart[0].core.regfile.registers[10]);
         end
       end
 
       // Track store at 0x11e2 that corrupts queueLength
       if (pc == 32'h000011e2) begin
         $display("[STORE-DEBUG] PC=0x11e2: sw a0,60(s0)");
-        $display("[STORE-DEBUG]   a0 (x10) = 0x%08h (value to store)", DUT.core.regfile.registers[10]);
-        $display("[STORE-DEBUG]   s0 (x8) = 0x%08h (base pointer)", DUT.core.regfile.registers[8]);
-        $display("[STORE-DEBUG]   Target address = 0x%08h", DUT.core.regfile.registers[8] + 60);
+        $display("[STORE-DEBUG]   a0 (x10) = 0x%08h (value to store)", DUT.g_hart[0].core.regfile.registers[10]);
+        $display("[STORE-DEBUG]   s0 (x8) = 0x%08h (base pointer)", DUT.g_hart[0].core.regfile.registers[8]);
+        $display("[STORE-DEBUG]   Target address = 0x%08h", DUT.g_hart[0].core.regfile.registers[8] + 60);
       end
 
       // Track check at 0x1122 (beqz a5,1182) - checks if queueLength is zero
       if (pc == 32'h00001122) begin
-        $display("[QUEUE-CHECK] PC=0x1122: queueLength (a5) = 0x%08h", DUT.core.regfile.registers[15]);
-        if (DUT.core.regfile.registers[15] == 0) begin
+        $display("[QUEUE-CHECK] PC=0x1122: queueLength (a5) = 0x%08h", DUT.g_hart[0].core.regfile.registers[15]);
+        if (DUT.g_hart[0].core.regfile.registers[15] == 0) begin
           $display("[QUEUE-CHECK] *** ASSERTION WILL FAIL: queueLength is ZERO! ***");
         end
       end
@@ -923,25 +923,25 @@ module tb_freertos;
       // Track where a5 gets loaded from memory at 0x111e
       if (pc == 32'h0000111e) begin
         $display("[LOAD-CHECK] PC=0x111e: Loading queueLength from offset 60");
-        $display("[LOAD-CHECK]   a0 (base ptr) = 0x%08h", DUT.core.regfile.registers[10]);
-        $display("[LOAD-CHECK]   Will load from addr = 0x%08h", DUT.core.regfile.registers[10] + 60);
+        $display("[LOAD-CHECK]   a0 (base ptr) = 0x%08h", DUT.g_hart[0].core.regfile.registers[10]);
+        $display("[LOAD-CHECK]   Will load from addr = 0x%08h", DUT.g_hart[0].core.regfile.registers[10] + 60);
       end
 
       // Track multiplication inputs at 0x1126 (mulhu a5,a5,a4)
       if (pc == 32'h00001126) begin
         $display("[QUEUE-CHECK] PC=0x1126: About to execute MULHU:");
         $display("[QUEUE-CHECK]   a5 (queueLength) = %0d (0x%08h)",
-                 DUT.core.regfile.registers[15], DUT.core.regfile.registers[15]);
+                 DUT.g_hart[0].core.regfile.registers[15], DUT.g_hart[0].core.regfile.registers[15]);
         $display("[QUEUE-CHECK]   a4 (itemSize) = %0d (0x%08h)",
-                 DUT.core.regfile.registers[14], DUT.core.regfile.registers[14]);
+                 DUT.g_hart[0].core.regfile.registers[14], DUT.g_hart[0].core.regfile.registers[14]);
         $display("[QUEUE-CHECK]   Expected product (a5*a4) = %0d",
-                 DUT.core.regfile.registers[15] * DUT.core.regfile.registers[14]);
+                 DUT.g_hart[0].core.regfile.registers[15] * DUT.g_hart[0].core.regfile.registers[14]);
       end
 
       // Track check at 0x112a (bnez a5,1182) - checks if multiplication overflows
       if (pc == 32'h0000112a) begin
-        $display("[QUEUE-CHECK] PC=0x112a: mulhu result (a5) = 0x%08h", DUT.core.regfile.registers[15]);
-        if (DUT.core.regfile.registers[15] != 0) begin
+        $display("[QUEUE-CHECK] PC=0x112a: mulhu result (a5) = 0x%08h", DUT.g_hart[0].core.regfile.registers[15]);
+        if (DUT.g_hart[0].core.regfile.registers[15] != 0) begin
           $display("[QUEUE-CHECK] *** ASSERTION WILL FAIL: queueLength * itemSize OVERFLOWS! ***");
         end
       end
@@ -957,10 +957,10 @@ module tb_freertos;
       if (pc == 32'h0000122c && cycle_count >= 31700) begin
         $display("========================================");
         $display("[REG-TRACE] Cycle %0d: At PC 0x122c (sw a0,60(s0))", cycle_count);
-        $display("[REG-TRACE]   a0 (x10) = 0x%08h (will be stored as queueLength)", DUT.core.regfile.registers[10]);
-        $display("[REG-TRACE]   a1 (x11) = 0x%08h (will be stored as itemSize)", DUT.core.regfile.registers[11]);
-        $display("[REG-TRACE]   s0 (x8)  = 0x%08h (base pointer)", DUT.core.regfile.registers[8]);
-        $display("[REG-TRACE]   Target addr = 0x%08h", DUT.core.regfile.registers[8] + 60);
+        $display("[REG-TRACE]   a0 (x10) = 0x%08h (will be stored as queueLength)", DUT.g_hart[0].core.regfile.registers[10]);
+        $display("[REG-TRACE]   a1 (x11) = 0x%08h (will be stored as itemSize)", DUT.g_hart[0].core.regfile.registers[11]);
+        $display("[REG-TRACE]   s0 (x8)  = 0x%08h (base pointer)", DUT.g_hart[0].core.regfile.registers[8]);
+        $display("[REG-TRACE]   Target addr = 0x%08h", DUT.g_hart[0].core.regfile.registers[8] + 60);
       end
     end
   end
@@ -972,16 +972,16 @@ module tb_freertos;
   always @(posedge clk) begin
     if (reset_n) begin
       // Track stores to address 0x800004c8 (queueLength - corrupted to 10)
-      if (DUT.core.exmem_valid && DUT.core.exmem_mem_write) begin
-        if (DUT.core.exmem_alu_result == 32'h800004c8 ||
-            (DUT.core.exmem_alu_result >= 32'h800004c4 && DUT.core.exmem_alu_result <= 32'h800004cc)) begin
+      if (DUT.g_hart[0].core.exmem_valid && DUT.g_hart[0].core.exmem_mem_write) begin
+        if (DUT.g_hart[0].core.exmem_alu_result == 32'h800004c8 ||
+            (DUT.g_hart[0].core.exmem_alu_result >= 32'h800004c4 && DUT.g_hart[0].core.exmem_alu_result <= 32'h800004cc)) begin
           $display("========================================");
           $display("[MEM-WRITE] Cycle %0d: Store to queue structure!", cycle_count);
-          $display("[MEM-WRITE]   PC = 0x%08h", DUT.core.exmem_pc);
-          $display("[MEM-WRITE]   Address = 0x%08h", DUT.core.exmem_alu_result);
-          $display("[MEM-WRITE]   Data = 0x%08h", DUT.core.exmem_mem_write_data);
-          $display("[MEM-WRITE]   funct3 = %b", DUT.core.exmem_funct3);
-          if (DUT.core.exmem_alu_result == 32'h800004c8) begin
+          $display("[MEM-WRITE]   PC = 0x%08h", DUT.g_hart[0].core.exmem_pc);
+          $display("[MEM-WRITE]   Address = 0x%08h", DUT.g_hart[0].core.exmem_alu_result);
+          $display("[MEM-WRITE]   Data = 0x%08h", DUT.g_hart[0].core.exmem_mem_write_data);
+          $display("[MEM-WRITE]   funct3 = %b", DUT.g_hart[0].core.exmem_funct3);
+          if (DUT.g_hart[0].core.exmem_alu_result == 32'h800004c8) begin
             $display("[MEM-WRITE]   *** This is address 0x800004c8 (queueLength field)! ***");
           end
         end
@@ -996,44 +996,44 @@ module tb_freertos;
   always @(posedge clk) begin
     if (reset_n) begin
       // Track load in ID stage
-      if (DUT.core.ifid_valid && DUT.core.ifid_pc == 32'h00001168) begin
+      if (DUT.g_hart[0].core.ifid_valid && DUT.g_hart[0].core.ifid_pc == 32'h00001168) begin
         $display("========================================");
         $display("[LOAD-ID] Cycle %0d: Load at PC 0x1168 in ID stage", cycle_count);
-        $display("[LOAD-ID]   Instruction = 0x%08h", DUT.core.ifid_instruction);
-        $display("[LOAD-ID]   rs1 = x%0d, rd = x%0d", DUT.core.id_rs1, DUT.core.id_rd);
-        $display("[LOAD-ID]   RegFile rs1 (base) = 0x%08h", DUT.core.regfile.registers[DUT.core.id_rs1]);
-        $display("[LOAD-ID]   Immediate offset = 0x%08h", DUT.core.id_immediate);
+        $display("[LOAD-ID]   Instruction = 0x%08h", DUT.g_hart[0].core.ifid_instruction);
+        $display("[LOAD-ID]   rs1 = x%0d, rd = x%0d", DUT.g_hart[0].core.id_rs1, DUT.g_hart[0].core.id_rd);
+        $display("[LOAD-ID]   RegFile rs1 (base) = 0x%08h", DUT.g_hart[0].core.regfile.registers[DUT.g_hart[0].core.id_rs1]);
+        $display("[LOAD-ID]   Immediate offset = 0x%08h", DUT.g_hart[0].core.id_immediate);
         $display("[LOAD-ID]   Target address = 0x%08h",
-                 DUT.core.regfile.registers[DUT.core.id_rs1] + DUT.core.id_immediate);
+                 DUT.g_hart[0].core.regfile.registers[DUT.g_hart[0].core.id_rs1] + DUT.g_hart[0].core.id_immediate);
       end
 
       // Track load in EX stage
-      if (DUT.core.idex_valid && DUT.core.idex_pc == 32'h00001168) begin
+      if (DUT.g_hart[0].core.idex_valid && DUT.g_hart[0].core.idex_pc == 32'h00001168) begin
         $display("========================================");
         $display("[LOAD-EX] Cycle %0d: Load at PC 0x1168 in EX stage", cycle_count);
-        $display("[LOAD-EX]   ALU result (address) = 0x%08h", DUT.core.ex_alu_result);
-        $display("[LOAD-EX]   rs1_data = 0x%08h", DUT.core.idex_rs1_data);
-        $display("[LOAD-EX]   immediate = 0x%08h", DUT.core.idex_imm);
-        $display("[LOAD-EX]   rd = x%0d", DUT.core.idex_rd_addr);
+        $display("[LOAD-EX]   ALU result (address) = 0x%08h", DUT.g_hart[0].core.ex_alu_result);
+        $display("[LOAD-EX]   rs1_data = 0x%08h", DUT.g_hart[0].core.idex_rs1_data);
+        $display("[LOAD-EX]   immediate = 0x%08h", DUT.g_hart[0].core.idex_imm);
+        $display("[LOAD-EX]   rd = x%0d", DUT.g_hart[0].core.idex_rd_addr);
       end
 
       // Track load in MEM stage
-      if (DUT.core.exmem_valid && DUT.core.exmem_pc == 32'h00001168) begin
+      if (DUT.g_hart[0].core.exmem_valid && DUT.g_hart[0].core.exmem_pc == 32'h00001168) begin
         $display("========================================");
         $display("[LOAD-MEM] Cycle %0d: Load at PC 0x1168 in MEM stage", cycle_count);
-        $display("[LOAD-MEM]   Memory address = 0x%08h", DUT.core.exmem_alu_result);
-        $display("[LOAD-MEM]   mem_read = %b", DUT.core.exmem_mem_read);
-        $display("[LOAD-MEM]   mem_read_data = 0x%08h", DUT.core.mem_read_data);
-        $display("[LOAD-MEM]   rd = x%0d", DUT.core.exmem_rd_addr);
-        $display("[LOAD-MEM]   wb_sel = %b", DUT.core.exmem_wb_sel);
+        $display("[LOAD-MEM]   Memory address = 0x%08h", DUT.g_hart[0].core.exmem_alu_result);
+        $display("[LOAD-MEM]   mem_read = %b", DUT.g_hart[0].core.exmem_mem_read);
+        $display("[LOAD-MEM]   mem_read_data = 0x%08h", DUT.g_hart[0].core.mem_read_data);
+        $display("[LOAD-MEM]   rd = x%0d", DUT.g_hart[0].core.exmem_rd_addr);
+        $display("[LOAD-MEM]   wb_sel = %b", DUT.g_hart[0].core.exmem_wb_sel);
       end
 
       // Track ALL WB stage activity around the critical cycles (detect load by rd=x14)
-      if (cycle_count >= 31720 && cycle_count <= 31735 && DUT.core.memwb_valid && DUT.core.memwb_reg_write) begin
+      if (cycle_count >= 31720 && cycle_count <= 31735 && DUT.g_hart[0].core.memwb_valid && DUT.g_hart[0].core.memwb_reg_write) begin
         $display("[WB-TRACE] Cycle %0d: WB writing x%0d <= 0x%08h (wb_sel=%b, mem_data=0x%08h)",
-                 cycle_count, DUT.core.memwb_rd_addr, DUT.core.wb_data, DUT.core.memwb_wb_sel,
-                 DUT.core.memwb_mem_read_data);
-        if (DUT.core.memwb_rd_addr == 5'd14) begin  // x14 = a4 (itemSize)
+                 cycle_count, DUT.g_hart[0].core.memwb_rd_addr, DUT.g_hart[0].core.wb_data, DUT.g_hart[0].core.memwb_wb_sel,
+                 DUT.g_hart[0].core.memwb_mem_read_data);
+        if (DUT.g_hart[0].core.memwb_rd_addr == 5'd14) begin  // x14 = a4 (itemSize)
           $display("[WB-TRACE] *** This is the load of itemSize into a4! ***");
         end
       end
@@ -1068,12 +1068,12 @@ module tb_freertos;
 
   always @(posedge clk) begin
     if (reset_n) begin
-      if (DUT.core.regfile.registers[2] != prev_sp_trace) begin
+      if (DUT.g_hart[0].core.regfile.registers[2] != prev_sp_trace) begin
         $display("[SP-TRACE] Cycle %0d: SP changed from 0x%08h to 0x%08h (delta: %0d), PC = 0x%08h",
-                 cycle_count, prev_sp_trace, DUT.core.regfile.registers[2],
-                 $signed(DUT.core.regfile.registers[2] - prev_sp_trace), pc);
+                 cycle_count, prev_sp_trace, DUT.g_hart[0].core.regfile.registers[2],
+                 $signed(DUT.g_hart[0].core.regfile.registers[2] - prev_sp_trace), pc);
       end
-      prev_sp_trace = DUT.core.regfile.registers[2];
+      prev_sp_trace = DUT.g_hart[0].core.regfile.registers[2];
     end
   end
   `endif
@@ -1085,11 +1085,11 @@ module tb_freertos;
 
   always @(posedge clk) begin
     if (reset_n) begin
-      if (DUT.core.regfile.registers[1] != prev_ra_trace) begin
+      if (DUT.g_hart[0].core.regfile.registers[1] != prev_ra_trace) begin
         $display("[RA-TRACE] Cycle %0d: RA changed from 0x%08h to 0x%08h, PC = 0x%08h",
-                 cycle_count, prev_ra_trace, DUT.core.regfile.registers[1], pc);
+                 cycle_count, prev_ra_trace, DUT.g_hart[0].core.regfile.registers[1], pc);
       end
-      prev_ra_trace = DUT.core.regfile.registers[1];
+      prev_ra_trace = DUT.g_hart[0].core.regfile.registers[1];
     end
   end
   `endif
@@ -1102,44 +1102,44 @@ module tb_freertos;
       if (pc == 32'h000022d4) begin
         $display("========================================");
         $display("[FUNC-CALL] main() ENTERED at cycle %0d", cycle_count);
-        $display("[FUNC-CALL]   SP = 0x%08h", DUT.core.regfile.registers[2]);
+        $display("[FUNC-CALL]   SP = 0x%08h", DUT.g_hart[0].core.regfile.registers[2]);
         $display("========================================");
       end
 
       // uart_init() at 0x2434
       if (pc == 32'h00002434) begin
         $display("[FUNC-CALL] uart_init() at cycle %0d, RA = 0x%08h",
-                 cycle_count, DUT.core.regfile.registers[1]);
+                 cycle_count, DUT.g_hart[0].core.regfile.registers[1]);
       end
 
       // puts() at 0x2462
       if (pc == 32'h00002462) begin
         $display("[FUNC-CALL] puts() at cycle %0d, arg a0 = 0x%08h, RA = 0x%08h",
-                 cycle_count, DUT.core.regfile.registers[10], DUT.core.regfile.registers[1]);
+                 cycle_count, DUT.g_hart[0].core.regfile.registers[10], DUT.g_hart[0].core.regfile.registers[1]);
       end
 
       // printf() at 0x26ea
       if (pc == 32'h000026ea) begin
         $display("[FUNC-CALL] printf() at cycle %0d, RA = 0x%08h",
-                 cycle_count, DUT.core.regfile.registers[1]);
+                 cycle_count, DUT.g_hart[0].core.regfile.registers[1]);
       end
 
       // xTaskCreate() at 0xf88
       if (pc == 32'h00000f88) begin
         $display("[FUNC-CALL] xTaskCreate() at cycle %0d, RA = 0x%08h",
-                 cycle_count, DUT.core.regfile.registers[1]);
+                 cycle_count, DUT.g_hart[0].core.regfile.registers[1]);
       end
 
       // Detect JALR with invalid target (crash indicator)
-      if (DUT.core.memwb_valid && instruction[6:0] == 7'b1100111) begin  // JALR
+      if (DUT.g_hart[0].core.memwb_valid && instruction[6:0] == 7'b1100111) begin  // JALR
         if (pc > 32'h00010000 || (pc >= 32'h00004000 && pc < 32'h80000000)) begin
           $display("========================================");
           $display("ERROR: JALR to INVALID ADDRESS!");
           $display("  Cycle: %0d", cycle_count);
           $display("  PC: 0x%08h (likely garbage)", pc);
           $display("  Instruction: 0x%08h", instruction);
-          $display("  RA (x1): 0x%08h", DUT.core.regfile.registers[1]);
-          $display("  SP (x2): 0x%08h", DUT.core.regfile.registers[2]);
+          $display("  RA (x1): 0x%08h", DUT.g_hart[0].core.regfile.registers[1]);
+          $display("  SP (x2): 0x%08h", DUT.g_hart[0].core.regfile.registers[2]);
           $display("========================================");
         end
       end
@@ -1163,8 +1163,8 @@ module tb_freertos;
           $display("========================================");
           $display("WARNING: PC STUCK AT 0x%08h for 100 cycles", pc);
           $display("  Instruction: 0x%08h", instruction);
-          $display("  SP: 0x%08h", DUT.core.regfile.registers[2]);
-          $display("  RA: 0x%08h", DUT.core.regfile.registers[1]);
+          $display("  SP: 0x%08h", DUT.g_hart[0].core.regfile.registers[2]);
+          $display("  RA: 0x%08h", DUT.g_hart[0].core.regfile.registers[1]);
           $display("========================================");
         end
       end else begin
@@ -1177,22 +1177,22 @@ module tb_freertos;
       // Main/ISR stack: 0x800C1850-0x800C2850
       // Task stacks are in heap region (0x80000980-0x80040980)
       // Only flag if SP is completely out of valid ranges
-      if (DUT.core.regfile.registers[2] < 32'h80000000 ||
-          DUT.core.regfile.registers[2] > 32'h80100000) begin
+      if (DUT.g_hart[0].core.regfile.registers[2] < 32'h80000000 ||
+          DUT.g_hart[0].core.regfile.registers[2] > 32'h80100000) begin
         $display("========================================");
         $display("ERROR: STACK POINTER OUT OF DMEM!");
         $display("  Cycle: %0d", cycle_count);
-        $display("  SP: 0x%08h (outside DMEM 0x80000000-0x80100000)", DUT.core.regfile.registers[2]);
+        $display("  SP: 0x%08h (outside DMEM 0x80000000-0x80100000)", DUT.g_hart[0].core.regfile.registers[2]);
         $display("  PC: 0x%08h", pc);
         $display("========================================");
       end
 
       // Detect stack over-growth (SP above stack top 0x800C2850)
-      if (DUT.core.regfile.registers[2] > 32'h800C2850) begin
+      if (DUT.g_hart[0].core.regfile.registers[2] > 32'h800C2850) begin
         $display("========================================");
         $display("WARNING: SP ABOVE INITIAL STACK TOP");
         $display("  Cycle: %0d", cycle_count);
-        $display("  SP: 0x%08h (above initial top 0x800C2850)", DUT.core.regfile.registers[2]);
+        $display("  SP: 0x%08h (above initial top 0x800C2850)", DUT.g_hart[0].core.regfile.registers[2]);
         $display("  PC: 0x%08h", pc);
         $display("========================================");
       end
@@ -1210,59 +1210,59 @@ module tb_freertos;
   always @(posedge clk) begin
     if (reset_n) begin
       // Track MULHU in ID stage
-      if (DUT.core.ifid_valid && DUT.core.id_is_mul_div_dec &&
-          DUT.core.id_mul_div_op_dec == 4'b0011) begin  // MULHU opcode
+      if (DUT.g_hart[0].core.ifid_valid && DUT.g_hart[0].core.id_is_mul_div_dec &&
+          DUT.g_hart[0].core.id_mul_div_op_dec == 4'b0011) begin  // MULHU opcode
         $display("========================================");
         $display("[MULHU-ID] Cycle %0d: MULHU detected in ID stage", cycle_count);
-        $display("[MULHU-ID]   PC: 0x%08h", DUT.core.ifid_pc);
+        $display("[MULHU-ID]   PC: 0x%08h", DUT.g_hart[0].core.ifid_pc);
         $display("[MULHU-ID]   rs1 = x%0d, rs2 = x%0d, rd = x%0d",
-                 DUT.core.id_rs1, DUT.core.id_rs2, DUT.core.id_rd);
+                 DUT.g_hart[0].core.id_rs1, DUT.g_hart[0].core.id_rs2, DUT.g_hart[0].core.id_rd);
         $display("[MULHU-ID]   RegFile rs1 (x%0d) = 0x%08h",
-                 DUT.core.id_rs1, DUT.core.regfile.registers[DUT.core.id_rs1]);
+                 DUT.g_hart[0].core.id_rs1, DUT.g_hart[0].core.regfile.registers[DUT.g_hart[0].core.id_rs1]);
         $display("[MULHU-ID]   RegFile rs2 (x%0d) = 0x%08h",
-                 DUT.core.id_rs2, DUT.core.regfile.registers[DUT.core.id_rs2]);
-        $display("[MULHU-ID]   Load-use hazard = %b", DUT.core.hazard_unit.load_use_hazard);
-        $display("[MULHU-ID]   M extension stall = %b", DUT.core.hazard_unit.m_extension_stall);
-        $display("[MULHU-ID]   Stall PC = %b", DUT.core.stall_pc);
+                 DUT.g_hart[0].core.id_rs2, DUT.g_hart[0].core.regfile.registers[DUT.g_hart[0].core.id_rs2]);
+        $display("[MULHU-ID]   Load-use hazard = %b", DUT.g_hart[0].core.hazard_unit.load_use_hazard);
+        $display("[MULHU-ID]   M extension stall = %b", DUT.g_hart[0].core.hazard_unit.m_extension_stall);
+        $display("[MULHU-ID]   Stall PC = %b", DUT.g_hart[0].core.stall_pc);
       end
 
       // Track MULHU in EX stage
-      if (DUT.core.idex_valid && DUT.core.idex_is_mul_div &&
-          DUT.core.idex_mul_div_op == 4'b0011) begin  // MULHU opcode
+      if (DUT.g_hart[0].core.idex_valid && DUT.g_hart[0].core.idex_is_mul_div &&
+          DUT.g_hart[0].core.idex_mul_div_op == 4'b0011) begin  // MULHU opcode
         $display("========================================");
         $display("[MULHU-EX] Cycle %0d: MULHU in EX stage", cycle_count);
-        $display("[MULHU-EX]   PC: 0x%08h", DUT.core.idex_pc);
+        $display("[MULHU-EX]   PC: 0x%08h", DUT.g_hart[0].core.idex_pc);
         $display("[MULHU-EX]   rs1 = x%0d, rs2 = x%0d, rd = x%0d",
-                 DUT.core.idex_rs1_addr, DUT.core.idex_rs2_addr, DUT.core.idex_rd_addr);
-        $display("[MULHU-EX]   IDEX rs1_data = 0x%08h", DUT.core.idex_rs1_data);
-        $display("[MULHU-EX]   IDEX rs2_data = 0x%08h", DUT.core.idex_rs2_data);
+                 DUT.g_hart[0].core.idex_rs1_addr, DUT.g_hart[0].core.idex_rs2_addr, DUT.g_hart[0].core.idex_rd_addr);
+        $display("[MULHU-EX]   IDEX rs1_data = 0x%08h", DUT.g_hart[0].core.idex_rs1_data);
+        $display("[MULHU-EX]   IDEX rs2_data = 0x%08h", DUT.g_hart[0].core.idex_rs2_data);
         $display("[MULHU-EX]   Forward_a = %b, Forward_b = %b",
-                 DUT.core.forward_a, DUT.core.forward_b);
-        $display("[MULHU-EX]   EXMEM forward_data = 0x%08h", DUT.core.exmem_forward_data);
-        $display("[MULHU-EX]   EXMEM alu_result = 0x%08h", DUT.core.exmem_alu_result);
-        $display("[MULHU-EX]   MEM read_data = 0x%08h", DUT.core.mem_read_data);
-        $display("[MULHU-EX]   EXMEM wb_sel = %b", DUT.core.exmem_wb_sel);
-        $display("[MULHU-EX]   WB data = 0x%08h", DUT.core.wb_data);
-        $display("[MULHU-EX]   Forwarded operand_a = 0x%08h", DUT.core.ex_alu_operand_a_forwarded);
-        $display("[MULHU-EX]   Forwarded operand_b (rs2) = 0x%08h", DUT.core.ex_rs2_data_forwarded);
-        $display("[MULHU-EX]   M operands valid = %b", DUT.core.m_operands_valid);
-        $display("[MULHU-EX]   M operand_a_latched = 0x%08h", DUT.core.m_operand_a_latched);
-        $display("[MULHU-EX]   M operand_b_latched = 0x%08h", DUT.core.m_operand_b_latched);
-        $display("[MULHU-EX]   M final operand_a = 0x%08h", DUT.core.m_final_operand_a);
-        $display("[MULHU-EX]   M final operand_b = 0x%08h", DUT.core.m_final_operand_b);
-        $display("[MULHU-EX]   M unit busy = %b", DUT.core.ex_mul_div_busy);
-        $display("[MULHU-EX]   M unit start = %b", DUT.core.m_unit_start);
+                 DUT.g_hart[0].core.forward_a, DUT.g_hart[0].core.forward_b);
+        $display("[MULHU-EX]   EXMEM forward_data = 0x%08h", DUT.g_hart[0].core.exmem_forward_data);
+        $display("[MULHU-EX]   EXMEM alu_result = 0x%08h", DUT.g_hart[0].core.exmem_alu_result);
+        $display("[MULHU-EX]   MEM read_data = 0x%08h", DUT.g_hart[0].core.mem_read_data);
+        $display("[MULHU-EX]   EXMEM wb_sel = %b", DUT.g_hart[0].core.exmem_wb_sel);
+        $display("[MULHU-EX]   WB data = 0x%08h", DUT.g_hart[0].core.wb_data);
+        $display("[MULHU-EX]   Forwarded operand_a = 0x%08h", DUT.g_hart[0].core.ex_alu_operand_a_forwarded);
+        $display("[MULHU-EX]   Forwarded operand_b (rs2) = 0x%08h", DUT.g_hart[0].core.ex_rs2_data_forwarded);
+        $display("[MULHU-EX]   M operands valid = %b", DUT.g_hart[0].core.m_operands_valid);
+        $display("[MULHU-EX]   M operand_a_latched = 0x%08h", DUT.g_hart[0].core.m_operand_a_latched);
+        $display("[MULHU-EX]   M operand_b_latched = 0x%08h", DUT.g_hart[0].core.m_operand_b_latched);
+        $display("[MULHU-EX]   M final operand_a = 0x%08h", DUT.g_hart[0].core.m_final_operand_a);
+        $display("[MULHU-EX]   M final operand_b = 0x%08h", DUT.g_hart[0].core.m_final_operand_b);
+        $display("[MULHU-EX]   M unit busy = %b", DUT.g_hart[0].core.ex_mul_div_busy);
+        $display("[MULHU-EX]   M unit start = %b", DUT.g_hart[0].core.m_unit_start);
       end
 
       // Track MULHU result ready
-      if (DUT.core.idex_valid && DUT.core.idex_is_mul_div &&
-          DUT.core.idex_mul_div_op == 4'b0011 && DUT.core.ex_mul_div_ready) begin
+      if (DUT.g_hart[0].core.idex_valid && DUT.g_hart[0].core.idex_is_mul_div &&
+          DUT.g_hart[0].core.idex_mul_div_op == 4'b0011 && DUT.g_hart[0].core.ex_mul_div_ready) begin
         $display("========================================");
         $display("[MULHU-DONE] Cycle %0d: MULHU completed", cycle_count);
-        $display("[MULHU-DONE]   PC: 0x%08h", DUT.core.idex_pc);
-        $display("[MULHU-DONE]   Result = 0x%08h", DUT.core.ex_mul_div_result);
+        $display("[MULHU-DONE]   PC: 0x%08h", DUT.g_hart[0].core.idex_pc);
+        $display("[MULHU-DONE]   Result = 0x%08h", DUT.g_hart[0].core.ex_mul_div_result);
         $display("[MULHU-DONE]   Expected high word of %0d * %0d",
-                 DUT.core.m_operand_a_latched, DUT.core.m_operand_b_latched);
+                 DUT.g_hart[0].core.m_operand_a_latched, DUT.g_hart[0].core.m_operand_b_latched);
         $display("========================================");
       end
     end
@@ -112,27 +112,27 @@ module tb_freertos_debug;
   initial prev_pc = 32'hFFFFFFFF;
 
   // Access core CSRs for debugging
-  wire [31:0] mstatus_val = DUT.core.csr_file_inst.mstatus_r;
-  wire [31:0] mtvec_val = DUT.core.csr_file_inst.mtvec_r;
-  wire [31:0] mcause_val = DUT.core.csr_file_inst.mcause_r;
-  wire [31:0] mepc_val = DUT.core.csr_file_inst.mepc_r;
-  wire trap_taken = DUT.core.csr_file_inst.trap_entry;
-  wire illegal_csr = DUT.core.csr_file_inst.illegal_csr;
-  wire [11:0] csr_addr_val = DUT.core.csr_file_inst.csr_addr;
-  wire [4:0] trap_cause = DUT.core.csr_file_inst.trap_cause;
-  wire exception_gated = DUT.core.exception_gated;
-  wire sync_exception = DUT.core.sync_exception;
-  wire interrupt_pending = DUT.core.interrupt_pending;
-  wire [4:0] sync_exception_code = DUT.core.sync_exception_code;
-  wire [4:0] interrupt_cause = DUT.core.interrupt_cause;
+  wire [31:0] mstatus_val = DUT.g_hart[0].core.csr_file_inst.mstatus_r;
+  wire [31:0] mtvec_val = DUT.g_hart[0].core.csr_file_inst.mtvec_r;
+  wire [31:0] mcause_val = DUT.g_hart[0].core.csr_file_inst.mcause_r;
+  wire [31:0] mepc_val = DUT.g_hart[0].core.csr_file_inst.mepc_r;
+  wire trap_taken = DUT.g_hart[0].core.csr_file_inst.trap_entry;
+  wire illegal_csr = DUT.g_hart[0].core.csr_file_inst.illegal_csr;
+  wire [11:0] csr_addr_val = DUT.g_hart[0].core.csr_file_inst.csr_addr;
+  wire [4:0] trap_cause = DUT.g_hart[0].core.csr_file_inst.trap_cause;
+  wire exception_gated = DUT.g_hart[0].core.exception_gated;
+  wire sync_exception = DUT.g_hart[0].core.sync_exception;
+  wire interrupt_pending = DUT.g_hart[0].core.interrupt_pending;
+  wire [4:0] sync_exception_code = DUT.g_hart[0].core.sync_exception_code;
+  wire [4:0] interrupt_cause = DUT.g_hart[0].core.interrupt_cause;
 
   // Exception unit internal signals
-  wire exc_if_misaligned = DUT.core.exception_unit_inst.if_inst_misaligned;
-  wire exc_id_ebreak = DUT.core.exception_unit_inst.id_ebreak_exc;
-  wire exc_id_ecall = DUT.core.exception_unit_inst.id_ecall_exc;
-  wire exc_id_illegal = DUT.core.exception_unit_inst.id_illegal_combined;
-  wire exc_mem_load_mis = DUT.core.exception_unit_inst.mem_load_misaligned;
-  wire exc_mem_store_mis = DUT.core.exception_unit_inst.mem_store_misaligned;
+  wire exc_if_misaligned = DUT.g_hart[0].core.exception_unit_inst.if_inst_misaligned;
+  wire exc_id_ebreak = DUT.g_hart[0].core.exception_unit_inst.id_ebreak_exc;
+  wire exc_id_ecall = DUT.g_hart[0].core.exception_unit_inst.id_ecall_exc;
+  wire exc_id_illegal = DUT.g_hart[0].core.exception_unit_inst.id_illegal_combined;
+  wire exc_mem_load_mis = DUT.g_hart[0].core.exception_unit_inst.mem_load_misaligned;
+  wire exc_mem_store_mis = DUT.g_hart[0].core.exception_unit_inst.mem_store_misaligned;
 
   always @(posedge clk) begin
     if (reset_n) begin
@@ -0,0 +1,248 @@
+// tb_ptw_ownership.v - Page walker bus ownership testbench
+// Runs tests/asm/test_ptw_ownership.hex on the pipelined core and checks,
+// besides the program's own result (x28), that each hit-under-miss case
+// really occurred: D-TLB hits while an I-TLB walk is in flight, a store that
+// reached MEM while the walker owned the bus (its deferred write pulse issued
+// exactly once), a load held behind ptw_bus_conflict, and a stale I-side walk
+// fault dropped after a redirect
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns/1ps
+
+`include "config/rv_config.vh"
+
+module tb_ptw_ownership;
+
+  parameter CLK_PERIOD = 10;
+  parameter TIMEOUT = 20000;
+
+  `ifdef MEM_FILE
+    parameter MEM_INIT_FILE = `MEM_FILE;
+  `else
+    parameter MEM_INIT_FILE = "tests/asm/test_ptw_ownership.hex";
+  `endif
+
+  reg         clk;
+  reg         reset_n;
+  wire [31:0] pc;
+  wire [31:0] instruction;
+
+  wire        bus_req_valid;
+  wire [31:0] bus_req_addr;
+  wire [63:0] bus_req_wdata;
+  wire        bus_req_we;
+  wire [2:0]  bus_req_size;
+  wire        bus_req_amo;
+  wire [4:0]  bus_req_amo_op;
+  wire        bus_req_ready;
+  wire [63:0] bus_req_rdata;
+
+  // Test tracking
+  integer errors;
+  integer tests;
+  integer cycle_count;
+
+  // Walk ownership event counters
+  integer iwalk_dtlb_hits;    // D-TLB hits in EX while an I-TLB walk runs
+  integer deferred_stores;    // Stores that entered MEM while the walker owned the bus
+  integer deferred_errors;    // ... not written exactly once
+  integer loads_held;         // Cycles a load waited in MEM for the walker
+  integer stale_drops;        // I-side walk faults dropped (owner moved on)
+  integer defer_seen;
+  integer defer_writes;
+
+  rv_core_pipelined #(
+    .XLEN(32),
+    .RESET_VECTOR(32'h80000000),
+    .IMEM_SIZE(65536),
+    .DMEM_SIZE(65536),
+    .MEM_FILE(MEM_INIT_FILE)
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .mtip_in(1'b0),
+    .msip_in(1'b0),
+    .meip_in(1'b0),
+    .seip_in(1'b0),
+    .mtime_in(64'h0),
+    .bus_req_valid(bus_req_valid),
+    .bus_req_addr(bus_req_addr),
+    .bus_req_wdata(bus_req_wdata),
+    .bus_req_we(bus_req_we),
+    .bus_req_size(bus_req_size),
+    .bus_req_amo(bus_req_amo),
+    .bus_req_amo_op(bus_req_amo_op),
+    .bus_req_ready(bus_req_ready),
+    .bus_req_rdata(bus_req_rdata),
+    .pc_out(pc),
+    .instr_out(instruction)
+  );
+
+  dmem_bus_adapter #(
+    .XLEN(32),
+    .FLEN(64),
+    .MEM_SIZE(65536),
+    .MEM_FILE(MEM_INIT_FILE)
+  ) dmem_adapter (
+    .clk(clk),
+    .reset_n(reset_n),
+    .req_valid(bus_req_valid),
+    .req_addr(bus_req_addr),
+    .req_wdata(bus_req_wdata),
+    .req_we(bus_req_we),
+    .req_size(bus_req_size),
+    .req_amo(bus_req_amo),
+    .req_amo_op(bus_req_amo_op),
+    .req_ready(bus_req_ready),
+    .req_rdata(bus_req_rdata)
+  );
+
+  initial begin
+    clk = 0;
+    forever #(CLK_PERIOD/2) clk = ~clk;
+  end
+
+  //==========================================================================
+  // Walk ownership monitors
+  //==========================================================================
+
+  always @(posedge clk) begin
+    if (reset_n) begin
+      if (DUT.dual_mmu_inst.ptw_walking && DUT.dual_mmu_inst.ptw_for_itlb &&
+          DUT.dual_mmu_inst.ex_req_valid && DUT.dual_mmu_inst.dtlb_hit)
+        iwalk_dtlb_hits = iwalk_dtlb_hits + 1;
+      if (DUT.ptw_bus_conflict && DUT.dmem_mem_read)
+        loads_held = loads_held + 1;
+      // Walk fault for the I-TLB that is not reported to IF
+      if (DUT.dual_mmu_inst.ptw_page_fault && DUT.dual_mmu_inst.ptw_for_itlb &&
+          !DUT.dual_mmu_inst.if_ptw_fault)
+        stale_drops = stale_drops + 1;
+    end
+  end
+
+  // Deferred store: count the data write pulses of each instruction in MEM;
+  // one that saw store_pulse_deferred must have exactly one
+  always @(posedge clk) begin
+    if (reset_n) begin
+      if (DUT.mem_stage_new_instr) begin
+        if (defer_seen) begin
+          deferred_stores = deferred_stores + 1;
+          if (defer_writes != 1) begin
+            $display("[%0d] Deferred store: %0d write pulses", cycle_count, defer_writes);
+            deferred_errors = deferred_errors + 1;
+          end
+        end
+        defer_seen = 0;
+        defer_writes = 0;
+      end
+      if (DUT.store_pulse_deferred)
+        defer_seen = 1;
+      if (DUT.dbus_req_we && !DUT.ptw_bus_grant)
+        defer_writes = defer_writes + 1;
+    end
+  end
+
+  //==========================================================================
+  // Test sequence
+  //==========================================================================
+
+  initial begin
+    $display("========================================");
+    $display("PTW Bus Ownership Test");
+    $display("========================================");
+    $display("Loading program from: %s", MEM_INIT_FILE);
+    $display("");
+
+    $dumpfile("sim/waves/ptw_ownership.vcd");
+    $dumpvars(0, tb_ptw_ownership);
+
+    errors = 0;
+    tests = 0;
+    cycle_count = 0;
+    iwalk_dtlb_hits = 0;
+    deferred_stores = 0;
+    deferred_errors = 0;
+    loads_held = 0;
+    stale_drops = 0;
+    defer_seen = 0;
+    defer_writes = 0;
+
+    reset_n = 0;
+    repeat(5) @(posedge clk);
+    reset_n = 1;
+
+    // x28 = 0xDEADBEEF (pass) or 0xDEADDEAD (fail), then the program parks
+    while (cycle_count < TIMEOUT && DUT.regfile.registers[28][31:16] != 16'hDEAD) begin
+      @(posedge clk);
+      cycle_count = cycle_count + 1;
+    end
+
+    if (cycle_count >= TIMEOUT)
+      $display("WARNING: Timeout reached (%0d cycles)", TIMEOUT);
+    $display("Done at cycle %0d, gp (test) = %0d", cycle_count, DUT.regfile.registers[3]);
+    $display("");
+
+    check("program result (x28)", DUT.regfile.registers[28], 32'hDEADBEEF);
+    check_true("D-TLB hits during an I-TLB walk", iwalk_dtlb_hits > 0);
+    check_true("store deferred behind the walker", deferred_stores > 0);
+    check_true("deferred store written exactly once", deferred_errors == 0);
+    check_true("load held behind ptw_bus_conflict", loads_held > 0);
+    check_true("stale walk fault dropped after redirect", stale_drops > 0);
+
+    $display("");
+    $display("=== Walk Ownership Statistics ===");
+    $display("Cycles:                  %0d", cycle_count);
+    $display("D-TLB hits under I-walk: %0d", iwalk_dtlb_hits);
+    $display("Deferred stores:         %0d", deferred_stores);
+    $display("Load hold cycles:        %0d", loads_held);
+    $display("Stale faults dropped:    %0d", stale_drops);
+
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed:      %0d", tests - errors);
+    $display("Failed:      %0d", errors);
+    $display("");
+
+    if (errors == 0) begin
+      $display("All tests PASSED!");
+    end else begin
+      $display("Some tests FAILED!");
+    end
+
+    $finish;
+  end
+
+  task check;
+    input [255:0] name;
+    input [31:0] actual;
+    input [31:0] expected;
+    begin
+      tests = tests + 1;
+      if (actual !== expected) begin
+        $display("FAIL: %0s: expected %h, got %h", name, expected, actual);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %0s", name);
+      end
+    end
+  endtask
+
+  task check_true;
+    input [255:0] name;
+    input cond;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %0s", name);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %0s", name);
+      end
+    end
+  endtask
+
+endmodule
@@ -107,13 +107,13 @@ module tb_soc;
     if (reset_n && instruction == 32'h00100073) begin
       // EBREAK detected - check test result marker in x28
       #1; // Allow register file to settle
-      case (DUT.core.regfile.registers[28])
+      case (DUT.g_hart[0].core.regfile.registers[28])
         32'hC0DEDBAD: begin
           $display("");
           $display("========================================");
           $display("TEST PASSED");
           $display("========================================");
-          $display("  Success marker (x28): 0x%08h", DUT.core.regfile.registers[28]);
+          $display("  Success marker (x28): 0x%08h", DUT.g_hart[0].core.regfile.registers[28]);
           $display("  Cycles: %0d", cycle_count);
           $display("========================================");
           $finish;
@@ -124,8 +124,8 @@ module tb_soc;
           $display("========================================");
           $display("TEST FAILED");
           $display("========================================");
-          $display("  Failure marker (x28): 0x%08h", DUT.core.regfile.registers[28]);
-          $display("  Test stage (x29): %0d", DUT.core.regfile.registers[29]);
+          $display("  Failure marker (x28): 0x%08h", DUT.g_hart[0].core.regfile.registers[28]);
+          $display("  Test stage (x29): %0d", DUT.g_hart[0].core.regfile.registers[29]);
           $display("  Cycles: %0d", cycle_count);
           $display("========================================");
           $finish;
@@ -135,7 +135,7 @@ module tb_soc;
           $display("========================================");
           $display("TEST PASSED (EBREAK with no marker)");
           $display("========================================");
-          $display("  Note: x28 = 0x%08h (no standard marker)", DUT.core.regfile.registers[28]);
+          $display("  Note: x28 = 0x%08h (no standard marker)", DUT.g_hart[0].core.regfile.registers[28]);
           $display("  Cycles: %0d", cycle_count);
           $display("========================================");
           $finish;
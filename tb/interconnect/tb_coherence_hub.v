@@ -0,0 +1,548 @@
+// tb_coherence_hub.v - Testbench for MESI Coherence between two D-Caches
+// Two COHERENT dcache instances behind bus_master_arbiter, kept coherent by
+// coherence_hub, with dmem_bus_adapter as memory: checks E/S installs,
+// invalidation on a store to a shared line, write-back of an M line to a
+// reading or writing cache, and a locked read-modify-write that another
+// cache's store cannot split
+// L2=1 puts a shared non-coherent dcache between the arbiter and memory, as
+// rv_soc does with L2_CACHE_ENABLE (make test-coherence-l2)
+// Author: RV1 Project
+// Date: 2026-10-16
+// Updated: 2026-10-16 - Optional L2; L1 evictions into the L2 while another
+//                       cache's refill goes through the same L2 set
+
+`timescale 1ns/1ps
+
+module tb_coherence_hub;
+
+  parameter XLEN = 32;
+  parameter NC   = 2;
+  parameter L2   = 0;
+
+  localparam ST_I = 2'd0;
+  localparam ST_S = 2'd1;
+  localparam ST_E = 2'd2;
+  localparam ST_M = 2'd3;
+
+  reg clk;
+  reg reset_n;
+
+  // CPU side of each cache
+  reg  [NC-1:0]      req_valid;
+  reg  [NC*XLEN-1:0] req_addr;
+  reg  [NC*64-1:0]   req_wdata;
+  reg  [NC-1:0]      req_we;
+  reg  [NC-1:0]      req_lock;
+  wire [NC-1:0]      req_ready;
+  wire [NC*64-1:0]   req_rdata;
+
+  // Cache memory ports (to the arbiter)
+  wire [NC-1:0]      m_valid;
+  wire [NC*XLEN-1:0] m_addr;
+  wire [NC*64-1:0]   m_wdata;
+  wire [NC-1:0]      m_we;
+  wire [NC*3-1:0]    m_size;
+  wire [NC-1:0]      m_ready;
+  wire [63:0]        m_rdata;
+
+  wire               mem_req_valid;
+  wire [XLEN-1:0]    mem_req_addr;
+  wire [63:0]        mem_req_wdata;
+  wire               mem_req_we;
+  wire [2:0]         mem_req_size;
+  wire               mem_req_ready;
+  wire [63:0]        mem_req_rdata;
+
+  // Backing memory port (behind the L2 when present)
+  wire               bk_req_valid;
+  wire [XLEN-1:0]    bk_req_addr;
+  wire [63:0]        bk_req_wdata;
+  wire               bk_req_we;
+  wire [2:0]         bk_req_size;
+  wire               bk_req_ready;
+  wire [63:0]        bk_req_rdata;
+
+  // Coherence
+  wire [NC-1:0]      acq_valid;
+  wire [NC*XLEN-1:0] acq_addr;
+  wire [NC-1:0]      acq_excl;
+  wire [NC-1:0]      acq_grant;
+  wire               acq_shared;
+  wire [NC-1:0]      snp_valid;
+  wire [XLEN-1:0]    snp_addr;
+  wire               snp_excl;
+  wire [NC-1:0]      snp_ack;
+  wire [NC-1:0]      snp_hit;
+
+  // 256B, 16B lines, 2 ways -> 8 sets (set = addr[6:4]); DMEM window cached
+  genvar gc;
+  generate
+    for (gc = 0; gc < NC; gc = gc + 1) begin : g_cache
+      dcache #(
+        .XLEN(XLEN),
+        .CACHE_SIZE(256),
+        .LINE_SIZE(16),
+        .WAYS(2),
+        .NUM_MSHRS(2),
+        .CACHEABLE_BASE(32'h8000_0000),
+        .CACHEABLE_MASK(32'hFFF0_0000),
+        .COHERENT(1)
+      ) l1 (
+        .clk(clk),
+        .reset_n(reset_n),
+        .req_valid(req_valid[gc]),
+        .req_addr(req_addr[gc*XLEN +: XLEN]),
+        .req_wdata(req_wdata[gc*64 +: 64]),
+        .req_we(req_we[gc]),
+        .req_size(3'b010),
+        .req_ready(req_ready[gc]),
+        .req_rdata(req_rdata[gc*64 +: 64]),
+        .req_lock(req_lock[gc]),
+        .mem_req_valid(m_valid[gc]),
+        .mem_req_addr(m_addr[gc*XLEN +: XLEN]),
+        .mem_req_wdata(m_wdata[gc*64 +: 64]),
+        .mem_req_we(m_we[gc]),
+        .mem_req_size(m_size[gc*3 +: 3]),
+        .mem_req_ready(m_ready[gc]),
+        .mem_req_rdata(m_rdata),
+        .acq_valid(acq_valid[gc]),
+        .acq_addr(acq_addr[gc*XLEN +: XLEN]),
+        .acq_excl(acq_excl[gc]),
+        .acq_grant(acq_grant[gc]),
+        .acq_shared(acq_shared),
+        .snp_valid(snp_valid[gc]),
+        .snp_addr(snp_addr),
+        .snp_excl(snp_excl),
+        .snp_ack(snp_ack[gc]),
+        .snp_hit(snp_hit[gc]),
+        .stat_hits(),
+        .stat_misses(),
+        .stat_writebacks()
+      );
+    end
+  endgenerate
+
+  coherence_hub #(
+    .XLEN(XLEN),
+    .NUM_CACHES(NC)
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .acq_valid(acq_valid),
+    .acq_addr(acq_addr),
+    .acq_excl(acq_excl),
+    .acq_grant(acq_grant),
+    .acq_shared(acq_shared),
+    .snp_valid(snp_valid),
+    .snp_addr(snp_addr),
+    .snp_excl(snp_excl),
+    .snp_ack(snp_ack),
+    .snp_hit(snp_hit)
+  );
+
+  bus_master_arbiter #(
+    .XLEN(XLEN),
+    .NUM_MASTERS(NC)
+  ) arbiter (
+    .clk(clk),
+    .reset_n(reset_n),
+    .m_req_valid(m_valid),
+    .m_req_addr(m_addr),
+    .m_req_wdata(m_wdata),
+    .m_req_we(m_we),
+    .m_req_size(m_size),
+    .m_req_lock({NC{1'b0}}),
+    .m_req_amo({NC{1'b0}}),
+    .m_req_amo_op({(NC*5){1'b0}}),
+    .m_req_ready(m_ready),
+    .m_req_rdata(m_rdata),
+    .bus_req_valid(mem_req_valid),
+    .bus_req_addr(mem_req_addr),
+    .bus_req_wdata(mem_req_wdata),
+    .bus_req_we(mem_req_we),
+    .bus_req_size(mem_req_size),
+    .bus_req_amo(),
+    .bus_req_amo_op(),
+    .bus_req_ready(mem_req_ready),
+    .bus_req_rdata(mem_req_rdata),
+    .snoop_valid(),
+    .snoop_addr(),
+    .snoop_master()
+  );
+
+  // Backing memory: 4KB, DMEM addresses alias by their low 12 bits
+  dmem_bus_adapter #(
+    .XLEN(32),
+    .FLEN(64),
+    .MEM_SIZE(4096)
+  ) backing (
+    .clk(clk),
+    .reset_n(reset_n),
+    .req_valid(bk_req_valid),
+    .req_addr(bk_req_addr),
+    .req_wdata(bk_req_wdata),
+    .req_we(bk_req_we),
+    .req_size(bk_req_size),
+    .req_amo(1'b0),
+    .req_amo_op(5'd0),
+    .req_ready(bk_req_ready),
+    .req_rdata(bk_req_rdata)
+  );
+
+  integer l2_collisions = 0;
+
+  // Shared L2: 128B, 16B lines, 2 ways -> 4 sets (set = addr[5:4]), so the
+  // two L1s (8 sets each) keep meeting in the same L2 sets
+  wire l2_busy;
+
+  generate
+    if (L2) begin : g_mem
+      dcache #(
+        .XLEN(XLEN),
+        .CACHE_SIZE(128),
+        .LINE_SIZE(16),
+        .WAYS(2),
+        .NUM_MSHRS(2),
+        .CACHEABLE_BASE(32'h8000_0000),
+        .CACHEABLE_MASK(32'hFFF0_0000)
+      ) l2 (
+        .clk(clk),
+        .reset_n(reset_n),
+        .req_valid(mem_req_valid),
+        .req_addr(mem_req_addr),
+        .req_wdata(mem_req_wdata),
+        .req_we(mem_req_we),
+        .req_size(mem_req_size),
+        .req_ready(mem_req_ready),
+        .req_rdata(mem_req_rdata),
+        .req_lock(1'b0),
+        .mem_req_valid(bk_req_valid),
+        .mem_req_addr(bk_req_addr),
+        .mem_req_wdata(bk_req_wdata),
+        .mem_req_we(bk_req_we),
+        .mem_req_size(bk_req_size),
+        .mem_req_ready(bk_req_ready),
+        .mem_req_rdata(bk_req_rdata),
+        .acq_valid(),
+        .acq_addr(),
+        .acq_excl(),
+        .acq_grant(1'b0),
+        .acq_shared(1'b0),
+        .snp_valid(1'b0),
+        .snp_addr({XLEN{1'b0}}),
+        .snp_excl(1'b0),
+        .snp_ack(),
+        .snp_hit(),
+        .stat_hits(),
+        .stat_misses(),
+        .stat_writebacks()
+      );
+
+      assign l2_busy = l2.eng_state != 0 || l2.mshr_valid[0] || l2.mshr_valid[1];
+
+      // Write-back beats that reach the L2 line being picked as a victim
+      always @(posedge clk)
+        if (l2.eng_start && l2.cur_valid && l2.cur_cached && l2.cur_we &&
+            l2.present_a && l2.cur_set == l2.svc_set && l2.present_a_way == l2.victim_way)
+          l2_collisions = l2_collisions + 1;
+
+      // Word as seen through the L2 (a resident line may be newer than memory)
+      function [31:0] word;
+        input [31:0] addr;
+        integer w, idx;
+        reg [127:0] line;
+        begin
+          word = {backing.dmem.mem[(addr + 3) & 12'hFFF], backing.dmem.mem[(addr + 2) & 12'hFFF],
+                  backing.dmem.mem[(addr + 1) & 12'hFFF], backing.dmem.mem[addr & 12'hFFF]};
+          for (w = 0; w < 2; w = w + 1) begin
+            idx = addr[5:4] * 2 + w;
+            if (l2.line_valid[idx] && l2.line_tag[idx] == {20'h80000, addr[11:6]}) begin
+              line = l2.line_data[idx] >> {addr[3:0], 3'b000};
+              word = line[31:0];
+            end
+          end
+        end
+      endfunction
+    end else begin : g_mem
+      assign bk_req_valid  = mem_req_valid;
+      assign bk_req_addr   = mem_req_addr;
+      assign bk_req_wdata  = mem_req_wdata;
+      assign bk_req_we     = mem_req_we;
+      assign bk_req_size   = mem_req_size;
+      assign mem_req_ready = bk_req_ready;
+      assign mem_req_rdata = bk_req_rdata;
+      assign l2_busy       = 1'b0;
+
+      function [31:0] word;
+        input [31:0] addr;
+        begin
+          word = {backing.dmem.mem[(addr + 3) & 12'hFFF], backing.dmem.mem[(addr + 2) & 12'hFFF],
+                  backing.dmem.mem[(addr + 1) & 12'hFFF], backing.dmem.mem[addr & 12'hFFF]};
+        end
+      endfunction
+    end
+  endgenerate
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  integer errors = 0;
+  integer tests = 0;
+  integer cycle = 0;
+  integer i;
+  reg [31:0] rdata [0:NC-1];
+  reg [31:0] orig;
+  reg        amo_read_done;
+  integer    d;
+  reg [31:0] base;
+  reg        l2_ok;
+
+  always @(posedge clk)
+    cycle = cycle + 1;
+
+  // Word currently held by memory (the L2 when it has the line)
+  function [31:0] mem_word;
+    input [31:0] addr;
+    begin
+      mem_word = g_mem.word(addr);
+    end
+  endfunction
+
+  // MESI state of a line in cache c
+  function [1:0] mesi;
+    input integer c;
+    input [31:0]  addr;
+    integer w, idx;
+    begin
+      mesi = ST_I;
+      for (w = 0; w < 2; w = w + 1) begin
+        idx = addr[6:4] * 2 + w;
+        if (c == 0) begin
+          if (g_cache[0].l1.line_valid[idx] && g_cache[0].l1.line_tag[idx] == addr[31:7])
+            mesi = g_cache[0].l1.line_dirty[idx]  ? ST_M :
+                   g_cache[0].l1.line_shared[idx] ? ST_S : ST_E;
+        end else begin
+          if (g_cache[1].l1.line_valid[idx] && g_cache[1].l1.line_tag[idx] == addr[31:7])
+            mesi = g_cache[1].l1.line_dirty[idx]  ? ST_M :
+                   g_cache[1].l1.line_shared[idx] ? ST_S : ST_E;
+        end
+      end
+    end
+  endfunction
+
+  // Issue one word access from cache c the way the core does (store enable
+  // only on the first cycle, valid held until ready); lock stays as given
+  // (automatic: both caches are driven concurrently)
+  task automatic access;
+    input integer c;
+    input         we;
+    input [31:0]  addr;
+    input [31:0]  wdata;
+    input         lock;
+    integer n;
+    begin
+      @(negedge clk);
+      req_valid[c]              = 1'b1;
+      req_we[c]                 = we;
+      req_addr[c*XLEN +: XLEN]  = addr;
+      req_wdata[c*64 +: 64]     = {32'h0, wdata};
+      req_lock[c]               = lock;
+      n = 0;
+      #1;
+      while (!req_ready[c] && n < 500) begin
+        @(negedge clk);
+        req_we[c] = 1'b0;
+        #1;
+        n = n + 1;
+      end
+      rdata[c]      = req_rdata[c*64 +: 32];
+      @(negedge clk);
+      req_valid[c] = 1'b0;
+      req_we[c]    = 1'b0;
+    end
+  endtask
+
+  // Let both miss engines and the hub go idle
+  task drain;
+    begin
+      @(negedge clk);
+      while (g_cache[0].l1.eng_state != 0 || g_cache[0].l1.mshr_valid[0] || g_cache[0].l1.mshr_valid[1] ||
+             g_cache[1].l1.eng_state != 0 || g_cache[1].l1.mshr_valid[0] || g_cache[1].l1.mshr_valid[1] ||
+             DUT.state != 0 || l2_busy)
+        @(negedge clk);
+    end
+  endtask
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %s", name);
+      end
+    end
+  endtask
+
+  initial begin
+    $display("========================================");
+    $display("Coherence Hub Testbench%s", L2 ? " (shared L2)" : "");
+    $display("========================================");
+
+    req_valid = 0;
+    req_we    = 0;
+    req_addr  = 0;
+    req_wdata = 0;
+    req_lock  = 0;
+    reset_n   = 0;
+
+    // Fill backing memory after data_memory clears it at time 0
+    #1;
+    for (i = 0; i < 4096; i = i + 1)
+      backing.dmem.mem[i] = i[7:0] ^ 8'h5A;
+
+    #20;
+    reset_n = 1;
+    repeat (2) @(posedge clk);
+
+    //------------------------------------------------------------------------
+    // Test 1: read sharing
+    //------------------------------------------------------------------------
+    $display("\n--- Test 1: Exclusive and shared reads ---");
+    access(0, 1'b0, 32'h8000_0100, 0, 1'b0);
+    check(rdata[0] == mem_word(32'h100), "Cache 0 load returns memory word");
+    check(mesi(0, 32'h8000_0100) == ST_E, "Only copy is installed Exclusive");
+    access(1, 1'b0, 32'h8000_0104, 0, 1'b0);
+    check(rdata[1] == mem_word(32'h104), "Cache 1 load returns memory word");
+    check(mesi(0, 32'h8000_0100) == ST_S && mesi(1, 32'h8000_0100) == ST_S,
+          "Second reader: both copies Shared");
+
+    //------------------------------------------------------------------------
+    // Test 2: store to a shared line
+    //------------------------------------------------------------------------
+    $display("\n--- Test 2: Store invalidates other copies ---");
+    access(1, 1'b1, 32'h8000_0100, 32'hCAFE_0001, 1'b0);
+    drain;
+    check(mesi(1, 32'h8000_0100) == ST_M, "Writer holds the line Modified");
+    check(mesi(0, 32'h8000_0100) == ST_I, "Other copy invalidated");
+
+    //------------------------------------------------------------------------
+    // Test 3: read of a modified line
+    //------------------------------------------------------------------------
+    $display("\n--- Test 3: M line supplied through write-back ---");
+    access(0, 1'b0, 32'h8000_0100, 0, 1'b0);
+    check(rdata[0] == 32'hCAFE_0001, "Reader sees the other cache's store");
+    check(mem_word(32'h100) == 32'hCAFE_0001, "Modified line written back to memory");
+    check(mesi(0, 32'h8000_0100) == ST_S && mesi(1, 32'h8000_0100) == ST_S,
+          "Both copies Shared after the write-back");
+
+    //------------------------------------------------------------------------
+    // Test 4: two writers of one line
+    //------------------------------------------------------------------------
+    $display("\n--- Test 4: Write after write, different words ---");
+    access(0, 1'b1, 32'h8000_0200, 32'h1111_0000, 1'b0);
+    drain;
+    access(1, 1'b1, 32'h8000_0204, 32'h2222_0004, 1'b0);
+    drain;
+    check(mesi(0, 32'h8000_0200) == ST_I && mesi(1, 32'h8000_0200) == ST_M,
+          "Line moved to the second writer");
+    access(1, 1'b0, 32'h8000_0200, 0, 1'b0);
+    check(rdata[1] == 32'h1111_0000, "First writer's word kept");
+    access(0, 1'b0, 32'h8000_0204, 0, 1'b0);
+    check(rdata[0] == 32'h2222_0004, "Second writer's word visible to the first");
+
+    //------------------------------------------------------------------------
+    // Test 5: locked read-modify-write against a competing store
+    //------------------------------------------------------------------------
+    $display("\n--- Test 5: Locked read-modify-write ---");
+    orig = mem_word(32'h300);
+    amo_read_done = 0;
+    fork
+      begin
+        access(0, 1'b0, 32'h8000_0300, 0, 1'b1);            // AMO read (locked)
+        amo_read_done = 1;
+        repeat (6) @(negedge clk);                          // competing RdX waits meanwhile
+        access(0, 1'b1, 32'h8000_0300, rdata[0] + 1, 1'b1); // AMO write
+        req_lock[0] = 1'b0;
+      end
+      begin
+        wait (amo_read_done);
+        access(1, 1'b1, 32'h8000_0300, 32'h7777_7777, 1'b0);
+      end
+    join
+    drain;
+    check(rdata[0] == orig, "AMO read the value from memory");
+    check(mesi(0, 32'h8000_0300) == ST_I && mesi(1, 32'h8000_0300) == ST_M,
+          "Line handed over after the atomic sequence");
+    access(1, 1'b0, 32'h8000_0300, 0, 1'b0);
+    check(rdata[1] == 32'h7777_7777, "Competing store ordered after the AMO write");
+    access(0, 1'b0, 32'h8000_0300, 0, 1'b0);
+    check(rdata[0] == 32'h7777_7777 && mesi(1, 32'h8000_0300) == ST_S,
+          "AMO cache re-reads the final value");
+
+    //------------------------------------------------------------------------
+    // Test 6: eviction of an M line while another cache refills the same set
+    //------------------------------------------------------------------------
+    // Cache 0 dirties A, then two loads in A's L1 set (E1, E2) evict it; the
+    // write-back reaches memory (the L2 set A maps to) while cache 1 misses on
+    // C0/C1 of that same set. The start of cache 1's misses is swept over a
+    // few cycles so the write-back beats meet the L2 picking its victim
+    $display("\n--- Test 6: Eviction racing a refill of the same set ---");
+    l2_ok = 1'b1;
+    for (d = 0; d < 8; d = d + 1) begin
+      base = 32'h8000_0400 + d * 32'h100;
+      access(0, 1'b1, base + 32'h14, 32'hA000_0000 | d, 1'b0);  // A: L1 set 1, L2 set 1
+      drain;
+      fork
+        begin
+          access(0, 1'b0, 32'h8000_0010, 0, 1'b0);               // E1
+          access(0, 1'b0, 32'h8000_0090, 0, 1'b0);               // E2: evicts A
+        end
+        begin
+          repeat (d) @(negedge clk);
+          access(1, 1'b0, base + 32'h50, 0, 1'b0);               // C0: L1 set 5, L2 set 1
+          if (rdata[1] != mem_word(base + 32'h50)) l2_ok = 1'b0;
+          access(1, 1'b0, base + 32'hD0, 0, 1'b0);               // C1
+          if (rdata[1] != mem_word(base + 32'hD0)) l2_ok = 1'b0;
+        end
+      join
+      drain;
+      if (mesi(0, base + 32'h14) != ST_I) l2_ok = 1'b0;
+      access(1, 1'b0, base + 32'h14, 0, 1'b0);
+      if (rdata[1] != (32'hA000_0000 | d)) begin
+        $display("  delay %0d: A read back 0x%08h", d, rdata[1]);
+        l2_ok = 1'b0;
+      end
+    end
+    check(l2_ok, "Evicted store survives a concurrent refill of its set");
+    if (L2)
+      $display("  L2 victim picks under a write-back beat to the victim: %0d", l2_collisions);
+
+    //------------------------------------------------------------------------
+    // Summary
+    //------------------------------------------------------------------------
+    $display("\n========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed:      %0d", tests - errors);
+    $display("Failed:      %0d", errors);
+    if (errors == 0)
+      $display("All tests PASSED!");
+    else
+      $display("Some tests FAILED!");
+    $finish;
+  end
+
+  initial begin
+    #200000;
+    $display("ERROR: Timeout");
+    $finish;
+  end
+
+endmodule
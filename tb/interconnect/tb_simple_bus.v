@@ -83,6 +83,8 @@ module tb_simple_bus;
     .master_req_wdata(master_req_wdata),
     .master_req_we(master_req_we),
     .master_req_size(master_req_size),
+    .master_req_amo(1'b0),
+    .master_req_amo_op(5'h0),
     .master_req_ready(master_req_ready),
     .master_req_rdata(master_req_rdata),
     // CLINT
@@ -106,6 +108,8 @@ module tb_simple_bus;
     .dmem_req_wdata(dmem_req_wdata),
     .dmem_req_we(dmem_req_we),
     .dmem_req_size(dmem_req_size),
+    .dmem_req_amo(),
+    .dmem_req_amo_op(),
     .dmem_req_ready(dmem_req_ready),
     .dmem_req_rdata(dmem_req_rdata),
     // PLIC
@@ -0,0 +1,358 @@
+// tb_split_bus.v - Testbench for Split-Transaction Bus Interconnect
+// Two masters, a pipelined DMEM (dmem_split_adapter) and a slow simple-bus
+// slave behind split_bus_bridge: checks back-to-back pipelined reads, out-of-
+// order responses matched by ID, the outstanding limit, unmapped-address
+// errors and round-robin arbitration between masters
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns / 1ps
+
+module tb_split_bus;
+
+  parameter XLEN   = 32;
+  parameter NM     = 2;
+  parameter NS     = 2;
+  parameter IDW    = 4;
+  parameter SIDW   = IDW + 1;
+
+  localparam DMEM_BASE = 32'h8000_0000;
+  localparam SLOW_BASE = 32'h1000_0000;
+  localparam UNMAPPED  = 32'h4000_0000;
+
+  reg clk;
+  reg reset_n;
+
+  // Master side
+  reg  [NM-1:0]      m_req_valid;
+  wire [NM-1:0]      m_req_ready;
+  reg  [NM*IDW-1:0]  m_req_id;
+  reg  [NM*XLEN-1:0] m_req_addr;
+  reg  [NM*64-1:0]   m_req_wdata;
+  reg  [NM-1:0]      m_req_we;
+  reg  [NM*3-1:0]    m_req_size;
+  wire [NM-1:0]      m_resp_valid;
+  reg  [NM-1:0]      m_resp_ready;
+  wire [NM*IDW-1:0]  m_resp_id;
+  wire [NM*64-1:0]   m_resp_rdata;
+  wire [NM-1:0]      m_resp_err;
+
+  // Slave side
+  wire [NS-1:0]      s_req_valid;
+  wire [NS-1:0]      s_req_ready;
+  wire [NS*SIDW-1:0] s_req_id;
+  wire [NS*XLEN-1:0] s_req_addr;
+  wire [NS*64-1:0]   s_req_wdata;
+  wire [NS-1:0]      s_req_we;
+  wire [NS*3-1:0]    s_req_size;
+  wire [NS-1:0]      s_resp_valid;
+  wire [NS-1:0]      s_resp_ready;
+  wire [NS*SIDW-1:0] s_resp_id;
+  wire [NS*64-1:0]   s_resp_rdata;
+
+  // Slow simple-bus slave (ready after 3 cycles)
+  wire             slow_valid;
+  wire [XLEN-1:0]  slow_addr;
+  wire [63:0]      slow_wdata;
+  wire             slow_we;
+  wire [2:0]       slow_size;
+  reg  [1:0]       slow_wait;
+  wire             slow_ready = slow_valid && (slow_wait == 2'd2);
+  wire [63:0]      slow_rdata = {32'h0, 20'h51000, slow_addr[11:0]};
+
+  always @(posedge clk) begin
+    if (!slow_valid || slow_ready)
+      slow_wait <= 2'd0;
+    else
+      slow_wait <= slow_wait + 1'b1;
+  end
+
+  split_bus #(
+    .XLEN(XLEN),
+    .NUM_MASTERS(NM),
+    .NUM_SLAVES(NS),
+    .ID_WIDTH(IDW),
+    .MAX_OUTSTANDING(2),
+    .SLAVE_BASE({SLOW_BASE, DMEM_BASE}),
+    .SLAVE_MASK({32'hFFFF_F000, 32'hFFF0_0000})
+  ) dut (
+    .clk(clk),
+    .reset_n(reset_n),
+    .m_req_valid(m_req_valid),
+    .m_req_ready(m_req_ready),
+    .m_req_id(m_req_id),
+    .m_req_addr(m_req_addr),
+    .m_req_wdata(m_req_wdata),
+    .m_req_we(m_req_we),
+    .m_req_size(m_req_size),
+    .m_resp_valid(m_resp_valid),
+    .m_resp_ready(m_resp_ready),
+    .m_resp_id(m_resp_id),
+    .m_resp_rdata(m_resp_rdata),
+    .m_resp_err(m_resp_err),
+    .s_req_valid(s_req_valid),
+    .s_req_ready(s_req_ready),
+    .s_req_id(s_req_id),
+    .s_req_addr(s_req_addr),
+    .s_req_wdata(s_req_wdata),
+    .s_req_we(s_req_we),
+    .s_req_size(s_req_size),
+    .s_resp_valid(s_resp_valid),
+    .s_resp_ready(s_resp_ready),
+    .s_resp_id(s_resp_id),
+    .s_resp_rdata(s_resp_rdata)
+  );
+
+  dmem_split_adapter #(
+    .XLEN(XLEN),
+    .FLEN(0),
+    .ID_WIDTH(SIDW),
+    .MEM_SIZE(4096)
+  ) dmem (
+    .clk(clk),
+    .reset_n(reset_n),
+    .req_valid(s_req_valid[0]),
+    .req_ready(s_req_ready[0]),
+    .req_id(s_req_id[0 +: SIDW]),
+    .req_addr(s_req_addr[0 +: XLEN]),
+    .req_wdata(s_req_wdata[0 +: 64]),
+    .req_we(s_req_we[0]),
+    .req_size(s_req_size[0 +: 3]),
+    .resp_valid(s_resp_valid[0]),
+    .resp_ready(s_resp_ready[0]),
+    .resp_id(s_resp_id[0 +: SIDW]),
+    .resp_rdata(s_resp_rdata[0 +: 64])
+  );
+
+  split_bus_bridge #(
+    .XLEN(XLEN),
+    .ID_WIDTH(SIDW)
+  ) bridge (
+    .clk(clk),
+    .reset_n(reset_n),
+    .req_valid(s_req_valid[1]),
+    .req_ready(s_req_ready[1]),
+    .req_id(s_req_id[SIDW +: SIDW]),
+    .req_addr(s_req_addr[XLEN +: XLEN]),
+    .req_wdata(s_req_wdata[64 +: 64]),
+    .req_we(s_req_we[1]),
+    .req_size(s_req_size[3 +: 3]),
+    .resp_valid(s_resp_valid[1]),
+    .resp_ready(s_resp_ready[1]),
+    .resp_id(s_resp_id[SIDW +: SIDW]),
+    .resp_rdata(s_resp_rdata[64 +: 64]),
+    .bus_req_valid(slow_valid),
+    .bus_req_addr(slow_addr),
+    .bus_req_wdata(slow_wdata),
+    .bus_req_we(slow_we),
+    .bus_req_size(slow_size),
+    .bus_req_ready(slow_ready),
+    .bus_req_rdata(slow_rdata)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  //==========================================================================
+  // Handshake Logs
+  //==========================================================================
+  integer errors = 0;
+  integer tests = 0;
+  integer cycle = 0;
+  integer i;
+
+  integer n_acc;                 // Accepted requests (both masters)
+  integer acc_master [0:31];
+  integer acc_cycle  [0:31];
+  integer n_resp     [0:NM-1];   // Responses per master
+  integer resp_id    [0:NM-1][0:31];
+  integer resp_cycle [0:NM-1][0:31];
+  reg [63:0] resp_data [0:NM-1][0:31];
+  reg        resp_err  [0:NM-1][0:31];
+
+  integer lm;
+  always @(posedge clk) begin
+    for (lm = 0; lm < NM; lm = lm + 1) begin
+      if (m_req_valid[lm] && m_req_ready[lm]) begin
+        acc_master[n_acc] = lm;
+        acc_cycle[n_acc]  = cycle;
+        n_acc = n_acc + 1;
+      end
+      if (m_resp_valid[lm] && m_resp_ready[lm]) begin
+        resp_id[lm][n_resp[lm]]    = m_resp_id[lm*IDW +: IDW];
+        resp_cycle[lm][n_resp[lm]] = cycle;
+        resp_data[lm][n_resp[lm]]  = m_resp_rdata[lm*64 +: 64];
+        resp_err[lm][n_resp[lm]]   = m_resp_err[lm];
+        n_resp[lm] = n_resp[lm] + 1;
+      end
+    end
+    cycle = cycle + 1;
+  end
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %s", name);
+      end
+    end
+  endtask
+
+  task clear_logs;
+    begin
+      n_acc     = 0;
+      n_resp[0] = 0;
+      n_resp[1] = 0;
+    end
+  endtask
+
+  // Present one request from master m (at a negedge) and hold it until accepted
+  // (automatic: both masters call it concurrently)
+  task automatic send;
+    input [31:0]     m;
+    input [IDW-1:0]  id;
+    input [31:0]     addr;
+    input            we;
+    input [63:0]     wdata;
+    begin
+      m_req_valid[m]              = 1'b1;
+      m_req_id[m*IDW +: IDW]      = id;
+      m_req_addr[m*XLEN +: XLEN]  = addr;
+      m_req_we[m]                 = we;
+      m_req_wdata[m*64 +: 64]     = wdata;
+      m_req_size[m*3 +: 3]        = 3'b010;
+      #1;
+      while (!m_req_ready[m]) begin
+        @(negedge clk);
+        #1;
+      end
+      @(negedge clk);
+      m_req_valid[m] = 1'b0;
+    end
+  endtask
+
+  task wait_cycles;
+    input integer n;
+    begin
+      repeat (n) @(negedge clk);
+    end
+  endtask
+
+  //==========================================================================
+  // Tests
+  //==========================================================================
+  initial begin
+    $dumpfile("sim/waves/split_bus.vcd");
+    $dumpvars(0, tb_split_bus);
+
+    reset_n      = 0;
+    m_req_valid  = 0;
+    m_req_id     = 0;
+    m_req_addr   = 0;
+    m_req_wdata  = 0;
+    m_req_we     = 0;
+    m_req_size   = 0;
+    m_resp_ready = {NM{1'b1}};
+    slow_wait    = 0;
+    clear_logs;
+    #20;
+    reset_n = 1;
+    @(negedge clk);
+
+    $display("=== Split-Transaction Bus Tests ===");
+
+    // Fill four DMEM words, then read them back-to-back
+    for (i = 0; i < 4; i = i + 1)
+      send(0, i, DMEM_BASE + i * 4, 1'b1, 64'h1111_0000 + i);
+    wait_cycles(2);
+    clear_logs;
+    for (i = 0; i < 4; i = i + 1)
+      send(0, 4 + i, DMEM_BASE + i * 4, 1'b0, 64'h0);
+    wait_cycles(2);
+    check(n_acc == 4 && acc_cycle[3] == acc_cycle[0] + 3,
+          "Four DMEM reads accepted on consecutive cycles");
+    check(n_resp[0] == 4 && resp_cycle[0][3] == acc_cycle[3] + 1,
+          "Each read answered one cycle after it was accepted");
+    check(resp_id[0][0] == 4 && resp_id[0][3] == 7 &&
+          resp_data[0][0] == 64'h1111_0000 && resp_data[0][3] == 64'h1111_0003,
+          "Read data returned with the request IDs");
+
+    // Slow slave first, DMEM second: DMEM answers first
+    clear_logs;
+    send(0, 4'd1, SLOW_BASE + 32'h24, 1'b0, 64'h0);
+    send(0, 4'd2, DMEM_BASE + 32'h8, 1'b0, 64'h0);
+    wait_cycles(6);
+    check(n_resp[0] == 2 && resp_id[0][0] == 2 && resp_data[0][0] == 64'h1111_0002,
+          "Fast slave overtakes the slow one");
+    check(resp_id[0][1] == 1 && resp_data[0][1] == 64'h5100_0024,
+          "Slow slave response matched by ID");
+
+    // Outstanding limit (2): master 1 stops taking responses
+    clear_logs;
+    m_resp_ready[1] = 1'b0;
+    fork
+      begin
+        send(1, 4'd3, DMEM_BASE, 1'b0, 64'h0);
+        send(1, 4'd4, SLOW_BASE, 1'b0, 64'h0);
+        send(1, 4'd5, UNMAPPED, 1'b0, 64'h0);
+      end
+      begin
+        wait_cycles(8);
+        check(n_acc == 2, "Third request waits at the outstanding limit");
+        m_resp_ready[1] = 1'b1;
+      end
+    join
+    wait_cycles(3);
+    check(n_acc == 3 && n_resp[1] == 3, "Limit released when responses are taken");
+    check(resp_id[1][2] == 5 && resp_err[1][2] && resp_data[1][2] == 64'h0,
+          "Unmapped address gets an error response");
+
+    // Both masters stream reads to DMEM: grants alternate
+    clear_logs;
+    fork
+      begin
+        send(0, 4'd0, DMEM_BASE, 1'b0, 64'h0);
+        send(0, 4'd1, DMEM_BASE + 4, 1'b0, 64'h0);
+      end
+      begin
+        send(1, 4'd0, DMEM_BASE + 8, 1'b0, 64'h0);
+        send(1, 4'd1, DMEM_BASE + 12, 1'b0, 64'h0);
+      end
+    join
+    wait_cycles(3);
+    check(n_acc == 4 && acc_master[0] != acc_master[1] && acc_master[2] != acc_master[3],
+          "Round-robin alternates between masters");
+    check(n_resp[0] == 2 && n_resp[1] == 2 &&
+          resp_data[1][0] == 64'h1111_0002 && resp_data[1][1] == 64'h1111_0003,
+          "Each master gets its own responses");
+
+    // Summary
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed: %0d", tests - errors);
+    $display("Failed: %0d", errors);
+
+    if (errors == 0) begin
+      $display("");
+      $display("All tests PASSED!");
+      $display("");
+    end else begin
+      $display("");
+      $display("Some tests FAILED!");
+      $display("");
+    end
+
+    $finish;
+  end
+
+endmodule
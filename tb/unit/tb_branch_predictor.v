@@ -0,0 +1,304 @@
+// tb_branch_predictor.v - Testbench for branch_predictor module
+// Tests BHT training, BTB allocation/tag match, unconditional jumps,
+// stale-entry invalidation, accuracy counters and the return address stack
+// Author: RV1 Project
+// Date: 2026-10-16
+// Updated: 2026-10-16 - Coroutine swap (pop then push)
+
+`timescale 1ns/1ps
+
+module tb_branch_predictor;
+
+  reg         clk;
+  reg         reset_n;
+
+  reg  [31:0] if_pc;
+  wire        pred_taken;
+  wire [31:0] pred_target;
+  wire [31:0] pred_meta;
+  reg         if_advance;
+  reg  [31:0] if_link_addr;
+
+  reg         update_valid;
+  reg  [31:0] update_pc;
+  reg         update_is_branch;
+  reg         update_is_jump;
+  reg         update_is_call;
+  reg         update_is_ret;
+  reg  [31:0] update_link_addr;
+  reg         update_taken;
+  reg  [31:0] update_target;
+  reg  [31:0] update_meta;
+  reg         update_mispredict;
+  reg         flush_restore;
+
+  wire [31:0] stat_branches;
+  wire [31:0] stat_branch_miss;
+  wire [31:0] stat_jumps;
+  wire [31:0] stat_jump_miss;
+
+  integer errors = 0;
+  integer tests = 0;
+
+  // Small bimodal configuration so aliasing is easy to provoke
+  branch_predictor #(
+    .XLEN(32),
+    .ENABLE(1),
+    .BHT_ENTRIES(16),
+    .BTB_ENTRIES(8),
+    .BTB_TAG_BITS(8),
+    .GHR_BITS(0),
+    .RAS_DEPTH(4)
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .if_pc(if_pc),
+    .pred_taken(pred_taken),
+    .pred_target(pred_target),
+    .pred_meta(pred_meta),
+    .if_advance(if_advance),
+    .if_link_addr(if_link_addr),
+    .update_valid(update_valid),
+    .update_pc(update_pc),
+    .update_is_branch(update_is_branch),
+    .update_is_jump(update_is_jump),
+    .update_is_call(update_is_call),
+    .update_is_ret(update_is_ret),
+    .update_link_addr(update_link_addr),
+    .update_taken(update_taken),
+    .update_target(update_target),
+    .update_meta(update_meta),
+    .update_mispredict(update_mispredict),
+    .flush_restore(flush_restore),
+    .stat_branches(stat_branches),
+    .stat_branch_miss(stat_branch_miss),
+    .stat_jumps(stat_jumps),
+    .stat_jump_miss(stat_jump_miss)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  // Resolve one instruction (single-cycle update pulse)
+  task resolve;
+    input [31:0] pc;
+    input        is_branch;
+    input        is_jump;
+    input        taken;
+    input [31:0] target;
+    input        mispredict;
+    begin
+      @(negedge clk);
+      update_valid      = 1;
+      update_pc         = pc;
+      update_is_branch  = is_branch;
+      update_is_jump    = is_jump;
+      update_taken      = taken;
+      update_target     = target;
+      update_meta       = 32'd0;
+      update_mispredict = mispredict;
+      @(negedge clk);
+      update_valid      = 0;
+      update_is_call    = 0;
+      update_is_ret     = 0;
+    end
+  endtask
+
+  // Resolve a call (link = return address) or a return
+  task resolve_call;
+    input [31:0] pc;
+    input [31:0] target;
+    input [31:0] link;
+    input        mispredict;
+    begin
+      update_is_call   = 1;
+      update_link_addr = link;
+      resolve(pc, 0, 1, 1, target, mispredict);
+    end
+  endtask
+
+  task resolve_ret;
+    input [31:0] pc;
+    input [31:0] target;
+    input        mispredict;
+    begin
+      update_is_ret = 1;
+      resolve(pc, 0, 1, 1, target, mispredict);
+    end
+  endtask
+
+  // Coroutine swap (jalr x1, x5): both a return and a call
+  task resolve_swap;
+    input [31:0] pc;
+    input [31:0] target;
+    input [31:0] link;
+    input        mispredict;
+    begin
+      update_is_call   = 1;
+      update_is_ret    = 1;
+      update_link_addr = link;
+      resolve(pc, 0, 1, 1, target, mispredict);
+    end
+  endtask
+
+  // Fetch one instruction with the PC advancing (speculative RAS push/pop)
+  task fetch;
+    input [31:0] pc;
+    input [31:0] link;
+    begin
+      @(negedge clk);
+      if_pc        = pc;
+      if_link_addr = link;
+      if_advance   = 1;
+      @(negedge clk);
+      if_advance   = 0;
+    end
+  endtask
+
+  task check_pred;
+    input [31:0] pc;
+    input        exp_taken;
+    input [31:0] exp_target;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if_pc = pc;
+      #1;
+      if (pred_taken !== exp_taken || (exp_taken && pred_target !== exp_target)) begin
+        $display("FAIL: %s", name);
+        $display("  PC=0x%08h Expected taken=%b target=0x%08h, Got taken=%b target=0x%08h",
+                 pc, exp_taken, exp_target, pred_taken, pred_target);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %s", name);
+      end
+    end
+  endtask
+
+  initial begin
+    $dumpfile("sim/waves/branch_predictor.vcd");
+    $dumpvars(0, tb_branch_predictor);
+
+    reset_n = 0;
+    if_pc = 0;
+    update_valid = 0;
+    update_pc = 0;
+    update_is_branch = 0;
+    update_is_jump = 0;
+    update_taken = 0;
+    update_target = 0;
+    update_meta = 0;
+    update_mispredict = 0;
+    update_is_call = 0;
+    update_is_ret = 0;
+    update_link_addr = 0;
+    if_advance = 0;
+    if_link_addr = 0;
+    flush_restore = 0;
+    #20;
+    reset_n = 1;
+
+    $display("=== Branch Predictor Tests ===");
+
+    check_pred(32'h0000_0100, 0, 32'h0, "Cold BTB predicts not-taken");
+
+    // Taken branch: counter 01 -> 10, BTB allocated
+    resolve(32'h0000_0100, 1, 0, 1, 32'h0000_0080, 1);
+    check_pred(32'h0000_0100, 1, 32'h0000_0080, "Taken branch trains BHT and BTB");
+    check_pred(32'h0000_0102, 0, 32'h0, "Neighbouring halfword is a different entry");
+
+    // Not taken: counter 10 -> 01, BTB entry kept but predicts not-taken
+    resolve(32'h0000_0100, 1, 0, 0, 32'h0000_0080, 1);
+    check_pred(32'h0000_0100, 0, 32'h0, "Not-taken branch weakens counter");
+
+    // Saturation: two taken outcomes -> 11, one not-taken -> 10 still taken
+    resolve(32'h0000_0100, 1, 0, 1, 32'h0000_0080, 1);
+    resolve(32'h0000_0100, 1, 0, 1, 32'h0000_0080, 0);
+    resolve(32'h0000_0100, 1, 0, 0, 32'h0000_0080, 1);
+    check_pred(32'h0000_0100, 1, 32'h0000_0080, "Strongly-taken counter survives one not-taken");
+
+    // Jumps are predicted taken regardless of BHT state
+    resolve(32'h0000_0200, 0, 1, 1, 32'h0000_0300, 1);
+    check_pred(32'h0000_0200, 1, 32'h0000_0300, "JAL predicted taken from BTB");
+
+    // Same BTB index, different tag must miss
+    check_pred(32'h0000_0200 + 32'd16, 0, 32'h0, "Tag mismatch does not hit");
+
+    // JALR target change replaces BTB target
+    resolve(32'h0000_0200, 0, 1, 1, 32'h0000_0400, 1);
+    check_pred(32'h0000_0200, 1, 32'h0000_0400, "JALR target updated");
+
+    // Stale hit on a non-branch instruction invalidates the entry
+    resolve(32'h0000_0200, 0, 0, 0, 32'h0, 1);
+    check_pred(32'h0000_0200, 0, 32'h0, "Stale BTB entry invalidated");
+
+    // Statistics: 5 branches (4 mispredicted), 2 jumps (2 mispredicted)
+    tests = tests + 1;
+    if (stat_branches !== 5 || stat_branch_miss !== 4 ||
+        stat_jumps !== 2 || stat_jump_miss !== 2) begin
+      $display("FAIL: Statistics counters");
+      $display("  branches=%0d miss=%0d jumps=%0d miss=%0d",
+               stat_branches, stat_branch_miss, stat_jumps, stat_jump_miss);
+      errors = errors + 1;
+    end else begin
+      $display("PASS: Statistics counters");
+    end
+
+    // Return address stack
+    // Train: call at 0x400 -> 0x800 (returns to 0x404), return at 0x812
+    resolve_call(32'h0000_0400, 32'h0000_0800, 32'h0000_0404, 1);
+    resolve_ret(32'h0000_0812, 32'h0000_0404, 1);
+
+    // Predicted calls push, predicted returns pop
+    fetch(32'h0000_0400, 32'h0000_0404);
+    check_pred(32'h0000_0812, 1, 32'h0000_0404, "Return predicted from RAS after call fetch");
+    fetch(32'h0000_0400, 32'h0000_0999);
+    check_pred(32'h0000_0812, 1, 32'h0000_0999, "RAS returns innermost call first");
+    fetch(32'h0000_0812, 32'h0000_0816);
+    check_pred(32'h0000_0812, 1, 32'h0000_0404, "RAS pop exposes outer return address");
+
+    // Trap flush: speculative push (0x777) is dropped, committed call survives
+    fetch(32'h0000_0400, 32'h0000_0777);
+    resolve_call(32'h0000_0400, 32'h0000_0800, 32'h0000_0404, 0);
+    @(negedge clk);
+    flush_restore = 1;
+    @(negedge clk);
+    flush_restore = 0;
+    check_pred(32'h0000_0812, 1, 32'h0000_0404, "Trap flush restores committed RAS pointer");
+
+    // Coroutine swap at 0x906: the resolved swap replaces the top (0x404)
+    // with its link, and predicts its target from the top
+    resolve_swap(32'h0000_0906, 32'h0000_0404, 32'h0000_0904, 1);
+    check_pred(32'h0000_0906, 1, 32'h0000_0904, "Coroutine swap predicted from RAS top");
+    // Call pushes 0x404, swap pops it and pushes 0xA04: depth unchanged
+    fetch(32'h0000_0400, 32'h0000_0404);
+    fetch(32'h0000_0906, 32'h0000_0A04);
+    check_pred(32'h0000_0812, 1, 32'h0000_0A04, "Return after swap gets the swap's link");
+    fetch(32'h0000_0812, 32'h0000_0816);
+    check_pred(32'h0000_0812, 1, 32'h0000_0904, "Swap pops then pushes (depth unchanged)");
+
+    // Summary
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed: %0d", tests - errors);
+    $display("Failed: %0d", errors);
+
+    if (errors == 0) begin
+      $display("");
+      $display("All tests PASSED!");
+      $display("");
+    end else begin
+      $display("");
+      $display("Some tests FAILED!");
+      $display("");
+    end
+
+    $finish;
+  end
+
+endmodule
@@ -0,0 +1,330 @@
+// tb_dcache.v - Testbench for dcache module
+// Tests miss/refill through dmem_bus_adapter, zero-wait hits, write-back of
+// dirty victims, non-blocking store misses (MSHR merge), MMIO bypass ordering
+// and line-crossing misaligned accesses
+// Author: RV1 Project
+// Date: 2026-10-16
+// Updated: 2026-10-16 - Store hit to the victim way in the cycle the miss
+//                       engine starts
+
+`timescale 1ns/1ps
+
+module tb_dcache;
+
+  reg         clk;
+  reg         reset_n;
+
+  reg         req_valid;
+  reg  [31:0] req_addr;
+  reg  [63:0] req_wdata;
+  reg         req_we;
+  reg  [2:0]  req_size;
+  wire        req_ready;
+  wire [63:0] req_rdata;
+
+  wire        mem_req_valid;
+  wire [31:0] mem_req_addr;
+  wire [63:0] mem_req_wdata;
+  wire        mem_req_we;
+  wire [2:0]  mem_req_size;
+  wire        mem_req_ready;
+  wire [63:0] mem_req_rdata;
+
+  wire [31:0] stat_hits;
+  wire [31:0] stat_misses;
+  wire [31:0] stat_writebacks;
+
+  integer errors = 0;
+  integer tests = 0;
+  integer cycles;
+  integer misses_before;
+  integer i;
+  reg race_cycle;
+  reg [63:0] rdata;
+
+  // 256B, 16B lines, 2 ways -> 8 sets (set = addr[6:4])
+  // DMEM window 0x8000_0000 is cached, everything else is MMIO
+  dcache #(
+    .XLEN(32),
+    .CACHE_SIZE(256),
+    .LINE_SIZE(16),
+    .WAYS(2),
+    .NUM_MSHRS(2),
+    .CACHEABLE_BASE(32'h8000_0000),
+    .CACHEABLE_MASK(32'hFFF0_0000)
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .req_valid(req_valid),
+    .req_addr(req_addr),
+    .req_wdata(req_wdata),
+    .req_we(req_we),
+    .req_size(req_size),
+    .req_ready(req_ready),
+    .req_rdata(req_rdata),
+    .mem_req_valid(mem_req_valid),
+    .mem_req_addr(mem_req_addr),
+    .mem_req_wdata(mem_req_wdata),
+    .mem_req_we(mem_req_we),
+    .mem_req_size(mem_req_size),
+    .mem_req_ready(mem_req_ready),
+    .mem_req_rdata(mem_req_rdata),
+    .stat_hits(stat_hits),
+    .stat_misses(stat_misses),
+    .stat_writebacks(stat_writebacks)
+  );
+
+  // Backing memory: 4KB, so DMEM and MMIO addresses alias by their low 12 bits
+  dmem_bus_adapter #(
+    .XLEN(32),
+    .FLEN(64),
+    .MEM_SIZE(4096)
+  ) backing (
+    .clk(clk),
+    .reset_n(reset_n),
+    .req_valid(mem_req_valid),
+    .req_addr(mem_req_addr),
+    .req_wdata(mem_req_wdata),
+    .req_we(mem_req_we),
+    .req_size(mem_req_size),
+    .req_amo(1'b0),
+    .req_amo_op(5'd0),
+    .req_ready(mem_req_ready),
+    .req_rdata(mem_req_rdata)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  // Word currently held by the backing memory
+  function [31:0] mem_word;
+    input [31:0] addr;
+    begin
+      mem_word = {backing.dmem.mem[(addr + 3) & 12'hFFF], backing.dmem.mem[(addr + 2) & 12'hFFF],
+                  backing.dmem.mem[(addr + 1) & 12'hFFF], backing.dmem.mem[addr & 12'hFFF]};
+    end
+  endfunction
+
+  // Record whether any MSHR was still pending when the MMIO store went out
+  reg mmio_seen;
+  reg mmio_mshr_busy;
+  always @(posedge clk) begin
+    if (mem_req_valid && mem_req_we && mem_req_addr == 32'h1000_0400) begin
+      mmio_seen = 1;
+      mmio_mshr_busy = DUT.mshr_valid[0] || DUT.mshr_valid[1];
+    end
+  end
+
+  // Issue one access the way the core does (store enable only on the first
+  // cycle, valid held until ready) and count the wait cycles
+  task access;
+    input        we;
+    input [31:0] addr;
+    input [63:0] wdata;
+    input [2:0]  size;
+    begin
+      @(negedge clk);
+      req_valid = 1;
+      req_we    = we;
+      req_addr  = addr;
+      req_wdata = wdata;
+      req_size  = size;
+      cycles    = 0;
+      #1;
+      while (!req_ready && cycles < 200) begin
+        @(negedge clk);
+        req_we = 0;
+        #1;
+        cycles = cycles + 1;
+      end
+      rdata = req_rdata;
+      @(negedge clk);
+      req_valid = 0;
+      req_we    = 0;
+    end
+  endtask
+
+  // Let the miss engine finish every outstanding line
+  task drain;
+    begin
+      while (DUT.eng_state != 0 || DUT.mshr_valid[0] || DUT.mshr_valid[1])
+        @(negedge clk);
+    end
+  endtask
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        $display("  addr=0x%08h rdata=0x%016h cycles=%0d misses=%0d wb=%0d",
+                 req_addr, rdata, cycles, stat_misses, stat_writebacks);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %s", name);
+      end
+    end
+  endtask
+
+  initial begin
+    $dumpfile("sim/waves/dcache.vcd");
+    $dumpvars(0, tb_dcache);
+
+    req_valid = 0;
+    req_we = 0;
+    req_addr = 0;
+    req_wdata = 0;
+    req_size = 3'b010;
+    mmio_seen = 0;
+    mmio_mshr_busy = 0;
+    reset_n = 0;
+
+    // Fill backing memory after data_memory clears it at time 0
+    #1;
+    for (i = 0; i < 4096; i = i + 1)
+      backing.dmem.mem[i] = i[7:0] ^ {i[11:8], 4'h0} ^ 8'h35;
+    backing.dmem.mem[12'h10F] = 8'h9C;
+
+    #20;
+    reset_n = 1;
+
+    $display("=== D-Cache Tests ===");
+
+    // Load miss: line is refilled, then the rest of the line hits with no wait
+    access(0, 32'h8000_0108, 0, 3'b010);
+    check(rdata[31:0] == mem_word(32'h108) && cycles > 0, "Load miss returns memory word");
+    check(stat_misses == 1, "Load miss allocates one MSHR");
+    access(0, 32'h8000_0100, 0, 3'b010);
+    check(rdata[31:0] == mem_word(32'h100) && cycles == 0, "Load hit completes without wait");
+
+    // Sign / zero extension on hits
+    access(0, 32'h8000_010F, 0, 3'b000);
+    check(rdata[31:0] == 32'hFFFF_FF9C, "LB sign-extends");
+    access(0, 32'h8000_010F, 0, 3'b100);
+    check(rdata[31:0] == 32'h0000_009C, "LBU zero-extends");
+    access(0, 32'h8000_0106, 0, 3'b101);
+    check(rdata[31:0] == (mem_word(32'h106) & 32'h0000_FFFF) && cycles == 0, "Halfword hit at odd word offset");
+
+    // Store hit stays in the cache (write-back)
+    access(1, 32'h8000_0104, 32'hCAFE_BABE, 3'b010);
+    check(cycles == 0, "Store hit completes without wait");
+    check(mem_word(32'h104) != 32'hCAFE_BABE, "Store hit not written through");
+    access(0, 32'h8000_0104, 0, 3'b010);
+    check(rdata[31:0] == 32'hCAFE_BABE, "Load sees stored word");
+
+    // Fill set 0: 0x100 (way 0, dirty) and 0x000 (way 1); 0x080 evicts 0x100
+    access(0, 32'h8000_0000, 0, 3'b010);
+    access(0, 32'h8000_0080, 0, 3'b010);
+    check(rdata[31:0] == mem_word(32'h080), "Conflict miss returns memory word");
+    check(stat_writebacks == 1 && mem_word(32'h104) == 32'hCAFE_BABE,
+          "Dirty victim written back on eviction");
+    access(0, 32'h8000_0004, 0, 3'b010);
+    check(cycles == 0, "Other way of the set still resident");
+
+    // Store miss completes immediately through an MSHR; a load to another
+    // line hits while the miss is outstanding
+    misses_before = stat_misses;
+    access(1, 32'h8000_0210, 32'h1234_5678, 3'b010);
+    check(cycles == 0 && stat_misses == misses_before + 1, "Store miss does not stall");
+    access(1, 32'h8000_0218, 32'h0000_ABCD, 3'b001);
+    check(stat_misses == misses_before + 1, "Second store merges into same MSHR");
+    access(0, 32'h8000_0000, 0, 3'b010);
+    check(cycles == 0, "Hit under miss");
+    access(0, 32'h8000_021C, 0, 3'b010);
+    check(rdata[31:0] == mem_word(32'h21C), "Refilled bytes outside store mask");
+    access(0, 32'h8000_0210, 0, 3'b010);
+    check(rdata[31:0] == 32'h1234_5678 && cycles == 0, "First merged store installed");
+    access(0, 32'h8000_0218, 0, 3'b010);
+    check(rdata[31:0] == {mem_word(32'h218) & 32'hFFFF_0000 | 32'h0000_ABCD},
+          "Second merged store installed");
+
+    // MMIO store waits for outstanding MSHRs before going out uncached
+    drain;
+    access(1, 32'h8000_0320, 32'h5555_AAAA, 3'b010);
+    access(1, 32'h1000_0400, 32'hDEAD_BEEF, 3'b010);
+    check(mmio_seen && !mmio_mshr_busy, "MMIO store ordered after store miss");
+    check(mem_word(32'h400) == 32'hDEAD_BEEF, "MMIO store written to memory");
+    backing.dmem.mem[12'h400] = 8'h77;
+    access(0, 32'h1000_0400, 0, 3'b010);
+    check(rdata[31:0] == 32'hDEAD_BE77, "MMIO load is not cached");
+
+    // Misaligned load crossing lines 0x100/0x110: dirty 0x110 is flushed first
+    access(0, 32'h8000_0110, 0, 3'b010);
+    access(1, 32'h8000_0110, 32'h0000_00A5, 3'b000);
+    access(0, 32'h8000_010E, 0, 3'b010);
+    check(rdata[31:0] == mem_word(32'h10E) && rdata[23:16] == 8'hA5,
+          "Line-crossing load sees flushed dirty byte");
+
+    // Misaligned store crossing lines 0x110/0x120 goes straight to memory
+    access(1, 32'h8000_011E, 32'h1122_3344, 3'b010);
+    check(mem_word(32'h11E) == 32'h1122_3344, "Line-crossing store reaches memory");
+    access(0, 32'h8000_0120, 0, 3'b101);
+    check(rdata[31:0] == 32'h0000_1122, "Refill after crossing store sees new data");
+
+    // Store hit to the victim way in the cycle the engine picks it: set 5
+    // holds 0x050 (way 0, clean, PLRU victim) and 0x0D0 (way 1). A store
+    // miss to 0x150 is followed back-to-back by a store to 0x050, which must
+    // not land in the line the refill of 0x150 is about to replace
+    drain;
+    access(0, 32'h8000_0050, 0, 3'b010);
+    access(0, 32'h8000_00D0, 0, 3'b010);
+    drain;
+    @(negedge clk);
+    req_valid = 1;
+    req_we    = 1;
+    req_addr  = 32'h8000_0150;
+    req_wdata = 64'h0BAD_F00D;
+    req_size  = 3'b010;
+    #1;
+    check(req_ready, "Store miss to the victim's set completes at once");
+    @(negedge clk);
+    req_addr  = 32'h8000_0054;
+    req_wdata = 64'hA5A5_5A5A;
+    #1;
+    race_cycle = DUT.eng_start && DUT.svc_set == 3'd5 && DUT.victim_way == 1'b0;
+    cycles = 0;
+    while (!req_ready && cycles < 200) begin
+      @(negedge clk);
+      req_we = 0;
+      #1;
+      cycles = cycles + 1;
+    end
+    @(negedge clk);
+    req_valid = 0;
+    req_we    = 0;
+    check(race_cycle, "Second store issued while the engine picks way 0");
+    drain;
+    access(0, 32'h8000_0054, 0, 3'b010);
+    check(rdata[31:0] == 32'hA5A5_5A5A, "Store to the victim line is not lost");
+    access(0, 32'h8000_0150, 0, 3'b010);
+    check(rdata[31:0] == 32'h0BAD_F00D, "Store miss installed over the victim");
+    access(0, 32'h8000_0050, 0, 3'b010);
+    check(rdata[31:0] == mem_word(32'h050), "Rest of the victim line intact");
+
+    // Summary
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed: %0d", tests - errors);
+    $display("Failed: %0d", errors);
+
+    if (errors == 0) begin
+      $display("");
+      $display("All tests PASSED!");
+      $display("");
+    end else begin
+      $display("");
+      $display("Some tests FAILED!");
+      $display("");
+    end
+
+    $finish;
+  end
+
+endmodule
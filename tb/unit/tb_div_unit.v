@@ -0,0 +1,264 @@
+// tb_div_unit.v - Testbench for div_unit module
+// Checks DIV/DIVU/REM/REMU (and RV64 W variants) against reference results
+// for the radix-2 and radix-4 dividers, including divide-by-zero, signed
+// overflow and divisor == 1 fast paths, and compares their latencies
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns/1ps
+
+module tb_div_unit;
+
+  reg         clk;
+  reg         reset_n;
+  reg         start;
+  reg  [1:0]  div_op;
+  reg         is_word_op;
+  reg  [63:0] op_a;
+  reg  [63:0] op_b;
+
+  wire [31:0] result_r2;
+  wire [31:0] result_r4;
+  wire [63:0] result_64;
+  wire        busy_r2, busy_r4, busy_64;
+  wire        ready_r2, ready_r4, ready_64;
+
+  integer errors = 0;
+  integer tests = 0;
+  integer i, j;
+  integer cyc_r2, cyc_r4, cyc_64;
+  integer total_r2, total_r4, divs;
+
+  div_unit #(.XLEN(32), .RADIX(2)) DUT_R2 (
+    .clk(clk), .reset_n(reset_n), .start(start),
+    .div_op(div_op), .is_word_op(1'b0),
+    .dividend(op_a[31:0]), .divisor(op_b[31:0]),
+    .result(result_r2), .busy(busy_r2), .ready(ready_r2)
+  );
+
+  div_unit #(.XLEN(32), .RADIX(4)) DUT_R4 (
+    .clk(clk), .reset_n(reset_n), .start(start),
+    .div_op(div_op), .is_word_op(1'b0),
+    .dividend(op_a[31:0]), .divisor(op_b[31:0]),
+    .result(result_r4), .busy(busy_r4), .ready(ready_r4)
+  );
+
+  div_unit #(.XLEN(64), .RADIX(4)) DUT_64 (
+    .clk(clk), .reset_n(reset_n), .start(start),
+    .div_op(div_op), .is_word_op(is_word_op),
+    .dividend(op_a), .divisor(op_b),
+    .result(result_64), .busy(busy_64), .ready(ready_64)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  // RISC-V reference results (div-by-zero and overflow per the M spec)
+  // Signed quotient/remainder are computed in their own statements so the
+  // unsigned special-case values don't turn the division unsigned
+  function [31:0] ref32;
+    input [1:0]  op;
+    input [31:0] a;
+    input [31:0] b;
+    reg signed [31:0] sa, sb, sq, sr;
+    begin
+      sa = a;
+      sb = b;
+      if (b != 0) begin
+        sq = sa / sb;
+        sr = sa % sb;
+      end
+      if (b == 0)
+        ref32 = op[1] ? a : 32'hFFFF_FFFF;
+      else if (op == 2'b00)
+        ref32 = (a == 32'h8000_0000 && b == 32'hFFFF_FFFF) ? a : sq;
+      else if (op == 2'b01)
+        ref32 = a / b;
+      else if (op == 2'b10)
+        ref32 = (a == 32'h8000_0000 && b == 32'hFFFF_FFFF) ? 32'h0 : sr;
+      else
+        ref32 = a % b;
+    end
+  endfunction
+
+  function [63:0] ref64;
+    input [1:0]  op;
+    input        word;
+    input [63:0] a;
+    input [63:0] b;
+    reg   [31:0] w;
+    reg signed [63:0] sa, sb, sq, sr;
+    begin
+      sa = a;
+      sb = b;
+      if (b != 0) begin
+        sq = sa / sb;
+        sr = sa % sb;
+      end
+      if (word) begin
+        w = ref32(op, a[31:0], b[31:0]);
+        ref64 = {{32{w[31]}}, w};
+      end else if (b == 0)
+        ref64 = op[1] ? a : {64{1'b1}};
+      else if (op == 2'b00)
+        ref64 = (a == 64'h8000_0000_0000_0000 && b == {64{1'b1}}) ? a : sq;
+      else if (op == 2'b01)
+        ref64 = a / b;
+      else if (op == 2'b10)
+        ref64 = (a == 64'h8000_0000_0000_0000 && b == {64{1'b1}}) ? 64'h0 : sr;
+      else
+        ref64 = a % b;
+    end
+  endfunction
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        $display("  op=%b word=%b a=0x%016h b=0x%016h r2=0x%08h r4=0x%08h r64=0x%016h",
+                 div_op, is_word_op, op_a, op_b, result_r2, result_r4, result_64);
+        errors = errors + 1;
+      end
+    end
+  endtask
+
+  // Start one division on all three units and wait for each to finish
+  task div_check;
+    input [1:0]  op;
+    input        word;
+    input [63:0] a;
+    input [63:0] b;
+    begin
+      @(negedge clk);
+      div_op     = op;
+      is_word_op = word;
+      op_a       = a;
+      op_b       = b;
+      start      = 1;
+      @(negedge clk);
+      start = 0;
+      fork
+        begin
+          cyc_r2 = 1;
+          while (!ready_r2) begin @(negedge clk); cyc_r2 = cyc_r2 + 1; end
+          if (!word)
+            check(result_r2 == ref32(op, a[31:0], b[31:0]), "Radix-2 result");
+        end
+        begin
+          cyc_r4 = 1;
+          while (!ready_r4) begin @(negedge clk); cyc_r4 = cyc_r4 + 1; end
+          if (!word)
+            check(result_r4 == ref32(op, a[31:0], b[31:0]), "Radix-4 result");
+        end
+        begin
+          cyc_64 = 1;
+          while (!ready_64) begin @(negedge clk); cyc_64 = cyc_64 + 1; end
+          check(result_64 == ref64(op, word, a, b), "RV64 radix-4 result");
+        end
+      join
+      total_r2 = total_r2 + cyc_r2;
+      total_r4 = total_r4 + cyc_r4;
+      divs     = divs + 1;
+    end
+  endtask
+
+  reg [63:0] vec [0:11];
+
+  initial begin
+    $dumpfile("sim/waves/div_unit.vcd");
+    $dumpvars(0, tb_div_unit);
+
+    start      = 0;
+    div_op     = 2'b00;
+    is_word_op = 0;
+    op_a       = 0;
+    op_b       = 0;
+    total_r2   = 0;
+    total_r4   = 0;
+    divs       = 0;
+    reset_n    = 0;
+    #20;
+    reset_n = 1;
+
+    $display("=== Divider Tests ===");
+
+    // Latency: fast paths finish without iterating, small quotients early
+    div_check(2'b01, 0, 64'd12345, 64'd0);
+    check(cyc_r4 <= 2 && cyc_64 <= 2, "Divide by zero fast path");
+    div_check(2'b00, 0, 64'hFFFF_FFFF_8000_0000, 64'hFFFF_FFFF_FFFF_FFFF);
+    check(cyc_r4 <= 2, "Signed overflow fast path");
+    div_check(2'b01, 0, 64'hDEAD_BEEF, 64'd1);
+    check(cyc_r4 <= 2 && cyc_64 <= 2, "Divide by one fast path");
+    div_check(2'b11, 0, 64'd5, 64'd99);
+    check(cyc_r4 <= 2 && cyc_64 <= 2, "Dividend smaller than divisor fast path");
+    div_check(2'b01, 0, 64'd100, 64'd7);
+    check(cyc_r4 <= 5 && cyc_64 <= 5 && cyc_r2 > 30, "Small quotient terminates early");
+    div_check(2'b01, 0, 64'hFFFF_FFFF_FFFF_FFFF, 64'd2);
+    check(cyc_r4 <= 18 && cyc_64 <= 34, "Full-width quotient takes XLEN/2 steps");
+    if (errors == 0)
+      $display("PASS: Fast paths and early termination");
+
+    // Corner operands
+    vec[0]  = 64'h0000_0000_0000_0000;
+    vec[1]  = 64'h0000_0000_0000_0001;
+    vec[2]  = 64'hFFFF_FFFF_FFFF_FFFF;
+    vec[3]  = 64'h8000_0000_0000_0000;
+    vec[4]  = 64'h7FFF_FFFF_FFFF_FFFF;
+    vec[5]  = 64'hFFFF_FFFF_8000_0000;
+    vec[6]  = 64'h0000_0000_7FFF_FFFF;
+    vec[7]  = 64'h0000_0000_0000_0003;
+    vec[8]  = 64'hFFFF_FFFF_FFFF_FFF9;
+    vec[9]  = 64'h1234_5678_9ABC_DEF0;
+    vec[10] = 64'h0000_0000_0001_0000;
+    vec[11] = 64'hDEAD_BEEF_CAFE_BABE;
+
+    for (i = 0; i < 12; i = i + 1)
+      for (j = 0; j < 12; j = j + 1) begin
+        div_check(2'b00, 0, vec[i], vec[j]);
+        div_check(2'b01, 0, vec[i], vec[j]);
+        div_check(2'b10, 0, vec[i], vec[j]);
+        div_check(2'b11, 0, vec[i], vec[j]);
+        div_check(i[1:0], 1, vec[i], vec[j]);
+      end
+
+    // Random operands, including narrow divisors
+    for (i = 0; i < 200; i = i + 1)
+      div_check($random & 3, $random & 1, {$random, $random}, {$random, $random});
+    for (i = 0; i < 100; i = i + 1)
+      div_check($random & 3, 0, {$random, $random}, $random & 16'hFFFF);
+    if (errors == 0)
+      $display("PASS: All ops match reference for radix-2, radix-4 and RV64");
+
+    $display("Average latency over %0d divides: radix-2 %0d.%02d cycles, radix-4 %0d.%02d cycles",
+             divs, total_r2 / divs, (total_r2 * 100 / divs) % 100,
+             total_r4 / divs, (total_r4 * 100 / divs) % 100);
+    check(total_r4 * 2 < total_r2, "Radix-4 at least twice as fast on average");
+
+    // Summary
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed: %0d", tests - errors);
+    $display("Failed: %0d", errors);
+
+    if (errors == 0) begin
+      $display("");
+      $display("All tests PASSED!");
+      $display("");
+    end else begin
+      $display("");
+      $display("Some tests FAILED!");
+      $display("");
+    end
+
+    $finish;
+  end
+
+endmodule
@@ -0,0 +1,265 @@
+// tb_fetch_queue.v - Testbench for fetch_queue module
+// Walks a mixed 16/32-bit instruction stream through the queue with decode
+// stalls and fetch misses, and checks realignment, same-cycle bypass after a
+// redirect, run-ahead during stalls, 64-bit bundles and fetch page faults
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns/1ps
+
+module tb_fetch_queue;
+
+  localparam DEPTH = 8;
+  localparam BASE  = 32'h0000_0100;
+
+  reg         clk;
+  reg         reset_n;
+
+  wire [31:0] fetch_addr;
+  wire        fetch_req;
+  reg         mem_ready;
+  reg  [31:0] fault_base;
+  wire        head_valid;
+  wire [31:0] head_instr;
+  wire        head_next_valid;
+  wire [31:0] head_next;
+  wire        head_fault;
+  wire [31:0] head_fault_vaddr;
+  reg         consume;
+  reg  [2:0]  consume_hw;
+  reg         redirect;
+  reg  [31:0] redirect_pc;
+
+  // Halfword memory, combinational read like instruction_memory
+  reg  [15:0] mem16 [0:1023];
+  wire [9:0]  fa = fetch_addr[10:1];
+  wire [31:0] fetch_data = {mem16[fa + 1], mem16[fa]};
+  wire [31:0] fetch_next = {mem16[fa + 3], mem16[fa + 2]};
+  wire        fetch_fault = (fetch_addr >= fault_base);
+
+  integer errors = 0;
+  integer tests = 0;
+  integer i, n, cycles, bad;
+  reg [31:0] decode_pc;
+  reg [31:0] expect;
+
+  fetch_queue #(
+    .XLEN(32),
+    .DEPTH(DEPTH),
+    .RESET_VECTOR(BASE)
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .fetch_addr(fetch_addr),
+    .fetch_req(fetch_req),
+    .fetch_valid(mem_ready),
+    .fetch_data(fetch_data),
+    .fetch_next_valid(!fetch_addr[1]),
+    .fetch_next(fetch_next),
+    .fetch_fault(fetch_fault),
+    .fetch_fault_vaddr(fetch_addr),
+    .head_valid(head_valid),
+    .head_instr(head_instr),
+    .head_next_valid(head_next_valid),
+    .head_next(head_next),
+    .head_fault(head_fault),
+    .head_fault_vaddr(head_fault_vaddr),
+    .consume(consume),
+    .consume_hw(consume_hw),
+    .redirect(redirect),
+    .redirect_pc(redirect_pc)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        $display("  decode_pc=0x%08h head=0x%08h valid=%b fetch_addr=0x%08h req=%b fault=%b",
+                 decode_pc, head_instr, head_valid, fetch_addr, fetch_req, head_fault);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %s", name);
+      end
+    end
+  endtask
+
+  // One cycle of decode: take the head instruction when `take` is set and
+  // check it against memory at decode_pc
+  task decode_cycle;
+    input take;
+    begin
+      @(negedge clk);
+      #1;
+      consume = 0;
+      if (take && head_valid) begin
+        expect = {mem16[decode_pc[10:1] + 1], mem16[decode_pc[10:1]]};
+        if (head_instr[1:0] != 2'b11) begin
+          if (head_instr[15:0] != expect[15:0]) bad = bad + 1;
+          consume_hw = 3'd1;
+          decode_pc  = decode_pc + 2;
+        end else begin
+          if (head_instr != expect) bad = bad + 1;
+          consume_hw = 3'd2;
+          decode_pc  = decode_pc + 4;
+        end
+        consume = 1;
+        n = n + 1;
+      end
+    end
+  endtask
+
+  task do_redirect;
+    input [31:0] target;
+    begin
+      @(negedge clk);
+      consume     = 0;
+      redirect    = 1;
+      redirect_pc = target;
+      @(negedge clk);
+      redirect    = 0;
+      decode_pc   = target;
+    end
+  endtask
+
+  initial begin
+    $dumpfile("sim/waves/fetch_queue.vcd");
+    $dumpvars(0, tb_fetch_queue);
+
+    // Mixed stream: roughly one compressed halfword in three, unique values
+    for (i = 0; i < 1024; i = i + 1)
+      mem16[i] = ((i * 7) % 3 == 0) ? {i[13:0], 2'b01} : {i[13:0], 2'b11};
+
+    reset_n     = 0;
+    mem_ready   = 1;
+    fault_base  = 32'hFFFF_FFFF;
+    consume     = 0;
+    consume_hw  = 3'd0;
+    redirect    = 0;
+    redirect_pc = 0;
+    decode_pc   = BASE;
+    bad         = 0;
+    n           = 0;
+    #20;
+    reset_n = 1;
+
+    $display("=== Fetch Queue Tests ===");
+
+    // Reset: fetching at the reset vector, visible in the same cycle
+    @(negedge clk);
+    #1;
+    check(fetch_addr == BASE && fetch_req, "Fetch starts at reset vector");
+    check(head_valid && head_instr[15:0] == mem16[BASE >> 1], "Head bypasses the empty queue");
+
+    // Free-running decode through a mixed stream
+    for (i = 0; i < 60; i = i + 1)
+      decode_cycle(1);
+    check(bad == 0 && n == 60, "Mixed 16/32-bit stream realigned");
+
+    // Decode stall: fetch keeps running until the queue is full
+    @(negedge clk);
+    consume = 0;
+    for (i = 0; i < 8; i = i + 1)
+      @(negedge clk);
+    #1;
+    check(!fetch_req && fetch_addr >= decode_pc + 2 * (DEPTH - 1),
+          "Fetch runs ahead while decode is stalled");
+    check(head_valid && head_next_valid, "Queue holds instructions for decode");
+
+    // Drain with fetch misses mixed in; the stream stays intact
+    bad = 0;
+    n   = 0;
+    for (i = 0; i < 80; i = i + 1) begin
+      mem_ready = (i % 5) != 2;
+      decode_cycle((i % 3) != 0);
+    end
+    @(negedge clk);
+    mem_ready = 1;
+    consume   = 0;
+    check(bad == 0 && n > 40, "Stream intact across stalls and fetch misses");
+
+    // Redirect to an odd halfword: one halfword is fetched, then word-aligned
+    do_redirect(BASE + 32'h1A2);
+    #1;
+    check(fetch_addr == BASE + 32'h1A2, "Redirect restarts fetch at target");
+    bad = 0;
+    n   = 0;
+    for (i = 0; i < 20; i = i + 1)
+      decode_cycle(1);
+    check(bad == 0 && n >= 18, "Stream correct after odd-halfword redirect");
+
+    // Redirect with decode taking the head immediately (taken-branch refill)
+    do_redirect(BASE + 32'h40);
+    #1;
+    check(head_valid && head_instr[15:0] == mem16[(BASE + 32'h40) >> 1],
+          "Target visible the cycle after redirect");
+
+    // 64-bit bundle: head_next is the word after a word-aligned head
+    @(negedge clk);
+    consume = 0;
+    for (i = 0; i < 4; i = i + 1)
+      @(negedge clk);
+    #1;
+    check(head_next_valid &&
+          head_next == {mem16[((BASE + 32'h40) >> 1) + 3], mem16[((BASE + 32'h40) >> 1) + 2]},
+          "Bundle word at head + 4");
+    consume    = 1;
+    consume_hw = 3'd4;
+    @(negedge clk);
+    consume   = 0;
+    decode_pc = BASE + 32'h48;
+    #1;
+    check(head_instr[15:0] == mem16[decode_pc >> 1], "Pair consumption advances by 8 bytes");
+
+    // Page fault: reported only after every earlier instruction is consumed
+    do_redirect(BASE + 32'h200);
+    fault_base = BASE + 32'h220;
+    bad    = 0;
+    n      = 0;
+    cycles = 0;
+    while (!head_fault && cycles < 100) begin
+      decode_cycle(1);
+      cycles = cycles + 1;
+    end
+    #1;
+    check(bad == 0 && head_fault && head_fault_vaddr == fault_base,
+          "Fetch fault reported with its address");
+    check(decode_pc == fault_base ||
+          (decode_pc == fault_base - 2 && mem16[decode_pc >> 1][1:0] == 2'b11),
+          "Every instruction before the fault was delivered");
+    check(!fetch_req, "Fetch stops after a fault");
+    fault_base = 32'hFFFF_FFFF;
+    do_redirect(BASE);
+    #1;
+    check(!head_fault && head_valid && fetch_req, "Redirect clears the fault");
+
+    // Summary
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed: %0d", tests - errors);
+    $display("Failed: %0d", errors);
+
+    if (errors == 0) begin
+      $display("");
+      $display("All tests PASSED!");
+      $display("");
+    end else begin
+      $display("");
+      $display("Some tests FAILED!");
+      $display("");
+    end
+
+    $finish;
+  end
+
+endmodule
@@ -0,0 +1,284 @@
+// tb_fp_fma_pipelined.v - Testbench for fp_fma_pipelined module
+// Checks FADD/FSUB/FMUL/FMA variants against precomputed IEEE 754 results
+// (single and double, all rounding modes, specials, subnormals, overflow,
+// fused single rounding), then issues every vector back-to-back to check
+// one-per-cycle throughput, fixed latency and destination tags
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns/1ps
+
+module tb_fp_fma_pipelined;
+
+  reg         clk;
+  reg         reset_n;
+  reg         valid_in;
+  reg  [4:0]  fp_alu_op;
+  reg         fmt;
+  reg  [2:0]  rm;
+  reg  [4:0]  rd_in;
+  reg  [63:0] op_a, op_b, op_c;
+
+  wire        valid_out, valid_out32;
+  wire [4:0]  rd_out, rd_out32;
+  wire        fmt_out, fmt_out32;
+  wire [63:0] result;
+  wire [31:0] result32;
+  wire        nv, of, uf, nx;
+  wire        nv32, of32, uf32, nx32;
+
+  integer errors = 0;
+  integer tests = 0;
+  integer nvec = 0;
+  integer i, cyc;
+
+  fp_fma_pipelined #(.FLEN(64)) DUT (
+    .clk(clk), .reset_n(reset_n), .valid_in(valid_in),
+    .fp_alu_op(fp_alu_op), .fmt(fmt), .rounding_mode(rm), .rd_in(rd_in),
+    .operand_a(op_a), .operand_b(op_b), .operand_c(op_c),
+    .valid_out(valid_out), .rd_out(rd_out), .fmt_out(fmt_out), .result(result),
+    .flag_nv(nv), .flag_of(of), .flag_uf(uf), .flag_nx(nx)
+  );
+
+  // F-only build: single-precision operands without NaN-boxing
+  fp_fma_pipelined #(.FLEN(32)) DUT32 (
+    .clk(clk), .reset_n(reset_n), .valid_in(valid_in && !fmt),
+    .fp_alu_op(fp_alu_op), .fmt(1'b0), .rounding_mode(rm), .rd_in(rd_in),
+    .operand_a(op_a[31:0]), .operand_b(op_b[31:0]), .operand_c(op_c[31:0]),
+    .valid_out(valid_out32), .rd_out(rd_out32), .fmt_out(fmt_out32), .result(result32),
+    .flag_nv(nv32), .flag_of(of32), .flag_uf(uf32), .flag_nx(nx32)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  // Test vectors (expected results and {NV,DZ,OF,UF,NX} flags)
+  reg [4:0]      v_op    [0:63];
+  reg            v_fmt   [0:63];
+  reg [2:0]      v_rm    [0:63];
+  reg [63:0]     v_a     [0:63];
+  reg [63:0]     v_b     [0:63];
+  reg [63:0]     v_c     [0:63];
+  reg [63:0]     v_res   [0:63];
+  reg [4:0]      v_flags [0:63];
+  reg [48*8:1]   v_name  [0:63];
+
+  task vec;
+    input [4:0]    op;
+    input          f;
+    input [2:0]    r;
+    input [63:0]   a;
+    input [63:0]   b;
+    input [63:0]   c;
+    input [63:0]   res;
+    input [4:0]    flags;
+    input [48*8:1] name;
+    begin
+      v_op[nvec]    = op;
+      v_fmt[nvec]   = f;
+      v_rm[nvec]    = r;
+      v_a[nvec]     = a;
+      v_b[nvec]     = b;
+      v_c[nvec]     = c;
+      v_res[nvec]   = res;
+      v_flags[nvec] = flags;
+      v_name[nvec]  = name;
+      nvec = nvec + 1;
+    end
+  endtask
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        $display("  result=0x%016h flags=%b%b0%b%b%b rd=%0d | result32=0x%08h flags32=%b0%b%b%b",
+                 result, nv, 1'b0, of, uf, nx, rd_out, result32, nv32, of32, uf32, nx32);
+        errors = errors + 1;
+      end
+    end
+  endtask
+
+  task drive;
+    input integer k;
+    begin
+      valid_in  = 1;
+      fp_alu_op = v_op[k];
+      fmt       = v_fmt[k];
+      rm        = v_rm[k];
+      op_a      = v_a[k];
+      op_b      = v_b[k];
+      op_c      = v_c[k];
+      rd_in     = k[4:0];
+    end
+  endtask
+
+  // Completion of vector k on both instances (F-only one: boxed singles)
+  task check_result;
+    input integer k;
+    begin
+      check(valid_out && rd_out == k[4:0] && fmt_out == v_fmt[k], v_name[k]);
+      check(result == v_res[k] && {nv, 1'b0, of, uf, nx} == v_flags[k], v_name[k]);
+      if (!v_fmt[k] && v_a[k][63:32] == 32'hFFFF_FFFF && v_b[k][63:32] == 32'hFFFF_FFFF &&
+          v_c[k][63:32] == 32'hFFFF_FFFF)
+        check(valid_out32 && result32 == v_res[k][31:0] &&
+              {nv32, 1'b0, of32, uf32, nx32} == v_flags[k], v_name[k]);
+    end
+  endtask
+
+  initial begin
+    $dumpfile("sim/waves/fp_fma_pipelined.vcd");
+    $dumpvars(0, tb_fp_fma_pipelined);
+
+    valid_in  = 0;
+    fp_alu_op = 5'b00000;
+    fmt       = 0;
+    rm        = 3'd0;
+    rd_in     = 5'd0;
+    op_a      = 0;
+    op_b      = 0;
+    op_c      = 0;
+    reset_n   = 0;
+
+    vec(5'b00000, 1'b1, 3'd0, 64'h3FF8000000000000, 64'h4002000000000000, 64'h0000000000000000,
+        64'h400E000000000000, 5'b00000, "1.5 + 2.25 (D)");
+    vec(5'b00001, 1'b1, 3'd0, 64'h3FF0000000000000, 64'h3FF0000000000000, 64'h0000000000000000,
+        64'h0000000000000000, 5'b00000, "1.0 - 1.0 = +0 (D)");
+    vec(5'b00001, 1'b1, 3'd2, 64'h3FF0000000000000, 64'h3FF0000000000000, 64'h0000000000000000,
+        64'h8000000000000000, 5'b00000, "1.0 - 1.0 = -0 in RDN (D)");
+    vec(5'b00000, 1'b1, 3'd0, 64'h3FF0000000000000, 64'h3CA0000000000000, 64'h0000000000000000,
+        64'h3FF0000000000000, 5'b00001, "1 + 2^-53 ties to even (D)");
+    vec(5'b00000, 1'b1, 3'd3, 64'h3FF0000000000000, 64'h3CA0000000000000, 64'h0000000000000000,
+        64'h3FF0000000000001, 5'b00001, "1 + 2^-53 RUP (D)");
+    vec(5'b00000, 1'b1, 3'd4, 64'h3FF0000000000000, 64'h3CA0000000000000, 64'h0000000000000000,
+        64'h3FF0000000000001, 5'b00001, "1 + 2^-53 RMM (D)");
+    vec(5'b00001, 1'b1, 3'd1, 64'h4340000000000000, 64'h0000000000000001, 64'h0000000000000000,
+        64'h433FFFFFFFFFFFFF, 5'b00001, "Large minus tiny RTZ (D)");
+    vec(5'b00010, 1'b1, 3'd0, 64'h4008000000000000, 64'h4014000000000000, 64'h0000000000000000,
+        64'h402E000000000000, 5'b00000, "3 * 5 (D)");
+    vec(5'b00010, 1'b1, 3'd0, 64'h8000000000000000, 64'h4014000000000000, 64'h0000000000000000,
+        64'h8000000000000000, 5'b00000, "-0 * 5 = -0 (D)");
+    vec(5'b00010, 1'b1, 3'd0, 64'h7FEFFFFFFFFFFFFF, 64'h4000000000000000, 64'h0000000000000000,
+        64'h7FF0000000000000, 5'b00101, "Max * 2 overflow RNE (D)");
+    vec(5'b00010, 1'b1, 3'd1, 64'h7FEFFFFFFFFFFFFF, 64'h4000000000000000, 64'h0000000000000000,
+        64'h7FEFFFFFFFFFFFFF, 5'b00101, "Max * 2 overflow RTZ (D)");
+    vec(5'b00010, 1'b1, 3'd0, 64'h0010000000000000, 64'h3FE0000000000000, 64'h0000000000000000,
+        64'h0008000000000000, 5'b00000, "Min normal * 0.5 subnormal (D)");
+    vec(5'b00010, 1'b1, 3'd0, 64'h0010000000000001, 64'h3FE8000000000000, 64'h0000000000000000,
+        64'h000C000000000001, 5'b00011, "Min normal * 0.75 inexact underflow (D)");
+    vec(5'b00000, 1'b1, 3'd0, 64'h0000000000000003, 64'h000FFFFFFFFFFFFF, 64'h0000000000000000,
+        64'h0010000000000002, 5'b00000, "Subnormal + subnormal (D)");
+    vec(5'b00010, 1'b1, 3'd0, 64'h7FF0000000000000, 64'h0000000000000000, 64'h0000000000000000,
+        64'h7FF8000000000000, 5'b10000, "Inf * 0 invalid (D)");
+    vec(5'b00001, 1'b1, 3'd0, 64'h7FF0000000000000, 64'h7FF0000000000000, 64'h0000000000000000,
+        64'h7FF8000000000000, 5'b10000, "Inf - Inf invalid (D)");
+    vec(5'b00000, 1'b1, 3'd0, 64'h7FF0000000000001, 64'h3FF0000000000000, 64'h0000000000000000,
+        64'h7FF8000000000000, 5'b10000, "sNaN + 1 invalid (D)");
+    vec(5'b00010, 1'b1, 3'd0, 64'h7FF8000000000123, 64'h4000000000000000, 64'h0000000000000000,
+        64'h7FF8000000000000, 5'b00000, "qNaN * 2 quiet (D)");
+    vec(5'b01101, 1'b1, 3'd0, 64'h3FF0000000400000, 64'h3FEFFFFFFF800000, 64'hBFF0000000000000,
+        64'hBC30000000000000, 5'b00000, "Fused: (1+2^-30)(1-2^-30) - 1 (D)");
+    vec(5'b01110, 1'b1, 3'd0, 64'h4008000000000000, 64'h4014000000000000, 64'h402E000000000000,
+        64'h0000000000000000, 5'b00000, "3*5 - 15 = +0 (D)");
+    vec(5'b01110, 1'b1, 3'd2, 64'h4008000000000000, 64'h4014000000000000, 64'h402E000000000000,
+        64'h8000000000000000, 5'b00000, "3*5 - 15 = -0 in RDN (D)");
+    vec(5'b01111, 1'b1, 3'd0, 64'h4000000000000000, 64'h4008000000000000, 64'h3FF0000000000000,
+        64'hC014000000000000, 5'b00000, "-(2*3) + 1 (D)");
+    vec(5'b10000, 1'b1, 3'd0, 64'h4000000000000000, 64'h4008000000000000, 64'h3FF0000000000000,
+        64'hC01C000000000000, 5'b00000, "-(2*3) - 1 (D)");
+    vec(5'b01101, 1'b1, 3'd0, 64'h0000000000000000, 64'h7FF0000000000000, 64'h7FF8000000000000,
+        64'h7FF8000000000000, 5'b10000, "0 * Inf + qNaN invalid (D)");
+    vec(5'b01101, 1'b1, 3'd3, 64'h3FF0000000000001, 64'h3CB0000000000000, 64'h4690000000000000,
+        64'h4690000000000001, 5'b00001, "Huge addend, tiny product (D)");
+    vec(5'b01110, 1'b1, 3'd1, 64'h3FF0000000000000, 64'h3FF0000000000000, 64'h0000000000000001,
+        64'h3FEFFFFFFFFFFFFF, 5'b00001, "Tiny addend, product sticky borrow (D)");
+    vec(5'b01101, 1'b1, 3'd0, 64'h0010000000000001, 64'h3FF0000000000000, 64'h8010000000000000,
+        64'h0000000000000001, 5'b00000, "Cancellation to subnormal (D)");
+    vec(5'b00000, 1'b0, 3'd0, 64'hFFFFFFFF3FC00000, 64'hFFFFFFFF40100000, 64'hFFFFFFFF00000000,
+        64'hFFFFFFFF40700000, 5'b00000, "1.5 + 2.25 (S)");
+    vec(5'b00000, 1'b0, 3'd0, 64'hFFFFFFFF3F800000, 64'hFFFFFFFF33800000, 64'hFFFFFFFF00000000,
+        64'hFFFFFFFF3F800000, 5'b00001, "1 + 2^-24 ties to even (S)");
+    vec(5'b00000, 1'b0, 3'd0, 64'hFFFFFFFF3F800000, 64'hFFFFFFFF33C00000, 64'hFFFFFFFF00000000,
+        64'hFFFFFFFF3F800001, 5'b00001, "1 + 3*2^-25 rounds up (S)");
+    vec(5'b00010, 1'b0, 3'd0, 64'hFFFFFFFF40400000, 64'hFFFFFFFF40A00000, 64'hFFFFFFFF00000000,
+        64'hFFFFFFFF41700000, 5'b00000, "3 * 5 (S)");
+    vec(5'b00010, 1'b0, 3'd2, 64'hFFFFFFFF7F7FFFFF, 64'hFFFFFFFF40000000, 64'hFFFFFFFF00000000,
+        64'hFFFFFFFF7F7FFFFF, 5'b00101, "Max * 2 overflow RDN positive (S)");
+    vec(5'b00010, 1'b0, 3'd2, 64'hFFFFFFFF7F7FFFFF, 64'hFFFFFFFFC0000000, 64'hFFFFFFFF00000000,
+        64'hFFFFFFFFFF800000, 5'b00101, "Max * -2 overflow RDN negative (S)");
+    vec(5'b00010, 1'b0, 3'd0, 64'hFFFFFFFF00800000, 64'hFFFFFFFF3F000000, 64'hFFFFFFFF00000000,
+        64'hFFFFFFFF00400000, 5'b00000, "Min normal * 0.5 (S)");
+    vec(5'b00010, 1'b0, 3'd0, 64'hFFFFFFFF007FFFFF, 64'hFFFFFFFF3F800001, 64'hFFFFFFFF00000000,
+        64'hFFFFFFFF00800000, 5'b00001, "Tiny before, normal after rounding (S)");
+    vec(5'b01101, 1'b0, 3'd0, 64'hFFFFFFFF3F800800, 64'hFFFFFFFF3F7FF000, 64'hFFFFFFFFBF800000,
+        64'hFFFFFFFFB3800000, 5'b00000, "Fused: (1+2^-12)(1-2^-12) - 1 (S)");
+    vec(5'b10000, 1'b0, 3'd0, 64'hFFFFFFFF40000000, 64'hFFFFFFFF40400000, 64'hFFFFFFFF3F800000,
+        64'hFFFFFFFFC0E00000, 5'b00000, "-(2*3) - 1 (S)");
+    vec(5'b00000, 1'b0, 3'd0, 64'h000000003F800000, 64'hFFFFFFFF3F800000, 64'hFFFFFFFF00000000,
+        64'hFFFFFFFF7FC00000, 5'b00000, "Improperly boxed input is NaN (S)");
+    vec(5'b01101, 1'b0, 3'd0, 64'hFFFFFFFF7F800001, 64'hFFFFFFFF3F800000, 64'hFFFFFFFF3F800000,
+        64'hFFFFFFFF7FC00000, 5'b10000, "sNaN fma invalid (S)");
+    vec(5'b00001, 1'b0, 3'd1, 64'hFFFFFFFF00000005, 64'hFFFFFFFF00000007, 64'hFFFFFFFF00000000,
+        64'hFFFFFFFF80000002, 5'b00000, "Subnormal - subnormal (S)");
+    #20;
+    reset_n = 1;
+
+    $display("=== Pipelined FMA Tests ===");
+
+    // One op at a time: result appears exactly 3 cycles after issue
+    for (i = 0; i < nvec; i = i + 1) begin
+      @(negedge clk);
+      drive(i);
+      @(negedge clk);
+      valid_in = 0;
+      check(!valid_out, "No completion before latency");
+      @(negedge clk);
+      check(!valid_out, "No completion before latency");
+      @(negedge clk);
+      check_result(i);
+    end
+    if (errors == 0)
+      $display("PASS: All %0d vectors match IEEE 754 reference", nvec);
+
+    // Back-to-back: a new op every cycle, each completing 3 cycles later in order
+    for (cyc = 0; cyc < nvec + 3; cyc = cyc + 1) begin
+      @(negedge clk);
+      if (cyc >= 3)
+        check_result(cyc - 3);
+      if (cyc < nvec)
+        drive(cyc);
+      else
+        valid_in = 0;
+    end
+    @(negedge clk);
+    check(!valid_out, "Pipeline empty after stream");
+    if (errors == 0)
+      $display("PASS: Back-to-back issue completes one op per cycle");
+
+    // Summary
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed: %0d", tests - errors);
+    $display("Failed: %0d", errors);
+
+    if (errors == 0) begin
+      $display("");
+      $display("All tests PASSED!");
+      $display("");
+    end else begin
+      $display("");
+      $display("Some tests FAILED!");
+      $display("");
+    end
+
+    $finish;
+  end
+
+endmodule
@@ -0,0 +1,306 @@
+// tb_hpm_counters.v - Testbench for the csr_file.v performance counters
+// Drives csr_file directly (RV32, HPM_COUNTERS=4) like the core's EX stage:
+// mcycle/minstret/time, mhpmevent selection and WARL, mcountinhibit, the
+// RV32 upper halves, and the mcounteren/scounteren gating of the user-level
+// shadows in S- and U-mode
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns / 1ps
+
+module tb_hpm_counters;
+
+  reg         clk;
+  reg         reset_n;
+
+  reg  [11:0] csr_addr;
+  reg  [31:0] csr_wdata;
+  reg  [2:0]  csr_op;
+  reg         csr_we;
+  reg         csr_access;
+  wire [31:0] csr_rdata;
+  wire        illegal_csr;
+  reg  [1:0]  priv;
+
+  reg  [1:0]  instret_inc;
+  reg  [9:0]  hpm_events;
+  reg  [63:0] mtime;
+
+  localparam [11:0] CSR_MCOUNTEREN    = 12'h306;
+  localparam [11:0] CSR_MCOUNTINHIBIT = 12'h320;
+  localparam [11:0] CSR_MHPMEVENT3    = 12'h323;
+  localparam [11:0] CSR_MHPMEVENT4    = 12'h324;
+  localparam [11:0] CSR_MHPMEVENT10   = 12'h32A;
+  localparam [11:0] CSR_MCYCLE        = 12'hB00;
+  localparam [11:0] CSR_MINSTRET      = 12'hB02;
+  localparam [11:0] CSR_MHPMCOUNTER3  = 12'hB03;
+  localparam [11:0] CSR_MHPMCOUNTER4  = 12'hB04;
+  localparam [11:0] CSR_MHPMCOUNTER10 = 12'hB0A;
+  localparam [11:0] CSR_MCYCLEH       = 12'hB80;
+  localparam [11:0] CSR_SCOUNTEREN    = 12'h106;
+  localparam [11:0] CSR_CYCLE         = 12'hC00;
+  localparam [11:0] CSR_TIME          = 12'hC01;
+  localparam [11:0] CSR_TIMEH         = 12'hC81;
+  localparam [11:0] CSR_INSTRET       = 12'hC02;
+  localparam [11:0] CSR_HPMCOUNTER3   = 12'hC03;
+
+  localparam [2:0] CSR_RW = 3'b001;
+  localparam [1:0] PRIV_U = 2'b00;
+  localparam [1:0] PRIV_S = 2'b01;
+  localparam [1:0] PRIV_M = 2'b11;
+
+  integer errors = 0;
+  integer tests = 0;
+  reg [31:0] v0, v1;
+  reg        ill;
+
+  csr_file #(
+    .XLEN(32),
+    .HPM_COUNTERS(4)
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .csr_addr(csr_addr),
+    .csr_wdata(csr_wdata),
+    .csr_op(csr_op),
+    .csr_we(csr_we),
+    .csr_access(csr_access),
+    .csr_rdata(csr_rdata),
+    .trap_entry(1'b0),
+    .trap_pc(32'h0),
+    .trap_cause(5'd0),
+    .trap_is_interrupt(1'b0),
+    .trap_val(32'h0),
+    .trap_vector(),
+    .mret(1'b0),
+    .mepc_out(),
+    .sret(1'b0),
+    .sepc_out(),
+    .mstatus_mie(),
+    .mstatus_sie(),
+    .mstatus_mpie(),
+    .mstatus_spie(),
+    .illegal_csr(illegal_csr),
+    .current_priv(priv),
+    .actual_priv(priv),
+    .trap_target_priv(),
+    .mpp_out(),
+    .spp_out(),
+    .medeleg_out(),
+    .satp_out(),
+    .mstatus_sum(),
+    .mstatus_mxr(),
+    .mstatus_fs(),
+    .frm_out(),
+    .fflags_out(),
+    .fflags_we(1'b0),
+    .fflags_in(5'd0),
+    .mtip_in(1'b0),
+    .msip_in(1'b0),
+    .meip_in(1'b0),
+    .seip_in(1'b0),
+    .mip_out(),
+    .mie_out(),
+    .mideleg_out(),
+    .instret_inc(instret_inc),
+    .hpm_events(hpm_events),
+    .mtime_in(mtime)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %s", name);
+      end
+    end
+  endtask
+
+  // CSR read in the current cycle (as EX does); returns data and illegal flag
+  task csr_read;
+    input  [11:0] addr;
+    output [31:0] data;
+    output        illegal;
+    begin
+      @(negedge clk);
+      csr_addr   = addr;
+      csr_access = 1'b1;
+      csr_we     = 1'b0;
+      #1;
+      data       = csr_rdata;
+      illegal    = illegal_csr;
+      csr_access = 1'b0;
+    end
+  endtask
+
+  // CSRRW for one cycle
+  task csr_write;
+    input [11:0] addr;
+    input [31:0] data;
+    begin
+      @(negedge clk);
+      csr_addr   = addr;
+      csr_wdata  = data;
+      csr_op     = CSR_RW;
+      csr_we     = 1'b1;
+      csr_access = 1'b1;
+      @(negedge clk);
+      csr_we     = 1'b0;
+      csr_access = 1'b0;
+    end
+  endtask
+
+  initial begin
+    $display("========================================");
+    $display("Performance Counter Testbench");
+    $display("========================================");
+
+    reset_n     = 0;
+    csr_addr    = 0;
+    csr_wdata   = 0;
+    csr_op      = 0;
+    csr_we      = 0;
+    csr_access  = 0;
+    priv        = PRIV_M;
+    instret_inc = 0;
+    hpm_events  = 0;
+    mtime       = 64'h0000_0001_2345_6789;
+    repeat (3) @(posedge clk);
+    reset_n = 1;
+    repeat (2) @(posedge clk);
+
+    //------------------------------------------------------------------------
+    // Test 1: mcycle counts every cycle, minstret the retire count
+    //------------------------------------------------------------------------
+    $display("\n--- Test 1: mcycle/minstret ---");
+    csr_read(CSR_MCYCLE, v0, ill);
+    repeat (9) @(negedge clk);
+    csr_read(CSR_MCYCLE, v1, ill);
+    check(v1 - v0 == 32'd10, "mcycle advances once per cycle");
+    csr_read(CSR_MINSTRET, v0, ill);
+    check(v0 == 32'd0, "minstret holds with nothing retiring");
+    @(negedge clk) instret_inc = 2'd1;
+    repeat (3) @(negedge clk);
+    instret_inc = 2'd2;
+    repeat (2) @(negedge clk);
+    instret_inc = 2'd0;
+    csr_read(CSR_MINSTRET, v0, ill);
+    check(v0 == 32'd7, "minstret adds 1 or 2 per cycle (dual issue)");
+
+    //------------------------------------------------------------------------
+    // Test 2: writes, upper half, mcountinhibit
+    //------------------------------------------------------------------------
+    $display("\n--- Test 2: Writes and inhibit ---");
+    csr_write(CSR_MCYCLEH, 32'h0000_00AB);
+    csr_read(CSR_MCYCLEH, v0, ill);
+    check(v0 == 32'h0000_00AB, "mcycleh write");
+    csr_write(CSR_MCOUNTINHIBIT, 32'hFFFF_FFFF);
+    csr_read(CSR_MCOUNTINHIBIT, v0, ill);
+    check(v0 == 32'h0000_007D, "mcountinhibit: CY, IR, HPM3-6 writable, TM zero");
+    csr_write(CSR_MCYCLE, 32'h0000_1000);
+    repeat (4) @(negedge clk);
+    csr_read(CSR_MCYCLE, v0, ill);
+    check(v0 == 32'h0000_1000, "Inhibited mcycle keeps the written value");
+    csr_write(CSR_MCOUNTINHIBIT, 32'h0);
+    csr_read(CSR_MCYCLE, v0, ill);
+    check(v0 > 32'h0000_1000, "mcycle runs again");
+
+    //------------------------------------------------------------------------
+    // Test 3: event selection
+    //------------------------------------------------------------------------
+    $display("\n--- Test 3: mhpmevent ---");
+    csr_write(CSR_MHPMEVENT3, 32'd1);   // Load-use
+    csr_write(CSR_MHPMEVENT4, 32'd9);   // I-TLB miss
+    csr_write(CSR_MHPMCOUNTER3, 32'h0);
+    csr_write(CSR_MHPMCOUNTER4, 32'h0);
+    @(negedge clk) hpm_events = 10'b00_0000_0001;
+    repeat (4) @(negedge clk);
+    hpm_events = 10'b01_0000_0000;
+    @(negedge clk) hpm_events = 10'b0;
+    csr_read(CSR_MHPMCOUNTER3, v0, ill);
+    check(v0 == 32'd4, "mhpmcounter3 counts load-use cycles");
+    csr_read(CSR_MHPMCOUNTER4, v0, ill);
+    check(v0 == 32'd1, "mhpmcounter4 counts the I-TLB miss only");
+    csr_write(CSR_MHPMEVENT3, 32'd11);
+    csr_read(CSR_MHPMEVENT3, v0, ill);
+    check(v0 == 32'd0, "Unsupported event number reads back 0 (WARL)");
+    csr_write(CSR_MHPMEVENT10, 32'd1);
+    csr_read(CSR_MHPMEVENT10, v0, ill);
+    check(v0 == 32'd0 && !ill, "mhpmevent10 (not implemented) exists, reads 0");
+    csr_read(CSR_MHPMCOUNTER10, v0, ill);
+    check(v0 == 32'd0 && !ill, "mhpmcounter10 (not implemented) exists, reads 0");
+
+    //------------------------------------------------------------------------
+    // Test 4: time
+    //------------------------------------------------------------------------
+    $display("\n--- Test 4: time ---");
+    csr_read(CSR_TIME, v0, ill);
+    check(v0 == 32'h2345_6789, "time reads mtime");
+    csr_read(CSR_TIMEH, v0, ill);
+    check(v0 == 32'h0000_0001, "timeh reads mtime[63:32]");
+
+    //------------------------------------------------------------------------
+    // Test 5: mcounteren/scounteren gating
+    //------------------------------------------------------------------------
+    $display("\n--- Test 5: Access gating ---");
+    priv = PRIV_S;
+    csr_read(CSR_CYCLE, v0, ill);
+    check(ill, "S-mode cycle traps with mcounteren clear");
+    priv = PRIV_M;
+    csr_write(CSR_MCOUNTEREN, 32'h0000_0005);  // CY, IR
+    priv = PRIV_S;
+    csr_read(CSR_CYCLE, v0, ill);
+    check(!ill, "S-mode cycle allowed by mcounteren.CY");
+    csr_read(CSR_TIME, v0, ill);
+    check(ill, "S-mode time traps with mcounteren.TM clear");
+    csr_read(CSR_MCYCLE, v0, ill);
+    check(ill, "S-mode mcycle traps (M-level CSR)");
+    priv = PRIV_U;
+    csr_read(CSR_INSTRET, v0, ill);
+    check(ill, "U-mode instret traps with scounteren clear");
+    priv = PRIV_S;
+    csr_write(CSR_SCOUNTEREN, 32'h0000_0004);  // IR
+    priv = PRIV_U;
+    csr_read(CSR_INSTRET, v0, ill);
+    check(!ill && v0 == 32'd7, "U-mode instret allowed by both enables");
+    csr_read(CSR_CYCLE, v0, ill);
+    check(ill, "U-mode cycle traps with scounteren.CY clear");
+    csr_read(CSR_HPMCOUNTER3, v0, ill);
+    check(ill, "U-mode hpmcounter3 traps with mcounteren.HPM3 clear");
+    priv = PRIV_M;
+    csr_read(CSR_HPMCOUNTER3, v0, ill);
+    check(!ill && v0 == 32'd4, "M-mode hpmcounter3 shadow");
+
+    //------------------------------------------------------------------------
+    // Summary
+    //------------------------------------------------------------------------
+    $display("\n========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed:      %0d", tests - errors);
+    $display("Failed:      %0d", errors);
+    if (errors == 0)
+      $display("All tests PASSED!");
+    else
+      $display("Some tests FAILED!");
+    $finish;
+  end
+
+  initial begin
+    #100000;
+    $display("ERROR: Timeout");
+    $finish;
+  end
+
+endmodule
@@ -0,0 +1,264 @@
+// tb_l2_tlb.v - Testbench for l2_tlb module
+// Checks 4KB-page set indexing and pseudo-LRU replacement within a set,
+// megapage matching in the superpage array, ASID/global tagging, the
+// SFENCE.VMA flush variants and the hit/miss counters
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns/1ps
+
+module tb_l2_tlb;
+
+  localparam ENTRIES = 16;   // 4 sets x 4 ways
+  localparam WAYS    = 4;
+
+  reg         clk;
+  reg         reset_n;
+
+  reg         lookup_valid;
+  reg  [31:0] lookup_vaddr;
+  wire        lookup_hit;
+  wire [31:0] lookup_vpn;
+  wire [31:0] lookup_ppn;
+  wire [7:0]  lookup_pte;
+  wire [31:0] lookup_level;
+
+  reg         update_valid;
+  reg  [31:0] update_vpn;
+  reg  [31:0] update_ppn;
+  reg  [7:0]  update_pte;
+  reg  [31:0] update_level;
+
+  reg  [15:0] asid;
+  reg         flush_all;
+  reg         flush_vaddr;
+  reg  [31:0] flush_addr;
+  reg         flush_asid;
+  reg  [15:0] flush_asid_value;
+
+  wire [31:0] stat_hits;
+  wire [31:0] stat_misses;
+
+  integer errors = 0;
+  integer tests = 0;
+  integer i;
+
+  localparam PTE_RW   = 8'hC7;  // D A - - - W R V
+  localparam PTE_RX_G = 8'h6B;  // - A G - X - R V
+
+  l2_tlb #(
+    .XLEN(32),
+    .ENTRIES(ENTRIES),
+    .WAYS(WAYS),
+    .SUPERPAGES(4)
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .lookup_valid(lookup_valid),
+    .lookup_vaddr(lookup_vaddr),
+    .lookup_hit(lookup_hit),
+    .lookup_vpn(lookup_vpn),
+    .lookup_ppn(lookup_ppn),
+    .lookup_pte(lookup_pte),
+    .lookup_level(lookup_level),
+    .update_valid(update_valid),
+    .update_vpn(update_vpn),
+    .update_ppn(update_ppn),
+    .update_pte(update_pte),
+    .update_level(update_level),
+    .asid(asid),
+    .flush_all(flush_all),
+    .flush_vaddr(flush_vaddr),
+    .flush_addr(flush_addr),
+    .flush_asid(flush_asid),
+    .flush_asid_value(flush_asid_value),
+    .stat_hits(stat_hits),
+    .stat_misses(stat_misses)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        $display("  asid=%0d vaddr=0x%08h hit=%b vpn=0x%05h ppn=0x%05h level=%0d",
+                 asid, lookup_vaddr, lookup_hit, lookup_vpn, lookup_ppn, lookup_level);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %s", name);
+      end
+    end
+  endtask
+
+  // PTW result
+  task fill;
+    input [15:0] a;
+    input [19:0] vpn;
+    input [19:0] ppn;
+    input [7:0]  pte;
+    input [1:0]  level;
+    begin
+      @(negedge clk);
+      asid         = a;
+      update_valid = 1;
+      update_vpn   = {12'h0, vpn};
+      update_ppn   = {12'h0, ppn};
+      update_pte   = pte;
+      update_level = {30'h0, level};
+      @(negedge clk);
+      update_valid = 0;
+    end
+  endtask
+
+  // One probe cycle (hit updates pseudo-LRU and counters)
+  task probe;
+    input [15:0] a;
+    input [31:0] vaddr;
+    begin
+      @(negedge clk);
+      asid         = a;
+      lookup_vaddr = vaddr;
+      lookup_valid = 1;
+      #1;
+    end
+  endtask
+
+  task idle;
+    begin
+      @(negedge clk);
+      lookup_valid = 0;
+    end
+  endtask
+
+  task sfence;
+    input        all;
+    input        by_addr;
+    input [31:0] addr;
+    input        by_asid;
+    input [15:0] a;
+    begin
+      @(negedge clk);
+      lookup_valid     = 0;
+      flush_all        = all;
+      flush_vaddr      = by_addr;
+      flush_addr       = addr;
+      flush_asid       = by_asid;
+      flush_asid_value = a;
+      @(negedge clk);
+      flush_all   = 0;
+      flush_vaddr = 0;
+      flush_asid  = 0;
+    end
+  endtask
+
+  initial begin
+    $dumpfile("sim/waves/l2_tlb.vcd");
+    $dumpvars(0, tb_l2_tlb);
+
+    reset_n          = 0;
+    lookup_valid     = 0;
+    lookup_vaddr     = 0;
+    update_valid     = 0;
+    update_vpn       = 0;
+    update_ppn       = 0;
+    update_pte       = 0;
+    update_level     = 0;
+    asid             = 0;
+    flush_all        = 0;
+    flush_vaddr      = 0;
+    flush_addr       = 0;
+    flush_asid       = 0;
+    flush_asid_value = 0;
+    #20;
+    reset_n = 1;
+
+    $display("=== L2 TLB Tests ===");
+
+    // 4KB pages: fill all four ways of set 1 (VPN[1:0] = 1)
+    for (i = 0; i < 4; i = i + 1)
+      fill(16'd1, 20'h10001 + (i << 2), 20'h80001 + (i << 2), PTE_RW, 2'd0);
+
+    probe(16'd1, 32'h1000_1abc);
+    check(lookup_hit && lookup_ppn == 32'h80001 && lookup_level == 0, "4KB page hit");
+    probe(16'd1, 32'h1000_d000);
+    check(lookup_hit && lookup_vpn == 32'h1000d, "Fourth way of the set hits");
+    probe(16'd1, 32'h1000_2000);
+    check(!lookup_hit, "Other set misses");
+    probe(16'd2, 32'h1000_1000);
+    check(!lookup_hit, "Other ASID misses");
+
+    // Touch ways 0, 2, 3; way 1 (VPN 0x10005) is now least recently used
+    probe(16'd1, 32'h1000_1000);
+    probe(16'd1, 32'h1000_9000);
+    probe(16'd1, 32'h1000_d000);
+    idle;
+    fill(16'd1, 20'h10011, 20'h80011, PTE_RW, 2'd0);
+    probe(16'd1, 32'h1000_5000);
+    check(!lookup_hit, "Pseudo-LRU evicts the least recently used way");
+    probe(16'd1, 32'h1001_1000);
+    check(lookup_hit && lookup_ppn == 32'h80011, "New page filled");
+    probe(16'd1, 32'h1000_1000);
+    check(lookup_hit, "Recently used way kept");
+    probe(16'd1, 32'h1000_d000);
+    check(lookup_hit, "Recently used way kept (2)");
+
+    // 4MB megapage (Sv32 level 1), global
+    idle;
+    fill(16'd1, 20'h40000, 20'h20000, PTE_RX_G, 2'd1);
+    probe(16'd3, 32'h4012_3456);
+    check(lookup_hit && lookup_level == 1 && lookup_vpn == 32'h40000 &&
+          lookup_ppn == 32'h20000, "Megapage hit for an address inside it");
+    probe(16'd3, 32'h403f_f000);
+    check(lookup_hit, "Megapage covers its last 4KB page");
+    probe(16'd3, 32'h4040_0000);
+    check(!lookup_hit, "Next megapage misses");
+
+    // Flushes
+    sfence(0, 1, 32'h4020_0000, 0, 16'd0);
+    probe(16'd1, 32'h4000_0000);
+    check(!lookup_hit, "Address flush inside a megapage removes it");
+    sfence(0, 0, 32'h0, 1, 16'd1);
+    probe(16'd1, 32'h1000_1000);
+    check(!lookup_hit, "ASID flush removes 4KB pages of that ASID");
+    idle;
+    fill(16'd1, 20'h40000, 20'h20000, PTE_RX_G, 2'd1);
+    sfence(0, 0, 32'h0, 1, 16'd1);
+    probe(16'd1, 32'h4000_0000);
+    check(lookup_hit, "ASID flush keeps global superpages");
+    sfence(1, 0, 32'h0, 0, 16'd0);
+    probe(16'd1, 32'h4000_0000);
+    check(!lookup_hit, "Flush all removes everything");
+    idle;
+
+    check(stat_hits == 11 && stat_misses == 7, "Hit/miss counters");
+
+    // Summary
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed: %0d", tests - errors);
+    $display("Failed: %0d", errors);
+
+    if (errors == 0) begin
+      $display("");
+      $display("All tests PASSED!");
+      $display("");
+    end else begin
+      $display("");
+      $display("Some tests FAILED!");
+      $display("");
+    end
+
+    $finish;
+  end
+
+endmodule
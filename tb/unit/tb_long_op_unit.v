@@ -0,0 +1,267 @@
+// tb_long_op_unit.v - Testbench for long_op_unit module
+// Checks background DIV/REM, FDIV and FSQRT: results and flags, operands
+// captured at issue, completion held until granted, FDIV-over-FSQRT
+// completion priority and the busy flags the core scoreboard relies on
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns/1ps
+
+`include "config/rv_config.vh"
+
+module tb_long_op_unit;
+
+  reg         clk;
+  reg         reset_n;
+
+  reg         int_issue;
+  reg  [1:0]  int_op;
+  reg  [31:0] int_a, int_b;
+  reg  [4:0]  int_rd;
+  reg         int_wb_grant;
+  wire        int_busy;
+  wire        int_wb_valid;
+  wire [4:0]  int_wb_rd;
+  wire [31:0] int_wb_data;
+
+  reg         fp_issue;
+  reg         fp_is_sqrt;
+  reg         fp_fmt;
+  reg  [2:0]  fp_rm;
+  reg  [4:0]  fp_rd;
+  reg  [63:0] fp_a, fp_b;
+  reg         fp_wb_grant;
+  wire        fdiv_busy, fsqrt_busy;
+  wire        fp_wb_valid;
+  wire [4:0]  fp_wb_rd;
+  wire        fp_wb_fmt;
+  wire [63:0] fp_wb_data;
+  wire [4:0]  fp_wb_flags;
+
+  integer errors = 0;
+  integer tests = 0;
+  integer i, cycles;
+
+  long_op_unit #(.XLEN(32), .FLEN(64)) DUT (
+    .clk(clk), .reset_n(reset_n),
+    .int_issue(int_issue), .int_op(int_op), .int_word(1'b0),
+    .int_a(int_a), .int_b(int_b), .int_rd(int_rd), .int_busy(int_busy),
+    .int_wb_valid(int_wb_valid), .int_wb_rd(int_wb_rd), .int_wb_data(int_wb_data),
+    .int_wb_grant(int_wb_grant),
+    .fp_issue(fp_issue), .fp_is_sqrt(fp_is_sqrt), .fp_fmt(fp_fmt), .fp_rm(fp_rm),
+    .fp_rd(fp_rd), .fp_a(fp_a), .fp_b(fp_b),
+    .fdiv_busy(fdiv_busy), .fsqrt_busy(fsqrt_busy),
+    .fp_wb_valid(fp_wb_valid), .fp_wb_rd(fp_wb_rd), .fp_wb_fmt(fp_wb_fmt),
+    .fp_wb_data(fp_wb_data), .fp_wb_flags(fp_wb_flags), .fp_wb_grant(fp_wb_grant)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        $display("  int: valid=%b rd=x%0d data=0x%08h  fp: valid=%b rd=f%0d data=0x%016h flags=%b",
+                 int_wb_valid, int_wb_rd, int_wb_data, fp_wb_valid, fp_wb_rd, fp_wb_data, fp_wb_flags);
+        errors = errors + 1;
+      end
+    end
+  endtask
+
+  // Issue a divide for one cycle, then scramble the EX operands
+  task issue_div;
+    input [1:0]  op;
+    input [31:0] a;
+    input [31:0] b;
+    input [4:0]  rd;
+    begin
+      @(negedge clk);
+      int_issue = 1;
+      int_op    = op;
+      int_a     = a;
+      int_b     = b;
+      int_rd    = rd;
+      @(negedge clk);
+      int_issue = 0;
+      int_a     = 32'hDEAD_BEEF;
+      int_b     = 32'h0000_0003;
+    end
+  endtask
+
+  // Issue FDIV (is_sqrt=0) or FSQRT (is_sqrt=1) for one cycle
+  task issue_fp;
+    input        sqrt;
+    input        fmt;
+    input [63:0] a;
+    input [63:0] b;
+    input [4:0]  rd;
+    begin
+      @(negedge clk);
+      fp_issue   = 1;
+      fp_is_sqrt = sqrt;
+      fp_fmt     = fmt;
+      fp_a       = a;
+      fp_b       = b;
+      fp_rd      = rd;
+      @(negedge clk);
+      fp_issue = 0;
+      fp_a     = 64'h4059_0000_0000_0000;
+      fp_b     = 64'hC000_0000_0000_0000;
+      fp_fmt   = ~fmt;
+    end
+  endtask
+
+  // Wait (granting immediately) for the integer completion
+  task int_result;
+    input [31:0] exp_data;
+    input [4:0]  exp_rd;
+    begin
+      cycles = 0;
+      while (!int_wb_valid && cycles < 200) begin @(negedge clk); cycles = cycles + 1; end
+      check(int_wb_valid, "Integer divide completes");
+      check(int_wb_rd == exp_rd && int_wb_data == exp_data, "Integer divide result and tag");
+      int_wb_grant = 1;
+      @(negedge clk);
+      int_wb_grant = 0;
+      check(!int_wb_valid && !int_busy, "Divider free after grant");
+    end
+  endtask
+
+  // Wait (granting immediately) for an FP completion
+  task fp_result;
+    input [63:0] exp_data;
+    input        single;
+    input [4:0]  exp_flags;
+    input [4:0]  exp_rd;
+    begin
+      cycles = 0;
+      while (!fp_wb_valid && cycles < 200) begin @(negedge clk); cycles = cycles + 1; end
+      check(fp_wb_valid, "FP op completes");
+      if (single)
+        check(fp_wb_data[31:0] == exp_data[31:0] && !fp_wb_fmt, "Single result");
+      else
+        check(fp_wb_data == exp_data && fp_wb_fmt, "Double result");
+      check(fp_wb_flags == exp_flags && fp_wb_rd == exp_rd, "FP flags and tag");
+      fp_wb_grant = 1;
+      @(negedge clk);
+      fp_wb_grant = 0;
+    end
+  endtask
+
+  reg [31:0] held_data;
+
+  initial begin
+    $dumpfile("sim/waves/long_op_unit.vcd");
+    $dumpvars(0, tb_long_op_unit);
+
+    int_issue    = 0;
+    int_op       = 2'b00;
+    int_a        = 0;
+    int_b        = 0;
+    int_rd       = 0;
+    int_wb_grant = 0;
+    fp_issue     = 0;
+    fp_is_sqrt   = 0;
+    fp_fmt       = 1;
+    fp_rm        = 3'b000;
+    fp_rd        = 0;
+    fp_a         = 0;
+    fp_b         = 0;
+    fp_wb_grant  = 0;
+    reset_n      = 0;
+    #20;
+    reset_n = 1;
+
+    $display("=== Long-Latency Unit Tests ===");
+
+    // Integer divide: operands captured at issue, result tagged with rd
+    issue_div(2'b00, 32'hFFFF_FF9C, 32'd7, 5'd5);       // -100 / 7
+    check(int_busy, "Divider busy after issue");
+    int_result(32'hFFFF_FFF2, 5'd5);                     // -14
+    issue_div(2'b10, 32'hFFFF_FF9C, 32'd7, 5'd6);       // -100 % 7
+    int_result(32'hFFFF_FFFE, 5'd6);                     // -2
+    issue_div(2'b01, 32'd1000, 32'd0, 5'd7);            // DIVU by zero
+    int_result(32'hFFFF_FFFF, 5'd7);
+    issue_div(2'b11, 32'hFFFF_FFFF, 32'd10, 5'd31);     // REMU
+    int_result(32'd5, 5'd31);
+    if (errors == 0)
+      $display("PASS: Integer divide results");
+
+    // Completion held while the write slot is not granted
+    issue_div(2'b01, 32'd144, 32'd12, 5'd9);
+    cycles = 0;
+    while (!int_wb_valid && cycles < 200) begin @(negedge clk); cycles = cycles + 1; end
+    held_data = int_wb_data;
+    for (i = 0; i < 5; i = i + 1) begin
+      @(negedge clk);
+      check(int_wb_valid && int_busy && int_wb_data == held_data && int_wb_rd == 5'd9,
+            "Result held until granted");
+    end
+    int_result(32'd12, 5'd9);
+    if (errors == 0)
+      $display("PASS: Integer completion waits for a write slot");
+
+    // FDIV / FSQRT results and flags (double unless noted, RNE)
+    issue_fp(0, 1, 64'h4018_0000_0000_0000, 64'h4000_0000_0000_0000, 5'd1);  // 6 / 2
+    check(fdiv_busy && !fsqrt_busy, "FDIV busy after issue");
+    fp_result(64'h4008_0000_0000_0000, 0, 5'b00000, 5'd1);
+    check(!fdiv_busy, "FDIV free after grant");
+    issue_fp(0, 1, 64'h3FF0_0000_0000_0000, 64'h0000_0000_0000_0000, 5'd2);  // 1 / 0
+    fp_result(64'h7FF0_0000_0000_0000, 0, 5'b01000, 5'd2);
+    issue_fp(0, 1, 64'h3FF0_0000_0000_0000, 64'h4008_0000_0000_0000, 5'd3);  // 1 / 3
+    fp_result(64'h3FD5_5555_5555_5555, 0, 5'b00001, 5'd3);
+    issue_fp(0, 0, 64'hFFFF_FFFF_3F80_0000, 64'hFFFF_FFFF_4080_0000, 5'd4);  // 1f / 4f
+    fp_result(64'h0000_0000_3E80_0000, 1, 5'b00000, 5'd4);
+    issue_fp(1, 1, 64'h4010_0000_0000_0000, 64'h0, 5'd5);                    // sqrt(4)
+    check(fsqrt_busy && !fdiv_busy, "FSQRT busy after issue");
+    fp_result(64'h4000_0000_0000_0000, 0, 5'b00000, 5'd5);
+    issue_fp(1, 1, 64'hBFF0_0000_0000_0000, 64'h0, 5'd6);                    // sqrt(-1)
+    fp_result(64'h7FF8_0000_0000_0000, 0, 5'b10000, 5'd6);
+    if (errors == 0)
+      $display("PASS: FDIV/FSQRT results and flags");
+
+    // FDIV, FSQRT and a divide in flight together; no grants until all are done
+    issue_fp(1, 1, 64'h4022_0000_0000_0000, 64'h0, 5'd10);                   // sqrt(9)
+    issue_fp(0, 1, 64'h4024_0000_0000_0000, 64'h4014_0000_0000_0000, 5'd11); // 10 / 5
+    issue_div(2'b00, 32'd81, 32'd9, 5'd12);
+    check(fdiv_busy && fsqrt_busy && int_busy, "All three units busy");
+    for (i = 0; i < 150; i = i + 1)
+      @(negedge clk);
+    check(fp_wb_valid && fp_wb_rd == 5'd11, "FDIV completes before FSQRT");
+    fp_result(64'h4000_0000_0000_0000, 0, 5'b00000, 5'd11);
+    check(!fdiv_busy && fsqrt_busy, "FSQRT still waiting after FDIV grant");
+    fp_result(64'h4008_0000_0000_0000, 0, 5'b00000, 5'd10);
+    check(!fdiv_busy && !fsqrt_busy, "FP units free");
+    int_result(32'd9, 5'd12);
+    if (errors == 0)
+      $display("PASS: Concurrent long ops complete out of order");
+
+    // Summary
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed: %0d", tests - errors);
+    $display("Failed: %0d", errors);
+
+    if (errors == 0) begin
+      $display("");
+      $display("All tests PASSED!");
+      $display("");
+    end else begin
+      $display("");
+      $display("Some tests FAILED!");
+      $display("");
+    end
+
+    $finish;
+  end
+
+endmodule
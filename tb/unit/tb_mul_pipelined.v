@@ -0,0 +1,246 @@
+// tb_mul_pipelined.v - Testbench for mul_pipelined module
+// Checks MUL/MULH/MULHSU/MULHU against a reference product for 1, 2 and 3
+// stage RV32 instances and a 2-stage RV64 instance (including MULW), then
+// checks back-to-back issue and stage-1 hold behaviour
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns/1ps
+
+module tb_mul_pipelined;
+
+  reg         clk;
+  reg         reset_n;
+  reg         stage1_en;
+  reg  [1:0]  mul_op;
+  reg         is_word_op;
+  reg  [63:0] op_a;
+  reg  [63:0] op_b;
+
+  wire [31:0] result_s1;
+  wire [31:0] result_s2;
+  wire [31:0] result_s3;
+  wire [63:0] result_64;
+
+  integer errors = 0;
+  integer tests = 0;
+  integer i, j;
+
+  mul_pipelined #(.XLEN(32), .STAGES(1)) DUT1 (
+    .clk(clk), .reset_n(reset_n), .stage1_en(stage1_en),
+    .mul_op(mul_op), .is_word_op(1'b0),
+    .operand_a(op_a[31:0]), .operand_b(op_b[31:0]),
+    .result(result_s1)
+  );
+
+  mul_pipelined #(.XLEN(32), .STAGES(2)) DUT2 (
+    .clk(clk), .reset_n(reset_n), .stage1_en(stage1_en),
+    .mul_op(mul_op), .is_word_op(1'b0),
+    .operand_a(op_a[31:0]), .operand_b(op_b[31:0]),
+    .result(result_s2)
+  );
+
+  mul_pipelined #(.XLEN(32), .STAGES(3)) DUT3 (
+    .clk(clk), .reset_n(reset_n), .stage1_en(stage1_en),
+    .mul_op(mul_op), .is_word_op(1'b0),
+    .operand_a(op_a[31:0]), .operand_b(op_b[31:0]),
+    .result(result_s3)
+  );
+
+  mul_pipelined #(.XLEN(64), .STAGES(2)) DUT64 (
+    .clk(clk), .reset_n(reset_n), .stage1_en(stage1_en),
+    .mul_op(mul_op), .is_word_op(is_word_op),
+    .operand_a(op_a), .operand_b(op_b),
+    .result(result_64)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  // Reference results: extend both operands per signedness and keep the
+  // double-width product modulo 2^(2*XLEN)
+  function [31:0] ref32;
+    input [1:0]  op;
+    input [31:0] a;
+    input [31:0] b;
+    reg   [63:0] ae, be, p;
+    begin
+      ae = (op == 2'b01 || op == 2'b10) ? {{32{a[31]}}, a} : {32'h0, a};
+      be = (op == 2'b01) ? {{32{b[31]}}, b} : {32'h0, b};
+      p  = ae * be;
+      ref32 = (op == 2'b00) ? p[31:0] : p[63:32];
+    end
+  endfunction
+
+  function [63:0] ref64;
+    input [1:0]  op;
+    input        word;
+    input [63:0] a;
+    input [63:0] b;
+    reg   [127:0] ae, be, p;
+    begin
+      ae = (op == 2'b01 || op == 2'b10) ? {{64{a[63]}}, a} : {64'h0, a};
+      be = (op == 2'b01) ? {{64{b[63]}}, b} : {64'h0, b};
+      p  = ae * be;
+      if (word)
+        ref64 = {{32{p[31]}}, p[31:0]};
+      else
+        ref64 = (op == 2'b00) ? p[63:0] : p[127:64];
+    end
+  endfunction
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        $display("  op=%b a=0x%016h b=0x%016h", mul_op, op_a, op_b);
+        errors = errors + 1;
+      end
+    end
+  endtask
+
+  // Apply one multiply in "EX" and check each instance in its result stage
+  task mul_check;
+    input [1:0]  op;
+    input        word;
+    input [63:0] a;
+    input [63:0] b;
+    reg   [31:0] exp32;
+    reg   [63:0] exp64;
+    begin
+      @(negedge clk);
+      mul_op     = op;
+      is_word_op = word;
+      op_a       = a;
+      op_b       = b;
+      exp32 = ref32(op, a[31:0], b[31:0]);
+      exp64 = ref64(op, word, a, b);
+      #1;
+      if (!word)
+        check(result_s1 == exp32, "1-stage result in EX");
+      @(negedge clk);
+      // Next instruction in EX must not disturb the product in flight
+      op_a = ~a;
+      op_b = b ^ 64'h5A5A_5A5A_5A5A_5A5A;
+      #1;
+      if (!word)
+        check(result_s2 == exp32, "2-stage result in MEM");
+      check(result_64 == exp64, "RV64 2-stage result in MEM");
+      @(negedge clk);
+      #1;
+      if (!word)
+        check(result_s3 == exp32, "3-stage result in WB");
+    end
+  endtask
+
+  reg [63:0] vec [0:11];
+  reg [31:0] stream_exp [0:7];
+  reg [31:0] held;
+
+  initial begin
+    $dumpfile("sim/waves/mul_pipelined.vcd");
+    $dumpvars(0, tb_mul_pipelined);
+
+    stage1_en  = 1;
+    mul_op     = 2'b00;
+    is_word_op = 0;
+    op_a       = 0;
+    op_b       = 0;
+    reset_n    = 0;
+    #20;
+    reset_n = 1;
+
+    $display("=== Pipelined Multiplier Tests ===");
+
+    // Corner operands: zero, one, -1, most negative/positive, mixed patterns
+    vec[0]  = 64'h0000_0000_0000_0000;
+    vec[1]  = 64'h0000_0000_0000_0001;
+    vec[2]  = 64'hFFFF_FFFF_FFFF_FFFF;
+    vec[3]  = 64'h8000_0000_0000_0000;
+    vec[4]  = 64'h7FFF_FFFF_FFFF_FFFF;
+    vec[5]  = 64'h0000_0000_8000_0000;
+    vec[6]  = 64'h0000_0000_7FFF_FFFF;
+    vec[7]  = 64'h1234_5678_9ABC_DEF0;
+    vec[8]  = 64'hFEDC_BA98_7654_3210;
+    vec[9]  = 64'hAAAA_AAAA_5555_5555;
+    vec[10] = 64'h0000_0001_FFFF_FFFE;
+    vec[11] = 64'hDEAD_BEEF_CAFE_BABE;
+
+    for (i = 0; i < 12; i = i + 1)
+      for (j = 0; j < 12; j = j + 1) begin
+        mul_check(2'b00, 0, vec[i], vec[j]);
+        mul_check(2'b01, 0, vec[i], vec[j]);
+        mul_check(2'b10, 0, vec[i], vec[j]);
+        mul_check(2'b11, 0, vec[i], vec[j]);
+        mul_check(2'b00, 1, vec[i], vec[j]);
+      end
+
+    // Random operands
+    for (i = 0; i < 200; i = i + 1)
+      mul_check($random & 3, 0, {$random, $random}, {$random, $random});
+    for (i = 0; i < 50; i = i + 1)
+      mul_check(2'b00, 1, {$random, $random}, {$random, $random});
+
+    if (errors == 0)
+      $display("PASS: All ops match reference for 1/2/3 stages and RV64");
+
+    // Back-to-back: a new multiply every cycle, 3-stage results two cycles later
+    for (i = 0; i < 8; i = i + 1) begin
+      @(negedge clk);
+      mul_op = i[1:0];
+      op_a   = {$random, $random};
+      op_b   = {$random, $random};
+      stream_exp[i] = ref32(mul_op, op_a[31:0], op_b[31:0]);
+      #1;
+      if (i >= 2)
+        check(result_s3 == stream_exp[i-2], "Back-to-back 3-stage result");
+    end
+    if (errors == 0)
+      $display("PASS: Back-to-back multiplies complete one per cycle");
+
+    // Stage 1 hold (EX/MEM held): the 2-stage product stays put
+    @(negedge clk);
+    mul_op = 2'b00;
+    op_a   = 64'd1234;
+    op_b   = 64'd5678;
+    @(negedge clk);
+    held = result_s2;
+    stage1_en = 0;
+    op_a = 64'd99;
+    @(negedge clk);
+    @(negedge clk);
+    check(result_s2 == held && held == 32'd7006652, "Stage 1 holds while stage1_en low");
+    stage1_en = 1;
+    @(negedge clk);
+    check(result_s2 == 32'd562122, "Stage 1 resumes with new operands");
+    if (errors == 0)
+      $display("PASS: Stage 1 hold");
+
+    // Summary
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed: %0d", tests - errors);
+    $display("Failed: %0d", errors);
+
+    if (errors == 0) begin
+      $display("");
+      $display("All tests PASSED!");
+      $display("");
+    end else begin
+      $display("");
+      $display("Some tests FAILED!");
+      $display("");
+    end
+
+    $finish;
+  end
+
+endmodule
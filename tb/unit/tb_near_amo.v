@@ -0,0 +1,244 @@
+// tb_near_amo.v - Testbench for Near-Memory AMOs in dmem_bus_adapter
+// Drives the adapter like the core's bus port: stores, loads and AMO reads
+// (req_amo with the funct5 in req_amo_op and rs2 on req_wdata). Checks that
+// every AMO returns the old value in its second cycle and leaves
+// amo_alu(old, rs2) in memory, and that plain reads never write
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns / 1ps
+
+module tb_near_amo;
+
+  reg         clk;
+  reg         reset_n;
+
+  reg         req_valid;
+  reg  [31:0] req_addr;
+  reg  [63:0] req_wdata;
+  reg         req_we;
+  reg  [2:0]  req_size;
+  reg         req_amo;
+  reg  [4:0]  req_amo_op;
+  wire        req_ready;
+  wire [63:0] req_rdata;
+
+  localparam [4:0] AMO_ADD  = 5'b00000;
+  localparam [4:0] AMO_SWAP = 5'b00001;
+  localparam [4:0] AMO_XOR  = 5'b00100;
+  localparam [4:0] AMO_OR   = 5'b01000;
+  localparam [4:0] AMO_AND  = 5'b01100;
+  localparam [4:0] AMO_MIN  = 5'b10000;
+  localparam [4:0] AMO_MAX  = 5'b10100;
+  localparam [4:0] AMO_MINU = 5'b11000;
+  localparam [4:0] AMO_MAXU = 5'b11100;
+
+  integer errors = 0;
+  integer tests = 0;
+  integer cycles;
+  reg [31:0] old;
+  reg [31:0] val;
+
+  dmem_bus_adapter #(
+    .XLEN(32),
+    .FLEN(64),
+    .MEM_SIZE(4096)
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .req_valid(req_valid),
+    .req_addr(req_addr),
+    .req_wdata(req_wdata),
+    .req_we(req_we),
+    .req_size(req_size),
+    .req_amo(req_amo),
+    .req_amo_op(req_amo_op),
+    .req_ready(req_ready),
+    .req_rdata(req_rdata)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %s", name);
+      end
+    end
+  endtask
+
+  // One bus transaction, request held until ready (as the core does);
+  // returns the low word of the read data and the cycles it took
+  task access;
+    input  [31:0] addr;
+    input  [31:0] wdata;
+    input         we;
+    input         amo;
+    input  [4:0]  op;
+    output [31:0] rdata;
+    begin
+      @(negedge clk);
+      req_valid  = 1'b1;
+      req_addr   = addr;
+      req_wdata  = {32'h0, wdata};
+      req_we     = we;
+      req_size   = 3'b010;
+      req_amo    = amo;
+      req_amo_op = op;
+      cycles     = 1;
+      #1;
+      while (!req_ready) begin
+        @(negedge clk);
+        cycles = cycles + 1;
+        #1;
+      end
+      rdata = req_rdata[31:0];
+      @(posedge clk);
+      #1;
+      req_valid = 1'b0;
+      req_we    = 1'b0;
+      req_amo   = 1'b0;
+    end
+  endtask
+
+  task store;
+    input [31:0] addr;
+    input [31:0] data;
+    reg   [31:0] unused;
+    begin
+      access(addr, data, 1'b1, 1'b0, 5'd0, unused);
+    end
+  endtask
+
+  task load;
+    input  [31:0] addr;
+    output [31:0] data;
+    begin
+      access(addr, 32'hDEAD_BEEF, 1'b0, 1'b0, 5'd0, data);
+    end
+  endtask
+
+  // AMO at addr with initial memory value init; returns old and new value
+  task amo_test;
+    input  [4:0]  op;
+    input  [31:0] init;
+    input  [31:0] src;
+    output [31:0] old_val;
+    output [31:0] new_val;
+    begin
+      store(32'h8000_0100, init);
+      access(32'h8000_0100, src, 1'b0, 1'b1, op, old_val);
+      load(32'h8000_0100, new_val);
+    end
+  endtask
+
+  initial begin
+    $display("========================================");
+    $display("Near-Memory AMO Testbench");
+    $display("========================================");
+
+    reset_n    = 0;
+    req_valid  = 0;
+    req_addr   = 0;
+    req_wdata  = 0;
+    req_we     = 0;
+    req_size   = 3'b010;
+    req_amo    = 0;
+    req_amo_op = 0;
+    repeat (3) @(posedge clk);
+    reset_n = 1;
+    repeat (2) @(posedge clk);
+
+    //------------------------------------------------------------------------
+    // Test 1: timing - an AMO costs the same two cycles as a load
+    //------------------------------------------------------------------------
+    $display("\n--- Test 1: Timing ---");
+    store(32'h8000_0100, 32'd5);
+    access(32'h8000_0100, 32'd3, 1'b0, 1'b1, AMO_ADD, old);
+    check(cycles == 2, "AMO ready in its second cycle");
+    check(old == 32'd5, "AMOADD returns the old value");
+    load(32'h8000_0100, val);
+    check(val == 32'd8, "AMOADD result written");
+
+    //------------------------------------------------------------------------
+    // Test 2: arithmetic and logical operations
+    //------------------------------------------------------------------------
+    $display("\n--- Test 2: Operations ---");
+    amo_test(AMO_SWAP, 32'h1111_1111, 32'h2222_2222, old, val);
+    check(old == 32'h1111_1111 && val == 32'h2222_2222, "AMOSWAP");
+    amo_test(AMO_ADD, 32'hFFFF_FFFF, 32'd2, old, val);
+    check(old == 32'hFFFF_FFFF && val == 32'd1, "AMOADD wraps");
+    amo_test(AMO_XOR, 32'hF0F0_00FF, 32'h0FF0_0F0F, old, val);
+    check(val == 32'hFF00_0FF0, "AMOXOR");
+    amo_test(AMO_AND, 32'hF0F0_00FF, 32'h0FF0_0F0F, old, val);
+    check(val == 32'h00F0_000F, "AMOAND");
+    amo_test(AMO_OR, 32'hF0F0_00FF, 32'h0FF0_0F0F, old, val);
+    check(val == 32'hFFF0_0FFF, "AMOOR");
+
+    //------------------------------------------------------------------------
+    // Test 3: signed and unsigned min/max
+    //------------------------------------------------------------------------
+    $display("\n--- Test 3: Min/Max ---");
+    amo_test(AMO_MIN, 32'hFFFF_FFFE, 32'd1, old, val);
+    check(val == 32'hFFFF_FFFE, "AMOMIN keeps -2 against 1");
+    amo_test(AMO_MAX, 32'hFFFF_FFFE, 32'd1, old, val);
+    check(val == 32'd1, "AMOMAX takes 1 against -2");
+    amo_test(AMO_MINU, 32'hFFFF_FFFE, 32'd1, old, val);
+    check(val == 32'd1, "AMOMINU takes 1 against 0xFFFFFFFE");
+    amo_test(AMO_MAXU, 32'hFFFF_FFFE, 32'd1, old, val);
+    check(val == 32'hFFFF_FFFE, "AMOMAXU keeps 0xFFFFFFFE");
+
+    //------------------------------------------------------------------------
+    // Test 4: back-to-back AMOs and neighbouring words
+    //------------------------------------------------------------------------
+    $display("\n--- Test 4: Back-to-back ---");
+    store(32'h8000_0200, 32'd0);
+    store(32'h8000_0204, 32'h5555_5555);
+    access(32'h8000_0200, 32'd1, 1'b0, 1'b1, AMO_ADD, old);
+    access(32'h8000_0200, 32'd1, 1'b0, 1'b1, AMO_ADD, val);
+    check(old == 32'd0 && val == 32'd1, "Second AMO sees the first one's result");
+    load(32'h8000_0200, val);
+    check(val == 32'd2, "Two increments");
+    load(32'h8000_0204, val);
+    check(val == 32'h5555_5555, "Next word untouched");
+
+    //------------------------------------------------------------------------
+    // Test 5: plain reads never write
+    //------------------------------------------------------------------------
+    $display("\n--- Test 5: Plain read ---");
+    load(32'h8000_0204, val);
+    load(32'h8000_0204, val);
+    check(val == 32'h5555_5555, "Read with write data present leaves memory unchanged");
+
+    //------------------------------------------------------------------------
+    // Summary
+    //------------------------------------------------------------------------
+    $display("\n========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed:      %0d", tests - errors);
+    $display("Failed:      %0d", errors);
+    if (errors == 0)
+      $display("All tests PASSED!");
+    else
+      $display("Some tests FAILED!");
+    $finish;
+  end
+
+  initial begin
+    #100000;
+    $display("ERROR: Timeout");
+    $finish;
+  end
+
+endmodule
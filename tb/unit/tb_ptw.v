@@ -0,0 +1,290 @@
+// tb_ptw.v - Testbench for ptw module
+// Walks a small Sv32 page table and counts PTE reads: a cold walk reads two
+// PTEs, a walk through a cached non-leaf PTE (page-walk cache) reads one;
+// checks ASID tagging and SFENCE.VMA invalidation of the page-walk cache, and
+// the hardware A/D update write-back and its bus lock (rmw_lock)
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns/1ps
+
+module tb_ptw;
+
+  reg         clk;
+  reg         reset_n;
+
+  reg         req_valid;
+  reg  [31:0] req_vaddr;
+  reg         req_is_store;
+  wire        req_ready;
+  wire        req_page_fault;
+  wire [31:0] req_fault_vaddr;
+  wire        busy;
+  wire        rmw_lock;
+
+  wire        result_valid;
+  wire [31:0] result_vpn;
+  wire [31:0] result_ppn;
+  wire [7:0]  result_pte;
+  wire [31:0] result_level;
+
+  wire        mem_req_valid;
+  wire [31:0] mem_req_addr;
+  wire        mem_req_we;
+  wire [31:0] mem_req_wdata;
+
+  reg  [31:0] satp;
+  reg         flush_all;
+  reg         flush_vaddr;
+  reg         flush_asid;
+  reg  [15:0] flush_asid_value;
+
+  // Physical memory (64KB window, combinational like the PTW memory arbiter)
+  reg  [31:0] mem [0:16383];
+  wire [31:0] mem_resp_data = mem[mem_req_addr[15:2]];
+
+  integer errors = 0;
+  integer tests = 0;
+  integer i;
+  integer reads;
+  integer writes;
+  reg     prev_req;
+  reg     bus_released;
+  reg     unlocked;       // PTE access with rmw_lock low
+  reg     lock_idle;      // rmw_lock high with no PTE access
+  reg     got_fault;
+  reg [31:0] got_ppn;
+
+  // Sv32 tables: root at PPN 0x100, one level-0 table at PPN 0x101
+  localparam ROOT_PPN  = 22'h100;
+  localparam L0_PPN    = 22'h101;
+  localparam PTE_LEAF  = 10'h0CF;  // D A - - X W R V
+  localparam PTE_CLEAN = 10'h00F;  // - - - - X W R V (A=0, D=0)
+
+  ptw #(
+    .XLEN(32),
+    .PWC_ENTRIES(4),
+    .AD_UPDATE(1)
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .req_valid(req_valid),
+    .req_vaddr(req_vaddr),
+    .req_is_store(req_is_store),
+    .req_is_fetch(1'b0),
+    .req_ready(req_ready),
+    .req_page_fault(req_page_fault),
+    .req_fault_vaddr(req_fault_vaddr),
+    .busy(busy),
+    .rmw_lock(rmw_lock),
+    .result_valid(result_valid),
+    .result_vpn(result_vpn),
+    .result_ppn(result_ppn),
+    .result_pte(result_pte),
+    .result_level(result_level),
+    .mem_req_valid(mem_req_valid),
+    .mem_req_addr(mem_req_addr),
+    .mem_req_we(mem_req_we),
+    .mem_req_wdata(mem_req_wdata),
+    .mem_req_ready(mem_req_valid),
+    .mem_resp_data(mem_resp_data),
+    .mem_resp_valid(mem_req_valid),
+    .satp(satp),
+    .privilege_mode(2'b01),
+    .mstatus_sum(1'b0),
+    .mstatus_mxr(1'b0),
+    .flush_all(flush_all),
+    .flush_vaddr(flush_vaddr),
+    .flush_asid(flush_asid),
+    .flush_asid_value(flush_asid_value)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  // Count PTE reads and writes (each holds mem_req_valid for one cycle) and
+  // note whether the request dropped between a read and its write-back
+  always @(posedge clk) begin
+    if (mem_req_valid && !mem_req_we)
+      reads = reads + 1;
+    if (mem_req_valid && mem_req_we) begin
+      writes = writes + 1;
+      mem[mem_req_addr[15:2]] <= mem_req_wdata;
+      if (!prev_req)
+        bus_released = 1;
+    end
+    if (mem_req_valid && !rmw_lock)
+      unlocked = 1;
+    if (rmw_lock && !mem_req_valid)
+      lock_idle = 1;
+    prev_req <= mem_req_valid;
+  end
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        $display("  vaddr=0x%08h reads=%0d ppn=0x%06h fault=%b",
+                 req_vaddr, reads, got_ppn, got_fault);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %s", name);
+      end
+    end
+  endtask
+
+  // One page walk under the given ASID; leaves the PTE read count in `reads`
+  task walk;
+    input [8:0]  asid;
+    input [31:0] vaddr;
+    begin
+      @(negedge clk);
+      satp      = {1'b1, asid, ROOT_PPN};
+      reads     = 0;
+      writes    = 0;
+      got_fault = 0;
+      req_vaddr = vaddr;
+      req_valid = 1;
+      @(negedge clk);
+      req_valid = 0;
+      while (!req_ready) begin
+        @(negedge clk);
+      end
+      got_ppn   = result_ppn;
+      got_fault = req_page_fault;
+      @(negedge clk);
+    end
+  endtask
+
+  task sfence;
+    input        all;
+    input        by_addr;
+    input        by_asid;
+    input [15:0] a;
+    begin
+      @(negedge clk);
+      flush_all        = all;
+      flush_vaddr      = by_addr;
+      flush_asid       = by_asid;
+      flush_asid_value = a;
+      @(negedge clk);
+      flush_all   = 0;
+      flush_vaddr = 0;
+      flush_asid  = 0;
+    end
+  endtask
+
+  initial begin
+    $dumpfile("sim/waves/ptw.vcd");
+    $dumpvars(0, tb_ptw);
+
+    for (i = 0; i < 16384; i = i + 1)
+      mem[i] = 32'h0;
+    // Root entry for VPN[1] = 0x040 (VA 0x1000_0000-0x103F_FFFF) -> level-0 table
+    mem[(ROOT_PPN * 4096 + 32'h040 * 4) >> 2 & 14'h3FFF] = {L0_PPN, 10'h001};
+    // Level-0 entries for VPN[0] = 0..7 -> PPN 0x200 + i
+    for (i = 0; i < 8; i = i + 1)
+      mem[(L0_PPN * 4096 + i * 4) >> 2 & 14'h3FFF] = {22'h200 + i[21:0], PTE_LEAF};
+    // VPN[0] = 9, 10: A and D clear
+    for (i = 9; i < 11; i = i + 1)
+      mem[(L0_PPN * 4096 + i * 4) >> 2 & 14'h3FFF] = {22'h200 + i[21:0], PTE_CLEAN};
+
+    reset_n          = 0;
+    req_valid        = 0;
+    req_vaddr        = 0;
+    req_is_store     = 0;
+    satp             = 0;
+    flush_all        = 0;
+    flush_vaddr      = 0;
+    flush_asid       = 0;
+    flush_asid_value = 0;
+    reads            = 0;
+    writes           = 0;
+    prev_req         = 0;
+    bus_released     = 0;
+    unlocked         = 0;
+    lock_idle        = 0;
+    #20;
+    reset_n = 1;
+
+    $display("=== PTW Page-Walk Cache Tests ===");
+
+    walk(9'd1, 32'h1000_0000);
+    check(!got_fault && got_ppn == 32'h200 && reads == 2, "Cold walk reads both levels");
+    walk(9'd1, 32'h1000_3000);
+    check(!got_fault && got_ppn == 32'h203 && reads == 1, "Cached root entry: one PTE read");
+    walk(9'd2, 32'h1000_5000);
+    check(!got_fault && got_ppn == 32'h205 && reads == 2, "Other ASID walks from the root");
+    walk(9'd2, 32'h1000_6000);
+    check(reads == 1, "Second ASID now cached too");
+
+    // SFENCE.VMA x0, rs2: only that ASID's entries go
+    sfence(0, 0, 1, 16'd1);
+    walk(9'd1, 32'h1000_1000);
+    check(got_ppn == 32'h201 && reads == 2, "ASID flush invalidates that ASID");
+    walk(9'd2, 32'h1000_2000);
+    check(got_ppn == 32'h202 && reads == 1, "ASID flush keeps other ASIDs");
+
+    // SFENCE.VMA rs1, x0 and x0, x0: everything
+    sfence(0, 1, 0, 16'd0);
+    walk(9'd2, 32'h1000_4000);
+    check(reads == 2, "Address flush invalidates the page-walk cache");
+    sfence(1, 0, 0, 16'd0);
+    walk(9'd2, 32'h1000_7000);
+    check(got_ppn == 32'h207 && reads == 2, "Flush all invalidates the page-walk cache");
+
+    // Faulting leaf through a cached pointer: still one read, still faults
+    walk(9'd2, 32'h1000_8000);
+    check(got_fault && reads == 1, "Invalid leaf through cached pointer faults");
+
+    $display("=== PTW A/D Update Tests ===");
+
+    walk(9'd2, 32'h1000_0000);
+    check(!got_fault && writes == 0, "A and D already set: no write-back");
+
+    walk(9'd2, 32'h1000_9000);
+    check(!got_fault && writes == 1 && result_pte[6] && !result_pte[7] &&
+          mem[(L0_PPN * 4096 + 9 * 4) >> 2 & 14'h3FFF][7:0] == 8'h4F,
+          "Load sets A only");
+    req_is_store = 1;
+    walk(9'd2, 32'h1000_9000);
+    check(!got_fault && writes == 1 && result_pte[7] &&
+          mem[(L0_PPN * 4096 + 9 * 4) >> 2 & 14'h3FFF][7:0] == 8'hCF,
+          "Store to a clean page sets D");
+    walk(9'd2, 32'h1000_a000);
+    check(!got_fault && writes == 1 && reads == 1 &&
+          mem[(L0_PPN * 4096 + 10 * 4) >> 2 & 14'h3FFF] == {22'h20a, 10'h0CF},
+          "First store sets A and D in one write");
+    req_is_store = 0;
+    check(!bus_released, "Write-back follows the read without releasing the bus");
+    check(!unlocked, "rmw_lock held from each PTE read through the write-back");
+    check(!lock_idle && !rmw_lock, "rmw_lock low outside PTE accesses");
+
+    // Summary
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed: %0d", tests - errors);
+    $display("Failed: %0d", errors);
+
+    if (errors == 0) begin
+      $display("");
+      $display("All tests PASSED!");
+      $display("");
+    end else begin
+      $display("");
+      $display("Some tests FAILED!");
+      $display("");
+    end
+
+    $finish;
+  end
+
+endmodule
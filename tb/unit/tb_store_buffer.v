@@ -0,0 +1,296 @@
+// tb_store_buffer.v - Testbench for store_buffer module
+// Tests zero-wait store retirement, background drain, merging, store-to-load
+// forwarding, loads bypassing buffered stores, full-buffer back-pressure and
+// ordering of MMIO / atomic accesses
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns/1ps
+
+module tb_store_buffer;
+
+  reg         clk;
+  reg         reset_n;
+
+  reg         req_valid;
+  reg  [31:0] req_addr;
+  reg  [63:0] req_wdata;
+  reg         req_we;
+  reg  [2:0]  req_size;
+  reg         req_ordered;
+  wire        req_ready;
+  wire [63:0] req_rdata;
+  wire        drained;
+
+  wire        mem_req_valid;
+  wire [31:0] mem_req_addr;
+  wire [63:0] mem_req_wdata;
+  wire        mem_req_we;
+  wire [2:0]  mem_req_size;
+  wire        mem_req_ready;
+  wire [63:0] mem_req_rdata;
+
+  integer errors = 0;
+  integer tests = 0;
+  integer cycles;
+  integer writes_before;
+  integer i;
+  reg [63:0] rdata;
+
+  store_buffer #(
+    .XLEN(32),
+    .NUM_ENTRIES(4),
+    .BUFFER_BASE(32'h8000_0000),
+    .BUFFER_MASK(32'hFFF0_0000)
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .req_valid(req_valid),
+    .req_addr(req_addr),
+    .req_wdata(req_wdata),
+    .req_we(req_we),
+    .req_size(req_size),
+    .req_ordered(req_ordered),
+    .req_amo(1'b0),
+    .req_amo_op(5'd0),
+    .req_ready(req_ready),
+    .req_rdata(req_rdata),
+    .drained(drained),
+    .mem_req_valid(mem_req_valid),
+    .mem_req_addr(mem_req_addr),
+    .mem_req_wdata(mem_req_wdata),
+    .mem_req_we(mem_req_we),
+    .mem_req_size(mem_req_size),
+    .mem_req_amo(),
+    .mem_req_amo_op(),
+    .mem_req_ready(mem_req_ready),
+    .mem_req_rdata(mem_req_rdata)
+  );
+
+  // Backing memory: 4KB, writes latched on the first cycle (like the bus
+  // slaves), ready after slave_lat wait cycles
+  reg  [7:0]  mem [0:4095];
+  integer     slave_lat;
+  reg         slave_busy;
+  integer     slave_cnt;
+  integer     bus_writes;
+  integer     k;
+  wire [11:0] ma = mem_req_addr[11:0];
+
+  wire [63:0] mem_raw = {mem[ma + 7], mem[ma + 6], mem[ma + 5], mem[ma + 4],
+                         mem[ma + 3], mem[ma + 2], mem[ma + 1], mem[ma]};
+  assign mem_req_rdata = (mem_req_size == 3'b000) ? {{56{mem_raw[7]}}, mem_raw[7:0]} :
+                         (mem_req_size == 3'b001) ? {{48{mem_raw[15]}}, mem_raw[15:0]} :
+                         (mem_req_size == 3'b010) ? {{32{mem_raw[31]}}, mem_raw[31:0]} :
+                         (mem_req_size == 3'b100) ? {56'h0, mem_raw[7:0]} :
+                         (mem_req_size == 3'b101) ? {48'h0, mem_raw[15:0]} :
+                         (mem_req_size == 3'b110) ? {32'h0, mem_raw[31:0]} : mem_raw;
+  assign mem_req_ready = mem_req_valid && (slave_lat == 0 || (slave_busy && slave_cnt == 0));
+
+  always @(posedge clk) begin
+    if (mem_req_valid && mem_req_we) begin
+      for (k = 0; k < (1 << mem_req_size[1:0]); k = k + 1)
+        mem[ma + k] <= mem_req_wdata[k*8 +: 8];
+      bus_writes = bus_writes + 1;
+    end
+    if (mem_req_valid && !mem_req_ready) begin
+      if (!slave_busy) begin
+        slave_busy <= 1'b1;
+        slave_cnt  <= slave_lat - 1;
+      end else if (slave_cnt > 0) begin
+        slave_cnt <= slave_cnt - 1;
+      end
+    end else begin
+      slave_busy <= 1'b0;
+    end
+  end
+
+  function [31:0] mem_word;
+    input [31:0] addr;
+    begin
+      mem_word = {mem[addr[11:0] + 3], mem[addr[11:0] + 2], mem[addr[11:0] + 1], mem[addr[11:0]]};
+    end
+  endfunction
+
+  // Record whether any store was still buffered when the MMIO store went out
+  reg mmio_seen;
+  reg mmio_sb_busy;
+  always @(posedge clk) begin
+    if (mem_req_valid && mem_req_we && mem_req_addr == 32'h1000_0000) begin
+      mmio_seen = 1;
+      mmio_sb_busy = (DUT.count != 0);
+    end
+  end
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  // Issue one access the way the core does (store enable only on the first
+  // cycle, valid held until ready) and count the wait cycles
+  task access;
+    input        we;
+    input [31:0] addr;
+    input [63:0] wdata;
+    input [2:0]  size;
+    input        ordered;
+    begin
+      @(negedge clk);
+      req_valid   = 1;
+      req_we      = we;
+      req_addr    = addr;
+      req_wdata   = wdata;
+      req_size    = size;
+      req_ordered = ordered;
+      cycles      = 0;
+      #1;
+      while (!req_ready && cycles < 200) begin
+        @(negedge clk);
+        req_we = 0;
+        #1;
+        cycles = cycles + 1;
+      end
+      rdata = req_rdata;
+      @(posedge clk);
+      #1;
+      req_valid   = 0;
+      req_we      = 0;
+      req_ordered = 0;
+    end
+  endtask
+
+  task drain;
+    begin
+      while (!drained) @(negedge clk);
+      @(negedge clk);
+    end
+  endtask
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        $display("  addr=0x%08h rdata=0x%016h cycles=%0d count=%0d writes=%0d",
+                 req_addr, rdata, cycles, DUT.count, bus_writes);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %s", name);
+      end
+    end
+  endtask
+
+  initial begin
+    $dumpfile("sim/waves/store_buffer.vcd");
+    $dumpvars(0, tb_store_buffer);
+
+    for (i = 0; i < 4096; i = i + 1)
+      mem[i] = i[7:0] ^ {i[11:8], 4'h0};
+
+    req_valid = 0;
+    req_we = 0;
+    req_addr = 0;
+    req_wdata = 0;
+    req_size = 3'b010;
+    req_ordered = 0;
+    slave_lat = 0;
+    slave_busy = 0;
+    slave_cnt = 0;
+    bus_writes = 0;
+    mmio_seen = 0;
+    mmio_sb_busy = 0;
+    reset_n = 0;
+    #20;
+    reset_n = 1;
+
+    $display("=== Store Buffer Tests ===");
+
+    // Store retires immediately and drains in the background
+    access(1, 32'h8000_0100, 32'h1111_2222, 3'b010, 0);
+    check(cycles == 0 && !drained, "Store accepted without wait");
+    drain;
+    check(mem_word(32'h100) == 32'h1111_2222, "Buffered store drained to memory");
+
+    // Slow bus from here on: stores pile up in the buffer
+    slave_lat = 3;
+    writes_before = bus_writes;
+    access(1, 32'h8000_0200, 32'hAAAA_AAAA, 3'b010, 0);
+    access(1, 32'h8000_0204, 32'hBBBB_BBBB, 3'b010, 0);
+    access(1, 32'h8000_0200, 32'hCCCC_CCCC, 3'b010, 0);
+    check(cycles == 0, "Stores accepted while bus is slow");
+    check(DUT.count == 2, "Third store merged into buffered doubleword");
+
+    // Forwarding: 0x204 is only in the merged entry; 0x200 is also in the
+    // head entry being drained, so that load waits for the head to retire
+    access(0, 32'h8000_0204, 0, 3'b010, 0);
+    check(rdata[31:0] == 32'hBBBB_BBBB && cycles == 0, "Load forwarded from buffer");
+    access(0, 32'h8000_0200, 0, 3'b010, 0);
+    check(rdata[31:0] == 32'hCCCC_CCCC && cycles > 0, "Load waits for older overlapping store");
+    drain;
+    check(mem_word(32'h200) == 32'hCCCC_CCCC && mem_word(32'h204) == 32'hBBBB_BBBB,
+          "Merged entry drained");
+    check(bus_writes == writes_before + 2, "Three stores drained as two bus writes");
+
+    // Sub-word forwarding with sign extension
+    access(1, 32'h8000_0300, 32'h0000_0000, 3'b010, 0);
+    access(1, 32'h8000_0308, 32'h0000_0000, 3'b010, 0);
+    access(1, 32'h8000_0309, 32'h0000_0080, 3'b000, 0);
+    access(0, 32'h8000_0309, 0, 3'b000, 0);
+    check(rdata[31:0] == 32'hFFFF_FF80, "Byte load forwarded and sign-extended");
+    access(0, 32'h8000_0308, 0, 3'b101, 0);
+    check(rdata[31:0] == 32'h0000_8000, "Halfword load forwarded and zero-extended");
+
+    // Load to an address not in the buffer goes ahead of buffered stores
+    drain;
+    access(1, 32'h8000_0400, 32'h4444_4444, 3'b010, 0);
+    access(1, 32'h8000_0410, 32'h5555_5555, 3'b010, 0);
+    access(1, 32'h8000_0420, 32'h6666_6666, 3'b010, 0);
+    access(0, 32'h8000_0500, 0, 3'b010, 0);
+    check(rdata[31:0] == mem_word(32'h500) && DUT.count != 0, "Load bypasses buffered stores");
+
+    // Full buffer back-pressures the next store
+    access(1, 32'h8000_0430, 32'h7777_7777, 3'b010, 0);
+    access(1, 32'h8000_0440, 32'h8888_8888, 3'b010, 0);
+    access(1, 32'h8000_0450, 32'h9999_9999, 3'b010, 0);
+    check(cycles > 0, "Store waits when buffer is full");
+    drain;
+    check(mem_word(32'h420) == 32'h6666_6666 && mem_word(32'h450) == 32'h9999_9999,
+          "All stores drained after back-pressure");
+
+    // MMIO store is not buffered and goes out after older stores
+    access(1, 32'h8000_0600, 32'h1234_5678, 3'b010, 0);
+    access(1, 32'h1000_0000, 32'h0000_0041, 3'b000, 0);
+    check(mmio_seen && !mmio_sb_busy, "MMIO store ordered after buffered stores");
+    check(drained, "MMIO store left buffer empty");
+
+    // Atomic access waits for the buffer and sees memory, not the buffer
+    access(1, 32'h8000_0700, 32'hFEED_F00D, 3'b010, 0);
+    access(0, 32'h8000_0700, 0, 3'b010, 1);
+    check(rdata[31:0] == 32'hFEED_F00D && cycles > 0 && drained, "Atomic load ordered after store");
+
+    // Summary
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed: %0d", tests - errors);
+    $display("Failed: %0d", errors);
+
+    if (errors == 0) begin
+      $display("");
+      $display("All tests PASSED!");
+      $display("");
+    end else begin
+      $display("");
+      $display("Some tests FAILED!");
+      $display("");
+    end
+
+    $finish;
+  end
+
+endmodule
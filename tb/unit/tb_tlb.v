@@ -0,0 +1,293 @@
+// tb_tlb.v - Testbench for tlb module
+// Checks ASID tagging: per-ASID entries for the same VPN, global (PTE.G)
+// entries visible to every ASID, and the SFENCE.VMA flush variants
+// (all, by address, by ASID, by address and ASID); megapage matching and
+// pseudo-LRU replacement
+// Author: RV1 Project
+// Date: 2026-10-16
+
+`timescale 1ns/1ps
+
+module tb_tlb;
+
+  reg         clk;
+  reg         reset_n;
+
+  reg  [31:0] lookup_vaddr;
+  reg         lookup_is_store;
+  wire        lookup_hit;
+  wire [31:0] lookup_paddr;
+  wire        lookup_page_fault;
+
+  reg         update_valid;
+  reg  [31:0] update_vpn;
+  reg  [31:0] update_ppn;
+  reg  [7:0]  update_pte;
+  reg  [31:0] update_level;
+
+  reg  [15:0] asid;
+  reg         flush_all;
+  reg         flush_vaddr;
+  reg  [31:0] flush_addr;
+  reg         flush_asid;
+  reg  [15:0] flush_asid_value;
+
+  integer errors = 0;
+  integer tests = 0;
+  integer i, hits;
+
+  // PTE flags {D,A,G,U,X,W,R,V}
+  localparam PTE_RW     = 8'hC7;  // D A - - - W R V
+  localparam PTE_RX_G   = 8'h6B;  // - A G - X - R V
+
+  tlb #(
+    .XLEN(32),
+    .TLB_ENTRIES(8)
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .lookup_valid(1'b1),
+    .lookup_vaddr(lookup_vaddr),
+    .lookup_is_store(lookup_is_store),
+    .lookup_is_fetch(1'b0),
+    .lookup_hit(lookup_hit),
+    .lookup_paddr(lookup_paddr),
+    .lookup_page_fault(lookup_page_fault),
+    .update_valid(update_valid),
+    .update_vpn(update_vpn),
+    .update_ppn(update_ppn),
+    .update_pte(update_pte),
+    .update_level(update_level),
+    .privilege_mode(2'b01),
+    .mstatus_sum(1'b0),
+    .mstatus_mxr(1'b0),
+    .translation_enabled(1'b1),
+    .asid(asid),
+    .flush_all(flush_all),
+    .flush_vaddr(flush_vaddr),
+    .flush_addr(flush_addr),
+    .flush_asid(flush_asid),
+    .flush_asid_value(flush_asid_value)
+  );
+
+  initial begin
+    clk = 0;
+    forever #5 clk = ~clk;
+  end
+
+  task check;
+    input        cond;
+    input [80*8:1] name;
+    begin
+      tests = tests + 1;
+      if (!cond) begin
+        $display("FAIL: %s", name);
+        $display("  asid=%0d vaddr=0x%08h hit=%b paddr=0x%08h fault=%b",
+                 asid, lookup_vaddr, lookup_hit, lookup_paddr, lookup_page_fault);
+        errors = errors + 1;
+      end else begin
+        $display("PASS: %s", name);
+      end
+    end
+  endtask
+
+  // Walk result for the current ASID
+  task fill;
+    input [15:0] a;
+    input [19:0] vpn;
+    input [19:0] ppn;
+    input [7:0]  pte;
+    begin
+      @(negedge clk);
+      asid         = a;
+      update_valid = 1;
+      update_vpn   = {12'h0, vpn};
+      update_ppn   = {12'h0, ppn};
+      update_pte   = pte;
+      @(negedge clk);
+      update_valid = 0;
+    end
+  endtask
+
+  // One-cycle SFENCE.VMA
+  task sfence;
+    input        all;
+    input        by_addr;
+    input [31:0] addr;
+    input        by_asid;
+    input [15:0] a;
+    begin
+      @(negedge clk);
+      flush_all        = all;
+      flush_vaddr      = by_addr;
+      flush_addr       = addr;
+      flush_asid       = by_asid;
+      flush_asid_value = a;
+      @(negedge clk);
+      flush_all   = 0;
+      flush_vaddr = 0;
+      flush_asid  = 0;
+    end
+  endtask
+
+  task lookup;
+    input [15:0] a;
+    input [31:0] vaddr;
+    begin
+      asid         = a;
+      lookup_vaddr = vaddr;
+      #1;
+    end
+  endtask
+
+  initial begin
+    $dumpfile("sim/waves/tlb.vcd");
+    $dumpvars(0, tb_tlb);
+
+    reset_n          = 0;
+    lookup_vaddr     = 0;
+    lookup_is_store  = 0;
+    update_valid     = 0;
+    update_vpn       = 0;
+    update_ppn       = 0;
+    update_pte       = 0;
+    update_level     = 0;
+    asid             = 0;
+    flush_all        = 0;
+    flush_vaddr      = 0;
+    flush_addr       = 0;
+    flush_asid       = 0;
+    flush_asid_value = 0;
+    #20;
+    reset_n = 1;
+
+    $display("=== TLB ASID Tests ===");
+
+    // Same VPN in two address spaces, plus a global kernel page
+    fill(16'd1, 20'h10000, 20'h80100, PTE_RW);
+    fill(16'd2, 20'h10000, 20'h80300, PTE_RW);
+    fill(16'd1, 20'h20000, 20'h80200, PTE_RX_G);
+
+    lookup(16'd1, 32'h1000_0123);
+    check(lookup_hit && lookup_paddr == 32'h8010_0123, "ASID 1 sees its own mapping");
+    lookup(16'd2, 32'h1000_0123);
+    check(lookup_hit && lookup_paddr == 32'h8030_0123, "ASID 2 sees its own mapping");
+    lookup(16'd3, 32'h1000_0123);
+    check(!lookup_hit, "Unknown ASID misses");
+    lookup(16'd3, 32'h2000_0456);
+    check(lookup_hit && lookup_paddr == 32'h8020_0456, "Global entry matches any ASID");
+
+    // SFENCE.VMA x0, rs2: only ASID 2's non-global entries go
+    sfence(0, 0, 32'h0, 1, 16'd2);
+    lookup(16'd2, 32'h1000_0123);
+    check(!lookup_hit, "ASID flush removes that address space");
+    lookup(16'd1, 32'h1000_0123);
+    check(lookup_hit && lookup_paddr == 32'h8010_0123, "ASID flush keeps other address spaces");
+    lookup(16'd2, 32'h2000_0000);
+    check(lookup_hit, "ASID flush keeps global entries");
+
+    // SFENCE.VMA rs1, rs2: one page of one ASID, globals kept
+    fill(16'd2, 20'h10000, 20'h80300, PTE_RW);
+    sfence(0, 1, 32'h1000_0000, 1, 16'd1);
+    lookup(16'd1, 32'h1000_0123);
+    check(!lookup_hit, "Address+ASID flush removes the page");
+    lookup(16'd2, 32'h1000_0123);
+    check(lookup_hit, "Address+ASID flush keeps the page in other ASIDs");
+    sfence(0, 1, 32'h2000_0000, 1, 16'd1);
+    lookup(16'd1, 32'h2000_0000);
+    check(lookup_hit, "Address+ASID flush keeps a global page");
+
+    // SFENCE.VMA rs1, x0: the page in every ASID, including global
+    sfence(0, 1, 32'h2000_0000, 0, 16'd0);
+    lookup(16'd1, 32'h2000_0000);
+    check(!lookup_hit, "Address flush removes a global page");
+    lookup(16'd2, 32'h1000_0123);
+    check(lookup_hit, "Address flush leaves other pages");
+
+    // SFENCE.VMA x0, x0: everything
+    fill(16'd1, 20'h20000, 20'h80200, PTE_RX_G);
+    sfence(1, 0, 32'h0, 0, 16'd0);
+    lookup(16'd1, 32'h2000_0000);
+    check(!lookup_hit, "Flush all removes global entries");
+    lookup(16'd2, 32'h1000_0123);
+    check(!lookup_hit, "Flush all removes per-ASID entries");
+
+    // Permission checks still apply to an ASID hit
+    fill(16'd4, 20'h30000, 20'h80400, PTE_RX_G);
+    lookup(16'd4, 32'h3000_0010);
+    lookup_is_store = 1;
+    #1;
+    check(lookup_hit && lookup_page_fault, "Store to read-only global page faults");
+    lookup_is_store = 0;
+
+    $display("=== TLB Superpage Tests ===");
+
+    // 4MB megapage: one entry covers every 4KB page inside it
+    sfence(1, 0, 32'h0, 0, 16'd0);
+    update_level = 32'd1;
+    fill(16'd1, 20'h50000, 20'h80400, PTE_RW);
+    update_level = 32'd0;
+    lookup(16'd1, 32'h5012_3456);
+    check(lookup_hit && lookup_paddr == 32'h8052_3456, "Megapage hit inside the page");
+    lookup(16'd1, 32'h503f_fffc);
+    check(lookup_hit && lookup_paddr == 32'h807f_fffc, "Megapage hit at its last word");
+    lookup(16'd1, 32'h5040_0000);
+    check(!lookup_hit, "Next megapage misses");
+    sfence(0, 1, 32'h5010_0000, 0, 16'd0);
+    lookup(16'd1, 32'h5000_0000);
+    check(!lookup_hit, "Address flush inside a megapage removes it");
+
+    $display("=== TLB Replacement Tests ===");
+
+    // Fill every entry, keep hitting the first page, then replace one
+    lookup(16'd1, 32'h7000_0000);
+    for (i = 0; i < 8; i = i + 1)
+      fill(16'd1, 20'h60000 + i, 20'h90000 + i, PTE_RW);
+    lookup(16'd1, 32'h6000_0000);
+    fill(16'd1, 20'h60008, 20'h90008, PTE_RW);
+    lookup(16'd1, 32'h6000_8000);
+    check(lookup_hit && lookup_paddr == 32'h9000_8000, "New page replaces an entry");
+    lookup(16'd1, 32'h6000_0000);
+    check(lookup_hit, "Recently hit entry survives replacement");
+    hits = 0;
+    for (i = 1; i < 8; i = i + 1) begin
+      lookup(16'd1, 32'h6000_0000 + (i << 12));
+      if (lookup_hit) hits = hits + 1;
+    end
+    check(hits == 6, "Exactly one other entry replaced");
+
+    // An invalidated entry is refilled before any valid one is replaced
+    lookup(16'd1, 32'h7000_0000);
+    sfence(0, 1, 32'h6000_3000, 0, 16'd0);
+    fill(16'd1, 20'h60010, 20'h90010, PTE_RW);
+    hits = 0;
+    for (i = 0; i < 9; i = i + 1) begin
+      lookup(16'd1, 32'h6000_0000 + (i << 12));
+      if (lookup_hit) hits = hits + 1;
+    end
+    lookup(16'd1, 32'h6001_0000);
+    check(lookup_hit && hits == 7, "Invalid entry filled first");
+
+    // Summary
+    $display("");
+    $display("========================================");
+    $display("Test Summary");
+    $display("========================================");
+    $display("Total tests: %0d", tests);
+    $display("Passed: %0d", tests - errors);
+    $display("Failed: %0d", errors);
+
+    if (errors == 0) begin
+      $display("");
+      $display("All tests PASSED!");
+      $display("");
+    end else begin
+      $display("");
+      $display("Some tests FAILED!");
+      $display("");
+    end
+
+    $finish;
+  end
+
+endmodule
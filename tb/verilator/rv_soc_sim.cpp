@@ -0,0 +1,438 @@
+// rv_soc_sim.cpp - Verilator C++ simulator for rv_soc (top: rv_soc_sim.v)
+// Runs one program image to completion and reports pass/fail and performance
+// Author: RV1 Project
+// Date: 2026-10-16
+//
+// Features:
+// - Loads ELF32/ELF64 (PT_LOAD segments, tohost from the symbol table) or .hex
+//   images at run time; the memories pull the segments over DPI-C in their
+//   initial blocks (RV_DPI_IMAGE), so one build runs every test and no hex
+//   files are written
+// - Stops on a tohost write (riscv-tests), a write to the 0x80002100 test
+//   marker, EBREAK with the x28 marker, ECALL with gp (--compliance, same
+//   convention as tb_core_pipelined.v), or --max-cycles
+// - UART TX bytes are streamed to stdout as they are sent
+// - Reports cycles, instructions retired (minstret), IPC and simulated MHz
+//
+// Usage: rv_soc_sim [options] <image.elf|image.hex> [+plusargs...]
+//   --max-cycles=N   Timeout in cycles (default 1000000)
+//   --tohost=ADDR    tohost address (default: the ELF 'tohost' symbol)
+//   --compliance     Also stop on ECALL and judge by gp
+//   --quiet          Only print the result block
+//
+// Exit status: 0 pass, 1 fail, 2 timeout, 3 usage/load error
+
+#include <verilated.h>
+#include "Vrv_soc_sim.h"
+#include "Vrv_soc_sim__Dpi.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+// simple_bus DMEM window (rv_soc.v address map)
+static const uint64_t DMEM_BASE = 0x80000000ULL;
+static const uint64_t DMEM_MASK = 0xFFF00000ULL;
+static const uint64_t DMEM_END  = DMEM_BASE + (~DMEM_MASK & 0xFFFFFFFFULL) + 1;
+
+// Completion conventions of tb_core_pipelined.v
+static const uint64_t MARKER_ADDR   = 0x80002100ULL;
+static const uint32_t INSTR_ECALL   = 0x00000073;
+static const uint32_t INSTR_EBREAK  = 0x00100073;
+static const uint32_t INSTR_CEBREAK = 0x00009002;
+
+enum ExitCode { EXIT_PASS = 0, EXIT_FAIL = 1, EXIT_TIMEOUT = 2, EXIT_ERROR = 3 };
+
+struct Segment {
+    uint64_t addr;
+    std::vector<uint8_t> data;  // memsz bytes (bss zero-filled)
+};
+
+struct Image {
+    std::vector<Segment> segments;
+    bool     has_tohost = false;
+    uint64_t tohost = 0;
+    uint64_t entry = 0;
+};
+
+//------------------------------------------------------------------------------
+// ELF loading
+//------------------------------------------------------------------------------
+
+template <typename T>
+static T rd(const std::vector<uint8_t>& f, uint64_t off) {
+    T v = 0;
+    if (off + sizeof(T) <= f.size())
+        std::memcpy(&v, &f[off], sizeof(T));  // Host and target are little-endian
+    return v;
+}
+
+static bool load_elf(const std::vector<uint8_t>& f, Image& img, std::string& err) {
+    if (f.size() < 52 || std::memcmp(f.data(), "\x7f" "ELF", 4) != 0) {
+        err = "not an ELF file";
+        return false;
+    }
+    const bool is64 = f[4] == 2;
+    if (f[5] != 1) {
+        err = "big-endian ELF not supported";
+        return false;
+    }
+    if (rd<uint16_t>(f, 18) != 243) {
+        err = "not a RISC-V ELF (e_machine != EM_RISCV)";
+        return false;
+    }
+
+    uint64_t phoff, shoff;
+    uint16_t phentsize, phnum, shentsize, shnum;
+    if (is64) {
+        img.entry = rd<uint64_t>(f, 24);
+        phoff     = rd<uint64_t>(f, 32);
+        shoff     = rd<uint64_t>(f, 40);
+        phentsize = rd<uint16_t>(f, 54);
+        phnum     = rd<uint16_t>(f, 56);
+        shentsize = rd<uint16_t>(f, 58);
+        shnum     = rd<uint16_t>(f, 60);
+    } else {
+        img.entry = rd<uint32_t>(f, 24);
+        phoff     = rd<uint32_t>(f, 28);
+        shoff     = rd<uint32_t>(f, 32);
+        phentsize = rd<uint16_t>(f, 42);
+        phnum     = rd<uint16_t>(f, 44);
+        shentsize = rd<uint16_t>(f, 46);
+        shnum     = rd<uint16_t>(f, 48);
+    }
+
+    // Program headers: PT_LOAD at p_paddr, file bytes then zero fill to p_memsz
+    for (uint16_t i = 0; i < phnum; i++) {
+        const uint64_t ph = phoff + uint64_t(i) * phentsize;
+        uint32_t type = rd<uint32_t>(f, ph);
+        uint64_t offset, paddr, filesz, memsz;
+        if (is64) {
+            offset = rd<uint64_t>(f, ph + 8);
+            paddr  = rd<uint64_t>(f, ph + 24);
+            filesz = rd<uint64_t>(f, ph + 32);
+            memsz  = rd<uint64_t>(f, ph + 40);
+        } else {
+            offset = rd<uint32_t>(f, ph + 4);
+            paddr  = rd<uint32_t>(f, ph + 12);
+            filesz = rd<uint32_t>(f, ph + 16);
+            memsz  = rd<uint32_t>(f, ph + 20);
+        }
+        if (type != 1 || memsz == 0)  // PT_LOAD
+            continue;
+        if (offset + filesz > f.size()) {
+            err = "truncated PT_LOAD segment";
+            return false;
+        }
+        Segment seg;
+        seg.addr = paddr;
+        seg.data.assign(memsz, 0);
+        std::memcpy(seg.data.data(), &f[offset], filesz);
+        img.segments.push_back(std::move(seg));
+    }
+    if (img.segments.empty()) {
+        err = "no PT_LOAD segments";
+        return false;
+    }
+
+    // Symbol table: tohost
+    for (uint16_t i = 0; i < shnum; i++) {
+        const uint64_t sh = shoff + uint64_t(i) * shentsize;
+        if (rd<uint32_t>(f, sh + 4) != 2)  // SHT_SYMTAB
+            continue;
+        uint64_t sym_off, sym_size, sym_ent;
+        uint32_t link;
+        if (is64) {
+            sym_off  = rd<uint64_t>(f, sh + 24);
+            sym_size = rd<uint64_t>(f, sh + 32);
+            link     = rd<uint32_t>(f, sh + 40);
+            sym_ent  = rd<uint64_t>(f, sh + 56);
+        } else {
+            sym_off  = rd<uint32_t>(f, sh + 16);
+            sym_size = rd<uint32_t>(f, sh + 20);
+            link     = rd<uint32_t>(f, sh + 24);
+            sym_ent  = rd<uint32_t>(f, sh + 36);
+        }
+        const uint64_t str_sh  = shoff + uint64_t(link) * shentsize;
+        const uint64_t str_off = is64 ? rd<uint64_t>(f, str_sh + 24) : rd<uint32_t>(f, str_sh + 16);
+        if (sym_ent == 0)
+            continue;
+        for (uint64_t s = sym_off; s + sym_ent <= sym_off + sym_size; s += sym_ent) {
+            const uint64_t name = str_off + rd<uint32_t>(f, s);
+            if (name >= f.size() || std::strcmp(reinterpret_cast<const char*>(&f[name]), "tohost") != 0)
+                continue;
+            img.tohost = is64 ? rd<uint64_t>(f, s + 8) : rd<uint32_t>(f, s + 4);
+            img.has_tohost = true;
+        }
+    }
+    return true;
+}
+
+// .hex as produced by tools/run_official_tests.sh / tests/asm: one byte per
+// token, optional @index lines. Indices are offsets from 0x8000_0000, where
+// these images are linked, so the bytes land in both memories
+static bool is_hex_image(const std::string& path) {
+    return path.size() > 4 && path.compare(path.size() - 4, 4, ".hex") == 0;
+}
+
+static bool load_hex(std::istream& in, Image& img, std::string& err) {
+    std::string tok;
+    Segment* seg = nullptr;
+    while (in >> tok) {
+        if (tok.compare(0, 2, "//") == 0) {
+            std::getline(in, tok);
+            continue;
+        }
+        if (tok[0] == '@') {
+            img.segments.push_back(Segment{DMEM_BASE + std::strtoull(tok.c_str() + 1, nullptr, 16), {}});
+            seg = &img.segments.back();
+            continue;
+        }
+        if (!seg) {
+            img.segments.push_back(Segment{DMEM_BASE, {}});
+            seg = &img.segments.back();
+        }
+        seg->data.push_back(static_cast<uint8_t>(std::strtoul(tok.c_str(), nullptr, 16)));
+    }
+    if (img.segments.empty()) {
+        err = "empty hex image";
+        return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// DPI-C image access for instruction_memory.v / data_memory.v (RV_DPI_IMAGE).
+// Their initial blocks copy every segment of their target into mem[]:
+// target 0 = IMEM (all segments), 1 = DMEM (the part in the simple_bus window)
+//------------------------------------------------------------------------------
+
+struct Span {
+    uint64_t       addr;
+    const uint8_t* data;
+    uint64_t       len;
+};
+
+static std::vector<Span> g_spans[2];
+
+static void set_image(const Image& img) {
+    for (const Segment& seg : img.segments) {
+        const uint64_t end = seg.addr + seg.data.size();
+        g_spans[0].push_back(Span{seg.addr, seg.data.data(), seg.data.size()});
+        const uint64_t lo = std::max(seg.addr, DMEM_BASE);
+        const uint64_t hi = std::min(end, DMEM_END);
+        if (lo < hi)
+            g_spans[1].push_back(Span{lo, seg.data.data() + (lo - seg.addr), hi - lo});
+    }
+}
+
+extern "C" int rv_image_segment(int target, int n, long long* addr, long long* len) {
+    if (target < 0 || target > 1 || n < 0 || static_cast<size_t>(n) >= g_spans[target].size())
+        return 0;
+    *addr = static_cast<long long>(g_spans[target][n].addr);
+    *len  = static_cast<long long>(g_spans[target][n].len);
+    return 1;
+}
+
+extern "C" char rv_image_byte(int target, int n, long long offset) {
+    return static_cast<char>(g_spans[target][n].data[offset]);
+}
+
+//------------------------------------------------------------------------------
+// Main
+//------------------------------------------------------------------------------
+
+static void usage(const char* prog) {
+    std::fprintf(stderr,
+        "Usage: %s [--max-cycles=N] [--tohost=ADDR] [--compliance] [--quiet]\n"
+        "       %*s <image.elf|image.hex> [+plusargs...]\n",
+        prog, static_cast<int>(std::strlen(prog)), "");
+}
+
+int main(int argc, char** argv) {
+    uint64_t    max_cycles = 1000000;
+    bool        compliance = false;
+    bool        quiet = false;
+    bool        tohost_given = false;
+    uint64_t    tohost = 0;
+    std::string image_path;
+    std::vector<std::string> vargs = {argv[0]};
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (std::strncmp(a, "--max-cycles=", 13) == 0) {
+            max_cycles = std::strtoull(a + 13, nullptr, 0);
+        } else if (std::strncmp(a, "--tohost=", 9) == 0) {
+            tohost = std::strtoull(a + 9, nullptr, 0);
+            tohost_given = true;
+        } else if (std::strcmp(a, "--compliance") == 0) {
+            compliance = true;
+        } else if (std::strcmp(a, "--quiet") == 0) {
+            quiet = true;
+        } else if (a[0] == '+') {
+            vargs.push_back(a);
+        } else if (a[0] == '-' || !image_path.empty()) {
+            usage(argv[0]);
+            return EXIT_ERROR;
+        } else {
+            image_path = a;
+        }
+    }
+    if (image_path.empty()) {
+        usage(argv[0]);
+        return EXIT_ERROR;
+    }
+
+    // Load the image; the memories copy it in on the first eval
+    std::ifstream in(image_path, std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "rv_soc_sim: cannot open %s\n", image_path.c_str());
+        return EXIT_ERROR;
+    }
+    Image img;
+    std::string err;
+    bool ok;
+    if (is_hex_image(image_path)) {
+        ok = load_hex(in, img, err);
+    } else {
+        std::vector<uint8_t> f((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        ok = load_elf(f, img, err);
+    }
+    if (!ok) {
+        std::fprintf(stderr, "rv_soc_sim: %s: %s\n", image_path.c_str(), err.c_str());
+        return EXIT_ERROR;
+    }
+    if (!tohost_given && img.has_tohost) {
+        tohost = img.tohost;
+        tohost_given = true;
+    }
+    set_image(img);
+
+    std::vector<const char*> cargs;
+    for (const std::string& s : vargs)
+        cargs.push_back(s.c_str());
+
+    const std::unique_ptr<VerilatedContext> ctx{new VerilatedContext};
+    ctx->commandArgs(static_cast<int>(cargs.size()), cargs.data());
+    const std::unique_ptr<Vrv_soc_sim> top{new Vrv_soc_sim{ctx.get()}};
+
+    if (!quiet) {
+        std::printf("=== rv_soc_sim: %s ===\n", image_path.c_str());
+        if (tohost_given)
+            std::printf("tohost: 0x%" PRIx64 "\n", tohost);
+        std::fflush(stdout);
+    }
+
+    // Reset (initial blocks load the images on the first eval)
+    const auto t_start = std::chrono::steady_clock::now();
+    top->clk = 0;
+    top->reset_n = 0;
+    for (int i = 0; i < 5; i++) {
+        top->clk = 0;
+        top->eval();
+        top->clk = 1;
+        top->eval();
+    }
+    top->reset_n = 1;
+
+    // Run. Bus and fetch outputs are sampled before each rising edge, i.e. the
+    // values that edge commits (as the iverilog testbenches do at posedge)
+    int         result = EXIT_TIMEOUT;
+    std::string reason;
+    uint64_t    cycle = 0;
+    int         drain = -1;       // Cycles left before judging EBREAK/ECALL
+    uint32_t    drain_instr = 0;
+    bool        uart_col0 = true;
+
+    while (cycle < max_cycles && !ctx->gotFinish()) {
+        top->clk = 0;
+        top->eval();
+
+        if (top->uart_tx_valid) {
+            const char c = static_cast<char>(top->uart_tx_data);
+            std::fputc(c, stdout);
+            uart_col0 = (c == '\n');
+            if (uart_col0)
+                std::fflush(stdout);
+        }
+
+        if (drain < 0 && top->st_valid) {
+            const uint64_t addr  = static_cast<uint64_t>(top->st_addr);
+            const uint64_t value = static_cast<uint64_t>(top->st_data) & 0xFFFFFFFFULL;  // SW
+            if (tohost_given && addr == tohost && value != 0) {
+                if (value == 1) {
+                    result = EXIT_PASS;
+                    reason = "tohost = 1";
+                } else {
+                    char buf[64];
+                    std::snprintf(buf, sizeof(buf), "tohost = 0x%" PRIx64 " (test %" PRIu64 ")",
+                                  value, value >> 1);
+                    result = EXIT_FAIL;
+                    reason = buf;
+                }
+            } else if (addr == MARKER_ADDR) {
+                result = value == 1 ? EXIT_PASS : EXIT_FAIL;
+                reason = "test marker = " + std::to_string(value);
+            }
+        }
+
+        if (drain < 0 && result == EXIT_TIMEOUT) {
+            const uint32_t instr = top->instr_out;
+            if (instr == INSTR_EBREAK || (instr & 0xFFFF) == INSTR_CEBREAK ||
+                (compliance && instr == INSTR_ECALL)) {
+                drain = (instr == INSTR_ECALL) ? 5 : 10;
+                drain_instr = instr;
+            }
+        }
+
+        top->clk = 1;
+        top->eval();
+        cycle++;
+
+        if (result != EXIT_TIMEOUT)
+            break;
+        if (drain > 0 && --drain == 0) {
+            char buf[64];
+            if (drain_instr == INSTR_ECALL) {
+                const uint64_t gp = static_cast<uint64_t>(top->reg_gp);
+                result = gp != 0 ? EXIT_PASS : EXIT_FAIL;
+                std::snprintf(buf, sizeof(buf), "ECALL, gp = %" PRIu64, gp);
+            } else {
+                const uint32_t x28 = static_cast<uint32_t>(top->reg_x28);
+                result = (x28 == 0xDEADDEAD || x28 == 0x0BADC0DE) ? EXIT_FAIL : EXIT_PASS;
+                std::snprintf(buf, sizeof(buf), "EBREAK, x28 = 0x%08x", x28);
+            }
+            reason = buf;
+            break;
+        }
+    }
+    top->final();
+
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+    const uint64_t instret = static_cast<uint64_t>(top->instret);
+
+    if (!uart_col0)
+        std::fputc('\n', stdout);
+    std::printf("========================================\n");
+    std::printf("%s\n", result == EXIT_PASS ? "TEST PASSED" :
+                        result == EXIT_FAIL ? "TEST FAILED" : "TEST TIMEOUT");
+    std::printf("========================================\n");
+    if (result == EXIT_TIMEOUT)
+        reason = "no completion after " + std::to_string(max_cycles) + " cycles";
+    std::printf("  Reason:       %s\n", reason.c_str());
+    std::printf("  Final PC:     0x%08" PRIx64 "\n", static_cast<uint64_t>(top->pc_out));
+    std::printf("  Cycles:       %" PRIu64 "\n", cycle);
+    std::printf("  Instructions: %" PRIu64 "\n", instret);
+    std::printf("  IPC:          %.3f\n", cycle ? double(instret) / double(cycle) : 0.0);
+    std::printf("  Sim speed:    %.3f MHz (%.3f s)\n", secs > 0 ? cycle / secs / 1e6 : 0.0, secs);
+    return result;
+}
@@ -0,0 +1,94 @@
+// rv_soc_sim.v - Verilator top for the rv_soc C++ simulator (rv_soc_sim.cpp)
+// Wraps rv_soc with the sizes from rv_config.vh and exposes what the C++
+// driver needs to run a program to completion
+// Author: RV1 Project
+// Date: 2026-10-16
+//
+// Features:
+// - No MEM_FILE: the memories take the image from the driver at run time
+//   (DPI-C with RV_DPI_IMAGE, otherwise +IMEM_FILE= / +DMEM_FILE=)
+// - UART TX always ready, RX idle; TX bytes go to the driver
+// - Hart 0 store snoop (tohost / test marker detection), also with a
+//   BUS_PIPELINED write acknowledged after the write strobe
+// - gp, x28 and minstret of hart 0 for the ECALL/EBREAK conventions and IPC
+// - Reset vector from SIM_RESET_VECTOR (default 0x8000_0000, the address the
+//   official and custom tests are linked at); memory sizes from IMEM_SIZE and
+//   DMEM_SIZE
+
+`include "config/rv_config.vh"
+
+`ifndef SIM_RESET_VECTOR
+  `define SIM_RESET_VECTOR 32'h8000_0000
+`endif
+
+module rv_soc_sim #(
+  parameter XLEN = `XLEN,
+  parameter [XLEN-1:0] RESET_VECTOR = `SIM_RESET_VECTOR,
+  parameter IMEM_SIZE = `IMEM_SIZE,
+  parameter DMEM_SIZE = `DMEM_SIZE
+) (
+  input  wire             clk,
+  input  wire             reset_n,
+
+  // Fetch stage of hart 0
+  output wire [XLEN-1:0]  pc_out,
+  output wire [31:0]      instr_out,
+
+  // UART TX
+  output wire             uart_tx_valid,
+  output wire [7:0]       uart_tx_data,
+
+  // Hart 0 stores accepted by the bus
+  output wire             st_valid,
+  output wire [XLEN-1:0]  st_addr,
+  output wire [63:0]      st_data,
+
+  // Hart 0 architectural state
+  output wire [XLEN-1:0]  reg_gp,
+  output wire [XLEN-1:0]  reg_x28,
+  output wire [63:0]      instret
+);
+
+  wire uart_rx_ready;
+
+  rv_soc #(
+    .XLEN(XLEN),
+    .RESET_VECTOR(RESET_VECTOR),
+    .IMEM_SIZE(IMEM_SIZE),
+    .DMEM_SIZE(DMEM_SIZE),
+    .MEM_FILE("")
+  ) DUT (
+    .clk(clk),
+    .reset_n(reset_n),
+    .uart_tx_valid(uart_tx_valid),
+    .uart_tx_data(uart_tx_data),
+    .uart_tx_ready(1'b1),
+    .uart_rx_valid(1'b0),
+    .uart_rx_data(8'h00),
+    .uart_rx_ready(uart_rx_ready),
+    .pc_out(pc_out),
+    .instr_out(instr_out)
+  );
+
+  // The core strobes req_we in the first cycle of a write only; with
+  // BUS_PIPELINED the write is acknowledged later, so remember the strobe
+  reg st_pending;
+  always @(posedge clk or negedge reset_n) begin
+    if (!reset_n)
+      st_pending <= 1'b0;
+    else if (!DUT.g_hart[0].core_req_valid || DUT.g_hart[0].core_req_ready)
+      st_pending <= 1'b0;
+    else if (DUT.g_hart[0].core_req_we)
+      st_pending <= 1'b1;
+  end
+
+  assign st_valid = DUT.g_hart[0].core_req_valid && DUT.g_hart[0].core_req_ready &&
+                    (DUT.g_hart[0].core_req_we || st_pending);
+  assign st_addr  = DUT.g_hart[0].core_req_addr;
+  assign st_data  = DUT.g_hart[0].core_req_wdata;
+
+  assign reg_gp   = DUT.g_hart[0].core.regfile.registers[3];
+  assign reg_x28  = DUT.g_hart[0].core.regfile.registers[28];
+  assign instret  = DUT.g_hart[0].core.csr_file_inst.minstret_r;
+
+endmodule
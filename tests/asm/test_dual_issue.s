@@ -0,0 +1,190 @@
+# Test Dual Issue (ISSUE_WIDTH=2)
+# Directed pairs for tb_dual_issue.v: independent ALU pairs, pairs split by a
+# dependency, forwarding from lane 1, WAW pairs on one rd (register_file port
+# 2 must win, also against a lane-0 load), lane-0 branch/JAL/JALR redirects
+# with a valid lane-1 fall-through, and a lane-0 load page fault (S-mode) with
+# a valid lane 1 that must be dropped and re-executed after the handler.
+# A FENCE (never paired) in front of a sequence makes the next word lane 0.
+# Also runs at ISSUE_WIDTH=1 (same results, no pairs)
+# Result: x28 = 0xDEADBEEF on success, 0xDEADDEAD on failure (gp = test)
+
+.include "tests/asm/include/priv_test_macros.s"
+.option norvc
+
+.section .text
+.globl _start
+
+_start:
+    li   gp, 0
+    li   s2, 0
+    li   s3, 0
+    SET_MTVEC_DIRECT m_trap_handler
+    la   s0, test_data
+    li   t0, 0x12345678
+    sw   t0, 0(s0)
+
+    #===========================================
+    # Test 1: independent pairs
+    #===========================================
+    li   gp, 1
+    fence
+    addi a0, zero, 1
+    addi a1, zero, 2
+    addi a2, zero, 3
+    addi a3, zero, 4
+    addi a4, zero, 5
+    addi a5, zero, 6
+    addi a6, zero, 7
+    addi a7, zero, 8
+    add  s4, a0, a1
+    add  s5, a2, a3
+    add  s6, a4, a5
+    add  s7, a6, a7
+    add  s4, s4, s5
+    add  s6, s6, s7
+    add  s4, s4, s6
+    li   t0, 36
+    bne  s4, t0, fail
+
+    #===========================================
+    # Test 2: dependent pairs (not paired) and forwarding from lane 1
+    #===========================================
+    li   gp, 2
+    fence
+    addi a0, zero, 5
+    addi a1, a0, 1              # Reads lane 0's rd: issues alone
+    addi a2, a1, 1
+    addi a3, a2, 1
+    li   t0, 8
+    bne  a3, t0, fail
+    fence
+    addi a0, zero, 1
+    addi a1, zero, 2            # Lane 1
+    add  a2, a1, a1             # Forwarded from lane 1 in MEM
+    add  a3, a2, a0             # a2 from MEM, a0 from WB
+    li   t0, 5
+    bne  a3, t0, fail
+
+    #===========================================
+    # Test 3: WAW pair (lane 1 wins)
+    #===========================================
+    li   gp, 3
+    fence
+    addi a0, zero, 1            # Lane 0
+    addi a0, zero, 2            # Lane 1, same rd
+    add  a1, a0, zero           # Forwarded: must see lane 1
+    li   t0, 2
+    bne  a1, t0, fail
+    fence
+    nop
+    nop
+    nop
+    nop
+    nop
+    nop
+    add  a2, a0, zero           # Register file: port 2 wrote last
+    bne  a2, t0, fail
+
+    # Lane-0 load and lane-1 ALU op to the same rd
+    fence
+    lw   a0, 0(s0)              # Lane 0
+    addi a0, zero, 7            # Lane 1, same rd
+    addi a1, a0, 0              # Load-use stall, then forwarded from lane 1
+    li   t0, 7
+    bne  a1, t0, fail
+    fence
+    nop
+    nop
+    nop
+    nop
+    nop
+    nop
+    bne  a0, t0, fail
+
+    #===========================================
+    # Test 4: lane-0 redirect kills lane 1
+    #===========================================
+    li   gp, 4
+    li   a0, 0
+    fence
+    beq  zero, zero, 1f         # Lane 0: taken, not predicted
+    addi a0, a0, 1              # Lane 1: fall-through, killed
+    addi a0, a0, 1
+1:  bnez a0, fail
+    fence
+    jal  zero, 2f               # Lane 0: jump
+    addi a0, a0, 1              # Lane 1: killed
+    addi a0, a0, 1
+2:  bnez a0, fail
+    la   t1, 3f
+    fence
+    jalr zero, 0(t1)            # Lane 0: indirect jump
+    addi a0, a0, 1              # Lane 1: killed
+    addi a0, a0, 1
+3:  bnez a0, fail
+
+    #===========================================
+    # Test 5: lane-0 load page fault with a valid lane 1
+    #===========================================
+    li   gp, 5
+
+    # Sv32: identity megapage for 0x80000000-0x803FFFFF, everything else invalid
+    la   t1, page_table_l1
+    li   t0, 0x200000CF         # Megapage: V|R|W|X|A|D
+    li   t2, 2048               # L1[512]
+    add  t2, t1, t2
+    sw   t0, 0(t2)
+    srli t0, t1, 12
+    li   t1, 0x80000000         # MODE = Sv32
+    or   t0, t0, t1
+    csrw satp, t0
+    sfence.vma
+
+    ENTER_SMODE_M smode_entry
+
+smode_entry:
+    li   t0, 0x00010000         # Unmapped VA
+    fence
+    lw   t1, 0(t0)              # Lane 0: load page fault (to M-mode)
+    addi s2, s2, 1              # Lane 1: dropped, re-executed after mret
+    li   t0, 1
+    bne  s2, t0, fail           # Committed exactly once
+    bne  s3, t0, fail           # One fault taken
+
+    # All tests passed
+    li   t3, 0xDEADBEEF
+    ebreak
+
+fail:
+    li   t3, 0xDEADDEAD
+    ebreak
+
+###############################################################################
+# M-mode trap handler: the Test 5 page fault resumes after the load,
+# EBREAK (end of test) parks here
+###############################################################################
+
+m_trap_handler:
+    csrr t5, mcause
+    li   t6, CAUSE_BREAKPOINT
+    beq  t5, t6, halt
+    li   t6, CAUSE_LOAD_PAGE_FAULT
+    bne  t5, t6, fail
+    bnez s2, fail               # Lane 1 must not have committed with the fault
+    addi s3, s3, 1
+    csrr t5, mepc
+    addi t5, t5, 4              # Skip the load; lane 1 runs next
+    csrw mepc, t5
+    mret
+
+halt:
+    j    halt
+
+.section .data
+
+.align 12
+page_table_l1:
+    .space 4096
+
+test_data:
+    .word 0
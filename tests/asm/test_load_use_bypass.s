@@ -0,0 +1,153 @@
+# Test Load-Use Bypass (LOAD_USE_BYPASS)
+# Every load's result is used by the very next instruction: ALU consumers
+# (rs1, rs2, both), sub-word loads (alignment path), load -> load address,
+# load -> store address and store data, a pointer chase, a load to x0, and
+# consumers that keep the stall (branch, MUL). In tb_core_pipelined every
+# load waits one cycle on the bus (dmem_bus_adapter), so each bypassed value
+# is taken while bus_wait_stall holds EX and MEM.
+# Run with tools/test_load_use_bypass.sh (LOAD_USE_BYPASS=0 vs 1)
+# Result: x28 = 0xDEADBEEF on success, 0xDEADDEAD on failure (gp = test)
+
+.section .text
+.globl _start
+
+_start:
+    li   s0, 0x80003000         # Data base (DMEM)
+    li   gp, 0
+
+    # Data: 0x12345678 at +0, pointer to +0x40 at +4, bytes 01 80 AA 55 at +8,
+    # 0x0BADF00D at +0x40
+    li   t0, 0x12345678
+    sw   t0, 0(s0)
+    addi t0, s0, 0x40
+    sw   t0, 4(s0)
+    li   t0, 0x55AA8001
+    sw   t0, 8(s0)
+    li   t0, 0x0BADF00D
+    sw   t0, 0x40(s0)
+
+    # Linked list at +0x100: 8 nodes {next, value}, values 1..8
+    addi t1, s0, 0x100
+    li   t2, 1
+    li   t4, 8
+build:
+    addi t5, t1, 8
+    sw   t5, 0(t1)
+    sw   t2, 4(t1)
+    mv   t1, t5
+    addi t2, t2, 1
+    bge  t4, t2, build
+    sw   zero, -8(t1)           # Last node: next = 0
+
+    #===========================================
+    # Test 1: load -> ALU (rs1)
+    #===========================================
+    li   gp, 1
+    lw   a0, 0(s0)
+    addi a1, a0, 1
+    li   a2, 0x12345679
+    bne  a1, a2, fail
+
+    #===========================================
+    # Test 2: load -> ALU (rs2, both operands)
+    #===========================================
+    li   gp, 2
+    lw   a0, 0(s0)
+    sub  a1, zero, a0
+    add  a1, a1, a0
+    bnez a1, fail
+    lw   a0, 0(s0)
+    add  a1, a0, a0
+    li   a2, 0x2468ACF0
+    bne  a1, a2, fail
+
+    #===========================================
+    # Test 3: sub-word loads (sign/zero extension) -> ALU
+    #===========================================
+    li   gp, 3
+    lb   a0, 9(s0)              # 0x80 -> 0xFFFFFF80
+    addi a1, a0, 0x80
+    bnez a1, fail
+    lhu  a0, 8(s0)              # 0x8001
+    addi a1, a0, -1
+    li   a2, 0x8000
+    bne  a1, a2, fail
+    lh   a0, 10(s0)             # 0x55AA
+    slli a1, a0, 16
+    li   a2, 0x55AA0000
+    bne  a1, a2, fail
+
+    #===========================================
+    # Test 4: load -> load address
+    #===========================================
+    li   gp, 4
+    lw   a0, 4(s0)              # Pointer to +0x40
+    lw   a1, 0(a0)
+    li   a2, 0x0BADF00D
+    bne  a1, a2, fail
+
+    #===========================================
+    # Test 5: load -> store address, load -> store data
+    #===========================================
+    li   gp, 5
+    lw   a0, 4(s0)
+    sw   s0, 4(a0)              # +0x44 = s0
+    lw   a1, 0x44(s0)
+    bne  a1, s0, fail
+    lw   a0, 0(s0)
+    sw   a0, 0x48(s0)
+    lw   a1, 0x48(s0)
+    li   a2, 0x12345678
+    bne  a1, a2, fail
+
+    #===========================================
+    # Test 6: pointer chase (ALU and branch consumers)
+    #===========================================
+    li   gp, 6
+    addi a0, s0, 0x100
+    li   a1, 0
+chase:
+    lw   a2, 4(a0)
+    add  a1, a1, a2
+    lw   a0, 0(a0)
+    bnez a0, chase              # Branch consumer keeps the stall
+    li   a2, 36
+    bne  a1, a2, fail
+
+    #===========================================
+    # Test 7: load -> MUL (keeps the stall)
+    #===========================================
+    li   gp, 7
+    li   a2, 2
+    lw   a0, 0(s0)
+    mul  a1, a0, a2
+    li   a3, 0x2468ACF0
+    bne  a1, a3, fail
+
+    #===========================================
+    # Test 8: load to x0 is not forwarded
+    #===========================================
+    li   gp, 8
+    lw   zero, 0(s0)
+    addi a1, zero, 5
+    li   a2, 5
+    bne  a1, a2, fail
+
+    #===========================================
+    # Test 9: back-to-back dependent loads and ALU ops
+    #===========================================
+    li   gp, 9
+    lw   a0, 4(s0)              # Pointer to +0x40
+    lw   a1, 0(a0)              # 0x0BADF00D
+    xor  a2, a1, a0
+    lw   a3, 0x40(s0)
+    xor  a2, a2, a3
+    bne  a2, a0, fail
+
+    # All tests passed
+    li   t3, 0xDEADBEEF
+    ebreak
+
+fail:
+    li   t3, 0xDEADDEAD
+    ebreak
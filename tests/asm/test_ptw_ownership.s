@@ -0,0 +1,180 @@
+# Test PTW Bus Ownership (hit-under-miss page walks)
+# The page walker shares the core's data port with MEM. An I-TLB walk runs
+# while the pipeline keeps draining, so it must not cut into a data access,
+# and a MEM access must wait while the walker owns the bus. In S-mode with
+# Sv32, code at VA 0x4000xxxx is mapped with 4 KiB pages; each snippet ends
+# with loads and stores (D-TLB hits on the identity megapage) in the last
+# words before a page whose I-TLB entry was just flushed, so the fetch walks
+# while they pass through MEM. The last snippet ends with a taken branch in
+# front of an unmapped page: the wrong-path fetch walks and faults, and that
+# fault must be dropped after the redirect (no trap).
+# tb_ptw_ownership.v checks that each case really occurred.
+# Result: x28 = 0xDEADBEEF on success, 0xDEADDEAD on failure (gp = test)
+
+.include "tests/asm/include/priv_test_macros.s"
+.option norvc
+
+.equ DATA_PAGE,  0x80006000     # Loads/stores (identity megapage)
+.equ L1_TABLE,   0x80007000     # Root table
+.equ L0_TABLE,   0x80008000     # Level-0 table for VA 0x40000000-0x403FFFFF
+.equ CODE_VA,    0x40000000     # VA of PA 0x80000000 (4 KiB pages)
+.equ CODE_PTE,   0x200000CB     # PPN 0x80000, V|R|X|A|D
+.equ ITERATIONS, 2
+
+# Snippet entry points and the pages behind them (VA)
+.equ TAIL_A,     CODE_VA + 0x2000 - 6*4
+.equ PAGE_A2,    CODE_VA + 0x2000
+.equ TAIL_B,     CODE_VA + 0x4000 - 6*4
+.equ PAGE_B2,    CODE_VA + 0x4000
+.equ TAIL_C,     CODE_VA + 0x6000 - 2*4
+
+.section .text
+.globl _start
+
+_start:
+    li   gp, 0
+    li   s3, 0                  # Traps taken (must stay 0)
+    SET_MTVEC_DIRECT m_trap_handler
+
+    # L1[512]: identity megapage for 0x80000000-0x803FFFFF
+    li   t0, L1_TABLE
+    li   t1, 0x200000CF         # V|R|W|X|A|D
+    li   t2, 2048
+    add  t2, t0, t2
+    sw   t1, 0(t2)
+    # L1[256]: VA 0x40000000 -> level-0 table
+    li   t1, ((L0_TABLE >> 12) << 10) | 0x01
+    sw   t1, 1024(t0)
+    # L0[1..5]: VA 0x40001000-0x40005FFF -> PA 0x80001000-0x80005FFF
+    # (L0[6] stays 0: VA 0x40006000 is unmapped)
+    li   t0, L0_TABLE + 4
+    li   t1, CODE_PTE + (1 << 10)
+    li   t2, (1 << 10)
+    li   t4, 5
+1:  sw   t1, 0(t0)
+    add  t1, t1, t2
+    addi t0, t0, 4
+    addi t4, t4, -1
+    bnez t4, 1b
+    li   t0, L0_TABLE + 24
+    sw   zero, 0(t0)
+
+    li   t0, (L1_TABLE >> 12) | 0x80000000     # MODE = Sv32
+    csrw satp, t0
+    sfence.vma
+
+    ENTER_SMODE_M smode_entry
+
+smode_entry:
+    li   s1, DATA_PAGE
+    lw   t0, 0(s1)              # D-TLB now holds the megapage
+    li   s4, ITERATIONS
+    li   s5, 0                  # Snippet C passes
+
+    #===========================================
+    # Tests 1-2: loads and stores in MEM during an I-TLB walk
+    #===========================================
+loop:
+    li   t0, PAGE_A2
+    sfence.vma t0, zero         # Next fetch from page A2 walks
+    li   t0, PAGE_B2
+    sfence.vma t0, zero
+
+    # Test 1: store, load, store, load, store, load
+    li   gp, 1
+    slli a0, s4, 8
+    addi a1, a0, 1
+    addi a2, a0, 2
+    li   t0, TAIL_A
+    jalr ra, 0(t0)
+    bne  t1, a0, fail
+    bne  t2, a1, fail
+    bne  t4, a2, fail
+
+    # Test 2: load, store, load, store, load, store
+    li   gp, 2
+    addi a0, a0, 0x10
+    addi a1, a1, 0x10
+    addi a2, a2, 0x10
+    sw   a0, 12(s1)
+    li   t0, TAIL_B
+    jalr ra, 0(t0)
+    bne  t1, a0, fail
+    bne  t2, a0, fail
+    bne  t4, a1, fail
+    lw   t0, 24(s1)
+    bne  t0, a2, fail
+
+    addi s4, s4, -1
+    bnez s4, loop
+
+    #===========================================
+    # Test 3: wrong-path fetch from an unmapped page
+    #===========================================
+    li   gp, 3
+    li   t0, TAIL_C
+    jalr ra, 0(t0)
+    li   t0, 1
+    bne  s5, t0, fail
+    bnez s3, fail               # The walk fault was not taken
+
+    # All tests passed
+    li   t3, 0xDEADBEEF
+    ebreak
+
+fail:
+    li   t3, 0xDEADDEAD
+    ebreak
+
+###############################################################################
+# M-mode trap handler: EBREAK (end of test) parks here, anything else fails
+###############################################################################
+
+m_trap_handler:
+    addi s3, s3, 1
+    csrr t5, mcause
+    li   t6, CAUSE_BREAKPOINT
+    beq  t5, t6, halt
+    li   t3, 0xDEADDEAD
+halt:
+    j    halt
+
+###############################################################################
+# Snippets, run at VA 0x4000xxxx (PA = VA + 0x40000000)
+###############################################################################
+
+    .balign 4096
+page_a1:                        # VA 0x40001000
+    .space 4096 - 6*4
+tail_a:
+    sw   a0, 0(s1)
+    lw   t1, 0(s1)
+    sw   a1, 4(s1)
+    lw   t2, 4(s1)
+    sw   a2, 8(s1)
+    lw   t4, 8(s1)
+page_a2:                        # VA 0x40002000: flushed from the I-TLB
+    jalr zero, 0(ra)
+
+    .balign 4096
+page_b1:                        # VA 0x40003000
+    .space 4096 - 6*4
+tail_b:
+    lw   t1, 12(s1)
+    sw   a0, 16(s1)
+    lw   t2, 16(s1)
+    sw   a1, 20(s1)
+    lw   t4, 20(s1)
+    sw   a2, 24(s1)
+page_b2:                        # VA 0x40004000: flushed from the I-TLB
+    jalr zero, 0(ra)
+
+    .balign 4096
+page_c:                         # VA 0x40005000
+c_return:
+    jalr zero, 0(ra)
+    .space 4096 - 3*4
+tail_c:
+    addi s5, s5, 1
+    beq  zero, zero, c_return   # Taken, not predicted: the fetch runs ahead
+                                # into VA 0x40006000 (unmapped) and walks
@@ -0,0 +1,123 @@
+# Test SMP PTW A/D Update (rv_soc, NUM_HARTS=2, PTW_AD_UPDATE=1)
+# The page walker's A/D update is a read-modify-write of the PTE; another hart
+# must not be able to write the PTE between the walker's read and its write-back.
+# Hart 0 (S-mode, Sv32) flushes its TLBs and loads through a clean leaf PTE over
+# and over, so every load walks and writes the PTE back with A set. Hart 1
+# (M-mode, bare) keeps rewriting the same PTE with A=0 and a software (RSW)
+# value that changes every time, and reads it back: a walker write-back based
+# on a read from before hart 1's store would bring back the old RSW value
+# (lost update). tb_smp_ptw_ad.v counts how often hart 1 hit the PTE while
+# hart 0's walker held the bus.
+# Result: x28 = 0xDEADBEEF on success, 0xDEADDEAD on failure (both harts)
+
+.include "tests/asm/include/priv_test_macros.s"
+.option norvc
+
+.equ L1_TABLE,   0x80002000     # Root table
+.equ L0_TABLE,   0x80003000     # Level-0 table for VA 0x40000000
+.equ DATA_PAGE,  0x80004000     # Target of VA 0x40000000
+.equ FLAGS,      0x80005000     # +0: go (tables ready), +4: done
+.equ TEST_VA,    0x40000000
+.equ LEAF_PTE,   0x20001007     # PPN 0x80004, V|R|W, A=0, D=0
+.equ ITERATIONS, 64
+
+.section .text
+.globl _start
+
+_start:
+    li   t3, 0
+    csrr t0, mhartid
+    bnez t0, hart1
+
+    #===========================================
+    # Hart 0: page tables, then walk in S-mode
+    #===========================================
+    SET_MTVEC_DIRECT m_trap_handler
+
+    li   t0, DATA_PAGE
+    li   t1, 0x12345678
+    sw   t1, 0(t0)
+
+    # L1[512]: identity megapage for 0x80000000-0x803FFFFF (code, tables, flags)
+    li   t0, L1_TABLE
+    li   t1, 0x200000CF         # V|R|W|X|A|D
+    li   t2, 2048
+    add  t2, t0, t2
+    sw   t1, 0(t2)
+    # L1[256]: VA 0x40000000 -> level-0 table
+    li   t1, ((L0_TABLE >> 12) << 10) | 0x01
+    sw   t1, 1024(t0)
+    # L0[0]: clean leaf for VA 0x40000000
+    li   t0, L0_TABLE
+    li   t1, LEAF_PTE
+    sw   t1, 0(t0)
+
+    li   t0, (L1_TABLE >> 12) | 0x80000000     # MODE = Sv32
+    csrw satp, t0
+    sfence.vma
+
+    li   t0, FLAGS
+    li   t1, 1
+    sw   t1, 0(t0)              # Go
+
+    ENTER_SMODE_M smode_entry
+
+smode_entry:
+    li   s0, TEST_VA
+    li   s1, ITERATIONS
+    li   s2, 0x12345678
+1:  sfence.vma                  # Drop the translation: next load walks again
+    lw   t1, 0(s0)
+    bne  t1, s2, fail
+    addi s1, s1, -1
+    bnez s1, 1b
+
+    li   t0, FLAGS
+    li   t1, 1
+    sw   t1, 4(t0)              # Done
+    li   t3, 0xDEADBEEF
+    ebreak
+
+fail:
+    li   t3, 0xDEADDEAD
+    ebreak
+
+    #===========================================
+    # Hart 1: rewrite the PTE until hart 0 is done
+    #===========================================
+hart1:
+    li   s0, L0_TABLE
+    li   s1, FLAGS
+    li   s2, LEAF_PTE
+    li   s3, 0x100              # RSW value (bit 8 or bit 9), toggled every store
+2:  lw   t0, 0(s1)
+    beqz t0, 2b                 # Wait for the tables
+
+3:  or   t1, s2, s3
+    sw   t1, 0(s0)
+    lw   t0, 0(s0)              # A may be set since, RSW must be ours
+    andi t0, t0, 0x300
+    bne  t0, s3, hart1_fail
+    xori s3, s3, 0x300
+    lw   t0, 4(s1)
+    beqz t0, 3b
+
+    li   t3, 0xDEADBEEF
+    j    park
+
+hart1_fail:
+    li   t3, 0xDEADDEAD
+park:
+    j    park
+
+###############################################################################
+# M-mode trap handler (hart 0): EBREAK ends the test, anything else fails
+###############################################################################
+
+m_trap_handler:
+    csrr t5, mcause
+    li   t6, CAUSE_BREAKPOINT
+    beq  t5, t6, halt
+    li   t3, 0xDEADDEAD
+halt:
+    j    halt
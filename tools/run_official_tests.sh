@@ -1,6 +1,8 @@
 #!/bin/bash
 # Run official RISC-V compliance tests
 # This script converts ELF binaries to hex and runs them through the RV1 core
+# SIM=verilator runs the ELFs directly on the Verilator rv_soc_sim instead
+# (built once per configuration, image loaded over DPI, no hex conversion)
 
 set -e
 
@@ -19,6 +21,7 @@ HEX_DIR="$RV1_DIR/tests/official-compliance"
 SIM_DIR="$RV1_DIR/sim/official-compliance"
 RTL_DIR="$RV1_DIR/rtl"
 TB_DIR="$RV1_DIR/tb"
+SIMULATOR="${SIM:-iverilog}"
 
 # Create directories
 mkdir -p "$HEX_DIR"
@@ -49,6 +52,7 @@ usage() {
   echo "  $0 m              # Run all M extension tests"
   echo "  $0 i add          # Run specific test: rv32ui-p-add"
   echo "  $0 all            # Run all tests"
+  echo "  SIM=verilator $0 i # Run on the Verilator simulator"
   exit 1
 }
 
@@ -83,17 +87,26 @@ elf_to_hex() {
   rm -f "${elf_file}.bin"
 }
 
+# Build the Verilator simulator for a configuration (once per script run);
+# sets VSIM_BIN
+declare -A VSIM_BUILT
+verilator_sim() {
+  local config_flag="$1"
+  local cfg="${config_flag#-DCONFIG_}"
+  local dir="$RV1_DIR/sim/verilator/$cfg"
+  VSIM_BIN="$dir/rv_soc_sim"
+  if [ -z "${VSIM_BUILT[$cfg]:-}" ]; then
+    make -C "$RV1_DIR" -s verilator-sim VSIM_CONFIG="$config_flag" VSIM_DIR="$dir" \
+      > "$SIM_DIR/verilator_${cfg}_build.log" 2>&1 || return 1
+    VSIM_BUILT[$cfg]=1
+  fi
+}
+
 # Run a single test
 run_test() {
   local test_path="$1"
   local test_name=$(basename "$test_path")
 
-  # Convert to hex if needed
-  local hex_file="$HEX_DIR/${test_name}.hex"
-  if [ ! -f "$hex_file" ] || [ "$test_path" -nt "$hex_file" ]; then
-    elf_to_hex "$test_path" "$hex_file"
-  fi
-
   # Determine configuration based on test name
   local config_flag=""
   if [[ "$test_name" == rv32uc* ]] || [[ "$test_name" == rv64uc* ]]; then
@@ -140,11 +153,39 @@ run_test() {
     fi
   fi
 
+  if [ "$SIMULATOR" = "verilator" ]; then
+    if ! verilator_sim "$config_flag"; then
+      echo -e "${RED}COMPILE FAILED${NC}"
+      return 1
+    fi
+    # ELF loaded directly; tohost from its symbol table
+    timeout 10s "$VSIM_BIN" --quiet "$test_path" > "$SIM_DIR/${test_name}.log" 2>&1 || true
+    if grep -q "TEST PASSED" "$SIM_DIR/${test_name}.log"; then
+      echo -e "${GREEN}PASSED${NC}"
+      return 0
+    elif grep -q "TEST FAILED" "$SIM_DIR/${test_name}.log"; then
+      local reason=$(grep "Reason:" "$SIM_DIR/${test_name}.log" | sed 's/.*Reason: *//')
+      echo -e "${RED}FAILED ($reason)${NC}"
+      return 1
+    else
+      echo -e "${YELLOW}TIMEOUT/ERROR${NC}"
+      return 1
+    fi
+  fi
+
+  # Convert to hex if needed
+  local hex_file="$HEX_DIR/${test_name}.hex"
+  if [ ! -f "$hex_file" ] || [ "$test_path" -nt "$hex_file" ]; then
+    elf_to_hex "$test_path" "$hex_file"
+  fi
+
   # Compile testbench
   debug_flags=""
   if [ -n "${DEBUG_FPU:-}" ]; then
     debug_flags="-DDEBUG_FPU"
   fi
+  # Extra configuration, e.g. EXTRA_DEFINES="-DATOMIC_DONE_FORWARD=1"
+  debug_flags="$debug_flags ${EXTRA_DEFINES:-}"
 
   iverilog -g2012 \
     -I"$RTL_DIR" \
@@ -0,0 +1,377 @@
+#!/usr/bin/env python3
+"""
+run_regression.py - Parallel regression runner on the Verilator rv_soc_sim
+
+Builds sim/verilator/<config>/rv_soc_sim once per configuration (all builds in
+parallel), then runs the official riscv-tests ELFs and the custom tests/asm
+programs on every host core. Each worker owns a deque of tests, longest
+first by the previous run's time; idle workers steal from the tail of the
+others, so the run ends about when its slowest test does.
+
+Usage: ./tools/run_regression.py [--suite official|custom|all] [-j N]
+                                 [--config rv32i,rv32imc,...] [--filter REGEX]
+                                 [--timeout SEC] [--max-cycles N]
+                                 [--junit FILE] [--json FILE] [--no-build]
+
+Exit status: 0 if every test passed, 1 otherwise.
+"""
+
+import argparse
+import collections
+import json
+import os
+import random
+import re
+import subprocess
+import sys
+import threading
+import time
+import xml.etree.ElementTree as ET
+
+RV1_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+RISCV_TESTS_DIR = os.path.join(RV1_DIR, 'riscv-tests', 'isa')
+OFFICIAL_HEX_DIR = os.path.join(RV1_DIR, 'tests', 'official-compliance')
+CUSTOM_DIR = os.path.join(RV1_DIR, 'tests', 'asm')
+VSIM_ROOT = os.path.join(RV1_DIR, 'sim', 'verilator')
+OUT_DIR = os.path.join(RV1_DIR, 'sim', 'regression')
+
+# Verilator defines per configuration (see rv_config.vh and test_pipelined.sh)
+CONFIGS = collections.OrderedDict([
+    ('rv32i',      '-DCONFIG_RV32I'),
+    ('rv32imc',    '-DCONFIG_RV32IMC'),
+    ('rv32imafdc', '-DXLEN=32 -DENABLE_M_EXT=1 -DENABLE_A_EXT=1 -DENABLE_C_EXT=1 -DENABLE_F_EXT=1'),
+    ('rv64',       '-DXLEN=64 -DENABLE_M_EXT=1 -DENABLE_A_EXT=1 -DENABLE_C_EXT=1 -DENABLE_F_EXT=1'),
+])
+
+# riscv-tests put tohost at the start of .tohost (0x80001000); needed only for
+# hex images, ELFs carry the symbol
+OFFICIAL_HEX_TOHOST = 0x80001000
+
+Test = collections.namedtuple('Test', ['name', 'suite', 'config', 'image', 'args'])
+
+
+def official_config(name):
+    """Configuration an official test runs on, from its rvXXuY prefix"""
+    if name.startswith('rv64'):
+        return 'rv64'
+    if name.startswith('rv32ui'):
+        return 'rv32i'
+    if name.startswith('rv32uc'):
+        return 'rv32imc'
+    return 'rv32imafdc'
+
+
+def discover(suite, xlen, pattern):
+    tests = []
+    if suite in ('official', 'all'):
+        exts = ['ui', 'um', 'ua', 'uf', 'ud', 'uc']
+        if os.path.isdir(RISCV_TESTS_DIR):
+            # ELFs as built by tools/build_riscv_tests.sh
+            for f in sorted(os.listdir(RISCV_TESTS_DIR)):
+                if not any(f.startswith('rv%d%s-p-' % (xlen, e)) for e in exts) or '.' in f:
+                    continue
+                tests.append(Test(f, 'official', official_config(f),
+                                  os.path.join(RISCV_TESTS_DIR, f), []))
+        elif os.path.isdir(OFFICIAL_HEX_DIR):
+            # Hex images left by tools/run_official_tests.sh
+            for f in sorted(os.listdir(OFFICIAL_HEX_DIR)):
+                name = f[:-4]
+                if not f.endswith('.hex') or not any(name.startswith('rv%d%s-p-' % (xlen, e)) for e in exts):
+                    continue
+                tests.append(Test(name, 'official', official_config(name),
+                                  os.path.join(OFFICIAL_HEX_DIR, f),
+                                  ['--tohost=0x%x' % OFFICIAL_HEX_TOHOST]))
+    if suite in ('custom', 'all'):
+        # Custom programs are assembled for all extensions (see test_pipelined.sh)
+        config = 'rv64' if xlen == 64 else 'rv32imafdc'
+        for f in sorted(os.listdir(CUSTOM_DIR)):
+            if f.endswith('.hex'):
+                tests.append(Test(f[:-4], 'custom', config, os.path.join(CUSTOM_DIR, f), []))
+    if pattern:
+        rx = re.compile(pattern)
+        tests = [t for t in tests if rx.search(t.name)]
+    return tests
+
+
+def build(config, log_dir):
+    """make verilator-sim for one configuration; returns (config, ok, seconds)"""
+    start = time.time()
+    log = os.path.join(log_dir, 'build_%s.log' % config)
+    with open(log, 'w') as f:
+        rc = subprocess.call(['make', '-C', RV1_DIR, '-s', 'verilator-sim',
+                              'VSIM_CONFIG=%s' % CONFIGS[config],
+                              'VSIM_DIR=%s' % os.path.join(VSIM_ROOT, config)],
+                             stdout=f, stderr=subprocess.STDOUT)
+    return config, rc == 0, time.time() - start
+
+
+RESULT_RE = {
+    'cycles': re.compile(r'^\s*Cycles:\s*(\d+)', re.M),
+    'instructions': re.compile(r'^\s*Instructions:\s*(\d+)', re.M),
+    'ipc': re.compile(r'^\s*IPC:\s*([\d.]+)', re.M),
+    'mhz': re.compile(r'^\s*Sim speed:\s*([\d.]+) MHz', re.M),
+    'reason': re.compile(r'^\s*Reason:\s*(.*)$', re.M),
+}
+
+
+def run_one(test, timeout, max_cycles, log_dir):
+    """Run one test on its configuration's simulator; returns a result dict"""
+    binary = os.path.join(VSIM_ROOT, test.config, 'rv_soc_sim')
+    cmd = [binary, '--quiet', '--max-cycles=%d' % max_cycles] + test.args + [test.image]
+    log = os.path.join(log_dir, test.config, test.name + '.log')
+    start = time.time()
+    try:
+        proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                              timeout=timeout)
+        output = proc.stdout.decode('utf-8', 'replace')
+        status = {0: 'pass', 1: 'fail', 2: 'timeout'}.get(proc.returncode, 'error')
+    except subprocess.TimeoutExpired as e:
+        output = (e.stdout or b'').decode('utf-8', 'replace')
+        status = 'timeout'
+        output += '\n[run_regression] killed after %ds wall time\n' % timeout
+    except OSError as e:
+        output = str(e)
+        status = 'error'
+    seconds = time.time() - start
+    with open(log, 'w') as f:
+        f.write(output)
+
+    result = {'name': test.name, 'suite': test.suite, 'config': test.config,
+              'status': status, 'seconds': round(seconds, 3), 'log': os.path.relpath(log, RV1_DIR),
+              'cycles': None, 'instructions': None, 'ipc': None, 'mhz': None, 'reason': ''}
+    for key, rx in RESULT_RE.items():
+        m = rx.search(output)
+        if m:
+            result[key] = m.group(1) if key == 'reason' else \
+                (float(m.group(1)) if key in ('ipc', 'mhz') else int(m.group(1)))
+    if status == 'timeout' and not result['reason']:
+        result['reason'] = 'wall-clock timeout (%ds)' % timeout
+    if status == 'error' and not result['reason']:
+        lines = output.strip().splitlines()
+        result['reason'] = lines[-1] if lines else 'no output'
+    return result
+
+
+class WorkStealingPool:
+    """Per-worker deques: a worker takes from the head of its own, and when
+    that is empty steals from the tail of another's (the cheapest work left)"""
+
+    def __init__(self, workers):
+        self.queues = [collections.deque() for _ in range(workers)]
+        self.locks = [threading.Lock() for _ in range(workers)]
+
+    def deal(self, items):
+        # Round-robin over the cost-sorted list: every worker starts on a long test
+        for i, item in enumerate(items):
+            self.queues[i % len(self.queues)].append(item)
+
+    def take(self, worker):
+        with self.locks[worker]:
+            if self.queues[worker]:
+                return self.queues[worker].popleft()
+        victims = [v for v in range(len(self.queues)) if v != worker]
+        random.shuffle(victims)
+        for v in victims:
+            with self.locks[v]:
+                if self.queues[v]:
+                    return self.queues[v].pop()
+        return None  # Nothing is ever added after deal(), so this worker is done
+
+    def run(self, fn):
+        threads = [threading.Thread(target=self._worker, args=(w, fn))
+                   for w in range(len(self.queues))]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+    def _worker(self, worker, fn):
+        while True:
+            item = self.take(worker)
+            if item is None:
+                return
+            fn(item)
+
+
+def load_history(path):
+    try:
+        with open(path) as f:
+            return {(r['config'], r['name']): r['seconds'] for r in json.load(f)['tests']}
+    except (OSError, ValueError, KeyError):
+        return {}
+
+
+def write_json(path, results, summary):
+    with open(path, 'w') as f:
+        json.dump({'summary': summary, 'tests': results}, f, indent=2)
+
+
+def write_junit(path, results, summary):
+    root = ET.Element('testsuites', tests=str(summary['total']),
+                      failures=str(summary['fail'] + summary['timeout']),
+                      errors=str(summary['error']), time='%.3f' % summary['wall_seconds'])
+    by_config = collections.OrderedDict()
+    for r in results:
+        by_config.setdefault(r['config'], []).append(r)
+    for config, rs in by_config.items():
+        suite = ET.SubElement(root, 'testsuite', name=config, tests=str(len(rs)),
+                              failures=str(sum(r['status'] in ('fail', 'timeout') for r in rs)),
+                              errors=str(sum(r['status'] == 'error' for r in rs)),
+                              time='%.3f' % sum(r['seconds'] for r in rs))
+        for r in rs:
+            case = ET.SubElement(suite, 'testcase', classname='%s.%s' % (r['suite'], config),
+                                 name=r['name'], time='%.3f' % r['seconds'])
+            if r['status'] in ('fail', 'timeout'):
+                ET.SubElement(case, 'failure', type=r['status'], message=r['reason'] or r['status'])
+            elif r['status'] == 'error':
+                ET.SubElement(case, 'error', message=r['reason'] or 'simulator error')
+            out = ET.SubElement(case, 'system-out')
+            out.text = 'cycles=%s instructions=%s ipc=%s log=%s' % (
+                r['cycles'], r['instructions'], r['ipc'], r['log'])
+    ET.ElementTree(root).write(path, encoding='utf-8', xml_declaration=True)
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Parallel RV1 regression on the Verilator simulator')
+    ap.add_argument('--suite', choices=['official', 'custom', 'all'], default='all')
+    ap.add_argument('--xlen', type=int, choices=[32, 64], default=int(os.environ.get('XLEN', 32)))
+    ap.add_argument('--config', help='Comma-separated configurations to run (default: all used)')
+    ap.add_argument('--filter', help='Regex on test names')
+    ap.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1)
+    ap.add_argument('--timeout', type=int, default=60, help='Per-test wall-clock timeout (s)')
+    ap.add_argument('--max-cycles', type=int, default=1000000, help='Per-test cycle limit')
+    ap.add_argument('--json', default=os.path.join(OUT_DIR, 'results.json'),
+                    help='JSON results (also the cost history for the next run)')
+    ap.add_argument('--junit', help='JUnit XML results')
+    ap.add_argument('--no-build', action='store_true', help='Reuse the existing simulators')
+    args = ap.parse_args()
+
+    tests = discover(args.suite, args.xlen, args.filter)
+    if args.config:
+        wanted = args.config.split(',')
+        unknown = [c for c in wanted if c not in CONFIGS]
+        if unknown:
+            ap.error('unknown configuration(s): %s' % ', '.join(unknown))
+        tests = [t for t in tests if t.config in wanted]
+    if not tests:
+        print('No tests found (official: riscv-tests/isa or tests/official-compliance, custom: tests/asm)')
+        return 1
+
+    configs = [c for c in CONFIGS if any(t.config == c for t in tests)]
+    log_dir = os.path.join(OUT_DIR, 'logs')
+    for c in configs:
+        os.makedirs(os.path.join(log_dir, c), exist_ok=True)
+
+    print('=' * 60)
+    print('RV1 Parallel Regression')
+    print('=' * 60)
+    print('Tests:   %d (%s)' % (len(tests), ', '.join(
+        '%s %d' % (c, sum(t.config == c for t in tests)) for c in configs)))
+    print('Workers: %d' % args.jobs)
+    print('')
+
+    t_start = time.time()
+
+    # Step 1: one simulator per configuration, built concurrently
+    if not args.no_build:
+        print('Building simulators...')
+        results = []
+        threads = [threading.Thread(target=lambda c=c: results.append(build(c, log_dir)))
+                   for c in configs]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        for config, ok, secs in sorted(results):
+            print('  %-12s %s (%.1fs)' % (config, 'ok' if ok else 'FAILED', secs))
+        failed = [c for c, ok, _ in results if not ok]
+        if failed:
+            print('Build failed, see %s/build_<config>.log' % os.path.relpath(log_dir, RV1_DIR))
+            return 1
+        print('')
+    else:
+        missing = [c for c in configs if not os.path.isfile(os.path.join(VSIM_ROOT, c, 'rv_soc_sim'))]
+        if missing:
+            print('No simulator built for: %s (run without --no-build)' % ', '.join(missing))
+            return 1
+
+    # Step 2: longest first (previous run's times; unknown tests count as longest)
+    history = load_history(args.json)
+    tests.sort(key=lambda t: -history.get((t.config, t.name), float('inf')))
+
+    results = []
+    lock = threading.Lock()
+    t_run = time.time()
+
+    def execute(test):
+        r = run_one(test, args.timeout, args.max_cycles, log_dir)
+        with lock:
+            results.append(r)
+            mark = 'PASS' if r['status'] == 'pass' else r['status'].upper()
+            print('[%*d/%d] %-7s %-12s %-36s %10s cyc %7.2fs' % (
+                len(str(len(tests))), len(results), len(tests), mark, test.config,
+                test.name, r['cycles'] if r['cycles'] is not None else '-', r['seconds']))
+            sys.stdout.flush()
+
+    pool = WorkStealingPool(max(1, min(args.jobs, len(tests))))
+    pool.deal(tests)
+    pool.run(execute)
+
+    run_seconds = time.time() - t_run
+    wall_seconds = time.time() - t_start
+
+    # Summary
+    order = {c: i for i, c in enumerate(CONFIGS)}
+    results.sort(key=lambda r: (order[r['config']], r['suite'], r['name']))
+    counts = collections.Counter(r['status'] for r in results)
+    summary = {'total': len(results), 'pass': counts['pass'], 'fail': counts['fail'],
+               'timeout': counts['timeout'], 'error': counts['error'],
+               'wall_seconds': round(wall_seconds, 3), 'run_seconds': round(run_seconds, 3),
+               'slowest_test_seconds': max(r['seconds'] for r in results),
+               'total_cycles': sum(r['cycles'] or 0 for r in results),
+               'jobs': args.jobs}
+
+    print('')
+    print('=' * 60)
+    print('Cycle Summary')
+    print('=' * 60)
+    print('%-12s %-36s %-7s %10s %10s %6s' % ('Config', 'Test', 'Result', 'Cycles', 'Instret', 'IPC'))
+    for r in results:
+        print('%-12s %-36s %-7s %10s %10s %6s' % (
+            r['config'], r['name'], r['status'],
+            r['cycles'] if r['cycles'] is not None else '-',
+            r['instructions'] if r['instructions'] is not None else '-',
+            '%.3f' % r['ipc'] if r['ipc'] is not None else '-'))
+
+    print('')
+    print('=' * 60)
+    print('Test Summary')
+    print('=' * 60)
+    print('Total:    %d' % summary['total'])
+    print('Passed:   %d' % summary['pass'])
+    print('Failed:   %d' % summary['fail'])
+    print('Timeout:  %d' % summary['timeout'])
+    print('Error:    %d' % summary['error'])
+    print('Cycles:   %d' % summary['total_cycles'])
+    print('Time:     %.1fs run (slowest test %.1fs), %.1fs total' % (
+        run_seconds, summary['slowest_test_seconds'], wall_seconds))
+
+    bad = [r for r in results if r['status'] != 'pass']
+    if bad:
+        print('')
+        print('Failed tests:')
+        for r in bad:
+            print('    - %s/%s: %s (%s)' % (r['config'], r['name'], r['status'], r['reason']))
+        print('')
+        print('Logs in: %s/' % os.path.relpath(log_dir, RV1_DIR))
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.json)), exist_ok=True)
+    write_json(args.json, results, summary)
+    if args.junit:
+        write_junit(args.junit, results, summary)
+
+    return 1 if bad else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())